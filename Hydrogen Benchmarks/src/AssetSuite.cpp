@@ -0,0 +1,274 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the asset loader decoding a few hundred files on the workers against doing it on the calling thread, and the texture cache
+//handing out one load per file, the vertex and pixel buffers getting from the loader to the upload without a copy, there's no gl context so AssetLoader::close waits for the decodes and drops the uploads
+
+namespace {
+	const unsigned int SEED = 1;
+	const size_t ASSET_AMOUNT = 500;
+	const size_t TEXTURE_SIZE = 128;
+	const size_t MESH_SIZE = 16;
+	const size_t CACHE_THREADS = 8;
+	const size_t CACHE_FILES = 30;
+
+	bool isMesh(const std::string& path) {
+		return path.size() > 4 && path.compare(path.size() - 4, 4, ".obj") == 0;
+	}
+
+	//every third one is a mesh and the rest are textures, written once and used by every run after that
+	const std::vector<std::string>& getAssets() {
+		static std::vector<std::string> paths;
+
+		if (!paths.empty())
+			return paths;
+
+		const std::string directory = getAssetDirectory();
+
+		for (size_t i = 0; i < ASSET_AMOUNT; ++i) {
+			const bool mesh = i % 3 == 2;
+			const std::string path = directory + "asset " + std::to_string(i) + (mesh ? ".obj" : ".png");
+			const size_t size = mesh ? writeObj(path, MESH_SIZE) : writePng(path, TEXTURE_SIZE, SEED + (unsigned int)i);
+
+			if (size == 0) {
+				paths.clear();
+				break;
+			}
+
+			paths.push_back(path);
+		}
+
+		return paths;
+	}
+
+	//the handles have to live until the decodes are done or the assets would go with them
+	void loadAll(const std::vector<std::string>& paths, std::vector<TextureHandle>& textures, std::vector<MeshHandle>& meshes) {
+		textures.clear();
+		meshes.clear();
+
+		for (size_t i = 0; i < paths.size(); ++i) {
+			if (isMesh(paths[i]))
+				meshes.push_back(AssetLoader::loadMesh(paths[i]));
+			else
+				textures.push_back(AssetLoader::loadTexture(paths[i]));
+		}
+
+		AssetLoader::close();
+	}
+
+	//close sleeps until every decode is in, what's decoded is there and the files that aren't there fail
+	void assetLoaderDecodes() {
+		const std::vector<std::string>& paths = getAssets();
+		HBM_REQUIRE(!paths.empty());
+
+		std::vector<TextureHandle> textures;
+		std::vector<MeshHandle> meshes;
+		loadAll(paths, textures, meshes);
+
+		std::vector<TextureHandle> missing;
+		for (size_t i = 0; i < 2; ++i)
+			missing.push_back(AssetLoader::loadTexture(getAssetDirectory() + "missing " + std::to_string(i) + ".png"));
+
+		AssetLoader::close();
+		HBM_EXPECT(AssetLoader::getPendingAmount() == 0);
+
+		size_t decoded = 0;
+
+		for (size_t i = 0; i < textures.size(); ++i) {
+			if (!textures[i].isFailed() && textures[i].get().image.hasData())
+				decoded++;
+		}
+
+		for (size_t i = 0; i < meshes.size(); ++i) {
+			if (!meshes[i].isFailed() && !meshes[i].get().empty())
+				decoded++;
+		}
+
+		HBM_EXPECT(decoded == paths.size());
+
+		for (size_t i = 0; i < missing.size(); ++i)
+			HBM_EXPECT(missing[i].isFailed());
+	}
+
+	//a bunch of threads asking for the same files at once, with and without workers (then the decode runs in load, outside the cache lock),
+	//every file misses once and everyone gets that one load
+	void textureCacheDecodesOnce() {
+		const std::vector<std::string>& paths = getAssets();
+		HBM_REQUIRE(!paths.empty());
+
+		std::vector<std::string> files;
+		for (size_t i = 0; i < paths.size() && files.size() < CACHE_FILES; ++i) {
+			if (!isMesh(paths[i]))
+				files.push_back(paths[i]);
+		}
+
+		const bool previous = AssetLoader::isMultithreaded();
+
+		for (int multithreaded = 0; multithreaded < 2; ++multithreaded) {
+			AssetLoader::setMultithreaded(multithreaded != 0);
+			TextureCache::clear();
+			TextureCache::resetCounters();
+
+			std::vector<std::vector<TextureHandle>> handles(CACHE_THREADS, std::vector<TextureHandle>(files.size()));
+			std::vector<std::thread> threads;
+
+			for (size_t t = 0; t < CACHE_THREADS; ++t) {
+				threads.emplace_back([&files, &handles, t]() {
+					//every thread starts somewhere else in the list so they actually run into each other
+					for (size_t i = 0; i < files.size(); ++i) {
+						const size_t file = (i + t * 7) % files.size();
+						handles[t][file] = TextureCache::load(files[file]);
+					}
+				});
+			}
+
+			for (size_t t = 0; t < threads.size(); ++t)
+				threads[t].join();
+
+			AssetLoader::close();
+
+			HBM_EXPECT(TextureCache::getMisses() == files.size());
+			HBM_EXPECT(TextureCache::getHits() == (CACHE_THREADS - 1) * files.size());
+			HBM_EXPECT(TextureCache::getEntryAmount() == files.size());
+
+			size_t shared = 0;
+
+			for (size_t i = 0; i < files.size(); ++i) {
+				bool same = !handles[0][i].isFailed() && handles[0][i].get().image.hasData();
+
+				for (size_t t = 1; t < CACHE_THREADS; ++t)
+					same = same && &handles[t][i].get() == &handles[0][i].get();
+
+				if (same)
+					shared++;
+			}
+
+			HBM_EXPECT(shared == files.size());
+		}
+
+		TextureCache::clear();
+		TextureCache::resetCounters();
+		AssetLoader::setMultithreaded(previous);
+	}
+
+	size_t getBufferBytes(const Mesh& mesh) {
+		return mesh.vertices.size() * sizeof(float) + mesh.normals.size() * sizeof(float) + mesh.texturecoords.size() * sizeof(float) + mesh.indices.size() * sizeof(unsigned int);
+	}
+
+	//same as the engines Main, loadMesh into a MeshComponent moved into addComponent and extracted, where the scene would create it next.
+	//every buffer has to be the one loadMesh made, and the allocation tracker shouldn't see anything near a copy of them go by
+	void meshReachesUploadWithoutCopies() {
+		std::vector<Mesh> meshes = Util::loadMesh(HFR_RES + "models/peter/peter.obj");
+		HBM_REQUIRE(!meshes.empty());
+
+		std::vector<const float*> vertices;
+		std::vector<const unsigned int*> indices;
+		size_t bytes = 0;
+
+		for (size_t i = 0; i < meshes.size(); ++i) {
+			vertices.push_back(meshes[i].vertices.data());
+			indices.push_back(meshes[i].indices.data());
+			bytes += getBufferBytes(meshes[i]);
+		}
+
+		std::unique_ptr<Scene> scene(new Scene());
+		GameObject peter = scene->createGameObject("peter");
+		RenderSnapshot snapshot;
+
+		const size_t allocatedBefore = AllocationTracker::getAllocatedBytes();
+
+		MeshComponent component = MeshComponent();
+		component.meshes = std::move(meshes);
+		peter.addComponent<MeshComponent>(std::move(component));
+
+		scene->updateTransforms();
+		scene->extract(snapshot);
+
+		const size_t allocated = AllocationTracker::getAllocatedBytes() - allocatedBefore;
+		const std::vector<Mesh>& added = peter.getComponent<MeshComponent>().meshes;
+		HBM_REQUIRE(added.size() == vertices.size());
+
+		size_t same = 0;
+		for (size_t i = 0; i < added.size(); ++i) {
+			if (added[i].vertices.data() == vertices[i] && added[i].indices.data() == indices[i] && !added[i].created)
+				same++;
+		}
+
+		HBM_EXPECT(same == added.size());
+		HBM_EXPECT(snapshot.pendingMeshes.size() == added.size());
+
+		//without HFR_TRACK_ALLOCATIONS nothing gets counted and the pointers are all there is to go on
+		if (AllocationTracker::isTracking()) {
+			HBM_EXPECT(allocated < bytes);
+			report(std::to_string(bytes) + " bytes of vertex data, " + std::to_string(allocated) + " allocated on the way");
+		}
+		else
+			report("allocation tracking is compiled out, only the buffers got checked");
+	}
+
+	//an image moved into a texture and the texture moved on keeps the pixels stb gave it
+	void textureReachesUploadWithoutCopies() {
+		const std::string path = getAssetDirectory() + "copies.png";
+		HBM_REQUIRE(writePng(path, TEXTURE_SIZE * 4, SEED) > 0);
+
+		Image image(path);
+		HBM_REQUIRE(image.hasData());
+
+		const unsigned char* pixels = image.data;
+		const size_t bytes = (size_t)image.width * (size_t)image.height * (size_t)image.channels;
+		const size_t allocatedBefore = AllocationTracker::getAllocatedBytes();
+
+		Texture texture(std::move(image));
+		Texture moved(std::move(texture));
+		Texture assigned;
+		assigned = std::move(moved);
+
+		const size_t allocated = AllocationTracker::getAllocatedBytes() - allocatedBefore;
+
+		HBM_EXPECT(assigned.image.data == pixels);
+		HBM_EXPECT(!assigned.isCreated);
+
+		if (AllocationTracker::isTracking())
+			HBM_EXPECT(allocated < bytes);
+
+		//a copy is the one place the pixels get duplicated, and it comes out not created
+		Texture copy(assigned);
+		HBM_EXPECT(copy.image.data != pixels && !copy.isCreated && copy.textureID == 0);
+	}
+
+	//range(0) is 1 for the job system workers and 0 for the calling thread
+	void assetLoading(BenchmarkState& state) {
+		const std::vector<std::string>& paths = getAssets();
+
+		if (paths.empty()) {
+			state.skipWithError("Couldn't write the assets to " + getAssetDirectory());
+			return;
+		}
+
+		const bool previous = AssetLoader::isMultithreaded();
+		AssetLoader::setMultithreaded(state.range(0) != 0);
+
+		std::vector<TextureHandle> textures;
+		std::vector<MeshHandle> meshes;
+
+		while (state.keepRunning())
+			loadAll(paths, textures, meshes);
+
+		AssetLoader::setMultithreaded(previous);
+
+		state.counters["workers"] = state.range(0) != 0 ? (double)JobSystem::getWorkerAmount() : 0;
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)paths.size());
+	}
+}
+
+HBM_CHECK(assetLoaderDecodes);
+HBM_CHECK(textureCacheDecodesOnce);
+HBM_CHECK(meshReachesUploadWithoutCopies);
+HBM_CHECK(textureReachesUploadWithoutCopies);
+
+HBM_BENCHMARK(assetLoading)->arg(0)->arg(1)->unit(TimeUnit::Millisecond);
@@ -0,0 +1,282 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the texture atlas on 2000 made up gui icons (small squares mostly, some bigger ones and some wide ones like a toolbar would have),
+//how full it gets the pages, whether every icon and its padding ended up where its region says and how long packing takes, nothing gets uploaded
+
+namespace {
+	const unsigned int SEED = 1;
+	const size_t ICON_AMOUNT = 2000;
+	//what the set added later on gets packed around
+	const size_t EXTRA_ICONS = 200;
+	//built tallest first, what's left over is the padding and the gaps the skyline leaves under the wide ones
+	const float MINIMUM_OCCUPANCY = 0.75f;
+
+	enum PackMode {
+		Build = 0,
+		Insert = 1
+	};
+
+	struct IconSet {
+		std::vector<std::string> names;
+		std::vector<Image> images;
+
+		std::vector<const Image*> getPointers() const {
+			std::vector<const Image*> out(images.size());
+
+			for (size_t i = 0; i < images.size(); ++i)
+				out[i] = &images[i];
+
+			return out;
+		}
+
+		size_t getArea() const {
+			size_t out = 0;
+
+			for (size_t i = 0; i < images.size(); ++i)
+				out += (size_t)images[i].width * images[i].height;
+
+			return out;
+		}
+	};
+
+	Vec2i getIconSize(std::mt19937& random) {
+		const int small[] = { 16, 24, 32, 48 };
+		const int large[] = { 64, 96 };
+		const int huge[] = { 128, 192 };
+
+		std::uniform_int_distribution<int> kind(0, 99);
+		std::uniform_int_distribution<int> pick(0, 3);
+		const int value = kind(random);
+
+		if (value < 60)
+			return Vec2i(small[pick(random)]);
+
+		if (value < 85)
+			return Vec2i(large[pick(random) % 2]);
+
+		if (value < 95)
+			return Vec2i(64 + 32 * pick(random), 16 + 8 * (pick(random) % 3));
+
+		return Vec2i(huge[pick(random) % 2]);
+	}
+
+	//gradients across and down, so the edges differ from each other, and blue tells the icons apart
+	IconSet createIcons(const size_t& amount, const std::string& prefix, const unsigned int& seed) {
+		std::mt19937 random(seed);
+		IconSet out;
+
+		for (size_t i = 0; i < amount; ++i) {
+			const Vec2i size = getIconSize(random);
+			Image image(size.x, size.y, 4, NULL);
+
+			for (int y = 0; y < size.y; ++y) {
+				for (int x = 0; x < size.x; ++x) {
+					unsigned char* pixel = image.data + ((size_t)y * size.x + x) * 4;
+					pixel[0] = (unsigned char)(x * 255 / max(size.x - 1, 1));
+					pixel[1] = (unsigned char)(y * 255 / max(size.y - 1, 1));
+					pixel[2] = (unsigned char)(i % 251);
+					pixel[3] = 255;
+				}
+			}
+
+			out.names.push_back(prefix + std::to_string(i));
+			out.images.push_back(std::move(image));
+		}
+
+		return out;
+	}
+
+	//the icon where its region says it is and every padding texel the edge pixel closest to it
+	bool isWritten(const TextureAtlas& atlas, const AtlasRegion& region, const Image& image) {
+		const Image& page = atlas.getTexture(region.page).image;
+
+		for (int y = -atlas.padding; y < region.size.y + atlas.padding; ++y) {
+			for (int x = -atlas.padding; x < region.size.x + atlas.padding; ++x) {
+				const int sourceX = min(max(x, 0), image.width - 1);
+				const int sourceY = min(max(y, 0), image.height - 1);
+
+				const unsigned char* expected = image.data + ((size_t)sourceY * image.width + sourceX) * 4;
+				const unsigned char* actual = page.data + ((size_t)(region.position.y + y) * page.width + region.position.x + x) * 4;
+
+				if (std::memcmp(expected, actual, 4) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	//with their padding, regions stay inside their page and apart from each other
+	size_t getOverlaps(const TextureAtlas& atlas, const std::vector<const AtlasRegion*>& regions) {
+		size_t out = 0;
+
+		for (size_t i = 0; i < regions.size(); ++i) {
+			const AtlasRegion& a = *regions[i];
+			const Image& page = atlas.getTexture(a.page).image;
+
+			if (a.position.x < atlas.padding || a.position.y < atlas.padding ||
+				a.position.x + a.size.x + atlas.padding > page.width || a.position.y + a.size.y + atlas.padding > page.height)
+				out++;
+
+			for (size_t j = i + 1; j < regions.size(); ++j) {
+				const AtlasRegion& b = *regions[j];
+
+				if (a.page == b.page &&
+					a.position.x - atlas.padding < b.position.x + b.size.x + atlas.padding && b.position.x - atlas.padding < a.position.x + a.size.x + atlas.padding &&
+					a.position.y - atlas.padding < b.position.y + b.size.y + atlas.padding && b.position.y - atlas.padding < a.position.y + a.size.y + atlas.padding)
+					out++;
+			}
+		}
+
+		return out;
+	}
+
+	//every icon is in, where its region says with its padding around it, the texture coordinates are the region on its page,
+	//and nothing overlaps
+	size_t checkRegions(const TextureAtlas& atlas, const IconSet& icons, std::vector<const AtlasRegion*>& regions) {
+		size_t wrong = 0;
+
+		for (size_t i = 0; i < icons.images.size(); ++i) {
+			const AtlasRegion* region = atlas.getRegion(icons.names[i]);
+
+			if (region == nullptr) {
+				wrong++;
+				continue;
+			}
+
+			const Image& page = atlas.getTexture(region->page).image;
+
+			const bool coordinates = std::abs(region->textureOffset.x * page.width - region->position.x) < 0.01f &&
+				std::abs(region->textureOffset.y * page.height - region->position.y) < 0.01f &&
+				std::abs(region->textureSize.x * page.width - region->size.x) < 0.01f && std::abs(region->textureSize.y * page.height - region->size.y) < 0.01f;
+
+			if (region->size.x != icons.images[i].width || region->size.y != icons.images[i].height || !coordinates || !isWritten(atlas, *region, icons.images[i]))
+				wrong++;
+
+			regions.push_back(region);
+		}
+
+		return wrong;
+	}
+
+	std::string toPercent(const float& value) {
+		return std::to_string((int)(value * 1000) / 10.0f).substr(0, 4) + "%";
+	}
+
+	//2000 icons built offline fill the pages to at least MINIMUM_OCCUPANCY with every icon and its padding where its region says
+	void atlasPacksIcons() {
+		const IconSet icons = createIcons(ICON_AMOUNT, "icon ", SEED);
+		TextureAtlas atlas;
+
+		HBM_REQUIRE(atlas.build(icons.names, icons.getPointers()) == ICON_AMOUNT);
+		HBM_EXPECT(atlas.getRegionAmount() == ICON_AMOUNT);
+
+		//no fewer than the image area needs, the last page counting only as far as it got trimmed
+		const size_t pageArea = (size_t)atlas.pageSize * atlas.pageSize;
+		HBM_EXPECT(atlas.getPageAmount() <= (icons.getArea() + pageArea - 1) / pageArea + 1);
+		HBM_EXPECT(atlas.getOccupancy() >= MINIMUM_OCCUPANCY);
+
+		std::vector<const AtlasRegion*> regions;
+		HBM_EXPECT(checkRegions(atlas, icons, regions) == 0);
+		HBM_EXPECT(getOverlaps(atlas, regions) == 0);
+
+		report(std::to_string(icons.getArea() / 1000) + "k texels of icons in " + std::to_string(atlas.getPageAmount()) + " pages, " + toPercent(atlas.getOccupancy()) + " used");
+	}
+
+	//more icons inserted into a built atlas fill the room its pages have left, the ones already in don't move,
+	//and putting one in again under its name keeps its spot when the size is the same
+	void atlasInsertsIntoExistingPages() {
+		const IconSet icons = createIcons(ICON_AMOUNT, "icon ", SEED);
+		const IconSet extra = createIcons(EXTRA_ICONS, "extra ", SEED + 1);
+		TextureAtlas atlas;
+
+		HBM_REQUIRE(atlas.build(icons.names, icons.getPointers()) == ICON_AMOUNT);
+
+		const size_t pages = atlas.getPageAmount();
+		std::vector<AtlasRegion> before;
+
+		for (size_t i = 0; i < icons.names.size(); ++i)
+			before.push_back(*atlas.getRegion(icons.names[i]));
+
+		size_t onOldPages = 0;
+
+		for (size_t i = 0; i < extra.names.size(); ++i) {
+			HBM_REQUIRE(atlas.insert(extra.names[i], extra.images[i]));
+
+			if (atlas.getRegion(extra.names[i])->page < (int)pages)
+				onOldPages++;
+		}
+
+		size_t moved = 0;
+
+		for (size_t i = 0; i < icons.names.size(); ++i) {
+			const AtlasRegion& region = *atlas.getRegion(icons.names[i]);
+
+			if (region.page != before[i].page || region.position.x != before[i].position.x || region.position.y != before[i].position.y)
+				moved++;
+		}
+
+		HBM_EXPECT(moved == 0);
+		HBM_EXPECT(onOldPages > 0);
+
+		std::vector<const AtlasRegion*> regions;
+		HBM_EXPECT(checkRegions(atlas, icons, regions) == 0);
+		HBM_EXPECT(checkRegions(atlas, extra, regions) == 0);
+		HBM_EXPECT(getOverlaps(atlas, regions) == 0);
+
+		//the same size goes where it was, another size gets a new spot and the old one isn't its region anymore
+		const AtlasRegion first = *atlas.getRegion(icons.names[0]);
+		HBM_EXPECT(atlas.insert(icons.names[0], icons.images[0]));
+		HBM_EXPECT(atlas.getRegion(icons.names[0])->position.x == first.position.x && atlas.getRegion(icons.names[0])->position.y == first.position.y);
+
+		const Image bigger(first.size.x + 1, first.size.y, 4, NULL);
+		HBM_EXPECT(atlas.insert(icons.names[0], bigger));
+		HBM_EXPECT(atlas.getRegion(icons.names[0])->size.x == first.size.x + 1);
+		HBM_EXPECT(atlas.getRegionAmount() == ICON_AMOUNT + EXTRA_ICONS);
+
+		report(std::to_string(onOldPages) + " of " + std::to_string(EXTRA_ICONS) + " extra icons went into the " + std::to_string(pages) + " built pages");
+	}
+
+	//range(0) is a PackMode, the whole set built offline (tallest first, last page trimmed) or inserted one at a time in the order they come in
+	void atlasPacking(BenchmarkState& state) {
+		const IconSet icons = createIcons(ICON_AMOUNT, "icon ", SEED);
+		const std::vector<const Image*> pointers = icons.getPointers();
+		const bool build = state.range(0) == Build;
+
+		float occupancy = 0;
+		size_t pages = 0;
+
+		while (state.keepRunning()) {
+			TextureAtlas atlas;
+
+			if (build)
+				atlas.build(icons.names, pointers);
+			else {
+				for (size_t i = 0; i < icons.images.size(); ++i)
+					atlas.insert(icons.names[i], icons.images[i]);
+			}
+
+			occupancy = atlas.getOccupancy();
+			pages = atlas.getPageAmount();
+
+			//the pages get freed with the atlas, that's not packing
+			state.pauseTiming();
+			atlas.clear();
+			state.resumeTiming();
+		}
+
+		state.counters["occupancy %"] = occupancy * 100.0;
+		state.counters["pages"] = (double)pages;
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)ICON_AMOUNT);
+	}
+}
+
+HBM_CHECK(atlasPacksIcons);
+HBM_CHECK(atlasInsertsIntoExistingPages);
+
+HBM_BENCHMARK(atlasPacking)->arg(Build)->arg(Insert)->unit(TimeUnit::Millisecond);
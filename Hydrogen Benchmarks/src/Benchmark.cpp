@@ -0,0 +1,552 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include <regex>
+#include <cmath>
+#include <ctime>
+
+using namespace HFR;
+
+namespace HBM {
+
+	namespace {
+		//seconds a benchmark has to run for before its numbers count, --benchmark_min_time changes it
+		const double DEFAULT_MIN_TIME = 0.5;
+		const size_t MAX_ITERATIONS = 1000000000;
+
+		struct BenchmarkResult {
+			std::string name;
+			size_t iterations = 0;
+			//per iteration, in timeUnit
+			double realTime = 0;
+			double cpuTime = 0;
+			TimeUnit timeUnit = TimeUnit::Nanosecond;
+			double itemsPerSecond = 0;
+			double bytesPerSecond = 0;
+			std::map<std::string, double> counters;
+
+			bool errorOccurred = false;
+			std::string errorMessage;
+		};
+
+		//made on first use, benchmarks register themselves while statics get initialized
+		std::vector<std::unique_ptr<Benchmark>>& getBenchmarks() {
+			static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+			return benchmarks;
+		}
+
+		const char* getUnitName(const TimeUnit& unit) {
+			switch (unit) {
+			case TimeUnit::Microsecond:
+				return "us";
+			case TimeUnit::Millisecond:
+				return "ms";
+			default:
+				return "ns";
+			}
+		}
+
+		//seconds to the unit
+		double getUnitMultiplier(const TimeUnit& unit) {
+			switch (unit) {
+			case TimeUnit::Microsecond:
+				return 1e6;
+			case TimeUnit::Millisecond:
+				return 1e3;
+			default:
+				return 1e9;
+			}
+		}
+
+		std::string getRunName(const Benchmark& benchmark, const std::vector<int64_t>& arguments) {
+			std::string out = benchmark.name;
+
+			for (size_t i = 0; i < arguments.size(); ++i)
+				out += "/" + std::to_string(arguments[i]);
+
+			return out;
+		}
+
+		//1.23k, 45.6M and so on like google benchmark prints its counters
+		std::string formatCounter(const double& value) {
+			static const char* suffixes[] = { "", "k", "M", "G", "T" };
+
+			double scaled = value;
+			size_t suffix = 0;
+
+			while (std::fabs(scaled) >= 1000 && suffix < 4) {
+				scaled /= 1000;
+				suffix += 1;
+			}
+
+			char buffer[64];
+			std::snprintf(buffer, sizeof(buffer), "%.4g%s", scaled, suffixes[suffix]);
+			return buffer;
+		}
+
+		//small times get decimals so they don't all print as 0
+		std::string formatTime(const double& value) {
+			char buffer[64];
+			std::snprintf(buffer, sizeof(buffer), value < 10 ? "%.2f" : value < 100 ? "%.1f" : "%.0f", value);
+			return buffer;
+		}
+
+		std::string escapeJson(const std::string& text) {
+			std::string out;
+
+			for (size_t i = 0; i < text.size(); ++i) {
+				if (text[i] == '"' || text[i] == '\\')
+					out += '\\';
+
+				//failure messages can have anything in them
+				if ((unsigned char)text[i] < 0x20) {
+					char buffer[8];
+					std::snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned int)text[i]);
+					out += buffer;
+					continue;
+				}
+
+				out += text[i];
+			}
+
+			return out;
+		}
+
+		BenchmarkResult makeResult(const std::string& name, const BenchmarkState& state, const TimeUnit& unit) {
+			BenchmarkResult out;
+			out.name = name;
+			out.timeUnit = unit;
+			out.errorOccurred = state.errorOccurred;
+			out.errorMessage = state.errorMessage;
+			out.counters = state.counters;
+
+			if (state.errorOccurred || state.getIterations() == 0)
+				return out;
+
+			out.iterations = state.getIterations();
+			out.realTime = state.realTime / (double)out.iterations * getUnitMultiplier(unit);
+			out.cpuTime = state.cpuTime / (double)out.iterations * getUnitMultiplier(unit);
+
+			//over wall time, process cpu time counts the job workers too and only ticks every few milliseconds on windows
+			if (state.realTime > 0) {
+				out.itemsPerSecond = (double)state.itemsProcessed / state.realTime;
+				out.bytesPerSecond = (double)state.bytesProcessed / state.realTime;
+			}
+
+			return out;
+		}
+
+		//runs it with more and more iterations until one run takes minTime, only that last run counts
+		BenchmarkResult runBenchmark(const Benchmark& benchmark, const std::vector<int64_t>& arguments, const double& minTime) {
+			const std::string name = getRunName(benchmark, arguments);
+			size_t iterations = 1;
+
+			while (true) {
+				BenchmarkState state(iterations, arguments);
+				benchmark.function(state);
+
+				if (state.errorOccurred || state.realTime >= minTime || iterations >= MAX_ITERATIONS)
+					return makeResult(name, state, benchmark.timeUnit);
+
+				//aim a bit past minTime so the next run is most likely the last, runs too short to go by just get 10 times longer
+				double multiplier = minTime * 1.4 / max(state.realTime, 1e-9);
+
+				if (state.realTime / minTime <= 0.1)
+					multiplier = 10;
+
+				const size_t next = (size_t)((double)iterations * multiplier);
+				iterations = min(max(next, iterations + 1), MAX_ITERATIONS);
+			}
+		}
+
+		void printHeader(const size_t& nameWidth) {
+			const std::string line(nameWidth + 49, '-');
+
+			std::printf("%s\n", line.c_str());
+			std::printf("%-*s %13s %15s %12s\n", (int)nameWidth, "Benchmark", "Time", "CPU", "Iterations");
+			std::printf("%s\n", line.c_str());
+		}
+
+		void printResult(const BenchmarkResult& result, const size_t& nameWidth) {
+			if (result.errorOccurred) {
+				std::printf("%-*s ERROR OCCURRED: '%s'\n", (int)nameWidth, result.name.c_str(), result.errorMessage.c_str());
+				return;
+			}
+
+			const char* unit = getUnitName(result.timeUnit);
+			std::printf("%-*s %10s %-2s %12s %-2s %12zu", (int)nameWidth, result.name.c_str(), formatTime(result.realTime).c_str(), unit, formatTime(result.cpuTime).c_str(), unit, result.iterations);
+
+			if (result.bytesPerSecond > 0)
+				std::printf(" bytes_per_second=%s/s", formatCounter(result.bytesPerSecond).c_str());
+
+			if (result.itemsPerSecond > 0)
+				std::printf(" items_per_second=%s/s", formatCounter(result.itemsPerSecond).c_str());
+
+			for (auto i = result.counters.begin(); i != result.counters.end(); ++i)
+				std::printf(" %s=%s", i->first.c_str(), formatCounter(i->second).c_str());
+
+			std::printf("\n");
+		}
+
+		void printCheck(const CheckResult& result) {
+			std::printf("[ %-8s ] %s (%.0f ms)\n", result.passed() ? "OK" : "FAILED", result.name.c_str(), result.milliseconds);
+
+			for (size_t i = 0; i < result.reports.size(); ++i)
+				std::printf("             %s\n", result.reports[i].c_str());
+
+			for (size_t i = 0; i < result.failures.size(); ++i)
+				std::printf("             failed: %s\n", result.failures[i].c_str());
+		}
+
+		//the fields of google benchmarks json output that compare.py and friends read, the checks go in their own array those tools skip
+		bool writeJson(const std::string& path, const std::string& executable, const std::vector<BenchmarkResult>& results, const std::vector<CheckResult>& checks) {
+			std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+
+			if (!file.is_open()) {
+				Debug::systemErr("Couldn't write benchmark results to: " + path);
+				return false;
+			}
+
+			char date[64];
+			const std::time_t now = std::time(nullptr);
+			std::tm local;
+			localtime_s(&local, &now);
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &local);
+
+#ifdef _DEBUG
+			const char* buildType = "debug";
+#else
+			const char* buildType = "release";
+#endif
+
+			file.precision(17);
+
+			file << "{\n  \"context\": {\n";
+			file << "    \"date\": \"" << date << "\",\n";
+			file << "    \"executable\": \"" << escapeJson(executable) << "\",\n";
+			file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+			file << "    \"library_build_type\": \"" << buildType << "\"\n";
+			file << "  },\n  \"benchmarks\": [";
+
+			for (size_t i = 0; i < results.size(); ++i) {
+				const BenchmarkResult& result = results[i];
+
+				file << (i > 0 ? ",\n" : "\n") << "    {\n";
+				file << "      \"name\": \"" << escapeJson(result.name) << "\",\n";
+				file << "      \"run_name\": \"" << escapeJson(result.name) << "\",\n";
+				file << "      \"run_type\": \"iteration\",\n";
+				file << "      \"repetitions\": 1,\n";
+				file << "      \"repetition_index\": 0,\n";
+				file << "      \"threads\": 1,\n";
+
+				if (result.errorOccurred) {
+					file << "      \"error_occurred\": true,\n";
+					file << "      \"error_message\": \"" << escapeJson(result.errorMessage) << "\"\n    }";
+					continue;
+				}
+
+				file << "      \"iterations\": " << result.iterations << ",\n";
+				file << "      \"real_time\": " << result.realTime << ",\n";
+				file << "      \"cpu_time\": " << result.cpuTime << ",\n";
+				file << "      \"time_unit\": \"" << getUnitName(result.timeUnit) << "\"";
+
+				if (result.bytesPerSecond > 0)
+					file << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+
+				if (result.itemsPerSecond > 0)
+					file << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+
+				for (auto counter = result.counters.begin(); counter != result.counters.end(); ++counter)
+					file << ",\n      \"" << escapeJson(counter->first) << "\": " << counter->second;
+
+				file << "\n    }";
+			}
+
+			file << "\n  ],\n  \"checks\": [";
+
+			for (size_t i = 0; i < checks.size(); ++i) {
+				const CheckResult& check = checks[i];
+
+				file << (i > 0 ? ",\n" : "\n") << "    {\n";
+				file << "      \"name\": \"" << escapeJson(check.name) << "\",\n";
+				file << "      \"passed\": " << (check.passed() ? "true" : "false") << ",\n";
+				file << "      \"milliseconds\": " << check.milliseconds << ",\n";
+				file << "      \"reports\": [";
+
+				for (size_t j = 0; j < check.reports.size(); ++j)
+					file << (j > 0 ? ", " : "") << "\"" << escapeJson(check.reports[j]) << "\"";
+
+				file << "],\n      \"failures\": [";
+
+				for (size_t j = 0; j < check.failures.size(); ++j)
+					file << (j > 0 ? ", " : "") << "\"" << escapeJson(check.failures[j]) << "\"";
+
+				file << "]\n    }";
+			}
+
+			file << "\n  ]\n}\n";
+			return true;
+		}
+
+		void printUsage() {
+			Debug::systemErr("Usage: [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>] [--benchmark_out=<results.json>] [--benchmark_list_tests] [--checks_only] [--skip_checks]");
+		}
+
+		bool readFlag(const std::string& argument, const std::string& flag, std::string& value) {
+			const std::string prefix = "--" + flag + "=";
+
+			if (argument.compare(0, prefix.size(), prefix) != 0)
+				return false;
+
+			value = argument.substr(prefix.size());
+			return true;
+		}
+	}
+
+	BenchmarkState::BenchmarkState(const size_t& _maxIterations, const std::vector<int64_t>& _arguments) {
+		maxIterations = _maxIterations;
+		arguments = _arguments;
+	}
+
+	void BenchmarkState::startTimer() {
+		realStart = std::chrono::steady_clock::now();
+		cpuStart = FrameTelemetry::getProcessCpuTime();
+		timing = true;
+	}
+
+	void BenchmarkState::stopTimer() {
+		if (!timing)
+			return;
+
+		realTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+		//getProcessCpuTime is in milliseconds
+		cpuTime += (FrameTelemetry::getProcessCpuTime() - cpuStart) / 1000.0;
+		timing = false;
+	}
+
+	bool BenchmarkState::keepRunning() {
+		if (!started) {
+			started = true;
+
+			if (!errorOccurred)
+				startTimer();
+		}
+
+		if (!errorOccurred && iterations < maxIterations) {
+			iterations += 1;
+			return true;
+		}
+
+		stopTimer();
+		return false;
+	}
+
+	void BenchmarkState::pauseTiming() {
+		stopTimer();
+	}
+
+	void BenchmarkState::resumeTiming() {
+		if (!timing)
+			startTimer();
+	}
+
+	void BenchmarkState::skipWithError(const std::string& message) {
+		stopTimer();
+
+		errorOccurred = true;
+		errorMessage = message;
+	}
+
+	int64_t BenchmarkState::range(const size_t& index) const {
+		return index < arguments.size() ? arguments[index] : 0;
+	}
+
+	size_t BenchmarkState::getIterations() const {
+		return iterations;
+	}
+
+	void BenchmarkState::setItemsProcessed(const int64_t& items) {
+		itemsProcessed = items;
+	}
+
+	void BenchmarkState::setBytesProcessed(const int64_t& bytes) {
+		bytesProcessed = bytes;
+	}
+
+	Benchmark::Benchmark(const std::string& _name, const BenchmarkFunction& _function) {
+		name = _name;
+		function = _function;
+	}
+
+	Benchmark* Benchmark::arg(const int64_t& value) {
+		argumentSets.push_back({ value });
+		return this;
+	}
+
+	Benchmark* Benchmark::args(const std::vector<int64_t>& values) {
+		argumentSets.push_back(values);
+		return this;
+	}
+
+	Benchmark* Benchmark::range(const int64_t& start, const int64_t& end, const int64_t& multiplier) {
+		int64_t value = start;
+
+		for (; value < end; value *= max(multiplier, (int64_t)2))
+			arg(value);
+
+		arg(end);
+		return this;
+	}
+
+	Benchmark* Benchmark::unit(const TimeUnit& _unit) {
+		timeUnit = _unit;
+		return this;
+	}
+
+	Benchmark* registerBenchmark(const std::string& name, const BenchmarkFunction& function) {
+		getBenchmarks().push_back(std::unique_ptr<Benchmark>(new Benchmark(name, function)));
+		return getBenchmarks().back().get();
+	}
+
+	int runBenchmarks(const std::vector<std::string>& arguments) {
+		std::string filter = ".";
+		std::string outPath;
+		double minTime = DEFAULT_MIN_TIME;
+		bool listOnly = false;
+		bool runChecks = true;
+		bool runTimings = true;
+
+		for (size_t i = 1; i < arguments.size(); ++i) {
+			std::string value;
+
+			if (readFlag(arguments[i], "benchmark_filter", value))
+				filter = value;
+			else if (readFlag(arguments[i], "benchmark_out", value))
+				outPath = value;
+			else if (readFlag(arguments[i], "benchmark_min_time", value)) {
+				//google benchmark takes 0.5s as well as 0.5
+				char* end = nullptr;
+				minTime = std::strtod(value.c_str(), &end);
+
+				if (end == value.c_str() || minTime <= 0) {
+					Debug::systemErr("Not a time in seconds: " + value);
+					return 1;
+				}
+			}
+			else if (arguments[i] == "--benchmark_list_tests")
+				listOnly = true;
+			else if (arguments[i] == "--checks_only")
+				runTimings = false;
+			else if (arguments[i] == "--skip_checks")
+				runChecks = false;
+			else {
+				Debug::systemErr("Unknown argument: " + arguments[i]);
+				printUsage();
+				return 1;
+			}
+		}
+
+		std::regex pattern;
+
+		try {
+			pattern = std::regex(filter);
+		}
+		catch (const std::regex_error&) {
+			Debug::systemErr("Not a valid filter: " + filter);
+			return 1;
+		}
+
+		//the filter goes for the checks too, so one area can be checked and timed on its own
+		std::vector<const Check*> checks;
+
+		for (const Check& check : getChecks()) {
+			if (runChecks && std::regex_search(check.name, pattern))
+				checks.push_back(&check);
+		}
+
+		//every benchmark and argument set that matches, in the order they were registered
+		std::vector<std::pair<const Benchmark*, std::vector<int64_t>>> runs;
+		size_t nameWidth = 10;
+
+		for (const std::unique_ptr<Benchmark>& benchmark : getBenchmarks()) {
+			if (!runTimings)
+				break;
+
+			std::vector<std::vector<int64_t>> argumentSets = benchmark->argumentSets;
+
+			if (argumentSets.empty())
+				argumentSets.push_back({});
+
+			for (size_t i = 0; i < argumentSets.size(); ++i) {
+				const std::string name = getRunName(*benchmark, argumentSets[i]);
+
+				if (!std::regex_search(name, pattern))
+					continue;
+
+				runs.push_back(std::make_pair(benchmark.get(), argumentSets[i]));
+				nameWidth = max(nameWidth, name.size());
+			}
+		}
+
+		if (runs.empty() && checks.empty()) {
+			Debug::systemErr("No benchmark or check matched: " + filter);
+			return 1;
+		}
+
+		if (listOnly) {
+			for (size_t i = 0; i < checks.size(); ++i)
+				std::printf("%s (check)\n", checks[i]->name.c_str());
+
+			for (size_t i = 0; i < runs.size(); ++i)
+				std::printf("%s\n", getRunName(*runs[i].first, runs[i].second).c_str());
+
+			return 0;
+		}
+
+		const std::string executable = arguments.empty() ? "" : arguments[0];
+
+		std::printf("Running %s\n", executable.c_str());
+		std::printf("Run on (%u X threads)\n", std::thread::hardware_concurrency());
+
+		std::vector<CheckResult> checkResults;
+		bool failed = false;
+
+		//checks first, a benchmark of code that's wrong isn't worth waiting for
+		if (!checks.empty()) {
+			size_t passed = 0;
+
+			for (size_t i = 0; i < checks.size(); ++i) {
+				checkResults.push_back(runCheck(*checks[i]));
+				printCheck(checkResults.back());
+
+				if (checkResults.back().passed())
+					passed += 1;
+			}
+
+			std::printf("%zu of %zu checks passed\n", passed, checks.size());
+			failed = passed != checks.size();
+		}
+
+		std::vector<BenchmarkResult> results;
+
+		if (!runs.empty()) {
+#ifdef _DEBUG
+			std::printf("***WARNING*** This is a debug build, the timings mean nothing\n");
+#endif
+			printHeader(nameWidth);
+		}
+
+		for (size_t i = 0; i < runs.size(); ++i) {
+			results.push_back(runBenchmark(*runs[i].first, runs[i].second, minTime));
+			printResult(results.back(), nameWidth);
+
+			failed = failed || results.back().errorOccurred;
+		}
+
+		if (!outPath.empty() && !writeJson(outPath, executable, results, checkResults))
+			return 1;
+
+		return failed ? 1 : 0;
+	}
+
+}
@@ -0,0 +1,109 @@
+#ifndef HBM_BENCHMARK_HEADER_INCLUDE
+#define HBM_BENCHMARK_HEADER_INCLUDE
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+#define HBM_CONCAT_INNER(a, b) a##b
+#define HBM_CONCAT(a, b) HBM_CONCAT_INNER(a, b)
+
+//registers a void(HBM::BenchmarkState&) function, chain arg / range / unit on it like HBM_BENCHMARK(name)->range(100, 4000)
+#define HBM_BENCHMARK(function) static HBM::Benchmark* HBM_CONCAT(hbmBenchmark, __LINE__) = HBM::registerBenchmark(#function, function)
+
+//a small stand in for google benchmark, same flags, same console table and the same json so the usual tools can compare runs
+namespace HBM {
+
+	enum class TimeUnit {
+		Nanosecond,
+		Microsecond,
+		Millisecond
+	};
+
+	//what a benchmark function gets, everything between the first keepRunning and the one that returns false is timed
+	class BenchmarkState {
+	private:
+		size_t maxIterations;
+		size_t iterations = 0;
+		bool started = false;
+		//between startTimer and stopTimer
+		bool timing = false;
+
+		std::chrono::steady_clock::time_point realStart;
+		double cpuStart = 0;
+
+		void startTimer();
+		void stopTimer();
+
+	public:
+		std::vector<int64_t> arguments;
+
+		//seconds
+		double realTime = 0;
+		double cpuTime = 0;
+
+		int64_t itemsProcessed = 0;
+		int64_t bytesProcessed = 0;
+		//shown next to the times as they are
+		std::map<std::string, double> counters;
+
+		bool errorOccurred = false;
+		std::string errorMessage;
+
+		BenchmarkState(const size_t& maxIterations, const std::vector<int64_t>& arguments);
+
+		//while (state.keepRunning()) { work }
+		bool keepRunning();
+
+		//setup that has to happen every iteration goes between these, they cost a clock read each so keep them out of tiny loops
+		void pauseTiming();
+		void resumeTiming();
+
+		//stops the benchmark and reports it as failed
+		void skipWithError(const std::string& message);
+
+		int64_t range(const size_t& index) const;
+		size_t getIterations() const;
+
+		//totals over every iteration, they show up per second
+		void setItemsProcessed(const int64_t& items);
+		void setBytesProcessed(const int64_t& bytes);
+	};
+
+	//keeps the compiler from throwing away work whose result nothing reads, for numbers
+	template<typename T>
+	inline void doNotOptimize(const T& value) {
+		static volatile T sink;
+		sink = value;
+	}
+
+	using BenchmarkFunction = void(*)(BenchmarkState&);
+
+	class Benchmark {
+	public:
+		std::string name;
+		BenchmarkFunction function;
+		//one run per entry, an empty list runs once without arguments
+		std::vector<std::vector<int64_t>> argumentSets;
+		TimeUnit timeUnit = TimeUnit::Nanosecond;
+
+		Benchmark(const std::string& name, const BenchmarkFunction& function);
+
+		Benchmark* arg(const int64_t& value);
+		Benchmark* args(const std::vector<int64_t>& values);
+		//start, start * multiplier and so on up to and including end
+		Benchmark* range(const int64_t& start, const int64_t& end, const int64_t& multiplier = 8);
+		Benchmark* unit(const TimeUnit& unit);
+	};
+
+	Benchmark* registerBenchmark(const std::string& name, const BenchmarkFunction& function);
+
+	//parses --benchmark_filter=<regex>, --benchmark_min_time=<seconds>, --benchmark_out=<json path> and --benchmark_list_tests,
+	//plus --checks_only and --skip_checks, runs the checks that matched and then the benchmarks and returns the exit code
+	int runBenchmarks(const std::vector<std::string>& arguments);
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "hfpch.h"
+#include "Check.h"
+
+using namespace HFR;
+
+namespace HBM {
+
+	namespace {
+		//made on first use, checks register themselves while statics get initialized
+		std::vector<Check>& getCheckList() {
+			static std::vector<Check> checks;
+			return checks;
+		}
+
+		//the check that's running, checks run one at a time on the main thread
+		CheckResult* current = nullptr;
+
+		std::string getFileName(const char* path) {
+			const std::string out = path;
+			const size_t slash = out.find_last_of("/\\");
+
+			return slash == std::string::npos ? out : out.substr(slash + 1);
+		}
+	}
+
+	bool CheckResult::passed() const {
+		return failures.empty();
+	}
+
+	bool registerCheck(const std::string& name, const CheckFunction& function) {
+		Check check;
+		check.name = name;
+		check.function = function;
+
+		getCheckList().push_back(check);
+		return true;
+	}
+
+	const std::vector<Check>& getChecks() {
+		return getCheckList();
+	}
+
+	CheckResult runCheck(const Check& check) {
+		CheckResult out;
+		out.name = check.name;
+
+		current = &out;
+		const auto start = std::chrono::steady_clock::now();
+
+		try {
+			check.function();
+		}
+		catch (const std::exception& exception) {
+			out.failures.push_back(std::string("threw: ") + exception.what());
+		}
+
+		out.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		current = nullptr;
+
+		return out;
+	}
+
+	bool expect(const bool& condition, const char* expression, const char* file, const int& line) {
+		if (condition)
+			return true;
+
+		if (current != nullptr)
+			current->failures.push_back(getFileName(file) + "(" + std::to_string(line) + "): " + expression);
+
+		return false;
+	}
+
+	bool expectNear(const double& value, const double& expected, const double& tolerance, const char* expression, const char* file, const int& line) {
+		if (std::fabs(value - expected) <= tolerance)
+			return true;
+
+		if (current != nullptr) {
+			char buffer[256];
+			std::snprintf(buffer, sizeof(buffer), "%s is %.9g, expected %.9g (+-%.3g)", expression, value, expected, tolerance);
+
+			current->failures.push_back(getFileName(file) + "(" + std::to_string(line) + "): " + buffer);
+		}
+
+		return false;
+	}
+
+	void report(const std::string& message) {
+		if (current != nullptr)
+			current->reports.push_back(message);
+	}
+
+}
@@ -0,0 +1,49 @@
+#ifndef HBM_CHECK_HEADER_INCLUDE
+#define HBM_CHECK_HEADER_INCLUDE
+
+#include "Benchmark.h"
+
+//registers a void() function as a check, checks run before the benchmarks and one that fails makes the whole run fail
+#define HBM_CHECK(function) static bool HBM_CONCAT(hbmCheck, __LINE__) = HBM::registerCheck(#function, function)
+
+//records a failure in the check that's running and carries on
+#define HBM_EXPECT(condition) HBM::expect((condition), #condition, __FILE__, __LINE__)
+//the same with both values in the failure, for numbers
+#define HBM_EXPECT_NEAR(value, expected, tolerance) HBM::expectNear((double)(value), (double)(expected), (double)(tolerance), #value, __FILE__, __LINE__)
+//leaves the check when it fails, for when nothing after it can run
+#define HBM_REQUIRE(condition) if (!HBM::expect((condition), #condition, __FILE__, __LINE__)) return
+
+//correctness checks for the benchmark target, the numbers a benchmark prints mean nothing if the code it times is wrong
+namespace HBM {
+
+	using CheckFunction = void(*)();
+
+	struct Check {
+		std::string name;
+		CheckFunction function;
+	};
+
+	struct CheckResult {
+		std::string name;
+		std::vector<std::string> failures;
+		//whatever the check measured along the way, printed under it
+		std::vector<std::string> reports;
+		double milliseconds = 0;
+
+		bool passed() const;
+	};
+
+	bool registerCheck(const std::string& name, const CheckFunction& function);
+	const std::vector<Check>& getChecks();
+	CheckResult runCheck(const Check& check);
+
+	//false when condition is, the failure goes to the check that's running
+	bool expect(const bool& condition, const char* expression, const char* file, const int& line);
+	bool expectNear(const double& value, const double& expected, const double& tolerance, const char* expression, const char* file, const int& line);
+
+	//a line of what the running check found (occupancy, latencies and such), it shows up under the check either way
+	void report(const std::string& message);
+
+}
+
+#endif
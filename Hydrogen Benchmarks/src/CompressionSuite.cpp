@@ -0,0 +1,206 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the block compressor on every format and quality, what it keeps (psnr against the source), how fast it encodes and how much memory it saves
+
+namespace {
+	const unsigned int SEED = 1;
+	const int CHECK_SIZE = 256;
+	//not a multiple of 4, the edge blocks only have part of the image in them
+	const int ODD_WIDTH = 37;
+	const int ODD_HEIGHT = 21;
+	const double ODD_MINIMUM_PSNR = 30.0;
+	const int FORMATS[] = { HFR_TEXTURE_FORMAT_BC1, HFR_TEXTURE_FORMAT_BC3, HFR_TEXTURE_FORMAT_BC5, HFR_TEXTURE_FORMAT_BC7 };
+
+	//something like an albedo map, smooth color changes with some grain, a few hard edges and an alpha gradient unless it's opaque
+	Image createAlbedo(const int& width, const int& height, const bool& opaque, const unsigned int& seed) {
+		Image out(width, height, 4, NULL);
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<int> grain(-6, 6);
+
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const float u = x / (float)width;
+				const float v = y / (float)height;
+				const bool tile = ((x / 32) + (y / 32)) % 2 == 0;
+
+				const float r = 120 + 80 * std::sin(u * 6.0f) + (tile ? 30 : 0);
+				const float g = 100 + 60 * std::cos(v * 5.0f + u * 2.0f);
+				const float b = 70 + 50 * std::sin((u + v) * 4.0f) + (tile ? 0 : 25);
+				const float a = opaque ? 255 : 255 * (0.25f + 0.75f * v);
+
+				unsigned char* texel = out.data + ((size_t)y * width + x) * 4;
+				texel[0] = (unsigned char)min(max((int)r + grain(random), 0), 255);
+				texel[1] = (unsigned char)min(max((int)g + grain(random), 0), 255);
+				texel[2] = (unsigned char)min(max((int)b + grain(random), 0), 255);
+				texel[3] = (unsigned char)min(max((int)a, 0), 255);
+			}
+		}
+
+		return out;
+	}
+
+	//tangent space normals of some bumps, what bc5 is for
+	Image createNormalMap(const int& width, const int& height) {
+		Image out(width, height, 4, NULL);
+
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const float dx = 0.6f * std::cos(x * 0.2f) * std::cos(y * 0.13f);
+				const float dy = -0.6f * std::sin(x * 0.2f) * std::sin(y * 0.13f);
+				const float length = std::sqrt(dx * dx + dy * dy + 1.0f);
+
+				unsigned char* texel = out.data + ((size_t)y * width + x) * 4;
+				texel[0] = (unsigned char)((-dx / length * 0.5f + 0.5f) * 255.0f + 0.5f);
+				texel[1] = (unsigned char)((-dy / length * 0.5f + 0.5f) * 255.0f + 0.5f);
+				texel[2] = (unsigned char)((1.0f / length * 0.5f + 0.5f) * 255.0f + 0.5f);
+				texel[3] = 255;
+			}
+		}
+
+		return out;
+	}
+
+	//bc1 gets an opaque one, anything under half alpha turns into transparent black in it
+	Image createSource(const int& format, const int& width, const int& height) {
+		return format == HFR_TEXTURE_FORMAT_BC5 ? createNormalMap(width, height) : createAlbedo(width, height, format == HFR_TEXTURE_FORMAT_BC1, SEED);
+	}
+
+	//the channels a format actually keeps, bc1 gets compared without alpha since it only has 1 bit of it
+	int getComparedChannels(const int& format) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1: return 3;
+		case HFR_TEXTURE_FORMAT_BC5: return 2;
+		default: return 4;
+		}
+	}
+
+	//what the fast encoder has to get to on the test images, the better qualities can only do better than that
+	double getMinimumPSNR(const int& format) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1: return 35.0;
+		case HFR_TEXTURE_FORMAT_BC3: return 36.0;
+		case HFR_TEXTURE_FORMAT_BC5: return 44.0;
+		default: return 38.0;
+		}
+	}
+
+	std::string getName(const int& format, const int& quality) {
+		const char* qualities[] = { "fast", "normal", "best" };
+		return CookedTexture::getFormatName(format) + " " + qualities[quality];
+	}
+
+	//round trips on every format and quality keep at least the minimum, and a better quality never ends up worse
+	void compressionQuality() {
+		for (const int& format : FORMATS) {
+			const Image source = createSource(format, CHECK_SIZE, CHECK_SIZE);
+			double previous = 0.0;
+
+			for (int quality = HFR_COMPRESSION_FAST; quality <= HFR_COMPRESSION_BEST; ++quality) {
+				const CompressedImage compressed = TextureCompressor::compress(source, format, quality);
+				HBM_REQUIRE(compressed.data.size() == CookedTexture::getImageSize(format, CHECK_SIZE, CHECK_SIZE));
+
+				const double psnr = TextureCompressor::getPSNR(source, TextureCompressor::decompress(compressed), getComparedChannels(format));
+				report(getName(format, quality) + ": " + std::to_string(psnr) + " dB");
+
+				HBM_EXPECT(psnr >= getMinimumPSNR(format));
+				//a little slack, refining can trade a tiny bit of one channel for another
+				HBM_EXPECT(psnr >= previous - 0.05);
+				previous = psnr;
+			}
+		}
+	}
+
+	//a block of one color comes back as that color (give or take the 565 rounding), and sizes that aren't a multiple of 4 keep their size
+	void compressionEdgeCases() {
+		std::mt19937 random(SEED);
+		std::uniform_int_distribution<int> values(0, 255);
+
+		for (const int& format : FORMATS) {
+			const int channels = getComparedChannels(format);
+
+			for (int i = 0; i < 16; ++i) {
+				unsigned char color[4] = { (unsigned char)values(random), (unsigned char)values(random), (unsigned char)values(random), (unsigned char)values(random) };
+				if (format == HFR_TEXTURE_FORMAT_BC1)
+					color[3] = 255;
+
+				unsigned char pixels[64], decoded[64];
+
+				for (int texel = 0; texel < 16; ++texel)
+					std::memcpy(pixels + texel * 4, color, 4);
+
+				unsigned char block[16] = {};
+				TextureCompressor::encodeBlock(format, pixels, HFR_COMPRESSION_NORMAL, block);
+				TextureCompressor::decodeBlock(format, block, decoded);
+
+				int difference = 0;
+				for (int texel = 0; texel < 16; ++texel) {
+					for (int c = 0; c < channels; ++c)
+						difference = max(difference, std::abs((int)decoded[texel * 4 + c] - (int)color[c]));
+				}
+
+				//565 endpoints are the worst case, 3 bits of green aren't there
+				if (!HBM_EXPECT(difference <= 8))
+					report(getName(format, HFR_COMPRESSION_NORMAL) + " solid block is " + std::to_string(difference) + " off");
+			}
+
+			const Image source = createSource(format, ODD_WIDTH, ODD_HEIGHT);
+			const CompressedImage compressed = TextureCompressor::compress(source, format, HFR_COMPRESSION_FAST);
+			const Image decompressed = TextureCompressor::decompress(compressed);
+
+			HBM_EXPECT(compressed.data.size() == (size_t)((ODD_WIDTH + 3) / 4) * ((ODD_HEIGHT + 3) / 4) * CookedTexture::getBlockSize(format));
+			HBM_EXPECT(decompressed.width == ODD_WIDTH && decompressed.height == ODD_HEIGHT);
+			//the whole pattern squeezed into a few blocks is a lot busier than the big image, this only has to be the image and not garbage
+			HBM_EXPECT(TextureCompressor::getPSNR(source, decompressed, channels) >= ODD_MINIMUM_PSNR);
+		}
+	}
+
+	//range(0) is the format, range(1) the quality and range(2) the size, one level over the job system like cook does it
+	void textureCompression(BenchmarkState& state) {
+		const int format = (int)state.range(0);
+		const int quality = (int)state.range(1);
+		const int size = (int)state.range(2);
+		const Image source = createSource(format, size, size);
+
+		CompressedImage compressed;
+
+		while (state.keepRunning()) {
+			compressed = TextureCompressor::compress(source, format, quality);
+			doNotOptimize(compressed.data[0]);
+		}
+
+		const int64_t texels = (int64_t)size * size;
+		state.setItemsProcessed((int64_t)state.getIterations() * texels);
+		state.setBytesProcessed((int64_t)state.getIterations() * texels * 4);
+
+		//psnr and the memory it takes with its mips against rgba8 with its mips
+		state.counters["psnr"] = TextureCompressor::getPSNR(source, TextureCompressor::decompress(compressed), getComparedChannels(format));
+
+		size_t rgba = 0, blocks = 0;
+		for (int level = 0; level < ImageProcessing::getMipLevelAmount(size, size); ++level) {
+			const int levelSize = max(size >> level, 1);
+			rgba += CookedTexture::getImageSize(HFR_TEXTURE_FORMAT_RGBA8, levelSize, levelSize);
+			blocks += CookedTexture::getImageSize(format, levelSize, levelSize);
+		}
+
+		state.counters["bits/texel"] = (double)compressed.data.size() * 8.0 / (double)texels;
+		state.counters["saved %"] = 100.0 * (1.0 - (double)blocks / (double)rgba);
+		state.counters["MB with mips"] = (double)blocks / (1024.0 * 1024.0);
+	}
+}
+
+HBM_CHECK(compressionQuality);
+HBM_CHECK(compressionEdgeCases);
+
+//every format at every quality on a 1k texture, and the normal quality on a 4k one (the size the albedo sets come in)
+HBM_BENCHMARK(textureCompression)
+	->args({ HFR_TEXTURE_FORMAT_BC1, HFR_COMPRESSION_FAST, 1024 })->args({ HFR_TEXTURE_FORMAT_BC1, HFR_COMPRESSION_NORMAL, 1024 })->args({ HFR_TEXTURE_FORMAT_BC1, HFR_COMPRESSION_BEST, 1024 })
+	->args({ HFR_TEXTURE_FORMAT_BC3, HFR_COMPRESSION_FAST, 1024 })->args({ HFR_TEXTURE_FORMAT_BC3, HFR_COMPRESSION_NORMAL, 1024 })->args({ HFR_TEXTURE_FORMAT_BC3, HFR_COMPRESSION_BEST, 1024 })
+	->args({ HFR_TEXTURE_FORMAT_BC5, HFR_COMPRESSION_FAST, 1024 })->args({ HFR_TEXTURE_FORMAT_BC5, HFR_COMPRESSION_NORMAL, 1024 })->args({ HFR_TEXTURE_FORMAT_BC5, HFR_COMPRESSION_BEST, 1024 })
+	->args({ HFR_TEXTURE_FORMAT_BC7, HFR_COMPRESSION_FAST, 1024 })->args({ HFR_TEXTURE_FORMAT_BC7, HFR_COMPRESSION_NORMAL, 1024 })->args({ HFR_TEXTURE_FORMAT_BC7, HFR_COMPRESSION_BEST, 1024 })
+	->args({ HFR_TEXTURE_FORMAT_BC1, HFR_COMPRESSION_NORMAL, 4096 })->args({ HFR_TEXTURE_FORMAT_BC3, HFR_COMPRESSION_NORMAL, 4096 })->args({ HFR_TEXTURE_FORMAT_BC5, HFR_COMPRESSION_NORMAL, 4096 })
+	->args({ HFR_TEXTURE_FORMAT_BC7, HFR_COMPRESSION_NORMAL, 4096 })->unit(TimeUnit::Millisecond);
@@ -0,0 +1,263 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the gpu profiler on a made up gpu handed in through setBackend, there's no gl context here, the fake one finishes every frame
+//a set number of frames after it was submitted and moves its clock a set amount for every timestamp
+
+namespace {
+	//nanoseconds the fake clock moves for every timestamp written
+	const uint64_t TIMESTAMP_STEP = 250000;
+	const size_t FRAMES = 10;
+	//passes in one frame, each is two scopes so twice what a frame has queries for
+	const size_t OVERFLOW_PASSES = HFR_GPU_TIMER_QUERIES;
+
+	class FakeGpu {
+	private:
+		struct Query {
+			size_t frame = 0;
+			uint64_t time = 0;
+			bool live = false;
+		};
+
+		std::vector<Query> queries;
+		uint64_t clock = 1000000;
+
+	public:
+		size_t frame = 0;
+		//frames between submitting one and the gpu being done with it
+		size_t lag = 1;
+		size_t created = 0;
+		size_t stalls = 0;
+		int groups = 0;
+		int deepestGroup = 0;
+
+		//only what's still around, the pools all get their queries back on close
+		size_t getLiveQueries() const {
+			return (size_t)std::count_if(queries.begin(), queries.end(), [](const Query& query) { return query.live; });
+		}
+
+		GpuTimerBackend createBackend() {
+			GpuTimerBackend out;
+
+			out.createQueries = [this](const size_t& amount, uint32_t* created) {
+				for (size_t i = 0; i < amount; ++i) {
+					created[i] = (uint32_t)queries.size();
+					queries.push_back(Query());
+					queries.back().live = true;
+				}
+
+				this->created += amount;
+			};
+
+			out.deleteQueries = [this](const size_t& amount, const uint32_t* deleted) {
+				for (size_t i = 0; i < amount; ++i)
+					queries[deleted[i]].live = false;
+			};
+
+			out.writeTimestamp = [this](const uint32_t& query) {
+				clock += TIMESTAMP_STEP;
+				queries[query].frame = frame;
+				queries[query].time = clock;
+			};
+
+			out.isAvailable = [this](const uint32_t& query) {
+				return frame >= queries[query].frame + lag;
+			};
+
+			//asking for a result that isn't there would wait on the gpu
+			out.getTimestamp = [this](const uint32_t& query) {
+				stalls += frame < queries[query].frame + lag ? 1 : 0;
+				return queries[query].time;
+			};
+
+			out.getTime = [this]() { return clock; };
+
+			out.pushGroup = [this](const char*) {
+				groups++;
+				deepestGroup = max(deepestGroup, groups);
+			};
+
+			out.popGroup = [this]() { groups--; };
+
+			return out;
+		}
+	};
+
+	//turns the profiler off again when it goes, nothing after the check should talk to the fake
+	class BackendScope {
+	public:
+		FakeGpu gpu;
+
+		BackendScope() {
+			GpuProfiler::setBackend(gpu.createBackend());
+		}
+
+		~BackendScope() {
+			GpuProfiler::close();
+		}
+	};
+
+	void submitFrame(FakeGpu& gpu, const size_t& passes) {
+		for (size_t i = 0; i < passes; ++i) {
+			ProfileGpuTime("Gpu check pass");
+
+			{
+				ProfileGpuTime("Gpu check inner");
+			}
+		}
+
+		GpuProfiler::endFrame();
+		gpu.frame++;
+	}
+
+	bool isNear(const double& value, const double& expected) {
+		return std::fabs(value - expected) < 1e-9;
+	}
+
+	//a pass with one scope in it, the timings come out of the fake clock exactly, as many frames late as the gpu is behind
+	//and nothing ever asks for a result that isn't done
+	void gpuProfilerTimings() {
+		BackendScope scope;
+		FakeGpu& gpu = scope.gpu;
+
+		HBM_REQUIRE(GpuProfiler::isEnabled());
+
+		for (size_t i = 0; i < FRAMES; ++i)
+			submitFrame(gpu, 1);
+
+		const std::vector<GpuTiming>& frame = GpuProfiler::getFrame();
+		const double step = TIMESTAMP_STEP / 1000000.0;
+
+		HBM_EXPECT(GpuProfiler::getLatency() == 1);
+		HBM_EXPECT(GpuProfiler::getDroppedFrames() == 0);
+		HBM_REQUIRE(frame.size() == 2);
+
+		//the inner scope is the two timestamps in the middle
+		HBM_EXPECT(frame[0].depth == 0 && frame[1].depth == 1);
+		HBM_EXPECT(isNear(frame[0].start, 0) && isNear(frame[0].duration, step * 3));
+		HBM_EXPECT(isNear(frame[1].start, step) && isNear(frame[1].duration, step));
+		HBM_EXPECT(isNear(GpuProfiler::getFrameTime(), step * 3));
+
+		double milliseconds = 0;
+		HBM_EXPECT(GpuProfiler::getTotal("Gpu check inner", milliseconds) && isNear(milliseconds, step));
+		HBM_EXPECT(!GpuProfiler::getTotal("Gpu check nothing", milliseconds));
+
+		//every pool made its first batch of queries and never needed more, groups nest like the scopes
+		HBM_EXPECT(gpu.created == HFR_GPU_TIMER_FRAMES * 16);
+		HBM_EXPECT(gpu.groups == 0 && gpu.deepestGroup == 2);
+
+		//the oldest pool is still fine as long as the gpu is less than HFR_GPU_TIMER_FRAMES behind
+		gpu.lag = HFR_GPU_TIMER_FRAMES - 1;
+
+		for (size_t i = 0; i < FRAMES; ++i)
+			submitFrame(gpu, 1);
+
+		HBM_EXPECT(GpuProfiler::getLatency() == HFR_GPU_TIMER_FRAMES - 1);
+		HBM_EXPECT(GpuProfiler::getDroppedFrames() == 0);
+		HBM_EXPECT(gpu.stalls == 0);
+
+		GpuProfiler::close();
+		HBM_EXPECT(gpu.getLiveQueries() == 0);
+		HBM_EXPECT(!GpuProfiler::isEnabled());
+	}
+
+	//a gpu further behind than there are pools gets its frames dropped instead of waited on, a frame with more scopes than queries
+	//keeps the ones that fit with every end paired up, and while recording every scope comes out as a begin and end on the gpu thread
+	void gpuProfilerEdges() {
+		BackendScope scope;
+		FakeGpu& gpu = scope.gpu;
+
+		gpu.lag = HFR_GPU_TIMER_FRAMES + 2;
+
+		for (size_t i = 0; i < FRAMES; ++i)
+			submitFrame(gpu, 1);
+
+		HBM_EXPECT(GpuProfiler::getDroppedFrames() >= FRAMES - HFR_GPU_TIMER_FRAMES);
+		HBM_EXPECT(gpu.stalls == 0);
+
+		gpu.lag = 1;
+		const size_t dropped = GpuProfiler::getDroppedFrames();
+
+		submitFrame(gpu, OVERFLOW_PASSES);
+		submitFrame(gpu, 1);
+
+		const std::vector<GpuTiming>& frame = GpuProfiler::getFrame();
+		HBM_EXPECT(frame.size() <= HFR_GPU_TIMER_QUERIES / 2);
+		HBM_EXPECT(std::all_of(frame.begin(), frame.end(), [](const GpuTiming& timing) { return timing.depth <= 1 && timing.duration > 0; }));
+		HBM_EXPECT(GpuProfiler::getDroppedFrames() == dropped);
+		HBM_EXPECT(gpu.groups == 0);
+
+		report(std::to_string(OVERFLOW_PASSES * 2) + " scopes in one frame kept " + std::to_string(frame.size()) + ", " +
+			std::to_string(gpu.created) + " queries made in all");
+
+		submitFrame(gpu, 1);
+
+		ScopeProfiler::setRecording(true);
+
+		for (size_t i = 0; i < 4; ++i)
+			submitFrame(gpu, 2);
+
+		ScopeProfiler::setRecording(false);
+
+		std::vector<RecordedEvent> events;
+		GpuProfiler::takeRecorded(events);
+
+		int open = 0;
+		size_t backwards = 0;
+
+		for (size_t i = 0; i < events.size(); ++i) {
+			HBM_EXPECT(events[i].thread == HFR_GPU_TRACE_THREAD);
+			open += events[i].isEnd ? -1 : 1;
+			HBM_EXPECT(open >= 0);
+			backwards += i > 0 && events[i].ticks < events[i - 1].ticks ? 1 : 0;
+		}
+
+		//the frame from before recording with its one pass resolves in the first recorded one, the last one is still on the gpu
+		HBM_EXPECT(events.size() == 4 + 3 * 8);
+		HBM_EXPECT(open == 0 && backwards == 0);
+
+		//the scope profiler kept whatever the cpu did meanwhile, none of it matters here
+		ScopeProfiler::collect();
+		std::vector<RecordedEvent> cpuEvents;
+		ScopeProfiler::takeRecorded(cpuEvents);
+	}
+
+	//what a gpu scope costs the cpu on a backend that does nothing, range(0) scopes a frame
+	void gpuScope(BenchmarkState& state) {
+		GpuTimerBackend backend;
+		backend.createQueries = [](const size_t& amount, uint32_t* queries) {
+			for (size_t i = 0; i < amount; ++i)
+				queries[i] = (uint32_t)i;
+		};
+		backend.deleteQueries = [](const size_t&, const uint32_t*) {};
+		backend.writeTimestamp = [](const uint32_t&) {};
+		backend.isAvailable = [](const uint32_t&) { return true; };
+		backend.getTimestamp = [](const uint32_t& query) { return (uint64_t)query * TIMESTAMP_STEP; };
+
+		GpuProfiler::setBackend(backend);
+
+		const size_t scopes = (size_t)state.range(0);
+
+		while (state.keepRunning()) {
+			for (size_t i = 0; i < scopes; ++i) {
+				ProfileGpuTime("Gpu benchmark scope");
+			}
+
+			GpuProfiler::endFrame();
+		}
+
+		GpuProfiler::close();
+
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)scopes);
+	}
+}
+
+HBM_CHECK(gpuProfilerTimings);
+HBM_CHECK(gpuProfilerEdges);
+
+//up to the most a frame has queries for
+HBM_BENCHMARK(gpuScope)->range(8, HFR_GPU_TIMER_QUERIES / 2, 4)->unit(TimeUnit::Microsecond);
@@ -0,0 +1,201 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the gui side of the renderer without a gl context, the quad batcher gets a backend that only counts what it would have drawn
+//and the gui canvas only queues the quads of its dirty regions
+
+namespace {
+	const size_t GUI_ELEMENTS = 10000;
+	//an icon panel at the end of the gui, its atlas has ICON_PAGES pages
+	const size_t ICON_AMOUNT = 2000;
+	const unsigned int ICON_PAGES = 4;
+	const size_t MAX_DRAWS = 10;
+	const size_t EDITOR_ELEMENTS = 5000;
+	const Vec2f WINDOW_SIZE = Vec2f(1920, 1080);
+
+	//what the batcher handed to the backend in the last flush
+	struct DrawCount {
+		size_t quads = 0;
+		std::vector<size_t> draws;
+		int maxTextures = 0;
+	};
+
+	//counts into count for as long as it's around, flush without a backend only drops the quads so that's what's left afterwards
+	class CountingBackend {
+	public:
+		CountingBackend(DrawCount& count) {
+			QuadBatchBackend backend;
+
+			backend.begin = [&count](const void* instances, const size_t& amount, const size_t& instanceSize) {
+				count = DrawCount();
+				count.quads = amount;
+			};
+
+			backend.draw = [&count](const Shader& shader, const size_t& first, const size_t& quads, const unsigned int* textures, const int& textureAmount) {
+				count.draws.push_back(quads);
+				count.maxTextures = max(count.maxTextures, textureAmount);
+			};
+
+			QuadBatcher::setBackend(backend);
+		}
+
+		~CountingBackend() {
+			QuadBatcher::clear();
+			QuadBatcher::setBackend(QuadBatchBackend());
+		}
+	};
+
+	//the gui lays out against the window size, puts back whatever was there before (nothing without a window)
+	class WindowSizeScope {
+	private:
+		Vec2f previous;
+
+	public:
+		WindowSizeScope(const Vec2f& size) : previous(Renderer2D::getCurrentWindowSize()) {
+			Renderer2D::setWindowSize(size.x, size.y);
+		}
+
+		~WindowSizeScope() {
+			Renderer2D::setWindowSize(previous.x, previous.y);
+		}
+	};
+
+	//the first frame of a gui, everything gets laid out and drawn
+	void drawFirstFrame() {
+		GuiCanvas::invalidateAll();
+		GuiCanvas::submitDirtyRegions();
+		QuadBatcher::clear();
+	}
+
+	//an element in a row that's on screen, the rows go further down than the window does
+	GuiElement& getOnScreenElement(GuiWorkload& gui) {
+		GuiElement* row = gui.getRoot()->firstChild;
+
+		for (int i = 0; i < 10; ++i)
+			row = row->nextSibling;
+
+		GuiElement* element = row->firstChild;
+
+		for (int i = 0; i < 5; ++i)
+			element = element->nextSibling;
+
+		return *element;
+	}
+
+	//one element turning a degree more every frame, only it gets laid out again and only what's around it drawn again
+	void animate(GuiElement& element, const int& frame) {
+		element.rotation = (float)(frame % 360);
+		element.markDirty();
+	}
+
+	void submitIcons(const size_t& amount, const unsigned int& pages) {
+		for (size_t i = 0; i < amount; ++i) {
+			GuiQuad quad;
+			Renderer2D::placeQuad(quad, Vec2f((float)(i % 50) * 24, (float)(i / 50) * 24), Vec2f(20, 20), 0, Vec2f(0, 0), HFR_PIXEL_SIZE);
+
+			quad.textureID = 1 + (unsigned int)(i % pages);
+			quad.color = Vec4f(1, 1, 1, 1);
+
+			QuadBatcher::submit(quad, Renderer2D::guiImageShader);
+		}
+	}
+
+	//a gui of 10k elements (frames and then an icon panel over a few atlas pages) takes a handful of draws, one per shader change,
+	//and icons from more pages than there are texture slots start a new draw every time the slots fill up
+	void quadBatchDraws() {
+		DrawCount count;
+		CountingBackend backend(count);
+
+		GuiWorkload gui(GUI_ELEMENTS - ICON_AMOUNT);
+
+		for (size_t i = 0; i < gui.frames.size(); ++i)
+			Renderer2D::render(*gui.frames[i]);
+
+		submitIcons(ICON_AMOUNT, ICON_PAGES);
+
+		const size_t submitted = QuadBatcher::getQueuedQuadAmount();
+		QuadBatcher::flush();
+
+		HBM_EXPECT(count.quads == submitted);
+		HBM_EXPECT(QuadBatcher::getDrawCalls() == count.draws.size());
+		HBM_EXPECT(std::accumulate(count.draws.begin(), count.draws.end(), (size_t)0) == submitted);
+		HBM_EXPECT(count.draws.size() < MAX_DRAWS);
+		HBM_EXPECT(count.maxTextures == (int)ICON_PAGES);
+
+		report(std::to_string(submitted) + " quads in " + std::to_string(count.draws.size()) + " draws");
+
+		//every page is new to the draw once the slots are full, so each draw gets exactly one quad per slot
+		submitIcons(ICON_AMOUNT, HFR_QUAD_BATCH_TEXTURE_SLOTS * 2);
+		QuadBatcher::flush();
+
+		HBM_EXPECT(count.draws.size() == (ICON_AMOUNT + HFR_QUAD_BATCH_TEXTURE_SLOTS - 1) / HFR_QUAD_BATCH_TEXTURE_SLOTS);
+		HBM_EXPECT(count.maxTextures == HFR_QUAD_BATCH_TEXTURE_SLOTS);
+
+		report(std::to_string(ICON_AMOUNT) + " icons from " + std::to_string(HFR_QUAD_BATCH_TEXTURE_SLOTS * 2) + " pages in " + std::to_string(count.draws.size()) + " draws");
+	}
+
+	//a frame where nothing changed lays out and draws nothing, one animated element only gets the part of the screen around it drawn again
+	void guiRedrawsDirtyRegions() {
+		WindowSizeScope window(WINDOW_SIZE);
+		GuiWorkload gui(EDITOR_ELEMENTS);
+
+		drawFirstFrame();
+		const size_t visible = GuiCanvas::getRedrawnQuads();
+		HBM_EXPECT(GuiCanvas::getLayoutAmount() == gui.frames.size() + 1);
+
+		GuiCanvas::submitDirtyRegions();
+		HBM_EXPECT(GuiCanvas::getLayoutAmount() == 0);
+		HBM_EXPECT(GuiCanvas::getRedrawnRegions() == 0);
+		HBM_EXPECT(QuadBatcher::getQueuedQuadAmount() == 0);
+
+		animate(getOnScreenElement(gui), 10);
+		GuiCanvas::submitDirtyRegions();
+
+		//the element, its row and the root behind it, and the neighbours its box reaches
+		HBM_EXPECT(GuiCanvas::getLayoutAmount() == 1);
+		HBM_EXPECT(GuiCanvas::getRedrawnRegions() == 1);
+		HBM_EXPECT(GuiCanvas::getRedrawnQuads() < visible / 10);
+
+		report(std::to_string(GuiCanvas::getRedrawnQuads()) + " of the " + std::to_string(visible) + " quads on screen drawn again for one animated element");
+		QuadBatcher::clear();
+	}
+
+	//range(0) is 0 for idle frames and 1 for one element animating, a frame is what render does minus the gl (layout, merging the dirty regions
+	//and queueing what's in them), with a full redraw being what guiLayout and the draws of every element would cost
+	void guiCanvasFrame(BenchmarkState& state) {
+		WindowSizeScope window(WINDOW_SIZE);
+		GuiWorkload gui(EDITOR_ELEMENTS);
+
+		const bool animated = state.range(0) != 0;
+		GuiElement& element = getOnScreenElement(gui);
+
+		drawFirstFrame();
+
+		int frame = 0;
+		size_t quads = 0;
+
+		while (state.keepRunning()) {
+			if (animated)
+				animate(element, frame++);
+
+			GuiCanvas::submitDirtyRegions();
+			quads += GuiCanvas::getRedrawnQuads();
+			QuadBatcher::clear();
+		}
+
+		state.counters["quads/frame"] = (double)quads / (double)state.getIterations();
+		state.counters["layouts"] = (double)GuiCanvas::getLayoutAmount();
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)EDITOR_ELEMENTS);
+	}
+}
+
+HBM_CHECK(quadBatchDraws);
+HBM_CHECK(guiRedrawsDirtyRegions);
+
+//a 5k element editor gui sitting there and with one element animating
+HBM_BENCHMARK(guiCanvasFrame)->arg(0)->arg(1)->unit(TimeUnit::Microsecond);
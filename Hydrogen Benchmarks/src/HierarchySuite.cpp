@@ -0,0 +1,389 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//parenting, reparenting and destroying objects in a tree, and propagating a million node hierarchy
+
+namespace {
+	const unsigned int SEED = 1;
+	const float SCENE_EXTENT = 200.0f;
+	const int64_t LARGE_HIERARCHY = 1000000;
+
+	bool isNear(const Mat4f& value, const Mat4f& expected) {
+		const float* v = &value.m00;
+		const float* e = &expected.m00;
+
+		for (int i = 0; i < 16; ++i) {
+			if (std::fabs(v[i] - e[i]) > 1e-3f * (1.0f + std::fabs(e[i])))
+				return false;
+		}
+
+		return true;
+	}
+
+	void randomize(Transform& transform, std::mt19937& random) {
+		std::uniform_real_distribution<float> position(-10, 10);
+		std::uniform_real_distribution<float> angle(0, 360);
+
+		transform.position.x = position(random);
+		transform.position.y = position(random);
+		transform.position.z = position(random);
+		transform.rotation.y = angle(random);
+		transform.markDirty();
+	}
+
+	//what the world matrix of node should be, walking up to the root
+	Mat4f getExpectedWorld(const HierarchySystem& hierarchy, const std::vector<Transform>& transforms, const unsigned int& node) {
+		Mat4f out = transforms[node].createLocalMatrix();
+
+		for (unsigned int parent = hierarchy.getParent(node); parent != HFR_NULL_ENTITY; parent = hierarchy.getParent(parent)) {
+			Mat4f world;
+			MatrixKernels::multiplyScalar(transforms[parent].createLocalMatrix(), out, world);
+			out = world;
+		}
+
+		return out;
+	}
+
+	bool isPlaced(const HierarchySystem& hierarchy, const std::vector<Transform>& transforms) {
+		for (unsigned int node = 0; node < (unsigned int)transforms.size(); ++node) {
+			if (!isNear(transforms[node].worldMatrix, getExpectedWorld(hierarchy, transforms, node)))
+				return false;
+		}
+
+		return true;
+	}
+
+	//every node comes after its parent in the packed order
+	bool isParentBeforeChild(HierarchySystem& hierarchy) {
+		const std::vector<unsigned int>& order = hierarchy.getOrder();
+		std::vector<size_t> slot(order.size() == 0 ? 0 : *std::max_element(order.begin(), order.end()) + 1, 0);
+
+		for (size_t i = 0; i < order.size(); ++i)
+			slot[order[i]] = i;
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			const unsigned int parent = hierarchy.getParent(order[i]);
+
+			if (parent != HFR_NULL_ENTITY && slot[parent] >= i)
+				return false;
+		}
+
+		return true;
+	}
+
+	void hierarchyReparenting() {
+		std::mt19937 random(SEED);
+		std::vector<Transform> transforms(6);
+
+		for (size_t i = 0; i < transforms.size(); ++i)
+			randomize(transforms[i], random);
+
+		HierarchySystem hierarchy;
+
+		for (unsigned int i = 0; i < (unsigned int)transforms.size(); ++i)
+			hierarchy.add(i);
+
+		//0 -> 1 -> 2, 0 -> 3, 4 and 5 on their own
+		HBM_EXPECT(hierarchy.setParent(1, 0));
+		HBM_EXPECT(hierarchy.setParent(2, 1));
+		HBM_EXPECT(hierarchy.setParent(3, 0));
+		hierarchy.update(transforms.data());
+
+		HBM_EXPECT(isPlaced(hierarchy, transforms));
+		HBM_EXPECT(isParentBeforeChild(hierarchy));
+		HBM_EXPECT(hierarchy.getHierarchy(0).childAmount == 2);
+
+		//1 takes 2 with it under 3, 2 itself didn't change but its world matrix did
+		HBM_EXPECT(hierarchy.setParent(1, 3));
+		hierarchy.update(transforms.data());
+
+		HBM_EXPECT(isPlaced(hierarchy, transforms));
+		HBM_EXPECT(isParentBeforeChild(hierarchy));
+		HBM_EXPECT(hierarchy.isDescendant(2, 0) && hierarchy.isDescendant(2, 3));
+		HBM_EXPECT(hierarchy.getHierarchy(0).childAmount == 1);
+
+		//loops get turned down and change nothing
+		HBM_EXPECT(!hierarchy.setParent(0, 2));
+		HBM_EXPECT(!hierarchy.setParent(3, 3));
+		HBM_EXPECT(hierarchy.getParent(0) == HFR_NULL_ENTITY && hierarchy.getParent(3) == 0);
+
+		//moving a parent moves what's under it
+		transforms[3].setPosition(Vec3f(5, 0, -5));
+		hierarchy.update(transforms.data());
+		HBM_EXPECT(isPlaced(hierarchy, transforms));
+
+		//a whole subtree under a root that was on its own
+		HBM_EXPECT(hierarchy.setParent(3, 5));
+		hierarchy.update(transforms.data());
+		HBM_EXPECT(isPlaced(hierarchy, transforms));
+		HBM_EXPECT(isParentBeforeChild(hierarchy));
+
+		HBM_REQUIRE(hierarchy.getParent(1) == 3);
+		hierarchy.removeParent(1);
+		hierarchy.update(transforms.data());
+		HBM_EXPECT(isNear(transforms[1].worldMatrix, transforms[1].createLocalMatrix()));
+		HBM_EXPECT(isPlaced(hierarchy, transforms));
+
+		//removing a node makes its children roots
+		hierarchy.remove(1);
+		hierarchy.update(transforms.data());
+		HBM_EXPECT(!hierarchy.contains(1));
+		HBM_EXPECT(hierarchy.getParent(2) == HFR_NULL_ENTITY);
+		HBM_EXPECT(isNear(transforms[2].worldMatrix, transforms[2].createLocalMatrix()));
+		HBM_EXPECT(hierarchy.getNodeAmount() == transforms.size() - 1);
+	}
+
+	//a node with transform index 0 has no transform, slot 0 is the empty component and has to stay untouched
+	void hierarchySkipsMissingTransforms() {
+		std::mt19937 random(SEED);
+		std::vector<Transform> transforms(3);
+
+		for (size_t i = 1; i < transforms.size(); ++i)
+			randomize(transforms[i], random);
+
+		//node 0 -> transform 1, node 1 has none, node 2 -> transform 2
+		const unsigned int indexes[] = { 1, 0, 2 };
+
+		HierarchySystem hierarchy;
+		HBM_EXPECT(hierarchy.setParent(1, 0));
+		HBM_EXPECT(hierarchy.setParent(2, 1));
+		hierarchy.update(transforms.data(), indexes);
+
+		const Mat4f empty;
+		HBM_EXPECT(transforms[0].dirty);
+		HBM_EXPECT(std::memcmp(&transforms[0].worldMatrix, &empty, sizeof(Mat4f)) == 0);
+		HBM_EXPECT(std::memcmp(&transforms[0].localMatrix, &empty, sizeof(Mat4f)) == 0);
+
+		//under a node without a transform it's placed like a root
+		HBM_EXPECT(isNear(transforms[2].worldMatrix, transforms[2].createLocalMatrix()));
+		HBM_EXPECT(!transforms[1].dirty && !transforms[2].dirty);
+
+		//and the same when only the parent moves
+		transforms[1].setPosition(Vec3f(1, 2, 3));
+		hierarchy.update(transforms.data(), indexes);
+		HBM_EXPECT(isNear(transforms[2].worldMatrix, transforms[2].createLocalMatrix()));
+		HBM_EXPECT(transforms[0].dirty);
+	}
+
+	int stoppedScripts = 0;
+	int updatedScripts = 0;
+
+	class Counter : public GameObject {
+	protected:
+		void update() override {
+			updatedScripts++;
+		}
+
+		void stop() override {
+			stoppedScripts++;
+		}
+	};
+
+	//destroys its own object the first time it updates
+	class SelfDestroyer : public Counter {
+	protected:
+		void update() override {
+			Counter::update();
+			destroy();
+		}
+	};
+
+	template<typename T>
+	void addScript(Scene& scene, const Entity& entity) {
+		NativeScript script = NativeScript();
+		script.scriptAmount = 1;
+		script.instantiateScript = [](NativeScript* nativeScript, const unsigned int& index) {
+			nativeScript->scripts[index] = new T();
+		};
+
+		Entity target = entity;
+		scene.getSystem()->getComponentManager()->addComponent<NativeScript>(target, std::move(script));
+	}
+
+	GameObject getObject(Scene& scene, const unsigned int& index) {
+		return GameObject((*scene.getSystem()->getEntities())[index], &scene);
+	}
+
+	//the subtree goes, scripts get stopped, the arrays stay packed and recycled ids start out of the tree
+	void sceneDestroyGameObject() {
+		std::unique_ptr<Scene> scene(createEntityScene(6, createCubeMesh(), SCENE_EXTENT, SEED));
+		System& system = *scene->getSystem();
+
+		std::vector<GameObject> objects;
+		std::map<unsigned int, std::string> names;
+
+		for (unsigned int i = 0; i < 6; ++i) {
+			objects.push_back(getObject(*scene, i));
+			names[objects.back().entity.id] = objects.back().getComponent<Tag>().name;
+		}
+
+		//0 -> 1 -> 2, 0 -> 3, 4 -> 5
+		HBM_REQUIRE(objects[1].setParent(objects[0]));
+		HBM_REQUIRE(objects[2].setParent(objects[1]));
+		HBM_REQUIRE(objects[3].setParent(objects[0]));
+		HBM_REQUIRE(objects[5].setParent(objects[4]));
+
+		addScript<Counter>(*scene, objects[2].entity);
+		addScript<Counter>(*scene, objects[5].entity);
+
+		stoppedScripts = 0;
+		scene->update();
+		scene->updateTransforms();
+
+		const Mat4f fourWorld = objects[4].getComponent<Transform>().worldMatrix;
+		scene->destroyGameObject(objects[0]);
+
+		HBM_EXPECT(system.getEntityAmount() == 2);
+		HBM_EXPECT(stoppedScripts == 1);
+
+		for (int i = 0; i < 4; ++i) {
+			HBM_EXPECT(!system.hasEntity(objects[i].entity));
+			HBM_EXPECT(!scene->getHierarchy()->contains(objects[i].entity.id));
+		}
+
+		//what's left still has its own components after the arrays got packed
+		for (unsigned int i = 0; i < system.getEntityAmount(); ++i) {
+			GameObject object = getObject(*scene, i);
+			HBM_EXPECT(object.getComponent<Tag>().name == names[object.entity.id]);
+		}
+
+		HBM_EXPECT(system.getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT)->getSize() == 2);
+		HBM_EXPECT(isNear(objects[4].getComponent<Transform>().worldMatrix, fourWorld));
+		HBM_EXPECT(objects[5].getParent().entity.id == objects[4].entity.id);
+
+		//ids come back out of a queue, fill the scene up so the destroyed ones get used again
+		while (system.getEntityAmount() < HFR_MAX_ENTITIES)
+			scene->createGameObject("filler");
+
+		for (int i = 0; i < 4; ++i) {
+			HBM_REQUIRE(system.hasEntity(objects[i].entity));
+
+			const Hierarchy& node = scene->getHierarchy()->getHierarchy(objects[i].entity.id);
+			HBM_EXPECT(node.parent == HFR_NULL_ENTITY && node.firstChild == HFR_NULL_ENTITY && node.childAmount == 0);
+			HBM_EXPECT(objects[i].getComponent<Tag>().name == "filler");
+		}
+
+		scene->updateTransforms();
+		const Transform& recycled = objects[2].getComponent<Transform>();
+		HBM_EXPECT(isNear(recycled.worldMatrix, recycled.createLocalMatrix()));
+
+		scene->destroyGameObject(objects[4]);
+		HBM_EXPECT(stoppedScripts == 2);
+	}
+
+	//a script destroying its own object keeps running until the phase is done, the others still get their update
+	void scriptDestroysItself() {
+		std::unique_ptr<Scene> scene(createEntityScene(3, createCubeMesh(), SCENE_EXTENT, SEED));
+		System& system = *scene->getSystem();
+
+		const Entity doomed = getObject(*scene, 0).entity;
+		addScript<SelfDestroyer>(*scene, doomed);
+		addScript<Counter>(*scene, getObject(*scene, 1).entity);
+		addScript<Counter>(*scene, getObject(*scene, 2).entity);
+
+		updatedScripts = 0;
+		stoppedScripts = 0;
+		scene->update();
+
+		HBM_EXPECT(updatedScripts == 3);
+		HBM_EXPECT(stoppedScripts == 1);
+		HBM_EXPECT(!system.hasEntity(doomed));
+		HBM_EXPECT(system.getEntityAmount() == 2);
+
+		scene->update();
+		HBM_EXPECT(updatedScripts == 5);
+
+		for (unsigned int i = system.getEntityAmount(); i-- > 0;)
+			scene->destroyGameObject(getObject(*scene, i));
+
+		HBM_EXPECT(stoppedScripts == 3);
+		HBM_EXPECT(system.getEntityAmount() == 0);
+	}
+
+	//range(0) nodes in chains range(1) long, node i is the child of i - 1 unless it starts a chain
+	struct HierarchyWorkload {
+		std::vector<Transform> transforms;
+		HierarchySystem hierarchy;
+		std::vector<unsigned int> roots;
+
+		HierarchyWorkload(const size_t& nodes, const size_t& depth) : transforms(nodes) {
+			std::mt19937 random(SEED);
+
+			for (size_t i = 0; i < nodes; ++i) {
+				randomize(transforms[i], random);
+
+				if (i % depth == 0) {
+					hierarchy.add((unsigned int)i);
+					roots.push_back((unsigned int)i);
+				}
+				else
+					hierarchy.setParent((unsigned int)i, (unsigned int)i - 1);
+			}
+
+			hierarchy.update(transforms.data());
+		}
+	};
+
+	//the roots move, so every world matrix under them gets redone
+	void hierarchyUpdate(BenchmarkState& state) {
+		HierarchyWorkload workload((size_t)state.range(0), (size_t)state.range(1));
+
+		while (state.keepRunning()) {
+			state.pauseTiming();
+			for (size_t i = 0; i < workload.roots.size(); ++i)
+				workload.transforms[workload.roots[i]].markDirty();
+			state.resumeTiming();
+
+			workload.hierarchy.update(workload.transforms.data());
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//nothing moved, a flag check per node
+	void hierarchyUpdateStatic(BenchmarkState& state) {
+		HierarchyWorkload workload((size_t)state.range(0), (size_t)state.range(1));
+
+		while (state.keepRunning())
+			workload.hierarchy.update(workload.transforms.data());
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//one chain moves to another root every frame, so the packed order gets rebuilt every time
+	void hierarchyReparent(BenchmarkState& state) {
+		HierarchyWorkload workload((size_t)state.range(0), (size_t)state.range(1));
+
+		if (workload.roots.size() < 3) {
+			state.skipWithError("Needs at least three chains");
+			return;
+		}
+
+		const unsigned int moved = workload.roots[0];
+		unsigned int parent = workload.roots[1];
+
+		while (state.keepRunning()) {
+			parent = parent == workload.roots[1] ? workload.roots[2] : workload.roots[1];
+
+			workload.hierarchy.setParent(moved, parent);
+			workload.hierarchy.update(workload.transforms.data());
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+}
+
+HBM_CHECK(hierarchyReparenting);
+HBM_CHECK(hierarchySkipsMissingTransforms);
+HBM_CHECK(sceneDestroyGameObject);
+HBM_CHECK(scriptDestroysItself);
+
+//a million nodes with no hierarchy at all, shallow chains and deep ones
+HBM_BENCHMARK(hierarchyUpdate)->args({ LARGE_HIERARCHY, 1 })->args({ LARGE_HIERARCHY, 16 })->args({ LARGE_HIERARCHY, 1024 })->unit(TimeUnit::Millisecond);
+HBM_BENCHMARK(hierarchyUpdateStatic)->args({ LARGE_HIERARCHY, 1 })->args({ LARGE_HIERARCHY, 16 })->args({ LARGE_HIERARCHY, 1024 })->unit(TimeUnit::Millisecond);
+HBM_BENCHMARK(hierarchyReparent)->args({ LARGE_HIERARCHY, 16 })->args({ LARGE_HIERARCHY, 1024 })->unit(TimeUnit::Millisecond);
@@ -0,0 +1,201 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//ImageProcessing's simd kernels against the scalar ones, and whole mip chains of a 4k texture on every instruction set it has
+
+namespace {
+	const unsigned int SEED = 1;
+	const int LARGE_SIZE = 4096;
+	//odd sizes and ones that aren't a multiple of the vector width, so the tails and the odd level sizes get hit
+	const int IMAGE_SIZES[][2] = { { 1, 1 }, { 2, 2 }, { 3, 5 }, { 18, 6 }, { 66, 34 }, { 129, 64 } };
+	//float paths can round the last bit the other way
+	const int TOLERANCE = 1;
+
+	class InstructionSetScope {
+	private:
+		int previous;
+
+	public:
+		InstructionSetScope() : previous(ImageProcessing::getInstructionSet()) {}
+		~InstructionSetScope() {
+			ImageProcessing::setInstructionSet(previous);
+		}
+	};
+
+	Image createRandomImage(const int& width, const int& height, std::mt19937& random) {
+		Image out(width, height, 4, NULL);
+		std::uniform_int_distribution<int> values(0, 255);
+
+		for (size_t i = 0; i < (size_t)width * height * 4; ++i)
+			out.data[i] = (unsigned char)values(random);
+
+		return out;
+	}
+
+	//made once, it's 64MB
+	const Image& getLargeImage() {
+		static Image image;
+
+		if (!image.hasData()) {
+			std::mt19937 random(SEED);
+			image = createRandomImage(LARGE_SIZE, LARGE_SIZE, random);
+		}
+
+		return image;
+	}
+
+	int getDifference(const unsigned char* left, const unsigned char* right, const size_t& count) {
+		int out = 0;
+
+		for (size_t i = 0; i < count; ++i)
+			out = max(out, std::abs((int)left[i] - (int)right[i]));
+
+		return out;
+	}
+
+	int getDifference(const Image& left, const Image& right) {
+		if (left.width != right.width || left.height != right.height || left.channels != right.channels)
+			return 256;
+
+		return getDifference(left.data, right.data, (size_t)left.width * left.height * left.channels);
+	}
+
+	int getDifference(const std::vector<Image>& left, const std::vector<Image>& right) {
+		if (left.size() != right.size())
+			return 256;
+
+		int out = 0;
+		for (size_t i = 0; i < left.size(); ++i)
+			out = max(out, getDifference(left[i], right[i]));
+
+		return out;
+	}
+
+	void reportSet(const int& set, const std::string& what, const int& width, const int& height) {
+		report(MatrixKernels::getInstructionSetName(set) + " " + what + " at " + std::to_string(width) + "x" + std::to_string(height));
+	}
+
+	//the in place kernels on every instruction set come out the same as the scalar references
+	void imageKernelsMatchScalar() {
+		InstructionSetScope scope;
+		std::mt19937 random(SEED);
+
+		for (int set = HFR_SIMD_SCALAR; set <= min(MatrixKernels::detectInstructionSet(), HFR_SIMD_AVX2); ++set) {
+			ImageProcessing::setInstructionSet(set);
+
+			for (const auto& size : IMAGE_SIZES) {
+				const Image image = createRandomImage(size[0], size[1], random);
+				const size_t count = (size_t)size[0] * size[1];
+
+				Image premultiplied = image.clone();
+				Image expected = image.clone();
+				ImageProcessing::premultiplyAlpha(premultiplied);
+				ImageProcessing::premultiplyAlphaScalar(expected.data, count);
+
+				if (!HBM_EXPECT(getDifference(premultiplied, expected) <= TOLERANCE))
+					reportSet(set, "premultiplyAlpha", size[0], size[1]);
+
+				const int order[] = { 2, 1, 0, 3 };
+				Image swizzled = image.clone();
+				expected = image.clone();
+				ImageProcessing::swizzle(swizzled, order[0], order[1], order[2], order[3]);
+				ImageProcessing::swizzleScalar(expected.data, count, order);
+
+				if (!HBM_EXPECT(getDifference(swizzled, expected) == 0))
+					reportSet(set, "swizzle", size[0], size[1]);
+
+				Image normals = image.clone();
+				expected = image.clone();
+				ImageProcessing::renormalizeNormals(normals);
+				ImageProcessing::renormalizeNormalsScalar(expected.data, count);
+
+				if (!HBM_EXPECT(getDifference(normals, expected) <= TOLERANCE))
+					reportSet(set, "renormalizeNormals", size[0], size[1]);
+
+				//the box kernel only takes even sizes, the mip chain takes care of the odd ones itself
+				if (size[0] % 2 == 0 && size[1] % 2 == 0) {
+					Image halfExpected(size[0] / 2, size[1] / 2, 4, NULL);
+					ImageProcessing::downsampleBoxScalar(image.data, size[0], size[1], halfExpected.data);
+					const Image half = ImageProcessing::downsample(image, MipSettings());
+
+					if (!HBM_EXPECT(getDifference(half, halfExpected) == 0))
+						reportSet(set, "downsample", size[0], size[1]);
+				}
+			}
+		}
+	}
+
+	//every filter with and without srgb makes the same chain as on the scalar kernels
+	void mipChainsMatchScalar() {
+		InstructionSetScope scope;
+		std::mt19937 random(SEED);
+
+		const int filters[] = { HFR_FILTER_BOX, HFR_FILTER_TRIANGLE, HFR_FILTER_KAISER };
+
+		for (const auto& size : IMAGE_SIZES) {
+			const Image image = createRandomImage(size[0], size[1], random);
+
+			for (const int& filter : filters) {
+				for (int srgb = 0; srgb < 2; ++srgb) {
+					MipSettings settings;
+					settings.filter = filter;
+					settings.srgb = srgb != 0;
+
+					ImageProcessing::setInstructionSet(HFR_SIMD_SCALAR);
+					const std::vector<Image> expected = ImageProcessing::generateMipChain(image, settings);
+
+					HBM_EXPECT((int)expected.size() == ImageProcessing::getMipLevelAmount(size[0], size[1]) - 1);
+
+					for (int set = HFR_SIMD_SSE2; set <= min(MatrixKernels::detectInstructionSet(), HFR_SIMD_AVX2); ++set) {
+						ImageProcessing::setInstructionSet(set);
+
+						if (!HBM_EXPECT(getDifference(ImageProcessing::generateMipChain(image, settings), expected) <= TOLERANCE))
+							reportSet(set, "mip chain with filter " + std::to_string(filter) + (srgb ? " in srgb" : ""), size[0], size[1]);
+					}
+				}
+			}
+		}
+	}
+
+	//range(0) is the instruction set, range(1) the filter and range(2) 1 for srgb, the whole chain of a 4096x4096 rgba texture
+	void mipChain(BenchmarkState& state) {
+		InstructionSetScope scope;
+
+		const int set = (int)state.range(0);
+		ImageProcessing::setInstructionSet(set);
+
+		if (ImageProcessing::getInstructionSet() != set) {
+			state.skipWithError(MatrixKernels::getInstructionSetName(set) + " isn't supported on this cpu");
+			return;
+		}
+
+		const Image& image = getLargeImage();
+
+		MipSettings settings;
+		settings.filter = (int)state.range(1);
+		settings.srgb = state.range(2) != 0;
+
+		while (state.keepRunning()) {
+			std::vector<Image> chain = ImageProcessing::generateMipChain(image, settings);
+			doNotOptimize(chain.back().data[0]);
+		}
+
+		const int64_t bytes = (int64_t)LARGE_SIZE * LARGE_SIZE * 4;
+		state.setBytesProcessed((int64_t)state.getIterations() * bytes);
+
+		if (state.realTime > 0)
+			state.counters["ms/chain"] = state.realTime * 1000.0 / (double)state.getIterations();
+	}
+}
+
+HBM_CHECK(imageKernelsMatchScalar);
+HBM_CHECK(mipChainsMatchScalar);
+
+//the scalar reference against sse2 and avx2 for the box filter (linear and srgb) and the kaiser one, avx-512 would run the avx2 kernels
+HBM_BENCHMARK(mipChain)->args({ HFR_SIMD_SCALAR, HFR_FILTER_BOX, 0 })->args({ HFR_SIMD_SSE2, HFR_FILTER_BOX, 0 })->args({ HFR_SIMD_AVX2, HFR_FILTER_BOX, 0 })
+	->args({ HFR_SIMD_SCALAR, HFR_FILTER_BOX, 1 })->args({ HFR_SIMD_SSE2, HFR_FILTER_BOX, 1 })->args({ HFR_SIMD_AVX2, HFR_FILTER_BOX, 1 })
+	->args({ HFR_SIMD_SCALAR, HFR_FILTER_KAISER, 0 })->args({ HFR_SIMD_SSE2, HFR_FILTER_KAISER, 0 })->args({ HFR_SIMD_AVX2, HFR_FILTER_KAISER, 0 })->unit(TimeUnit::Millisecond);
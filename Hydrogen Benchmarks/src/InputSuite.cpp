@@ -0,0 +1,277 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//input without a window, everything goes in through pushEvent like the glfw callbacks would put it there, the key and action edges
+//a frame gets out of it, what happens when the ring buffer is full and a recorded session replayed against what it did live
+
+namespace {
+	const unsigned int SEED = 1;
+	const int KEY = GLFW_KEY_SPACE;
+	const int BUTTON = GLFW_MOUSE_BUTTON_LEFT;
+	const size_t RECORDED_FRAMES = 500;
+	//events pushed past a full ring buffer
+	const size_t OVERFLOW_EVENTS = 76;
+
+	InputEvent createEvent(const InputEventType& type, const int& code, const int& action) {
+		InputEvent out;
+		out.time = Time::getTime();
+		out.type = type;
+		out.code = code;
+		out.action = action;
+		return out;
+	}
+
+	InputEvent createMouseEvent(const InputEventType& type, const float& x, const float& y) {
+		InputEvent out = createEvent(type, 0, 0);
+		out.x = x;
+		out.y = y;
+		return out;
+	}
+
+	//nothing held, the mouse at the corner and every edge gone, so a frame after it is the same however the one before went
+	void releaseAll() {
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_RELEASE));
+		Input::pushEvent(createEvent(InputEventType::MouseButton, BUTTON, GLFW_RELEASE));
+		Input::pushEvent(createMouseEvent(InputEventType::CursorPosition, 0, 0));
+
+		Input::update();
+		Input::update();
+	}
+
+	//the actions the checks use, and input left the way it was found (nothing held, not recording or replaying) once it goes
+	class InputScope {
+	public:
+		InputScope() {
+			releaseAll();
+
+			Input::bindAction("Input check jump", InputBinding(InputSource::Key, KEY, 1));
+			Input::bindAction("Input check jump", InputBinding(InputSource::MouseButton, BUTTON, 1));
+			Input::bindAction("Input check look", InputBinding(InputSource::MouseX, 0, 0.5f));
+		}
+
+		~InputScope() {
+			Input::stopRecording();
+			Input::stopReplay();
+
+			Input::unbindAction("Input check jump");
+			Input::unbindAction("Input check look");
+
+			releaseAll();
+		}
+	};
+
+	//everything a frame of game code could ask for
+	struct FrameState {
+		bool key = false;
+		bool keyDown = false;
+		bool keyUp = false;
+		bool button = false;
+		bool action = false;
+		bool actionDown = false;
+		bool actionUp = false;
+		float look = 0;
+		Vec2f mouse;
+		Vec2f scroll;
+
+		static FrameState get() {
+			FrameState out;
+			out.key = Input::getKey(KEY);
+			out.keyDown = Input::getKeyDown(KEY);
+			out.keyUp = Input::getKeyUp(KEY);
+			out.button = Input::getMouseButton(BUTTON);
+			out.action = Input::getAction("Input check jump");
+			out.actionDown = Input::getActionDown("Input check jump");
+			out.actionUp = Input::getActionUp("Input check jump");
+			out.look = Input::getActionValue("Input check look");
+			out.mouse = Input::getMouseMovement();
+			out.scroll = Input::getScrollMovement();
+			return out;
+		}
+
+		bool operator==(const FrameState& other) const {
+			return key == other.key && keyDown == other.keyDown && keyUp == other.keyUp && button == other.button && action == other.action &&
+				actionDown == other.actionDown && actionUp == other.actionUp && look == other.look && mouse.x == other.mouse.x && mouse.y == other.mouse.y &&
+				scroll.x == other.scroll.x && scroll.y == other.scroll.y;
+		}
+	};
+
+	//a few made up events a frame, keys going down, up and repeating, the button, the mouse moving and scrolling
+	void pushRandomEvents(std::mt19937& random) {
+		const int amount = (int)(random() % 4);
+
+		for (int i = 0; i < amount; ++i) {
+			switch (random() % 4) {
+			case 0: Input::pushEvent(createEvent(InputEventType::Key, KEY, (int)(random() % 3))); break;
+			case 1: Input::pushEvent(createEvent(InputEventType::MouseButton, BUTTON, (int)(random() % 2))); break;
+			case 2: Input::pushEvent(createMouseEvent(InputEventType::CursorPosition, (float)(random() % 800), (float)(random() % 600))); break;
+			default: Input::pushEvent(createMouseEvent(InputEventType::Scroll, 0, (float)(random() % 3) - 1)); break;
+			}
+		}
+	}
+
+	//a press, a repeat and a release each in their own frame, then a tap that goes down and up between two frames and still has both edges,
+	//actions follow the keys and buttons bound to them and the mouse axis they're bound to, codes out of range don't count for anything
+	void inputEdges() {
+		InputScope scope;
+
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_PRESS));
+		Input::update();
+		HBM_EXPECT(Input::getKey(KEY) && Input::getKeyDown(KEY) && !Input::getKeyUp(KEY));
+		HBM_EXPECT(Input::getAction("Input check jump") && Input::getActionDown("Input check jump"));
+
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_REPEAT));
+		Input::update();
+		HBM_EXPECT(Input::getKey(KEY) && !Input::getKeyDown(KEY));
+		HBM_EXPECT(Input::getAction("Input check jump") && !Input::getActionDown("Input check jump"));
+
+		//the button keeps the action held after the key lets go
+		Input::pushEvent(createEvent(InputEventType::MouseButton, BUTTON, GLFW_PRESS));
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_RELEASE));
+		Input::update();
+		HBM_EXPECT(!Input::getKey(KEY) && Input::getKeyUp(KEY) && Input::getMouseButtonDown(BUTTON));
+		HBM_EXPECT(Input::getAction("Input check jump") && !Input::getActionUp("Input check jump"));
+
+		Input::pushEvent(createEvent(InputEventType::MouseButton, BUTTON, GLFW_RELEASE));
+		Input::update();
+		HBM_EXPECT(Input::getMouseButtonUp(BUTTON) && Input::getActionUp("Input check jump"));
+
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_PRESS));
+		Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_RELEASE));
+		Input::update();
+		HBM_EXPECT(!Input::getKey(KEY) && Input::getKeyDown(KEY) && Input::getKeyUp(KEY));
+		HBM_EXPECT(!Input::getAction("Input check jump") && Input::getActionDown("Input check jump") && Input::getActionUp("Input check jump"));
+
+		Input::update();
+		HBM_EXPECT(!Input::getKeyDown(KEY) && !Input::getKeyUp(KEY) && !Input::getActionUp("Input check jump"));
+
+		//two scrolls in a frame add up, the movement only lasts the frame it happened in
+		Input::pushEvent(createMouseEvent(InputEventType::CursorPosition, 10, 4));
+		Input::pushEvent(createMouseEvent(InputEventType::Scroll, 0, 1));
+		Input::pushEvent(createMouseEvent(InputEventType::Scroll, 0, 2));
+		Input::update();
+		HBM_EXPECT(Input::getMouseMovement().x == 10 && Input::getMouseMovement().y == 4 && Input::getScrollMovement().y == 3);
+		HBM_EXPECT(Input::getActionValue("Input check look") == 5 && Input::getAction("Input check look"));
+
+		Input::update();
+		HBM_EXPECT(Input::getMouseMovement().x == 0 && Input::getScrollMovement().y == 0 && !Input::getAction("Input check look"));
+
+		Input::pushEvent(createEvent(InputEventType::Key, -1, GLFW_PRESS));
+		Input::pushEvent(createEvent(InputEventType::Key, GLFW_KEY_LAST + 1, GLFW_PRESS));
+		Input::update();
+		HBM_EXPECT(!Input::getKey(-1) && !Input::getKeyDown(GLFW_KEY_LAST + 1));
+		HBM_EXPECT(!Input::getAction("Input check unbound") && Input::getActionValue("Input check unbound") == 0);
+	}
+
+	//a frame with more events than the ring buffer holds keeps the oldest ones and counts the rest as dropped
+	void inputOverflow() {
+		InputScope scope;
+
+		const size_t dropped = Input::getDroppedEvents();
+
+		for (size_t i = 0; i < HFR_INPUT_EVENTS + OVERFLOW_EVENTS; ++i)
+			Input::pushEvent(createMouseEvent(InputEventType::Scroll, 0, 1));
+
+		Input::update();
+
+		HBM_EXPECT(Input::getDroppedEvents() - dropped == OVERFLOW_EVENTS);
+		HBM_EXPECT(Input::getScrollMovement().y == (float)HFR_INPUT_EVENTS);
+	}
+
+	//a random session gets recorded, saved and loaded again, then replayed twice with live input coming in meanwhile,
+	//every replayed frame has to look exactly like it did live, and a recording that's cut off doesn't load at all
+	void inputReplay() {
+		InputScope scope;
+
+		std::mt19937 random(SEED);
+		std::vector<FrameState> live;
+
+		Input::startRecording();
+
+		for (size_t i = 0; i < RECORDED_FRAMES; ++i) {
+			pushRandomEvents(random);
+			Input::update();
+			live.push_back(FrameState::get());
+		}
+
+		Input::stopRecording();
+		HBM_REQUIRE(Input::getRecording().frames.size() == RECORDED_FRAMES);
+
+		const std::string path = getAssetDirectory() + "input/session.hinp";
+		HBM_REQUIRE(Input::getRecording().save(path));
+
+		InputRecording loaded;
+		HBM_REQUIRE(loaded.load(path));
+		HBM_REQUIRE(loaded.frames.size() == RECORDED_FRAMES);
+
+		for (int run = 0; run < 2; ++run) {
+			releaseAll();
+			Input::startReplay(loaded);
+
+			size_t mismatched = 0;
+
+			for (size_t i = 0; i < RECORDED_FRAMES; ++i) {
+				//thrown away while replaying
+				Input::pushEvent(createEvent(InputEventType::Key, KEY, GLFW_PRESS));
+				Input::update();
+
+				mismatched += FrameState::get() == live[i] ? 0 : 1;
+			}
+
+			HBM_EXPECT(mismatched == 0);
+			HBM_EXPECT(!Input::isReplaying());
+		}
+
+		std::string file;
+
+		{
+			std::ifstream in(path, std::ios_base::binary);
+			file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		const std::string brokenPath = getAssetDirectory() + "input/cut off.hinp";
+
+		{
+			std::ofstream out(brokenPath, std::ios_base::binary | std::ios_base::trunc);
+			out.write(file.data(), file.size() - 5);
+		}
+
+		InputRecording broken;
+		HBM_EXPECT(!broken.load(brokenPath) && broken.frames.empty());
+
+		report(std::to_string(RECORDED_FRAMES) + " frames recorded into " + std::to_string(file.size()) + " bytes and replayed twice");
+	}
+
+	//range(0) events a frame taken out of the ring buffer and turned into key, mouse and action state
+	void inputUpdate(BenchmarkState& state) {
+		InputScope scope;
+
+		const size_t events = (size_t)state.range(0);
+		size_t frame = 0;
+
+		while (state.keepRunning()) {
+			for (size_t i = 0; i < events; ++i) {
+				if (i % 2 == 0)
+					Input::pushEvent(createEvent(InputEventType::Key, KEY, (int)((frame + i / 2) % 2)));
+				else
+					Input::pushEvent(createMouseEvent(InputEventType::CursorPosition, (float)(frame % 800), (float)i));
+			}
+
+			Input::update();
+			frame++;
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)events);
+	}
+}
+
+HBM_CHECK(inputEdges);
+HBM_CHECK(inputOverflow);
+HBM_CHECK(inputReplay);
+
+//up to a full ring buffer
+HBM_BENCHMARK(inputUpdate)->arg(0)->range(2, HFR_INPUT_EVENTS, 8)->unit(TimeUnit::Nanosecond);
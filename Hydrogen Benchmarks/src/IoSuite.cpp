@@ -0,0 +1,188 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the lz4 codec and the pack archives against the loose res folder they're built from, and reading all of res/ both ways
+
+namespace {
+	const unsigned int SEED = 1;
+
+	enum ResSource {
+		Loose = 0,
+		Packed = 1,
+		PackedLZ4 = 2
+	};
+
+	std::string getArchivePath(const bool& compressed) {
+		return getAssetDirectory() + (compressed ? "res lz4.hpak" : "res.hpak");
+	}
+
+	//built from res/ the first time something needs them
+	bool buildArchives() {
+		static int built = -1;
+
+		if (built < 0)
+			built = PackArchive::build(HFR_RES, getArchivePath(false), false) && PackArchive::build(HFR_RES, getArchivePath(true), true) ? 1 : 0;
+
+		return built == 1;
+	}
+
+	std::vector<std::string> getResFiles() {
+		PackArchive archive;
+		std::vector<std::string> out;
+
+		if (!buildArchives() || !archive.open(getArchivePath(false)))
+			return out;
+
+		for (size_t i = 0; i < archive.getEntryAmount(); ++i)
+			out.push_back(archive.getEntryName(i));
+
+		return out;
+	}
+
+	std::shared_ptr<FileMount> createMount(const int& source) {
+		if (source == Loose)
+			return std::make_shared<DirectoryMount>(HFR_RES);
+
+		std::shared_ptr<PackArchive> archive = std::make_shared<PackArchive>();
+
+		if (!archive->open(getArchivePath(source == PackedLZ4)))
+			return nullptr;
+
+		return archive;
+	}
+
+	bool isSame(const FileData& left, const FileData& right) {
+		return left.isValid() && right.isValid() && left.getSize() == right.getSize() && (left.getSize() == 0 || std::memcmp(left.getData(), right.getData(), left.getSize()) == 0);
+	}
+
+	//random bytes compress badly, runs compress well, real files are somewhere in between
+	std::vector<unsigned char> createData(const size_t& size, std::mt19937& random) {
+		std::vector<unsigned char> out(size);
+		std::uniform_int_distribution<int> bytes(0, 255);
+		std::uniform_int_distribution<int> runs(1, 64);
+
+		for (size_t i = 0; i < size;) {
+			const unsigned char value = (unsigned char)bytes(random);
+			const size_t run = bytes(random) < 128 ? 1 : (size_t)runs(random);
+
+			for (size_t j = 0; j < run && i < size; ++j, ++i)
+				out[i] = j % 2 == 0 ? value : (unsigned char)bytes(random);
+		}
+
+		return out;
+	}
+
+	void lz4RoundTrip() {
+		std::mt19937 random(SEED);
+		const size_t sizes[] = { 0, 1, 5, 12, 13, 64, 1000, 65536, 300000 };
+
+		for (const size_t& size : sizes) {
+			const std::vector<unsigned char> data = createData(size, random);
+			std::vector<unsigned char> compressed;
+			PackArchive::compressLZ4(data.data(), data.size(), compressed);
+
+			std::vector<unsigned char> out(size + 1, 0xAB);
+			HBM_EXPECT(PackArchive::decompressLZ4(compressed.data(), compressed.size(), out.data(), size));
+			HBM_EXPECT(std::equal(data.begin(), data.end(), out.begin()));
+			HBM_EXPECT(out[size] == 0xAB);
+
+			//the wrong size and damaged bytes get turned down, the destination isn't written past its end either way
+			if (size > 0) {
+				HBM_EXPECT(!PackArchive::decompressLZ4(compressed.data(), compressed.size(), out.data(), size - 1));
+				HBM_EXPECT(!PackArchive::decompressLZ4(compressed.data(), compressed.size() - 1, out.data(), size));
+			}
+
+			std::uniform_int_distribution<size_t> position(0, compressed.empty() ? 0 : compressed.size() - 1);
+
+			for (int i = 0; i < 50 && !compressed.empty(); ++i) {
+				std::vector<unsigned char> damaged = compressed;
+				damaged[position(random)] ^= (unsigned char)(1 + i);
+
+				out[size] = 0xAB;
+				PackArchive::decompressLZ4(damaged.data(), damaged.size(), out.data(), size);
+				HBM_EXPECT(out[size] == 0xAB);
+			}
+		}
+	}
+
+	//every entry of both archives is byte for byte the loose file
+	void packedResMatchesLoose() {
+		const std::vector<std::string> files = getResFiles();
+		HBM_REQUIRE(!files.empty());
+
+		std::shared_ptr<FileMount> loose = createMount(Loose);
+		std::shared_ptr<FileMount> packed = createMount(Packed);
+		std::shared_ptr<FileMount> compressed = createMount(PackedLZ4);
+		HBM_REQUIRE(packed != nullptr && compressed != nullptr);
+
+		size_t mismatches = 0;
+
+		for (size_t i = 0; i < files.size(); ++i) {
+			const FileData original = loose->read(files[i]);
+
+			if (!isSame(packed->read(files[i]), original) || !isSame(compressed->read(files[i]), original) || compressed->getFileSize(files[i]) != (long long)original.getSize()) {
+				report(files[i] + " differs from the loose file");
+				mismatches++;
+			}
+		}
+
+		HBM_EXPECT(mismatches == 0);
+		HBM_EXPECT(!packed->exists("not a file.png") && !packed->read("not a file.png").isValid());
+
+		report(std::to_string(files.size()) + " files");
+	}
+
+	//a byte per page, so every page of a mapped file actually gets read in
+	uint64_t touch(const FileData& file) {
+		uint64_t sum = 0;
+
+		for (size_t i = 0; i < file.getSize(); i += 4096)
+			sum += file.getData()[i];
+
+		return sum;
+	}
+
+	//range(0) is a ResSource, with range(1) every pass gets a new mount (an archive gets opened and mapped again),
+	//without it the mount stays, the os file cache is warm after the first pass either way
+	void resRead(BenchmarkState& state) {
+		const std::vector<std::string> files = getResFiles();
+
+		if (files.empty()) {
+			state.skipWithError("Couldn't pack " + HFR_RES);
+			return;
+		}
+
+		const int source = (int)state.range(0);
+		const bool cold = state.range(1) != 0;
+
+		std::shared_ptr<FileMount> mount = createMount(source);
+		uint64_t sum = 0;
+		int64_t bytes = 0;
+
+		while (state.keepRunning()) {
+			if (cold)
+				mount = createMount(source);
+
+			for (size_t i = 0; i < files.size(); ++i) {
+				const FileData file = mount->read(files[i]);
+				sum += touch(file);
+				bytes += (int64_t)file.getSize();
+			}
+		}
+
+		doNotOptimize(sum);
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)files.size());
+		state.setBytesProcessed(bytes);
+	}
+}
+
+HBM_CHECK(lz4RoundTrip);
+HBM_CHECK(packedResMatchesLoose);
+
+//loose, packed and packed with lz4, each with a new mount every pass and with one that stays
+HBM_BENCHMARK(resRead)->args({ Loose, 1 })->args({ Packed, 1 })->args({ PackedLZ4, 1 })->args({ Loose, 0 })->args({ Packed, 0 })->args({ PackedLZ4, 0 })->unit(TimeUnit::Millisecond);
@@ -0,0 +1,226 @@
+#include "hfpch.h"
+#include "Json.h"
+
+namespace HBM {
+
+	namespace {
+		//objects and arrays don't go deeper than this in anything the framework writes, it keeps a broken file from blowing the stack
+		const int MAXIMUM_DEPTH = 64;
+
+		class JsonParser {
+		private:
+			const std::string& text;
+			size_t position = 0;
+
+			void skipSpace() {
+				while (position < text.size() && std::isspace((unsigned char)text[position]))
+					position += 1;
+			}
+
+			bool expect(const char& c) {
+				skipSpace();
+
+				if (position >= text.size() || text[position] != c)
+					return false;
+
+				position += 1;
+				return true;
+			}
+
+			bool expectWord(const std::string& word) {
+				if (text.compare(position, word.size(), word) != 0)
+					return false;
+
+				position += word.size();
+				return true;
+			}
+
+			void appendUtf8(std::string& out, const unsigned int& codepoint) {
+				if (codepoint < 0x80)
+					out += (char)codepoint;
+				else if (codepoint < 0x800) {
+					out += (char)(0xC0 | (codepoint >> 6));
+					out += (char)(0x80 | (codepoint & 0x3F));
+				}
+				else {
+					out += (char)(0xE0 | (codepoint >> 12));
+					out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+					out += (char)(0x80 | (codepoint & 0x3F));
+				}
+			}
+
+			bool parseString(std::string& out) {
+				if (!expect('"'))
+					return false;
+
+				out.clear();
+
+				while (position < text.size() && text[position] != '"') {
+					const char c = text[position++];
+
+					//control characters have to be escaped
+					if ((unsigned char)c < 0x20)
+						return false;
+
+					if (c != '\\') {
+						out += c;
+						continue;
+					}
+
+					if (position >= text.size())
+						return false;
+
+					const char escaped = text[position++];
+
+					switch (escaped) {
+					case '"': out += '"'; break;
+					case '\\': out += '\\'; break;
+					case '/': out += '/'; break;
+					case 'b': out += '\b'; break;
+					case 'f': out += '\f'; break;
+					case 'n': out += '\n'; break;
+					case 'r': out += '\r'; break;
+					case 't': out += '\t'; break;
+					case 'u': {
+						if (position + 4 > text.size() || !std::all_of(text.begin() + position, text.begin() + position + 4, [](const char& digit) { return std::isxdigit((unsigned char)digit) != 0; }))
+							return false;
+
+						appendUtf8(out, (unsigned int)std::stoul(text.substr(position, 4), nullptr, 16));
+						position += 4;
+						break;
+					}
+					default: return false;
+					}
+				}
+
+				return expect('"');
+			}
+
+			bool parseNumber(double& out) {
+				//strtod also takes things json doesn't (hex, inf, a leading +), a json number starts with a digit or a minus
+				if (!std::isdigit((unsigned char)text[position]) && text[position] != '-')
+					return false;
+
+				const char* start = text.c_str() + position;
+				char* end = nullptr;
+				out = std::strtod(start, &end);
+
+				position += end - start;
+				return end != start;
+			}
+
+			bool parseArray(JsonValue& out, const int& depth) {
+				out.type = JsonType::Array;
+
+				if (expect(']'))
+					return true;
+
+				do {
+					out.items.push_back(JsonValue());
+
+					if (!parseValue(out.items.back(), depth + 1))
+						return false;
+				} while (expect(','));
+
+				return expect(']');
+			}
+
+			bool parseObject(JsonValue& out, const int& depth) {
+				out.type = JsonType::Object;
+
+				if (expect('}'))
+					return true;
+
+				do {
+					out.names.push_back("");
+					out.items.push_back(JsonValue());
+
+					if (!parseString(out.names.back()) || !expect(':') || !parseValue(out.items.back(), depth + 1))
+						return false;
+				} while (expect(','));
+
+				return expect('}');
+			}
+
+		public:
+			JsonParser(const std::string& _text) : text(_text) {}
+
+			bool parseValue(JsonValue& out, const int& depth) {
+				skipSpace();
+
+				if (position >= text.size() || depth > MAXIMUM_DEPTH)
+					return false;
+
+				switch (text[position]) {
+				case '{':
+					position += 1;
+					return parseObject(out, depth);
+				case '[':
+					position += 1;
+					return parseArray(out, depth);
+				case '"':
+					out.type = JsonType::String;
+					return parseString(out.string);
+				case 't':
+					out.type = JsonType::Boolean;
+					out.boolean = true;
+					return expectWord("true");
+				case 'f':
+					out.type = JsonType::Boolean;
+					out.boolean = false;
+					return expectWord("false");
+				case 'n':
+					out.type = JsonType::Null;
+					return expectWord("null");
+				default:
+					out.type = JsonType::Number;
+					return parseNumber(out.number);
+				}
+			}
+
+			bool isAtEnd() {
+				skipSpace();
+				return position == text.size();
+			}
+		};
+	}
+
+	bool JsonValue::is(const JsonType& expected) const {
+		return type == expected;
+	}
+
+	const JsonValue* JsonValue::find(const std::string& name) const {
+		if (type != JsonType::Object)
+			return nullptr;
+
+		for (size_t i = 0; i < names.size(); ++i) {
+			if (names[i] == name)
+				return &items[i];
+		}
+
+		return nullptr;
+	}
+
+	const JsonValue* JsonValue::find(const std::string& name, const JsonType& expected) const {
+		const JsonValue* out = find(name);
+		return out != nullptr && out->type == expected ? out : nullptr;
+	}
+
+	bool parseJson(const std::string& text, JsonValue& out) {
+		out = JsonValue();
+
+		JsonParser parser(text);
+		return parser.parseValue(out, 0) && parser.isAtEnd();
+	}
+
+	bool readJson(const std::string& path, JsonValue& out) {
+		std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+
+		if (!file.is_open())
+			return false;
+
+		const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return parseJson(text, out);
+	}
+
+}
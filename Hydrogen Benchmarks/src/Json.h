@@ -0,0 +1,42 @@
+#ifndef HBM_JSON_HEADER_INCLUDE
+#define HBM_JSON_HEADER_INCLUDE
+
+#include <string>
+#include <vector>
+
+//just enough json to check what the framework writes (traces, telemetry reports) against what the format wants
+namespace HBM {
+
+	enum class JsonType {
+		Null,
+		Boolean,
+		Number,
+		String,
+		Array,
+		Object
+	};
+
+	struct JsonValue {
+		JsonType type = JsonType::Null;
+		bool boolean = false;
+		double number = 0;
+		std::string string;
+		//the elements of an array or the values of an object, in the order they were written
+		std::vector<JsonValue> items;
+		//the member names of an object, names[i] goes with items[i]
+		std::vector<std::string> names;
+
+		bool is(const JsonType& expected) const;
+		//nullptr when it isn't an object or has no member called name
+		const JsonValue* find(const std::string& name) const;
+		//the member if it's there and of that type, nullptr otherwise
+		const JsonValue* find(const std::string& name, const JsonType& expected) const;
+	};
+
+	//false when text isn't exactly one json value (whitespace around it is fine)
+	bool parseJson(const std::string& text, JsonValue& out);
+	bool readJson(const std::string& path, JsonValue& out);
+
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the async logger, what a log call costs the thread making it on its own and with 16 threads at once, and whether what comes out of the
+//log file is what got logged (formats, Debug calls, records too big for a buffer) and the buffers of threads that exited go away
+
+namespace {
+	const size_t THREAD_AMOUNT = 16;
+	const size_t RECORDS_PER_THREAD = 1000;
+	//logged from every thread of the throughput benchmark each iteration, a record is 56 bytes so about what fits in a buffer
+	const size_t BATCH_RECORDS = 4096;
+
+	//what HFR_LOG_INFO does, on a site that isn't rate limited so every record counts
+	void logRecord(const size_t& record, const size_t& thread) {
+		static LogSite site(LogLevel::Info, "Logger check", "record {} of thread {}", DebugColor::White, 0);
+
+		if (site.allow())
+			Logger::write(site, record, thread);
+	}
+
+	//the writer thread running, every level let through and nothing on the console, puts all of it back when it goes
+	class LoggerScope {
+	private:
+		LogLevel level;
+
+	public:
+		LoggerScope(const std::string& path) : level(Logger::level) {
+			Logger::level = LogLevel::Trace;
+			Logger::setConsole(false);
+			Logger::setFile(path);
+			Logger::init();
+		}
+
+		~LoggerScope() {
+			Logger::close();
+			Logger::setFile("");
+			Logger::setConsole(true);
+			Logger::level = level;
+		}
+	};
+
+	std::vector<std::string> readLines(const std::string& path) {
+		std::ifstream file(path);
+		std::vector<std::string> out;
+		std::string line;
+
+		while (std::getline(file, line))
+			out.push_back(line);
+
+		return out;
+	}
+
+	//the lines that end with text, the file has a timestamp and the level in front of it
+	size_t countEnding(const std::vector<std::string>& lines, const std::string& text) {
+		return (size_t)std::count_if(lines.begin(), lines.end(), [&text](const std::string& line) {
+			return line.size() >= text.size() && line.compare(line.size() - text.size(), text.size(), text) == 0;
+		});
+	}
+
+	//every kind of argument through a macro and through the Debug calls that take a format, and a record bigger than HFR_LOG_RECORD_BYTES
+	//that comes out cut down with a note instead of not at all
+	void loggerFormatting() {
+		const std::string path = getAssetDirectory() + "logs/formatting.log";
+
+		{
+			LoggerScope scope(path);
+
+			const std::string text = "text";
+			HFR_LOG_INFO("Logger check", "{} {} {} {} {} {} {}", -7, (size_t)42, 1.5f, true, 'c', text, "literal");
+			HFR_LOG_WARNING("Logger check", "{} more braces than arguments {}", 1);
+			Debug::systemErr("Debug check {} of {}", 3, text);
+			Debug::systemLog("Debug check with a {} format", "deferred");
+
+			HFR_LOG_INFO("Logger check", "oversized {}", std::string(HFR_LOG_RECORD_BYTES * 2, 'x'));
+		}
+
+		const std::vector<std::string> lines = readLines(path);
+
+		HBM_EXPECT(countEnding(lines, "System Message: -7 42 1.5 true c text literal") == 1);
+		HBM_EXPECT(countEnding(lines, "System Warning: 1 more braces than arguments {}") == 1);
+		HBM_EXPECT(countEnding(lines, "System Error: Debug check 3 of text") == 1);
+		HBM_EXPECT(countEnding(lines, "System Message: Debug check with a deferred format") == 1);
+
+		std::vector<std::string>::const_iterator oversized = std::find_if(lines.begin(), lines.end(), [](const std::string& line) {
+			return line.find("oversized xxx") != std::string::npos;
+		});
+
+		HBM_REQUIRE(oversized != lines.end());
+		HBM_EXPECT(oversized->size() <= HFR_LOG_RECORD_BYTES);
+		//the string is its size and its characters
+		HBM_EXPECT(oversized->find("cut off, the record was " + std::to_string(5 + HFR_LOG_RECORD_BYTES * 2) + " bytes") != std::string::npos);
+	}
+
+	//THREAD_AMOUNT threads that log and exit, every record fits into the buffer of its thread so all of them are in the file,
+	//and the buffers are gone once it's all written
+	void loggerThreads() {
+		const std::string path = getAssetDirectory() + "logs/threads.log";
+
+		size_t buffers = 0;
+		size_t dropped = 0;
+
+		{
+			LoggerScope scope(path);
+
+			Logger::flush();
+			buffers = Logger::getBufferAmount();
+			dropped = Logger::getDroppedRecords();
+
+			std::vector<std::thread> threads;
+
+			for (size_t i = 0; i < THREAD_AMOUNT; ++i) {
+				threads.emplace_back([i]() {
+					for (size_t j = 0; j < RECORDS_PER_THREAD; ++j)
+						logRecord(j, i);
+				});
+			}
+
+			for (size_t i = 0; i < threads.size(); ++i)
+				threads[i].join();
+
+			Logger::flush();
+
+			HBM_EXPECT(Logger::getBufferAmount() == buffers);
+			dropped = Logger::getDroppedRecords() - dropped;
+		}
+
+		const std::vector<std::string> lines = readLines(path);
+		size_t records = 0;
+
+		for (size_t i = 0; i < THREAD_AMOUNT; ++i) {
+			const size_t thread = countEnding(lines, " of thread " + std::to_string(i));
+			HBM_EXPECT(thread == RECORDS_PER_THREAD);
+			records += thread;
+		}
+
+		HBM_EXPECT(dropped == 0);
+
+		report(std::to_string(records) + " records from " + std::to_string(THREAD_AMOUNT) + " threads written, " + std::to_string(dropped) + " dropped, " +
+			std::to_string(Logger::getBufferAmount()) + " buffers left");
+	}
+
+	//a site that goes away like the ones of an unloaded script dll, its strings are overwritten right after like the dlls memory would be,
+	//what it logged still comes out and the records after it don't touch it
+	void loggerSiteRemoved() {
+		const std::string path = getAssetDirectory() + "logs/site removed.log";
+
+		{
+			LoggerScope scope(path);
+
+			std::string format = "from the removed site {}";
+			std::unique_ptr<LogSite> site(new LogSite(LogLevel::Info, "Logger check", format.c_str(), DebugColor::White, 0));
+
+			if (site->allow())
+				Logger::write(*site, 1);
+
+			site.reset();
+			format.assign(format.size(), '?');
+
+			HFR_LOG_INFO("Logger check", "after the removed site {}", 2);
+		}
+
+		const std::vector<std::string> lines = readLines(path);
+
+		HBM_EXPECT(countEnding(lines, "System Message: from the removed site 1") == 1);
+		HBM_EXPECT(countEnding(lines, "System Message: after the removed site 2") == 1);
+	}
+
+	//what a log call costs the thread making it, the writer thread formats and writes it out to the file meanwhile
+	void loggerWrite(BenchmarkState& state) {
+		LoggerScope scope(getAssetDirectory() + "logs/benchmark.log");
+
+		const size_t dropped = Logger::getDroppedRecords();
+		size_t i = 0;
+
+		while (state.keepRunning())
+			logRecord(i++, 0);
+
+		state.counters["dropped"] = (double)(Logger::getDroppedRecords() - dropped);
+		state.setItemsProcessed((int64_t)state.getIterations());
+	}
+
+	//the filtered out ones are what most trace logging in a release build comes to
+	void loggerFiltered(BenchmarkState& state) {
+		LoggerScope scope(getAssetDirectory() + "logs/benchmark.log");
+		Logger::level = LogLevel::Warning;
+
+		size_t i = 0;
+
+		while (state.keepRunning())
+			logRecord(i++, 0);
+
+		state.setItemsProcessed((int64_t)state.getIterations());
+	}
+
+	//range(0) threads logging BATCH_RECORDS each at once, records a second over all of them, a thread the writer can't keep up with
+	//drops records instead of waiting
+	void loggerThroughput(BenchmarkState& state) {
+		LoggerScope scope(getAssetDirectory() + "logs/benchmark.log");
+
+		const size_t amount = (size_t)state.range(0);
+		const size_t dropped = Logger::getDroppedRecords();
+
+		while (state.keepRunning()) {
+			std::vector<std::thread> threads;
+
+			for (size_t i = 0; i < amount; ++i) {
+				threads.emplace_back([i]() {
+					for (size_t j = 0; j < BATCH_RECORDS; ++j)
+						logRecord(j, i);
+				});
+			}
+
+			for (size_t i = 0; i < threads.size(); ++i)
+				threads[i].join();
+		}
+
+		state.counters["dropped"] = (double)(Logger::getDroppedRecords() - dropped) / (double)state.getIterations();
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)(amount * BATCH_RECORDS));
+	}
+}
+
+HBM_CHECK(loggerFormatting);
+HBM_CHECK(loggerThreads);
+HBM_CHECK(loggerSiteRemoved);
+
+HBM_BENCHMARK(loggerWrite)->unit(TimeUnit::Nanosecond);
+HBM_BENCHMARK(loggerFiltered)->unit(TimeUnit::Nanosecond);
+HBM_BENCHMARK(loggerThroughput)->arg(1)->arg(4)->arg(THREAD_AMOUNT)->unit(TimeUnit::Millisecond);
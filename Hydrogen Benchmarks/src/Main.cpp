@@ -0,0 +1,384 @@
+#include "hfpch.h"
+#include HFR_FREETYPE
+//with HFR_TRACK_ALLOCATIONS on, what the checks allocate in here counts along with what the framework does
+#include HFR_ALLOCATION_OPERATORS
+#include "Benchmark.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//Hydrogen Benchmarks [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>] [--benchmark_out=<results.json>] [--benchmark_list_tests] [--checks_only] [--skip_checks]
+//no window and no gl context, only the cpu side of the engine gets measured
+//
+//the checks run first, then the benchmarks, the filter picks from both, the synthetic ecs, transform, culling, loader, gui and text
+//benchmarks are in here and every area with more to it has its own suite file with its checks next to its benchmarks (Scene, Time,
+//Input, Replay, Logger, Profiler, Trace, Gpu, Telemetry and so on), the gpu ones run on a made up backend and the clock can be made up too
+//so the checks come out the same on any machine
+//
+//exits with 0 when everything passed, 1 when a check failed, a benchmark stopped with an error, the arguments are wrong or the json
+//couldn't be written
+
+namespace {
+	const unsigned int SEED = 1;
+	//entities go in a cube this wide around the camera, about a quarter of them end up in view
+	const float SCENE_EXTENT = 200.0f;
+	const float ASPECT_RATIO = 16.0f / 9.0f;
+	const size_t TEXT_LENGTH = 32;
+
+	//the scene has to go through destroyMovers first when it has them
+	using ScenePointer = std::unique_ptr<Scene>;
+
+	ScenePointer createScene(BenchmarkState& state) {
+		return ScenePointer(createEntityScene((size_t)state.range(0), createCubeMesh(), SCENE_EXTENT, SEED));
+	}
+
+	//rasterized the first time a text benchmark runs, it holds a freetype face so it has to go before FreeType::close
+	std::unique_ptr<Font> textFont;
+
+	const Font* getFont() {
+		if (textFont == nullptr) {
+			textFont = std::unique_ptr<Font>(new Font(HFR_RES + "fonts/oxygen/Oxygen-Regular.ttf"));
+			textFont->size = Vec2f(0, 24);
+			textFont->logStatus = false;
+			textFont->rasterize();
+		}
+
+		return textFont->isRasterized() ? textFont.get() : nullptr;
+	}
+
+	//the way Scene::extract and runScripts get at components, a map lookup per array and the index of every entity
+	void ecsIteration(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		System& system = *scene->getSystem();
+		ComponentManager& components = *system.getComponentManager();
+
+		float sum = 0;
+
+		while (state.keepRunning()) {
+			for (unsigned int i = 0; i < system.getEntityAmount(); ++i) {
+				Entity entity = (*system.getEntities())[i];
+
+				const Transform& transform = components.getComponent<Transform>(entity);
+				const MeshComponent& mesh = components.getComponent<MeshComponent>(entity);
+				const Tag& tag = components.getComponent<Tag>(entity);
+
+				sum += transform.position.x + (float)mesh.meshes.size() + (float)tag.name.size();
+			}
+		}
+
+		doNotOptimize(sum);
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//straight through the packed array like TransformSystem does
+	void ecsPackedIteration(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		auto transforms = scene->getSystem()->getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT);
+
+		float sum = 0;
+
+		while (state.keepRunning()) {
+			const Transform* data = transforms->getComponents();
+
+			for (unsigned int i = 0; i < transforms->getSize(); ++i)
+				sum += data[i].position.x;
+		}
+
+		doNotOptimize(sum);
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//everything moved, so every matrix gets rebuilt
+	void transformUpdate(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		auto transforms = scene->getSystem()->getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT);
+
+		while (state.keepRunning()) {
+			Transform* data = transforms->getComponents();
+
+			for (unsigned int i = 0; i < transforms->getSize(); ++i)
+				data[i].markDirty();
+
+			scene->updateTransforms();
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//one in every range(1) entities moved, the usual frame where most of the scene stands still
+	void transformUpdatePartial(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		auto transforms = scene->getSystem()->getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT);
+		scene->updateTransforms();
+
+		const unsigned int stride = (unsigned int)state.range(1);
+		unsigned int offset = 0;
+
+		while (state.keepRunning()) {
+			Transform* data = transforms->getComponents();
+
+			//a different set every frame so it isn't always the same cache lines
+			for (unsigned int i = offset; i < transforms->getSize(); i += stride)
+				data[i].markDirty();
+
+			scene->updateTransforms();
+			offset = (offset + 1) % stride;
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//nothing moved, what a still scene costs every frame
+	void transformUpdateStatic(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		scene->updateTransforms();
+
+		while (state.keepRunning())
+			scene->updateTransforms();
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//a script on every entity moving it, then the transforms that makes dirty
+	void scriptedMovers(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		addMovers(*scene);
+
+		//the first update makes and starts the scripts
+		scene->update();
+
+		while (state.keepRunning()) {
+			scene->update();
+			scene->updateTransforms();
+		}
+
+		destroyMovers(*scene);
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//range(0) game objects made and destroyed again every iteration, what spawning a wave of things and clearing it out costs
+	void entityLifecycle(BenchmarkState& state) {
+		ScenePointer scene(new Scene());
+		const size_t amount = (size_t)state.range(0);
+
+		std::vector<GameObject> objects;
+		objects.reserve(amount);
+
+		while (state.keepRunning()) {
+			for (size_t i = 0; i < amount; ++i)
+				objects.push_back(scene->createGameObject("spawned"));
+
+			for (size_t i = 0; i < objects.size(); ++i)
+				scene->destroyGameObject(objects[i]);
+
+			objects.clear();
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//every entity loses its MeshComponent and gets it back, the packed array moves its last one into every hole
+	void componentChurn(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		System& system = *scene->getSystem();
+		ComponentManager& components = *system.getComponentManager();
+
+		while (state.keepRunning()) {
+			for (unsigned int i = 0; i < system.getEntityAmount(); ++i) {
+				Entity entity = (*system.getEntities())[i];
+
+				MeshComponent mesh = std::move(components.getComponent<MeshComponent>(entity));
+				components.removeComponent<MeshComponent>(entity);
+				components.addComponent<MeshComponent>(entity, std::move(mesh));
+			}
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//extracting the scene into a snapshot, the draw packets the renderer goes through
+	void renderQueueBuild(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		scene->updateTransforms();
+
+		RenderSnapshot snapshot;
+
+		while (state.keepRunning()) {
+			snapshot.clear();
+			scene->extract(snapshot);
+		}
+
+		state.counters["packets"] = (double)snapshot.packets.size();
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	void culling(BenchmarkState& state) {
+		ScenePointer scene = createScene(state);
+		scene->updateTransforms();
+
+		RenderSnapshot snapshot;
+		scene->extract(snapshot);
+
+		const Frustum frustum = createFrustum(HFR_FIELD_OF_VIEW, ASPECT_RATIO, 0.1f, 1000);
+		std::vector<unsigned int> visible;
+
+		while (state.keepRunning())
+			cullPackets(snapshot, frustum, visible);
+
+		state.counters["visible"] = (double)visible.size();
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)snapshot.packets.size());
+	}
+
+	//a grid of range(0) x range(0) quads
+	void objLoad(BenchmarkState& state) {
+		const std::string path = getAssetDirectory() + "grid " + std::to_string(state.range(0)) + ".obj";
+		const size_t fileSize = writeObj(path, (size_t)state.range(0));
+
+		if (fileSize == 0) {
+			state.skipWithError("Couldn't write " + path);
+			return;
+		}
+
+		while (state.keepRunning()) {
+			std::vector<Mesh> meshes = Util::loadMesh(path);
+
+			if (meshes.empty()) {
+				state.skipWithError("Couldn't load " + path);
+				return;
+			}
+		}
+
+		state.setBytesProcessed((int64_t)state.getIterations() * (int64_t)fileSize);
+	}
+
+	//range(0) x range(0) rgba pixels
+	void pngLoad(BenchmarkState& state) {
+		const std::string path = getAssetDirectory() + "noise " + std::to_string(state.range(0)) + ".png";
+		const size_t fileSize = writePng(path, (size_t)state.range(0), SEED);
+
+		if (fileSize == 0) {
+			state.skipWithError("Couldn't write " + path);
+			return;
+		}
+
+		while (state.keepRunning()) {
+			Image image(path);
+
+			if (!image.hasData()) {
+				state.skipWithError("Couldn't load " + path);
+				return;
+			}
+		}
+
+		state.setBytesProcessed((int64_t)state.getIterations() * (int64_t)fileSize);
+	}
+
+	//laying out the whole tree again, what a window resize or a change at the top does
+	void guiLayout(BenchmarkState& state) {
+		GuiWorkload gui((size_t)state.range(0));
+		GuiCanvas::update();
+
+		while (state.keepRunning()) {
+			gui.getRoot()->markDirty();
+			GuiCanvas::update();
+			//render would have drawn and dropped the dirty regions, without it they'd pile up
+			GuiCanvas::invalidateAll();
+		}
+
+		state.counters["layouts"] = (double)GuiCanvas::getLayoutAmount();
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	void submitStrings(const std::vector<std::string>& strings, const Font& font) {
+		for (size_t i = 0; i < strings.size(); ++i)
+			TextBatcher::submit(strings[i], font, Vec2f(0, (float)i * 0.05f), Vec2f(1), Vec4f(1));
+	}
+
+	//every string laid out from scratch, like the first frame it shows up in
+	void textLayoutCold(BenchmarkState& state) {
+		const Font* font = getFont();
+
+		if (font == nullptr) {
+			state.skipWithError("Couldn't load the oxygen font");
+			return;
+		}
+
+		const std::vector<std::string> strings = createStrings((size_t)state.range(0), TEXT_LENGTH, SEED);
+
+		while (state.keepRunning()) {
+			state.pauseTiming();
+			//drops the cached layouts, there's no gl to let go of
+			TextBatcher::close();
+			state.resumeTiming();
+
+			submitStrings(strings, *font);
+		}
+
+		TextBatcher::close();
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//the same strings every frame, only the vertices get written
+	void textLayoutWarm(BenchmarkState& state) {
+		const Font* font = getFont();
+
+		if (font == nullptr) {
+			state.skipWithError("Couldn't load the oxygen font");
+			return;
+		}
+
+		const std::vector<std::string> strings = createStrings((size_t)state.range(0), TEXT_LENGTH, SEED);
+		submitStrings(strings, *font);
+
+		while (state.keepRunning()) {
+			TextBatcher::clear();
+			submitStrings(strings, *font);
+		}
+
+		TextBatcher::close();
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+}
+
+//entity counts go up to HFR_MAX_ENTITIES, a scene can't hold more
+HBM_BENCHMARK(ecsIteration)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(ecsPackedIteration)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(transformUpdate)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(transformUpdatePartial)->args({ HFR_MAX_ENTITIES, 4 })->args({ HFR_MAX_ENTITIES, 16 })->args({ HFR_MAX_ENTITIES, 256 });
+HBM_BENCHMARK(transformUpdateStatic)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(scriptedMovers)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(entityLifecycle)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(componentChurn)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(renderQueueBuild)->range(64, HFR_MAX_ENTITIES);
+HBM_BENCHMARK(culling)->range(64, HFR_MAX_ENTITIES);
+//the biggest obj is a quarter million quads and the biggest png 64 mb of pixels
+HBM_BENCHMARK(objLoad)->range(16, 512, 4)->unit(TimeUnit::Millisecond);
+HBM_BENCHMARK(pngLoad)->range(256, 4096, 2)->unit(TimeUnit::Millisecond);
+HBM_BENCHMARK(guiLayout)->range(100, 25600, 4)->unit(TimeUnit::Microsecond);
+//up to the 10k strings a frame of a busy hud comes to, and 10 times that
+HBM_BENCHMARK(textLayoutCold)->range(16, 100000, 8)->unit(TimeUnit::Microsecond);
+HBM_BENCHMARK(textLayoutWarm)->range(16, 100000, 8)->unit(TimeUnit::Microsecond);
+
+int main(int argc, char** argv) {
+	//the table is the output, the framework only gets to say something when it goes wrong
+	Logger::level = LogLevel::Warning;
+
+	//what Engine::startEngine sets up minus the window, gl and everything drawn with them
+	ScopeProfiler::init();
+	Util::init();
+	VirtualFileSystem::init();
+	MatrixKernels::init();
+	ImageProcessing::init();
+	JobSystem::init();
+	FreeType::init();
+
+	const int out = runBenchmarks(std::vector<std::string>(argv, argv + argc));
+
+	textFont.reset();
+	FreeType::close();
+	JobSystem::close();
+	VirtualFileSystem::close();
+
+	return out;
+}
@@ -0,0 +1,336 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//MatrixKernels against its scalar reference on every instruction set the cpu has, and how many matrices each one makes a millisecond
+
+namespace {
+	const unsigned int SEED = 1;
+	//not multiples of 4, 8 or 16 so every kernel goes through its tail too
+	const size_t BATCH_SIZES[] = { 0, 1, 3, 7, 15, 17, 33, 1001 };
+	//the simd sin and cos are polynomials, they get within this of the scalar ones relative to the value
+	const float TOLERANCE = 1e-4f;
+
+	//puts the instruction set the engine picked back when a check or benchmark leaves
+	class InstructionSetScope {
+	private:
+		int previous;
+
+	public:
+		InstructionSetScope() : previous(MatrixKernels::getInstructionSet()) {}
+		~InstructionSetScope() {
+			MatrixKernels::setInstructionSet(previous);
+		}
+	};
+
+	bool isNear(const float& value, const float& expected) {
+		return std::fabs(value - expected) <= TOLERANCE * (1.0f + std::fabs(expected));
+	}
+
+	bool isNear(const Mat4f& value, const Mat4f& expected) {
+		const float* v = &value.m00;
+		const float* e = &expected.m00;
+
+		for (int i = 0; i < 16; ++i) {
+			if (!isNear(v[i], e[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool isNear(const Vec3f& value, const Vec3f& expected) {
+		return isNear(value.x, expected.x) && isNear(value.y, expected.y) && isNear(value.z, expected.z);
+	}
+
+	Mat4f createRandomMatrix(std::mt19937& random) {
+		std::uniform_real_distribution<float> values(-10, 10);
+
+		Mat4f out;
+		float* data = &out.m00;
+
+		for (int i = 0; i < 16; ++i)
+			data[i] = values(random);
+
+		return out;
+	}
+
+	//what a scene hands the batch kernels, soa like the packed transform arrays
+	struct TransformData {
+		std::vector<float> positionX, positionY, positionZ;
+		std::vector<float> rotationX, rotationY, rotationZ;
+		std::vector<float> scaleX, scaleY, scaleZ;
+
+		TransformData(const size_t& count, const unsigned int& seed) {
+			std::mt19937 random(seed);
+			std::uniform_real_distribution<float> positions(-100, 100);
+			std::uniform_real_distribution<float> rotations(-360, 360);
+			std::uniform_real_distribution<float> scales(0.1f, 4);
+
+			std::vector<float>* arrays[] = { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &scaleX, &scaleY, &scaleZ };
+
+			//one array at a time so the values don't depend on the order arguments get evaluated in
+			for (int i = 0; i < 9; ++i) {
+				arrays[i]->resize(count + 1);
+
+				for (size_t j = 0; j < count + 1; ++j)
+					(*arrays[i])[j] = i < 3 ? positions(random) : i < 6 ? rotations(random) : scales(random);
+			}
+		}
+
+		TransformArrays getArrays() const {
+			TransformArrays out;
+			out.positionX = positionX.data();
+			out.positionY = positionY.data();
+			out.positionZ = positionZ.data();
+			out.rotationX = rotationX.data();
+			out.rotationY = rotationY.data();
+			out.rotationZ = rotationZ.data();
+			out.scaleX = scaleX.data();
+			out.scaleY = scaleY.data();
+			out.scaleZ = scaleZ.data();
+
+			return out;
+		}
+	};
+
+	//HBM_EXPECT only prints the expression, this says which kernel on which set
+	void reportSet(const int& set, const std::string& kernel, const size_t& count) {
+		report(MatrixKernels::getInstructionSetName(set) + " " + kernel + " differs from the scalar reference at count " + std::to_string(count));
+	}
+
+	void matrixKernelsSingle() {
+		std::mt19937 random(SEED);
+
+		for (int i = 0; i < 1000; ++i) {
+			const Mat4f left = createRandomMatrix(random);
+			const Mat4f right = createRandomMatrix(random);
+
+			Mat4f simd, scalar;
+			MatrixKernels::multiply(left, right, simd);
+			MatrixKernels::multiplyScalar(left, right, scalar);
+			HBM_EXPECT(isNear(simd, scalar));
+
+			//out can be one of the inputs
+			Mat4f aliased = left;
+			MatrixKernels::multiply(aliased, right, aliased);
+			HBM_EXPECT(isNear(aliased, scalar));
+
+			MatrixKernels::transpose(left, simd);
+			MatrixKernels::transposeScalar(left, scalar);
+			HBM_EXPECT(std::memcmp(&simd, &scalar, sizeof(Mat4f)) == 0);
+
+			const Vec3f point(left.m00, right.m11, left.m22);
+			HBM_EXPECT(isNear(MatrixKernels::transformPoint(left, point), MatrixKernels::transformPointScalar(left, point)));
+
+			const Vec4f vector = MatrixKernels::transform(left, Vec4f(point.x, point.y, point.z, 1));
+			HBM_EXPECT(isNear(Vec3f(vector.x, vector.y, vector.z), MatrixKernels::transformPointScalar(left, point)));
+		}
+
+		//transformation matrices are always invertible and what the engine actually inverts
+		TransformData transforms(1000, SEED);
+		const TransformArrays arrays = transforms.getArrays();
+
+		for (size_t i = 0; i < 1000; ++i) {
+			Mat4f matrix, simd, scalar, identity;
+			MatrixKernels::createTransformationMatrixScalar(arrays, i, matrix);
+
+			HBM_EXPECT(MatrixKernels::inverse(matrix, simd));
+			HBM_EXPECT(MatrixKernels::inverseScalar(matrix, scalar));
+			HBM_EXPECT(isNear(simd, scalar));
+
+			Mat4f expected;
+			expected.setIdentity();
+			MatrixKernels::multiply(matrix, simd, identity);
+			HBM_EXPECT(isNear(identity, expected));
+		}
+
+		//a singular matrix leaves out alone
+		Mat4f singular, out;
+		out.setIdentity();
+		const Mat4f before = out;
+
+		HBM_EXPECT(!MatrixKernels::inverse(singular, out));
+		HBM_EXPECT(std::memcmp(&out, &before, sizeof(Mat4f)) == 0);
+		HBM_EXPECT(!MatrixKernels::inverseScalar(singular, out));
+		HBM_EXPECT(std::memcmp(&out, &before, sizeof(Mat4f)) == 0);
+	}
+
+	//every instruction set up to the one the cpu has, each batch kernel at sizes that end in a tail
+	void matrixKernelsBatch() {
+		InstructionSetScope scope;
+		std::mt19937 random(SEED);
+
+		const Mat4f left = createRandomMatrix(random);
+		const Mat4f projectionView = createRandomMatrix(random);
+
+		for (int set = HFR_SIMD_SCALAR; set <= MatrixKernels::detectInstructionSet(); ++set) {
+			MatrixKernels::setInstructionSet(set);
+			HBM_REQUIRE(MatrixKernels::getInstructionSet() == set);
+
+			for (const size_t& count : BATCH_SIZES) {
+				TransformData transforms(count, SEED + (unsigned int)count);
+				const TransformArrays arrays = transforms.getArrays();
+
+				std::vector<Mat4f> right(count + 1);
+				for (size_t i = 0; i < count + 1; ++i)
+					right[i] = createRandomMatrix(random);
+
+				//one more than count everywhere, a kernel that writes past the end changes the sentinel
+				Mat4f sentinel = createRandomMatrix(random);
+				std::vector<Mat4f> out(count + 1), models(count + 1), mvps(count + 1);
+				out[count] = models[count] = mvps[count] = sentinel;
+
+				bool matches = true;
+
+				MatrixKernels::multiply(left, right.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					Mat4f expected;
+					MatrixKernels::multiplyScalar(left, right[i], expected);
+					matches &= isNear(out[i], expected);
+				}
+
+				if (!HBM_EXPECT(matches && std::memcmp(&out[count], &sentinel, sizeof(Mat4f)) == 0))
+					reportSet(set, "multiply", count);
+
+				matches = true;
+				MatrixKernels::createTransformationMatrices(arrays, out.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					Mat4f expected;
+					MatrixKernels::createTransformationMatrixScalar(arrays, i, expected);
+					matches &= isNear(out[i], expected);
+				}
+
+				if (!HBM_EXPECT(matches && std::memcmp(&out[count], &sentinel, sizeof(Mat4f)) == 0))
+					reportSet(set, "createTransformationMatrices", count);
+
+				matches = true;
+				MatrixKernels::createMVPMatrices(projectionView, arrays, models.data(), mvps.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					Mat4f model, mvp;
+					MatrixKernels::createTransformationMatrixScalar(arrays, i, model);
+					MatrixKernels::multiplyScalar(projectionView, model, mvp);
+					matches &= isNear(models[i], model) && isNear(mvps[i], mvp);
+				}
+
+				if (!HBM_EXPECT(matches && std::memcmp(&models[count], &sentinel, sizeof(Mat4f)) == 0 && std::memcmp(&mvps[count], &sentinel, sizeof(Mat4f)) == 0))
+					reportSet(set, "createMVPMatrices", count);
+
+				//without models only the mvps get written
+				matches = true;
+				MatrixKernels::createMVPMatrices(projectionView, arrays, nullptr, out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					matches &= isNear(out[i], mvps[i]);
+
+				if (!HBM_EXPECT(matches))
+					reportSet(set, "createMVPMatrices without models", count);
+
+				std::vector<float> outX(count + 1, -1), outY(count + 1, -1), outZ(count + 1, -1);
+				matches = true;
+				MatrixKernels::transformPoints(left, transforms.positionX.data(), transforms.positionY.data(), transforms.positionZ.data(), outX.data(), outY.data(), outZ.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					const Vec3f expected = MatrixKernels::transformPointScalar(left, Vec3f(transforms.positionX[i], transforms.positionY[i], transforms.positionZ[i]));
+					matches &= isNear(Vec3f(outX[i], outY[i], outZ[i]), expected);
+				}
+
+				if (!HBM_EXPECT(matches && outX[count] == -1 && outY[count] == -1 && outZ[count] == -1))
+					reportSet(set, "transformPoints", count);
+			}
+		}
+	}
+
+	//only sets the instruction set the benchmark asks for, false when the cpu doesn't have it
+	bool useInstructionSet(BenchmarkState& state) {
+		const int set = (int)state.range(0);
+		MatrixKernels::setInstructionSet(set);
+
+		if (MatrixKernels::getInstructionSet() != set) {
+			state.skipWithError(MatrixKernels::getInstructionSetName(set) + " isn't supported on this cpu");
+			return false;
+		}
+
+		return true;
+	}
+
+	void reportMatricesPerMillisecond(BenchmarkState& state, const int64_t& matrices) {
+		state.setItemsProcessed(matrices);
+
+		if (state.realTime > 0)
+			state.counters["matrices/ms"] = (double)matrices / (state.realTime * 1000.0);
+	}
+
+	//range(0) is the instruction set, range(1) how many transforms
+	void transformationMatrices(BenchmarkState& state) {
+		InstructionSetScope scope;
+
+		if (!useInstructionSet(state))
+			return;
+
+		const size_t count = (size_t)state.range(1);
+		TransformData transforms(count, SEED);
+		const TransformArrays arrays = transforms.getArrays();
+		std::vector<Mat4f> out(count);
+
+		while (state.keepRunning()) {
+			MatrixKernels::createTransformationMatrices(arrays, out.data(), count);
+			doNotOptimize(out[count - 1].m30);
+		}
+
+		reportMatricesPerMillisecond(state, (int64_t)state.getIterations() * (int64_t)count);
+	}
+
+	void mvpMatrices(BenchmarkState& state) {
+		InstructionSetScope scope;
+
+		if (!useInstructionSet(state))
+			return;
+
+		const size_t count = (size_t)state.range(1);
+		TransformData transforms(count, SEED);
+		const TransformArrays arrays = transforms.getArrays();
+
+		Mat4f projectionView = Mat4f::createPerspectiveMatrix(1920, 1080, HFR_FIELD_OF_VIEW, 0.1f, 1000);
+		std::vector<Mat4f> models(count), mvps(count);
+
+		while (state.keepRunning()) {
+			MatrixKernels::createMVPMatrices(projectionView, arrays, models.data(), mvps.data(), count);
+			doNotOptimize(mvps[count - 1].m30);
+		}
+
+		reportMatricesPerMillisecond(state, (int64_t)state.getIterations() * (int64_t)count);
+	}
+
+	void matrixMultiply(BenchmarkState& state) {
+		InstructionSetScope scope;
+
+		if (!useInstructionSet(state))
+			return;
+
+		const size_t count = (size_t)state.range(1);
+		std::mt19937 random(SEED);
+
+		const Mat4f left = createRandomMatrix(random);
+		std::vector<Mat4f> right(count), out(count);
+		for (size_t i = 0; i < count; ++i)
+			right[i] = createRandomMatrix(random);
+
+		while (state.keepRunning()) {
+			MatrixKernels::multiply(left, right.data(), out.data(), count);
+			doNotOptimize(out[count - 1].m30);
+		}
+
+		reportMatricesPerMillisecond(state, (int64_t)state.getIterations() * (int64_t)count);
+	}
+}
+
+HBM_CHECK(matrixKernelsSingle);
+HBM_CHECK(matrixKernelsBatch);
+
+//every instruction set at a scene's worth of transforms and at a lot more, the ones the cpu doesn't have show up as errors
+HBM_BENCHMARK(transformationMatrices)->args({ HFR_SIMD_SCALAR, 4096 })->args({ HFR_SIMD_SSE2, 4096 })->args({ HFR_SIMD_AVX2, 4096 })->args({ HFR_SIMD_AVX512, 4096 })
+	->args({ HFR_SIMD_SCALAR, 100000 })->args({ HFR_SIMD_SSE2, 100000 })->args({ HFR_SIMD_AVX2, 100000 })->args({ HFR_SIMD_AVX512, 100000 })->unit(TimeUnit::Microsecond);
+HBM_BENCHMARK(mvpMatrices)->args({ HFR_SIMD_SCALAR, 4096 })->args({ HFR_SIMD_SSE2, 4096 })->args({ HFR_SIMD_AVX2, 4096 })->args({ HFR_SIMD_AVX512, 4096 })->unit(TimeUnit::Microsecond);
+HBM_BENCHMARK(matrixMultiply)->args({ HFR_SIMD_SCALAR, 4096 })->args({ HFR_SIMD_SSE2, 4096 })->args({ HFR_SIMD_AVX2, 4096 })->args({ HFR_SIMD_AVX512, 4096 })->unit(TimeUnit::Microsecond);
@@ -0,0 +1,340 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the scope profiler, what a scope costs the thread it's on and what collect costs, and whether the call trees come out right
+//with a lot of threads writing at the same time
+
+namespace {
+	const size_t THREAD_AMOUNT = 8;
+	const size_t ITERATIONS = 1000;
+	const int RECURSION_DEPTH = 3;
+	//half the buffer, so a thread timing itself never runs into a full one
+	const size_t TIMED_SCOPES = HFR_PROFILER_BUFFER_EVENTS / 4;
+	const int TIMED_ROUNDS = 5;
+	const double MAXIMUM_NANOSECONDS = 50.0;
+	//about what reading the tsc takes outside a virtual machine
+	const double NATIVE_CLOCK_NANOSECONDS = 10.0;
+
+	//a little work so scopes take some time
+	void spin() {
+		uint32_t value = 1;
+
+		for (int i = 0; i < 64; ++i)
+			value = value * 1664525u + 1013904223u;
+
+		doNotOptimize(value);
+	}
+
+	void leaf() {
+		ProfileScope("profiler check leaf");
+		spin();
+	}
+
+	void inner() {
+		ProfileScope("profiler check inner");
+		spin();
+		leaf();
+	}
+
+	//outer > inner > leaf and outer > leaf, the same leaf marker through two parents is two nodes
+	void outer() {
+		ProfileScope("profiler check outer");
+		inner();
+		leaf();
+	}
+
+	void recurse(const int& depth) {
+		ProfileScope("profiler check recursion");
+
+		if (depth > 1)
+			recurse(depth - 1);
+	}
+
+	void empty() {
+		ProfileScope("profiler check empty");
+	}
+
+	void nest(const int64_t& depth) {
+		ProfileScope("profiler benchmark scope");
+
+		if (depth > 1)
+			nest(depth - 1);
+	}
+
+	//runs work on amount threads named name 0, name 1, ... that all start at once
+	void runThreads(const size_t& amount, const std::string& name, const std::function<void(const size_t&)>& work) {
+		std::atomic<bool> go(false);
+		std::vector<std::thread> threads;
+
+		for (size_t i = 0; i < amount; ++i) {
+			threads.emplace_back([&go, &work, &name, i]() {
+				ScopeProfiler::setThreadName(name + " " + std::to_string(i));
+
+				while (!go.load())
+					std::this_thread::yield();
+
+				work(i);
+			});
+		}
+
+		go.store(true);
+
+		for (size_t i = 0; i < threads.size(); ++i)
+			threads[i].join();
+	}
+
+	//threads that exited keep their buffer and their name, the one that did something in the last collect is the one just run
+	const ThreadProfile* findThread(const std::string& name) {
+		const std::vector<ThreadProfile>& frame = ScopeProfiler::getFrame();
+
+		for (size_t i = 0; i < frame.size(); ++i) {
+			if (frame[i].name == name && (!frame[i].nodes.empty() || frame[i].dropped > 0))
+				return &frame[i];
+		}
+
+		return nullptr;
+	}
+
+	//the node for name under a node for parent (or at the top when parent is empty), -1 when there isn't one
+	int findNode(const ThreadProfile& thread, const std::string& name, const std::string& parent) {
+		for (size_t i = 0; i < thread.nodes.size(); ++i) {
+			const ProfileNode& node = thread.nodes[i];
+
+			if (ScopeProfiler::getMarkerName(node.marker) != name)
+				continue;
+
+			if (parent.empty() ? node.parent < 0 : node.parent >= 0 && ScopeProfiler::getMarkerName(thread.nodes[node.parent].marker) == parent)
+				return (int)i;
+		}
+
+		return -1;
+	}
+
+	//the first node under node, -1 when nothing is
+	int findChild(const ThreadProfile& thread, const int& node) {
+		for (size_t i = node + 1; i < thread.nodes.size(); ++i) {
+			if (thread.nodes[i].parent == node)
+				return (int)i;
+		}
+
+		return -1;
+	}
+
+	bool hasCalls(const ThreadProfile& thread, const int& node, const size_t& calls) {
+		return node >= 0 && thread.nodes[node].calls == calls;
+	}
+
+	//every thread gets its own tree with the right parents and call counts, the same marker through different parents and recursion
+	//each get their own nodes, and a parent takes at least as long as its children
+	void profilerNestsAcrossThreads() {
+		ScopeProfiler::collect();
+
+		runThreads(THREAD_AMOUNT, "profiler nesting", [](const size_t& thread) {
+			for (size_t i = 0; i < ITERATIONS; ++i) {
+				outer();
+				recurse(RECURSION_DEPTH);
+			}
+		});
+
+		ScopeProfiler::collect();
+
+		for (size_t i = 0; i < THREAD_AMOUNT; ++i) {
+			const ThreadProfile* thread = findThread("profiler nesting " + std::to_string(i));
+			HBM_REQUIRE(thread != nullptr);
+
+			const int outerNode = findNode(*thread, "profiler check outer", "");
+			const int innerNode = findNode(*thread, "profiler check inner", "profiler check outer");
+			const int innerLeaf = findNode(*thread, "profiler check leaf", "profiler check inner");
+			const int outerLeaf = findNode(*thread, "profiler check leaf", "profiler check outer");
+
+			HBM_EXPECT(hasCalls(*thread, outerNode, ITERATIONS));
+			HBM_EXPECT(hasCalls(*thread, innerNode, ITERATIONS));
+			HBM_EXPECT(hasCalls(*thread, innerLeaf, ITERATIONS));
+			HBM_EXPECT(hasCalls(*thread, outerLeaf, ITERATIONS));
+			HBM_EXPECT(innerLeaf != outerLeaf);
+
+			//a chain of RECURSION_DEPTH nodes, every one under the one before
+			int recursion = findNode(*thread, "profiler check recursion", "");
+
+			for (int depth = 0; depth < RECURSION_DEPTH && HBM_EXPECT(hasCalls(*thread, recursion, ITERATIONS)); ++depth)
+				recursion = findChild(*thread, recursion);
+
+			HBM_EXPECT(recursion < 0);
+
+			HBM_EXPECT(thread->nodes.size() == 4 + (size_t)RECURSION_DEPTH);
+			HBM_EXPECT(thread->dropped == 0);
+
+			if (outerNode < 0 || innerNode < 0 || outerLeaf < 0)
+				continue;
+
+			const ProfileNode& top = thread->nodes[outerNode];
+			const double children = thread->nodes[innerNode].inclusive + thread->nodes[outerLeaf].inclusive;
+
+			HBM_EXPECT(top.inclusive >= children);
+			HBM_EXPECT(std::abs(top.exclusive - (top.inclusive - children)) <= top.inclusive * 1e-6);
+
+			for (size_t node = 0; node < thread->nodes.size(); ++node) {
+				//parents come before their children
+				HBM_EXPECT(thread->nodes[node].parent < (int)node);
+				HBM_EXPECT(thread->nodes[node].exclusive >= 0 && thread->nodes[node].exclusive <= thread->nodes[node].inclusive);
+			}
+		}
+	}
+
+	//a scope counts in the frame it ends in, and a thread that fills its buffer before collect comes around keeps the events that fit
+	//and reports the rest as dropped
+	void profilerFrameEdges() {
+		size_t calls = 0;
+		double milliseconds = 0;
+
+		ScopeProfiler::collect();
+
+		{
+			ProfileScope("profiler check spanning");
+			ScopeProfiler::collect();
+			HBM_EXPECT(!ScopeProfiler::getTotal("profiler check spanning", calls, milliseconds));
+		}
+
+		ScopeProfiler::collect();
+		HBM_EXPECT(ScopeProfiler::getTotal("profiler check spanning", calls, milliseconds) && calls == 1);
+
+		//twice what fits, the buffer holds exactly the first half of the begin and end pairs
+		const size_t scopes = HFR_PROFILER_BUFFER_EVENTS;
+
+		runThreads(1, "profiler overflow", [scopes](const size_t& thread) {
+			for (size_t i = 0; i < scopes; ++i)
+				empty();
+		});
+
+		ScopeProfiler::collect();
+
+		const ThreadProfile* thread = findThread("profiler overflow 0");
+		HBM_REQUIRE(thread != nullptr);
+
+		const int node = findNode(*thread, "profiler check empty", "");
+		HBM_EXPECT(hasCalls(*thread, node, HFR_PROFILER_BUFFER_EVENTS / 2));
+		HBM_EXPECT(thread->dropped == scopes * 2 - HFR_PROFILER_BUFFER_EVENTS);
+	}
+
+	//nanoseconds an empty scope costs, the best round of TIMED_ROUNDS on every thread with all of them going at once
+	double getScopeCost(const size_t& threads) {
+		std::vector<double> best(threads, DBL_MAX);
+
+		for (int round = 0; round < TIMED_ROUNDS; ++round) {
+			runThreads(threads, "profiler overhead", [&best](const size_t& thread) {
+				const auto start = std::chrono::steady_clock::now();
+
+				for (size_t i = 0; i < TIMED_SCOPES; ++i)
+					empty();
+
+				const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+				best[thread] = min(best[thread], nanoseconds / TIMED_SCOPES);
+			});
+
+			ScopeProfiler::collect();
+		}
+
+		return std::accumulate(best.begin(), best.end(), 0.0) / (double)threads;
+	}
+
+	//nanoseconds one getTicks takes, the best of TIMED_ROUNDS
+	double getClockCost() {
+		double best = DBL_MAX;
+
+		for (int round = 0; round < TIMED_ROUNDS; ++round) {
+			uint64_t sum = 0;
+			const auto start = std::chrono::steady_clock::now();
+
+			for (size_t i = 0; i < TIMED_SCOPES; ++i)
+				sum += ScopeProfiler::getTicks();
+
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			doNotOptimize(sum);
+			best = min(best, elapsed.count() / TIMED_SCOPES);
+		}
+
+		return best;
+	}
+
+	//under MAXIMUM_NANOSECONDS plus however much slower the two clock reads are than on real hardware
+	//(virtual machines trap rdtsc, it's 20 ns and more there), the profiler can't do anything about that part
+	bool isCheapEnough(const double& scope, const double& clock) {
+		return scope < MAXIMUM_NANOSECONDS + max(clock - NATIVE_CLOCK_NANOSECONDS, 0.0) * 2;
+	}
+
+	//a scope (begin and end) is cheap enough on its own and with THREAD_AMOUNT threads writing at once, and nothing gets dropped
+	void profilerOverhead() {
+		ScopeProfiler::collect();
+
+		const double clock = getClockCost();
+		const double single = getScopeCost(1);
+		const double all = getScopeCost(THREAD_AMOUNT);
+
+		HBM_EXPECT(isCheapEnough(single, clock));
+		HBM_EXPECT(isCheapEnough(all, clock));
+
+		for (size_t i = 0; i < ScopeProfiler::getFrame().size(); ++i)
+			HBM_EXPECT(ScopeProfiler::getFrame()[i].dropped == 0);
+
+		report(std::to_string(single) + " ns a scope on one thread, " + std::to_string(all) + " ns on " + std::to_string(THREAD_AMOUNT) + " at once, " +
+			std::to_string(clock) + " ns of that is each of the two clock reads");
+	}
+
+	//range(0) is how deep the scopes go, collect runs with the timing paused before the buffer fills up
+	void profileScope(BenchmarkState& state) {
+		const int64_t depth = state.range(0);
+		const int64_t collectEvery = (int64_t)TIMED_SCOPES / depth;
+		int64_t sinceCollect = 0;
+
+		ScopeProfiler::collect();
+
+		while (state.keepRunning()) {
+			nest(depth);
+
+			if (++sinceCollect == collectEvery) {
+				state.pauseTiming();
+				ScopeProfiler::collect();
+				state.resumeTiming();
+
+				sinceCollect = 0;
+			}
+		}
+
+		ScopeProfiler::collect();
+
+		state.setItemsProcessed((int64_t)state.getIterations() * depth);
+
+		if (state.realTime > 0)
+			state.counters["ns/scope"] = state.realTime * 1e9 / (double)(state.getIterations() * depth);
+	}
+
+	//range(0) is how many times outer (4 scopes) ran since the last collect, only collect gets timed
+	void profilerCollect(BenchmarkState& state) {
+		const int64_t amount = state.range(0);
+
+		ScopeProfiler::collect();
+
+		while (state.keepRunning()) {
+			state.pauseTiming();
+			for (int64_t i = 0; i < amount; ++i)
+				outer();
+			state.resumeTiming();
+
+			ScopeProfiler::collect();
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * amount * 8);
+	}
+}
+
+HBM_CHECK(profilerNestsAcrossThreads);
+HBM_CHECK(profilerFrameEdges);
+HBM_CHECK(profilerOverhead);
+
+HBM_BENCHMARK(profileScope)->arg(1)->arg(8)->unit(TimeUnit::Nanosecond);
+//up to what fits in a buffer, 8 events a call
+HBM_BENCHMARK(profilerCollect)->range(64, 8192, 8)->unit(TimeUnit::Microsecond);
@@ -0,0 +1,222 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//a replay recorded from a made up run (jittery clock, random input, random numbers in the fixed steps) and played back,
+//every frame of the playback has to come out exactly like it did live however the state was left before it started
+
+namespace {
+	const unsigned int SEED = 1;
+	const unsigned int REPLAY_SEED = 1234;
+	const size_t FRAMES = 300;
+	const int RIGHT_KEY = GLFW_KEY_D;
+	const int FORWARD_KEY = GLFW_KEY_W;
+
+	//a small game, physics in fixed steps pushed by an action, a camera moved with the frame delta and the mouse, and random spawns
+	struct Game {
+		double position = 0;
+		double velocity = 0;
+		double camera = 0;
+		double spawned = 0;
+
+		//what Engine::updateEngine does at the start of a frame and then the game on top
+		void frame() {
+			Replay::update();
+			Time::update();
+			Input::update();
+
+			while (Time::stepFixed()) {
+				FixedStepScope step;
+
+				velocity += (Input::getAction("Replay check right") ? 1.0 : 0.0) * Time::getDeltaTime();
+				position += velocity * Time::getDeltaTime();
+
+				if (Random::range(0, 100) < 3)
+					spawned += Random::range(0, 10);
+			}
+
+			camera += Input::getMouseMovement().x * 0.08 + Time::getDeltaTime() * (Input::getKey(FORWARD_KEY) ? 10 : 0);
+		}
+
+		bool operator==(const Game& other) const {
+			return position == other.position && velocity == other.velocity && camera == other.camera && spawned == other.spawned;
+		}
+	};
+
+	struct FrameState {
+		Game game;
+		size_t steps = 0;
+		double frameStart = 0;
+
+		bool operator==(const FrameState& other) const {
+			return game == other.game && steps == other.steps && frameStart == other.frameStart;
+		}
+	};
+
+	InputEvent createEvent(const InputEventType& type, const int& code, const int& action, const float& x) {
+		InputEvent out;
+		out.time = Time::getTime();
+		out.type = type;
+		out.code = code;
+		out.action = action;
+		out.x = x;
+		return out;
+	}
+
+	void releaseAll() {
+		Input::pushEvent(createEvent(InputEventType::Key, RIGHT_KEY, GLFW_RELEASE, 0));
+		Input::pushEvent(createEvent(InputEventType::Key, FORWARD_KEY, GLFW_RELEASE, 0));
+		Input::pushEvent(createEvent(InputEventType::CursorPosition, 0, 0, 0));
+
+		Input::update();
+		Input::update();
+	}
+
+	//the action the game uses, and the clock, fixed rate and input put back once it goes
+	class ReplayScope {
+	private:
+		double rate;
+
+	public:
+		double now = 0;
+
+		ReplayScope() : rate(Time::getFixedRate()) {
+			Time::setClock([this]() { return now; });
+			releaseAll();
+
+			Input::bindAction("Replay check right", InputBinding(InputSource::Key, RIGHT_KEY, 1));
+		}
+
+		ReplayScope(const ReplayScope&) = delete;
+		ReplayScope& operator=(const ReplayScope&) = delete;
+
+		~ReplayScope() {
+			Replay::stopRecording();
+			Replay::stopReplay();
+
+			Input::unbindAction("Replay check right");
+			releaseAll();
+
+			Time::setClock(std::function<double()>());
+			Time::setFixedRate(rate);
+			Time::resetFixedSteps();
+		}
+	};
+
+	//FRAMES frames of 2 to 14 ms with a few random events each, recorded into a replay
+	std::vector<FrameState> recordRun(ReplayScope& scope) {
+		std::mt19937 random(SEED);
+		std::vector<FrameState> out;
+		Game game;
+
+		Time::update();
+		Replay::startRecording(REPLAY_SEED);
+
+		for (size_t i = 0; i < FRAMES; ++i) {
+			scope.now += 2.0 + (double)(random() % 12000) / 1000.0;
+
+			const int events = (int)(random() % 3);
+
+			for (int j = 0; j < events; ++j) {
+				switch (random() % 3) {
+				case 0: Input::pushEvent(createEvent(InputEventType::Key, RIGHT_KEY, (int)(random() % 2), 0)); break;
+				case 1: Input::pushEvent(createEvent(InputEventType::Key, FORWARD_KEY, (int)(random() % 2), 0)); break;
+				default: Input::pushEvent(createEvent(InputEventType::CursorPosition, 0, 0, (float)(random() % 800))); break;
+				}
+			}
+
+			game.frame();
+
+			FrameState state;
+			state.game = game;
+			state.steps = Time::getFixedSteps();
+			state.frameStart = Time::getFrameStartTime();
+			out.push_back(state);
+		}
+
+		Replay::stopRecording();
+		return out;
+	}
+
+	//plays it until the replay ends, with the real input pressing a key every frame that has to be ignored
+	std::vector<FrameState> playRun(const ReplayData& replay) {
+		std::vector<FrameState> out;
+		Game game;
+
+		Replay::startReplay(replay);
+
+		while (true) {
+			Input::pushEvent(createEvent(InputEventType::Key, RIGHT_KEY, GLFW_PRESS, 0));
+			game.frame();
+
+			if (!Replay::isReplaying())
+				break;
+
+			FrameState state;
+			state.game = game;
+			state.steps = Time::getFixedSteps();
+			state.frameStart = Time::getFrameStartTime();
+			out.push_back(state);
+		}
+
+		return out;
+	}
+
+	//saved and loaded again, then played twice after messing up the seed, the fixed rate and the input each time,
+	//both playbacks have to match the live run frame for frame and a replay that's cut off doesn't load
+	void replayMatchesLive() {
+		ReplayScope scope;
+
+		const std::vector<FrameState> live = recordRun(scope);
+		HBM_REQUIRE(Replay::getData().getFrameAmount() == FRAMES);
+
+		const std::string path = getAssetDirectory() + "replays/run.hrpl";
+		HBM_REQUIRE(Replay::getData().save(path));
+
+		ReplayData loaded;
+		HBM_REQUIRE(loaded.load(path));
+		HBM_EXPECT(loaded.seed == REPLAY_SEED && loaded.getFrameAmount() == FRAMES);
+
+		for (int run = 0; run < 2; ++run) {
+			Random::setSeed(REPLAY_SEED + 1 + run);
+			Time::setFixedRate(30.0 + run);
+			releaseAll();
+
+			const std::vector<FrameState> played = playRun(loaded);
+			HBM_REQUIRE(played.size() == FRAMES);
+
+			size_t mismatched = 0;
+
+			for (size_t i = 0; i < FRAMES; ++i)
+				mismatched += played[i] == live[i] ? 0 : 1;
+
+			HBM_EXPECT(mismatched == 0);
+		}
+
+		std::string file;
+
+		{
+			std::ifstream in(path, std::ios_base::binary);
+			file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		const std::string brokenPath = getAssetDirectory() + "replays/cut off.hrpl";
+
+		{
+			std::ofstream out(brokenPath, std::ios_base::binary | std::ios_base::trunc);
+			out.write(file.data(), file.size() - 3);
+		}
+
+		ReplayData broken;
+		HBM_EXPECT(!broken.load(brokenPath));
+
+		report(std::to_string(FRAMES) + " frames and " + std::to_string(live.back().steps) + " fixed steps played back twice, the game ended at " +
+			std::to_string(live.back().game.position));
+	}
+}
+
+HBM_CHECK(replayMatchesLive);
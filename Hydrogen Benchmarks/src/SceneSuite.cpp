@@ -0,0 +1,372 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//what the simulation side of a frame hands the renderer, both stages of pipelined frames, and what a frame costs when nothing in the scene moves
+
+namespace {
+	const unsigned int SEED = 1;
+	const float SCENE_EXTENT = 200.0f;
+	const int64_t FULL_SCENE = HFR_MAX_ENTITIES;
+	//what a big still level has, more than a scene can hold so it goes into TransformSystem without the ecs
+	const int64_t LEVEL_TRANSFORMS = 100000;
+	const size_t PIPELINE_ENTITIES = 1000;
+	const size_t PIPELINE_FRAMES = 500;
+	const size_t PIPELINE_GUI_ELEMENTS = 100;
+	//a power of two, the made up frames below are whole and half steps of it and come out exact
+	const double FIXED_RATE = 64.0;
+
+	bool isNear(const Mat4f& value, const Mat4f& expected) {
+		const float* v = &value.m00;
+		const float* e = &expected.m00;
+
+		for (int i = 0; i < 16; ++i) {
+			if (std::fabs(v[i] - e[i]) > 1e-4f * (1.0f + std::fabs(e[i])))
+				return false;
+		}
+
+		return true;
+	}
+
+	//one mesh per entity, so packet i is entity i
+	Mat4f getExtractedMatrix(Scene& scene, const unsigned int& index) {
+		RenderSnapshot snapshot;
+		scene.extract(snapshot);
+
+		return index < snapshot.packets.size() ? snapshot.packets[index].transform : Mat4f();
+	}
+
+	//a child gets drawn with its parents world matrix in it, also after the parent moves
+	void extractedChildFollowsParent() {
+		std::unique_ptr<Scene> scene(createEntityScene(2, createCubeMesh(), SCENE_EXTENT, SEED));
+		System& system = *scene->getSystem();
+
+		GameObject parent((*system.getEntities())[0], scene.get());
+		GameObject child((*system.getEntities())[1], scene.get());
+		HBM_REQUIRE(child.setParent(parent));
+
+		Transform& parentTransform = parent.getComponent<Transform>();
+		Transform& childTransform = child.getComponent<Transform>();
+
+		for (int step = 0; step < 3; ++step) {
+			scene->updateTransforms();
+			HBM_EXPECT(!parentTransform.dirty && !childTransform.dirty);
+
+			Mat4f expected;
+			MatrixKernels::multiplyScalar(parentTransform.createLocalMatrix(), childTransform.createLocalMatrix(), expected);
+
+			HBM_EXPECT(isNear(getExtractedMatrix(*scene, 0), parentTransform.createLocalMatrix()));
+			HBM_EXPECT(isNear(getExtractedMatrix(*scene, 1), expected));
+
+			//only the parent moves, the child isn't dirty itself
+			parentTransform.setPosition(parentTransform.position + Vec3f(1, 2, 3));
+			parentTransform.setRotation(parentTransform.rotation + Vec3f(0, 15, 0));
+		}
+	}
+
+	//a packet gets drawn with its meshes material as it was when it got extracted, a change shows up in the next extraction and a mesh that's
+	//gone doesn't keep its textures alive through the snapshot
+	void extractedMaterials() {
+		std::unique_ptr<Scene> scene(createEntityScene(2, createCubeMesh(), SCENE_EXTENT, SEED));
+		System& system = *scene->getSystem();
+
+		GameObject first((*system.getEntities())[0], scene.get());
+		Material& material = first.getComponent<MeshComponent>().meshes[0].material;
+
+		TextureHandle texture(std::make_shared<Asset<Texture>>());
+		material.diffuseMap = texture;
+
+		scene->updateTransforms();
+
+		RenderSnapshot snapshot;
+		scene->extract(snapshot);
+
+		HBM_REQUIRE(snapshot.packets.size() == 2 && snapshot.materials.size() == 2);
+		HBM_EXPECT(snapshot.getMaterial(snapshot.packets[0]).diffuseMap == texture);
+		//the check, the mesh and the snapshot
+		HBM_EXPECT(texture.getReferenceAmount() == 3);
+
+		material.diffuseColor = Vec3f(1, 0, 0);
+		HBM_EXPECT(snapshot.getMaterial(snapshot.packets[0]).diffuseColor.y != 0);
+
+		snapshot.clear();
+		scene->extract(snapshot);
+		HBM_EXPECT(snapshot.getMaterial(snapshot.packets[0]).diffuseColor.y == 0);
+		HBM_EXPECT(texture.getReferenceAmount() == 3);
+
+		scene->destroyGameObject(first);
+
+		snapshot.clear();
+		scene->extract(snapshot);
+		HBM_EXPECT(snapshot.packets.size() == 1 && snapshot.materials.size() == 1);
+		HBM_EXPECT(texture.getReferenceAmount() == 1);
+	}
+
+	//Time on a clock the check moves by hand with FIXED_RATE steps, glfw's clock and the old rate come back when it goes
+	class ClockScope {
+	private:
+		double rate;
+		double now = 0;
+
+	public:
+		ClockScope() : rate(Time::getFixedRate()) {
+			Time::setClock([this]() { return now; });
+			Time::setFixedRate(FIXED_RATE);
+			Time::update();
+			Time::resetFixedSteps();
+		}
+
+		ClockScope(const ClockScope&) = delete;
+		ClockScope& operator=(const ClockScope&) = delete;
+
+		~ClockScope() {
+			Time::setClock(std::function<double()>());
+			Time::setFixedRate(rate);
+			Time::resetFixedSteps();
+		}
+
+		void advance(const double& steps) {
+			now += steps * 1000.0 / FIXED_RATE;
+			Time::update();
+		}
+	};
+
+	//what Engine::updateEngine does with the fixed steps, every step moves the entity one along x
+	void stepFixed(Scene& scene, Transform& transform) {
+		while (Time::stepFixed()) {
+			FixedStepScope step;
+			scene.fixedUpdate();
+			transform.setPosition(transform.position + Vec3f(1, 0, 0));
+		}
+	}
+
+	//an interpolated transform moved one along x by each of two steps and drawn half a step after the second one is halfway between them,
+	//one that isn't interpolated is drawn where the last step left it and so is an interpolated one that got teleported
+	void extractedTransformInterpolates() {
+		ClockScope clock;
+		std::unique_ptr<Scene> scene(createEntityScene(2, createCubeMesh(), SCENE_EXTENT, SEED));
+		System& system = *scene->getSystem();
+
+		Transform& moving = GameObject((*system.getEntities())[0], scene.get()).getComponent<Transform>();
+		Transform& still = GameObject((*system.getEntities())[1], scene.get()).getComponent<Transform>();
+		moving.interpolated = true;
+
+		const Vec3f start = moving.position;
+
+		clock.advance(1);
+		stepFixed(*scene, moving);
+		clock.advance(1);
+		stepFixed(*scene, moving);
+
+		HBM_REQUIRE(Time::getFixedSteps() == 2);
+
+		clock.advance(0.5);
+		stepFixed(*scene, moving);
+		scene->updateTransforms();
+
+		RenderSnapshot snapshot;
+		scene->extract(snapshot);
+		HBM_REQUIRE(snapshot.packets.size() == 2);
+		HBM_EXPECT(snapshot.interpolationAlpha == 0.5f);
+
+		Transform halfway = moving;
+		halfway.position = start + Vec3f(1.5f, 0, 0);
+
+		HBM_EXPECT(isNear(snapshot.packets[0].transform, halfway.createLocalMatrix()));
+		HBM_EXPECT(isNear(snapshot.packets[1].transform, still.worldMatrix));
+
+		moving.hasPreviousStep = false;
+		HBM_EXPECT(isNear(getExtractedMatrix(*scene, 0), moving.worldMatrix));
+	}
+
+	//what would have gone to glDeleteVertexArrays, in the order it got there, and how much of it came from another thread than the one
+	//running the frames (the one with the gl context)
+	struct DeletedVertexArrays {
+		std::vector<unsigned int> vertexArrays;
+		//the frame the main thread was on when each of them went
+		std::vector<size_t> frames;
+		size_t frame = 0;
+		size_t wrongThread = 0;
+	};
+
+	//whatever happens in a check, the simulation thread is gone afterwards and gl is the backend again, what it left queued goes to deleted
+	class PipelineScope {
+	public:
+		PipelineScope(DeletedVertexArrays& deleted) {
+			const std::thread::id mainThread = std::this_thread::get_id();
+
+			RenderPipelineBackend backend;
+			backend.deleteVertexArrays = [&deleted, mainThread](const size_t& amount, const unsigned int* vertexArrays) {
+				for (size_t i = 0; i < amount; ++i) {
+					deleted.vertexArrays.push_back(vertexArrays[i]);
+					deleted.frames.push_back(deleted.frame);
+				}
+
+				deleted.wrongThread += std::this_thread::get_id() != mainThread ? amount : 0;
+			};
+
+			RenderPipeline::setBackend(backend);
+			RenderPipeline::setEnabled(true);
+		}
+
+		PipelineScope(const PipelineScope&) = delete;
+		PipelineScope& operator=(const PipelineScope&) = delete;
+
+		~PipelineScope() {
+			RenderPipeline::setEnabled(false);
+			RenderPipeline::setBackend(RenderPipelineBackend());
+		}
+	};
+
+	//adds up every matrix the way a draw goes through them, two snapshots with the same sum drew the same thing
+	double getChecksum(const RenderSnapshot& snapshot) {
+		double out = 0;
+
+		for (size_t i = 0; i < snapshot.packets.size(); ++i) {
+			const float* matrix = &snapshot.packets[i].transform.m00;
+
+			for (int j = 0; j < 16; ++j)
+				out += matrix[j] * (double)(j + 1);
+		}
+
+		return out;
+	}
+
+	//both stages of pipelined frames the way Scene::updateEditor runs them, scripts moving every entity and a gui element on the simulation thread
+	//while the main thread goes through the snapshot of the frame before and lays out the gui once endFrame returned, the render stage is reading
+	//every packet instead of drawing it. the front snapshot has to be exactly what its simulation extracted however much the scene moved since,
+	//and a mesh that dies on the simulation thread every frame has its vertex array deleted by the endFrame of that frame on the main thread,
+	//once and in order, through a backend that counts instead of calling gl
+	void pipelinedFrames() {
+		std::unique_ptr<Scene> scene(createEntityScene(PIPELINE_ENTITIES, createCubeMesh(), SCENE_EXTENT, SEED));
+		addMovers(*scene);
+
+		GuiWorkload gui(PIPELINE_GUI_ELEMENTS);
+		GuiElement& element = *gui.getRoot()->firstChild->firstChild;
+
+		const size_t start = RenderPipeline::getFrameNumber();
+		//the sum every simulation got when it extracted, a frame only ever writes its own
+		std::vector<double> extracted(PIPELINE_FRAMES + 1, 0);
+
+		size_t mismatched = 0;
+		size_t drawn = 0;
+		size_t guiLayouts = 0;
+		DeletedVertexArrays deleted;
+
+		{
+			PipelineScope pipeline(deleted);
+
+			for (size_t i = 0; i < PIPELINE_FRAMES; ++i) {
+				deleted.frame = i;
+
+				RenderPipeline::beginFrame([&scene, &element, &extracted, start](RenderSnapshot& snapshot) {
+					//made up, no gl ever saw it, it's only here to die on this thread
+					Mesh dying;
+					dying.VAO = (unsigned int)(snapshot.frameNumber - start);
+
+					scene->update();
+					scene->updateTransforms();
+					scene->extract(snapshot);
+
+					element.rotation = (float)(snapshot.frameNumber % 360);
+					element.markDirty();
+
+					extracted[snapshot.frameNumber - start] = getChecksum(snapshot);
+				});
+
+				//the first front is whatever the pipeline had from before
+				const RenderSnapshot& front = RenderPipeline::getFront();
+
+				if (i > 0) {
+					mismatched += front.frameNumber != start + i || getChecksum(front) != extracted[i] ? 1 : 0;
+					drawn += front.packets.size();
+				}
+
+				RenderPipeline::endFrame();
+
+				GuiCanvas::submitDirtyRegions();
+				guiLayouts += GuiCanvas::getLayoutAmount();
+				QuadBatcher::clear();
+			}
+		}
+
+		destroyMovers(*scene);
+
+		HBM_EXPECT(!RenderPipeline::isEnabled());
+		HBM_EXPECT(mismatched == 0);
+		HBM_EXPECT(drawn == (PIPELINE_FRAMES - 1) * PIPELINE_ENTITIES);
+		//the first frame lays out all of it, every one after only the element
+		HBM_EXPECT(guiLayouts >= PIPELINE_FRAMES - 1 + PIPELINE_GUI_ELEMENTS);
+		HBM_EXPECT(RenderPipeline::getQueuedDeletions() == 0);
+
+		size_t misplaced = 0;
+
+		for (size_t i = 0; i < deleted.vertexArrays.size(); ++i)
+			misplaced += deleted.vertexArrays[i] != i + 1 || deleted.frames[i] != i ? 1 : 0;
+
+		HBM_EXPECT(deleted.vertexArrays.size() == PIPELINE_FRAMES);
+		HBM_EXPECT(misplaced == 0 && deleted.wrongThread == 0);
+
+		report(std::to_string(PIPELINE_FRAMES) + " pipelined frames, " + std::to_string(drawn) + " packets read, " + std::to_string(mismatched) + " snapshots changed after extraction");
+	}
+
+	//transforms and extraction of a scene nothing moved in, range(0) entities
+	void staticSceneFrame(BenchmarkState& state) {
+		std::unique_ptr<Scene> scene(createEntityScene((size_t)state.range(0), createCubeMesh(), SCENE_EXTENT, SEED));
+		scene->updateTransforms();
+
+		RenderSnapshot snapshot;
+
+		while (state.keepRunning()) {
+			scene->updateTransforms();
+
+			snapshot.clear();
+			scene->extract(snapshot);
+		}
+
+		state.counters["packets"] = (double)snapshot.packets.size();
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+
+	//range(0) transforms where nothing moved straight through TransformSystem, what the transforms of a still level cost every frame
+	void staticTransforms(BenchmarkState& state) {
+		std::mt19937 random(SEED);
+		std::uniform_real_distribution<float> position(-SCENE_EXTENT / 2, SCENE_EXTENT / 2);
+		std::uniform_real_distribution<float> angle(0, 360);
+
+		std::vector<Transform> transforms((size_t)state.range(0));
+
+		for (Transform& transform : transforms) {
+			//one at a time like createEntityScene, so the same seed makes the same transforms everywhere
+			transform.position.x = position(random);
+			transform.position.y = position(random);
+			transform.position.z = position(random);
+			transform.rotation.x = angle(random);
+			transform.rotation.y = angle(random);
+			transform.markDirty();
+		}
+
+		TransformSystem::update(transforms.data(), transforms.size());
+
+		unsigned int rebuilt = 0;
+
+		while (state.keepRunning())
+			rebuilt += TransformSystem::update(transforms.data(), transforms.size());
+
+		state.counters["rebuilt"] = (double)rebuilt;
+		state.setItemsProcessed((int64_t)state.getIterations() * state.range(0));
+	}
+}
+
+HBM_CHECK(extractedChildFollowsParent);
+HBM_CHECK(extractedMaterials);
+HBM_CHECK(pipelinedFrames);
+HBM_CHECK(extractedTransformInterpolates);
+
+//a 100k entity scene doesn't fit in HFR_MAX_ENTITIES, so the scene goes up to a full one and the 100k transforms are timed on their own
+HBM_BENCHMARK(staticSceneFrame)->range(64, 4096)->arg(FULL_SCENE)->unit(TimeUnit::Microsecond);
+HBM_BENCHMARK(staticTransforms)->range(64, 32768)->arg(LEVEL_TRANSFORMS)->unit(TimeUnit::Microsecond);
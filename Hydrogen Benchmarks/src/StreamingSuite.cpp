@@ -0,0 +1,167 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the texture streamer following a camera down a row of cooked textures, with the loader not uploading (no gl context)
+//so every level change only moves firstLevel, which is all the streamer looks at anyway
+
+namespace {
+	const size_t TEXTURE_AMOUNT = 16;
+	const int TEXTURE_SIZE = 512;
+	const float SPACING = 40.0f;
+	const float RADIUS = 4.0f;
+	//a bit off the row so the camera goes past the spheres instead of through them
+	const float CAMERA_OFFSET = 6.0f;
+	const int PATH_FRAMES = 600;
+	const int SETTLE_FRAMES = 200;
+	const int SAMPLE_FRAMES = 50;
+	//room for the base levels of all of them and about three at full size, so going down the row has to give levels back
+	const size_t BUDGET = 640 * 1024;
+
+	std::vector<std::string> getCookedTextures() {
+		static std::vector<std::string> paths;
+
+		if (!paths.empty())
+			return paths;
+
+		CompressionSettings settings;
+		settings.format = HFR_TEXTURE_FORMAT_BC1;
+		settings.quality = HFR_COMPRESSION_FAST;
+
+		for (size_t i = 0; i < TEXTURE_AMOUNT; ++i) {
+			const std::string path = getAssetDirectory() + "streamed " + std::to_string(i) + ".htex";
+			CookedTexture existing;
+
+			//cooked once and used by every run after that
+			if (!VirtualFileSystem::exists(path) || !existing.open(path) || existing.getWidth() != TEXTURE_SIZE) {
+				existing.close();
+
+				Image image(TEXTURE_SIZE, TEXTURE_SIZE, 4, NULL);
+				for (size_t texel = 0; texel < (size_t)TEXTURE_SIZE * TEXTURE_SIZE; ++texel) {
+					image.data[texel * 4 + 0] = (unsigned char)(texel % TEXTURE_SIZE / 2);
+					image.data[texel * 4 + 1] = (unsigned char)(texel / TEXTURE_SIZE / 2);
+					image.data[texel * 4 + 2] = (unsigned char)(i * 16);
+					image.data[texel * 4 + 3] = 255;
+				}
+
+				if (!TextureCompressor::cook(image, path, settings)) {
+					paths.clear();
+					break;
+				}
+			}
+
+			paths.push_back(path);
+		}
+
+		return paths;
+	}
+
+	Vec3f getPosition(const size_t& index) {
+		return Vec3f(index * SPACING, 0, 0);
+	}
+
+	//what the renderer would do for every draw followed by what the engine does every frame, the camera looks down the row
+	//so whatever it went past got culled and doesn't get drawn anymore
+	void runFrame(const std::vector<TextureHandle>& textures) {
+		for (size_t i = 0; i < textures.size(); ++i) {
+			if (getPosition(i).x + RADIUS >= Renderer::view.camera.position.x)
+				TextureStreamer::markVisible(textures[i], getPosition(i), RADIUS);
+		}
+
+		AssetLoader::update();
+		TextureStreamer::update();
+
+		//about a frames worth of time for the reads on the workers
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	std::string toKilobytes(const size_t& bytes) {
+		return std::to_string(bytes / 1024) + " KB";
+	}
+
+	//the camera goes down the whole row and stops at the end: resident memory never goes over the budget, what the camera is next to
+	//ends up at full size and what it left behind (seen the longest ago) gave its levels back first, resident memory over the path and the request latency get reported
+	void textureStreamingCameraPath() {
+		const std::vector<std::string> paths = getCookedTextures();
+		HBM_REQUIRE(paths.size() == TEXTURE_AMOUNT);
+
+		const bool uploading = AssetLoader::isUploading();
+		const size_t budget = TextureStreamer::getBudget();
+		const Vec3f camera = Renderer::view.camera.position;
+
+		AssetLoader::setUploading(false);
+		Renderer::setWindowSize(1920, 1080);
+		TextureStreamer::clear();
+		TextureStreamer::resetCounters();
+		TextureStreamer::setBudget(BUDGET);
+
+		std::vector<TextureHandle> textures;
+		for (size_t i = 0; i < paths.size(); ++i)
+			textures.push_back(TextureStreamer::load(paths[i]));
+
+		AssetLoader::waitForAll();
+
+		size_t ready = 0;
+		for (size_t i = 0; i < textures.size(); ++i) {
+			if (textures[i].isReady() && textures[i].get().firstLevel > 0)
+				ready++;
+		}
+
+		//everything starts out with only the small levels
+		HBM_EXPECT(ready == textures.size());
+
+		size_t peak = 0;
+		int overBudget = 0;
+		std::vector<bool> reachedFull(textures.size(), false);
+		const float start = -SPACING;
+		const float end = getPosition(TEXTURE_AMOUNT - 1).x;
+
+		for (int frame = 0; frame < PATH_FRAMES + SETTLE_FRAMES; ++frame) {
+			const float progress = min(frame / (float)PATH_FRAMES, 1.0f);
+			Renderer::view.camera.position = Vec3f(start + (end - start) * progress, CAMERA_OFFSET, 0);
+
+			runFrame(textures);
+
+			const size_t resident = TextureStreamer::getResidentMemory();
+			peak = max(peak, resident);
+
+			if (resident > BUDGET)
+				overBudget++;
+
+			for (size_t i = 0; i < textures.size(); ++i)
+				reachedFull[i] = reachedFull[i] || textures[i].get().firstLevel == 0;
+
+			if (frame % SAMPLE_FRAMES == 0)
+				report("frame " + std::to_string(frame) + ": " + toKilobytes(resident) + " resident, " + std::to_string(TextureStreamer::getPendingAmount()) + " reads in flight");
+
+			if (frame >= PATH_FRAMES && TextureStreamer::getPendingAmount() == 0 && textures.back().get().firstLevel == 0)
+				break;
+		}
+
+		HBM_EXPECT(overBudget == 0);
+		HBM_EXPECT(textures.back().get().firstLevel == 0);
+		HBM_EXPECT(textures.front().get().firstLevel > 0);
+		HBM_EXPECT(TextureStreamer::getCompletedRequests() > 0);
+
+		report(toKilobytes(peak) + " peak of " + toKilobytes(BUDGET) + ", " + std::to_string(std::count(reachedFull.begin(), reachedFull.end(), true)) + " of " +
+			std::to_string(textures.size()) + " got to full size on the way, " + std::to_string(TextureStreamer::getCompletedRequests()) + " levels streamed in, " +
+			std::to_string(TextureStreamer::getAverageLatency()) + " ms average and " + std::to_string(TextureStreamer::getMaxLatency()) + " ms max latency");
+
+		//the streamer lets go of entries nobody else holds on its next update
+		textures.clear();
+		TextureStreamer::update();
+		HBM_EXPECT(TextureStreamer::getEntryAmount() == 0);
+
+		TextureStreamer::clear();
+		TextureStreamer::resetCounters();
+		TextureStreamer::setBudget(budget);
+		AssetLoader::setUploading(uploading);
+		Renderer::view.camera.position = camera;
+	}
+}
+
+HBM_CHECK(textureStreamingCameraPath);
@@ -0,0 +1,245 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Json.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//frame telemetry fed synthetic frame times with known distributions, the percentiles against a sorted copy, hitches over a window that wraps around
+//and the json report replays get compared with
+
+namespace {
+	const unsigned int SEED = 1;
+	const size_t WINDOW = HFR_TELEMETRY_FRAMES;
+	const float STEADY_MILLISECONDS = 16.6f;
+	const float SPIKE_MILLISECONDS = 50.0f;
+	//every this many frames one takes SPIKE_MILLISECONDS
+	const size_t SPIKE_PERIOD = 100;
+	const size_t SPIKY_FRAMES = 1000;
+	//dumpJson writes 6 significant digits
+	const double JSON_TOLERANCE = 1e-5;
+
+	//the window and hitch settings go back to what they were, and the synthetic frames don't stay around
+	class TelemetryScope {
+	private:
+		size_t capacity;
+		float hitchFactor;
+		float hitchMilliseconds;
+
+	public:
+		TelemetryScope() : capacity(FrameTelemetry::getCapacity()), hitchFactor(FrameTelemetry::hitchFactor), hitchMilliseconds(FrameTelemetry::hitchMilliseconds) {
+			FrameTelemetry::setCapacity(WINDOW);
+			FrameTelemetry::hitchFactor = HFR_TELEMETRY_HITCH_FACTOR;
+			FrameTelemetry::hitchMilliseconds = HFR_TELEMETRY_HITCH_MILLISECONDS;
+		}
+
+		~TelemetryScope() {
+			FrameTelemetry::setCapacity(capacity);
+			FrameTelemetry::hitchFactor = hitchFactor;
+			FrameTelemetry::hitchMilliseconds = hitchMilliseconds;
+		}
+	};
+
+	FrameSample createSample(const float& milliseconds) {
+		FrameSample out = {};
+		out.frameTime = milliseconds;
+		out.cpuTime = milliseconds / 2;
+		return out;
+	}
+
+	void addFrames(const std::vector<float>& frameTimes) {
+		for (const float& frameTime : frameTimes)
+			FrameTelemetry::addSample(createSample(frameTime));
+	}
+
+	//nearest rank, the same definition FrameTelemetry says it uses
+	float getPercentile(const std::vector<float>& sorted, const double& fraction) {
+		const size_t rank = (size_t)std::ceil(fraction * sorted.size());
+		return sorted[rank > 0 ? rank - 1 : 0];
+	}
+
+	//every statistic is exactly the value a sorted copy of the window has at that rank
+	bool matches(const FrameStats& stats, std::vector<float> frameTimes) {
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		const double average = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frameTimes.size();
+
+		return stats.frames == frameTimes.size() && stats.p50 == getPercentile(frameTimes, 0.5) && stats.p95 == getPercentile(frameTimes, 0.95) &&
+			stats.p99 == getPercentile(frameTimes, 0.99) && stats.max == frameTimes.back() && std::fabs(stats.average - average) <= average * 1e-5;
+	}
+
+	std::string toString(const FrameStats& stats) {
+		return std::to_string(stats.frames) + " frames, " + std::to_string(stats.average) + " average, " + std::to_string(stats.p50) + " p50, " +
+			std::to_string(stats.p95) + " p95, " + std::to_string(stats.p99) + " p99, " + std::to_string(stats.max) + " max";
+	}
+
+	std::vector<float> createUniform() {
+		std::vector<float> out;
+
+		for (int i = 1; i <= 100; ++i)
+			out.push_back((float)i);
+
+		return out;
+	}
+
+	//a steady frame rate with a long tail, what a game with the odd slow frame looks like
+	std::vector<float> createExponentialTail(const size_t& frames) {
+		std::mt19937 random(SEED);
+		std::exponential_distribution<float> tail(1.0f / 4.0f);
+		std::vector<float> out(frames);
+
+		for (float& frameTime : out)
+			frameTime = 12.0f + tail(random);
+
+		return out;
+	}
+
+	std::vector<float> createSpiky(const size_t& frames) {
+		std::vector<float> out(frames);
+
+		for (size_t i = 0; i < frames; ++i)
+			out[i] = i % SPIKE_PERIOD == SPIKE_PERIOD - 1 ? SPIKE_MILLISECONDS : STEADY_MILLISECONDS;
+
+		return out;
+	}
+
+	//1 to 100 ms has its percentiles on whole numbers, a long tail and a window that has wrapped around (only the newest WINDOW frames count)
+	void telemetryPercentiles() {
+		TelemetryScope scope;
+
+		const std::vector<float> uniform = createUniform();
+		addFrames(uniform);
+
+		const FrameStats stats = FrameTelemetry::getFrameStats();
+		HBM_EXPECT(matches(stats, uniform));
+		HBM_EXPECT(stats.p50 == 50 && stats.p95 == 95 && stats.p99 == 99 && stats.max == 100);
+		HBM_EXPECT_NEAR(stats.average, 50.5, 1e-4);
+
+		std::vector<float> cpuTimes(uniform);
+		for (float& cpuTime : cpuTimes)
+			cpuTime /= 2;
+
+		HBM_EXPECT(matches(FrameTelemetry::getCpuStats(), cpuTimes));
+
+		FrameTelemetry::clear();
+
+		const std::vector<float> tail = createExponentialTail(WINDOW * 2 + WINDOW / 3);
+		addFrames(tail);
+
+		const std::vector<float> window(tail.end() - WINDOW, tail.end());
+		HBM_EXPECT(FrameTelemetry::getFrameAmount() == WINDOW);
+		HBM_EXPECT(FrameTelemetry::getSample(0).frameTime == tail.back());
+		HBM_EXPECT(FrameTelemetry::getSample(WINDOW - 1).frameTime == window.front());
+		HBM_EXPECT(matches(FrameTelemetry::getFrameStats(), window));
+
+		std::vector<float> cpuWindow(window);
+		for (float& cpuTime : cpuWindow)
+			cpuTime /= 2;
+
+		HBM_EXPECT(matches(FrameTelemetry::getCpuStats(), cpuWindow));
+
+		report("uniform: " + toString(stats));
+		report("exponential tail: " + toString(FrameTelemetry::getFrameStats()));
+	}
+
+	//a spike every SPIKE_PERIOD frames over a steady frame rate, every one of them is a hitch, the window only counts the ones still in it
+	//and nothing under hitchMilliseconds counts however much slower than the average it is
+	void telemetryHitches() {
+		TelemetryScope scope;
+
+		const size_t before = FrameTelemetry::getTotalHitches();
+		addFrames(createSpiky(SPIKY_FRAMES));
+
+		const FrameStats stats = FrameTelemetry::getFrameStats();
+		HBM_EXPECT(stats.frames == WINDOW && stats.p50 == STEADY_MILLISECONDS && stats.p99 == STEADY_MILLISECONDS && stats.max == SPIKE_MILLISECONDS);
+		HBM_EXPECT(FrameTelemetry::getHitches() == WINDOW / SPIKE_PERIOD);
+		HBM_EXPECT(FrameTelemetry::getTotalHitches() - before == SPIKY_FRAMES / SPIKE_PERIOD);
+		HBM_EXPECT(FrameTelemetry::getSample(0).hitch && !FrameTelemetry::getSample(1).hitch);
+
+		report(std::to_string(FrameTelemetry::getHitches()) + " hitches in the window, " + std::to_string(FrameTelemetry::getTotalHitches() - before) + " over " +
+			std::to_string(SPIKY_FRAMES) + " frames");
+
+		FrameTelemetry::clear();
+
+		//3 times the average but under the floor
+		addFrames(std::vector<float>(10, 4.0f));
+		addFrames(std::vector<float>(1, 12.0f));
+		HBM_EXPECT(FrameTelemetry::getHitches() == 0);
+	}
+
+	bool hasStats(const JsonValue* value, const FrameStats& stats) {
+		if (value == nullptr || !value->is(JsonType::Object))
+			return false;
+
+		const char* names[] = { "average", "p50", "p95", "p99", "max" };
+		const float expected[] = { stats.average, stats.p50, stats.p95, stats.p99, stats.max };
+
+		for (size_t i = 0; i < 5; ++i) {
+			const JsonValue* number = value->find(names[i], JsonType::Number);
+
+			if (number == nullptr || std::fabs(number->number - expected[i]) > std::fabs(expected[i]) * JSON_TOLERANCE)
+				return false;
+		}
+
+		return true;
+	}
+
+	//the report parses, has every field compareReports flattens and the numbers are the ones the statistics give,
+	//a subsystem with quotes in its name comes through escaped
+	void telemetryReportJson() {
+		TelemetryScope scope;
+
+		const std::string subsystem = "Telemetry check \"quoted\" subsystem";
+		FrameTelemetry::trackSubsystem(subsystem);
+		addFrames(createExponentialTail(WINDOW));
+
+		const std::string path = getAssetDirectory() + "telemetry/report.json";
+		HBM_REQUIRE(FrameTelemetry::dumpJson(path));
+
+		JsonValue json;
+		HBM_REQUIRE(readJson(path, json));
+		HBM_REQUIRE(json.is(JsonType::Object));
+
+		const JsonValue* frames = json.find("frames", JsonType::Number);
+		const JsonValue* hitches = json.find("hitches", JsonType::Number);
+		HBM_EXPECT(frames != nullptr && frames->number == WINDOW);
+		HBM_EXPECT(hitches != nullptr && hitches->number == FrameTelemetry::getHitches());
+
+		HBM_EXPECT(hasStats(json.find("frameTime"), FrameTelemetry::getFrameStats()));
+		HBM_EXPECT(hasStats(json.find("cpuTime"), FrameTelemetry::getCpuStats()));
+		HBM_EXPECT(hasStats(json.find("gpuTime"), FrameTelemetry::getGpuStats()));
+
+		const JsonValue* subsystems = json.find("subsystems", JsonType::Object);
+		HBM_REQUIRE(subsystems != nullptr);
+		//never ran, so all zeros
+		HBM_EXPECT(hasStats(subsystems->find(subsystem), FrameTelemetry::getSubsystemStats(subsystem)));
+
+		for (size_t i = 0; i < subsystems->items.size(); ++i)
+			HBM_EXPECT(hasStats(&subsystems->items[i], FrameTelemetry::getSubsystemStats(subsystems->names[i])));
+	}
+
+	//range(0) frames in the window, what working out the statistics costs (they sort a copy every time)
+	void telemetryStats(BenchmarkState& state) {
+		TelemetryScope scope;
+
+		const size_t frames = (size_t)state.range(0);
+		FrameTelemetry::setCapacity(frames);
+		addFrames(createExponentialTail(frames));
+
+		while (state.keepRunning()) {
+			const FrameStats stats = FrameTelemetry::getFrameStats();
+			doNotOptimize(stats.p99);
+		}
+
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)frames);
+	}
+}
+
+HBM_CHECK(telemetryPercentiles);
+HBM_CHECK(telemetryHitches);
+HBM_CHECK(telemetryReportJson);
+
+//the default window and the ones replays make for runs of a few minutes
+HBM_BENCHMARK(telemetryStats)->range(600, 38400, 4)->unit(TimeUnit::Microsecond);
@@ -0,0 +1,103 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//glyph atlases for a big cjk subset, one distance field cache that does every size against a bitmap cache per size,
+//only the cpu side (freetype, the distance fields and packing), nothing gets uploaded
+
+namespace {
+	const uint32_t CJK_FIRST = 0x4E00;
+	const uint32_t CJK_AMOUNT = 3000;
+	//the sizes a ui would want bitmap atlases for
+	const int BITMAP_SIZES[] = { 12, 16, 24, 32, 48, 64 };
+
+	//nothing cjk ships in res/, so whichever of these is there (the windows ones are on pretty much every install)
+	std::string findCJKFont() {
+		const std::string candidates[] = {
+			HFR_RES + "fonts/noto/NotoSansCJK-Regular.ttc",
+			"C:/Windows/Fonts/msyh.ttc",
+			"C:/Windows/Fonts/simsun.ttc",
+			"C:/Windows/Fonts/msgothic.ttc",
+			"C:/Windows/Fonts/malgun.ttf"
+		};
+
+		for (const std::string& candidate : candidates) {
+			if (VirtualFileSystem::exists(candidate))
+				return candidate;
+		}
+
+		return "";
+	}
+
+	std::vector<uint32_t> getCodepoints() {
+		std::vector<uint32_t> out(CJK_AMOUNT);
+
+		for (uint32_t i = 0; i < CJK_AMOUNT; ++i)
+			out[i] = CJK_FIRST + i;
+
+		return out;
+	}
+
+	struct AtlasTotals {
+		size_t memory = 0;
+		size_t glyphs = 0;
+		size_t atlases = 0;
+	};
+
+	bool buildAtlas(const std::string& path, const bool& distanceField, const int& pixelSize, const std::vector<uint32_t>& codepoints, AtlasTotals& totals) {
+		GlyphCache cache(path, distanceField, pixelSize);
+
+		if (!cache.open())
+			return false;
+
+		for (size_t i = 0; i < codepoints.size(); ++i)
+			cache.cacheGlyph(codepoints[i]);
+
+		totals.memory += cache.getMemoryUsage();
+		totals.glyphs += cache.getGlyphAmount();
+		totals.atlases += 1;
+
+		return true;
+	}
+
+	//range(0) is 1 for the one distance field atlas and 0 for a bitmap atlas at every size in BITMAP_SIZES,
+	//glyphs that don't fit in HFR_MAX_GLYPH_ATLAS_SIZE get evicted like they would in the engine, so glyphs says how many made it
+	void cjkGlyphAtlas(BenchmarkState& state) {
+		const std::string path = findCJKFont();
+
+		if (path.empty()) {
+			state.skipWithError("No cjk font, put one at " + HFR_RES + "fonts/noto/NotoSansCJK-Regular.ttc");
+			return;
+		}
+
+		const bool distanceField = state.range(0) != 0;
+		const std::vector<uint32_t> codepoints = getCodepoints();
+		AtlasTotals totals;
+
+		while (state.keepRunning()) {
+			totals = AtlasTotals();
+			bool built = true;
+
+			if (distanceField)
+				built = buildAtlas(path, true, HFR_SDF_GLYPH_SIZE, codepoints, totals);
+			else {
+				for (const int& size : BITMAP_SIZES)
+					built = built && buildAtlas(path, false, size, codepoints, totals);
+			}
+
+			if (!built) {
+				state.skipWithError("Couldn't open " + path);
+				return;
+			}
+		}
+
+		state.counters["atlases"] = (double)totals.atlases;
+		state.counters["glyphs"] = (double)totals.glyphs;
+		state.counters["atlas MB"] = (double)totals.memory / (1024.0 * 1024.0);
+		state.setItemsProcessed((int64_t)state.getIterations() * (int64_t)codepoints.size());
+	}
+}
+
+HBM_BENCHMARK(cjkGlyphAtlas)->arg(1)->arg(0)->unit(TimeUnit::Millisecond);
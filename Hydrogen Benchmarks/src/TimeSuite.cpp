@@ -0,0 +1,185 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//the fixed step accumulator on a made up clock, runs fed the same frames end up in the same state and so do runs with the same time cut into
+//different frames, long frames get clamped and getDeltaTime is the fixed delta inside a step and the frame delta after it however the loop ends
+
+namespace {
+	//a power of two, so the steps and the frame times below are exact in floats and doubles and no run can be a rounding error off
+	const double FIXED_RATE = 64.0;
+	//frames are whole multiples of 1 / 512 of a second, 8 of them make a step
+	const double TICK_MILLISECONDS = 1000.0 / 512.0;
+	const int TICKS_PER_STEP = 8;
+	const size_t FRAMES = 2000;
+	const unsigned int SEED = 1;
+
+	//Time reads the made up clock with FIXED_RATE steps while it's around, glfw's clock and the old rate come back when it goes
+	class ClockScope {
+	private:
+		double rate;
+
+	public:
+		double now = 0;
+
+		ClockScope() : rate(Time::getFixedRate()) {
+			Time::setClock([this]() { return now; });
+			Time::setFixedRate(FIXED_RATE);
+			Time::resetFixedSteps();
+		}
+
+		ClockScope(const ClockScope&) = delete;
+		ClockScope& operator=(const ClockScope&) = delete;
+
+		~ClockScope() {
+			Time::setClock(std::function<double()>());
+			Time::setFixedRate(rate);
+			Time::resetFixedSteps();
+		}
+
+		void advance(const int& ticks) {
+			now += ticks * TICK_MILLISECONDS;
+			Time::update();
+		}
+	};
+
+	//a ball bouncing with a bit of drag, it only ever moves by getDeltaTime so a step with the wrong delta shows up in where it ends
+	struct Body {
+		double position = 10;
+		double velocity = 0;
+
+		bool operator==(const Body& other) const {
+			return position == other.position && velocity == other.velocity;
+		}
+	};
+
+	void step(Body& body) {
+		const double delta = Time::getDeltaTime();
+
+		body.velocity = (body.velocity - 9.81 * delta) * 0.999;
+		body.position += body.velocity * delta;
+
+		if (body.position < 0) {
+			body.position = -body.position;
+			body.velocity = -body.velocity * 0.8;
+		}
+	}
+
+	struct Run {
+		Body body;
+		size_t steps = 0;
+		double fixedTime = 0;
+	};
+
+	Run simulate(ClockScope& clock, const std::vector<int>& frames) {
+		Time::resetFixedSteps();
+		Run out;
+
+		for (const int& ticks : frames) {
+			clock.advance(ticks);
+
+			while (Time::stepFixed()) {
+				FixedStepScope scope;
+				step(out.body);
+			}
+		}
+
+		out.steps = Time::getFixedSteps();
+		out.fixedTime = Time::getFixedTime();
+		return out;
+	}
+
+	//between about 8 and 23 ms, never long enough to get clamped
+	std::vector<int> createJitteryFrames(const size_t& amount) {
+		std::mt19937 random(SEED);
+		std::uniform_int_distribution<int> ticks(4, 12);
+		std::vector<int> out(amount);
+
+		for (int& frame : out)
+			frame = ticks(random);
+
+		return out;
+	}
+
+	//the same time in one step long frames with what's left over at the end
+	std::vector<int> createSteadyFrames(const int& totalTicks) {
+		std::vector<int> out((size_t)(totalTicks / TICKS_PER_STEP), TICKS_PER_STEP);
+
+		if (totalTicks % TICKS_PER_STEP > 0)
+			out.push_back(totalTicks % TICKS_PER_STEP);
+
+		return out;
+	}
+
+	//the same jittery frames twice come out the same to the bit, and so does the same amount of time in steady frames,
+	//the frame rate only changes how the steps are spread over the frames
+	void fixedStepDeterminism() {
+		ClockScope clock;
+
+		const std::vector<int> frames = createJitteryFrames(FRAMES);
+		const int totalTicks = std::accumulate(frames.begin(), frames.end(), 0);
+
+		const Run first = simulate(clock, frames);
+		const Run second = simulate(clock, frames);
+		const Run steady = simulate(clock, createSteadyFrames(totalTicks));
+
+		HBM_EXPECT(first.steps == (size_t)(totalTicks / TICKS_PER_STEP));
+		HBM_EXPECT(first.fixedTime == first.steps / FIXED_RATE);
+		HBM_EXPECT(Time::getDroppedTime() == 0);
+
+		HBM_EXPECT(second.steps == first.steps && second.body == first.body);
+		HBM_EXPECT(steady.steps == first.steps && steady.body == first.body);
+
+		report(std::to_string(FRAMES) + " frames, " + std::to_string(first.steps) + " steps, the ball ended at " + std::to_string(first.body.position));
+	}
+
+	//a one second frame only gets HFR_MAX_FIXED_STEPS steps and the rest is dropped, the alpha is what's left in the accumulator,
+	//and breaking out of the loop after the first step still leaves the frame delta behind with the other steps waiting for the next loop
+	void fixedStepClamp() {
+		ClockScope clock;
+
+		clock.advance(512);
+
+		size_t steps = 0;
+
+		while (Time::stepFixed())
+			steps++;
+
+		HBM_EXPECT(steps == (size_t)HFR_MAX_FIXED_STEPS);
+		HBM_EXPECT(Time::getDroppedTime() == 1.0 - HFR_MAX_FIXED_STEPS / FIXED_RATE);
+		HBM_EXPECT(Time::getInterpolationAlpha() == 0);
+
+		//a step and a half and then two more, the alpha never goes past 1 however much is waiting
+		clock.advance(TICKS_PER_STEP + TICKS_PER_STEP / 2);
+		clock.advance(TICKS_PER_STEP * 2);
+		HBM_EXPECT(Time::getInterpolationAlpha() == 1);
+
+		float inside = 0;
+
+		while (Time::stepFixed()) {
+			FixedStepScope scope;
+			inside = Time::getDeltaTime();
+			break;
+		}
+
+		HBM_EXPECT(inside == (float)(1.0 / FIXED_RATE));
+		HBM_EXPECT(Time::getDeltaTime() == (float)(TICKS_PER_STEP * 2 / 512.0));
+
+		steps = 0;
+
+		while (Time::stepFixed()) {
+			FixedStepScope scope;
+			steps++;
+		}
+
+		HBM_EXPECT(steps == 2);
+		HBM_EXPECT(Time::getInterpolationAlpha() == 0.5f);
+		HBM_EXPECT(Time::getDeltaTime() == (float)(TICKS_PER_STEP * 2 / 512.0));
+	}
+}
+
+HBM_CHECK(fixedStepDeterminism);
+HBM_CHECK(fixedStepClamp);
@@ -0,0 +1,262 @@
+#include "hfpch.h"
+#include "Benchmark.h"
+#include "Check.h"
+#include "Json.h"
+#include "Workloads.h"
+
+using namespace HFR;
+using namespace HBM;
+
+//a frame capture of a synthetic workload checked against the trace event format chrome://tracing and perfetto read,
+//and the .htrace next to it converted back into the exact same json
+
+namespace {
+	const size_t FRAMES = 8;
+	const std::string WORKER_NAME = "Trace check worker";
+	//the name of the scope below, it ends up escaped in the json
+	const std::string QUOTED_NAME = "Trace check \"quoted\" update";
+
+	void spin() {
+		uint32_t value = 1;
+
+		for (int i = 0; i < 20000; ++i)
+			value = value * 1664525u + 1013904223u;
+
+		doNotOptimize(value);
+	}
+
+	//puts everything TraceCapture touches back the way it was when it goes
+	class CaptureSettings {
+	private:
+		std::string outputPath;
+		int hotkey;
+		float spikeThreshold;
+
+	public:
+		CaptureSettings() : outputPath(TraceCapture::outputPath), hotkey(TraceCapture::hotkey), spikeThreshold(TraceCapture::spikeThreshold) {}
+		~CaptureSettings() {
+			TraceCapture::outputPath = outputPath;
+			TraceCapture::hotkey = hotkey;
+			TraceCapture::spikeThreshold = spikeThreshold;
+		}
+	};
+
+	std::string readFile(const std::string& path) {
+		std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+		return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	bool isInteger(const JsonValue* value) {
+		return value != nullptr && value->is(JsonType::Number) && value->number == std::floor(value->number);
+	}
+
+	bool isTimestamp(const JsonValue* value) {
+		return value != nullptr && value->is(JsonType::Number) && value->number >= 0;
+	}
+
+	//the fields the trace event format wants for each phase this writes, with the types it wants them in
+	bool hasRequiredFields(const JsonValue& event, const std::string& phase) {
+		if (!event.find("name", JsonType::String) || !isInteger(event.find("pid")) || !isInteger(event.find("tid")))
+			return false;
+
+		if (phase == "M") {
+			const JsonValue* args = event.find("args", JsonType::Object);
+			return args != nullptr && args->find("name", JsonType::String) != nullptr;
+		}
+
+		if (!event.find("cat", JsonType::String) || !isTimestamp(event.find("ts")))
+			return false;
+
+		if (phase == "X")
+			return isTimestamp(event.find("dur"));
+
+		if (phase == "C") {
+			const JsonValue* args = event.find("args", JsonType::Object);
+			return args != nullptr && args->find("value", JsonType::Number) != nullptr;
+		}
+
+		return phase == "B" || phase == "E";
+	}
+
+	struct TraceSummary {
+		size_t frames = 0;
+		size_t scopes = 0;
+		//an end with its begin from before the capture, only the worker can have those
+		size_t unmatched = 0;
+		size_t misnested = 0;
+		size_t backwards = 0;
+		size_t invalid = 0;
+		int workerThread = -1;
+		size_t workerJobs = 0;
+		size_t quoted = 0;
+		std::map<std::string, std::vector<double>> counters;
+	};
+
+	TraceSummary summarize(const JsonValue& events) {
+		TraceSummary out;
+		std::map<int, std::vector<std::string>> open;
+		std::map<int, double> last;
+
+		for (const JsonValue& event : events.items) {
+			const JsonValue* phase = event.find("ph", JsonType::String);
+
+			if (phase == nullptr || !hasRequiredFields(event, phase->string)) {
+				out.invalid++;
+				continue;
+			}
+
+			const std::string& name = event.find("name")->string;
+			const int thread = (int)event.find("tid")->number;
+
+			if (phase->string == "M") {
+				if (name == "thread_name" && event.find("args")->find("name")->string == WORKER_NAME)
+					out.workerThread = thread;
+
+				continue;
+			}
+
+			const double timestamp = event.find("ts")->number;
+
+			if (phase->string == "X")
+				out.frames += name == "Frame" ? 1 : 0;
+			else if (phase->string == "C")
+				out.counters[name].push_back(event.find("args")->find("value")->number);
+			else {
+				//every thread goes forward in time, begins and ends nest
+				if (last.count(thread) > 0 && timestamp < last[thread])
+					out.backwards++;
+
+				last[thread] = timestamp;
+				std::vector<std::string>& stack = open[thread];
+
+				if (phase->string == "B") {
+					stack.push_back(name);
+					out.workerJobs += thread == out.workerThread && event.find("cat")->string == "job" ? 1 : 0;
+					out.quoted += name == QUOTED_NAME ? 1 : 0;
+				}
+				else if (stack.empty())
+					out.unmatched++;
+				else if (stack.back() != name)
+					out.misnested++;
+				else {
+					stack.pop_back();
+					out.scopes++;
+				}
+			}
+		}
+
+		return out;
+	}
+
+	//FRAMES frames of nested scopes on the main thread and jobs on a worker captured through the api, the json parses, every event has
+	//what its phase needs, begins and ends nest, the counters are there once a frame and the binary converts back into the same json
+	void traceCaptureJson() {
+		CaptureSettings settings;
+
+		TraceCapture::outputPath = getAssetDirectory() + "captures/trace";
+		TraceCapture::hotkey = GLFW_KEY_UNKNOWN;
+		TraceCapture::spikeThreshold = 0;
+
+		//whatever ran before this isn't part of the capture
+		ScopeProfiler::collect();
+		TraceCapture::update();
+		TraceCapture::capture(FRAMES);
+
+		std::atomic<bool> running(true);
+		std::atomic<size_t> jobs(0);
+		std::thread worker([&running, &jobs]() {
+			ScopeProfiler::setThreadName(WORKER_NAME);
+
+			while (running) {
+				ProfileJob("Trace check job");
+				spin();
+				jobs++;
+			}
+		});
+
+		for (size_t frame = 0; frame < FRAMES; ++frame) {
+			//the worker gets a job into every frame, even with nothing but this thread for it to run on
+			const size_t done = jobs;
+
+			while (jobs == done)
+				std::this_thread::yield();
+
+			{
+				ProfileScope("Trace check frame");
+
+				{
+					ProfileScope("Trace check \"quoted\" update");
+					std::vector<uint32_t> allocated(1024, (uint32_t)frame);
+					doNotOptimize(allocated[0]);
+					spin();
+				}
+
+				{
+					ProfileGpu("Trace check submit");
+					spin();
+				}
+			}
+
+			TraceCapture::setCounter("Trace check counter", (double)frame);
+			ScopeProfiler::collect();
+			TraceCapture::update();
+		}
+
+		running = false;
+		worker.join();
+
+		HBM_EXPECT(!TraceCapture::isCapturing());
+
+		while (TraceCapture::isWriting())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		const std::string path = TraceCapture::getLastPath();
+		HBM_REQUIRE(!path.empty());
+
+		JsonValue trace;
+		HBM_REQUIRE(readJson(path + ".json", trace));
+		HBM_REQUIRE(trace.is(JsonType::Object));
+
+		const JsonValue* unit = trace.find("displayTimeUnit", JsonType::String);
+		const JsonValue* events = trace.find("traceEvents", JsonType::Array);
+		HBM_EXPECT(unit != nullptr && unit->string == "ms");
+		HBM_REQUIRE(events != nullptr && !events->items.empty());
+
+		const TraceSummary summary = summarize(*events);
+
+		HBM_EXPECT(summary.invalid == 0);
+		HBM_EXPECT(summary.frames == FRAMES);
+		HBM_EXPECT(summary.misnested == 0);
+		HBM_EXPECT(summary.backwards == 0);
+		HBM_EXPECT(summary.quoted == FRAMES);
+		HBM_EXPECT(summary.workerThread >= 0 && summary.workerJobs > 0);
+		//a frame and the two scopes in it every frame at the least
+		HBM_EXPECT(summary.scopes >= FRAMES * 3);
+
+		std::vector<double> expected(FRAMES);
+		std::iota(expected.begin(), expected.end(), 0.0);
+
+		HBM_EXPECT(summary.counters.count("Trace check counter") > 0 && summary.counters.at("Trace check counter") == expected);
+		HBM_EXPECT(summary.counters.count("Quad draw calls") > 0 && summary.counters.at("Quad draw calls").size() == FRAMES);
+
+		//the allocation counters are only there when something counts them, and then every frame here allocates
+		if (AllocationTracker::isTracking()) {
+			HBM_EXPECT(summary.counters.count("Allocations") > 0 && summary.counters.at("Allocations").size() == FRAMES);
+
+			if (summary.counters.count("Allocations") > 0) {
+				const std::vector<double>& allocations = summary.counters.at("Allocations");
+				HBM_EXPECT(std::all_of(allocations.begin(), allocations.end(), [](const double& value) { return value > 0; }));
+			}
+		}
+		else
+			HBM_EXPECT(summary.counters.count("Allocations") == 0);
+
+		HBM_REQUIRE(TraceCapture::convert(path + ".htrace", path + " converted.json"));
+		HBM_EXPECT(readFile(path + " converted.json") == readFile(path + ".json"));
+
+		report(std::to_string(events->items.size()) + " events, " + std::to_string(summary.scopes) + " scopes, " + std::to_string(summary.unmatched) +
+			" ended without their begin in the capture, allocation counters " + (AllocationTracker::isTracking() ? "on" : "off"));
+	}
+}
+
+HBM_CHECK(traceCaptureJson);
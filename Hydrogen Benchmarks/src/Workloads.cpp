@@ -0,0 +1,445 @@
+#include "hfpch.h"
+#include "Workloads.h"
+#include <random>
+
+using namespace HFR;
+
+namespace HBM {
+
+	namespace {
+		//what a mover goes per update, the scripts don't look at the clock so every run moves the same
+		const float MOVER_STEP = 1.0f / 60.0f;
+		const size_t GUI_ROW_ELEMENTS = 10;
+		const Vec2f GUI_WINDOW_SIZE = Vec2f(1920, 1080);
+
+		//moves its entity in a straight line
+		class Mover : public GameObject {
+		private:
+			Vec3f velocity;
+
+		protected:
+			void start() override {
+				velocity = Vec3f((float)(entity.id % 7) - 3, (float)(entity.id % 5) - 2, (float)(entity.id % 3) - 1);
+			}
+
+			void update() override {
+				Transform& transform = getComponent<Transform>();
+				transform.position += velocity * MOVER_STEP;
+				transform.markDirty();
+			}
+		};
+
+		//largest scale on any axis, so the sphere still holds everything after a non uniform scale
+		float getMaxScale(const Mat4f& matrix) {
+			const float x = matrix.m00 * matrix.m00 + matrix.m01 * matrix.m01 + matrix.m02 * matrix.m02;
+			const float y = matrix.m10 * matrix.m10 + matrix.m11 * matrix.m11 + matrix.m12 * matrix.m12;
+			const float z = matrix.m20 * matrix.m20 + matrix.m21 * matrix.m21 + matrix.m22 * matrix.m22;
+
+			return sqrtf(max(x, max(y, z)));
+		}
+
+		void writeBigEndian(std::string& out, const uint32_t& value) {
+			out += (char)(value >> 24);
+			out += (char)(value >> 16);
+			out += (char)(value >> 8);
+			out += (char)value;
+		}
+
+		uint32_t crc32(const unsigned char* data, const size_t& size, uint32_t crc = 0) {
+			static uint32_t table[256];
+			static bool tableMade = false;
+
+			if (!tableMade) {
+				for (uint32_t i = 0; i < 256; ++i) {
+					uint32_t value = i;
+
+					for (int bit = 0; bit < 8; ++bit)
+						value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+
+					table[i] = value;
+				}
+
+				tableMade = true;
+			}
+
+			crc = ~crc;
+
+			for (size_t i = 0; i < size; ++i)
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+			return ~crc;
+		}
+
+		void writeChunk(std::string& out, const char* type, const std::string& data) {
+			writeBigEndian(out, (uint32_t)data.size());
+
+			const size_t start = out.size();
+			out.append(type, 4);
+			out += data;
+
+			writeBigEndian(out, crc32((const unsigned char*)out.data() + start, out.size() - start));
+		}
+
+		//a zlib stream of stored deflate blocks
+		std::string storeZlib(const std::string& data) {
+			//the biggest a stored block can be
+			const size_t blockSize = 65535;
+
+			std::string out;
+			out += (char)0x78;
+			out += (char)0x01;
+
+			size_t offset = 0;
+
+			do {
+				const size_t length = min(blockSize, data.size() - offset);
+				const bool last = offset + length == data.size();
+
+				out += (char)(last ? 1 : 0);
+				out += (char)(length & 0xFF);
+				out += (char)(length >> 8);
+				out += (char)(~length & 0xFF);
+				out += (char)((~length >> 8) & 0xFF);
+				out.append(data, offset, length);
+
+				offset += length;
+			} while (offset < data.size());
+
+			uint32_t a = 1;
+			uint32_t b = 0;
+
+			for (size_t i = 0; i < data.size(); ++i) {
+				a = (a + (unsigned char)data[i]) % 65521;
+				b = (b + a) % 65521;
+			}
+
+			writeBigEndian(out, (b << 16) | a);
+			return out;
+		}
+
+		size_t writeFile(const std::string& path, const std::string& data) {
+			std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+			if (!file.is_open()) {
+				Debug::systemErr("Couldn't write benchmark asset: " + path);
+				return 0;
+			}
+
+			file.write(data.data(), data.size());
+			return file.good() ? data.size() : 0;
+		}
+	}
+
+	Mesh createCubeMesh() {
+		std::vector<float> vertices = {
+			-0.5f, -0.5f, -0.5f,  0.5f, -0.5f, -0.5f,  0.5f, 0.5f, -0.5f,  -0.5f, 0.5f, -0.5f,
+			-0.5f, -0.5f, 0.5f,  0.5f, -0.5f, 0.5f,  0.5f, 0.5f, 0.5f,  -0.5f, 0.5f, 0.5f
+		};
+
+		std::vector<unsigned int> indices = {
+			0, 2, 1, 0, 3, 2,
+			4, 5, 6, 4, 6, 7,
+			0, 1, 5, 0, 5, 4,
+			3, 6, 2, 3, 7, 6,
+			0, 4, 7, 0, 7, 3,
+			1, 2, 6, 1, 6, 5
+		};
+
+		std::vector<float> normals;
+
+		for (size_t i = 0; i < vertices.size(); i += 3) {
+			const float length = sqrtf(vertices[i] * vertices[i] + vertices[i + 1] * vertices[i + 1] + vertices[i + 2] * vertices[i + 2]);
+
+			normals.push_back(vertices[i] / length);
+			normals.push_back(vertices[i + 1] / length);
+			normals.push_back(vertices[i + 2] / length);
+		}
+
+		Mesh out(std::move(vertices), std::move(indices), std::move(normals), std::vector<float>());
+		out.isUsingIndices = true;
+		//what create would have worked out
+		out.radius = sqrtf(0.75f);
+		out.material.created = true;
+		out.created = true;
+
+		return out;
+	}
+
+	Scene* createEntityScene(const size_t& entities, const Mesh& mesh, const float& extent, const unsigned int& seed) {
+		Scene* scene = new Scene();
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> position(-extent / 2, extent / 2);
+		std::uniform_real_distribution<float> angle(0, 360);
+
+		for (size_t i = 0; i < entities; ++i) {
+			GameObject object = scene->createGameObject("entity " + std::to_string(i));
+
+			Transform& transform = object.getComponent<Transform>();
+			//one at a time, arguments can be evaluated in any order and the same seed should make the same scene everywhere
+			transform.position.x = position(random);
+			transform.position.y = position(random);
+			transform.position.z = position(random);
+			transform.rotation.x = angle(random);
+			transform.rotation.y = angle(random);
+			transform.rotation.z = 0;
+			transform.markDirty();
+
+			MeshComponent component = MeshComponent();
+			component.meshes.push_back(mesh.clone());
+
+			//copies come out not created, there's no gpu to put them on anyway
+			component.meshes.back().radius = mesh.radius;
+			component.meshes.back().material.created = true;
+			component.meshes.back().created = true;
+
+			object.addComponent<MeshComponent>(std::move(component));
+		}
+
+		return scene;
+	}
+
+	void addMovers(Scene& scene) {
+		System& system = *scene.getSystem();
+
+		for (unsigned int i = 0; i < system.getEntityAmount(); ++i) {
+			Entity entity = (*system.getEntities())[i];
+
+			NativeScript script = NativeScript();
+			script.scriptAmount = 1;
+			//normally the script dlls make them, these are in the benchmark itself
+			script.instantiateScript = [](NativeScript* nativeScript, const unsigned int& index) {
+				nativeScript->scripts[index] = new Mover();
+			};
+
+			system.getComponentManager()->addComponent<NativeScript>(entity, std::move(script));
+		}
+	}
+
+	void destroyMovers(Scene& scene) {
+		System& system = *scene.getSystem();
+
+		for (unsigned int i = 0; i < system.getEntityAmount(); ++i) {
+			Entity entity = (*system.getEntities())[i];
+
+			if (!system.getComponentManager()->hasComponent<NativeScript>(entity))
+				continue;
+
+			NativeScript& script = system.getComponentManager()->getComponent<NativeScript>(entity);
+
+			for (unsigned int j = 0; j < script.scriptAmount; ++j) {
+				delete script.scripts[j];
+				script.scripts[j] = nullptr;
+			}
+		}
+	}
+
+	Frustum createFrustum(const float& fov, const float& aspectRatio, const float& nearPlane, const float& farPlane) {
+		const float tanY = (float)tan(HMath::toRadians(fov / 2));
+		const float tanX = tanY * aspectRatio;
+
+		const float lengthX = sqrtf(1 + tanX * tanX);
+		const float lengthY = sqrtf(1 + tanY * tanY);
+
+		//a point is outside a side when it's further than x = -z * tan (and so on), the normals point out of the frustum
+		Frustum out;
+		out.planes[0] = Vec3f(1 / lengthX, 0, tanX / lengthX);
+		out.planes[1] = Vec3f(-1 / lengthX, 0, tanX / lengthX);
+		out.planes[2] = Vec3f(0, 1 / lengthY, tanY / lengthY);
+		out.planes[3] = Vec3f(0, -1 / lengthY, tanY / lengthY);
+		out.nearPlane = nearPlane;
+		out.farPlane = farPlane;
+
+		return out;
+	}
+
+	void cullPackets(const RenderSnapshot& snapshot, const Frustum& frustum, std::vector<unsigned int>& visible) {
+		visible.clear();
+
+		const Mat4f& view = snapshot.view.viewMatrix;
+
+		for (size_t i = 0; i < snapshot.packets.size(); ++i) {
+			const DrawPacket& packet = snapshot.packets[i];
+			const float radius = packet.geometry.radius * getMaxScale(packet.transform);
+
+			const Vec4f center = Vec4f(packet.transform.m30, packet.transform.m31, packet.transform.m32, 1) * view;
+
+			//in front of the camera is -z
+			if (center.z - radius > -frustum.nearPlane || center.z + radius < -frustum.farPlane)
+				continue;
+
+			bool inside = true;
+
+			for (int plane = 0; plane < 4 && inside; ++plane) {
+				const Vec3f& normal = frustum.planes[plane];
+				inside = normal.x * center.x + normal.y * center.y + normal.z * center.z <= radius;
+			}
+
+			if (inside)
+				visible.push_back((unsigned int)i);
+		}
+	}
+
+	GuiWorkload::GuiWorkload(const size_t& elements) {
+		frames.push_back(std::unique_ptr<GuiFrame>(new GuiFrame()));
+
+		GuiFrame* root = frames.back().get();
+		root->name = "benchmark root";
+		root->size = GUI_WINDOW_SIZE;
+		root->layout = HFR_GUI_LAYOUT_COLUMN;
+		root->padding = 4;
+		root->spacing = 4;
+
+		GuiFrame* row = nullptr;
+
+		for (size_t i = 0; i < elements; ++i) {
+			if (i % GUI_ROW_ELEMENTS == 0) {
+				frames.push_back(std::unique_ptr<GuiFrame>(new GuiFrame()));
+
+				row = frames.back().get();
+				row->size = Vec2f(GUI_WINDOW_SIZE.x, 20);
+				row->layout = HFR_GUI_LAYOUT_ROW;
+				row->spacing = 2;
+				row->flexGrow = 1;
+				row->borderSize = 0;
+
+				root->addChild(row);
+			}
+
+			frames.push_back(std::unique_ptr<GuiFrame>(new GuiFrame()));
+
+			GuiFrame* element = frames.back().get();
+			element->size = Vec2f(20, 20);
+			element->flexGrow = 1;
+			element->rotation = (float)(i % 4) * 5;
+			element->roundedCornerRadius = 4;
+
+			row->addChild(element);
+		}
+	}
+
+	GuiWorkload::~GuiWorkload() {
+		while (!frames.empty())
+			frames.pop_back();
+	}
+
+	GuiFrame* GuiWorkload::getRoot() {
+		return frames.front().get();
+	}
+
+	std::vector<std::string> createStrings(const size_t& amount, const size_t& length, const unsigned int& seed) {
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<int> letter('a', 'z');
+		std::uniform_int_distribution<int> wordLength(2, 9);
+
+		std::vector<std::string> out(amount);
+
+		for (size_t i = 0; i < amount; ++i) {
+			std::string& text = out[i];
+
+			while (text.size() < length) {
+				if (!text.empty())
+					text += ' ';
+
+				const int letters = wordLength(random);
+
+				for (int j = 0; j < letters; ++j)
+					text += (char)letter(random);
+			}
+		}
+
+		return out;
+	}
+
+	std::string getAssetDirectory() {
+		const std::string out = Util::getWorkingDirectory() + "/benchmark assets/";
+		Util::createDirectory(out);
+		return out;
+	}
+
+	size_t writeObj(const std::string& path, const size_t& size) {
+		std::string out = "# generated benchmark grid\no grid\n";
+		char line[128];
+
+		//(size + 1)^2 corners, row by row
+		for (size_t y = 0; y <= size; ++y) {
+			for (size_t x = 0; x <= size; ++x) {
+				const float u = (float)x / (float)size;
+				const float v = (float)y / (float)size;
+
+				std::snprintf(line, sizeof(line), "v %f %f %f\n", u * 10 - 5, sinf(u * 12) * cosf(v * 9) * 0.5f, v * 10 - 5);
+				out += line;
+				std::snprintf(line, sizeof(line), "vt %f %f\n", u, v);
+				out += line;
+			}
+		}
+
+		out += "vn 0.000000 1.000000 0.000000\n";
+
+		for (size_t y = 0; y < size; ++y) {
+			for (size_t x = 0; x < size; ++x) {
+				//obj indexes start at 1
+				const size_t a = y * (size + 1) + x + 1;
+				const size_t b = a + 1;
+				const size_t c = a + size + 1;
+				const size_t d = c + 1;
+
+				std::snprintf(line, sizeof(line), "f %zu/%zu/1 %zu/%zu/1 %zu/%zu/1\n", a, a, c, c, b, b);
+				out += line;
+				std::snprintf(line, sizeof(line), "f %zu/%zu/1 %zu/%zu/1 %zu/%zu/1\n", b, b, c, c, d, d);
+				out += line;
+			}
+		}
+
+		return writeFile(path, out);
+	}
+
+	size_t writePng(const std::string& path, const size_t& size, const unsigned int& seed) {
+		std::mt19937 random(seed);
+		const size_t rowBytes = size * 4;
+
+		//noise on top of a gradient, so it isn't all the same bytes
+		std::vector<unsigned char> pixels(rowBytes * size);
+
+		for (size_t y = 0; y < size; ++y) {
+			for (size_t x = 0; x < size; ++x) {
+				unsigned char* pixel = &pixels[y * rowBytes + x * 4];
+				const unsigned int noise = random();
+
+				pixel[0] = (unsigned char)(x * 255 / size + (noise & 15));
+				pixel[1] = (unsigned char)(y * 255 / size + ((noise >> 4) & 15));
+				pixel[2] = (unsigned char)(noise >> 8);
+				pixel[3] = 255;
+			}
+		}
+
+		//every row starts with its filter type, sub stores each byte minus the one a pixel before it
+		std::string filtered;
+		filtered.reserve((rowBytes + 1) * size);
+
+		for (size_t y = 0; y < size; ++y) {
+			const unsigned char* row = &pixels[y * rowBytes];
+			filtered += (char)1;
+
+			for (size_t i = 0; i < rowBytes; ++i)
+				filtered += (char)(row[i] - (i >= 4 ? row[i - 4] : 0));
+		}
+
+		std::string header;
+		writeBigEndian(header, (uint32_t)size);
+		writeBigEndian(header, (uint32_t)size);
+		//8 bits, rgba, deflate, adaptive filtering, not interlaced
+		header += (char)8;
+		header += (char)6;
+		header += (char)0;
+		header += (char)0;
+		header += (char)0;
+
+		std::string out = "\x89PNG\r\n\x1a\n";
+		writeChunk(out, "IHDR", header);
+		writeChunk(out, "IDAT", storeZlib(filtered));
+		writeChunk(out, "IEND", "");
+
+		return writeFile(path, out);
+	}
+
+}
@@ -0,0 +1,64 @@
+#ifndef HBM_WORKLOADS_HEADER_INCLUDE
+#define HBM_WORKLOADS_HEADER_INCLUDE
+
+#include <string>
+#include <vector>
+#include <memory>
+
+//synthetic scenes, gui trees, strings and asset files for the benchmarks, nothing in here needs a window or a gl context
+namespace HBM {
+
+	//a unit cube with indices, marked created without a vao so extraction treats it like it's on the gpu and nothing ever hands it to gl
+	HFR::Mesh createCubeMesh();
+
+	//entities spread over a cube extent wide around the origin, every one gets a Transform, a Tag and a MeshComponent with a copy of mesh
+	HFR::Scene* createEntityScene(const size_t& entities, const HFR::Mesh& mesh, const float& extent, const unsigned int& seed);
+
+	//every entity gets a NativeScript with one script that moves it a bit each update, the scene makes them on its first update
+	void addMovers(HFR::Scene& scene);
+	//the scene leaves its scripts alone when it goes, so this has to happen before deleting it
+	void destroyMovers(HFR::Scene& scene);
+
+	//the side planes in view space (camera looking down -z), normalized so a dot product is the distance
+	struct Frustum {
+		HFR::Vec3f planes[4];
+		float nearPlane = 0;
+		float farPlane = 0;
+	};
+
+	//fov in degrees, vertically
+	Frustum createFrustum(const float& fov, const float& aspectRatio, const float& nearPlane, const float& farPlane);
+
+	//the renderer only culls faces on the gpu, this is the bounding sphere test a cpu pass over the render queue would do,
+	//visible gets the indexes of the packets that are in the frustum
+	void cullPackets(const HFR::RenderSnapshot& snapshot, const Frustum& frustum, std::vector<unsigned int>& visible);
+
+	//rows of frames that grow to fill a column the size of the window, elements is how many frames are in the rows
+	struct GuiWorkload {
+		//parents before their children
+		std::vector<std::unique_ptr<HFR::GuiFrame>> frames;
+
+		GuiWorkload(const size_t& elements);
+		GuiWorkload(const GuiWorkload&) = delete;
+		GuiWorkload& operator=(const GuiWorkload&) = delete;
+		//children go first so none of them is left pointing at a parent that's gone
+		~GuiWorkload();
+
+		HFR::GuiFrame* getRoot();
+	};
+
+	//words of lowercase letters, length characters per string give or take a word
+	std::vector<std::string> createStrings(const size_t& amount, const size_t& length, const unsigned int& seed);
+
+	//where the generated asset files go, next to the executable
+	std::string getAssetDirectory();
+
+	//a size x size grid of quads with texture coordinates and normals, returns how big the file is (0 when it couldn't be written)
+	size_t writeObj(const std::string& path, const size_t& size);
+	//size x size rgba noise, the deflate blocks are stored so it's the png side of the loader being measured and not zlib,
+	//rows use the sub filter so unfiltering still costs what it does in a normal png
+	size_t writePng(const std::string& path, const size_t& size, const unsigned int& seed);
+
+}
+
+#endif
@@ -0,0 +1,15 @@
+#version 400 core
+out vec4 fragColor;
+
+in vec2 passTextureCoords;
+
+//only the first one gets used
+uniform sampler2D textures[8];
+
+void main() {
+	
+	//the canvas was blended into a transparent framebuffer so its color already got multiplied by alpha, blending it again would do that twice
+	vec4 color = texture(textures[0], passTextureCoords);
+
+	fragColor = vec4(color.rgb / max(color.a, 0.0001), color.a);
+}
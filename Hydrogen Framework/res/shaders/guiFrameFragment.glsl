@@ -1,23 +1,17 @@
 #version 400 core
 out vec4 fragColor;
 
-in vec2 passTextureCoords;
+in vec2 passQuadCoords;
 
-uniform vec4 color;
-uniform float alpha;
-uniform float aspectRatio;
-uniform vec2 uiSize;
-
-uniform vec4 borderColor;
-uniform float borderSize;
-
-uniform float cornerRadius;
-uniform float smoothness;
+flat in vec2 passUiSize;
+flat in vec4 passColor;
+flat in vec4 passBorderColor;
+flat in vec4 passShape;
 
 bool isOnEdge(vec2 position, float size){
 	
-	float maxX = uiSize.x - size;
-	float maxY = uiSize.y - size;
+	float maxX = passUiSize.x - size;
+	float maxY = passUiSize.y - size;
 
 	if (position.x < size || position.x > maxX)
 		return true;
@@ -27,10 +21,10 @@ bool isOnEdge(vec2 position, float size){
 	return false;
 }
 
-float getRoundedRectangle(vec2 position) {
+float getRoundedRectangle(vec2 position, float cornerRadius, float smoothness) {
 
-	float maxX = uiSize.x - cornerRadius;
-	float maxY = uiSize.y - cornerRadius;
+	float maxX = passUiSize.x - cornerRadius;
+	float maxY = passUiSize.y - cornerRadius;
 	float alpha = 1;
 
 	if (position.x < cornerRadius && position.y < cornerRadius)
@@ -46,16 +40,19 @@ float getRoundedRectangle(vec2 position) {
 }
 
 void main() {
-	vec2 pixelPosition = passTextureCoords * uiSize;	
-	vec4 tempColor = color;
+	vec2 pixelPosition = passQuadCoords * passUiSize;	
+	vec4 tempColor = passColor;
+
+	float borderSize = passShape.x;
+	float cornerRadius = passShape.y;
 
 	if(isOnEdge(pixelPosition, borderSize))
-		tempColor = borderColor;
+		tempColor = passBorderColor;
 	else
-		tempColor = color;
+		tempColor = passColor;
 
 	if(cornerRadius > 0)
-		tempColor.a *= getRoundedRectangle(pixelPosition); 
+		tempColor.a *= getRoundedRectangle(pixelPosition, cornerRadius, passShape.z); 
 
 	fragColor = tempColor;
 }
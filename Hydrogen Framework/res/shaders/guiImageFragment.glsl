@@ -4,20 +4,19 @@ out vec4 fragColor;
 const float PI = 3.1415926;
 const float TWO_PI = 6.2831852;
 
-in vec2 passTextureCoords;
-
-uniform sampler2D textureSampler;
-uniform bool hasTextureCoords;
+const uint HAS_TEXTURE = 256u;
+const uint RADIAL_FILL_INVERSE = 512u;
 
+in vec2 passTextureCoords;
+in vec2 passQuadCoords;
 
-uniform vec4 color;
-uniform vec2 uiSize;
+flat in vec4 passColor;
+flat in vec4 passShape;
+flat in vec3 passRadial;
+flat in uint passFlags;
 
-//for radial fill
-uniform float angle; //IN RADIANS
-uniform float offsetAngle; //IN RADIANS
-uniform vec2 radialFillOffset;
-uniform bool radialFillFlipped;
+//as many as HFR_QUAD_BATCH_TEXTURE_SLOTS
+uniform sampler2D textures[8];
 
 float getAngle(vec2 v1, vec2 v2) {
 
@@ -31,16 +30,34 @@ float getTargetAngle(float number) {
 
 }
 
+//sampler arrays can only be indexed with constants in glsl 4.00
+vec4 sampleTexture(uint slot, vec2 coords) {
+
+	switch (slot) {
+		case 0u: return texture(textures[0], coords);
+		case 1u: return texture(textures[1], coords);
+		case 2u: return texture(textures[2], coords);
+		case 3u: return texture(textures[3], coords);
+		case 4u: return texture(textures[4], coords);
+		case 5u: return texture(textures[5], coords);
+		case 6u: return texture(textures[6], coords);
+		default: return texture(textures[7], coords);
+	}
+
+}
+
 void main() {
-	vec2 pixelPosition = passTextureCoords * uiSize;	
-	
-	if(hasTextureCoords)
-		fragColor = texture(textureSampler, passTextureCoords);
+	fragColor = vec4(0);
+
+	if((passFlags & HAS_TEXTURE) != 0u)
+		fragColor = sampleTexture(passFlags & 255u, passTextureCoords);
+
+	fragColor += passColor;
 
-	fragColor += color;
+	float angle = passShape.w;
 
-	float pixelAngle = getAngle(passTextureCoords, radialFillOffset);
-	if(radialFillFlipped){
+	float pixelAngle = getAngle(passQuadCoords, passRadial.yz);
+	if((passFlags & RADIAL_FILL_INVERSE) != 0u){
 		if (pixelAngle > getTargetAngle(angle))
 			fragColor.a = 1;
 		else
@@ -2,15 +2,12 @@
 out vec4 fragColor;
 
 in vec2 passedTextureCoords;
+in vec4 passedColor;
 
 
 uniform sampler2D textureSampler;
-uniform vec4 color;
 
 void main() {
 	
-	//vec4 alpha = texture(textureSampler, passedTextureCoords);
-	fragColor = vec4(0.1, 0.2, 1, texture(textureSampler, passedTextureCoords).r);
-	//fragColor *= color;
-	//fragColor = vec4(1,1,1,1);
+	fragColor = vec4(passedColor.rgb, passedColor.a * texture(textureSampler, passedTextureCoords).r);
 }
\ No newline at end of file
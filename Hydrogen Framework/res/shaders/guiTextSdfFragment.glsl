@@ -0,0 +1,17 @@
+#version 400 core
+out vec4 fragColor;
+
+in vec2 passedTextureCoords;
+in vec4 passedColor;
+
+
+uniform sampler2D textureSampler;
+
+void main() {
+	
+	//the atlas holds distances with the edge at 0.5, how soft the edge gets follows how fast the distance changes across a pixel so any text size stays sharp
+	float distance = texture(textureSampler, passedTextureCoords).r;
+	float width = max(fwidth(distance) * 0.5, 0.0001);
+
+	fragColor = vec4(passedColor.rgb, passedColor.a * smoothstep(0.5 - width, 0.5 + width, distance));
+}
\ No newline at end of file
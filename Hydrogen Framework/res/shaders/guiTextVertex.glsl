@@ -1,12 +1,18 @@
 #version 400 core
-layout (location = 0) in vec3 position;
+layout (location = 0) in vec2 position;
 layout (location = 1) in vec2 textureCoords;
+layout (location = 2) in vec4 color;
 
 out vec2 passedTextureCoords;
+out vec4 passedColor;
+
+uniform sampler2D textureSampler;
 
 void main() {
 
-	gl_Position = vec4(position, 1);
-	passedTextureCoords = textureCoords;
+	gl_Position = vec4(position, 0, 1);
+	//the text batcher hands over atlas texels so growing the atlas doesn't change any vertices
+	passedTextureCoords = textureCoords / vec2(textureSize(textureSampler, 0));
+	passedColor = color;
 
 }
@@ -2,13 +2,40 @@
 
 layout (location = 0) in vec2 position;
 
+//per quad, filled in by the quad batcher
+layout (location = 1) in vec4 originAxisX;
+layout (location = 2) in vec4 axisYPixelSize;
+layout (location = 3) in vec4 textureRect;
+layout (location = 4) in vec4 color;
+layout (location = 5) in vec4 borderColor;
+//border size, corner radius, corner smoothing, radial fill
+layout (location = 6) in vec4 shape;
+//radial fill angle offset, radial fill offset
+layout (location = 7) in vec3 radial;
+layout (location = 8) in uint flags;
+
 out vec2 passTextureCoords;
+out vec2 passQuadCoords;
 
-uniform mat4 transform;
+flat out vec2 passUiSize;
+flat out vec4 passColor;
+flat out vec4 passBorderColor;
+flat out vec4 passShape;
+flat out vec3 passRadial;
+flat out uint passFlags;
 
 void main(){
 	
-	gl_Position = transform * vec4(position, 0, 1);
+	gl_Position = vec4(originAxisX.xy + originAxisX.zw * position.x + axisYPixelSize.xy * position.y, 0, 1);
+
+	//0 - 1 across the quad from the top left
+	passQuadCoords = vec2((position.x+1.0)/2.0, 1 - (position.y+1.0)/2.0);
+	passTextureCoords = textureRect.xy + passQuadCoords * textureRect.zw;
 
-	passTextureCoords = vec2((position.x+1.0)/2.0, 1 - (position.y+1.0)/2.0);
+	passUiSize = axisYPixelSize.zw;
+	passColor = color;
+	passBorderColor = borderColor;
+	passShape = shape;
+	passRadial = radial;
+	passFlags = flags;
 }
\ No newline at end of file
@@ -6,6 +6,11 @@
 #include "hfrdef.h"
 #include "IncludeStandard.h"
 
+#include "HFR/assets/AssetHandle.h"
+#include "HFR/assets/AssetLoader.h"
+#include "HFR/assets/TextureCache.h"
+#include "HFR/assets/TextureStreamer.h"
+
 #include "HFR/camera/Camera.h"
 #include "HFR/camera/CameraController.h"
 #include "HFR/camera/EditorCamera.h"
@@ -14,6 +19,9 @@
 #include "HFR/ECS/GameObject.h"
 #include "HFR/ECS/Scene.h"
 #include "HFR/ECS/components/Tag.h"
+#include "HFR/ECS/components/Hierarchy.h"
+#include "HFR/ECS/systems/TransformSystem.h"
+#include "HFR/ECS/systems/HierarchySystem.h"
 
 #include "HFR/mesh/Mesh.h"
 #include "HFR/mesh/Texture.h"
@@ -26,6 +34,7 @@
 #include "HFR/scripting/VisualStudio.h"
 
 #include "HFR/gui/GuiElement.h"
+#include "HFR/gui/GuiCanvas.h"
 #include "HFR/gui/GuiFrame.h"
 #include "HFR/gui/GuiText.h"
 
@@ -33,12 +42,25 @@
 #include "HFR/core/Program.h"
 #include "HFR/core/Engine.h"
 #include "HFR/core/Start.h"
+#include "HFR/core/JobSystem.h"
+#include "HFR/core/AllocationTracker.h"
+#include "HFR/core/Replay.h"
 
 #include "HFR/graphics/image/Image.h"
 #include "HFR/graphics/image/Pixel.h"
+#include "HFR/graphics/image/ImageProcessing.h"
+#include "HFR/graphics/image/CookedTexture.h"
+#include "HFR/graphics/image/TextureCompressor.h"
+#include "HFR/graphics/image/SkylinePacker.h"
+#include "HFR/graphics/image/TextureAtlas.h"
 
 #include "HFR/graphics/rendering/Renderer.h"
 #include "HFR/graphics/rendering/Renderer2D.h"
+#include "HFR/graphics/rendering/TextBatcher.h"
+#include "HFR/graphics/rendering/QuadBatcher.h"
+#include "HFR/graphics/rendering/Framebuffer.h"
+#include "HFR/graphics/rendering/RenderSnapshot.h"
+#include "HFR/graphics/rendering/RenderPipeline.h"
 #include "HFR/graphics/rendering/Shader.h"
 
 #include "HFR/graphics/lighting/Light.h"
@@ -46,9 +68,13 @@
 #include "HFR/io/Cursor.h"
 #include "HFR/io/Input.h"
 #include "HFR/io/Window.h"
+#include "HFR/io/VirtualFileSystem.h"
+#include "HFR/io/PackArchive.h"
 
 #include "HFR/math/matrixes/Mat4.h"
+#include "HFR/math/matrixes/MatrixKernels.h"
 #include "HFR/math/vectors/Transform.h"
+#include "HFR/math/vectors/Quaternion.h"
 #include "HFR/math/vectors/Vec2.h"
 #include "HFR/math/vectors/Vec3.h"
 #include "HFR/math/vectors/Vec4.h"
@@ -59,13 +85,19 @@
 
 #include "HFR/text/FreeType.h"
 #include "HFR/text/Character.h"
+#include "HFR/text/GlyphCache.h"
 #include "HFR/text/Font.h"
 
 #include "HFR/time/Profiler.h"
+#include "HFR/time/ScopeProfiler.h"
+#include "HFR/time/TraceCapture.h"
+#include "HFR/time/FrameTelemetry.h"
+#include "HFR/time/GpuProfiler.h"
 #include "HFR/time/Profile.h"
 #include "HFR/time/Time.h"
 
 #include "HFR/util/Debug.h"
+#include "HFR/util/Logger.h"
 #include "HFR/util/Util.h"
 #include "HFR/util/HGUID.h"
 
@@ -23,6 +23,7 @@ namespace HFR {
 			entities[entityAmount] = out;
 			entityQueue.pop();
 			entityAmount += 1;
+			entitySlot[id] = entityAmount;
 
 			return out;
 		}
@@ -32,12 +33,30 @@ namespace HFR {
 	}
 
 	void EntityManager::destoryEntity(const Entity& entity) {
-		if (entity.id < HFR_MAX_COMPONENTS) {
-			entityQueue.push(entity.id);
-			entityAmount -= 1;
-		}
-		else
+		if (entity.id >= HFR_MAX_ENTITIES) {
 			Debug::systemErr("Could not destroy entity because the id was out of range");
+			return;
+		}
+
+		if (!hasEntity(entity)) {
+			Debug::systemErr("Could not destroy entity {} because it isn't alive", entity.id);
+			return;
+		}
+
+		//the last entity takes its place so the list stays packed
+		unsigned int slot = entitySlot[entity.id] - 1;
+		Entity last = entities[entityAmount - 1];
+
+		entities[slot] = last;
+		entitySlot[last.id] = slot + 1;
+		entitySlot[entity.id] = 0;
+
+		entityQueue.push(entity.id);
+		entityAmount -= 1;
+	}
+
+	bool EntityManager::hasEntity(const Entity& entity) const {
+		return entity.id < HFR_MAX_ENTITIES && entitySlot[entity.id] > 0;
 	}
 
 	System::System() {
@@ -53,10 +72,19 @@ namespace HFR {
 	}
 
 	void System::destroyEntity(Entity& entity) {
+		if (!entityManager.hasEntity(entity)) {
+			Debug::systemErr("Could not destroy entity {} because it isn't alive", entity.id);
+			return;
+		}
+
 		entityManager.destoryEntity(entity);
 		componentManager.destroyEntity(entity);
 	}
 
+	bool System::hasEntity(const Entity& entity) {
+		return entityManager.hasEntity(entity);
+	}
+
 	ComponentManager* System::getComponentManager() {
 		return &componentManager;
 	}
@@ -8,6 +8,7 @@
 #define HFR_MAX_COMPONENTS 50
 
 #include HFR_DEBUG
+#include HFR_LOGGER
 
 namespace HFR {
 
@@ -30,7 +31,10 @@ namespace HFR {
 	class DLL_API ComponentArray : public ComponentArrayBase {
 	private:
 		std::array<unsigned int, HFR_MAX_ENTITIES> componentIndex{0};
-		std::array<T, HFR_MAX_ENTITIES> components;
+		//one more than there can be entities, slot 0 is the empty component
+		std::array<T, HFR_MAX_ENTITIES + 1> components;
+		//the entity in each slot, so removing can move the last component into the hole and fix up its index
+		std::array<unsigned int, HFR_MAX_ENTITIES + 1> slotEntity{0};
 
 		unsigned int currentSize = 1;
 
@@ -39,21 +43,28 @@ namespace HFR {
 		using type = T;
 
 		T& addComponent(const Entity& entity, T& component) {
+			T copy = component;
+			return addComponent(entity, std::move(copy));
+		}
+
+		//moves the component in, so meshes and textures don't get their buffers copied
+		T& addComponent(const Entity& entity, T&& component) {
 			if (entity.id < HFR_MAX_ENTITIES) {
 				if (componentIndex[entity.id] == 0) {
 					componentIndex[entity.id] = currentSize;
-					components[currentSize] = component;
+					components[currentSize] = std::move(component);
+					slotEntity[currentSize] = entity.id;
 					currentSize += 1;
 
 					return components[componentIndex[entity.id]];
 				}
 				else {
-					Debug::systemErr("Couldn't add component of type: " + std::string(typeid(T).name()) + ", because the entity has that component");
+					HFR_LOG_ERROR("ECS", "Couldn't add component of type: {}, because the entity has that component", typeid(T).name());
 					return components[componentIndex[entity.id]];
 				}
 			}
 			else {
-				Debug::systemErr("Couldn't add component of type: " + std::string(typeid(T).name()) + ", because the entity id was out of range");
+				HFR_LOG_ERROR("ECS", "Couldn't add component of type: {}, because the entity id was out of range", typeid(T).name());
 				return *static_cast<T*>(nullptr);
 			}
 		}
@@ -61,9 +72,7 @@ namespace HFR {
 		T& getComponent(const Entity& entity) {
 
 			if (entity.id >= HFR_MAX_ENTITIES) {
-				std::string name = typeid(T).name();
-
-				Debug::systemErr("Couldn't get component of type: " + name + ", because the entity id was out of range");
+				HFR_LOG_ERROR("ECS", "Couldn't get component of type: {}, because the entity id {} was out of range", typeid(T).name(), entity.id);
 
 				return *static_cast<T*>(nullptr);
 			}
@@ -80,25 +89,55 @@ namespace HFR {
 		}
 
 		void removeComponent(const Entity& entity) {
-			if (entity.id < HFR_MAX_ENTITIES) {
-				components[componentIndex[entity.id]] = components[componentIndex[currentSize]];
-				components[componentIndex[currentSize]] = T();
-				currentSize -= 1;
+			if (entity.id >= HFR_MAX_ENTITIES) {
+				HFR_LOG_ERROR("ECS", "Couldn't remove component of type: {}, because the entity id {} was out of range", typeid(T).name(), entity.id);
+				return;
 			}
-			else
-				Debug::systemErr("Couldn't remove component of type: " + std::string(typeid(T).name()) + ", because the entity id was out of range");
-		}
 
-		void destroyEntity(Entity& entity) override {
-
-			std::array<unsigned int, HFR_MAX_ENTITIES>::iterator iterator = std::find(componentIndex.begin(), componentIndex.end(), entity.id);
+			const unsigned int slot = componentIndex[entity.id];
 
-			if (iterator != componentIndex.end()) {
-				removeComponent(entity);
+			if (slot == 0) {
+				HFR_LOG_ERROR("ECS", "Couldn't remove component of type: {}, because entity {} doesn't have one", typeid(T).name(), entity.id);
 				return;
 			}
 
-			Debug::systemErr("Could not destroy entity because it was not created");
+			//the last component fills the hole so the array stays packed
+			const unsigned int last = currentSize - 1;
+
+			if (slot != last) {
+				components[slot] = std::move(components[last]);
+				slotEntity[slot] = slotEntity[last];
+				componentIndex[slotEntity[slot]] = slot;
+			}
+
+			components[last] = T();
+			slotEntity[last] = 0;
+			componentIndex[entity.id] = 0;
+			currentSize -= 1;
+		}
+
+		//packed components for systems that go over all of them at once (slot 0 is the empty component so it gets skipped)
+		T* getComponents() {
+			return &components[1];
+		}
+
+		unsigned int getSize() {
+			return currentSize - 1;
+		}
+
+		//unpacked access, the component of an entity is getComponentData()[getComponentIndexes()[entity.id]]
+		T* getComponentData() {
+			return components.data();
+		}
+
+		const unsigned int* getComponentIndexes() {
+			return componentIndex.data();
+		}
+
+		//every array gets this when an entity goes, most of them won't have a component for it
+		void destroyEntity(Entity& entity) override {
+			if (hasComponent(entity))
+				removeComponent(entity);
 		}
 
 	};
@@ -146,15 +185,15 @@ namespace HFR {
 			if (componentTypes.find(type) == componentTypes.end()) {
 				//just some code checks for me and my smol brain
 				if (code == HFR_ECS_ADD_COMPONENT)
-					Debug::systemErr("Uhhh no component was registed but is trying to be added of type: " + std::string(type));
+					Debug::systemErr("Uhhh no component was registed but is trying to be added of type: {}", type);
 
 				else if (code == HFR_ECS_GET_COMPONENT)
-					Debug::systemErr("Uhhh no component was registed but is trying to be retrieved of type: " + std::string(type));
+					Debug::systemErr("Uhhh no component was registed but is trying to be retrieved of type: {}", type);
 
 				else if (code == HFR_ECS_REMOVE_COMPONENT)
-					Debug::systemErr("Uhhh no component was registed but is trying to be removed of type: " + std::string(type));
+					Debug::systemErr("Uhhh no component was registed but is trying to be removed of type: {}", type);
 
-				Debug::systemLog("Creating component of type: " + std::string(type) + " so there wont be errors calling this one again");
+				Debug::systemLog("Creating component of type: {} so there wont be errors calling this one again", type);
 				registerComponent<T>();
 
 			}
@@ -168,6 +207,12 @@ namespace HFR {
 			return getArray<T>(HFR_ECS_ADD_COMPONENT)->addComponent(entity, component);
 		}
 
+		template <typename T>
+		T& addComponent(Entity& entity, T&& component) {
+			registerComponent<T>();
+			return getArray<T>(HFR_ECS_ADD_COMPONENT)->addComponent(entity, std::move(component));
+		}
+
 		template <typename T>
 		T& getComponent(Entity& entity) {
 			return getArray<T>(HFR_ECS_GET_COMPONENT)->getComponent(entity);
@@ -201,6 +246,8 @@ namespace HFR {
 	private:
 		std::queue<unsigned int> entityQueue{};
 		std::array<Entity, HFR_MAX_ENTITIES> entities;
+		//where an entity is in entities plus one, 0 if it isn't alive
+		std::array<unsigned int, HFR_MAX_ENTITIES> entitySlot{0};
 		unsigned int entityAmount = 0;
 	public:
 
@@ -210,6 +257,7 @@ namespace HFR {
 		Entity createEntity();
 
 		void destoryEntity(const Entity& entity);
+		bool hasEntity(const Entity& entity) const;
 
 		friend class System;
 	};
@@ -229,7 +277,9 @@ namespace HFR {
 		~System();
 
 		Entity createEntity();
+		//only the entity and its components, objects in a scene go through Scene::destroyGameObject so the hierarchy and scripts let go of them too
 		void destroyEntity(Entity& entity);
+		bool hasEntity(const Entity& entity);
 
 		ComponentManager* getComponentManager();
 		EntityManager* getEntityManager();
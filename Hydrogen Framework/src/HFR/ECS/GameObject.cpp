@@ -16,12 +16,14 @@ namespace HFR {
 	//templates for transform component
 	template Transform& GameObject::addComponent<Transform>();
 	template Transform& GameObject::addComponent<Transform>(Transform&);
+	template Transform& GameObject::addComponent<Transform>(Transform&&);
 	template Transform& GameObject::getComponent<Transform>();
 	template void GameObject::removeComponent<Transform>();
 
 	//templates for tag component
 	template Tag& GameObject::addComponent<Tag>();
 	template Tag& GameObject::addComponent<Tag>(Tag&);
+	template Tag& GameObject::addComponent<Tag>(Tag&&);
 	template Tag& GameObject::getComponent<Tag>();
 	template void GameObject::removeComponent<Tag>();
 
@@ -34,18 +36,21 @@ namespace HFR {
 	//templates for MeshComponent component
 	template MeshComponent& GameObject::addComponent<MeshComponent>();
 	template MeshComponent& GameObject::addComponent<MeshComponent>(MeshComponent&);
+	template MeshComponent& GameObject::addComponent<MeshComponent>(MeshComponent&&);
 	template MeshComponent& GameObject::getComponent<MeshComponent>();
 	template void GameObject::removeComponent<MeshComponent>();
 
 	//templates for Texture component
 	template Texture& GameObject::addComponent<Texture>();
 	template Texture& GameObject::addComponent<Texture>(Texture&);
+	template Texture& GameObject::addComponent<Texture>(Texture&&);
 	template Texture& GameObject::getComponent<Texture>();
 	template void GameObject::removeComponent<Texture>();
 
 	//templates for NativeScript component
 	template NativeScript& GameObject::addComponent<NativeScript>();
 	template NativeScript& GameObject::addComponent<NativeScript>(NativeScript&);
+	template NativeScript& GameObject::addComponent<NativeScript>(NativeScript&&);
 	template NativeScript& GameObject::getComponent<NativeScript>();
 	template void GameObject::removeComponent<NativeScript>();
 
@@ -53,4 +58,39 @@ namespace HFR {
 		return created;
 	}
 
+	bool GameObject::setParent(const GameObject& parent) {
+		ComponentManager& components = *scene->getSystem()->getComponentManager();
+		Entity parentEntity = parent.entity;
+
+		//the hierarchy only places transforms
+		if (!components.hasComponent<Transform>(entity) || !components.hasComponent<Transform>(parentEntity)) {
+			Debug::systemErr("Couldn't parent {} to {}, because one of them has no transform", entity.id, parent.entity.id);
+			return false;
+		}
+
+		return scene->getHierarchy()->setParent(entity.id, parent.entity.id);
+	}
+
+	void GameObject::destroy() {
+		scene->destroyGameObject(*this);
+	}
+
+	void GameObject::removeParent() {
+		scene->getHierarchy()->removeParent(entity.id);
+	}
+
+	bool GameObject::hasParent() {
+		return scene->getHierarchy()->getParent(entity.id) != HFR_NULL_ENTITY;
+	}
+
+	GameObject GameObject::getParent() {
+		Entity parent = Entity();
+		parent.id = scene->getHierarchy()->getParent(entity.id);
+
+		if (parent.id == HFR_NULL_ENTITY)
+			return GameObject();
+
+		return GameObject(parent, scene);
+	}
+
 }
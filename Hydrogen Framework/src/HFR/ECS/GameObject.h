@@ -32,14 +32,19 @@ namespace HFR {
 
 		template <typename T>
 		T& addComponent() {
-			T component = T();
-			return scene->getSystem()->getComponentManager()->addComponent<T>(entity, component);
+			return scene->getSystem()->getComponentManager()->addComponent<T>(entity, T());
 		};
 
 		template <typename T>
 		T& addComponent(T& component) {
 			return scene->getSystem()->getComponentManager()->addComponent<T>(entity, component);
 		};
+
+		//use this with std::move for anything holding big buffers (meshes, textures)
+		template <typename T>
+		T& addComponent(T&& component) {
+			return scene->getSystem()->getComponentManager()->addComponent<T>(entity, std::move(component));
+		};
 			
 		template <typename T>
 		T& getComponent() {
@@ -52,6 +57,15 @@ namespace HFR {
 		}
 
 		bool isCreated();
+
+		//see Scene::destroyGameObject
+		void destroy();
+
+		//returns false if the parent is this or one of its children, or if either of them has no Transform
+		bool setParent(const GameObject& parent);
+		void removeParent();
+		bool hasParent();
+		GameObject getParent();
 	};
 
 }
@@ -14,9 +14,16 @@ namespace HFR {
 		lerpedCpuUsage = 0;
 		lerpedRamUsage = 0;
 		radialBarTexture = Texture();
+
+		//the first scene is the one the engine runs the scripts of
+		if (Engine::scene == nullptr)
+			Engine::scene = this;
 	}
 
 	Scene::~Scene() {
+		if (Engine::scene == this)
+			Engine::scene = nullptr;
+
 		for (unsigned int i = 0; i < system.getEntityAmount(); i++) {
 			Entity entity = (*system.getEntities())[i];
 
@@ -60,16 +67,50 @@ namespace HFR {
 		return out;
 	}
 
-	void Scene::updateEditor() {
-		ProfileMethod("Scene Editor update");
-		editorCamera.update();
+	void Scene::destroyGameObject(const GameObject& object) {
+		if (runningScripts)
+			destroyQueue.push_back(object.entity);
+		else
+			destroyNow(object.entity);
+	}
+
+	void Scene::destroyNow(const Entity& entity) {
+		//queued twice, or a child of something that went first
+		if (!system.hasEntity(entity))
+			return;
+
+		//the whole subtree, parents before children
+		std::vector<unsigned int> subtree = { entity.id };
 
-		Renderer::setCamera(editorCamera.camera);
+		for (size_t i = 0; i < subtree.size(); ++i) {
+			for (unsigned int child = hierarchy.getHierarchy(subtree[i]).firstChild; child != HFR_NULL_ENTITY; child = hierarchy.getHierarchy(child).nextSibling)
+				subtree.push_back(child);
+		}
+
+		//children first so nothing is left pointing at a node that's gone
+		for (size_t i = subtree.size(); i-- > 0;) {
+			Entity node = Entity();
+			node.id = subtree[i];
+
+			//a stopping script can destroy things too
+			if (!system.hasEntity(node))
+				continue;
+
+			hierarchy.remove(node.id);
+
+			if (system.getComponentManager()->hasComponent<NativeScript>(node))
+				system.getComponentManager()->getComponent<NativeScript>(node).destroyScripts();
+
+			system.destroyEntity(node);
+		}
+	}
+
+	void Scene::runScripts(void (GameObject::*phase)()) {
+		runningScripts = true;
 
 		for (unsigned int i = 0; i < system.getEntityAmount(); i++) {
 			Entity entity = (*system.getEntities())[i];
 
-			//update scripts (NEED TO PUSH TO UPDATE GAME NOT EDITOR)
 			if (system.getComponentManager()->hasComponent<NativeScript>(entity)) {
 				auto& script = system.getComponentManager()->getComponent<NativeScript>(entity);
 
@@ -77,6 +118,9 @@ namespace HFR {
 					if (!script.scripts[j]) {
 						script.instantiateScript(&script, j);
 
+						if (!script.scripts[j])
+							continue;
+
 						//add the entity reference to the script (to call things like getComponent<>())
 						script.scripts[j]->entity = entity;
 						script.scripts[j]->scene = this;
@@ -86,71 +130,146 @@ namespace HFR {
 						script.scripts[j]->start();
 					}
 
-					script.scripts[j]->update();
+					(script.scripts[j]->*phase)();
 				}
+			}
+		}
 
-				//script.scripts[0]->update();
+		runningScripts = false;
 
-				//if (!script.gameObject) {
-				//	//create the script
-				//	script.gameObject = script.instantiateFunction();
+		for (size_t i = 0; i < destroyQueue.size(); ++i)
+			destroyNow(destroyQueue[i]);
 
-				//	//add the entity reference to the script (to call things like getComponent<>())
-				//	script.gameObject->entity = entity;
-				//	script.gameObject->scene = this;
+		destroyQueue.clear();
+	}
+
+	void Scene::storePreviousSteps() {
+		//the matrixes have to be current before they get kept, only what changed since the last frame gets rebuilt
+		updateTransforms();
 
-				//	//startup the script
-				//	script.gameObject->start();
-				//}
+		auto transforms = system.getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT);
+		Transform* data = transforms->getComponents();
 
+		for (unsigned int i = 0; i < transforms->getSize(); ++i) {
+			if (data[i].interpolated) {
+				data[i].previousWorldMatrix = data[i].worldMatrix;
+				data[i].hasPreviousStep = true;
 			}
+		}
+	}
 
+	void Scene::fixedUpdate() {
+		ProfileMethod("Scene fixed update");
+		storePreviousSteps();
+		runScripts(&GameObject::fixedUpdate);
+	}
+
+	void Scene::update() {
+		ProfileMethod("Scene update");
+		runScripts(&GameObject::update);
+	}
+
+	void Scene::lateUpdate() {
+		ProfileMethod("Scene late update");
+		runScripts(&GameObject::lateUpdate);
+	}
+
+	void Scene::updateTransforms() {
+		//rebuild the cached matrixes of everything that changed, children first go through the hierarchy so they pick up their parents
+		auto transforms = system.getComponentManager()->getArray<Transform>(HFR_ECS_GET_COMPONENT);
+		hierarchy.update(transforms->getComponentData(), transforms->getComponentIndexes());
+		TransformSystem::update(*transforms);
+	}
 
+	void Scene::extract(RenderSnapshot& snapshot) {
+		ProfileMethod("Scene extract");
+
+		snapshot.view.setCamera(editorCamera.camera);
+		snapshot.view.light = light;
+		snapshot.interpolationAlpha = Time::getInterpolationAlpha();
+
+		for (unsigned int i = 0; i < system.getEntityAmount(); i++) {
+			Entity entity = (*system.getEntities())[i];
 
 			auto& meshcomponent = system.getComponentManager()->getComponent<MeshComponent>(entity);
 			auto& transform = system.getComponentManager()->getComponent<Transform>(entity);
 
-			HMath::keepRotationInTermsOf360(transform.rotation);
+			//updateTransforms runs right before this, so the world matrix already has the parents in it
+			const Mat4f* matrix = &transform.worldMatrix;
+			Mat4f blended;
 
-			//transform.rotation += Time::getDeltaTime() * 20;
-
-			if (meshcomponent.meshes.size() > 0) {
-				for (int j = 0; j < meshcomponent.meshes.size(); j++) {
-					auto& mesh = meshcomponent.meshes[j];
-					auto& texture = meshcomponent.meshes[j].material.diffuseMap;
+			if (transform.interpolated && transform.hasPreviousStep) {
+				blended = Mat4f::lerp(transform.previousWorldMatrix, transform.worldMatrix, snapshot.interpolationAlpha);
+				matrix = &blended;
+			}
 
-					if (!mesh.created)
-						mesh.create();
+			for (size_t j = 0; j < meshcomponent.meshes.size(); j++)
+				snapshot.add(meshcomponent.meshes[j], *matrix);
 
-					if (!texture.isCreated)
-						texture.create();
+			if (meshcomponent.asset.isReady()) {
+				std::vector<Mesh>& loaded = meshcomponent.asset.get();
 
-					if (!mesh.vertices.empty()) {
-						Renderer::render(mesh, transform, texture);
-					}
-				}
+				for (size_t j = 0; j < loaded.size(); ++j)
+					snapshot.add(loaded[j], *matrix);
 			}
-			/*else {
-				auto& mesh = system.getComponentManager()->getComponent<Mesh>(entity);
-				auto& texture = system.getComponentManager()->getComponent<Texture>(entity);
+		}
 
-				if (!mesh.vertices.empty()) {
-					if (!mesh.created)
-						mesh.create();
+		snapshot.finish();
+	}
 
-					if (!texture.isCreated)
-						texture.create();
+	void Scene::createPendingMeshes(RenderSnapshot& snapshot) {
+		for (size_t i = 0; i < snapshot.pendingMeshes.size(); ++i) {
+			Mesh& mesh = *snapshot.pendingMeshes[i];
 
-					Renderer::render(mesh, transform, texture);
-				}
-			}*/
+			//meshes handed over directly share the loaders upload budget so spawning a lot doesn't stall one frame
+			if (mesh.created || !AssetLoader::requestUpload(AssetLoader::getUploadSize(mesh)))
+				continue;
 
-			Renderer::update();
-			Renderer2D::renderGuis();
+			mesh.create();
 		}
 
+		snapshot.pendingMeshes.clear();
+	}
+
+	void Scene::updateEditor() {
+		ProfileMethod("Scene Editor update");
+
+		//input only gets read on the main thread, the camera gets to the simulation through the snapshot
+		editorCamera.update();
+
+		const bool pipelined = RenderPipeline::isEnabled();
 
+		RenderPipeline::beginFrame([this, pipelined](RenderSnapshot& snapshot) {
+			//without the pipeline Engine::updateEngine already ran the script phases
+			if (pipelined) {
+				while (Time::stepFixed()) {
+					FixedStepScope step;
+					fixedUpdate();
+				}
+
+				update();
+				lateUpdate();
+			}
 
+			updateTransforms();
+			extract(snapshot);
+		});
+
+		//the last frame gets drawn while the next one simulates, the gui is still the scripts' to change until the simulation is done
+		//so it gets laid out and drawn after (a frame ahead of the scene under it)
+		if (pipelined) {
+			Renderer::render(RenderPipeline::getFront());
+			RenderPipeline::endFrame();
+			Renderer2D::renderGuis();
+		}
+		else {
+			RenderPipeline::endFrame();
+			Renderer::render(RenderPipeline::getFront());
+			Renderer2D::renderGuis();
+		}
+
+		//the simulation isn't running until the next beginFrame
+		createPendingMeshes(RenderPipeline::getFront());
 
 		lerpedCpuUsage = HMath::lerp(lerpedCpuUsage, (float)Util::getCPUusage(), 0.01f);
 		lerpedRamUsage = HMath::lerp(lerpedRamUsage, (float)Util::getRAMusage(), 0.01f);
@@ -172,4 +291,8 @@ namespace HFR {
 		return &system;
 	}
 
+	HierarchySystem* Scene::getHierarchy() {
+		return &hierarchy;
+	}
+
 }
\ No newline at end of file
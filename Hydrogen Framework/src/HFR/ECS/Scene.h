@@ -7,6 +7,9 @@
 #include "ECS.h"
 #include HFR_EDITOR_CAMERA
 #include HFR_TEXTURE
+#include HFR_HIERARCHY_SYSTEM
+#include HFR_LIGHT
+#include HFR_RENDER_SNAPSHOT
 
 namespace HFR {
 
@@ -16,6 +19,7 @@ namespace HFR {
 	class DLL_API Scene {
 	private:
 		System system;
+		HierarchySystem hierarchy;
 
 		//GuiWindow performanceStats;
 		//GuiWindow gameObjectList;
@@ -25,8 +29,23 @@ namespace HFR {
 		float lerpedCpuUsage;
 		float lerpedRamUsage;
 
+		//objects destroyed by scripts, they go once the phase is done so the script doing it isn't deleted under itself
+		std::vector<Entity> destroyQueue;
+		bool runningScripts = false;
+
+		//calls phase on every script, making the ones that don't exist yet first
+		void runScripts(void (GameObject::*phase)());
+		void destroyNow(const Entity& entity);
+		//where the interpolated transforms are before a fixed step moves them
+		void storePreviousSteps();
+
+		//gl, so on the main thread while the simulation isn't running
+		void createPendingMeshes(RenderSnapshot& snapshot);
+
 	public:
 		EditorCamera editorCamera;
+		//goes into the snapshot with the camera, while pipelined only change it outside of updateEditor
+		Light light;
 
 		void initialize();
 
@@ -34,12 +53,28 @@ namespace HFR {
 		~Scene();
 
 		GameObject createGameObject(const std::string& name);
+		//takes its children with it and stops its scripts, from a script it happens at the end of the phase it was called in
+		void destroyGameObject(const GameObject& object);
 
+		//script phases, Engine::updateEngine runs them on Engine::scene, fixedUpdate once per fixed step and lateUpdate after every update
+		void fixedUpdate();
+		void update();
+		void lateUpdate();
+
+		//camera, transforms and drawing, after the script phases, with RenderPipeline enabled it also runs them on the simulation thread
+		//while the frame before gets drawn
 		void updateEditor();
 		//void startPlay();
 		//void updatePlay();
 
+		//the simulation side of a frame, with the render pipeline on these run on its thread (updateEditor does both, the benchmarks run them on their own)
+		void updateTransforms();
+		//uses the cached world matrixes, so updateTransforms has to run after anything moves and before this, interpolated transforms
+		//get drawn Time::getInterpolationAlpha() of the way from their previous fixed step to the last one
+		void extract(RenderSnapshot& snapshot);
+
 		System* getSystem();
+		HierarchySystem* getHierarchy();
 
 	};
 
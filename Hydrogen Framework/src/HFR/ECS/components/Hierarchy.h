@@ -0,0 +1,24 @@
+#ifndef HFR_HIERARCHY_COMPONENT_HEADER_INCLUDE
+#define HFR_HIERARCHY_COMPONENT_HEADER_INCLUDE
+
+#include HFR_API
+
+//no parent / child / sibling
+#define HFR_NULL_ENTITY 0xFFFFFFFF
+
+namespace HFR {
+
+	//children are a linked list through nextSibling, HierarchySystem keeps these up to date so don't change them yourself
+	struct DLL_API Hierarchy {
+		unsigned int parent = HFR_NULL_ENTITY;
+		unsigned int firstChild = HFR_NULL_ENTITY;
+		unsigned int nextSibling = HFR_NULL_ENTITY;
+		unsigned int childAmount = 0;
+
+		Hierarchy() {}
+
+	};
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+#include "hfpch.h"
+#include HFR_HIERARCHY_SYSTEM
+
+namespace HFR {
+
+	HierarchySystem::HierarchySystem() {
+
+	}
+
+	void HierarchySystem::add(const unsigned int& node) {
+		if (node == HFR_NULL_ENTITY)
+			return;
+
+		if (node >= nodes.size()) {
+			nodes.resize((size_t)node + 1);
+			inHierarchy.resize((size_t)node + 1, 0);
+		}
+
+		if (!inHierarchy[node]) {
+			inHierarchy[node] = 1;
+			nodes[node] = Hierarchy();
+			nodeAmount++;
+			orderDirty = true;
+		}
+	}
+
+	void HierarchySystem::remove(const unsigned int& node) {
+		if (!contains(node))
+			return;
+
+		//children become roots
+		unsigned int child = nodes[node].firstChild;
+
+		while (child != HFR_NULL_ENTITY) {
+			unsigned int next = nodes[child].nextSibling;
+
+			nodes[child].parent = HFR_NULL_ENTITY;
+			nodes[child].nextSibling = HFR_NULL_ENTITY;
+			reparented.push_back(child);
+
+			child = next;
+		}
+
+		nodes[node].firstChild = HFR_NULL_ENTITY;
+		nodes[node].childAmount = 0;
+		unlink(node);
+
+		inHierarchy[node] = 0;
+		nodeAmount--;
+		orderDirty = true;
+	}
+
+	bool HierarchySystem::contains(const unsigned int& node) const {
+		return node < inHierarchy.size() && inHierarchy[node];
+	}
+
+	void HierarchySystem::unlink(const unsigned int& node) {
+		unsigned int parent = nodes[node].parent;
+
+		if (parent == HFR_NULL_ENTITY)
+			return;
+
+		Hierarchy& parentHierarchy = nodes[parent];
+
+		if (parentHierarchy.firstChild == node)
+			parentHierarchy.firstChild = nodes[node].nextSibling;
+		else {
+			unsigned int sibling = parentHierarchy.firstChild;
+
+			while (nodes[sibling].nextSibling != node)
+				sibling = nodes[sibling].nextSibling;
+
+			nodes[sibling].nextSibling = nodes[node].nextSibling;
+		}
+
+		parentHierarchy.childAmount--;
+		nodes[node].parent = HFR_NULL_ENTITY;
+		nodes[node].nextSibling = HFR_NULL_ENTITY;
+	}
+
+	bool HierarchySystem::setParent(const unsigned int& node, const unsigned int& parent) {
+		if (parent == HFR_NULL_ENTITY) {
+			removeParent(node);
+			return true;
+		}
+
+		//a node without children can't be above its new parent, so only walk up when it has some (keeps building deep chains linear)
+		if (node == parent || (getHierarchy(node).firstChild != HFR_NULL_ENTITY && isDescendant(parent, node))) {
+			Debug::systemErr("Couldn't parent {} to {}, because it would make a loop", node, parent);
+			return false;
+		}
+
+		add(node);
+		add(parent);
+
+		if (nodes[node].parent == parent)
+			return true;
+
+		unlink(node);
+
+		//put at the front so it doesn't have to walk the siblings
+		nodes[node].parent = parent;
+		nodes[node].nextSibling = nodes[parent].firstChild;
+		nodes[parent].firstChild = node;
+		nodes[parent].childAmount++;
+
+		reparented.push_back(node);
+		orderDirty = true;
+
+		return true;
+	}
+
+	void HierarchySystem::removeParent(const unsigned int& node) {
+		if (!contains(node) || nodes[node].parent == HFR_NULL_ENTITY)
+			return;
+
+		unlink(node);
+
+		reparented.push_back(node);
+		orderDirty = true;
+	}
+
+	const Hierarchy& HierarchySystem::getHierarchy(const unsigned int& node) const {
+		static const Hierarchy none = Hierarchy();
+
+		if (!contains(node))
+			return none;
+
+		return nodes[node];
+	}
+
+	unsigned int HierarchySystem::getParent(const unsigned int& node) const {
+		return getHierarchy(node).parent;
+	}
+
+	bool HierarchySystem::isDescendant(const unsigned int& node, const unsigned int& ancestor) const {
+		unsigned int current = getParent(node);
+
+		while (current != HFR_NULL_ENTITY) {
+			if (current == ancestor)
+				return true;
+
+			current = getParent(current);
+		}
+
+		return false;
+	}
+
+	size_t HierarchySystem::getNodeAmount() const {
+		return nodeAmount;
+	}
+
+	const std::vector<unsigned int>& HierarchySystem::getOrder() {
+		if (orderDirty)
+			rebuildOrder();
+
+		return order;
+	}
+
+	void HierarchySystem::rebuildOrder() {
+		order.clear();
+		order.reserve(nodeAmount);
+		parentSlot.clear();
+		parentSlot.reserve(nodeAmount);
+		nodeSlot.assign(nodes.size(), HFR_NULL_ENTITY);
+
+		//depth first (with a stack, deep chains would blow up recursion) so every subtree ends up in one range
+		std::vector<unsigned int> stack;
+
+		for (unsigned int root = 0; root < (unsigned int)nodes.size(); ++root) {
+			if (!inHierarchy[root] || nodes[root].parent != HFR_NULL_ENTITY)
+				continue;
+
+			stack.push_back(root);
+
+			while (!stack.empty()) {
+				unsigned int node = stack.back();
+				stack.pop_back();
+
+				unsigned int parent = nodes[node].parent;
+
+				nodeSlot[node] = (unsigned int)order.size();
+				order.push_back(node);
+				parentSlot.push_back(parent == HFR_NULL_ENTITY ? HFR_NULL_ENTITY : nodeSlot[parent]);
+
+				for (unsigned int child = nodes[node].firstChild; child != HFR_NULL_ENTITY; child = nodes[child].nextSibling)
+					stack.push_back(child);
+			}
+		}
+
+		//children always come after their parent so going backwards finishes them first
+		size_t slots = order.size();
+		subtreeEnd.resize(slots);
+
+		for (size_t slot = 0; slot < slots; ++slot)
+			subtreeEnd[slot] = (unsigned int)slot + 1;
+
+		for (size_t slot = slots; slot-- > 0;) {
+			unsigned int parent = parentSlot[slot];
+
+			if (parent != HFR_NULL_ENTITY)
+				subtreeEnd[parent] = max(subtreeEnd[parent], subtreeEnd[slot]);
+		}
+
+		//split it up into ranges that can run at the same time
+		serialSlots.clear();
+		rangeBegins.clear();
+		rangeEnds.clear();
+
+		size_t grain = max((size_t)1024, slots / (((size_t)JobSystem::getWorkerAmount() + 1) * 4));
+
+		for (size_t slot = 0; slot < slots; slot = subtreeEnd[slot])
+			splitSubtree((unsigned int)slot, grain);
+
+		std::sort(serialSlots.begin(), serialSlots.end());
+
+		//splitSubtree adds ranges in order, so small neighbouring subtrees can be merged into one
+		size_t merged = 0;
+
+		for (size_t i = 0; i < rangeBegins.size(); ++i) {
+			if (merged > 0 && rangeEnds[merged - 1] == rangeBegins[i] && rangeEnds[i] - rangeBegins[merged - 1] <= grain)
+				rangeEnds[merged - 1] = rangeEnds[i];
+			else {
+				rangeBegins[merged] = rangeBegins[i];
+				rangeEnds[merged] = rangeEnds[i];
+				merged++;
+			}
+		}
+
+		rangeBegins.resize(merged);
+		rangeEnds.resize(merged);
+
+		changed.resize(slots);
+		orderDirty = false;
+	}
+
+	void HierarchySystem::splitSubtree(const unsigned int& root, const size_t& grain) {
+		//small enough to be one range, otherwise the root gets done up front and its children get split
+		std::vector<unsigned int> stack;
+		stack.push_back(root);
+
+		while (!stack.empty()) {
+			unsigned int slot = stack.back();
+			stack.pop_back();
+
+			if (subtreeEnd[slot] - slot <= grain) {
+				rangeBegins.push_back(slot);
+				rangeEnds.push_back(subtreeEnd[slot]);
+				continue;
+			}
+
+			serialSlots.push_back(slot);
+
+			//pushed backwards so they come off the stack in order
+			std::vector<unsigned int> children;
+
+			for (unsigned int child = slot + 1; child < subtreeEnd[slot]; child = subtreeEnd[child])
+				children.push_back(child);
+
+			for (size_t i = children.size(); i-- > 0;)
+				stack.push_back(children[i]);
+		}
+	}
+
+	bool HierarchySystem::hasTransform(const unsigned int& node, const unsigned int* transformIndexes) {
+		//index 0 is the empty component of the array, nothing should write to it
+		return transformIndexes == nullptr || transformIndexes[node] != 0;
+	}
+
+	void HierarchySystem::updateSlot(const unsigned int& slot, Transform* transforms, const unsigned int* transformIndexes) {
+		unsigned int node = order[slot];
+
+		if (!hasTransform(node, transformIndexes)) {
+			changed[slot] = 0;
+			return;
+		}
+
+		Transform& transform = transforms[transformIndexes ? transformIndexes[node] : node];
+
+		//under a node without a transform it gets placed like a root
+		unsigned int parent = parentSlot[slot];
+
+		if (parent != HFR_NULL_ENTITY && !hasTransform(order[parent], transformIndexes))
+			parent = HFR_NULL_ENTITY;
+
+		bool parentChanged = parent != HFR_NULL_ENTITY && changed[parent];
+
+		if (!transform.dirty && !parentChanged) {
+			changed[slot] = 0;
+			return;
+		}
+
+		if (transform.dirty)
+			transform.localMatrix = transform.createLocalMatrix();
+
+		if (parent == HFR_NULL_ENTITY)
+			transform.worldMatrix = transform.localMatrix;
+		else {
+			unsigned int parentNode = order[parent];
+			const Transform& parentTransform = transforms[transformIndexes ? transformIndexes[parentNode] : parentNode];
+
+			MatrixKernels::multiply(parentTransform.worldMatrix, transform.localMatrix, transform.worldMatrix);
+		}
+
+		transform.dirty = false;
+		changed[slot] = 1;
+	}
+
+	void HierarchySystem::update(Transform* transforms, const unsigned int* transformIndexes) {
+		ProfileMethod("Hierarchy System update");
+
+		if (orderDirty)
+			rebuildOrder();
+
+		//reparenting changes the world matrix even if the transform itself didn't change
+		for (size_t i = 0; i < reparented.size(); ++i) {
+			unsigned int node = reparented[i];
+
+			if (contains(node) && hasTransform(node, transformIndexes))
+				transforms[transformIndexes ? transformIndexes[node] : node].dirty = true;
+		}
+
+		reparented.clear();
+
+		for (size_t i = 0; i < serialSlots.size(); ++i)
+			updateSlot(serialSlots[i], transforms, transformIndexes);
+
+		JobSystem::parallelFor(rangeBegins.size(), 1, [&](const size_t& begin, const size_t& end) {
+			for (size_t range = begin; range < end; ++range) {
+				for (unsigned int slot = rangeBegins[range]; slot < rangeEnds[range]; ++slot)
+					updateSlot(slot, transforms, transformIndexes);
+			}
+		});
+	}
+
+}
@@ -0,0 +1,70 @@
+#ifndef HFR_HIERARCHY_SYSTEM_HEADER_INCLUDE
+#define HFR_HIERARCHY_SYSTEM_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_HIERARCHY
+#include HFR_TRANSFORM
+
+namespace HFR {
+
+	//parent / child transforms, nodes are just ids (entity ids in a scene) and the transforms are looked up by that id
+	//the nodes get kept in a packed parent before child order so propagating world matrixes is one linear pass, split up over independent subtrees
+	class DLL_API HierarchySystem {
+	private:
+		std::vector<Hierarchy> nodes;
+		std::vector<unsigned char> inHierarchy;
+
+		//packed order (depth first so every subtree is one range)
+		std::vector<unsigned int> order;
+		std::vector<unsigned int> nodeSlot;
+		std::vector<unsigned int> parentSlot;
+		std::vector<unsigned int> subtreeEnd;
+		bool orderDirty = true;
+
+		//ancestors of the big subtrees get done first on one thread, then the ranges can be done at the same time
+		std::vector<unsigned int> serialSlots;
+		std::vector<unsigned int> rangeBegins;
+		std::vector<unsigned int> rangeEnds;
+
+		//per slot, set if the world matrix changed this update so the children know
+		std::vector<unsigned char> changed;
+
+		//nodes that got reparented and need their world matrix redone even if their transform didn't change
+		std::vector<unsigned int> reparented;
+
+		size_t nodeAmount = 0;
+
+		void rebuildOrder();
+		void splitSubtree(const unsigned int& slot, const size_t& grain);
+		void unlink(const unsigned int& node);
+		static bool hasTransform(const unsigned int& node, const unsigned int* transformIndexes);
+		void updateSlot(const unsigned int& slot, Transform* transforms, const unsigned int* transformIndexes);
+
+	public:
+		HierarchySystem();
+
+		void add(const unsigned int& node);
+		void remove(const unsigned int& node);
+		bool contains(const unsigned int& node) const;
+
+		//returns false if it would make a loop (parent is the node or one of its children)
+		bool setParent(const unsigned int& node, const unsigned int& parent);
+		void removeParent(const unsigned int& node);
+
+		const Hierarchy& getHierarchy(const unsigned int& node) const;
+		unsigned int getParent(const unsigned int& node) const;
+		bool isDescendant(const unsigned int& node, const unsigned int& ancestor) const;
+		size_t getNodeAmount() const;
+
+		//the transform of node n is transforms[transformIndexes[n]] (or transforms[n] if transformIndexes is nullptr),
+		//nodes whose index is 0 (no transform) get skipped and their children get placed like roots
+		//rebuilds local matrixes of dirty transforms and world matrixes of everything under them, dirty flags are cleared
+		void update(Transform* transforms, const unsigned int* transformIndexes = nullptr);
+
+		//packed parent before child order
+		const std::vector<unsigned int>& getOrder();
+	};
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "hfpch.h"
+#include HFR_TRANSFORM_SYSTEM
+
+namespace HFR {
+
+	std::vector<unsigned int> TransformSystem::dirtyIndices = std::vector<unsigned int>();
+	std::array<std::vector<float>, 9> TransformSystem::gatherBuffers = std::array<std::vector<float>, 9>();
+	std::vector<Mat4f> TransformSystem::matrices = std::vector<Mat4f>();
+
+	unsigned int TransformSystem::rebuiltLastUpdate = 0;
+
+	unsigned int TransformSystem::update(Transform* transforms, const size_t& count) {
+		ProfileMethod("Transform System update");
+
+		unsigned int rebuilt = 0;
+		dirtyIndices.clear();
+
+		for (size_t i = 0; i < count; ++i) {
+			Transform& transform = transforms[i];
+
+			if (!transform.dirty)
+				continue;
+
+			//quaternions don't need any trig so just build them here
+			if (transform.useQuaternion) {
+				transform.localMatrix = Mat4f::createTransformationMatrix(transform.position, transform.orientation, transform.scale);
+				transform.worldMatrix = transform.localMatrix;
+				transform.dirty = false;
+				rebuilt++;
+			}
+			else
+				dirtyIndices.push_back((unsigned int)i);
+		}
+
+		size_t dirtyAmount = dirtyIndices.size();
+
+		if (dirtyAmount > 0) {
+			for (size_t j = 0; j < gatherBuffers.size(); ++j)
+				gatherBuffers[j].resize(dirtyAmount);
+
+			matrices.resize(dirtyAmount);
+
+			for (size_t j = 0; j < dirtyAmount; ++j) {
+				const Transform& transform = transforms[dirtyIndices[j]];
+
+				gatherBuffers[0][j] = transform.position.x;
+				gatherBuffers[1][j] = transform.position.y;
+				gatherBuffers[2][j] = transform.position.z;
+				gatherBuffers[3][j] = transform.rotation.x;
+				gatherBuffers[4][j] = transform.rotation.y;
+				gatherBuffers[5][j] = transform.rotation.z;
+				gatherBuffers[6][j] = transform.scale.x;
+				gatherBuffers[7][j] = transform.scale.y;
+				gatherBuffers[8][j] = transform.scale.z;
+			}
+
+			TransformArrays arrays;
+			arrays.positionX = gatherBuffers[0].data();
+			arrays.positionY = gatherBuffers[1].data();
+			arrays.positionZ = gatherBuffers[2].data();
+			arrays.rotationX = gatherBuffers[3].data();
+			arrays.rotationY = gatherBuffers[4].data();
+			arrays.rotationZ = gatherBuffers[5].data();
+			arrays.scaleX = gatherBuffers[6].data();
+			arrays.scaleY = gatherBuffers[7].data();
+			arrays.scaleZ = gatherBuffers[8].data();
+
+			MatrixKernels::createTransformationMatrices(arrays, matrices.data(), dirtyAmount);
+
+			for (size_t j = 0; j < dirtyAmount; ++j) {
+				Transform& transform = transforms[dirtyIndices[j]];
+
+				transform.localMatrix = matrices[j];
+				transform.worldMatrix = matrices[j];
+				transform.dirty = false;
+			}
+
+			rebuilt += (unsigned int)dirtyAmount;
+		}
+
+		rebuiltLastUpdate = rebuilt;
+		return rebuilt;
+	}
+
+	unsigned int TransformSystem::update(ComponentArray<Transform>& transforms) {
+		return update(transforms.getComponents(), transforms.getSize());
+	}
+
+	unsigned int TransformSystem::getRebuiltLastUpdate() {
+		return rebuiltLastUpdate;
+	}
+
+}
@@ -0,0 +1,30 @@
+#ifndef HFR_TRANSFORM_SYSTEM_HEADER_INCLUDE
+#define HFR_TRANSFORM_SYSTEM_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_ECS
+#include HFR_TRANSFORM
+
+namespace HFR {
+
+	//rebuilds the cached matrixes of dirty transforms in one pass, transforms that haven't changed cost a flag check
+	class DLL_API TransformSystem {
+	private:
+		//scratch space so the euler transforms can go through the batch kernel (kept around so there's no allocating every frame)
+		static std::vector<unsigned int> dirtyIndices;
+		static std::array<std::vector<float>, 9> gatherBuffers;
+		static std::vector<Mat4f> matrices;
+
+		static unsigned int rebuiltLastUpdate;
+
+	public:
+		//returns how many matrixes got rebuilt
+		static unsigned int update(Transform* transforms, const size_t& count);
+		static unsigned int update(ComponentArray<Transform>& transforms);
+
+		static unsigned int getRebuiltLastUpdate();
+	};
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef HFR_ASSET_HANDLE_HEADER_INCLUDE
+#define HFR_ASSET_HANDLE_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	class Texture;
+	class Mesh;
+	class Font;
+
+	//shared between the handle, the worker that decodes it and the main thread that uploads it
+	template<typename T>
+	struct Asset {
+		std::atomic<int> status;
+		std::string path;
+		T data;
+
+		Asset() : status(HFR_ASSET_LOADING) {}
+	};
+
+	//cheap to copy, every copy points at the same asset
+	template<typename T>
+	class AssetHandle {
+	private:
+		std::shared_ptr<Asset<T>> asset;
+
+		friend class AssetLoader;
+
+	public:
+		AssetHandle() {}
+		AssetHandle(const std::shared_ptr<Asset<T>>& _asset) : asset(_asset) {}
+
+		//false for default constructed handles that never got loaded
+		bool isValid() const {
+			return asset != nullptr;
+		}
+
+		//HFR_ASSET_LOADING, HFR_ASSET_READY or HFR_ASSET_FAILED
+		int getStatus() const {
+			return asset ? asset->status.load(std::memory_order_acquire) : HFR_ASSET_FAILED;
+		}
+
+		bool isLoading() const {
+			return getStatus() == HFR_ASSET_LOADING;
+		}
+
+		bool isReady() const {
+			return getStatus() == HFR_ASSET_READY;
+		}
+
+		bool isFailed() const {
+			return getStatus() == HFR_ASSET_FAILED;
+		}
+
+		std::string getPath() const {
+			return asset ? asset->path : std::string();
+		}
+
+		//how many handles (and in flight loads) share the asset
+		long getReferenceAmount() const {
+			return asset.use_count();
+		}
+
+		//only touch this once the asset is ready, before that it belongs to the loader
+		T& get() const {
+			return asset->data;
+		}
+
+		//the same asset, not just the same path
+		bool operator==(const AssetHandle& other) const {
+			return asset == other.asset;
+		}
+
+		bool operator!=(const AssetHandle& other) const {
+			return asset != other.asset;
+		}
+	};
+
+	typedef AssetHandle<Texture> TextureHandle;
+	typedef AssetHandle<std::vector<Mesh>> MeshHandle;
+	typedef AssetHandle<Font> FontHandle;
+
+}
+
+#endif
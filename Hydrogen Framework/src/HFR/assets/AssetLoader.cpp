@@ -0,0 +1,277 @@
+#include "hfpch.h"
+#include HFR_ASSET_LOADER
+#include HFR_FONT
+
+namespace HFR {
+
+	namespace {
+		struct PendingUpload {
+			size_t bytes = 0;
+			//false skips the gl part and only makes the asset ready
+			std::function<void(const bool&)> upload;
+		};
+
+		std::deque<PendingUpload> uploads;
+		std::mutex uploadMutex;
+		std::atomic<unsigned int> decodingAmount(0);
+		//signalled when a decode finishes, waitForAll and close sleep on it
+		std::condition_variable decodedCondition;
+
+		//decode runs on a worker (or right here), if it worked the upload gets queued for AssetLoader::update
+		template<typename T>
+		void startLoad(const std::shared_ptr<Asset<T>>& asset, const bool& multithreaded, const std::function<bool(T&)>& decode, const std::function<size_t(const T&)>& uploadSize, const std::function<void(T&)>& upload) {
+			decodingAmount++;
+
+			auto job = [asset, decode, uploadSize, upload]() {
+				const bool decoded = decode(asset->data);
+				PendingUpload pending;
+
+				if (decoded) {
+					pending.bytes = uploadSize(asset->data);
+					pending.upload = [asset, upload](const bool& uploading) {
+						if (uploading)
+							upload(asset->data);
+
+						asset->status.store(HFR_ASSET_READY, std::memory_order_release);
+					};
+				}
+				else
+					asset->status.store(HFR_ASSET_FAILED, std::memory_order_release);
+
+				{
+					std::lock_guard<std::mutex> lock(uploadMutex);
+
+					if (decoded)
+						uploads.push_back(pending);
+
+					//with the push so getPendingAmount never sees the asset in neither place,
+					//and under the lock so a waiter can't check, miss this and then sleep through the notify
+					decodingAmount--;
+				}
+
+				decodedCondition.notify_all();
+			};
+
+			if (multithreaded)
+				JobSystem::run(job);
+			else
+				job();
+		}
+	}
+
+	size_t AssetLoader::uploadBudget = HFR_DEFAULT_UPLOAD_BUDGET;
+	size_t AssetLoader::uploadedThisFrame = 0;
+	unsigned int AssetLoader::uploadsThisFrame = 0;
+	bool AssetLoader::multithreaded = true;
+	bool AssetLoader::uploading = true;
+
+	void AssetLoader::close() {
+		std::unique_lock<std::mutex> lock(uploadMutex);
+		decodedCondition.wait(lock, []() { return decodingAmount == 0; });
+
+		uploads.clear();
+	}
+
+	TextureHandle AssetLoader::loadTexture(const std::string& path) {
+		return loadTexture(path, TextureSampler());
+	}
+
+	TextureHandle AssetLoader::loadTexture(const std::string& path, const TextureSampler& sampler) {
+		return loadTexture(path, sampler, 0);
+	}
+
+	TextureHandle AssetLoader::loadTexture(const std::string& path, const TextureSampler& sampler, const int& streamingSize) {
+		TextureHandle out = reserveTexture(path, sampler);
+		startTexture(out, streamingSize);
+
+		return out;
+	}
+
+	TextureHandle AssetLoader::reserveTexture(const std::string& path, const TextureSampler& sampler) {
+		std::shared_ptr<Asset<Texture>> asset = std::make_shared<Asset<Texture>>();
+		asset->path = path;
+		asset->data.setSampler(sampler);
+
+		return TextureHandle(asset);
+	}
+
+	void AssetLoader::startTexture(const TextureHandle& texture, const int& streamingSize) {
+		const std::shared_ptr<Asset<Texture>>& asset = texture.asset;
+		const std::string path = asset->path;
+
+		startLoad<Texture>(asset, multithreaded,
+			[path, streamingSize](Texture& texture) {
+				//cooked textures already have their levels in the format the gpu wants
+				if (CookedTexture::isCookedPath(path)) {
+					if (!texture.cooked.open(path))
+						return false;
+
+					if (streamingSize > 0)
+						texture.firstLevel = (int)texture.cooked.getLevelForSize(streamingSize);
+
+					return true;
+				}
+
+				texture.image = Image(path);
+
+				//making the mips here keeps glGenerateMipmap off the main thread
+				if (texture.generateMipmap && texture.image.hasData())
+					texture.mipmaps = ImageProcessing::generateMipChain(texture.image);
+
+				return texture.image.hasData();
+			},
+			[](const Texture& texture) {
+				return getUploadSize(texture);
+			},
+			[](Texture& texture) {
+				texture.create();
+			});
+	}
+
+	MeshHandle AssetLoader::loadMesh(const std::string& path) {
+		std::shared_ptr<Asset<std::vector<Mesh>>> asset = std::make_shared<Asset<std::vector<Mesh>>>();
+		asset->path = path;
+
+		startLoad<std::vector<Mesh>>(asset, multithreaded,
+			[path](std::vector<Mesh>& meshes) {
+				//material textures get requested from the texture cache in here and load as their own assets
+				meshes = Util::loadMesh(path);
+				return !meshes.empty();
+			},
+			[](const std::vector<Mesh>& meshes) {
+				size_t bytes = 0;
+				for (size_t i = 0; i < meshes.size(); ++i)
+					bytes += getUploadSize(meshes[i]);
+
+				return bytes;
+			},
+			[](std::vector<Mesh>& meshes) {
+				for (size_t i = 0; i < meshes.size(); ++i)
+					meshes[i].create();
+			});
+
+		return MeshHandle(asset);
+	}
+
+	FontHandle AssetLoader::loadFont(const std::string& path, const float& size) {
+		std::shared_ptr<Asset<Font>> asset = std::make_shared<Asset<Font>>();
+		asset->path = path;
+		asset->data = Font(path);
+		asset->data.size.y = size;
+
+		startLoad<Font>(asset, multithreaded,
+			[](Font& font) {
+				return font.rasterize();
+			},
+			[](const Font& font) {
+				return getUploadSize(font.getTexture());
+			},
+			[](Font& font) {
+				font.createTexture();
+			});
+
+		return FontHandle(asset);
+	}
+
+	void AssetLoader::update() {
+		ProfileMethod("Asset uploads");
+
+		uploadedThisFrame = 0;
+		uploadsThisFrame = 0;
+
+		while (true) {
+			PendingUpload pending;
+
+			{
+				std::lock_guard<std::mutex> lock(uploadMutex);
+
+				if (uploads.empty() || !requestUpload(uploads.front().bytes))
+					break;
+
+				pending = uploads.front();
+				uploads.pop_front();
+			}
+
+			pending.upload(uploading);
+		}
+	}
+
+	void AssetLoader::waitForAll() {
+		std::unique_lock<std::mutex> lock(uploadMutex);
+
+		while (decodingAmount > 0 || !uploads.empty()) {
+			//sleeps until there's something to upload or nothing left decoding
+			decodedCondition.wait(lock, []() { return decodingAmount == 0 || !uploads.empty(); });
+
+			std::deque<PendingUpload> ready;
+			ready.swap(uploads);
+
+			//uploads can start loads of their own, so not while holding the lock
+			lock.unlock();
+
+			for (size_t i = 0; i < ready.size(); ++i)
+				ready[i].upload(uploading);
+
+			lock.lock();
+		}
+	}
+
+	bool AssetLoader::requestUpload(const size_t& bytes) {
+		if (uploadsThisFrame > 0 && uploadedThisFrame + bytes > uploadBudget)
+			return false;
+
+		uploadedThisFrame += bytes;
+		uploadsThisFrame += 1;
+
+		return true;
+	}
+
+	void AssetLoader::setUploadBudget(const size_t& bytes) {
+		uploadBudget = bytes;
+	}
+
+	size_t AssetLoader::getUploadBudget() {
+		return uploadBudget;
+	}
+
+	void AssetLoader::setMultithreaded(const bool& _multithreaded) {
+		multithreaded = _multithreaded;
+	}
+
+	bool AssetLoader::isMultithreaded() {
+		return multithreaded;
+	}
+
+	void AssetLoader::setUploading(const bool& _uploading) {
+		uploading = _uploading;
+	}
+
+	bool AssetLoader::isUploading() {
+		return uploading;
+	}
+
+	size_t AssetLoader::getUploadSize(const Texture& texture) {
+		if (texture.cooked.isOpen())
+			return texture.cooked.getDataSize(texture.firstLevel);
+
+		size_t bytes = (size_t)texture.image.width * texture.image.height * texture.image.channels;
+
+		for (size_t i = 0; i < texture.mipmaps.size(); ++i)
+			bytes += (size_t)texture.mipmaps[i].width * texture.mipmaps[i].height * texture.mipmaps[i].channels;
+
+		return bytes;
+	}
+
+	size_t AssetLoader::getUploadSize(const Mesh& mesh) {
+		//material maps come from the texture cache and get uploaded on their own
+		return (mesh.vertices.size() + mesh.texturecoords.size() + mesh.normals.size()) * sizeof(float) + mesh.indices.size() * sizeof(unsigned int);
+	}
+
+	size_t AssetLoader::getPendingAmount() {
+		size_t amount = decodingAmount;
+
+		std::lock_guard<std::mutex> lock(uploadMutex);
+		return amount + uploads.size();
+	}
+
+}
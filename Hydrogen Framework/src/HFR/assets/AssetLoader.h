@@ -0,0 +1,68 @@
+#ifndef HFR_ASSET_LOADER_HEADER_INCLUDE
+#define HFR_ASSET_LOADER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_ASSET_HANDLE
+
+namespace HFR {
+
+	struct TextureSampler;
+
+	//file reading and decoding (stb_image, obj parsing, freetype) happens on the job system workers,
+	//the opengl uploads get queued and handed out a few at a time by update() so no single frame stalls
+	class DLL_API AssetLoader {
+	private:
+		static size_t uploadBudget;
+		static size_t uploadedThisFrame;
+		static unsigned int uploadsThisFrame;
+		static bool multithreaded;
+		static bool uploading;
+
+	public:
+		//waits for the decodes that are still running and drops the uploads nobody got to (without a gl context this is how to wait for the decodes)
+		static void close();
+
+		//these always load a new copy, go through TextureCache to share textures that are already loaded
+		static TextureHandle loadTexture(const std::string& path);
+		static TextureHandle loadTexture(const std::string& path, const TextureSampler& sampler);
+		//cooked textures only get the levels that fit in streamingSize x streamingSize uploaded (0 uploads all of them), TextureStreamer brings in the rest
+		static TextureHandle loadTexture(const std::string& path, const TextureSampler& sampler, const int& streamingSize);
+		//loadTexture in two steps, reserve only makes the handle so a cache can hand it out under its lock and start it after letting go
+		//(without workers start decodes right there), start once per handle
+		static TextureHandle reserveTexture(const std::string& path, const TextureSampler& sampler);
+		static void startTexture(const TextureHandle& texture, const int& streamingSize = 0);
+		static MeshHandle loadMesh(const std::string& path);
+		static FontHandle loadFont(const std::string& path, const float& size);
+
+		//uploads decoded assets until this frames budget runs out, call once per frame on the opengl thread
+		static void update();
+		//blocks until everything is decoded and uploaded, ignores the budget (loading screens and benchmarks)
+		static void waitForAll();
+
+		//for gl uploads outside the loader (like the scene creating meshes it was handed), returns false if this frame is out of budget
+		//the first upload of a frame always goes through so a big asset can't get stuck forever
+		static bool requestUpload(const size_t& bytes);
+
+		//bytes per frame, HFR_DEFAULT_UPLOAD_BUDGET by default
+		static void setUploadBudget(const size_t& bytes);
+		static size_t getUploadBudget();
+
+		//turning this off decodes on the calling thread, the load functions block but the uploads still go through update()
+		static void setMultithreaded(const bool& multithreaded);
+		static bool isMultithreaded();
+
+		//off without a gl context (tools, the benchmarks), update and waitForAll still make the assets ready but skip the gl calls,
+		//so textures come out not created and Renderer::getTexture would hand out the null texture for them
+		static void setUploading(const bool& uploading);
+		static bool isUploading();
+
+		//assets that are still decoding or waiting to be uploaded
+		static size_t getPendingAmount();
+
+		static size_t getUploadSize(const Texture& texture);
+		static size_t getUploadSize(const Mesh& mesh);
+	};
+
+}
+
+#endif
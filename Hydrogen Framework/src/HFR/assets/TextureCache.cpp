@@ -0,0 +1,202 @@
+#include "hfpch.h"
+#include HFR_TEXTURE_CACHE
+
+namespace HFR {
+
+	namespace {
+		struct CacheEntry {
+			TextureHandle texture;
+			std::list<std::string>::iterator order;
+			size_t bytes = 0;
+		};
+
+		std::unordered_map<std::string, CacheEntry> entries;
+		//front is the most recently used
+		std::list<std::string> order;
+		std::mutex cacheMutex;
+
+		size_t getTextureSize(const Texture& texture) {
+			//the file stays mapped for as long as the texture does and the gpu holds the same bytes
+			if (texture.cooked.isOpen())
+				return texture.cooked.getDataSize() + texture.cooked.getDataSize(texture.firstLevel);
+
+			size_t pixels = (size_t)texture.image.width * texture.image.height;
+			size_t gpu = pixels * 4;
+
+			//a full mip chain is about another third on top
+			if (texture.generateMipmap)
+				gpu += gpu / 3;
+
+			size_t cpu = pixels * texture.image.channels;
+
+			for (size_t i = 0; i < texture.mipmaps.size(); ++i)
+				cpu += (size_t)texture.mipmaps[i].width * texture.mipmaps[i].height * texture.mipmaps[i].channels;
+
+			return cpu + gpu;
+		}
+
+		//walks from the least recently used end, needs cacheMutex
+		unsigned long long evictUnreferenced(size_t& memoryUsage, const size_t& target) {
+			unsigned long long evicted = 0;
+			auto current = order.end();
+
+			while (memoryUsage > target && current != order.begin()) {
+				--current;
+
+				auto found = entries.find(*current);
+				const TextureHandle& texture = found->second.texture;
+
+				//the cache holds one reference itself, anything above that is someone still using it
+				if (texture.isLoading() || texture.getReferenceAmount() > 1)
+					continue;
+
+				memoryUsage -= found->second.bytes;
+				entries.erase(found);
+				current = order.erase(current);
+				evicted += 1;
+			}
+
+			return evicted;
+		}
+	}
+
+	size_t TextureCache::budget = HFR_DEFAULT_TEXTURE_CACHE_BUDGET;
+	size_t TextureCache::memoryUsage = 0;
+
+	unsigned long long TextureCache::hits = 0;
+	unsigned long long TextureCache::misses = 0;
+	unsigned long long TextureCache::evictions = 0;
+
+	std::string TextureCache::createKey(const std::string& path, const TextureSampler& sampler) {
+		std::string out = VirtualFileSystem::normalizePath(path);
+
+#if _WIN64
+		//windows paths aren't case sensitive so neither is the cache
+		std::transform(out.begin(), out.end(), out.begin(), [](const char& character) { return (char)tolower((unsigned char)character); });
+#endif
+
+		out += "|" + std::to_string(sampler.wrapMode.x) + "," + std::to_string(sampler.wrapMode.y);
+		out += "|" + std::to_string(sampler.filterMode.x) + "," + std::to_string(sampler.filterMode.y);
+		out += sampler.generateMipmap ? "|mip" : "|nomip";
+
+		return out;
+	}
+
+	TextureHandle TextureCache::load(const std::string& path) {
+		return load(path, TextureSampler());
+	}
+
+	TextureHandle TextureCache::load(const std::string& path, const TextureSampler& sampler) {
+		std::string key = createKey(path, sampler);
+		TextureHandle out;
+
+		{
+			std::lock_guard<std::mutex> lock(cacheMutex);
+
+			auto found = entries.find(key);
+
+			if (found != entries.end()) {
+				hits += 1;
+				order.splice(order.begin(), order, found->second.order);
+
+				return found->second.texture;
+			}
+
+			misses += 1;
+
+			order.push_front(key);
+
+			CacheEntry& entry = entries[key];
+			entry.texture = AssetLoader::reserveTexture(path, sampler);
+			entry.order = order.begin();
+
+			out = entry.texture;
+		}
+
+		//without workers this decodes right here, so not under the lock (anyone asking for the same file meanwhile gets this handle while it loads)
+		AssetLoader::startTexture(out);
+
+		return out;
+	}
+
+	void TextureCache::update() {
+		ProfileMethod("Texture cache update");
+
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		memoryUsage = 0;
+
+		for (auto& pair : entries) {
+			if (pair.second.texture.isReady())
+				pair.second.bytes = getTextureSize(pair.second.texture.get());
+
+			memoryUsage += pair.second.bytes;
+		}
+
+		if (memoryUsage > budget)
+			evictions += evictUnreferenced(memoryUsage, budget);
+	}
+
+	void TextureCache::trim() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		//size doesn't matter here so pretend everything is over budget
+		size_t everything = (size_t)-1;
+		evictions += evictUnreferenced(everything, 0);
+
+		memoryUsage = 0;
+
+		for (auto& pair : entries)
+			memoryUsage += pair.second.bytes;
+	}
+
+	void TextureCache::clear() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		entries.clear();
+		order.clear();
+		memoryUsage = 0;
+	}
+
+	void TextureCache::setBudget(const size_t& bytes) {
+		budget = bytes;
+	}
+
+	size_t TextureCache::getBudget() {
+		return budget;
+	}
+
+	size_t TextureCache::getMemoryUsage() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return memoryUsage;
+	}
+
+	size_t TextureCache::getEntryAmount() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return entries.size();
+	}
+
+	unsigned long long TextureCache::getHits() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return hits;
+	}
+
+	unsigned long long TextureCache::getMisses() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return misses;
+	}
+
+	unsigned long long TextureCache::getEvictions() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		return evictions;
+	}
+
+	void TextureCache::resetCounters() {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		hits = 0;
+		misses = 0;
+		evictions = 0;
+	}
+
+}
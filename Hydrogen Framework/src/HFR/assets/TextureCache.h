@@ -0,0 +1,50 @@
+#ifndef HFR_TEXTURE_CACHE_HEADER_INCLUDE
+#define HFR_TEXTURE_CACHE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_ASSET_HANDLE
+#include HFR_TEXTURE
+
+namespace HFR {
+
+	//one decode and one upload per file and sampler, everyone asking for the same texture shares the handle
+	//textures nobody holds a handle to anymore get evicted least recently used first once the cache goes over budget
+	class DLL_API TextureCache {
+	private:
+		static size_t budget;
+		static size_t memoryUsage;
+
+		static unsigned long long hits;
+		static unsigned long long misses;
+		static unsigned long long evictions;
+
+		static std::string createKey(const std::string& path, const TextureSampler& sampler);
+
+	public:
+		//safe from any thread, a miss starts an async load through the AssetLoader
+		static TextureHandle load(const std::string& path);
+		static TextureHandle load(const std::string& path, const TextureSampler& sampler);
+
+		//evicts down to the budget, call once per frame on the opengl thread since evicting deletes gl textures
+		static void update();
+		//evicts everything that isn't referenced, ignoring the budget
+		static void trim();
+		//drops every entry, do this while the opengl context is still around
+		static void clear();
+
+		//bytes of cpu pixels plus the gpu copy (mips included), HFR_DEFAULT_TEXTURE_CACHE_BUDGET by default
+		static void setBudget(const size_t& bytes);
+		static size_t getBudget();
+		//as of the last update
+		static size_t getMemoryUsage();
+		static size_t getEntryAmount();
+
+		static unsigned long long getHits();
+		static unsigned long long getMisses();
+		static unsigned long long getEvictions();
+		static void resetCounters();
+	};
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+#include "hfpch.h"
+#include HFR_TEXTURE_STREAMER
+
+namespace HFR {
+
+	namespace {
+		struct StreamEntry {
+			TextureHandle texture;
+			//levels from this one down are always resident
+			int baseLevel = 0;
+			//smallest level any draw asked for since the last update and what that came out to at the last update
+			int wantedLevel = INT_MAX;
+			int targetLevel = INT_MAX;
+			float screenSize = 0.0f;
+			unsigned long long lastVisible = 0;
+			bool registered = false;
+
+			//the level being read on a worker, -1 when there isn't one
+			int pendingLevel = -1;
+			std::shared_ptr<std::atomic<bool>> pendingDone;
+			std::chrono::steady_clock::time_point requestTime;
+		};
+
+		std::unordered_map<std::string, StreamEntry> entries;
+		//ready cooked textures by address, which is all the renderer has at draw time
+		std::unordered_map<const Texture*, StreamEntry*> streamed;
+
+		//touches one byte a page so the page faults (the actual disk reads) happen on the worker instead of in the middle of the upload
+		void prefetch(const CookedTexture& cooked, const int& level) {
+			const volatile unsigned char* data = cooked.getLevelData(level);
+			const size_t size = cooked.getLevelSize(level);
+			unsigned char sum = 0;
+
+			for (size_t i = 0; i < size; i += 4096)
+				sum += data[i];
+
+			(void)sum;
+		}
+
+		//drops the biggest level of the least recently seen texture that has anything above its base levels
+		//when something is asking for the room, textures seen last frame only give up levels they have more of than they want
+		bool evictLevel(size_t& residentMemory, const unsigned long long& frame, const StreamEntry* requester) {
+			StreamEntry* victim = nullptr;
+
+			for (auto& pair : entries) {
+				StreamEntry& entry = pair.second;
+
+				if (&entry == requester || !entry.registered || entry.pendingLevel >= 0)
+					continue;
+
+				const Texture& texture = entry.texture.get();
+
+				if (texture.firstLevel >= entry.baseLevel)
+					continue;
+
+				bool recentlySeen = entry.lastVisible + 1 >= frame;
+
+				if (requester != nullptr && recentlySeen && texture.firstLevel >= entry.targetLevel)
+					continue;
+
+				if (victim == nullptr || entry.lastVisible < victim->lastVisible)
+					victim = &entry;
+			}
+
+			if (victim == nullptr)
+				return false;
+
+			Texture& texture = victim->texture.get();
+			residentMemory -= texture.cooked.getLevelSize(texture.firstLevel);
+			texture.setFirstLevel(texture.firstLevel + 1);
+
+			return true;
+		}
+	}
+
+	size_t TextureStreamer::budget = HFR_DEFAULT_STREAMING_BUDGET;
+	size_t TextureStreamer::residentMemory = 0;
+	size_t TextureStreamer::pendingMemory = 0;
+	unsigned long long TextureStreamer::frame = 0;
+
+	unsigned long long TextureStreamer::completedRequests = 0;
+	double TextureStreamer::totalLatency = 0.0;
+	double TextureStreamer::maxLatency = 0.0;
+
+	std::string TextureStreamer::createKey(const std::string& path, const TextureSampler& sampler) {
+		std::string out = VirtualFileSystem::normalizePath(path);
+
+		out += "|" + std::to_string(sampler.wrapMode.x) + "," + std::to_string(sampler.wrapMode.y);
+		out += "|" + std::to_string(sampler.filterMode.x) + "," + std::to_string(sampler.filterMode.y);
+
+		return out;
+	}
+
+	TextureHandle TextureStreamer::load(const std::string& path) {
+		return load(path, TextureSampler());
+	}
+
+	TextureHandle TextureStreamer::load(const std::string& path, const TextureSampler& sampler) {
+		if (!CookedTexture::isCookedPath(path))
+			return AssetLoader::loadTexture(path, sampler);
+
+		std::string key = createKey(path, sampler);
+		auto found = entries.find(key);
+
+		if (found != entries.end())
+			return found->second.texture;
+
+		StreamEntry& entry = entries[key];
+		entry.texture = AssetLoader::loadTexture(path, sampler, HFR_STREAMING_BASE_SIZE);
+		entry.lastVisible = frame;
+
+		return entry.texture;
+	}
+
+	void TextureStreamer::markVisible(const TextureHandle& texture, const Vec3f& position, const float& radius) {
+		if (streamed.empty() || !texture.isReady())
+			return;
+
+		auto found = streamed.find(&texture.get());
+
+		if (found == streamed.end())
+			return;
+
+		StreamEntry& entry = *found->second;
+		const CookedTexture& cooked = texture.get().cooked;
+
+		float screenSize = getScreenSize(position, radius);
+
+		entry.wantedLevel = min(entry.wantedLevel, getWantedLevel(max(cooked.getWidth(), cooked.getHeight()), screenSize, (int)cooked.getLevelAmount()));
+		entry.screenSize = max(entry.screenSize, screenSize);
+		entry.lastVisible = frame;
+	}
+
+	void TextureStreamer::markVisible(const Material& material, const Vec3f& position, const float& radius) {
+		if (streamed.empty())
+			return;
+
+		markVisible(material.diffuseMap, position, radius);
+		markVisible(material.ambientMap, position, radius);
+		markVisible(material.specularMap, position, radius);
+		markVisible(material.emissionMap, position, radius);
+	}
+
+	void TextureStreamer::update() {
+		ProfileMethod("Texture streamer update");
+
+		frame += 1;
+
+		std::vector<StreamEntry*> requests;
+
+		for (auto current = entries.begin(); current != entries.end();) {
+			StreamEntry& entry = current->second;
+
+			//the streamer holds one reference itself, a read in flight doesn't hold any
+			if (entry.texture.getReferenceAmount() == 1 && !entry.texture.isLoading()) {
+				if (entry.registered) {
+					const Texture& texture = entry.texture.get();
+
+					streamed.erase(&texture);
+					residentMemory -= texture.cooked.getDataSize(texture.firstLevel);
+
+					if (entry.pendingLevel >= 0)
+						pendingMemory -= texture.cooked.getLevelSize(entry.pendingLevel);
+				}
+
+				current = entries.erase(current);
+				continue;
+			}
+
+			++current;
+
+			if (!entry.texture.isReady())
+				continue;
+
+			Texture& texture = entry.texture.get();
+
+			if (!entry.registered) {
+				entry.registered = true;
+				entry.baseLevel = texture.firstLevel;
+				streamed[&texture] = &entry;
+				residentMemory += texture.cooked.getDataSize(texture.firstLevel);
+			}
+
+			//finished reads go up as soon as the loaders upload budget lets them
+			if (entry.pendingLevel >= 0 && entry.pendingDone->load(std::memory_order_acquire)) {
+				size_t bytes = texture.cooked.getLevelSize(entry.pendingLevel);
+
+				if (AssetLoader::requestUpload(bytes)) {
+					texture.setFirstLevel(entry.pendingLevel);
+
+					pendingMemory -= bytes;
+					residentMemory += bytes;
+
+					double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - entry.requestTime).count();
+					totalLatency += latency;
+					maxLatency = max(maxLatency, latency);
+					completedRequests += 1;
+
+					entry.pendingLevel = -1;
+					entry.pendingDone.reset();
+				}
+			}
+
+			//nothing drawn with it means it only needs its base levels
+			entry.targetLevel = min(entry.wantedLevel, entry.baseLevel);
+			entry.wantedLevel = INT_MAX;
+
+			if (entry.pendingLevel < 0 && entry.targetLevel < texture.firstLevel)
+				requests.push_back(&entry);
+		}
+
+		//whatever is missing the most detail goes first, ties go to what's bigger on screen
+		std::sort(requests.begin(), requests.end(), [](const StreamEntry* a, const StreamEntry* b) {
+			int missingA = a->texture.get().firstLevel - a->targetLevel;
+			int missingB = b->texture.get().firstLevel - b->targetLevel;
+
+			return missingA != missingB ? missingA > missingB : a->screenSize > b->screenSize;
+		});
+
+		size_t inFlight = getPendingAmount();
+
+		for (size_t i = 0; i < requests.size() && inFlight < (size_t)HFR_STREAMING_MAX_REQUESTS; ++i) {
+			StreamEntry& entry = *requests[i];
+			Texture& texture = entry.texture.get();
+
+			//one level at a time so the texture sharpens as it goes instead of waiting on the biggest level
+			const int level = texture.firstLevel - 1;
+			const size_t bytes = texture.cooked.getLevelSize(level);
+
+			while (residentMemory + pendingMemory + bytes > budget && evictLevel(residentMemory, frame, &entry)) {}
+
+			if (residentMemory + pendingMemory + bytes > budget)
+				continue;
+
+			entry.pendingLevel = level;
+			entry.pendingDone = std::make_shared<std::atomic<bool>>(false);
+			entry.requestTime = std::chrono::steady_clock::now();
+			pendingMemory += bytes;
+			inFlight += 1;
+
+			//the job gets its own view of the file instead of the handle, the last handle can't go away on a worker without a gl context
+			CookedTexture cooked = texture.cooked;
+			std::shared_ptr<std::atomic<bool>> done = entry.pendingDone;
+
+			JobSystem::run([cooked, level, done]() {
+				prefetch(cooked, level);
+				done->store(true, std::memory_order_release);
+			});
+		}
+
+		for (auto& pair : entries)
+			pair.second.screenSize = 0.0f;
+
+		//the budget can also get set under what's already resident
+		while (residentMemory > budget && evictLevel(residentMemory, frame, nullptr)) {}
+	}
+
+	void TextureStreamer::clear() {
+		entries.clear();
+		streamed.clear();
+
+		residentMemory = 0;
+		pendingMemory = 0;
+	}
+
+	void TextureStreamer::setBudget(const size_t& bytes) {
+		budget = bytes;
+	}
+
+	size_t TextureStreamer::getBudget() {
+		return budget;
+	}
+
+	size_t TextureStreamer::getResidentMemory() {
+		return residentMemory;
+	}
+
+	size_t TextureStreamer::getEntryAmount() {
+		return entries.size();
+	}
+
+	size_t TextureStreamer::getPendingAmount() {
+		size_t out = 0;
+
+		for (auto& pair : entries) {
+			if (pair.second.pendingLevel >= 0)
+				out += 1;
+		}
+
+		return out;
+	}
+
+	unsigned long long TextureStreamer::getCompletedRequests() {
+		return completedRequests;
+	}
+
+	double TextureStreamer::getAverageLatency() {
+		return completedRequests > 0 ? totalLatency / completedRequests : 0.0;
+	}
+
+	double TextureStreamer::getMaxLatency() {
+		return maxLatency;
+	}
+
+	void TextureStreamer::resetCounters() {
+		completedRequests = 0;
+		totalLatency = 0.0;
+		maxLatency = 0.0;
+	}
+
+	float TextureStreamer::getScreenSize(const Vec3f& position, const float& radius) {
+		float dx = position.x - Renderer::view.camera.position.x;
+		float dy = position.y - Renderer::view.camera.position.y;
+		float dz = position.z - Renderer::view.camera.position.z;
+		float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+		//inside the sphere it covers the whole screen
+		if (distance <= radius)
+			return FLT_MAX;
+
+		float halfHeight = (float)tan(HMath::toRadians(HFR_FIELD_OF_VIEW) * 0.5);
+
+		return radius / (distance * halfHeight) * Renderer::getCurrentWindowSize().y;
+	}
+
+	int TextureStreamer::getWantedLevel(const int& textureSize, const float& screenSize, const int& levelAmount) {
+		if (screenSize <= 0.0f)
+			return levelAmount - 1;
+
+		if (screenSize >= (float)textureSize)
+			return 0;
+
+		return min((int)log2f((float)textureSize / screenSize), levelAmount - 1);
+	}
+
+}
@@ -0,0 +1,67 @@
+#ifndef HFR_TEXTURE_STREAMER_HEADER_INCLUDE
+#define HFR_TEXTURE_STREAMER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_ASSET_HANDLE
+#include HFR_TEXTURE
+#include HFR_MATERIAL
+#include HFR_VEC3
+
+namespace HFR {
+
+	//mip streaming for cooked (.htex) textures, they start out with only their small levels on the gpu and the bigger ones get read in
+	//on the job system once whatever uses them is close enough to the camera to need them
+	//when the streamed levels go over budget the textures that haven't been seen the longest give theirs up first
+	//everything here is main thread only, same as the renderer
+	class DLL_API TextureStreamer {
+	private:
+		static size_t budget;
+		static size_t residentMemory;
+		//bytes of the reads in flight, they already count against the budget
+		static size_t pendingMemory;
+		static unsigned long long frame;
+
+		static unsigned long long completedRequests;
+		static double totalLatency;
+		static double maxLatency;
+
+		static std::string createKey(const std::string& path, const TextureSampler& sampler);
+
+	public:
+		//anything that isn't cooked loads like it would through the AssetLoader and never streams
+		static TextureHandle load(const std::string& path);
+		static TextureHandle load(const std::string& path, const TextureSampler& sampler);
+
+		//the renderer calls these for every draw, position and radius are the world space bounding sphere of what's being drawn
+		static void markVisible(const TextureHandle& texture, const Vec3f& position, const float& radius);
+		static void markVisible(const Material& material, const Vec3f& position, const float& radius);
+
+		//uploads finished reads (through AssetLoader::requestUpload), starts new ones and drops levels to stay in budget, once per frame
+		static void update();
+		//drops every entry, do this while the opengl context is still around
+		static void clear();
+
+		//HFR_DEFAULT_STREAMING_BUDGET by default
+		static void setBudget(const size_t& bytes);
+		static size_t getBudget();
+		//gpu bytes of every streamed texture as of the last update
+		static size_t getResidentMemory();
+		static size_t getEntryAmount();
+		//levels still being read
+		static size_t getPendingAmount();
+
+		//latency is from a level being requested to it being on the gpu, in milliseconds
+		static unsigned long long getCompletedRequests();
+		static double getAverageLatency();
+		static double getMaxLatency();
+		static void resetCounters();
+
+		//pixels across a sphere covers on screen as seen from Renderer::view
+		static float getScreenSize(const Vec3f& position, const float& radius);
+		//the level that gives about one texel per pixel, 0 is the full size one
+		static int getWantedLevel(const int& textureSize, const float& screenSize, const int& levelAmount);
+	};
+
+}
+
+#endif
@@ -46,6 +46,9 @@ namespace HFR {
 		else if (transform.rotation.x > 90)
 			transform.rotation.x = 90;
 
+		//changed in place instead of through setRotation, that would wrap the pitch into 0 to 360 and break the clamp
+		transform.markDirty();
+
 		camera.position = transform.position;
 		camera.rotation = transform.rotation;
 	}
@@ -0,0 +1,108 @@
+#ifndef HFR_ALLOCATION_OPERATORS_HEADER_INCLUDE
+#define HFR_ALLOCATION_OPERATORS_HEADER_INCLUDE
+
+#include HFR_ALLOCATION_TRACKER
+
+//the global new and delete going through AllocationTracker, include this in exactly one source file of a module (the framework does in AllocationTracker.cpp),
+//every module has its own operators on windows so a program that wants its allocations counted has to include it too,
+//nothing gets replaced unless HFR_TRACK_ALLOCATIONS is defined
+#ifdef HFR_TRACK_ALLOCATIONS
+
+void* operator new(size_t size) {
+	return HFR::AllocationTracker::allocate(size);
+}
+
+void* operator new[](size_t size) {
+	return HFR::AllocationTracker::allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return HFR::AllocationTracker::allocate(size);
+	}
+	catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+	HFR::AllocationTracker::deallocate(pointer);
+}
+
+//over aligned types go through these with /std:c++17 or /Zc:alignedNew, they need their own free so they can't fall back to the ones above
+#ifdef __cpp_aligned_new
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	return HFR::AllocationTracker::allocateAligned(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return HFR::AllocationTracker::allocateAligned(size, (size_t)alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try {
+		return HFR::AllocationTracker::allocateAligned(size, (size_t)alignment);
+	}
+	catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+	return operator new(size, alignment, tag);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+	HFR::AllocationTracker::deallocateAligned(pointer);
+}
+
+#endif
+
+#endif
+
+#endif
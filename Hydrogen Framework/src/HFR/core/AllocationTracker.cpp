@@ -0,0 +1,105 @@
+#include "hfpch.h"
+#include HFR_ALLOCATION_TRACKER
+#include HFR_ALLOCATION_OPERATORS
+
+namespace HFR {
+
+	namespace {
+		//these get used before anything else in the module is constructed, atomics with constant initialization are ready from the start
+		std::atomic<size_t> allocations(0);
+		std::atomic<size_t> frees(0);
+		std::atomic<size_t> allocatedBytes(0);
+
+		//what operator new has to do when it's out of memory, the new_handler gets to free something up (or throw) until it's taken away
+		template<typename Allocate>
+		void* allocateOrHandle(const size_t& size, const Allocate& allocate) {
+			while (true) {
+				void* out = allocate();
+
+				if (out != nullptr) {
+					AllocationTracker::countAllocation(size);
+					return out;
+				}
+
+				std::new_handler handler = std::get_new_handler();
+
+				if (handler == nullptr)
+					throw std::bad_alloc();
+
+				handler();
+			}
+		}
+	}
+
+	bool AllocationTracker::isTracking() {
+#ifdef HFR_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void* AllocationTracker::allocate(const size_t& size) {
+		return allocateOrHandle(size, [&size]() { return malloc(size > 0 ? size : 1); });
+	}
+
+	void* AllocationTracker::allocateAligned(const size_t& size, const size_t& alignment) {
+		return allocateOrHandle(size, [&size, &alignment]() {
+#ifdef _WIN32
+			return _aligned_malloc(size > 0 ? size : 1, alignment);
+#else
+			//aligned_alloc only takes multiples of the alignment
+			return aligned_alloc(alignment, size > 0 ? (size + alignment - 1) / alignment * alignment : alignment);
+#endif
+		});
+	}
+
+	void AllocationTracker::deallocate(void* pointer) {
+		if (pointer == nullptr)
+			return;
+
+		countFree();
+		free(pointer);
+	}
+
+	void AllocationTracker::deallocateAligned(void* pointer) {
+		if (pointer == nullptr)
+			return;
+
+		countFree();
+#ifdef _WIN32
+		_aligned_free(pointer);
+#else
+		free(pointer);
+#endif
+	}
+
+	void AllocationTracker::countAllocation(const size_t& bytes) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void AllocationTracker::countFree() {
+		frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	size_t AllocationTracker::getAllocations() {
+		return allocations.load(std::memory_order_relaxed);
+	}
+
+	size_t AllocationTracker::getFrees() {
+		return frees.load(std::memory_order_relaxed);
+	}
+
+	size_t AllocationTracker::getAllocatedBytes() {
+		return allocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	size_t AllocationTracker::getLiveAllocations() {
+		size_t freed = getFrees();
+		size_t made = getAllocations();
+
+		return made > freed ? made - freed : 0;
+	}
+
+}
@@ -0,0 +1,34 @@
+#ifndef HFR_ALLOCATION_TRACKER_HEADER_INCLUDE
+#define HFR_ALLOCATION_TRACKER_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	//counts everything that goes through new and delete while HFR_TRACK_ALLOCATIONS is defined, the framework replaces the global operators
+	//for its own module then (AllocationOperators.h), a program counts its own into here too by including that in one of its files
+	class DLL_API AllocationTracker {
+	public:
+		//false when the framework was built without HFR_TRACK_ALLOCATIONS, everything stays at 0 then
+		static bool isTracking();
+
+		//what the replaced operators call, malloc with the new_handler loop, throws std::bad_alloc when the handler gives up
+		static void* allocate(const size_t& size);
+		static void* allocateAligned(const size_t& size, const size_t& alignment);
+		static void deallocate(void* pointer);
+		static void deallocateAligned(void* pointer);
+
+		static void countAllocation(const size_t& bytes);
+		static void countFree();
+
+		//since the program started
+		static size_t getAllocations();
+		static size_t getFrees();
+		static size_t getAllocatedBytes();
+		//allocations that haven't been freed yet
+		static size_t getLiveAllocations();
+	};
+
+}
+
+#endif
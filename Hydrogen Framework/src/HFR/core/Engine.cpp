@@ -6,10 +6,13 @@
 namespace HFR {
 
 	Window* Engine::window = nullptr;
-	std::vector<GuiFrame*> Engine::guiFrames = std::vector<GuiFrame*>();
-	std::vector<GuiImage*> Engine::guiImages = std::vector<GuiImage*>();
+	Scene* Engine::scene = nullptr;
 
 	void Engine::startEngine() {
+		ScopeProfiler::init();
+		//after the profiler, it timestamps the records with its clock
+		Logger::init();
+
 		Debug::waterMark();
 		Debug::newLine();
 
@@ -62,9 +65,15 @@ namespace HFR {
 		Debug::systemSuccess("Renderer2D was initialized");
 		Debug::newLine();
 
+		GpuProfiler::init();
+
 		Debug::systemLog("Initializing Utilities");
 		Util::init();
+		VirtualFileSystem::init();
 		Random::init();
+		MatrixKernels::init();
+		ImageProcessing::init();
+		JobSystem::init();
 		Debug::systemSuccess("Utilities was initialized");
 		Debug::newLine();
 
@@ -83,16 +92,52 @@ namespace HFR {
 	}
 
 	void Engine::updateEngine() {
+		//a replay sets the clock, so before anything reads it
+		Replay::update();
+		Time::waitForFrame();
 		Time::update();
 		Input::update();
 		Debug::update();
+		TraceCapture::update();
+		FrameTelemetry::update();
+		AssetLoader::update();
+		TextureCache::update();
+		TextureStreamer::update();
 		ScriptManager::update();
+
+		//fixed steps first, so update and the drawing after it see where the last step left things,
+		//when the render pipeline is on Scene::updateEditor runs them on the simulation thread instead
+		if (scene != nullptr && !RenderPipeline::isEnabled()) {
+			while (Time::stepFixed()) {
+				FixedStepScope step;
+				scene->fixedUpdate();
+			}
+
+			scene->update();
+			scene->lateUpdate();
+		}
 	}
 
 	void Engine::stopEngine() {
 		Debug::closingWaterMark();
 		Debug::newLine();
 
+		//before anything the loader threads might still be using goes away
+		Debug::systemLog("Closing Asset Loader");
+		AssetLoader::close();
+		//the cached textures have to go while there's still a context to delete them in
+		TextureCache::clear();
+		TextureStreamer::clear();
+		Debug::systemSuccess("Closed Asset Loader");
+		Debug::newLine();
+
+		//no simulation can be running when the scripts and meshes go away
+		RenderPipeline::close();
+
+		//the gui framebuffer and the timer queries too
+		GuiCanvas::close();
+		GpuProfiler::close();
+
 		Debug::systemLog("Closing main window");
 		glfwTerminate();
 		delete window;
@@ -110,6 +155,8 @@ namespace HFR {
 
 		Debug::systemLog("Closing Utilities");
 		Util::deleteVBOs();
+		JobSystem::close();
+		VirtualFileSystem::close();
 		Debug::systemSuccess("Closed Utilities");
 		Debug::newLine();
 
@@ -119,38 +166,33 @@ namespace HFR {
 			delete guiFrames[i];
 			amount += 1;
 		}
-		Debug::systemSuccess("Deleted " + std::to_string(amount) + " Gui Items");
+		Debug::systemSuccess("Deleted {} Gui Items", amount);
 		Debug::newLine();*/
 
 		Debug::systemLog("Deleting Scripts");
 		ScriptManager::close();
 		Debug::systemSuccess("Scripts were deleted");
 		Debug::newLine();
+
+		Logger::close();
 	}
 
 	void Engine::registerGuiFrame(GuiFrame* frame) {
-		if (std::find(guiFrames.begin(), guiFrames.end(), frame) == guiFrames.end()) {
-			guiFrames.push_back(frame);
-		}
+		if (frame->parent == nullptr)
+			GuiCanvas::add(frame);
 	}
 
 	void Engine::registerGuiImage(GuiImage* image) {
-		if (std::find(guiImages.begin(), guiImages.end(), image) == guiImages.end()) {
-			guiImages.push_back(image);
-		}
+		if (image->parent == nullptr)
+			GuiCanvas::add(image);
 	}
 
 	void Engine::removeGuiFrame(GuiFrame* frame) {
-		for (size_t i = 0; i < guiFrames.size(); ++i) {
-			if (frame == guiFrames[i])
-				guiFrames.erase(guiFrames.begin() + i, guiFrames.begin() + i + 1);
-		}
+		frame->removeFromParent();
 	}
 
 	void Engine::removeGuiFrame(const std::string& frame) {
-		for (size_t i = 0; i < guiFrames.size(); ++i) {
-			if (frame == guiFrames[i]->name)
-				guiFrames.erase(guiFrames.begin() + i, guiFrames.begin() + i + 1);
-		}
+		for (GuiElement* element = GuiCanvas::find(frame); element != nullptr; element = GuiCanvas::find(frame))
+			element->removeFromParent();
 	}
 }
\ No newline at end of file
@@ -10,20 +10,20 @@
 
 namespace HFR {
 
-
+	class Scene;
 
 	class DLL_API Engine {
 	public:
-		static std::vector<GuiFrame*> guiFrames;
-		static std::vector<GuiImage*> guiImages;
 		//static std::map<std::string, Face*> faces;
 		static Window* window;
+		//whose scripts the frame loop runs, the first scene made sets itself
+		static Scene* scene;
 
 		static void startEngine();
 		static void updateEngine();
 		static void stopEngine();
 
-		//gui stuff
+		//gui stuff, these put elements into (or take them out of) the top level of GuiCanvas
 		static void registerGuiFrame(GuiFrame* frame);
 		static void registerGuiImage(GuiImage* image);
 		static void removeGuiFrame(GuiFrame* frame);
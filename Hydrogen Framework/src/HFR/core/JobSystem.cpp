@@ -0,0 +1,159 @@
+#include "hfpch.h"
+#include HFR_JOB_SYSTEM
+
+namespace HFR {
+
+	namespace {
+		std::vector<std::thread> workers;
+		std::queue<std::function<void()>> jobs;
+		std::mutex jobMutex;
+		std::condition_variable jobCondition;
+		bool running = false;
+	}
+
+	unsigned int JobSystem::workerAmount = 0;
+
+	void JobSystem::init() {
+		unsigned int threads = std::thread::hardware_concurrency();
+		init(threads > 1 ? threads - 1 : 0);
+	}
+
+	void JobSystem::init(const unsigned int& _workers) {
+		if (running)
+			close();
+
+		running = true;
+		workerAmount = _workers;
+
+		for (unsigned int i = 0; i < workerAmount; ++i)
+			workers.push_back(std::thread(workerLoop));
+
+		Debug::systemLog("Job system started {} worker threads", workerAmount);
+	}
+
+	void JobSystem::close() {
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			running = false;
+		}
+
+		jobCondition.notify_all();
+
+		for (size_t i = 0; i < workers.size(); ++i)
+			workers[i].join();
+
+		workers.clear();
+		workerAmount = 0;
+
+		//anything left over still has to happen
+		while (runPendingJob());
+	}
+
+	unsigned int JobSystem::getWorkerAmount() {
+		return workerAmount;
+	}
+
+	void JobSystem::workerLoop() {
+		ScopeProfiler::setThreadName("Job worker");
+
+		while (true) {
+			std::function<void()> job;
+
+			{
+				std::unique_lock<std::mutex> lock(jobMutex);
+				jobCondition.wait(lock, [] { return !running || !jobs.empty(); });
+
+				if (!running && jobs.empty())
+					return;
+
+				job = std::move(jobs.front());
+				jobs.pop();
+			}
+
+			ProfileJob("Job");
+			job();
+		}
+	}
+
+	bool JobSystem::runPendingJob() {
+		std::function<void()> job;
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+
+			if (jobs.empty())
+				return false;
+
+			job = std::move(jobs.front());
+			jobs.pop();
+		}
+
+		ProfileJob("Job");
+		job();
+		return true;
+	}
+
+	void JobSystem::run(const std::function<void()>& job) {
+		if (workerAmount == 0) {
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+			jobs.push(job);
+		}
+
+		jobCondition.notify_one();
+	}
+
+	void JobSystem::parallelFor(const size_t& count, const size_t& batchSize, const std::function<void(const size_t& begin, const size_t& end)>& function) {
+		if (count == 0)
+			return;
+
+		//no point splitting it up
+		if (workerAmount == 0 || count <= batchSize) {
+			function(0, count);
+			return;
+		}
+
+		//a few batches per thread so uneven batches even out
+		size_t batch = max(batchSize, count / ((size_t)(workerAmount + 1) * 4));
+		if (batch == 0)
+			batch = 1;
+
+		size_t batchAmount = (count + batch - 1) / batch;
+		std::atomic<size_t> remaining(batchAmount);
+
+		{
+			std::lock_guard<std::mutex> lock(jobMutex);
+
+			//the last batch gets done on this thread
+			for (size_t i = 0; i < batchAmount - 1; ++i) {
+				size_t begin = i * batch;
+				size_t end = min(begin + batch, count);
+
+				jobs.push([&function, &remaining, begin, end]() {
+					function(begin, end);
+					remaining.fetch_sub(1, std::memory_order_release);
+				});
+			}
+		}
+
+		jobCondition.notify_all();
+
+		{
+			ProfileJob("Parallel for batch");
+			function((batchAmount - 1) * batch, count);
+		}
+
+		remaining.fetch_sub(1, std::memory_order_release);
+
+		//help out instead of just waiting
+		while (remaining.load(std::memory_order_acquire) > 0) {
+			if (!runPendingJob())
+				std::this_thread::yield();
+		}
+	}
+
+}
@@ -0,0 +1,34 @@
+#ifndef HFR_JOB_SYSTEM_HEADER_INCLUDE
+#define HFR_JOB_SYSTEM_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	//small worker thread pool, if it wasn't initialized (or has no workers) everything just runs on the calling thread
+	class DLL_API JobSystem {
+	private:
+		static unsigned int workerAmount;
+
+		static void workerLoop();
+		//runs one queued job on the calling thread, returns false if there wasn't one
+		static bool runPendingJob();
+
+	public:
+		//one worker per hardware thread minus the main thread
+		static void init();
+		static void init(const unsigned int& workers);
+		static void close();
+
+		static unsigned int getWorkerAmount();
+
+		//fire and forget
+		static void run(const std::function<void()>& job);
+
+		//splits [0, count) into batches of at least batchSize and runs them on the workers and the calling thread, returns once every batch is done
+		static void parallelFor(const size_t& count, const size_t& batchSize, const std::function<void(const size_t& begin, const size_t& end)>& function);
+	};
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 namespace HFR {
 
+	std::vector<std::string> Program::arguments;
+
 	Program::Program() {
 		window = new HFR::Window(Vec2i(1880, 1080), "Hydrogen Game Engine");
 		Engine::window = window;
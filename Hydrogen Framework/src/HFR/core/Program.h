@@ -12,6 +12,8 @@ namespace HFR {
 	protected:
 		Window* window;
 	public:
+		//what the program got started with, the first one is the executable, filled in before createProgram
+		static std::vector<std::string> arguments;
 
 		Program();
 		virtual ~Program();
@@ -0,0 +1,169 @@
+#include "hfpch.h"
+#include HFR_REPLAY
+
+namespace HFR {
+
+	namespace {
+		const char REPLAY_MAGIC[4] = { 'H', 'R', 'P', 'L' };
+	}
+
+	ReplayData Replay::data;
+	bool Replay::recording = false;
+	bool Replay::replaying = false;
+	size_t Replay::frame = 0;
+
+	size_t ReplayData::getFrameAmount() const {
+		return input.frames.size();
+	}
+
+	bool ReplayData::save(const std::string& path) const {
+		std::string out;
+		out.append(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+		Util::writeValue(out, (uint32_t)HFR_REPLAY_VERSION);
+		Util::writeValue(out, (uint32_t)seed);
+		Util::writeValue(out, fixedRate);
+		Util::writeValue(out, startTime);
+		input.write(out);
+
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't write replay to: {}", path);
+			return false;
+		}
+
+		file.write(out.data(), out.size());
+		Debug::systemLog("Wrote a replay of {} frames to: {}", getFrameAmount(), path);
+		return file.good();
+	}
+
+	bool ReplayData::load(const std::string& path) {
+		FileData file = VirtualFileSystem::read(path);
+
+		if (!file.isValid()) {
+			Debug::systemErr("Could not read replay: {}", path);
+			return false;
+		}
+
+		const unsigned char* bytes = file.getData();
+		const size_t size = file.getSize();
+		size_t offset = 0;
+		uint32_t version = 0;
+		uint32_t readSeed = 0;
+
+		if (size < sizeof(REPLAY_MAGIC) || std::memcmp(bytes, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+			Debug::systemErr("Not a replay: {}", path);
+			return false;
+		}
+
+		offset += sizeof(REPLAY_MAGIC);
+
+		if (!Util::readValue(bytes, size, offset, version) || version != HFR_REPLAY_VERSION) {
+			Debug::systemErr("Replay: {} has version {}, expected {}", path, version, HFR_REPLAY_VERSION);
+			return false;
+		}
+
+		if (!Util::readValue(bytes, size, offset, readSeed) || !Util::readValue(bytes, size, offset, fixedRate) || !Util::readValue(bytes, size, offset, startTime) ||
+			!input.read(bytes, size, offset) || fixedRate <= 0) {
+			Debug::systemErr("Replay: {} is cut off or broken", path);
+			return false;
+		}
+
+		seed = readSeed;
+		return true;
+	}
+
+	void Replay::startRecording(const unsigned int& seed) {
+		if (replaying) {
+			Debug::systemErr("Can't record a replay while one is playing");
+			return;
+		}
+
+		Random::setSeed(seed);
+		Time::resetFixedSteps();
+
+		data = ReplayData();
+		data.seed = seed;
+		data.fixedRate = Time::getFixedRate();
+		//the first recorded frame measures its delta from the frame before
+		data.startTime = Time::getFrameStartTime();
+
+		Input::startRecording();
+		recording = true;
+	}
+
+	void Replay::stopRecording() {
+		if (!recording)
+			return;
+
+		Input::stopRecording();
+		data.input = Input::getRecording();
+		recording = false;
+	}
+
+	bool Replay::isRecording() {
+		return recording;
+	}
+
+	const ReplayData& Replay::getData() {
+		return data;
+	}
+
+	void Replay::startReplay(const ReplayData& _data) {
+		if (_data.input.frames.empty()) {
+			Debug::systemErr("Can't play a replay without frames");
+			return;
+		}
+
+		stopRecording();
+
+		data = _data;
+		frame = 0;
+		replaying = true;
+
+		Random::setSeed(data.seed);
+		Time::setFixedRate(data.fixedRate);
+		Time::resetFixedSteps();
+		//also makes the first frame measure from the start time
+		Time::setClock([]() { return frame == 0 ? data.startTime : data.input.frames[frame - 1].time; });
+		Input::startReplay(data.input);
+
+		Debug::systemLog("Replaying {} frames with seed {}", data.getFrameAmount(), data.seed);
+	}
+
+	void Replay::stopReplay() {
+		if (!replaying)
+			return;
+
+		replaying = false;
+		Time::setClock(std::function<double()>());
+		Input::stopReplay();
+	}
+
+	bool Replay::isReplaying() {
+		return replaying;
+	}
+
+	void Replay::update() {
+		if (!replaying)
+			return;
+
+		if (frame == data.getFrameAmount()) {
+			stopReplay();
+			return;
+		}
+
+		frame += 1;
+	}
+
+	size_t Replay::getFrame() {
+		return frame;
+	}
+
+	size_t Replay::getFrameAmount() {
+		return data.getFrameAmount();
+	}
+
+}
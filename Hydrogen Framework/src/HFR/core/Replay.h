@@ -0,0 +1,56 @@
+#ifndef HFR_REPLAY_HEADER_INCLUDE
+#define HFR_REPLAY_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_INPUT
+
+namespace HFR {
+
+	//everything a run of frames depends on besides the code, the input, the clock and the random seed
+	struct DLL_API ReplayData {
+		unsigned int seed = 0;
+		//fixed steps a second
+		double fixedRate = HFR_FIXED_RATE;
+		//the clock the frame before the first one, every frame after that has its own in the input recording
+		double startTime = 0;
+		InputRecording input;
+
+		size_t getFrameAmount() const;
+
+		bool save(const std::string& path) const;
+		bool load(const std::string& path);
+	};
+
+	//records a run and plays it back frame for frame, the replay drives Time with the recorded clock and Input with the recorded events,
+	//so the same scene goes through the same frames on every build and only how long they take changes
+	class DLL_API Replay {
+	private:
+		static ReplayData data;
+		static bool recording;
+		static bool replaying;
+		//frames started since the replay began, the clock reads the time of the one before it
+		static size_t frame;
+
+	public:
+		//seeds Random and starts the fixed steps over, the frames from the next update on get recorded
+		static void startRecording(const unsigned int& seed);
+		static void stopRecording();
+		static bool isRecording();
+		static const ReplayData& getData();
+
+		//sets the seed, fixed rate, clock and input back to how they were, the frames from the next update on play the recording
+		static void startReplay(const ReplayData& data);
+		static void stopReplay();
+		//stays true through the last recorded frame, the update after it puts the real clock back and ends it
+		static bool isReplaying();
+
+		//Engine::updateEngine does it at the start of every frame, before Time::update
+		static void update();
+		//how many recorded frames got started so far
+		static size_t getFrame();
+		static size_t getFrameAmount();
+	};
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 int main(int argc, char** argv) {
 	__security_init_cookie();
 #ifndef HFR_SCRIPT
+	HFR::Program::arguments = std::vector<std::string>(argv, argv + argc);
 	auto program = HFR::createProgram();
 
 	HFR::Engine::startEngine();
@@ -0,0 +1,284 @@
+#include "hfpch.h"
+#include HFR_COOKED_TEXTURE
+
+namespace HFR {
+
+	namespace {
+		void pad(std::ofstream& file, uint64_t& position, const uint64_t& alignment) {
+			while (position % alignment != 0) {
+				file.put(0);
+				position += 1;
+			}
+		}
+	}
+
+	CookedTexture::CookedTexture() {}
+
+	CookedTexture::CookedTexture(CookedTexture&& cooked) noexcept {
+		*this = std::move(cooked);
+	}
+
+	CookedTexture& CookedTexture::operator=(CookedTexture&& cooked) noexcept {
+		if (this != &cooked) {
+			file = std::move(cooked.file);
+			header = cooked.header;
+			levels = cooked.levels;
+
+			cooked.file = FileData();
+			cooked.header = {};
+			cooked.levels = nullptr;
+		}
+
+		return *this;
+	}
+
+	bool CookedTexture::open(const std::string& path) {
+		FileData data = VirtualFileSystem::read(path);
+
+		if (!data.isValid()) {
+			Debug::systemErr("Couldn't open cooked texture: {}", path);
+			return false;
+		}
+
+		if (!open(data)) {
+			Debug::systemErr("Cooked texture is corrupt or from a different version: {}", path);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CookedTexture::open(const FileData& data) {
+		close();
+
+		if (!data.isValid() || data.getSize() < sizeof(CookedTextureHeader))
+			return false;
+
+		const CookedTextureHeader* candidate = (const CookedTextureHeader*)data.getData();
+		const uint64_t fileSize = data.getSize();
+		const uint64_t tableEnd = sizeof(CookedTextureHeader) + (uint64_t)candidate->levelAmount * sizeof(CookedTextureLevel);
+
+		bool valid = std::memcmp(candidate->magic, "HTEX", 4) == 0 && candidate->version == HFR_COOKED_TEXTURE_VERSION &&
+			candidate->format <= (uint32_t)HFR_TEXTURE_FORMAT_BC7 && candidate->levelAmount > 0 && candidate->levelAmount <= 32 &&
+			candidate->width > 0 && candidate->height > 0 && tableEnd <= fileSize;
+
+		const CookedTextureLevel* table = (const CookedTextureLevel*)(data.getData() + sizeof(CookedTextureHeader));
+
+		//checking every level once here means uploads never have to
+		for (uint32_t i = 0; i < candidate->levelAmount && valid; ++i) {
+			const CookedTextureLevel& level = table[i];
+
+			valid = level.offset <= fileSize && level.size <= fileSize - level.offset &&
+				level.width > 0 && level.height > 0 &&
+				level.size == getImageSize((int)candidate->format, (int)level.width, (int)level.height);
+		}
+
+		if (!valid)
+			return false;
+
+		file = data;
+		header = *candidate;
+		levels = table;
+
+		return true;
+	}
+
+	bool CookedTexture::isOpen() const {
+		return levels != nullptr;
+	}
+
+	void CookedTexture::close() {
+		file = FileData();
+		header = {};
+		levels = nullptr;
+	}
+
+	int CookedTexture::getFormat() const {
+		return (int)header.format;
+	}
+
+	bool CookedTexture::isSRGB() const {
+		return (header.flags & HFR_COOKED_TEXTURE_SRGB) != 0;
+	}
+
+	bool CookedTexture::isCompressed() const {
+		return isOpen() && getBlockSize(getFormat()) != 0;
+	}
+
+	int CookedTexture::getWidth() const {
+		return (int)header.width;
+	}
+
+	int CookedTexture::getHeight() const {
+		return (int)header.height;
+	}
+
+	size_t CookedTexture::getLevelAmount() const {
+		return isOpen() ? header.levelAmount : 0;
+	}
+
+	int CookedTexture::getLevelWidth(const size_t& level) const {
+		return (int)levels[level].width;
+	}
+
+	int CookedTexture::getLevelHeight(const size_t& level) const {
+		return (int)levels[level].height;
+	}
+
+	const unsigned char* CookedTexture::getLevelData(const size_t& level) const {
+		return file.getData() + levels[level].offset;
+	}
+
+	size_t CookedTexture::getLevelSize(const size_t& level) const {
+		return (size_t)levels[level].size;
+	}
+
+	size_t CookedTexture::getDataSize() const {
+		return getDataSize(0);
+	}
+
+	size_t CookedTexture::getDataSize(const size_t& firstLevel) const {
+		size_t out = 0;
+
+		for (size_t i = firstLevel; i < getLevelAmount(); ++i)
+			out += getLevelSize(i);
+
+		return out;
+	}
+
+	size_t CookedTexture::getLevelForSize(const int& size) const {
+		for (size_t i = 0; i < getLevelAmount(); ++i) {
+			if (getLevelWidth(i) <= size && getLevelHeight(i) <= size)
+				return i;
+		}
+
+		return getLevelAmount() > 0 ? getLevelAmount() - 1 : 0;
+	}
+
+	int CookedTexture::getInternalFormat() const {
+		return getInternalFormat(getFormat(), isSRGB());
+	}
+
+	bool CookedTexture::save(const std::string& path, const std::vector<CompressedImage>& levels, const bool& srgb) {
+		if (levels.empty()) {
+			Debug::systemErr("Can't cook a texture without any levels: {}", path);
+			return false;
+		}
+
+		for (size_t i = 0; i < levels.size(); ++i) {
+			if (levels[i].format != levels[0].format || levels[i].data.size() != getImageSize(levels[i].format, levels[i].width, levels[i].height)) {
+				Debug::systemErr("Cooked texture levels don't match: {}", path);
+				return false;
+			}
+		}
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't create cooked texture: {}", path);
+			return false;
+		}
+
+		CookedTextureHeader header = {};
+		std::memcpy(header.magic, "HTEX", 4);
+		header.version = HFR_COOKED_TEXTURE_VERSION;
+		header.format = (uint32_t)levels[0].format;
+		header.flags = srgb ? HFR_COOKED_TEXTURE_SRGB : 0;
+		header.width = (uint32_t)levels[0].width;
+		header.height = (uint32_t)levels[0].height;
+		header.levelAmount = (uint32_t)levels.size();
+
+		file.write((const char*)&header, sizeof(header));
+		uint64_t position = sizeof(header) + levels.size() * sizeof(CookedTextureLevel);
+
+		//the table only depends on sizes so it can go out before the data
+		std::vector<CookedTextureLevel> table(levels.size());
+		uint64_t offset = position;
+
+		for (size_t i = 0; i < levels.size(); ++i) {
+			offset = (offset + HFR_COOKED_TEXTURE_ALIGNMENT - 1) / HFR_COOKED_TEXTURE_ALIGNMENT * HFR_COOKED_TEXTURE_ALIGNMENT;
+
+			table[i] = {};
+			table[i].offset = offset;
+			table[i].size = levels[i].data.size();
+			table[i].width = (uint32_t)levels[i].width;
+			table[i].height = (uint32_t)levels[i].height;
+
+			offset += table[i].size;
+		}
+
+		file.write((const char*)table.data(), (std::streamsize)(table.size() * sizeof(CookedTextureLevel)));
+
+		for (size_t i = 0; i < levels.size(); ++i) {
+			pad(file, position, HFR_COOKED_TEXTURE_ALIGNMENT);
+
+			file.write((const char*)levels[i].data.data(), (std::streamsize)levels[i].data.size());
+			position += levels[i].data.size();
+		}
+
+		if (!file.good()) {
+			Debug::systemErr("Couldn't write cooked texture: {}", path);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CookedTexture::isCookedPath(const std::string& path) {
+		return path.size() >= 5 && path.compare(path.size() - 5, 5, ".htex") == 0;
+	}
+
+	int CookedTexture::getBlockSize(const int& format) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1:
+			return 8;
+		case HFR_TEXTURE_FORMAT_BC3:
+		case HFR_TEXTURE_FORMAT_BC5:
+		case HFR_TEXTURE_FORMAT_BC7:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	size_t CookedTexture::getImageSize(const int& format, const int& width, const int& height) {
+		int blockSize = getBlockSize(format);
+
+		if (blockSize == 0)
+			return (size_t)width * height * 4;
+
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+	}
+
+	int CookedTexture::getInternalFormat(const int& format, const bool& srgb) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case HFR_TEXTURE_FORMAT_BC3:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case HFR_TEXTURE_FORMAT_BC5:
+			//two channel data (normal maps) is never srgb
+			return GL_COMPRESSED_RG_RGTC2;
+		case HFR_TEXTURE_FORMAT_BC7:
+			return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default:
+			return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+		}
+	}
+
+	std::string CookedTexture::getFormatName(const int& format) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1:
+			return "BC1";
+		case HFR_TEXTURE_FORMAT_BC3:
+			return "BC3";
+		case HFR_TEXTURE_FORMAT_BC5:
+			return "BC5";
+		case HFR_TEXTURE_FORMAT_BC7:
+			return "BC7";
+		default:
+			return "RGBA8";
+		}
+	}
+
+}
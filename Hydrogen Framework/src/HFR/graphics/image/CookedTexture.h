@@ -0,0 +1,94 @@
+#ifndef HFR_COOKED_TEXTURE_HEADER_INCLUDE
+#define HFR_COOKED_TEXTURE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VIRTUAL_FILE_SYSTEM
+
+namespace HFR {
+
+	//start of every .htex file, the level table comes right after it and the level data after that
+	struct DLL_API CookedTextureHeader {
+		char magic[4];
+		uint32_t version;
+		uint32_t format;
+		uint32_t flags;
+		uint32_t width;
+		uint32_t height;
+		uint32_t levelAmount;
+		uint32_t padding;
+	};
+
+	struct DLL_API CookedTextureLevel {
+		uint64_t offset;
+		uint64_t size;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	//one level as it comes out of TextureCompressor, data is rgba8 pixels or rows of 4x4 blocks depending on format
+	struct DLL_API CompressedImage {
+		int width = 0;
+		int height = 0;
+		int format = HFR_TEXTURE_FORMAT_RGBA8;
+		std::vector<unsigned char> data;
+	};
+
+	//a texture with every mip level already in the layout the gpu wants, the file is mapped once and levels get uploaded straight out of the mapping
+	class DLL_API CookedTexture {
+	private:
+		FileData file;
+		CookedTextureHeader header = {};
+		const CookedTextureLevel* levels = nullptr;
+
+	public:
+		CookedTexture();
+		CookedTexture(const CookedTexture& cooked) = default;
+		CookedTexture& operator=(const CookedTexture& cooked) = default;
+		//moves leave the source closed instead of pointing into a file it no longer holds
+		CookedTexture(CookedTexture&& cooked) noexcept;
+		CookedTexture& operator=(CookedTexture&& cooked) noexcept;
+
+		bool open(const std::string& path);
+		//same as open but with data that has already been read, the levels point into it
+		bool open(const FileData& data);
+		bool isOpen() const;
+		void close();
+
+		//HFR_TEXTURE_FORMAT_*
+		int getFormat() const;
+		bool isSRGB() const;
+		bool isCompressed() const;
+		int getWidth() const;
+		int getHeight() const;
+
+		size_t getLevelAmount() const;
+		int getLevelWidth(const size_t& level) const;
+		int getLevelHeight(const size_t& level) const;
+		const unsigned char* getLevelData(const size_t& level) const;
+		size_t getLevelSize(const size_t& level) const;
+		//every level together, what the gpu ends up holding
+		size_t getDataSize() const;
+		//levels from firstLevel down to 1x1
+		size_t getDataSize(const size_t& firstLevel) const;
+		//the biggest level that fits in size x size, the last level if none do
+		size_t getLevelForSize(const int& size) const;
+
+		//what glTexImage2D or glCompressedTexImage2D wants as the internal format
+		int getInternalFormat() const;
+
+		//levels[0] is the base level and every level has to have the same format
+		static bool save(const std::string& path, const std::vector<CompressedImage>& levels, const bool& srgb);
+
+		//anything ending in .htex
+		static bool isCookedPath(const std::string& path);
+		//bytes per 4x4 block, 0 for rgba8
+		static int getBlockSize(const int& format);
+		//bytes one level of this size takes, partial blocks at the edges count as whole ones
+		static size_t getImageSize(const int& format, const int& width, const int& height);
+		static int getInternalFormat(const int& format, const bool& srgb);
+		static std::string getFormatName(const int& format);
+	};
+
+}
+
+#endif
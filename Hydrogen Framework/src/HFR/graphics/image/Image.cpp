@@ -14,53 +14,86 @@ namespace HFR {
 		height = _height;
 		channels = _channels;
 
-		int allocation = width * height * channels;
+		size_t allocation = (size_t)width * height * channels;
 		data = new unsigned char[allocation];
 
 		if (_data != NULL)
 			std::memcpy(data, _data, allocation);
 	}
 
-	Image::Image(const Image& image) {
-		
-		width = 0;
-		height = 0;
-		channels = 0;
-		data = NULL;
+	Image::Image(const Image& image) : Image(image.clone()) {}
+
+	Image& Image::operator=(const Image& image) {
+		//cloning first keeps self assignment safe
+		if (this != &image)
+			*this = image.clone();
 
-		if (image.hasData()) {
+		return *this;
+	}
+
+	Image::Image(Image&& image) noexcept {
+		filepath = std::move(image.filepath);
+		width = image.width;
+		height = image.height;
+		channels = image.channels;
+		data = image.data;
+		loadedByStb = image.loadedByStb;
+
+		image.width = 0;
+		image.height = 0;
+		image.channels = 0;
+		image.data = NULL;
+		image.loadedByStb = false;
+	}
+
+	Image& Image::operator=(Image&& image) noexcept {
+		if (this != &image) {
+			release();
+
+			filepath = std::move(image.filepath);
 			width = image.width;
 			height = image.height;
 			channels = image.channels;
-			filepath = image.filepath;
-
-			int allocation = image.width * image.height * image.channels;
-			data = new unsigned char[allocation];
-			std::memcpy(data, image.data, allocation);
+			data = image.data;
+			loadedByStb = image.loadedByStb;
+
+			image.width = 0;
+			image.height = 0;
+			image.channels = 0;
+			image.data = NULL;
+			image.loadedByStb = false;
 		}
+
+		return *this;
 	}
 
-	Image& Image::operator=(const Image& image) {
-		if (data != NULL)
-			delete[] data;
-		data = NULL;
+	Image Image::clone() const {
+		Image out;
+		out.filepath = filepath;
 
-		if (image.hasData()) {
-			if (image.data != NULL) {
-				int allocation = image.width * image.height * image.channels;
-				data = new unsigned char[allocation];
-				width = image.width;
-				height = image.height;
-				channels = image.channels;
-				filepath = image.filepath;
+		if (hasData()) {
+			out.width = width;
+			out.height = height;
+			out.channels = channels;
 
-				if (this != &image && image.data != NULL)
-					std::memcpy(data, image.data, allocation);
-			}
+			size_t allocation = (size_t)width * height * channels;
+			out.data = new unsigned char[allocation];
+			std::memcpy(out.data, data, allocation);
+		}
+
+		return out;
+	}
 
+	void Image::release() {
+		if (data != NULL) {
+			if (loadedByStb)
+				stbi_image_free(data);
+			else
+				delete[] data;
 		}
 
-		return *this;
+		data = NULL;
+		loadedByStb = false;
 	}
 
 	Image::Image(const std::string& _filepath) {
@@ -70,20 +103,20 @@ namespace HFR {
 		data = NULL;
 		filepath = _filepath;
 
-		data = stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+		FileData file = VirtualFileSystem::read(filepath);
+
+		if (file.isValid())
+			data = stbi_load_from_memory(file.getData(), (int)file.getSize(), &width, &height, &channels, STBI_rgb_alpha);
 		channels = STBI_rgb_alpha;
+		loadedByStb = data != nullptr;
 		
 		if (data == nullptr) {
-			Debug::systemErr("Couldn't load image: " + filepath);
+			Debug::systemErr("Couldn't load image: {}", filepath);
 		}
 	}
 
 	Image::~Image() {
-		if (data != nullptr) {
-			delete[] data;
-		}
-
-		data = NULL;
+		release();
 	}
 
 	unsigned char* Image::getPixel(const size_t& x, const size_t& y) {
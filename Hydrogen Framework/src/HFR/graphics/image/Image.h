@@ -21,11 +21,18 @@ namespace HFR {
 
 		Image();
 		Image(const std::string& filepath);
+		//copies are deep, move images around instead and use clone() where a copy is actually wanted
 		Image& operator=(const Image& image);
 		Image(const Image& image);
+		Image& operator=(Image&& image) noexcept;
+		Image(Image&& image) noexcept;
 		Image(const int& width, const int& height, const int& channels, unsigned char* data);
 		~Image();
 
+		Image clone() const;
+		//frees the pixels with whatever allocated them
+		void release();
+
 		unsigned char* getPixel(const size_t& x, const size_t& y);
 
 		//TODO
@@ -33,6 +40,10 @@ namespace HFR {
 
 		//void generatePixelData();
 		bool hasData() const;
+
+	private:
+		//stb_image allocations have to go back through stbi_image_free, everything else is new[]
+		bool loadedByStb = false;
 	};
 
 }
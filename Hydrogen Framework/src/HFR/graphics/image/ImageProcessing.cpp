@@ -0,0 +1,1112 @@
+#include "hfpch.h"
+#include HFR_IMAGE_PROCESSING
+#include HFR_MATRIX_KERNELS
+
+namespace HFR {
+
+	namespace {
+
+		//linear back to srgb goes through a table with 14 bits of precision, a lot finer than the 8 bit output near black
+		const int linearTableSize = 16384;
+
+		struct ColorTables {
+			float toLinear[256];
+			//the same but as 14 bit integers, four of them still fit in 16 bits
+			unsigned short toLinearInteger[256];
+			unsigned char toSRGB[linearTableSize];
+
+			ColorTables() {
+				for (int i = 0; i < 256; ++i) {
+					float color = i / 255.0f;
+					toLinear[i] = color <= 0.04045f ? color / 12.92f : std::pow((color + 0.055f) / 1.055f, 2.4f);
+					toLinearInteger[i] = (unsigned short)std::nearbyint(toLinear[i] * (linearTableSize - 1));
+				}
+
+				for (int i = 0; i < linearTableSize; ++i) {
+					float linear = i / (float)(linearTableSize - 1);
+					float color = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+					toSRGB[i] = (unsigned char)std::nearbyint(min(max(color, 0.0f), 1.0f) * 255.0f);
+				}
+			}
+		};
+
+		const ColorTables& getColorTables() {
+			static ColorTables tables;
+			return tables;
+		}
+
+		inline unsigned char encodeSRGB(const ColorTables& tables, const float& linear) {
+			int index = (int)(min(max(linear, 0.0f), 1.0f) * (linearTableSize - 1) + 0.5f);
+			return tables.toSRGB[index];
+		}
+
+		//gray and rgb images are all color, the last channel of gray alpha and rgba images is alpha
+		inline int getColorChannels(const int& channels) {
+			return (channels == 2 || channels == 4) ? channels - 1 : channels;
+		}
+
+		//filters
+
+		float besselI0(const float& x) {
+			float sum = 1;
+			float term = 1;
+			float half = x * 0.5f;
+
+			for (int k = 1; k < 32; ++k) {
+				term *= (half / k) * (half / k);
+				sum += term;
+
+				if (term < sum * 1e-8f)
+					break;
+			}
+
+			return sum;
+		}
+
+		float sinc(float x) {
+			if (std::fabs(x) < 1e-6f)
+				return 1;
+
+			x *= 3.14159265f;
+			return std::sin(x) / x;
+		}
+
+		float getFilterRadius(const int& filter, const MipSettings& settings) {
+			switch (filter) {
+			case HFR_FILTER_TRIANGLE: return 1.0f;
+			case HFR_FILTER_KAISER: return settings.kaiserRadius;
+			default: return 0.5f;
+			}
+		}
+
+		//t is in destination texels
+		float getFilterWeight(const int& filter, const float& t, const MipSettings& settings) {
+			switch (filter) {
+			case HFR_FILTER_TRIANGLE:
+				return max(0.0f, 1.0f - std::fabs(t));
+			case HFR_FILTER_KAISER: {
+				if (std::fabs(t) >= settings.kaiserRadius)
+					return 0;
+
+				float r = t / settings.kaiserRadius;
+				return sinc(t) * besselI0(settings.kaiserAlpha * std::sqrt(1 - r * r)) / besselI0(settings.kaiserAlpha);
+			}
+			default:
+				return (t >= -0.5f && t < 0.5f) ? 1.0f : 0.0f;
+			}
+		}
+
+		//which source texels end up in every destination texel along one axis, and how much of each
+		struct FilterAxis {
+			int taps = 0;
+			//size * taps of them, already clamped to the edge
+			std::vector<int> indices;
+			std::vector<float> weights;
+		};
+
+		FilterAxis createFilterAxis(const int& sourceSize, const int& destinationSize, const int& filter, const MipSettings& settings) {
+			FilterAxis out;
+
+			float scale = (float)sourceSize / destinationSize;
+			//only widen the filter when shrinking, upscaling just interpolates
+			float filterScale = max(scale, 1.0f);
+			float support = getFilterRadius(filter, settings) * filterScale;
+
+			out.taps = (int)std::ceil(support * 2) + 1;
+			out.indices.resize((size_t)destinationSize * out.taps);
+			out.weights.resize((size_t)destinationSize * out.taps);
+
+			for (int x = 0; x < destinationSize; ++x) {
+				float center = (x + 0.5f) * scale;
+				int start = (int)std::floor(center - support);
+				float total = 0;
+
+				for (int k = 0; k < out.taps; ++k) {
+					int index = start + k;
+					float weight = getFilterWeight(filter, (index + 0.5f - center) / filterScale, settings);
+
+					out.indices[(size_t)x * out.taps + k] = min(max(index, 0), sourceSize - 1);
+					out.weights[(size_t)x * out.taps + k] = weight;
+					total += weight;
+				}
+
+				if (total != 0) {
+					for (int k = 0; k < out.taps; ++k)
+						out.weights[(size_t)x * out.taps + k] /= total;
+				}
+			}
+
+			return out;
+		}
+
+		//scalar row kernels
+
+		void loadRowScalar(const unsigned char* in, float* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				out[i] = in[i] * (1.0f / 255.0f);
+		}
+
+		void storeRowScalar(const float* in, unsigned char* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				out[i] = (unsigned char)std::nearbyint(min(max(in[i] * 255.0f, 0.0f), 255.0f));
+		}
+
+		void accumulateRowScalar(const float* in, const float& weight, float* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				out[i] += in[i] * weight;
+		}
+
+		void filterRowScalar(const float* in, const int* indices, const float* weights, const int& taps, float* out, const int& width) {
+			for (int x = 0; x < width; ++x) {
+				float r = 0, g = 0, b = 0, a = 0;
+
+				for (int k = 0; k < taps; ++k) {
+					const float* pixel = in + (size_t)indices[k] * 4;
+					float weight = weights[k];
+
+					r += pixel[0] * weight;
+					g += pixel[1] * weight;
+					b += pixel[2] * weight;
+					a += pixel[3] * weight;
+				}
+
+				out[0] = r;
+				out[1] = g;
+				out[2] = b;
+				out[3] = a;
+
+				out += 4;
+				indices += taps;
+				weights += taps;
+			}
+		}
+
+		//sse2 kernels
+
+		void downsampleBoxSSE2(const unsigned char* in, const int& width, const int& height, unsigned char* out) {
+			const size_t stride = (size_t)width * 4;
+			const int outWidth = width / 2;
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(2);
+
+			for (int y = 0; y < height / 2; ++y) {
+				const unsigned char* row0 = in + (size_t)y * 2 * stride;
+				const unsigned char* row1 = row0 + stride;
+				unsigned char* o = out + (size_t)y * outWidth * 4;
+
+				int x = 0;
+
+				//8 source pixels from both rows make 4 destination pixels
+				for (; x + 8 <= width; x += 8) {
+					__m128i sums[2];
+
+					for (int half = 0; half < 2; ++half) {
+						__m128i a = _mm_loadu_si128((const __m128i*)(row0 + (x + half * 4) * 4));
+						__m128i b = _mm_loadu_si128((const __m128i*)(row1 + (x + half * 4) * 4));
+
+						//(p0, p1) and (p2, p3) with both rows already added together
+						__m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+						__m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+						__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+						sums[half] = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+					}
+
+					_mm_storeu_si128((__m128i*)(o + x * 2), _mm_packus_epi16(sums[0], sums[1]));
+				}
+
+				for (; x < width; x += 2) {
+					for (int c = 0; c < 4; ++c) {
+						int index = x * 4 + c;
+						o[x * 2 + c] = (unsigned char)((row0[index] + row0[index + 4] + row1[index] + row1[index + 4] + 2) >> 2);
+					}
+				}
+			}
+		}
+
+		void premultiplyAlphaSSE2(unsigned char* pixels, const size_t& count) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(128);
+			//the alpha lanes get multiplied by 255 so alpha comes out the same
+			const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+			const __m128i alphaFill = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				__m128i pixel = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+				__m128i halves[2] = { _mm_unpacklo_epi8(pixel, zero), _mm_unpackhi_epi8(pixel, zero) };
+
+				for (int half = 0; half < 2; ++half) {
+					__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[half], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+					alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), alphaFill);
+
+					//x / 255 rounded, done as (x + (x >> 8)) >> 8 with the rounding already in x
+					__m128i product = _mm_add_epi16(_mm_mullo_epi16(halves[half], alpha), rounding);
+					halves[half] = _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+				}
+
+				_mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+			}
+
+			ImageProcessing::premultiplyAlphaScalar(pixels + i * 4, count - i);
+		}
+
+		void swizzleSSE2(unsigned char* pixels, const size_t& count, const int* order) {
+			const __m128i byteMask = _mm_set1_epi32(0xFF);
+			__m128i sourceShift[4];
+			__m128i destinationShift[4];
+
+			for (int c = 0; c < 4; ++c) {
+				sourceShift[c] = _mm_cvtsi32_si128(order[c] * 8);
+				destinationShift[c] = _mm_cvtsi32_si128(c * 8);
+			}
+
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				__m128i pixel = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+				__m128i out = _mm_setzero_si128();
+
+				for (int c = 0; c < 4; ++c)
+					out = _mm_or_si128(out, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(pixel, sourceShift[c]), byteMask), destinationShift[c]));
+
+				_mm_storeu_si128((__m128i*)(pixels + i * 4), out);
+			}
+
+			ImageProcessing::swizzleScalar(pixels + i * 4, count - i, order);
+		}
+
+		void renormalizeNormalsSSE2(unsigned char* pixels, const size_t& count) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128 toSigned = _mm_set1_ps(2.0f / 255.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 half = _mm_set1_ps(127.5f);
+			const __m128 epsilon = _mm_set1_ps(1e-12f);
+
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4) {
+				__m128i pixel = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+				__m128i low = _mm_unpacklo_epi8(pixel, zero);
+				__m128i high = _mm_unpackhi_epi8(pixel, zero);
+
+				__m128 x = _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero));
+				__m128 y = _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero));
+				__m128 z = _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero));
+				__m128 a = _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero));
+
+				//pixels to one channel per register
+				_MM_TRANSPOSE4_PS(x, y, z, a);
+
+				x = _mm_sub_ps(_mm_mul_ps(x, toSigned), one);
+				y = _mm_sub_ps(_mm_mul_ps(y, toSigned), one);
+				z = _mm_sub_ps(_mm_mul_ps(z, toSigned), one);
+
+				__m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				__m128 valid = _mm_cmpgt_ps(length, epsilon);
+				__m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(length));
+
+				x = _mm_and_ps(valid, _mm_mul_ps(x, inverse));
+				y = _mm_and_ps(valid, _mm_mul_ps(y, inverse));
+				z = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(z, inverse)), _mm_andnot_ps(valid, one));
+
+				x = _mm_add_ps(_mm_mul_ps(x, half), half);
+				y = _mm_add_ps(_mm_mul_ps(y, half), half);
+				z = _mm_add_ps(_mm_mul_ps(z, half), half);
+
+				_MM_TRANSPOSE4_PS(x, y, z, a);
+
+				__m128i out = _mm_packus_epi16(_mm_packs_epi32(_mm_cvtps_epi32(x), _mm_cvtps_epi32(y)), _mm_packs_epi32(_mm_cvtps_epi32(z), _mm_cvtps_epi32(a)));
+				_mm_storeu_si128((__m128i*)(pixels + i * 4), out);
+			}
+
+			ImageProcessing::renormalizeNormalsScalar(pixels + i * 4, count - i);
+		}
+
+		void loadRowSSE2(const unsigned char* in, float* out, const size_t& count) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				__m128i bytes = _mm_loadu_si128((const __m128i*)(in + i));
+				__m128i low = _mm_unpacklo_epi8(bytes, zero);
+				__m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+				_mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+				_mm_storeu_ps(out + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+				_mm_storeu_ps(out + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+			}
+
+			loadRowScalar(in + i, out + i, count - i);
+		}
+
+		void storeRowSSE2(const float* in, unsigned char* out, const size_t& count) {
+			const __m128 scale = _mm_set1_ps(255.0f);
+
+			size_t i = 0;
+
+			//the saturating packs do the clamping
+			for (; i + 16 <= count; i += 16) {
+				__m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+				__m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale));
+				__m128i c = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 8), scale));
+				__m128i d = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 12), scale));
+
+				_mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+			}
+
+			storeRowScalar(in + i, out + i, count - i);
+		}
+
+		void accumulateRowSSE2(const float* in, const float& weight, float* out, const size_t& count) {
+			const __m128 w = _mm_set1_ps(weight);
+
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), w)));
+				_mm_storeu_ps(out + i + 4, _mm_add_ps(_mm_loadu_ps(out + i + 4), _mm_mul_ps(_mm_loadu_ps(in + i + 4), w)));
+			}
+
+			accumulateRowScalar(in + i, weight, out + i, count - i);
+		}
+
+		void filterRowSSE2(const float* in, const int* indices, const float* weights, const int& taps, float* out, const int& width) {
+			for (int x = 0; x < width; ++x) {
+				__m128 sum = _mm_setzero_ps();
+
+				for (int k = 0; k < taps; ++k)
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(in + (size_t)indices[k] * 4), _mm_set1_ps(weights[k])));
+
+				_mm_storeu_ps(out, sum);
+
+				out += 4;
+				indices += taps;
+				weights += taps;
+			}
+		}
+
+		//avx2 kernels
+
+		void downsampleBoxAVX2(const unsigned char* in, const int& width, const int& height, unsigned char* out) {
+			const size_t stride = (size_t)width * 4;
+			const int outWidth = width / 2;
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i rounding = _mm256_set1_epi16(2);
+
+			for (int y = 0; y < height / 2; ++y) {
+				const unsigned char* row0 = in + (size_t)y * 2 * stride;
+				const unsigned char* row1 = row0 + stride;
+				unsigned char* o = out + (size_t)y * outWidth * 4;
+
+				int x = 0;
+
+				//same as the sse2 one but every 128 bit lane does its own 4 pixels, the permute puts the lanes back in order
+				for (; x + 16 <= width; x += 16) {
+					__m256i sums[2];
+
+					for (int half = 0; half < 2; ++half) {
+						__m256i a = _mm256_loadu_si256((const __m256i*)(row0 + (x + half * 8) * 4));
+						__m256i b = _mm256_loadu_si256((const __m256i*)(row1 + (x + half * 8) * 4));
+
+						__m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+						__m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+
+						__m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(low, high), _mm256_unpackhi_epi64(low, high));
+						sums[half] = _mm256_srli_epi16(_mm256_add_epi16(sum, rounding), 2);
+					}
+
+					__m256i packed = _mm256_packus_epi16(sums[0], sums[1]);
+					_mm256_storeu_si256((__m256i*)(o + x * 2), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+				}
+
+				for (; x < width; x += 2) {
+					for (int c = 0; c < 4; ++c) {
+						int index = x * 4 + c;
+						o[x * 2 + c] = (unsigned char)((row0[index] + row0[index + 4] + row1[index] + row1[index + 4] + 2) >> 2);
+					}
+				}
+			}
+		}
+
+		void premultiplyAlphaAVX2(unsigned char* pixels, const size_t& count) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i rounding = _mm256_set1_epi16(128);
+			const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+			const __m256i alphaFill = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256i pixel = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+				__m256i halves[2] = { _mm256_unpacklo_epi8(pixel, zero), _mm256_unpackhi_epi8(pixel, zero) };
+
+				for (int half = 0; half < 2; ++half) {
+					__m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(halves[half], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+					alpha = _mm256_or_si256(_mm256_andnot_si256(alphaLanes, alpha), alphaFill);
+
+					__m256i product = _mm256_add_epi16(_mm256_mullo_epi16(halves[half], alpha), rounding);
+					halves[half] = _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+				}
+
+				//unpack and pack both stay inside their lanes so the order comes back out right
+				_mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_packus_epi16(halves[0], halves[1]));
+			}
+
+			premultiplyAlphaSSE2(pixels + i * 4, count - i);
+		}
+
+		void swizzleAVX2(unsigned char* pixels, const size_t& count, const int* order) {
+			char shuffle[32];
+
+			for (int i = 0; i < 32; ++i)
+				shuffle[i] = (char)((i & 0xC) + order[i & 3]);
+
+			const __m256i mask = _mm256_loadu_si256((const __m256i*)shuffle);
+
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256i pixel = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+				_mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_shuffle_epi8(pixel, mask));
+			}
+
+			swizzleSSE2(pixels + i * 4, count - i, order);
+		}
+
+		//4x4 transpose inside both 128 bit lanes
+		inline void transposeLanes(__m256& a, __m256& b, __m256& c, __m256& d) {
+			__m256 t0 = _mm256_unpacklo_ps(a, b);
+			__m256 t1 = _mm256_unpacklo_ps(c, d);
+			__m256 t2 = _mm256_unpackhi_ps(a, b);
+			__m256 t3 = _mm256_unpackhi_ps(c, d);
+
+			a = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			b = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			c = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			d = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		void renormalizeNormalsAVX2(unsigned char* pixels, const size_t& count) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256 toSigned = _mm256_set1_ps(2.0f / 255.0f);
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 half = _mm256_set1_ps(127.5f);
+			const __m256 epsilon = _mm256_set1_ps(1e-12f);
+
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8) {
+				__m256i pixel = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+				__m256i low = _mm256_unpacklo_epi8(pixel, zero);
+				__m256i high = _mm256_unpackhi_epi8(pixel, zero);
+
+				//lane 0 holds pixels 0 to 3 and lane 1 pixels 4 to 7
+				__m256 x = _mm256_cvtepi32_ps(_mm256_unpacklo_epi16(low, zero));
+				__m256 y = _mm256_cvtepi32_ps(_mm256_unpackhi_epi16(low, zero));
+				__m256 z = _mm256_cvtepi32_ps(_mm256_unpacklo_epi16(high, zero));
+				__m256 a = _mm256_cvtepi32_ps(_mm256_unpackhi_epi16(high, zero));
+
+				transposeLanes(x, y, z, a);
+
+				x = _mm256_sub_ps(_mm256_mul_ps(x, toSigned), one);
+				y = _mm256_sub_ps(_mm256_mul_ps(y, toSigned), one);
+				z = _mm256_sub_ps(_mm256_mul_ps(z, toSigned), one);
+
+				__m256 length = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+				__m256 valid = _mm256_cmp_ps(length, epsilon, _CMP_GT_OQ);
+				__m256 inverse = _mm256_div_ps(one, _mm256_sqrt_ps(length));
+
+				x = _mm256_and_ps(valid, _mm256_mul_ps(x, inverse));
+				y = _mm256_and_ps(valid, _mm256_mul_ps(y, inverse));
+				z = _mm256_blendv_ps(one, _mm256_mul_ps(z, inverse), valid);
+
+				x = _mm256_add_ps(_mm256_mul_ps(x, half), half);
+				y = _mm256_add_ps(_mm256_mul_ps(y, half), half);
+				z = _mm256_add_ps(_mm256_mul_ps(z, half), half);
+
+				transposeLanes(x, y, z, a);
+
+				__m256i out = _mm256_packus_epi16(_mm256_packs_epi32(_mm256_cvtps_epi32(x), _mm256_cvtps_epi32(y)), _mm256_packs_epi32(_mm256_cvtps_epi32(z), _mm256_cvtps_epi32(a)));
+				_mm256_storeu_si256((__m256i*)(pixels + i * 4), out);
+			}
+
+			renormalizeNormalsSSE2(pixels + i * 4, count - i);
+		}
+
+		void loadRowAVX2(const unsigned char* in, float* out, const size_t& count) {
+			const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				__m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(in + i)));
+				__m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(in + i + 8)));
+
+				_mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(a), scale));
+				_mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), scale));
+			}
+
+			loadRowScalar(in + i, out + i, count - i);
+		}
+
+		void storeRowAVX2(const float* in, unsigned char* out, const size_t& count) {
+			const __m256 scale = _mm256_set1_ps(255.0f);
+
+			size_t i = 0;
+
+			for (; i + 32 <= count; i += 32) {
+				__m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale));
+				__m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale));
+				__m256i c = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 16), scale));
+				__m256i d = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(in + i + 24), scale));
+
+				//the packs interleave the lanes, the permute undoes it
+				__m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+				_mm256_storeu_si256((__m256i*)(out + i), _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+			}
+
+			storeRowSSE2(in + i, out + i, count - i);
+		}
+
+		void accumulateRowAVX2(const float* in, const float& weight, float* out, const size_t& count) {
+			const __m256 w = _mm256_set1_ps(weight);
+
+			size_t i = 0;
+
+			for (; i + 16 <= count; i += 16) {
+				_mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(in + i), w, _mm256_loadu_ps(out + i)));
+				_mm256_storeu_ps(out + i + 8, _mm256_fmadd_ps(_mm256_loadu_ps(in + i + 8), w, _mm256_loadu_ps(out + i + 8)));
+			}
+
+			accumulateRowScalar(in + i, weight, out + i, count - i);
+		}
+
+		void filterRowAVX2(const float* in, const int* indices, const float* weights, const int& taps, float* out, const int& width) {
+			int x = 0;
+
+			//two destination pixels at a time, one per lane
+			for (; x + 2 <= width; x += 2) {
+				const int* nextIndices = indices + taps;
+				const float* nextWeights = weights + taps;
+				__m256 sum = _mm256_setzero_ps();
+
+				for (int k = 0; k < taps; ++k) {
+					__m256 pixels = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + (size_t)indices[k] * 4)), _mm_loadu_ps(in + (size_t)nextIndices[k] * 4), 1);
+					__m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weights[k])), _mm_set1_ps(nextWeights[k]), 1);
+
+					sum = _mm256_fmadd_ps(pixels, w, sum);
+				}
+
+				_mm256_storeu_ps(out, sum);
+
+				out += 8;
+				indices += taps * 2;
+				weights += taps * 2;
+			}
+
+			filterRowSSE2(in, indices, weights, taps, out, width - x);
+		}
+
+		//the 2x2 box for srgb rgba8, table lookups all the way so it's the same for every instruction set
+		void downsampleBoxSRGB(const unsigned char* in, const int& width, const int& height, unsigned char* out) {
+			const ColorTables& tables = getColorTables();
+			const size_t stride = (size_t)width * 4;
+			const int outWidth = width / 2;
+
+			for (int y = 0; y < height / 2; ++y) {
+				const unsigned char* row0 = in + (size_t)y * 2 * stride;
+				const unsigned char* row1 = row0 + stride;
+				unsigned char* o = out + (size_t)y * outWidth * 4;
+
+				for (int x = 0; x < outWidth; ++x) {
+					int index = x * 8;
+
+					for (int c = 0; c < 3; ++c) {
+						unsigned int sum = tables.toLinearInteger[row0[index + c]] + tables.toLinearInteger[row0[index + c + 4]]
+							+ tables.toLinearInteger[row1[index + c]] + tables.toLinearInteger[row1[index + c + 4]];
+
+						o[x * 4 + c] = tables.toSRGB[(sum + 2) >> 2];
+					}
+
+					o[x * 4 + 3] = (unsigned char)((row0[index + 3] + row0[index + 7] + row1[index + 3] + row1[index + 7] + 2) >> 2);
+				}
+			}
+		}
+
+		//resampling
+
+		void decodeRow(const unsigned char* in, float* out, const int& width, const int& channels, const bool& srgb, void (*loadRow)(const unsigned char*, float*, const size_t&)) {
+			const size_t count = (size_t)width * channels;
+
+			if (!srgb) {
+				loadRow(in, out, count);
+				return;
+			}
+
+			const ColorTables& tables = getColorTables();
+			const int colorChannels = getColorChannels(channels);
+
+			for (size_t i = 0; i < count; i += channels) {
+				for (int c = 0; c < channels; ++c)
+					out[i + c] = c < colorChannels ? tables.toLinear[in[i + c]] : in[i + c] * (1.0f / 255.0f);
+			}
+		}
+
+		void encodeRow(const float* in, unsigned char* out, const int& width, const int& channels, const bool& srgb, void (*storeRow)(const float*, unsigned char*, const size_t&)) {
+			const size_t count = (size_t)width * channels;
+
+			if (!srgb) {
+				storeRow(in, out, count);
+				return;
+			}
+
+			const ColorTables& tables = getColorTables();
+			const int colorChannels = getColorChannels(channels);
+
+			for (size_t i = 0; i < count; i += channels) {
+				for (int c = 0; c < channels; ++c)
+					out[i + c] = c < colorChannels ? encodeSRGB(tables, in[i + c]) : (unsigned char)std::nearbyint(min(max(in[i + c] * 255.0f, 0.0f), 255.0f));
+			}
+		}
+
+		void filterRowGeneric(const float* in, const FilterAxis& axis, const int& width, const int& channels, float* out) {
+			for (int x = 0; x < width; ++x) {
+				float* pixel = out + (size_t)x * channels;
+
+				for (int c = 0; c < channels; ++c)
+					pixel[c] = 0;
+
+				for (int k = 0; k < axis.taps; ++k) {
+					const float* source = in + (size_t)axis.indices[(size_t)x * axis.taps + k] * channels;
+					float weight = axis.weights[(size_t)x * axis.taps + k];
+
+					for (int c = 0; c < channels; ++c)
+						pixel[c] += source[c] * weight;
+				}
+			}
+		}
+
+		//stands in for infinity in the distance transform, real infinity would turn into nan when two of them get subtracted
+		const float farAway = 1e20f;
+
+		//squared distance to the nearest zero along one line of the grid (felzenszwalb and huttenlocher), in place
+		//line, parabolas and bounds are scratch space for count, count and count + 1 values
+		void distanceTransform(float* grid, const int& count, const size_t& stride, float* line, int* parabolas, float* bounds) {
+			bool anyFinite = false;
+			bool allZero = true;
+
+			for (int i = 0; i < count; ++i) {
+				line[i] = grid[i * stride];
+
+				anyFinite |= line[i] < farAway;
+				allZero &= line[i] == 0.0f;
+			}
+
+			//lines with nothing to spread or nothing to spread into stay the way they are, most of the padding is like that
+			if (!anyFinite || allZero)
+				return;
+
+			int k = 0;
+			parabolas[0] = 0;
+			bounds[0] = -farAway;
+			bounds[1] = farAway;
+
+			//lower envelope of the parabolas rooted at every sample
+			for (int q = 1; q < count; ++q) {
+				float s;
+
+				while (true) {
+					int p = parabolas[k];
+					s = ((line[q] + (float)q * q) - (line[p] + (float)p * p)) / (2.0f * q - 2.0f * p);
+
+					if (s > bounds[k] || k == 0)
+						break;
+
+					k -= 1;
+				}
+
+				k += 1;
+				parabolas[k] = q;
+				bounds[k] = s;
+				bounds[k + 1] = farAway;
+			}
+
+			k = 0;
+
+			for (int q = 0; q < count; ++q) {
+				while (bounds[k + 1] < q)
+					k += 1;
+
+				float offset = (float)(q - parabolas[k]);
+				grid[q * stride] = offset * offset + line[parabolas[k]];
+			}
+		}
+
+		void distanceTransform(std::vector<float>& grid, const int& width, const int& height) {
+			const int longest = max(width, height);
+
+			std::vector<float> line(longest);
+			std::vector<int> parabolas(longest);
+			std::vector<float> bounds((size_t)longest + 1);
+
+			for (int x = 0; x < width; ++x)
+				distanceTransform(grid.data() + x, height, width, line.data(), parabolas.data(), bounds.data());
+
+			for (int y = 0; y < height; ++y)
+				distanceTransform(grid.data() + (size_t)y * width, width, 1, line.data(), parabolas.data(), bounds.data());
+		}
+
+	}
+
+	int ImageProcessing::instructionSet = HFR_SIMD_SSE2;
+
+	void (*ImageProcessing::downsampleBoxKernel)(const unsigned char*, const int&, const int&, unsigned char*) = downsampleBoxSSE2;
+	void (*ImageProcessing::premultiplyAlphaKernel)(unsigned char*, const size_t&) = premultiplyAlphaSSE2;
+	void (*ImageProcessing::swizzleKernel)(unsigned char*, const size_t&, const int*) = swizzleSSE2;
+	void (*ImageProcessing::renormalizeNormalsKernel)(unsigned char*, const size_t&) = renormalizeNormalsSSE2;
+	void (*ImageProcessing::loadRowKernel)(const unsigned char*, float*, const size_t&) = loadRowSSE2;
+	void (*ImageProcessing::storeRowKernel)(const float*, unsigned char*, const size_t&) = storeRowSSE2;
+	void (*ImageProcessing::accumulateRowKernel)(const float*, const float&, float*, const size_t&) = accumulateRowSSE2;
+	void (*ImageProcessing::filterRowKernel)(const float*, const int*, const float*, const int&, float*, const int&) = filterRowSSE2;
+
+	void ImageProcessing::init() {
+		setInstructionSet(MatrixKernels::getInstructionSet());
+		Debug::systemLog("Image processing is using: {}", MatrixKernels::getInstructionSetName(instructionSet));
+	}
+
+	void ImageProcessing::setInstructionSet(const int& set) {
+		//there's nothing here that avx-512 would do much better
+		instructionSet = min(min(set, MatrixKernels::detectInstructionSet()), HFR_SIMD_AVX2);
+
+		switch (instructionSet) {
+		case HFR_SIMD_SCALAR:
+			downsampleBoxKernel = downsampleBoxScalar;
+			premultiplyAlphaKernel = premultiplyAlphaScalar;
+			swizzleKernel = swizzleScalar;
+			renormalizeNormalsKernel = renormalizeNormalsScalar;
+			loadRowKernel = loadRowScalar;
+			storeRowKernel = storeRowScalar;
+			accumulateRowKernel = accumulateRowScalar;
+			filterRowKernel = filterRowScalar;
+			break;
+		case HFR_SIMD_AVX2:
+			downsampleBoxKernel = downsampleBoxAVX2;
+			premultiplyAlphaKernel = premultiplyAlphaAVX2;
+			swizzleKernel = swizzleAVX2;
+			renormalizeNormalsKernel = renormalizeNormalsAVX2;
+			loadRowKernel = loadRowAVX2;
+			storeRowKernel = storeRowAVX2;
+			accumulateRowKernel = accumulateRowAVX2;
+			filterRowKernel = filterRowAVX2;
+			break;
+		default:
+			instructionSet = HFR_SIMD_SSE2;
+			downsampleBoxKernel = downsampleBoxSSE2;
+			premultiplyAlphaKernel = premultiplyAlphaSSE2;
+			swizzleKernel = swizzleSSE2;
+			renormalizeNormalsKernel = renormalizeNormalsSSE2;
+			loadRowKernel = loadRowSSE2;
+			storeRowKernel = storeRowSSE2;
+			accumulateRowKernel = accumulateRowSSE2;
+			filterRowKernel = filterRowSSE2;
+			break;
+		}
+	}
+
+	int ImageProcessing::getInstructionSet() {
+		return instructionSet;
+	}
+
+	std::vector<Image> ImageProcessing::generateMipChain(const Image& image) {
+		return generateMipChain(image, MipSettings());
+	}
+
+	std::vector<Image> ImageProcessing::generateMipChain(const Image& image, const MipSettings& settings) {
+		std::vector<Image> out;
+
+		if (!image.hasData())
+			return out;
+
+		int levels = getMipLevelAmount(image.width, image.height) - 1;
+
+		if (settings.maxLevels > 0)
+			levels = min(levels, settings.maxLevels);
+
+		out.reserve(levels);
+
+		//every level comes from the one before it, which is how the gpu would have done it too
+		for (int i = 0; i < levels; ++i)
+			out.push_back(downsample(i == 0 ? image : out.back(), settings));
+
+		return out;
+	}
+
+	Image ImageProcessing::downsample(const Image& image, const MipSettings& settings) {
+		if (!image.hasData())
+			return Image();
+
+		int width = max(1, image.width / 2);
+		int height = max(1, image.height / 2);
+
+		//the common case gets to stay in integers the whole way
+		if (settings.filter == HFR_FILTER_BOX && image.channels == 4 && image.width % 2 == 0 && image.height % 2 == 0) {
+			Image out(width, height, 4, NULL);
+			out.filepath = image.filepath;
+
+			if (settings.srgb)
+				downsampleBoxSRGB(image.data, image.width, image.height, out.data);
+			else
+				downsampleBoxKernel(image.data, image.width, image.height, out.data);
+
+			if (settings.normalMap)
+				renormalizeNormals(out);
+
+			return out;
+		}
+
+		Image out = resample(image, width, height, settings);
+
+		if (settings.normalMap)
+			renormalizeNormals(out);
+
+		return out;
+	}
+
+	int ImageProcessing::getMipLevelAmount(const int& width, const int& height) {
+		int size = max(width, height);
+		int levels = 1;
+
+		while (size > 1) {
+			size /= 2;
+			levels += 1;
+		}
+
+		return levels;
+	}
+
+	Image ImageProcessing::resize(const Image& image, const int& width, const int& height, const int& filter, const bool& srgb) {
+		MipSettings settings;
+		settings.filter = filter;
+		settings.srgb = srgb;
+
+		return resample(image, width, height, settings);
+	}
+
+	Image ImageProcessing::resample(const Image& image, const int& width, const int& height, const MipSettings& settings) {
+		if (!image.hasData() || width <= 0 || height <= 0)
+			return Image();
+
+		const int channels = image.channels;
+		const bool srgb = settings.srgb;
+
+		FilterAxis horizontal = createFilterAxis(image.width, width, settings.filter, settings);
+		FilterAxis vertical = createFilterAxis(image.height, height, settings.filter, settings);
+
+		const size_t rowSize = (size_t)width * channels;
+		std::vector<float> decoded((size_t)image.width * channels);
+		std::vector<float> accumulator(rowSize);
+
+		//horizontally filtered source rows, neighbouring destination rows share most of their taps
+		const int cacheRows = vertical.taps + 1;
+		std::vector<float> cache(rowSize * cacheRows);
+		std::vector<int> cacheTags(cacheRows, -1);
+
+		Image out(width, height, channels, NULL);
+		out.filepath = image.filepath;
+
+		for (int y = 0; y < height; ++y) {
+			std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+
+			for (int k = 0; k < vertical.taps; ++k) {
+				float weight = vertical.weights[(size_t)y * vertical.taps + k];
+
+				if (weight == 0)
+					continue;
+
+				int row = vertical.indices[(size_t)y * vertical.taps + k];
+				int slot = row % cacheRows;
+				float* filtered = &cache[(size_t)slot * rowSize];
+
+				if (cacheTags[slot] != row) {
+					decodeRow(image.data + (size_t)row * image.width * channels, decoded.data(), image.width, channels, srgb, loadRowKernel);
+
+					if (channels == 4)
+						filterRowKernel(decoded.data(), horizontal.indices.data(), horizontal.weights.data(), horizontal.taps, filtered, width);
+					else
+						filterRowGeneric(decoded.data(), horizontal, width, channels, filtered);
+
+					cacheTags[slot] = row;
+				}
+
+				accumulateRowKernel(filtered, weight, accumulator.data(), rowSize);
+			}
+
+			encodeRow(accumulator.data(), out.data + (size_t)y * rowSize, width, channels, srgb, storeRowKernel);
+		}
+
+		return out;
+	}
+
+	void ImageProcessing::premultiplyAlpha(Image& image) {
+		if (!image.hasData() || image.channels != 4) {
+			Debug::systemErr("Couldn't premultiply alpha of: {}, because it isn't an rgba image", image.filepath);
+			return;
+		}
+
+		premultiplyAlphaKernel(image.data, (size_t)image.width * image.height);
+	}
+
+	void ImageProcessing::swizzle(Image& image, const int& r, const int& g, const int& b, const int& a) {
+		if (!image.hasData() || image.channels != 4) {
+			Debug::systemErr("Couldn't swizzle: {}, because it isn't an rgba image", image.filepath);
+			return;
+		}
+
+		const int order[4] = { r & 3, g & 3, b & 3, a & 3 };
+		swizzleKernel(image.data, (size_t)image.width * image.height, order);
+	}
+
+	void ImageProcessing::renormalizeNormals(Image& image) {
+		if (!image.hasData() || image.channels != 4) {
+			Debug::systemErr("Couldn't renormalize: {}, because it isn't an rgba image", image.filepath);
+			return;
+		}
+
+		renormalizeNormalsKernel(image.data, (size_t)image.width * image.height);
+	}
+
+	Image ImageProcessing::createDistanceField(const Image& image, const int& spread, const int& scale) {
+		if (!image.hasData() || image.channels != 1 || spread <= 0 || scale <= 0) {
+			Debug::systemErr("Couldn't make a distance field from: {}, it has to be a one channel image", image.filepath);
+			return Image();
+		}
+
+		const int outWidth = (image.width + scale - 1) / scale + spread * 2;
+		const int outHeight = (image.height + scale - 1) / scale + spread * 2;
+		const int width = outWidth * scale;
+		const int height = outHeight * scale;
+		const int padding = spread * scale;
+
+		//squared distances to the nearest inside and nearest outside sample, the padding is all outside
+		std::vector<float> toInside((size_t)width * height, farAway);
+		std::vector<float> toOutside((size_t)width * height, 0.0f);
+
+		for (int y = 0; y < image.height; ++y) {
+			const unsigned char* row = image.data + (size_t)y * image.width;
+			size_t start = (size_t)(y + padding) * width + padding;
+
+			for (int x = 0; x < image.width; ++x) {
+				if (row[x] >= 128) {
+					toInside[start + x] = 0.0f;
+					toOutside[start + x] = farAway;
+				}
+			}
+		}
+
+		distanceTransform(toInside, width, height);
+		distanceTransform(toOutside, width, height);
+
+		Image out = Image(outWidth, outHeight, 1, NULL);
+		out.filepath = image.filepath;
+
+		const float toTexels = 1.0f / ((float)scale * scale * scale);
+		const float toByte = 127.0f / spread;
+
+		for (int y = 0; y < outHeight; ++y) {
+			for (int x = 0; x < outWidth; ++x) {
+				float sum = 0.0f;
+
+				//the edge sits halfway between an inside and an outside sample, averaging a block of samples puts it back between them
+				for (int sy = 0; sy < scale; ++sy) {
+					size_t index = (size_t)(y * scale + sy) * width + (size_t)x * scale;
+
+					for (int sx = 0; sx < scale; ++sx) {
+						if (toInside[index + sx] > 0.0f)
+							sum += std::sqrt(toInside[index + sx]) - 0.5f;
+						else
+							sum -= std::sqrt(toOutside[index + sx]) - 0.5f;
+					}
+				}
+
+				//inside is bright and the edge is 128
+				float value = 128.5f - sum * toTexels * toByte;
+				out.data[(size_t)y * outWidth + x] = (unsigned char)min(max(value, 0.0f), 255.0f);
+			}
+		}
+
+		return out;
+	}
+
+	void ImageProcessing::downsampleBoxScalar(const unsigned char* in, const int& width, const int& height, unsigned char* out) {
+		const size_t stride = (size_t)width * 4;
+		const int outWidth = width / 2;
+
+		for (int y = 0; y < height / 2; ++y) {
+			const unsigned char* row0 = in + (size_t)y * 2 * stride;
+			const unsigned char* row1 = row0 + stride;
+			unsigned char* o = out + (size_t)y * outWidth * 4;
+
+			for (int x = 0; x < outWidth; ++x) {
+				for (int c = 0; c < 4; ++c) {
+					int index = x * 8 + c;
+					o[x * 4 + c] = (unsigned char)((row0[index] + row0[index + 4] + row1[index] + row1[index + 4] + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	void ImageProcessing::premultiplyAlphaScalar(unsigned char* pixels, const size_t& count) {
+		for (size_t i = 0; i < count; ++i) {
+			unsigned char* pixel = pixels + i * 4;
+
+			for (int c = 0; c < 3; ++c) {
+				unsigned int product = pixel[c] * pixel[3] + 128;
+				pixel[c] = (unsigned char)((product + (product >> 8)) >> 8);
+			}
+		}
+	}
+
+	void ImageProcessing::swizzleScalar(unsigned char* pixels, const size_t& count, const int* order) {
+		for (size_t i = 0; i < count; ++i) {
+			unsigned char* pixel = pixels + i * 4;
+			unsigned char source[4] = { pixel[0], pixel[1], pixel[2], pixel[3] };
+
+			for (int c = 0; c < 4; ++c)
+				pixel[c] = source[order[c]];
+		}
+	}
+
+	void ImageProcessing::renormalizeNormalsScalar(unsigned char* pixels, const size_t& count) {
+		for (size_t i = 0; i < count; ++i) {
+			unsigned char* pixel = pixels + i * 4;
+
+			float x = pixel[0] * (2.0f / 255.0f) - 1.0f;
+			float y = pixel[1] * (2.0f / 255.0f) - 1.0f;
+			float z = pixel[2] * (2.0f / 255.0f) - 1.0f;
+
+			float length = x * x + y * y + z * z;
+
+			if (length > 1e-12f) {
+				float inverse = 1.0f / std::sqrt(length);
+				x *= inverse;
+				y *= inverse;
+				z *= inverse;
+			}
+			else {
+				x = 0;
+				y = 0;
+				z = 1;
+			}
+
+			pixel[0] = (unsigned char)std::nearbyint(x * 127.5f + 127.5f);
+			pixel[1] = (unsigned char)std::nearbyint(y * 127.5f + 127.5f);
+			pixel[2] = (unsigned char)std::nearbyint(z * 127.5f + 127.5f);
+		}
+	}
+
+}
@@ -0,0 +1,82 @@
+#ifndef HFR_IMAGE_PROCESSING_HEADER_INCLUDE
+#define HFR_IMAGE_PROCESSING_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_IMAGE
+
+namespace HFR {
+
+	struct DLL_API MipSettings {
+		//HFR_FILTER_BOX, HFR_FILTER_TRIANGLE or HFR_FILTER_KAISER
+		int filter = HFR_FILTER_BOX;
+		//average the color channels in linear space, alpha always stays linear
+		bool srgb = false;
+		//renormalizes every level, for tangent space normal maps
+		bool normalMap = false;
+		//levels after the base one, 0 goes all the way down to 1x1
+		int maxLevels = 0;
+
+		//kaiser windowed sinc, radius is in destination texels
+		float kaiserAlpha = 4.0f;
+		float kaiserRadius = 3.0f;
+	};
+
+	//cpu side image work so mips can be made on the loader threads (or ahead of time) instead of by glGenerateMipmap at upload,
+	//every function works on 8 bit images and the simd kernels are picked the same way as MatrixKernels
+	class DLL_API ImageProcessing {
+	private:
+		static int instructionSet;
+
+		//rgba8 2x2 box average, width and height are the source size and have to be even
+		static void (*downsampleBoxKernel)(const unsigned char* in, const int& width, const int& height, unsigned char* out);
+		static void (*premultiplyAlphaKernel)(unsigned char* pixels, const size_t& count);
+		static void (*swizzleKernel)(unsigned char* pixels, const size_t& count, const int* order);
+		static void (*renormalizeNormalsKernel)(unsigned char* pixels, const size_t& count);
+
+		//row kernels for the separable resampler, counts are in floats
+		static void (*loadRowKernel)(const unsigned char* in, float* out, const size_t& count);
+		static void (*storeRowKernel)(const float* in, unsigned char* out, const size_t& count);
+		static void (*accumulateRowKernel)(const float* in, const float& weight, float* out, const size_t& count);
+		//horizontal filter pass over rgba pixels, every destination pixel has taps indices and weights
+		static void (*filterRowKernel)(const float* in, const int* indices, const float* weights, const int& taps, float* out, const int& width);
+
+		//separable resampler behind resize and the non box mip paths
+		static Image resample(const Image& image, const int& width, const int& height, const MipSettings& settings);
+
+	public:
+		//uses whatever MatrixKernels detected, avx-512 runs the avx2 kernels
+		static void init();
+		static void setInstructionSet(const int& set);
+		static int getInstructionSet();
+
+		//levels 1 and up, level 0 is the image itself
+		static std::vector<Image> generateMipChain(const Image& image);
+		static std::vector<Image> generateMipChain(const Image& image, const MipSettings& settings);
+		//the next mip level down (half size, rounded down, never below 1)
+		static Image downsample(const Image& image, const MipSettings& settings);
+		static int getMipLevelAmount(const int& width, const int& height);
+
+		//separable resample to any size, filter is HFR_FILTER_BOX, HFR_FILTER_TRIANGLE or HFR_FILTER_KAISER
+		static Image resize(const Image& image, const int& width, const int& height, const int& filter, const bool& srgb);
+
+		//these work in place on rgba8 images
+		static void premultiplyAlpha(Image& image);
+		//order[n] is the source channel of channel n, so (2, 1, 0, 3) turns bgra into rgba
+		static void swizzle(Image& image, const int& r, const int& g, const int& b, const int& a);
+		//treats rgb as a [-1, 1] vector and makes it unit length again, zero vectors become straight up (0, 0, 1)
+		static void renormalizeNormals(Image& image);
+
+		//signed distance field out of a one channel coverage image (anything 128 and up is inside), for text that scales without blurring
+		//out is 1 / scale the size with spread texels of padding on every side, 128 is the edge and every 127 / spread is a texel away from it
+		static Image createDistanceField(const Image& image, const int& spread, const int& scale);
+
+		//scalar reference versions, these are what the simd versions get checked against
+		static void downsampleBoxScalar(const unsigned char* in, const int& width, const int& height, unsigned char* out);
+		static void premultiplyAlphaScalar(unsigned char* pixels, const size_t& count);
+		static void swizzleScalar(unsigned char* pixels, const size_t& count, const int* order);
+		static void renormalizeNormalsScalar(unsigned char* pixels, const size_t& count);
+	};
+
+}
+
+#endif
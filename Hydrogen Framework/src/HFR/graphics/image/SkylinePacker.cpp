@@ -0,0 +1,153 @@
+#include "hfpch.h"
+#include HFR_SKYLINE_PACKER
+
+namespace HFR {
+
+	SkylinePacker::SkylinePacker() {}
+
+	SkylinePacker::SkylinePacker(const int& width, const int& height) {
+		reset(width, height);
+	}
+
+	void SkylinePacker::reset(const int& _width, const int& _height) {
+		width = _width;
+		height = _height;
+		usedArea = 0;
+
+		nodes.clear();
+		nodes.push_back({ 0, 0, width });
+	}
+
+	void SkylinePacker::grow(const int& _width, const int& _height) {
+		if (_width > width) {
+			nodes.push_back({ width, 0, _width - width });
+			width = _width;
+
+			mergeNodes();
+		}
+
+		height = max(height, _height);
+	}
+
+	bool SkylinePacker::shrink(const int& _height) {
+		if (_height < getUsedHeight())
+			return false;
+
+		height = min(height, _height);
+		return true;
+	}
+
+	int SkylinePacker::getFitHeight(const size_t& node, const Vec2i& size) const {
+		if (nodes[node].x + size.x > width)
+			return -1;
+
+		//the rectangle rests on the highest node under it
+		int y = 0;
+		int remaining = size.x;
+
+		for (size_t i = node; remaining > 0; ++i) {
+			y = max(y, nodes[i].y);
+
+			if (y + size.y > height)
+				return -1;
+
+			remaining -= nodes[i].width;
+		}
+
+		return y;
+	}
+
+	bool SkylinePacker::insert(const Vec2i& size, Vec2i& position) {
+		if (size.x <= 0 || size.y <= 0)
+			return false;
+
+		size_t bestNode = nodes.size();
+		int bestTop = INT_MAX;
+		int bestWidth = INT_MAX;
+
+		//lowest top wins, ties go to the narrowest node so wide gaps are left for wide rectangles
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			int y = getFitHeight(i, size);
+
+			if (y < 0)
+				continue;
+
+			if (y + size.y < bestTop || (y + size.y == bestTop && nodes[i].width < bestWidth)) {
+				bestNode = i;
+				bestTop = y + size.y;
+				bestWidth = nodes[i].width;
+			}
+		}
+
+		if (bestNode == nodes.size())
+			return false;
+
+		position = Vec2i(nodes[bestNode].x, bestTop - size.y);
+
+		Node node = { position.x, bestTop, size.x };
+		nodes.insert(nodes.begin() + bestNode, node);
+
+		//everything the new node covers gets cut off or removed
+		for (size_t i = bestNode + 1; i < nodes.size();) {
+			Node& next = nodes[i];
+			int overlap = node.x + node.width - next.x;
+
+			if (overlap <= 0)
+				break;
+
+			if (overlap >= next.width) {
+				nodes.erase(nodes.begin() + i);
+				continue;
+			}
+
+			next.x += overlap;
+			next.width -= overlap;
+			break;
+		}
+
+		mergeNodes();
+		usedArea += (size_t)size.x * size.y;
+
+		return true;
+	}
+
+	void SkylinePacker::mergeNodes() {
+		for (size_t i = 0; i + 1 < nodes.size();) {
+			if (nodes[i].y == nodes[i + 1].y) {
+				nodes[i].width += nodes[i + 1].width;
+				nodes.erase(nodes.begin() + i + 1);
+			}
+			else
+				++i;
+		}
+	}
+
+	int SkylinePacker::getWidth() const {
+		return width;
+	}
+
+	int SkylinePacker::getHeight() const {
+		return height;
+	}
+
+	int SkylinePacker::getUsedHeight() const {
+		int out = 0;
+
+		for (size_t i = 0; i < nodes.size(); ++i)
+			out = max(out, nodes[i].y);
+
+		return out;
+	}
+
+	size_t SkylinePacker::getUsedArea() const {
+		return usedArea;
+	}
+
+	float SkylinePacker::getOccupancy() const {
+		if (width <= 0 || height <= 0)
+			return 0.0f;
+
+		return (float)((double)usedArea / ((double)width * height));
+	}
+
+}
@@ -0,0 +1,54 @@
+#ifndef HFR_SKYLINE_PACKER_HEADER_INCLUDE
+#define HFR_SKYLINE_PACKER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VEC2
+
+namespace HFR {
+
+	//packs rectangles into a fixed size area by keeping track of the top edge of everything placed so far (the skyline),
+	//every rectangle goes wherever its top ends up lowest, rectangles can't be taken out again but the area can grow
+	class DLL_API SkylinePacker {
+	private:
+		//one flat piece of the skyline, x to x + width at height y
+		struct Node {
+			int x;
+			int y;
+			int width;
+		};
+
+		std::vector<Node> nodes;
+		int width = 0;
+		int height = 0;
+		size_t usedArea = 0;
+
+		//where the top of a rectangle would end up if its left edge sat on node, -1 when it doesn't fit there
+		int getFitHeight(const size_t& node, const Vec2i& size) const;
+		void mergeNodes();
+
+	public:
+		SkylinePacker();
+		SkylinePacker(const int& width, const int& height);
+
+		//throws away everything that was packed
+		void reset(const int& width, const int& height);
+		//keeps everything where it is and makes the area bigger, sizes smaller than the current ones are ignored
+		void grow(const int& width, const int& height);
+		//cuts the area down to height, false when something packed already reaches past it
+		bool shrink(const int& height);
+
+		//false when it doesn't fit anywhere, position is the top left corner otherwise
+		bool insert(const Vec2i& size, Vec2i& position);
+
+		int getWidth() const;
+		int getHeight() const;
+		//bottom of the lowest rectangle packed so far
+		int getUsedHeight() const;
+		size_t getUsedArea() const;
+		//used area over the whole area, 0 to 1
+		float getOccupancy() const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,420 @@
+#include "hfpch.h"
+#include HFR_TEXTURE_ATLAS
+#include HFR_JOB_SYSTEM
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		//rgba of one pixel whatever the channel count is
+		void getPixel(const Image& image, const int& x, const int& y, unsigned char* out) {
+			const unsigned char* pixel = image.data + ((size_t)y * image.width + x) * image.channels;
+
+			switch (image.channels) {
+			case 1:
+				out[0] = out[1] = out[2] = pixel[0];
+				out[3] = 255;
+				break;
+			case 2:
+				out[0] = out[1] = out[2] = pixel[0];
+				out[3] = pixel[1];
+				break;
+			case 3:
+				out[0] = pixel[0];
+				out[1] = pixel[1];
+				out[2] = pixel[2];
+				out[3] = 255;
+				break;
+			default:
+				std::memcpy(out, pixel, 4);
+				break;
+			}
+		}
+
+		std::string getPagePath(const std::string& path, const size_t& page) {
+			return path + "_" + std::to_string(page) + ".htex";
+		}
+
+		Vec2i getPageSize(const Texture& texture) {
+			if (texture.cooked.isOpen())
+				return Vec2i(texture.cooked.getWidth(), texture.cooked.getHeight());
+
+			return Vec2i(texture.image.width, texture.image.height);
+		}
+
+		void setTextureCoordinates(AtlasRegion& region, const Vec2i& pageSize) {
+			region.textureOffset = Vec2f((float)region.position.x / pageSize.x, (float)region.position.y / pageSize.y);
+			region.textureSize = Vec2f((float)region.size.x / pageSize.x, (float)region.size.y / pageSize.y);
+		}
+
+		void setPageSampling(Texture& texture) {
+			texture.filterMode = Vec2i(GL_LINEAR);
+			texture.wrapMode = Vec2i(GL_CLAMP_TO_EDGE);
+			texture.generateMipmap = false;
+		}
+	}
+
+	TextureAtlas::TextureAtlas(const int& _pageSize, const int& _padding) {
+		pageSize = _pageSize;
+		padding = _padding;
+	}
+
+	TextureAtlas::Page& TextureAtlas::addPage() {
+		std::unique_ptr<Page> page(new Page());
+
+		page->packer.reset(pageSize, pageSize);
+
+		page->texture.image = Image(pageSize, pageSize, 4, NULL);
+		std::memset(page->texture.image.data, 0, (size_t)pageSize * pageSize * 4);
+		setPageSampling(page->texture);
+
+		pages.push_back(std::move(page));
+		return *pages.back();
+	}
+
+	void TextureAtlas::writeImage(Page& page, const AtlasRegion& region, const Image& image) {
+		const Vec2i corner = Vec2i(region.position.x - padding, region.position.y - padding);
+		const Vec2i paddedSize = Vec2i(region.size.x + padding * 2, region.size.y + padding * 2);
+
+		std::vector<unsigned char> pixels((size_t)paddedSize.x * paddedSize.y * 4);
+
+		//the padding repeats whichever edge pixel is closest
+		for (int y = 0; y < paddedSize.y; ++y) {
+			const int sourceY = min(max(y - padding, 0), image.height - 1);
+			unsigned char* row = pixels.data() + (size_t)y * paddedSize.x * 4;
+
+			if (image.channels == 4) {
+				std::memcpy(row + (size_t)padding * 4, image.data + (size_t)sourceY * image.width * 4, (size_t)image.width * 4);
+
+				for (int x = 0; x < padding; ++x) {
+					std::memcpy(row + (size_t)x * 4, row + (size_t)padding * 4, 4);
+					std::memcpy(row + (size_t)(padding + image.width + x) * 4, row + (size_t)(padding + image.width - 1) * 4, 4);
+				}
+			}
+			else {
+				for (int x = 0; x < paddedSize.x; ++x)
+					getPixel(image, min(max(x - padding, 0), image.width - 1), sourceY, row + (size_t)x * 4);
+			}
+		}
+
+		Image& atlas = page.texture.image;
+
+		for (int y = 0; y < paddedSize.y; ++y) {
+			std::memcpy(atlas.data + ((size_t)(corner.y + y) * atlas.width + corner.x) * 4,
+				pixels.data() + (size_t)y * paddedSize.x * 4, (size_t)paddedSize.x * 4);
+		}
+
+		//otherwise it goes up with the rest of the page
+		if (page.texture.isCreated && !page.needsUpload)
+			page.texture.setSubImage(0, corner, paddedSize, pixels.data());
+	}
+
+	void TextureAtlas::trimLastPage() {
+		if (pages.empty())
+			return;
+
+		Page& page = *pages.back();
+		Image& atlas = page.texture.image;
+
+		if (page.texture.isCreated || !atlas.hasData())
+			return;
+
+		int height = 1;
+
+		while (height < page.packer.getUsedHeight())
+			height *= 2;
+
+		if (height >= atlas.height || !page.packer.shrink(height))
+			return;
+
+		//rows come first so the top of the page is a copy as is
+		Image trimmed = Image(atlas.width, height, 4, atlas.data);
+		page.texture.image = std::move(trimmed);
+
+		const int pageIndex = (int)pages.size() - 1;
+
+		for (auto& region : regions) {
+			if (region.second.page == pageIndex)
+				setTextureCoordinates(region.second, getPageSize(page.texture));
+		}
+	}
+
+	bool TextureAtlas::insert(const std::string& name, const Image& image) {
+		if (!image.hasData()) {
+			Debug::systemErr("Can't put an empty image in a texture atlas: {}", name);
+			return false;
+		}
+
+		const Vec2i packSize = Vec2i(image.width + padding * 2, image.height + padding * 2);
+
+		if (packSize.x > pageSize || packSize.y > pageSize) {
+			Debug::systemErr("Image is too big for a {} atlas page: {}", pageSize, name);
+			return false;
+		}
+
+		auto found = regions.find(name);
+
+		if (found != regions.end()) {
+			AtlasRegion& region = found->second;
+			Page& page = *pages[region.page];
+
+			if (region.size.x == image.width && region.size.y == image.height && page.texture.image.hasData()) {
+				writeImage(page, region, image);
+				return true;
+			}
+
+			//the old spot stays taken until the atlas gets built again
+			imageArea -= (size_t)region.size.x * region.size.y;
+			regions.erase(found);
+		}
+
+		size_t pageIndex = 0;
+		Vec2i position;
+
+		//first page with room, so early pages keep filling up with small images after big ones stop fitting
+		while (pageIndex < pages.size() && !pages[pageIndex]->packer.insert(packSize, position))
+			++pageIndex;
+
+		if (pageIndex == pages.size())
+			addPage().packer.insert(packSize, position);
+
+		Page& page = *pages[pageIndex];
+
+		AtlasRegion region;
+		region.page = (int)pageIndex;
+		region.position = Vec2i(position.x + padding, position.y + padding);
+		region.size = Vec2i(image.width, image.height);
+		setTextureCoordinates(region, getPageSize(page.texture));
+
+		writeImage(page, region, image);
+
+		regions[name] = region;
+		imageArea += (size_t)image.width * image.height;
+
+		return true;
+	}
+
+	bool TextureAtlas::insert(const std::string& path) {
+		Image image(path);
+		return image.hasData() && insert(path, image);
+	}
+
+	size_t TextureAtlas::build(const std::vector<std::string>& names, const std::vector<const Image*>& images) {
+		ProfileMethod("Texture atlas build");
+
+		if (names.size() != images.size()) {
+			Debug::systemErr("Texture atlas build needs a name for every image");
+			return 0;
+		}
+
+		std::vector<size_t> order;
+		order.reserve(images.size());
+
+		for (size_t i = 0; i < images.size(); ++i) {
+			if (images[i] != nullptr && images[i]->hasData())
+				order.push_back(i);
+		}
+
+		//tallest first keeps the skyline flat, wide first among the same height
+		std::sort(order.begin(), order.end(), [&images](const size_t& a, const size_t& b) {
+			if (images[a]->height != images[b]->height)
+				return images[a]->height > images[b]->height;
+
+			return images[a]->width > images[b]->width;
+		});
+
+		size_t inserted = 0;
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			if (insert(names[order[i]], *images[order[i]]))
+				inserted += 1;
+		}
+
+		trimLastPage();
+
+		Debug::systemSuccess("Packed {} images into {} atlas pages ({}% used)", inserted, pages.size(), (int)(getOccupancy() * 100));
+
+		return inserted;
+	}
+
+	size_t TextureAtlas::build(const std::vector<std::string>& paths) {
+		std::vector<Image> images(paths.size());
+
+		//decoding is most of the time here
+		JobSystem::parallelFor(paths.size(), 8, [&images, &paths](const size_t& begin, const size_t& end) {
+			for (size_t i = begin; i < end; ++i)
+				images[i] = Image(paths[i]);
+		});
+
+		std::vector<const Image*> pointers(images.size());
+
+		for (size_t i = 0; i < images.size(); ++i)
+			pointers[i] = &images[i];
+
+		return build(paths, pointers);
+	}
+
+	bool TextureAtlas::save(const std::string& path, const CompressionSettings& settings) const {
+		ProfileMethod("Texture atlas save");
+
+		std::string manifest = std::to_string(pages.size()) + " " + std::to_string(padding) + "\n";
+
+		for (size_t i = 0; i < pages.size(); ++i) {
+			if (!pages[i]->texture.image.hasData()) {
+				Debug::systemErr("Atlas page {} was loaded cooked and can't be cooked again: {}", i, path);
+				return false;
+			}
+
+			if (!TextureCompressor::cook(pages[i]->texture.image, getPagePath(path, i), settings))
+				return false;
+		}
+
+		//page, position, size and then the name, which gets the rest of the line so it can have spaces in it
+		for (auto& region : regions) {
+			manifest += std::to_string(region.second.page) + " " + std::to_string(region.second.position.x) + " " + std::to_string(region.second.position.y) + " " +
+				std::to_string(region.second.size.x) + " " + std::to_string(region.second.size.y) + " " + region.first + "\n";
+		}
+
+		Util::writeAsString(manifest, path, HFR_NORMAL_WRITE);
+
+		return true;
+	}
+
+	bool TextureAtlas::load(const std::string& path) {
+		ProfileMethod("Texture atlas load");
+
+		FileData file = VirtualFileSystem::read(path);
+
+		if (!file.isValid()) {
+			Debug::systemErr("Couldn't open texture atlas: {}", path);
+			return false;
+		}
+
+		std::istringstream stream(file.toString());
+
+		size_t pageAmount = 0;
+		int filePadding = 0;
+
+		if (!(stream >> pageAmount >> filePadding)) {
+			Debug::systemErr("Texture atlas is corrupt: {}", path);
+			return false;
+		}
+
+		clear();
+		padding = filePadding;
+
+		for (size_t i = 0; i < pageAmount; ++i) {
+			CookedTexture cooked;
+
+			if (!cooked.open(getPagePath(path, i))) {
+				clear();
+				return false;
+			}
+
+			std::unique_ptr<Page> page(new Page());
+
+			//no cpu copy to pack into, new images go on new pages
+			page->packer.reset(0, 0);
+			page->texture = Texture(cooked);
+			setPageSampling(page->texture);
+
+			pages.push_back(std::move(page));
+		}
+
+		AtlasRegion region;
+
+		while (stream >> region.page >> region.position.x >> region.position.y >> region.size.x >> region.size.y) {
+			std::string name;
+			std::getline(stream, name);
+
+			if (!name.empty() && name[0] == ' ')
+				name.erase(0, 1);
+
+			if (region.page < 0 || region.page >= (int)pages.size()) {
+				Debug::systemErr("Texture atlas region is on a page that doesn't exist: {}", name);
+				continue;
+			}
+
+			setTextureCoordinates(region, getPageSize(pages[region.page]->texture));
+
+			regions[name] = region;
+			imageArea += (size_t)region.size.x * region.size.y;
+		}
+
+		return true;
+	}
+
+	void TextureAtlas::clear() {
+		pages.clear();
+		regions.clear();
+		imageArea = 0;
+	}
+
+	bool TextureAtlas::contains(const std::string& name) const {
+		return regions.find(name) != regions.end();
+	}
+
+	const AtlasRegion* TextureAtlas::getRegion(const std::string& name) const {
+		auto found = regions.find(name);
+		return found != regions.end() ? &found->second : nullptr;
+	}
+
+	void TextureAtlas::createTextures() {
+		for (size_t i = 0; i < pages.size(); ++i)
+			getTextureID((int)i);
+	}
+
+	unsigned int TextureAtlas::getTextureID(const int& page) {
+		if (page < 0 || page >= (int)pages.size())
+			return 0;
+
+		Page& atlasPage = *pages[page];
+
+		if (!atlasPage.texture.isCreated || atlasPage.needsUpload) {
+			atlasPage.texture.destroy();
+			atlasPage.texture.create();
+
+			atlasPage.needsUpload = false;
+		}
+
+		return atlasPage.texture.textureID;
+	}
+
+	const Texture& TextureAtlas::getTexture(const int& page) const {
+		return pages[page]->texture;
+	}
+
+	size_t TextureAtlas::getPageAmount() const {
+		return pages.size();
+	}
+
+	size_t TextureAtlas::getRegionAmount() const {
+		return regions.size();
+	}
+
+	float TextureAtlas::getOccupancy() const {
+		double area = 0;
+
+		for (size_t i = 0; i < pages.size(); ++i) {
+			Vec2i size = getPageSize(pages[i]->texture);
+			area += (double)size.x * size.y;
+		}
+
+		if (area <= 0)
+			return 0.0f;
+
+		return (float)(imageArea / area);
+	}
+
+	size_t TextureAtlas::getMemoryUsage() const {
+		size_t out = 0;
+
+		for (size_t i = 0; i < pages.size(); ++i) {
+			const Texture& texture = pages[i]->texture;
+			out += texture.cooked.isOpen() ? texture.cooked.getDataSize() : (size_t)texture.image.width * texture.image.height * 4;
+		}
+
+		return out;
+	}
+
+}
@@ -0,0 +1,92 @@
+#ifndef HFR_TEXTURE_ATLAS_HEADER_INCLUDE
+#define HFR_TEXTURE_ATLAS_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_TEXTURE
+#include HFR_SKYLINE_PACKER
+#include HFR_TEXTURE_COMPRESSOR
+
+namespace HFR {
+
+	//where one image ended up in an atlas
+	struct DLL_API AtlasRegion {
+		int page = -1;
+		//top left and size in page texels, the padding around it not included
+		Vec2i position;
+		Vec2i size;
+		//the same in 0 - 1 texture coordinates from the top left, what GuiQuad::textureOffset and textureSize take
+		Vec2f textureOffset;
+		Vec2f textureSize;
+	};
+
+	//packs lots of small images into a few big rgba pages so everything drawn out of the same page shares one texture and batches together
+	//every image gets padding texels around it filled with its own edge pixels, so filtering and block compression never pull in its neighbours
+	//inserting fills whatever room the pages have left before starting a new one, nothing that's packed ever moves so regions stay valid for good
+	class DLL_API TextureAtlas {
+	private:
+		struct Page {
+			SkylinePacker packer;
+			//texture.image is the cpu copy, pages that were loaded cooked don't have one and count as full
+			Texture texture;
+			//set when the page has to go up as a whole, otherwise new images get uploaded on their own
+			bool needsUpload = true;
+		};
+
+		//pages are held by pointer so their textures don't move around when more get added
+		std::vector<std::unique_ptr<Page>> pages;
+		std::unordered_map<std::string, AtlasRegion> regions;
+		//area of every image in it, padding not counted
+		size_t imageArea = 0;
+
+		Page& addPage();
+		//cuts the last page down to the smallest power of two height that holds everything in it, only before it's on the gpu so no texture coordinates are in use yet
+		void trimLastPage();
+		//copies the image and its extruded edges into the page, and up to the gpu too when the page is already there
+		void writeImage(Page& page, const AtlasRegion& region, const Image& image);
+
+	public:
+		int pageSize;
+		int padding;
+
+		TextureAtlas(const int& pageSize = HFR_ATLAS_PAGE_SIZE, const int& padding = HFR_ATLAS_PADDING);
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		//a name that's already in the atlas gets its pixels replaced where they are when the size is the same, and packed somewhere else when it isn't
+		//false when the image is empty or too big for a page
+		bool insert(const std::string& name, const Image& image);
+		//loads the image and uses the path as the name
+		bool insert(const std::string& path);
+
+		//the offline way, everything gets packed tallest first which fills the pages a lot tighter than inserting one at a time, and the last page gets trimmed
+		//returns how many made it in
+		size_t build(const std::vector<std::string>& names, const std::vector<const Image*>& images);
+		size_t build(const std::vector<std::string>& paths);
+
+		//every page gets cooked next to path (path_0.htex, path_1.htex, ...) and path gets the regions, load gets it all back without the source images
+		//gui atlases want settings.generateMipmap off, smaller levels blur images into each other once they get past the padding
+		bool save(const std::string& path, const CompressionSettings& settings) const;
+		bool load(const std::string& path);
+		void clear();
+
+		bool contains(const std::string& name) const;
+		//nullptr when it isn't in the atlas
+		const AtlasRegion* getRegion(const std::string& name) const;
+
+		//uploads the pages that aren't on the gpu yet, main thread only
+		void createTextures();
+		//creates the page first if it isn't on the gpu yet, 0 for a page that doesn't exist
+		unsigned int getTextureID(const int& page);
+		const Texture& getTexture(const int& page) const;
+
+		size_t getPageAmount() const;
+		size_t getRegionAmount() const;
+		//image area (padding not counted) over the area of every page, 0 to 1
+		float getOccupancy() const;
+		//bytes of every page on the gpu
+		size_t getMemoryUsage() const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,1085 @@
+#include "hfpch.h"
+#include HFR_TEXTURE_COMPRESSOR
+
+namespace HFR {
+
+	namespace {
+		//least squares refinement passes per quality level
+		const int REFINE_ITERATIONS[3] = { 0, 2, 6 };
+
+		//bc7 4 bit index weights out of 64, symmetric so swapping endpoints is just 15 - index
+		const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		//closest bc7 index for every weight, so indices can come from projecting onto the endpoint line
+		struct WeightTable {
+			int index[65];
+
+			WeightTable() {
+				for (int weight = 0; weight <= 64; ++weight) {
+					int best = 0;
+
+					for (int i = 1; i < 16; ++i) {
+						if (abs(BC7_WEIGHTS[i] - weight) < abs(BC7_WEIGHTS[best] - weight))
+							best = i;
+					}
+
+					index[weight] = best;
+				}
+			}
+		};
+
+		const WeightTable weightTable;
+
+		inline int clampInt(const int& value, const int& low, const int& high) {
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		inline float clampFloat(const float& value, const float& low, const float& high) {
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		//rgba8 no matter how many channels the image has, grey and grey alpha get spread over rgb the same way stb does
+		inline void readTexel(const Image& image, const int& x, const int& y, unsigned char* out) {
+			const unsigned char* texel = image.data + ((size_t)y * image.width + x) * image.channels;
+
+			switch (image.channels) {
+			case 1:
+				out[0] = out[1] = out[2] = texel[0];
+				out[3] = 255;
+				break;
+			case 2:
+				out[0] = out[1] = out[2] = texel[0];
+				out[3] = texel[1];
+				break;
+			case 3:
+				out[0] = texel[0];
+				out[1] = texel[1];
+				out[2] = texel[2];
+				out[3] = 255;
+				break;
+			default:
+				std::memcpy(out, texel, 4);
+				break;
+			}
+		}
+
+		//edge blocks repeat the last row and column, that way the padding never pulls the endpoints away from the real texels
+		void readBlock(const Image& image, const int& blockX, const int& blockY, unsigned char* out) {
+			for (int y = 0; y < 4; ++y) {
+				for (int x = 0; x < 4; ++x)
+					readTexel(image, min(blockX * 4 + x, image.width - 1), min(blockY * 4 + y, image.height - 1), out + (y * 4 + x) * 4);
+			}
+		}
+
+		struct BitWriter {
+			unsigned char* out;
+			int position = 0;
+
+			BitWriter(unsigned char* out) : out(out) {}
+
+			void write(const uint32_t& value, const int& bits) {
+				for (int i = 0; i < bits; ++i, ++position) {
+					if ((value >> i) & 1)
+						out[position >> 3] |= (unsigned char)(1 << (position & 7));
+				}
+			}
+		};
+
+		struct BitReader {
+			const unsigned char* in;
+			int position = 0;
+
+			BitReader(const unsigned char* in) : in(in) {}
+
+			uint32_t read(const int& bits) {
+				uint32_t out = 0;
+
+				for (int i = 0; i < bits; ++i, ++position)
+					out |= (uint32_t)((in[position >> 3] >> (position & 7)) & 1) << i;
+
+				return out;
+			}
+		};
+
+		//principal axis through power iteration, plenty for endpoint fitting and a lot cheaper than a proper eigen solver
+		void getPrincipalAxis(const float* points, const int& count, const int& channels, float* mean, float* axis) {
+			float covariance[4][4] = {};
+
+			for (int c = 0; c < channels; ++c) {
+				mean[c] = 0.0f;
+
+				for (int i = 0; i < count; ++i)
+					mean[c] += points[i * channels + c];
+
+				mean[c] /= (float)count;
+			}
+
+			for (int i = 0; i < count; ++i) {
+				for (int a = 0; a < channels; ++a) {
+					for (int b = a; b < channels; ++b)
+						covariance[a][b] += (points[i * channels + a] - mean[a]) * (points[i * channels + b] - mean[b]);
+				}
+			}
+
+			int largest = 0;
+
+			for (int a = 0; a < channels; ++a) {
+				for (int b = 0; b < a; ++b)
+					covariance[a][b] = covariance[b][a];
+
+				if (covariance[a][a] > covariance[largest][largest])
+					largest = a;
+			}
+
+			//starting from the row of the channel that varies the most avoids starting orthogonal to the answer
+			for (int c = 0; c < channels; ++c)
+				axis[c] = covariance[largest][c];
+
+			for (int iteration = 0; iteration < 8; ++iteration) {
+				float next[4] = {};
+				float scale = 0.0f;
+
+				for (int a = 0; a < channels; ++a) {
+					for (int b = 0; b < channels; ++b)
+						next[a] += covariance[a][b] * axis[b];
+
+					scale = max(scale, fabsf(next[a]));
+				}
+
+				//flat block, any axis works
+				if (scale == 0.0f)
+					break;
+
+				for (int c = 0; c < channels; ++c)
+					axis[c] = next[c] / scale;
+			}
+
+			float length = 0.0f;
+
+			for (int c = 0; c < channels; ++c)
+				length += axis[c] * axis[c];
+
+			length = sqrtf(length);
+
+			for (int c = 0; c < channels; ++c)
+				axis[c] = length > 0.0f ? axis[c] / length : 0.0f;
+		}
+
+		//the two points where the block's extent along the principal axis ends
+		void getAxisEndpoints(const float* points, const int& count, const int& channels, float* start, float* end) {
+			float mean[4], axis[4];
+			getPrincipalAxis(points, count, channels, mean, axis);
+
+			float lowest = FLT_MAX;
+			float highest = -FLT_MAX;
+
+			for (int i = 0; i < count; ++i) {
+				float t = 0.0f;
+
+				for (int c = 0; c < channels; ++c)
+					t += (points[i * channels + c] - mean[c]) * axis[c];
+
+				lowest = min(lowest, t);
+				highest = max(highest, t);
+			}
+
+			for (int c = 0; c < channels; ++c) {
+				start[c] = clampFloat(mean[c] + axis[c] * lowest, 0.0f, 255.0f);
+				end[c] = clampFloat(mean[c] + axis[c] * highest, 0.0f, 255.0f);
+			}
+		}
+
+		//least squares endpoints for fixed indices, weights[i] is how much of end texel i is made of
+		bool solveEndpoints(const float* points, const float* weights, const int& count, const int& channels, float* start, float* end) {
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[4] = {}, bx[4] = {};
+
+			for (int i = 0; i < count; ++i) {
+				float a = 1.0f - weights[i];
+				float b = weights[i];
+
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+
+				for (int c = 0; c < channels; ++c) {
+					ax[c] += a * points[i * channels + c];
+					bx[c] += b * points[i * channels + c];
+				}
+			}
+
+			float determinant = aa * bb - ab * ab;
+
+			//every texel on the same index, nothing to solve
+			if (fabsf(determinant) < 1e-6f)
+				return false;
+
+			for (int c = 0; c < channels; ++c) {
+				start[c] = clampFloat((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+				end[c] = clampFloat((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+			}
+
+			return true;
+		}
+
+		//bc1 color part, also the second half of every bc3 block
+
+		struct ColorBlock {
+			uint16_t color0 = 0;
+			uint16_t color1 = 0;
+			bool fourColor = true;
+			int indices[16] = {};
+			int error = INT_MAX;
+		};
+
+		inline uint16_t packColor(const float* color) {
+			int r = clampInt((int)(color[0] * 31.0f / 255.0f + 0.5f), 0, 31);
+			int g = clampInt((int)(color[1] * 63.0f / 255.0f + 0.5f), 0, 63);
+			int b = clampInt((int)(color[2] * 31.0f / 255.0f + 0.5f), 0, 31);
+
+			return (uint16_t)((r << 11) | (g << 5) | b);
+		}
+
+		inline void unpackColor(const uint16_t& color, int* out) {
+			int r = color >> 11;
+			int g = (color >> 5) & 63;
+			int b = color & 31;
+
+			out[0] = (r << 3) | (r >> 2);
+			out[1] = (g << 2) | (g >> 4);
+			out[2] = (b << 3) | (b >> 2);
+		}
+
+		//4 colors when color0 > color1, otherwise 3 and transparent black
+		void getColorPalette(const uint16_t& color0, const uint16_t& color1, const bool& fourColor, int palette[4][3]) {
+			unpackColor(color0, palette[0]);
+			unpackColor(color1, palette[1]);
+
+			for (int c = 0; c < 3; ++c) {
+				if (fourColor) {
+					palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+				}
+				else {
+					palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+					palette[3][c] = 0;
+				}
+			}
+		}
+
+		//transparent texels only ever happen in 3 color mode and always get index 3
+		ColorBlock fitColorEndpoints(const unsigned char* pixels, const bool* transparent, const float* start, const float* end, const bool& threeColor) {
+			ColorBlock out;
+			out.color0 = packColor(start);
+			out.color1 = packColor(end);
+
+			//the endpoint order is what tells the gpu which mode the block is in
+			if ((!threeColor && out.color0 < out.color1) || (threeColor && out.color0 > out.color1))
+				std::swap(out.color0, out.color1);
+
+			out.fourColor = out.color0 > out.color1;
+			out.error = 0;
+
+			int palette[4][3];
+			getColorPalette(out.color0, out.color1, out.fourColor, palette);
+
+			//index 3 is black in 3 color mode, only worth picking for bc1 blocks that chose that mode on purpose
+			const int entries = out.fourColor || threeColor ? 4 : 3;
+
+			for (int i = 0; i < 16; ++i) {
+				if (transparent[i]) {
+					out.indices[i] = 3;
+					continue;
+				}
+
+				const unsigned char* pixel = pixels + i * 4;
+				int bestError = INT_MAX;
+
+				for (int entry = 0; entry < entries; ++entry) {
+					int dr = pixel[0] - palette[entry][0];
+					int dg = pixel[1] - palette[entry][1];
+					int db = pixel[2] - palette[entry][2];
+					int error = dr * dr + dg * dg + db * db;
+
+					if (error < bestError) {
+						bestError = error;
+						out.indices[i] = entry;
+					}
+				}
+
+				out.error += bestError;
+			}
+
+			return out;
+		}
+
+		//bc3 color blocks are always decoded with 4 colors, so only bc1 gets to use 3 color mode
+		void encodeColorBlock(const unsigned char* pixels, const int& quality, const bool& isBC1, unsigned char* out) {
+			bool transparent[16];
+			float points[48];
+			int count = 0;
+
+			for (int i = 0; i < 16; ++i) {
+				transparent[i] = isBC1 && pixels[i * 4 + 3] < 128;
+
+				if (!transparent[i]) {
+					for (int c = 0; c < 3; ++c)
+						points[count * 3 + c] = (float)pixels[i * 4 + c];
+
+					count += 1;
+				}
+			}
+
+			const bool threeColor = count < 16;
+			ColorBlock best;
+
+			if (count == 0) {
+				best.fourColor = false;
+
+				for (int i = 0; i < 16; ++i)
+					best.indices[i] = 3;
+			}
+			else {
+				float start[3], end[3];
+				getAxisEndpoints(points, count, 3, start, end);
+
+				best = fitColorEndpoints(pixels, transparent, start, end, threeColor);
+
+				//3 color mode has a black entry and a midpoint, that sometimes beats 4 colors even without transparency
+				if (isBC1 && !threeColor && quality == HFR_COMPRESSION_BEST) {
+					ColorBlock candidate = fitColorEndpoints(pixels, transparent, start, end, true);
+
+					if (candidate.error < best.error)
+						best = candidate;
+				}
+
+				for (int iteration = 0; iteration < REFINE_ITERATIONS[quality]; ++iteration) {
+					float weights[16];
+					int fitted = 0;
+					bool usesBlack = false;
+
+					for (int i = 0; i < 16; ++i) {
+						if (transparent[i])
+							continue;
+
+						const int index = best.indices[i];
+
+						if (best.fourColor)
+							weights[fitted] = index == 0 ? 0.0f : (index == 1 ? 1.0f : (index == 2 ? 1.0f / 3.0f : 2.0f / 3.0f));
+						else
+							weights[fitted] = index == 0 ? 0.0f : (index == 1 ? 1.0f : 0.5f);
+
+						usesBlack |= !best.fourColor && index == 3;
+						fitted += 1;
+					}
+
+					//the black entry isn't on the line between the endpoints so the solve would be wrong
+					if (usesBlack || !solveEndpoints(points, weights, count, 3, start, end))
+						break;
+
+					ColorBlock candidate = fitColorEndpoints(pixels, transparent, start, end, isBC1 && !best.fourColor);
+
+					if (candidate.error >= best.error)
+						break;
+
+					best = candidate;
+				}
+			}
+
+			uint32_t indices = 0;
+
+			for (int i = 0; i < 16; ++i)
+				indices |= (uint32_t)best.indices[i] << (i * 2);
+
+			out[0] = (unsigned char)(best.color0 & 0xFF);
+			out[1] = (unsigned char)(best.color0 >> 8);
+			out[2] = (unsigned char)(best.color1 & 0xFF);
+			out[3] = (unsigned char)(best.color1 >> 8);
+			std::memcpy(out + 4, &indices, 4);
+		}
+
+		void decodeColorBlock(const unsigned char* block, const bool& isBC1, unsigned char* pixels) {
+			uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+			uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+			uint32_t indices;
+			std::memcpy(&indices, block + 4, 4);
+
+			const bool fourColor = !isBC1 || color0 > color1;
+
+			int palette[4][3];
+			getColorPalette(color0, color1, fourColor, palette);
+
+			for (int i = 0; i < 16; ++i) {
+				int index = (indices >> (i * 2)) & 3;
+
+				for (int c = 0; c < 3; ++c)
+					pixels[i * 4 + c] = (unsigned char)palette[index][c];
+
+				pixels[i * 4 + 3] = (!fourColor && index == 3) ? 0 : 255;
+			}
+		}
+
+		//bc4, one channel per block, bc3 alpha and both halves of bc5
+
+		//8 values when the first endpoint is bigger, otherwise 6 plus 0 and 255
+		void getAlphaPalette(const int& start, const int& end, int* palette) {
+			palette[0] = start;
+			palette[1] = end;
+
+			if (start > end) {
+				for (int i = 1; i < 7; ++i)
+					palette[i + 1] = ((7 - i) * start + i * end) / 7;
+			}
+			else {
+				for (int i = 1; i < 5; ++i)
+					palette[i + 1] = ((5 - i) * start + i * end) / 5;
+
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		int fitAlphaEndpoints(const unsigned char* values, const int& start, const int& end, uint64_t& indices) {
+			int palette[8];
+			getAlphaPalette(start, end, palette);
+
+			int error = 0;
+			indices = 0;
+
+			for (int i = 0; i < 16; ++i) {
+				int best = 0;
+				int bestError = INT_MAX;
+
+				for (int entry = 0; entry < 8; ++entry) {
+					int difference = values[i] - palette[entry];
+
+					if (difference * difference < bestError) {
+						bestError = difference * difference;
+						best = entry;
+					}
+				}
+
+				error += bestError;
+				indices |= (uint64_t)best << (i * 3);
+			}
+
+			return error;
+		}
+
+		void encodeAlphaBlock(const unsigned char* pixels, const int& channel, const int& quality, unsigned char* out) {
+			unsigned char values[16];
+			int lowest = 255, highest = 0;
+			//same thing without the 0 and 255 texels, for 6 value mode
+			int innerLowest = 255, innerHighest = 0;
+
+			for (int i = 0; i < 16; ++i) {
+				values[i] = pixels[i * 4 + channel];
+				lowest = min(lowest, (int)values[i]);
+				highest = max(highest, (int)values[i]);
+
+				if (values[i] != 0 && values[i] != 255) {
+					innerLowest = min(innerLowest, (int)values[i]);
+					innerHighest = max(innerHighest, (int)values[i]);
+				}
+			}
+
+			int bestStart = highest;
+			int bestEnd = lowest;
+			uint64_t bestIndices;
+			int bestError = fitAlphaEndpoints(values, bestStart, bestEnd, bestIndices);
+
+			auto tryEndpoints = [&](const int& start, const int& end) {
+				uint64_t indices;
+				int error = fitAlphaEndpoints(values, start, end, indices);
+
+				if (error < bestError) {
+					bestError = error;
+					bestStart = start;
+					bestEnd = end;
+					bestIndices = indices;
+				}
+			};
+
+			//blocks that hit 0 or 255 get those exactly from 6 value mode and spend the rest of the range on the texels in between
+			if (quality >= HFR_COMPRESSION_NORMAL && bestError > 0 && (lowest == 0 || highest == 255) && innerLowest <= innerHighest)
+				tryEndpoints(innerLowest, innerHighest);
+
+			//pulling the endpoints in a little often lines the interpolated values up better
+			if (quality == HFR_COMPRESSION_BEST && bestError > 0) {
+				for (int startOffset = -2; startOffset <= 2; ++startOffset) {
+					for (int endOffset = -2; endOffset <= 2; ++endOffset) {
+						int start = clampInt(highest + startOffset, 0, 255);
+						int end = clampInt(lowest + endOffset, 0, 255);
+
+						if (start > end)
+							tryEndpoints(start, end);
+					}
+				}
+			}
+
+			out[0] = (unsigned char)bestStart;
+			out[1] = (unsigned char)bestEnd;
+
+			for (int i = 0; i < 6; ++i)
+				out[2 + i] = (unsigned char)(bestIndices >> (i * 8));
+		}
+
+		void decodeAlphaBlock(const unsigned char* block, const int& channel, unsigned char* pixels) {
+			int palette[8];
+			getAlphaPalette(block[0], block[1], palette);
+
+			uint64_t indices = 0;
+
+			for (int i = 0; i < 6; ++i)
+				indices |= (uint64_t)block[2 + i] << (i * 8);
+
+			for (int i = 0; i < 16; ++i)
+				pixels[i * 4 + channel] = (unsigned char)palette[(indices >> (i * 3)) & 7];
+		}
+
+		//bc7 mode 6, 7 bit rgba endpoints with a p-bit each and 4 bit indices
+
+		struct BC7Block {
+			int endpoints[2][4] = {};
+			int pbits[2] = {};
+			int indices[16] = {};
+			int error = INT_MAX;
+		};
+
+		void fitBC7Endpoints(const unsigned char* pixels, const float* start, const float* end, BC7Block& best) {
+			for (int pbit = 0; pbit < 4; ++pbit) {
+				BC7Block candidate;
+				candidate.pbits[0] = pbit & 1;
+				candidate.pbits[1] = pbit >> 1;
+				candidate.error = 0;
+
+				int values[2][4];
+
+				for (int c = 0; c < 4; ++c) {
+					candidate.endpoints[0][c] = clampInt((int)((start[c] - candidate.pbits[0]) * 0.5f + 0.5f), 0, 127);
+					candidate.endpoints[1][c] = clampInt((int)((end[c] - candidate.pbits[1]) * 0.5f + 0.5f), 0, 127);
+					values[0][c] = (candidate.endpoints[0][c] << 1) | candidate.pbits[0];
+					values[1][c] = (candidate.endpoints[1][c] << 1) | candidate.pbits[1];
+				}
+
+				int palette[16][4];
+				int direction[4];
+				int length = 0;
+
+				for (int c = 0; c < 4; ++c) {
+					for (int i = 0; i < 16; ++i)
+						palette[i][c] = ((64 - BC7_WEIGHTS[i]) * values[0][c] + BC7_WEIGHTS[i] * values[1][c] + 32) >> 6;
+
+					direction[c] = values[1][c] - values[0][c];
+					length += direction[c] * direction[c];
+				}
+
+				for (int i = 0; i < 16 && candidate.error < best.error; ++i) {
+					const unsigned char* pixel = pixels + i * 4;
+
+					//projecting onto the endpoint line gets the index to within one, the neighbours cover rounding
+					int guess = 0;
+
+					if (length > 0) {
+						int dot = 0;
+
+						for (int c = 0; c < 4; ++c)
+							dot += (pixel[c] - values[0][c]) * direction[c];
+
+						guess = weightTable.index[clampInt((dot * 64 + length / 2) / length, 0, 64)];
+					}
+
+					int bestError = INT_MAX;
+
+					for (int index = max(guess - 1, 0); index <= min(guess + 1, 15); ++index) {
+						int error = 0;
+
+						for (int c = 0; c < 4; ++c) {
+							int difference = pixel[c] - palette[index][c];
+							error += difference * difference;
+						}
+
+						if (error < bestError) {
+							bestError = error;
+							candidate.indices[i] = index;
+						}
+					}
+
+					candidate.error += bestError;
+				}
+
+				if (candidate.error < best.error)
+					best = candidate;
+			}
+		}
+
+		BC7Block encodeBC7Mode6(const unsigned char* pixels, const int& quality) {
+			float points[64];
+
+			for (int i = 0; i < 64; ++i)
+				points[i] = (float)pixels[i];
+
+			float start[4], end[4];
+			getAxisEndpoints(points, 16, 4, start, end);
+
+			BC7Block best;
+			fitBC7Endpoints(pixels, start, end, best);
+
+			for (int iteration = 0; iteration < REFINE_ITERATIONS[quality] && best.error > 0; ++iteration) {
+				float weights[16];
+
+				for (int i = 0; i < 16; ++i)
+					weights[i] = BC7_WEIGHTS[best.indices[i]] / 64.0f;
+
+				if (!solveEndpoints(points, weights, 16, 4, start, end))
+					break;
+
+				int previous = best.error;
+				fitBC7Endpoints(pixels, start, end, best);
+
+				if (best.error >= previous)
+					break;
+			}
+
+			//the first index only has 3 bits so its top bit has to be 0, flipping the endpoints gets there
+			if (best.indices[0] >= 8) {
+				for (int c = 0; c < 4; ++c)
+					std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+
+				std::swap(best.pbits[0], best.pbits[1]);
+
+				for (int i = 0; i < 16; ++i)
+					best.indices[i] = 15 - best.indices[i];
+			}
+
+			return best;
+		}
+
+		//bc7 mode 5, rgb and alpha get their own endpoints and 2 bit indices, which mode 6 can't do when alpha doesn't follow the color
+
+		const int BC7_SPLIT_WEIGHTS[4] = { 0, 21, 43, 64 };
+
+		struct BC7SplitBlock {
+			//7 bit color and 8 bit alpha endpoints
+			int color[2][3] = {};
+			int alpha[2] = {};
+			int colorIndices[16] = {};
+			int alphaIndices[16] = {};
+			int colorError = INT_MAX;
+			int alphaError = INT_MAX;
+		};
+
+		//fits channels [first, first + count) of every texel with 4 interpolated values, bits is the endpoint precision
+		int fitSplitEndpoints(const unsigned char* pixels, const int& first, const int& count, const int& bits, const float* start, const float* end, int endpoints[2][3], int* indices) {
+			const int levels = (1 << bits) - 1;
+			int values[2][3];
+
+			for (int c = 0; c < count; ++c) {
+				endpoints[0][c] = clampInt((int)(start[c] * levels / 255.0f + 0.5f), 0, levels);
+				endpoints[1][c] = clampInt((int)(end[c] * levels / 255.0f + 0.5f), 0, levels);
+
+				//7 bit endpoints get their top bit repeated at the bottom
+				values[0][c] = bits == 8 ? endpoints[0][c] : (endpoints[0][c] << 1) | (endpoints[0][c] >> 6);
+				values[1][c] = bits == 8 ? endpoints[1][c] : (endpoints[1][c] << 1) | (endpoints[1][c] >> 6);
+			}
+
+			int error = 0;
+
+			for (int i = 0; i < 16; ++i) {
+				int bestError = INT_MAX;
+
+				for (int index = 0; index < 4; ++index) {
+					int weight = BC7_SPLIT_WEIGHTS[index];
+					int indexError = 0;
+
+					for (int c = 0; c < count; ++c) {
+						int difference = pixels[i * 4 + first + c] - (((64 - weight) * values[0][c] + weight * values[1][c] + 32) >> 6);
+						indexError += difference * difference;
+					}
+
+					if (indexError < bestError) {
+						bestError = indexError;
+						indices[i] = index;
+					}
+				}
+
+				error += bestError;
+			}
+
+			return error;
+		}
+
+		//one half of a mode 5 block, the color half when count is 3 and the alpha half when it's 1
+		int encodeSplitHalf(const unsigned char* pixels, const int& first, const int& count, const int& bits, const int& quality, int endpoints[2][3], int* indices) {
+			float points[48];
+
+			for (int i = 0; i < 16; ++i) {
+				for (int c = 0; c < count; ++c)
+					points[i * count + c] = (float)pixels[i * 4 + first + c];
+			}
+
+			float start[3], end[3];
+			getAxisEndpoints(points, 16, count, start, end);
+
+			int error = fitSplitEndpoints(pixels, first, count, bits, start, end, endpoints, indices);
+
+			for (int iteration = 0; iteration < REFINE_ITERATIONS[quality] && error > 0; ++iteration) {
+				float weights[16];
+
+				for (int i = 0; i < 16; ++i)
+					weights[i] = BC7_SPLIT_WEIGHTS[indices[i]] / 64.0f;
+
+				if (!solveEndpoints(points, weights, 16, count, start, end))
+					break;
+
+				int candidateEndpoints[2][3];
+				int candidateIndices[16];
+				int candidate = fitSplitEndpoints(pixels, first, count, bits, start, end, candidateEndpoints, candidateIndices);
+
+				if (candidate >= error)
+					break;
+
+				error = candidate;
+				std::memcpy(endpoints, candidateEndpoints, sizeof(candidateEndpoints));
+				std::memcpy(indices, candidateIndices, sizeof(candidateIndices));
+			}
+
+			//the first index of each set only has 1 bit
+			if (indices[0] >= 2) {
+				for (int c = 0; c < count; ++c)
+					std::swap(endpoints[0][c], endpoints[1][c]);
+
+				for (int i = 0; i < 16; ++i)
+					indices[i] = 3 - indices[i];
+			}
+
+			return error;
+		}
+
+		BC7SplitBlock encodeBC7Mode5(const unsigned char* pixels, const int& quality) {
+			BC7SplitBlock out;
+			out.colorError = encodeSplitHalf(pixels, 0, 3, 7, quality, out.color, out.colorIndices);
+
+			int alpha[2][3];
+			out.alphaError = encodeSplitHalf(pixels, 3, 1, 8, quality, alpha, out.alphaIndices);
+			out.alpha[0] = alpha[0][0];
+			out.alpha[1] = alpha[1][0];
+
+			return out;
+		}
+
+		void encodeBC7Block(const unsigned char* pixels, const int& quality, unsigned char* out) {
+			BC7Block single = encodeBC7Mode6(pixels, quality);
+
+			bool alphaVaries = false;
+
+			for (int i = 1; i < 16; ++i)
+				alphaVaries |= pixels[i * 4 + 3] != pixels[3];
+
+			std::memset(out, 0, 16);
+			BitWriter writer(out);
+
+			if (alphaVaries) {
+				BC7SplitBlock split = encodeBC7Mode5(pixels, quality);
+
+				if (split.colorError + split.alphaError < single.error) {
+					//mode 5 is five 0 bits and then a 1, the rotation stays 0 so alpha really is alpha
+					writer.write(1 << 5, 6);
+					writer.write(0, 2);
+
+					for (int c = 0; c < 3; ++c) {
+						writer.write((uint32_t)split.color[0][c], 7);
+						writer.write((uint32_t)split.color[1][c], 7);
+					}
+
+					writer.write((uint32_t)split.alpha[0], 8);
+					writer.write((uint32_t)split.alpha[1], 8);
+
+					for (int i = 0; i < 16; ++i)
+						writer.write((uint32_t)split.colorIndices[i], i == 0 ? 1 : 2);
+
+					for (int i = 0; i < 16; ++i)
+						writer.write((uint32_t)split.alphaIndices[i], i == 0 ? 1 : 2);
+
+					return;
+				}
+			}
+
+			//mode 6 is six 0 bits and then a 1
+			writer.write(1 << 6, 7);
+
+			for (int c = 0; c < 4; ++c) {
+				writer.write((uint32_t)single.endpoints[0][c], 7);
+				writer.write((uint32_t)single.endpoints[1][c], 7);
+			}
+
+			writer.write((uint32_t)single.pbits[0], 1);
+			writer.write((uint32_t)single.pbits[1], 1);
+
+			writer.write((uint32_t)single.indices[0], 3);
+
+			for (int i = 1; i < 16; ++i)
+				writer.write((uint32_t)single.indices[i], 4);
+		}
+
+		//only modes 5 and 6 get decoded since that's all the compressor writes, anything else comes out as zeros like an invalid block would
+		void decodeBC7Block(const unsigned char* block, unsigned char* pixels) {
+			std::memset(pixels, 0, 64);
+
+			BitReader reader(block);
+
+			if ((block[0] & 0x3F) == 0x20) {
+				reader.read(6);
+				int rotation = (int)reader.read(2);
+
+				int values[2][4];
+
+				for (int c = 0; c < 3; ++c) {
+					for (int e = 0; e < 2; ++e) {
+						int value = (int)reader.read(7);
+						values[e][c] = (value << 1) | (value >> 6);
+					}
+				}
+
+				values[0][3] = (int)reader.read(8);
+				values[1][3] = (int)reader.read(8);
+
+				int colorIndices[16];
+
+				for (int i = 0; i < 16; ++i)
+					colorIndices[i] = (int)reader.read(i == 0 ? 1 : 2);
+
+				for (int i = 0; i < 16; ++i) {
+					int alphaWeight = BC7_SPLIT_WEIGHTS[reader.read(i == 0 ? 1 : 2)];
+					int colorWeight = BC7_SPLIT_WEIGHTS[colorIndices[i]];
+					unsigned char* pixel = pixels + i * 4;
+
+					for (int c = 0; c < 3; ++c)
+						pixel[c] = (unsigned char)(((64 - colorWeight) * values[0][c] + colorWeight * values[1][c] + 32) >> 6);
+
+					pixel[3] = (unsigned char)(((64 - alphaWeight) * values[0][3] + alphaWeight * values[1][3] + 32) >> 6);
+
+					//rotation swaps alpha with one of the color channels after decoding
+					if (rotation != 0)
+						std::swap(pixel[3], pixel[rotation - 1]);
+				}
+
+				return;
+			}
+
+			if ((block[0] & 0x7F) != 0x40)
+				return;
+
+			reader.read(7);
+
+			int values[2][4];
+
+			for (int c = 0; c < 4; ++c) {
+				values[0][c] = (int)reader.read(7) << 1;
+				values[1][c] = (int)reader.read(7) << 1;
+			}
+
+			int pbit0 = (int)reader.read(1);
+			int pbit1 = (int)reader.read(1);
+
+			for (int c = 0; c < 4; ++c) {
+				values[0][c] |= pbit0;
+				values[1][c] |= pbit1;
+			}
+
+			for (int i = 0; i < 16; ++i) {
+				int weight = BC7_WEIGHTS[reader.read(i == 0 ? 3 : 4)];
+
+				for (int c = 0; c < 4; ++c)
+					pixels[i * 4 + c] = (unsigned char)(((64 - weight) * values[0][c] + weight * values[1][c] + 32) >> 6);
+			}
+		}
+	}
+
+	CompressedImage TextureCompressor::compress(const Image& image, const int& format, const int& quality) {
+		ProfileMethod("Texture compress");
+
+		CompressedImage out;
+
+		if (!image.hasData() || format < HFR_TEXTURE_FORMAT_RGBA8 || format > HFR_TEXTURE_FORMAT_BC7) {
+			Debug::systemErr("Can't compress image: {}", image.filepath);
+			return out;
+		}
+
+		out.width = image.width;
+		out.height = image.height;
+		out.format = format;
+		out.data.resize(CookedTexture::getImageSize(format, image.width, image.height));
+
+		if (format == HFR_TEXTURE_FORMAT_RGBA8) {
+			for (int y = 0; y < image.height; ++y) {
+				for (int x = 0; x < image.width; ++x)
+					readTexel(image, x, y, &out.data[((size_t)y * image.width + x) * 4]);
+			}
+
+			return out;
+		}
+
+		const int level = clampInt(quality, HFR_COMPRESSION_FAST, HFR_COMPRESSION_BEST);
+		const int blockSize = CookedTexture::getBlockSize(format);
+		const int blocksX = (image.width + 3) / 4;
+		const int blocksY = (image.height + 3) / 4;
+		unsigned char* data = out.data.data();
+
+		//a block row of a big texture is plenty of work for one batch
+		JobSystem::parallelFor((size_t)blocksY, 1, [&](const size_t& begin, const size_t& end) {
+			unsigned char pixels[64];
+
+			for (size_t blockY = begin; blockY < end; ++blockY) {
+				for (int blockX = 0; blockX < blocksX; ++blockX) {
+					readBlock(image, blockX, (int)blockY, pixels);
+					encodeBlock(format, pixels, level, data + (blockY * blocksX + blockX) * blockSize);
+				}
+			}
+		});
+
+		return out;
+	}
+
+	Image TextureCompressor::decompress(const CompressedImage& image) {
+		Image out(image.width, image.height, 4, NULL);
+
+		if (image.format == HFR_TEXTURE_FORMAT_RGBA8) {
+			std::memcpy(out.data, image.data.data(), min(image.data.size(), (size_t)image.width * image.height * 4));
+			return out;
+		}
+
+		const int blockSize = CookedTexture::getBlockSize(image.format);
+		const int blocksX = (image.width + 3) / 4;
+		const int blocksY = (image.height + 3) / 4;
+
+		for (int blockY = 0; blockY < blocksY; ++blockY) {
+			for (int blockX = 0; blockX < blocksX; ++blockX) {
+				unsigned char pixels[64];
+				decodeBlock(image.format, &image.data[((size_t)blockY * blocksX + blockX) * blockSize], pixels);
+
+				//edge blocks only write the texels that are actually in the image
+				for (int y = 0; y < 4 && blockY * 4 + y < image.height; ++y) {
+					for (int x = 0; x < 4 && blockX * 4 + x < image.width; ++x)
+						std::memcpy(out.data + ((size_t)(blockY * 4 + y) * image.width + blockX * 4 + x) * 4, pixels + (y * 4 + x) * 4, 4);
+				}
+			}
+		}
+
+		return out;
+	}
+
+	bool TextureCompressor::cook(const Image& image, const std::string& path, const CompressionSettings& settings) {
+		ProfileMethod("Texture cook");
+
+		if (!image.hasData()) {
+			Debug::systemErr("Can't cook an empty image into: {}", path);
+			return false;
+		}
+
+		std::vector<CompressedImage> levels;
+		levels.push_back(compress(image, settings.format, settings.quality));
+
+		size_t uncompressed = (size_t)image.width * image.height * 4;
+
+		if (settings.generateMipmap) {
+			std::vector<Image> mipmaps = ImageProcessing::generateMipChain(image, settings.mips);
+
+			for (size_t i = 0; i < mipmaps.size(); ++i) {
+				levels.push_back(compress(mipmaps[i], settings.format, settings.quality));
+				uncompressed += (size_t)mipmaps[i].width * mipmaps[i].height * 4;
+			}
+		}
+
+		if (!CookedTexture::save(path, levels, settings.mips.srgb && settings.format != HFR_TEXTURE_FORMAT_BC5))
+			return false;
+
+		size_t compressed = 0;
+
+		for (size_t i = 0; i < levels.size(); ++i)
+			compressed += levels[i].data.size();
+
+		Debug::systemSuccess("Cooked {} levels of {} ({} KB -> {} KB) into: {}", levels.size(), CookedTexture::getFormatName(settings.format), uncompressed / 1024, compressed / 1024, path);
+
+		return true;
+	}
+
+	bool TextureCompressor::cook(const std::string& imagePath, const std::string& path, const CompressionSettings& settings) {
+		Image image(imagePath);
+		return image.hasData() && cook(image, path, settings);
+	}
+
+	void TextureCompressor::encodeBlock(const int& format, const unsigned char* pixels, const int& quality, unsigned char* out) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1:
+			encodeColorBlock(pixels, quality, true, out);
+			break;
+		case HFR_TEXTURE_FORMAT_BC3:
+			encodeAlphaBlock(pixels, 3, quality, out);
+			encodeColorBlock(pixels, quality, false, out + 8);
+			break;
+		case HFR_TEXTURE_FORMAT_BC5:
+			encodeAlphaBlock(pixels, 0, quality, out);
+			encodeAlphaBlock(pixels, 1, quality, out + 8);
+			break;
+		case HFR_TEXTURE_FORMAT_BC7:
+			encodeBC7Block(pixels, quality, out);
+			break;
+		}
+	}
+
+	void TextureCompressor::decodeBlock(const int& format, const unsigned char* block, unsigned char* pixels) {
+		switch (format) {
+		case HFR_TEXTURE_FORMAT_BC1:
+			decodeColorBlock(block, true, pixels);
+			break;
+		case HFR_TEXTURE_FORMAT_BC3:
+			decodeColorBlock(block + 8, false, pixels);
+			decodeAlphaBlock(block, 3, pixels);
+			break;
+		case HFR_TEXTURE_FORMAT_BC5:
+			for (int i = 0; i < 16; ++i) {
+				pixels[i * 4 + 2] = 0;
+				pixels[i * 4 + 3] = 255;
+			}
+
+			decodeAlphaBlock(block, 0, pixels);
+			decodeAlphaBlock(block + 8, 1, pixels);
+			break;
+		case HFR_TEXTURE_FORMAT_BC7:
+			decodeBC7Block(block, pixels);
+			break;
+		}
+	}
+
+	double TextureCompressor::getPSNR(const Image& a, const Image& b, const int& channels) {
+		if (!a.hasData() || !b.hasData() || a.width != b.width || a.height != b.height) {
+			Debug::systemErr("Can't compare images of different sizes");
+			return 0.0;
+		}
+
+		const int compared = clampInt(channels, 1, 4);
+		double squaredError = 0.0;
+
+		for (int y = 0; y < a.height; ++y) {
+			for (int x = 0; x < a.width; ++x) {
+				unsigned char first[4], second[4];
+				readTexel(a, x, y, first);
+				readTexel(b, x, y, second);
+
+				for (int c = 0; c < compared; ++c) {
+					double difference = (double)first[c] - second[c];
+					squaredError += difference * difference;
+				}
+			}
+		}
+
+		double meanSquaredError = squaredError / ((double)a.width * a.height * compared);
+
+		if (meanSquaredError == 0.0)
+			return std::numeric_limits<double>::infinity();
+
+		return 10.0 * log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+}
@@ -0,0 +1,45 @@
+#ifndef HFR_TEXTURE_COMPRESSOR_HEADER_INCLUDE
+#define HFR_TEXTURE_COMPRESSOR_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_IMAGE
+#include HFR_IMAGE_PROCESSING
+#include HFR_COOKED_TEXTURE
+
+namespace HFR {
+
+	struct DLL_API CompressionSettings {
+		//HFR_TEXTURE_FORMAT_*
+		int format = HFR_TEXTURE_FORMAT_BC7;
+		//HFR_COMPRESSION_FAST, HFR_COMPRESSION_NORMAL or HFR_COMPRESSION_BEST
+		int quality = HFR_COMPRESSION_NORMAL;
+		bool generateMipmap = true;
+		//mips.srgb also marks the cooked file as srgb (except for bc5, which is never srgb)
+		MipSettings mips;
+	};
+
+	//block compression for cooking textures ahead of time, the gpu reads the result as is so nothing gets decoded at load
+	//bc1 is rgb (with 1 bit alpha), bc3 is rgb plus smooth alpha, bc5 is two channels for normal maps (red and green, the shader rebuilds z)
+	//and bc7 is rgba at the best quality, written as mode 6 (one set of rgba endpoints) or mode 5 (separate alpha endpoints) whichever fits a block better
+	class DLL_API TextureCompressor {
+	public:
+		//any channel count gets expanded to rgba first, block rows are spread over the job system
+		static CompressedImage compress(const Image& image, const int& format, const int& quality);
+		//back to rgba8, for checking quality
+		static Image decompress(const CompressedImage& image);
+
+		//makes the mip chain, compresses every level and saves it all as a .htex
+		static bool cook(const Image& image, const std::string& path, const CompressionSettings& settings);
+		static bool cook(const std::string& imagePath, const std::string& path, const CompressionSettings& settings);
+
+		//single 4x4 blocks, pixels are 16 rgba8 texels in row order and out gets CookedTexture::getBlockSize bytes
+		static void encodeBlock(const int& format, const unsigned char* pixels, const int& quality, unsigned char* out);
+		static void decodeBlock(const int& format, const unsigned char* block, unsigned char* pixels);
+
+		//peak signal to noise ratio in db over the first channels of two images of the same size, infinity if they match
+		static double getPSNR(const Image& a, const Image& b, const int& channels);
+	};
+
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "hfpch.h"
+#include HFR_FRAMEBUFFER
+
+namespace HFR {
+
+	Framebuffer::Framebuffer() {}
+
+	Framebuffer::~Framebuffer() {
+		destroy();
+	}
+
+	bool Framebuffer::create(const Vec2i& _size) {
+		destroy();
+
+		if (_size.x <= 0 || _size.y <= 0)
+			return false;
+
+		size = _size;
+
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		//it gets drawn back one texel to one pixel
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glGenFramebuffers(1, &framebufferID);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureID, 0);
+
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			Debug::systemErr("Framebuffer of size {}x{} isn't complete", size.x, size.y);
+			destroy();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Framebuffer::destroy() {
+		if (framebufferID != 0)
+			glDeleteFramebuffers(1, &framebufferID);
+
+		if (textureID != 0)
+			glDeleteTextures(1, &textureID);
+
+		framebufferID = 0;
+		textureID = 0;
+		size = Vec2i();
+	}
+
+	bool Framebuffer::isCreated() const {
+		return framebufferID != 0;
+	}
+
+	void Framebuffer::bind() const {
+		glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+		glViewport(0, 0, size.x, size.y);
+	}
+
+	void Framebuffer::unbind(const Vec2i& viewportSize) const {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, viewportSize.x, viewportSize.y);
+	}
+
+	unsigned int Framebuffer::getTextureID() const {
+		return textureID;
+	}
+
+	Vec2i Framebuffer::getSize() const {
+		return size;
+	}
+
+}
@@ -0,0 +1,40 @@
+#ifndef HFR_FRAMEBUFFER_HEADER_INCLUDE
+#define HFR_FRAMEBUFFER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VEC2
+
+namespace HFR {
+
+	//an offscreen rgba8 color target without depth, for things that get drawn once and shown for many frames
+	class DLL_API Framebuffer {
+	private:
+		unsigned int framebufferID = 0;
+		unsigned int textureID = 0;
+		Vec2i size;
+
+	public:
+		Framebuffer();
+		~Framebuffer();
+
+		//the gl objects belong to one framebuffer only
+		Framebuffer(const Framebuffer&) = delete;
+		Framebuffer& operator=(const Framebuffer&) = delete;
+
+		//makes it again if it was already created, the contents are undefined afterwards
+		bool create(const Vec2i& size);
+		void destroy();
+		bool isCreated() const;
+
+		//draws go into it (and the viewport gets set to its size) until unbind
+		void bind() const;
+		//back to the window, viewportSize is what the viewport gets set back to
+		void unbind(const Vec2i& viewportSize) const;
+
+		unsigned int getTextureID() const;
+		Vec2i getSize() const;
+	};
+
+}
+
+#endif
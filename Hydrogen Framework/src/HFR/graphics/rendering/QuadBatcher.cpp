@@ -0,0 +1,303 @@
+#include "hfpch.h"
+#include HFR_QUAD_BATCHER
+#include HFR_RENDERER2D
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		//one per quad, the corners come from the shared unit quad
+		struct QuadInstance {
+			float origin[2];
+			float axisX[2];
+			float axisY[2];
+			float pixelSize[2];
+			float textureOffset[2];
+			float textureSize[2];
+			uint32_t color;
+			uint32_t borderColor;
+			//border size, corner radius, corner smoothing, radial fill
+			float shape[4];
+			//radial fill angle offset, radial fill offset
+			float radial[3];
+			//texture slot in the low byte, then whether there's a texture and whether the radial fill is inverted
+			uint32_t flags;
+		};
+
+		const uint32_t HAS_TEXTURE = 1 << 8;
+		const uint32_t RADIAL_FILL_INVERSE = 1 << 9;
+
+		//a run of quads drawn with one call
+		struct QuadDraw {
+			const Shader* shader;
+			size_t first;
+			size_t count;
+			unsigned int textures[HFR_QUAD_BATCH_TEXTURE_SLOTS];
+			int textureAmount;
+		};
+
+		std::vector<QuadInstance> instances;
+		std::vector<QuadDraw> draws;
+
+		const float unitQuad[] = { -1, 1,  -1, -1,  1, 1,  1, -1 };
+
+		unsigned int VAO = 0;
+		unsigned int cornerVBO = 0;
+		unsigned int instanceVBO = 0;
+		size_t capacity = 0;
+		const Shader* boundShader = nullptr;
+
+		//slot of texture in draw, -1 when it's full
+		int getTextureSlot(QuadDraw& draw, const unsigned int& texture) {
+			for (int i = 0; i < draw.textureAmount; ++i) {
+				if (draw.textures[i] == texture)
+					return i;
+			}
+
+			if (draw.textureAmount == HFR_QUAD_BATCH_TEXTURE_SLOTS)
+				return -1;
+
+			draw.textures[draw.textureAmount] = texture;
+			return draw.textureAmount++;
+		}
+
+		QuadDraw& startDraw(const Shader& shader) {
+			QuadDraw draw;
+			draw.shader = &shader;
+			draw.first = instances.size();
+			draw.count = 0;
+			draw.textureAmount = 0;
+
+			draws.push_back(draw);
+			return draws.back();
+		}
+	}
+
+	size_t QuadBatcher::drawCalls = 0;
+	size_t QuadBatcher::quadAmount = 0;
+	QuadBatchBackend QuadBatcher::backend;
+
+	void QuadBatcher::init() {
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &cornerVBO);
+		glGenBuffers(1, &instanceVBO);
+
+		glBindVertexArray(VAO);
+
+		glBindBuffer(GL_ARRAY_BUFFER, cornerVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(unitQuad), unitQuad, GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+		glEnableVertexAttribArray(0);
+
+		for (unsigned int i = 1; i <= 8; ++i) {
+			glEnableVertexAttribArray(i);
+			glVertexAttribDivisor(i, 1);
+		}
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		reserve(HFR_QUAD_BATCH_QUADS);
+
+		QuadBatchBackend gl;
+
+		gl.begin = [](const void* data, const size_t& amount, const size_t& instanceSize) {
+			reserve(amount);
+
+			glBindVertexArray(VAO);
+			glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+			//orphaning the old storage gets fresh memory from the driver instead of waiting on the draws still reading last frames quads
+			glBufferData(GL_ARRAY_BUFFER, capacity * instanceSize, NULL, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, amount * instanceSize, data);
+
+			Renderer2D::setDepthTest(false);
+			Renderer2D::setAlphaBlending(true);
+
+			boundShader = nullptr;
+		};
+
+		gl.draw = [](const Shader& shader, const size_t& first, const size_t& count, const unsigned int* textures, const int& textureAmount) {
+			if (&shader != boundShader) {
+				shader.bind();
+				boundShader = &shader;
+
+				for (int slot = 0; slot < HFR_QUAD_BATCH_TEXTURE_SLOTS; ++slot)
+					shader.setUniform(("textures[" + std::to_string(slot) + "]").c_str(), slot);
+			}
+
+			for (int slot = 0; slot < textureAmount; ++slot) {
+				glActiveTexture(GL_TEXTURE0 + slot);
+				glBindTexture(GL_TEXTURE_2D, textures[slot]);
+			}
+
+			setInstanceOffset(first);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)count);
+		};
+
+		gl.end = []() {
+			glActiveTexture(GL_TEXTURE0);
+
+			if (boundShader != nullptr)
+				boundShader->unbind();
+
+			boundShader = nullptr;
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			Renderer2D::setDepthTest(true);
+			Renderer2D::setAlphaBlending(false);
+		};
+
+		setBackend(gl);
+	}
+
+	void QuadBatcher::close() {
+		instances.clear();
+		draws.clear();
+		backend = QuadBatchBackend();
+
+		if (VAO != 0) {
+			glDeleteVertexArrays(1, &VAO);
+			glDeleteBuffers(1, &cornerVBO);
+			glDeleteBuffers(1, &instanceVBO);
+		}
+
+		VAO = 0;
+		cornerVBO = 0;
+		instanceVBO = 0;
+		capacity = 0;
+	}
+
+	void QuadBatcher::setBackend(const QuadBatchBackend& _backend) {
+		backend = _backend;
+	}
+
+	void QuadBatcher::reserve(const size_t& quads) {
+		if (quads <= capacity)
+			return;
+
+		capacity = max(quads, capacity * 2);
+
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(QuadInstance), NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void QuadBatcher::setInstanceOffset(const size_t& first) {
+		const size_t base = first * sizeof(QuadInstance);
+		const GLsizei stride = sizeof(QuadInstance);
+
+		//base instance needs gl 4.2, so the attributes get moved instead
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(QuadInstance, origin)));
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(QuadInstance, axisY)));
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(QuadInstance, textureOffset)));
+		glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)(base + offsetof(QuadInstance, color)));
+		glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)(base + offsetof(QuadInstance, borderColor)));
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(QuadInstance, shape)));
+		glVertexAttribPointer(7, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(QuadInstance, radial)));
+		glVertexAttribIPointer(8, 1, GL_UNSIGNED_INT, stride, (void*)(base + offsetof(QuadInstance, flags)));
+	}
+
+	void QuadBatcher::submit(const GuiQuad& quad, const Shader& shader) {
+		QuadDraw* draw = draws.empty() || draws.back().shader != &shader ? &startDraw(shader) : &draws.back();
+
+		uint32_t flags = 0;
+
+		if (quad.textureID != 0) {
+			int slot = getTextureSlot(*draw, quad.textureID);
+
+			//out of slots, the rest goes into the next draw
+			if (slot < 0) {
+				draw = &startDraw(shader);
+				slot = getTextureSlot(*draw, quad.textureID);
+			}
+
+			flags = (uint32_t)slot | HAS_TEXTURE;
+		}
+
+		if (quad.radialFillInverse)
+			flags |= RADIAL_FILL_INVERSE;
+
+		QuadInstance instance;
+
+		instance.origin[0] = quad.origin.x;
+		instance.origin[1] = quad.origin.y;
+		instance.axisX[0] = quad.axisX.x;
+		instance.axisX[1] = quad.axisX.y;
+		instance.axisY[0] = quad.axisY.x;
+		instance.axisY[1] = quad.axisY.y;
+		instance.pixelSize[0] = quad.pixelSize.x;
+		instance.pixelSize[1] = quad.pixelSize.y;
+		instance.textureOffset[0] = quad.textureOffset.x;
+		instance.textureOffset[1] = quad.textureOffset.y;
+		instance.textureSize[0] = quad.textureSize.x;
+		instance.textureSize[1] = quad.textureSize.y;
+		instance.color = Util::packColor(quad.color);
+		instance.borderColor = Util::packColor(quad.borderColor);
+		instance.shape[0] = quad.borderSize;
+		instance.shape[1] = quad.cornerRadius;
+		instance.shape[2] = quad.cornerSmoothing;
+		instance.shape[3] = quad.radialFill;
+		instance.radial[0] = quad.radialFillAngleOffset;
+		instance.radial[1] = quad.radialFillOffset.x;
+		instance.radial[2] = quad.radialFillOffset.y;
+		instance.flags = flags;
+
+		instances.push_back(instance);
+		draw->count += 1;
+	}
+
+	void QuadBatcher::flush() {
+		ProfileMethod("Quad batcher flush");
+		ProfileGpuTime("Quad batches");
+
+		drawCalls = 0;
+		quadAmount = instances.size();
+
+		if (!instances.empty() && backend.draw) {
+			if (backend.begin)
+				backend.begin(instances.data(), instances.size(), sizeof(QuadInstance));
+
+			for (size_t i = 0; i < draws.size(); ++i) {
+				const QuadDraw& draw = draws[i];
+
+				if (draw.count == 0)
+					continue;
+
+				ProfileGpu("Quad draw");
+
+				backend.draw(*draw.shader, draw.first, draw.count, draw.textures, draw.textureAmount);
+				drawCalls += 1;
+			}
+
+			if (backend.end)
+				backend.end();
+		}
+
+		clear();
+	}
+
+	void QuadBatcher::clear() {
+		instances.clear();
+		draws.clear();
+	}
+
+	size_t QuadBatcher::getDrawCalls() {
+		return drawCalls;
+	}
+
+	size_t QuadBatcher::getQuadAmount() {
+		return quadAmount;
+	}
+
+	size_t QuadBatcher::getQueuedQuadAmount() {
+		return instances.size();
+	}
+
+	size_t QuadBatcher::getQueuedDrawAmount() {
+		return draws.size();
+	}
+
+}
@@ -0,0 +1,89 @@
+#ifndef HFR_QUAD_BATCHER_HEADER_INCLUDE
+#define HFR_QUAD_BATCHER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_MATH
+#include HFR_SHADER
+
+namespace HFR {
+
+	//everything a gui shader needs to draw one rectangle, Renderer2D fills these in from gui elements
+	struct DLL_API GuiQuad {
+		//the corners end up at origin + axisX * x + axisY * y (opengl coordinates) for x and y -1 or 1, so rotation and scale are already in there
+		Vec2f origin;
+		Vec2f axisX;
+		Vec2f axisY;
+
+		//borders and corner radii are in pixels of this size
+		Vec2f pixelSize;
+
+		//part of the texture that gets drawn, top left corner and size (0 - 1)
+		Vec2f textureOffset = Vec2f(0, 0);
+		Vec2f textureSize = Vec2f(1, 1);
+		//0 for none
+		unsigned int textureID = 0;
+
+		Vec4f color;
+		Vec4f borderColor;
+
+		float borderSize = 0;
+		float cornerRadius = 0;
+		float cornerSmoothing = 0;
+
+		//radial fill, in radians
+		float radialFill = 0;
+		float radialFillAngleOffset = 0;
+		Vec2f radialFillOffset = Vec2f(0.5f, 0.5f);
+		bool radialFillInverse = false;
+	};
+
+	//what the quad batcher needs from the graphics api, init sets up the opengl one, tests can hand in one that only counts the draws
+	struct DLL_API QuadBatchBackend {
+		//once per flush with quads in it, amount instances of instanceSize bytes in the order they were submitted
+		std::function<void(const void* instances, const size_t& amount, const size_t& instanceSize)> begin;
+		//one draw call, the quads first to first + count - 1 with textures in slots 0 to textureAmount - 1
+		std::function<void(const Shader& shader, const size_t& first, const size_t& count, const unsigned int* textures, const int& textureAmount)> draw;
+		std::function<void()> end;
+	};
+
+	//gui quads get collected into one instance buffer and drawn with as few calls as possible,
+	//a new draw only starts when the shader changes or the textures used don't fit into the texture slots anymore
+	//quads get drawn in the order they were submitted
+	class DLL_API QuadBatcher {
+	private:
+		static size_t drawCalls;
+		static size_t quadAmount;
+		static QuadBatchBackend backend;
+
+		//makes the instance buffer fit at least quads quads
+		static void reserve(const size_t& quads);
+		//points the per quad attributes at the quad first in the instance buffer
+		static void setInstanceOffset(const size_t& first);
+
+	public:
+		//main thread with a current context
+		static void init();
+		static void close();
+		//replaces whatever init set up, without init or a backend flush only drops the quads
+		static void setBackend(const QuadBatchBackend& backend);
+
+		//shader needs the gui quad inputs (guiVertex.glsl), nothing gets drawn until flush
+		static void submit(const GuiQuad& quad, const Shader& shader);
+
+		//uploads everything queued since the last flush and draws it, Window::update does this right before the text
+		static void flush();
+		//drops everything queued without drawing it
+		static void clear();
+
+		//as of the last flush
+		static size_t getDrawCalls();
+		static size_t getQuadAmount();
+		//quads queued since the last flush
+		static size_t getQueuedQuadAmount();
+		//draws the queued quads would take
+		static size_t getQueuedDrawAmount();
+	};
+
+}
+
+#endif
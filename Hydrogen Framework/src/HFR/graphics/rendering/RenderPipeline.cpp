@@ -0,0 +1,170 @@
+#include "hfpch.h"
+#include HFR_RENDER_PIPELINE
+
+namespace HFR {
+
+	namespace {
+		std::thread simulationThread;
+		std::mutex simulationMutex;
+		std::condition_variable simulationWake;
+		std::condition_variable simulationDone;
+
+		bool running = false;
+		//set by beginFrame, cleared by the simulation thread once it's done with it
+		bool hasJob = false;
+		std::function<void(RenderSnapshot& snapshot)> job;
+		RenderSnapshot* jobSnapshot = nullptr;
+
+		//both threads add to it, only the main thread empties it
+		std::mutex deletionMutex;
+		std::vector<unsigned int> deletedVertexArrays;
+
+		RenderPipelineBackend backend;
+
+		void deleteVertexArrays(const size_t& amount, const unsigned int* vertexArrays) {
+			if (backend.deleteVertexArrays)
+				backend.deleteVertexArrays(amount, vertexArrays);
+			else
+				glDeleteVertexArrays((GLsizei)amount, vertexArrays);
+		}
+
+		void deleteQueued() {
+			std::lock_guard<std::mutex> lock(deletionMutex);
+
+			if (!deletedVertexArrays.empty())
+				deleteVertexArrays(deletedVertexArrays.size(), deletedVertexArrays.data());
+
+			deletedVertexArrays.clear();
+		}
+	}
+
+	std::array<RenderSnapshot, 2> RenderPipeline::snapshots;
+	size_t RenderPipeline::front = 0;
+	size_t RenderPipeline::frameNumber = 0;
+	bool RenderPipeline::enabled = false;
+
+	void RenderPipeline::setEnabled(const bool& _enabled) {
+		if (_enabled == enabled)
+			return;
+
+		enabled = _enabled;
+
+		if (enabled) {
+			running = true;
+			simulationThread = std::thread(simulationLoop);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(simulationMutex);
+			running = false;
+		}
+
+		simulationWake.notify_all();
+		simulationThread.join();
+
+		//nothing runs on its own anymore and only what's in the front snapshot was still waiting on being drawn
+		deleteQueued();
+	}
+
+	bool RenderPipeline::isEnabled() {
+		return enabled;
+	}
+
+	void RenderPipeline::close() {
+		setEnabled(false);
+
+		for (size_t i = 0; i < snapshots.size(); ++i)
+			snapshots[i] = RenderSnapshot();
+	}
+
+	void RenderPipeline::simulationLoop() {
+		ScopeProfiler::setThreadName("Simulation");
+
+		std::unique_lock<std::mutex> lock(simulationMutex);
+
+		while (true) {
+			simulationWake.wait(lock, [] { return hasJob || !running; });
+
+			//a frame that got started still gets finished, endFrame is waiting on it
+			if (!hasJob)
+				break;
+
+			lock.unlock();
+
+			{
+				ProfileMethod("Simulation");
+				job(*jobSnapshot);
+			}
+
+			lock.lock();
+			hasJob = false;
+			simulationDone.notify_all();
+		}
+	}
+
+	void RenderPipeline::beginFrame(const std::function<void(RenderSnapshot& snapshot)>& simulate) {
+		RenderSnapshot& back = snapshots[1 - front];
+
+		back.clear();
+		back.frameNumber = ++frameNumber;
+
+		if (!enabled) {
+			ProfileMethod("Simulation");
+			simulate(back);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(simulationMutex);
+			job = simulate;
+			jobSnapshot = &back;
+			hasJob = true;
+		}
+
+		simulationWake.notify_one();
+	}
+
+	RenderSnapshot& RenderPipeline::getFront() {
+		return snapshots[front];
+	}
+
+	void RenderPipeline::endFrame() {
+		if (enabled) {
+			ProfileMethod("Waiting on simulation");
+
+			std::unique_lock<std::mutex> lock(simulationMutex);
+			simulationDone.wait(lock, [] { return !hasJob; });
+			job = nullptr;
+		}
+
+		front = 1 - front;
+
+		//the old front got drawn and the new one was extracted after anything the simulation destroyed was gone
+		deleteQueued();
+	}
+
+	size_t RenderPipeline::getFrameNumber() {
+		return frameNumber;
+	}
+
+	void RenderPipeline::setBackend(const RenderPipelineBackend& _backend) {
+		backend = _backend;
+	}
+
+	void RenderPipeline::deleteVertexArray(const unsigned int& VAO) {
+		if (!enabled) {
+			deleteVertexArrays(1, &VAO);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(deletionMutex);
+		deletedVertexArrays.push_back(VAO);
+	}
+
+	size_t RenderPipeline::getQueuedDeletions() {
+		std::lock_guard<std::mutex> lock(deletionMutex);
+		return deletedVertexArrays.size();
+	}
+
+}
@@ -0,0 +1,52 @@
+#ifndef HFR_RENDER_PIPELINE_HEADER_INCLUDE
+#define HFR_RENDER_PIPELINE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_RENDER_SNAPSHOT
+
+namespace HFR {
+
+	//the gl calls the pipeline makes itself, an empty one is gl, checks without a gl context hand in one that counts instead
+	struct DLL_API RenderPipelineBackend {
+		std::function<void(const size_t& amount, const unsigned int* vertexArrays)> deleteVertexArrays;
+	};
+
+	//two stage frames, the simulation of the next frame runs on its own thread while the thread with the gl context draws the snapshot of the last one,
+	//a frame goes beginFrame (simulation starts on the back snapshot), drawing getFront(), endFrame (waits for the simulation and swaps the two)
+	class DLL_API RenderPipeline {
+	private:
+		static std::array<RenderSnapshot, 2> snapshots;
+		static size_t front;
+		static size_t frameNumber;
+		static bool enabled;
+
+		static void simulationLoop();
+
+	public:
+		//starts or stops the simulation thread, only between frames, while it's off beginFrame runs the simulation right away on the calling thread
+		static void setEnabled(const bool& enabled);
+		static bool isEnabled();
+		static void close();
+
+		//simulate gets the cleared back snapshot to extract into once it's done simulating, it can't make gl calls
+		static void beginFrame(const std::function<void(RenderSnapshot& snapshot)>& simulate);
+		//the snapshot the last endFrame handed over, only the thread that calls beginFrame and endFrame can look at it
+		static RenderSnapshot& getFront();
+		//returns once the simulation is done, then the snapshot it made is the front one
+		static void endFrame();
+
+		static size_t getFrameNumber();
+
+		//only between frames, an empty one goes back to gl
+		static void setBackend(const RenderPipelineBackend& backend);
+
+		//deletes it right away while the pipeline is off, while it's on the front snapshot could still be drawing it and the simulation thread
+		//has no gl context, so it waits for the next endFrame (meshes that die on either thread go through this)
+		static void deleteVertexArray(const unsigned int& VAO);
+		//vertex arrays waiting for endFrame
+		static size_t getQueuedDeletions();
+	};
+
+}
+
+#endif
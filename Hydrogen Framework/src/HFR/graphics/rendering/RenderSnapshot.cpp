@@ -0,0 +1,65 @@
+#include "hfpch.h"
+#include HFR_RENDER_SNAPSHOT
+
+namespace HFR {
+
+	void RenderView::setCamera(const Camera& _camera) {
+		camera = _camera;
+		viewMatrix = Mat4f::createViewMatrix(_camera.position, _camera.rotation);
+	}
+
+	DrawGeometry DrawGeometry::fromMesh(const Mesh& mesh) {
+		DrawGeometry geometry;
+
+		geometry.VAO = mesh.VAO;
+		geometry.IBO = mesh.IBO;
+		geometry.indexed = !mesh.indices.empty();
+		geometry.count = geometry.indexed ? (unsigned int)mesh.indices.size() : (unsigned int)(mesh.vertices.size() / mesh.type);
+		geometry.hasTextureCoords = !mesh.texturecoords.empty();
+		geometry.useLighting = mesh.useLighting;
+		geometry.radius = mesh.radius;
+
+		return geometry;
+	}
+
+	void RenderSnapshot::clear() {
+		frameNumber = 0;
+		packets.clear();
+		pendingMeshes.clear();
+		interpolationAlpha = 0;
+	}
+
+	void RenderSnapshot::add(Mesh& mesh, const Mat4f& transform) {
+		if (mesh.vertices.empty())
+			return;
+
+		if (!mesh.created) {
+			pendingMeshes.push_back(&mesh);
+			return;
+		}
+
+		packets.emplace_back();
+
+		DrawPacket& packet = packets.back();
+		packet.geometry = DrawGeometry::fromMesh(mesh);
+		packet.transform = transform;
+
+		//one material per packet, the same packet usually has the same mesh as last time so it's almost always already there
+		packet.material = (unsigned int)(packets.size() - 1);
+
+		if (packet.material == materials.size())
+			materials.push_back(mesh.material);
+		else if (materials[packet.material] != mesh.material)
+			materials[packet.material] = mesh.material;
+	}
+
+	void RenderSnapshot::finish() {
+		if (materials.size() > packets.size())
+			materials.erase(materials.begin() + packets.size(), materials.end());
+	}
+
+	const Material& RenderSnapshot::getMaterial(const DrawPacket& packet) const {
+		return materials[packet.material];
+	}
+
+}
@@ -0,0 +1,71 @@
+#ifndef HFR_RENDER_SNAPSHOT_HEADER_INCLUDE
+#define HFR_RENDER_SNAPSHOT_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_MAT4
+#include HFR_CAMERA
+#include HFR_LIGHT
+#include HFR_MESH
+
+namespace HFR {
+
+	//what a frame is seen with, the renderer draws with the view of the snapshot it's drawing
+	struct DLL_API RenderView {
+		Camera camera;
+		Mat4f viewMatrix;
+		Light light;
+
+		void setCamera(const Camera& camera);
+	};
+
+	//the gpu side of a mesh, everything a draw needs without touching the mesh again
+	struct DLL_API DrawGeometry {
+		unsigned int VAO = 0;
+		unsigned int IBO = 0;
+		//indices when indexed, vertices otherwise
+		unsigned int count = 0;
+		bool indexed = false;
+		bool hasTextureCoords = false;
+		bool useLighting = true;
+		float radius = 0;
+
+		static DrawGeometry fromMesh(const Mesh& mesh);
+	};
+
+	struct DLL_API DrawPacket {
+		DrawGeometry geometry;
+		Mat4f transform;
+		//into the materials of the snapshot the packet is in
+		unsigned int material = 0;
+	};
+
+	//everything the render stage needs from one simulated frame, it owns copies of all of it so nothing in it changes once it's handed over
+	struct DLL_API RenderSnapshot {
+		size_t frameNumber = 0;
+		RenderView view;
+		std::vector<DrawPacket> packets;
+		//copies of what the packets get drawn with, the simulation can change the ones in the scene while this gets drawn. they stay
+		//through clear and a mesh only gets its material copied over again when it changed since this snapshot was extracted into last,
+		//so a scene whose materials stay the same doesn't copy a single texture handle
+		std::vector<Material> materials;
+		//Time::getInterpolationAlpha() when the frame was extracted, the interpolated transforms in packets are already blended with it
+		float interpolationAlpha = 0;
+
+		//meshes extraction found that aren't on the gpu yet, they get created on the render thread while the simulation isn't running
+		//and show up in the next snapshot (the pointers are only good until the simulation runs again)
+		std::vector<Mesh*> pendingMeshes;
+
+		//keeps the memory and the materials so extracting into it again doesn't allocate or copy
+		void clear();
+		//lets go of the materials past the last packet once extraction is done, so textures nothing draws anymore can be freed
+		void finish();
+
+		const Material& getMaterial(const DrawPacket& packet) const;
+
+		//adds a draw of every mesh that's created, the rest goes into pendingMeshes
+		void add(Mesh& mesh, const Mat4f& transform);
+	};
+
+}
+
+#endif
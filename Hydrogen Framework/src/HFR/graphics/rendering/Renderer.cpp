@@ -7,11 +7,8 @@
 namespace HFR {
 
 	Mat4f Renderer::perspectiveMatrix = Mat4f();
-	Mat4f Renderer::viewMatrix = Mat4f();
 
-	Camera Renderer::camera = Camera();
-	
-	Light Renderer::light = Light();
+	RenderView Renderer::view = RenderView();
 
 	Shader Renderer::mainShader = HFR::Shader(HFR_RES + "shaders/", "MainVertex.glsl", "MainFragment.glsl");
 
@@ -66,12 +63,16 @@ namespace HFR {
 	}
 
 	void Renderer::createProjectionMatrix(const float& screenWidth, const float& screenHeight) {
-		perspectiveMatrix = Mat4f::createPerspectiveMatrix(screenWidth, screenHeight, 90, 0.1f, 1000);
+		setWindowSize(screenWidth, screenHeight);
+		
+		glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
+	}
+
+	void Renderer::setWindowSize(const float& screenWidth, const float& screenHeight) {
+		perspectiveMatrix = Mat4f::createPerspectiveMatrix(screenWidth, screenHeight, HFR_FIELD_OF_VIEW, 0.1f, 1000);
 
 		currentWindowSize.x = screenWidth;
 		currentWindowSize.y = screenHeight;
-		
-		glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 	}
 
 	void Renderer::close() {
@@ -88,8 +89,7 @@ namespace HFR {
 	}
 
 	void Renderer::setCamera(const Camera& _camera) {
-		viewMatrix = Mat4f::createViewMatrix(_camera.position, _camera.rotation);
-		camera = _camera;
+		view.setCamera(_camera);
 	}
 
 	void Renderer::setWireFrameMode(const bool& in) {
@@ -148,15 +148,39 @@ namespace HFR {
 	}
 
 	void Renderer::render(Mesh& mesh, const Shader& shader, const Transform& transform, const Texture& texture) {
-		render(mesh, shader, transform.position, transform.rotation, transform.scale, texture);
+		render(mesh, shader, transform.worldMatrix, texture);
 	}
 
 	void Renderer::render(Mesh& mesh, const Transform& transform, const Texture& texture) {
-		render(mesh, mainShader, transform.position, transform.rotation, transform.scale, texture);
+		render(mesh, mainShader, transform, texture);
+	}
+
+	void Renderer::render(const MeshHandle& meshes, const Transform& transform) {
+		render(meshes, mainShader, transform);
+	}
+
+	void Renderer::render(const MeshHandle& meshes, const Shader& shader, const Transform& transform) {
+		if (!meshes.isReady())
+			return;
+
+		std::vector<Mesh>& loaded = meshes.get();
+
+		for (size_t i = 0; i < loaded.size(); ++i) {
+			if (!loaded[i].vertices.empty())
+				render(loaded[i], shader, transform, getTexture(loaded[i].material.diffuseMap));
+		}
+	}
+
+	const Texture& Renderer::getTexture(const Texture& texture) {
+		return texture.isCreated ? texture : nullTexture;
+	}
+
+	const Texture& Renderer::getTexture(const TextureHandle& texture) {
+		return texture.isReady() ? texture.get() : nullTexture;
 	}
 
 	void Renderer::loadLight(const Light& _light) {
-		light = _light;
+		view.light = _light;
 	}
 
 	//position and size in pixels
@@ -358,18 +382,46 @@ namespace HFR {
 	//}
 
 	void Renderer::render(Mesh& mesh, const Shader& shader, const Vec3f& position, const Vec3f& rotation, const Vec3f& scale, const Texture& texture) {
-		glBindVertexArray(mesh.VAO);
+		render(mesh, shader, Mat4f::createTransformationMatrix(position, rotation, scale), texture);
+	}
+
+	void Renderer::render(Mesh& mesh, const Shader& shader, const Mat4f& transform, const Texture& texture) {
+		draw(DrawGeometry::fromMesh(mesh), mesh.material, shader, transform);
+	}
+
+	void Renderer::render(const RenderSnapshot& snapshot) {
+		view = snapshot.view;
+
+		{
+			ProfileGpuTime("Scene");
+
+			for (size_t i = 0; i < snapshot.packets.size(); ++i)
+				draw(snapshot.packets[i].geometry, snapshot.getMaterial(snapshot.packets[i]), mainShader, snapshot.packets[i].transform);
+		}
+
+		update();
+	}
+
+	void Renderer::draw(const DrawGeometry& geometry, const Material& material, const Shader& shader, const Mat4f& transform) {
+		glBindVertexArray(geometry.VAO);
 		glEnableVertexAttribArray(0);
 		glEnableVertexAttribArray(1);
 		glEnableVertexAttribArray(2);
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.IBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.IBO);
 
 		shader.bind();
 		//Debug::log("test");
 		//mesh.material.bindLightMaps(shader);
 		
-		shader.bindLightMaps(mesh.material);
+		shader.bindLightMaps(material);
+
+		//the streamer needs to know how big the maps end up on screen to pick their levels
+		float scale = sqrtf(max(transform.m00 * transform.m00 + transform.m01 * transform.m01 + transform.m02 * transform.m02,
+			max(transform.m10 * transform.m10 + transform.m11 * transform.m11 + transform.m12 * transform.m12,
+				transform.m20 * transform.m20 + transform.m21 * transform.m21 + transform.m22 * transform.m22)));
+
+		TextureStreamer::markVisible(material, Vec3f(transform.m30, transform.m31, transform.m32), geometry.radius * scale);
 
 		//glActiveTexture(GL_TEXTURE0);
 
@@ -382,30 +434,37 @@ namespace HFR {
 			glBindTexture(GL_TEXTURE_2D, nullTexture.textureID);*/
 
 		//matrix stuff
-		Mat4f transform = Mat4f::createTransformationMatrix(position, rotation, scale);
-		Mat4f projectionViewTransform = perspectiveMatrix * viewMatrix * transform;
+		Mat4f projectionViewTransform = perspectiveMatrix * view.viewMatrix * transform;
 		//Mat4f projectionTransform = perspectiveMatrix * transform;
 
 		shader.setUniform("transformMatrix", transform);
 		shader.setUniform("projectionViewTransformMatrix", projectionViewTransform);
-		shader.setUniform("hasTextureCoords", !mesh.texturecoords.empty());
+		shader.setUniform("hasTextureCoords", geometry.hasTextureCoords);
 
 		//light things
 		//shader.setUniform("lightMode", light.usePerPixelLighting);
-		shader.setUniform("useLighting", mesh.useLighting);
-		shader.setUniform("cameraPosition", camera.position);
+		shader.setUniform("useLighting", geometry.useLighting);
+		shader.setUniform("cameraPosition", view.camera.position);
 
 		//light parameters
-		shader.setUniform("light.position", light.position);
-		shader.setUniform("light.diffuseColor", light.diffuseColor);
-		shader.setUniform("light.ambientColor", light.ambientColor);
-		shader.setUniform("light.specularColor", light.specularColor);
-
-		//stupid cast size_t to GLsizei warning
-		if (!mesh.indices.empty())
-			glDrawElements(GL_TRIANGLES, (int)mesh.indices.size(), GL_UNSIGNED_INT, 0);
-		else if(!mesh.vertices.empty())
-			glDrawArrays(GL_TRIANGLES, 0, (int)mesh.vertices.size() / mesh.type);
+		shader.setUniform("light.position", view.light.position);
+		shader.setUniform("light.diffuseColor", view.light.diffuseColor);
+		shader.setUniform("light.ambientColor", view.light.ambientColor);
+		shader.setUniform("light.specularColor", view.light.specularColor);
+
+		{
+			ProfileGpu("Mesh draw");
+
+			//stupid cast size_t to GLsizei warning
+			if (geometry.indexed) {
+				glDrawElements(GL_TRIANGLES, (int)geometry.count, GL_UNSIGNED_INT, 0);
+				FrameTelemetry::countDraw(geometry.count / 3);
+			}
+			else if (geometry.count > 0) {
+				glDrawArrays(GL_TRIANGLES, 0, (int)geometry.count);
+				FrameTelemetry::countDraw(geometry.count / 3);
+			}
+		}
 
 		shader.unbind();
 
@@ -518,8 +577,8 @@ namespace HFR {
 	//}
 
 	void Renderer::update() {
-		lightObject.meshes[0].material.diffuseColor = light.diffuseColor;
-		render(lightObject.meshes[0], Transform(light.position, Vec3f(), Vec3f(1, 1, 1)), Texture());
+		lightObject.meshes[0].material.diffuseColor = view.light.diffuseColor;
+		render(lightObject.meshes[0], Transform(view.light.position, Vec3f(), Vec3f(1, 1, 1)), Texture());
 	}
 
 }
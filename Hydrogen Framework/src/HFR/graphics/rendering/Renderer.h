@@ -11,6 +11,8 @@
 #include HFR_LIGHT
 #include HFR_MESH_COMPONENT
 #include HFR_CAMERA
+#include HFR_ASSET_HANDLE
+#include HFR_RENDER_SNAPSHOT
 
 namespace HFR {
 
@@ -29,6 +31,8 @@ namespace HFR {
 		//const static std::vector<float> quadVertices;
 		static Vec2f currentWindowSize;
 
+		static void draw(const DrawGeometry& geometry, const Material& material, const Shader& shader, const Mat4f& transform);
+
 	public:
 		static Shader mainShader;
 		/*static Shader guiShader;
@@ -40,15 +44,15 @@ namespace HFR {
 		static Mat4f perspectiveMatrix;
 		/*static Mat4f orthoMatrix;
 		static Mat4f pixelOrthoMatrix;*/
-		static Mat4f viewMatrix;
 
-		static Light light;
+		//camera, view matrix and light of the snapshot being drawn, or whatever setCamera and loadLight set when drawing right away
+		static RenderView view;
 		static MeshComponent lightObject;
 
-		static Camera camera;
-
 		static void init(const float& screenWidth, const float& screenHeight);
 		static void createProjectionMatrix(const float& screenWidth, const float& screenHeight);
+		//createProjectionMatrix without the glViewport, for running without a gl context
+		static void setWindowSize(const float& screenWidth, const float& screenHeight);
 		static void close();
 		static void setCamera(const Camera& camera);
 
@@ -74,9 +78,24 @@ namespace HFR {
 		static void render(Mesh& mesh, const Vec3f& position, const Vec3f& rotation, const Vec3f& scale, const Texture& texture);
 		static void render(Mesh& mesh, const Shader& shader, const Vec3f& position, const Vec3f& rotation, const Vec3f& scale, const Texture& texture);
 
+		//these draw the world matrix, so the transform has to have been through the transform pass since it last moved
+		//(Scene::updateTransforms for scene objects, TransformSystem::update for transforms that aren't in a scene)
 		static void render(Mesh& mesh, const Transform& transform, const Texture& texture);
 		static void render(Mesh& mesh, const Shader& shader, const Transform& transform, const Texture& texture);
 
+		static void render(Mesh& mesh, const Shader& shader, const Mat4f& transform, const Texture& texture);
+
+		//draws every packet with the snapshots view and the light after them, only on the thread with the context
+		static void render(const RenderSnapshot& snapshot);
+
+		//draws the meshes once the loader has uploaded them, nothing while they're still loading
+		static void render(const MeshHandle& meshes, const Transform& transform);
+		static void render(const MeshHandle& meshes, const Shader& shader, const Transform& transform);
+
+		//nullTexture until the texture is on the gpu
+		static const Texture& getTexture(const Texture& texture);
+		static const Texture& getTexture(const TextureHandle& texture);
+
 		/*static void renderRectangle(const Vec2f& position, const Vec2f& size, const Texture& texture);
 		static void renderRectangle(const Vec2f& position, const Vec2f& size, const Vec3f& color);
 		static void renderRectangle(const Vec2f& position, const Vec2f& size, const float& rotation, const Vec3f& color);
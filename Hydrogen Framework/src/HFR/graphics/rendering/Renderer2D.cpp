@@ -6,14 +6,13 @@ namespace HFR {
 	Shader Renderer2D::guiFrameShader = HFR::Shader(HFR_RES + "shaders/", "guiVertex.glsl", "guiFrameFragment.glsl");
 	Shader Renderer2D::guiImageShader = HFR::Shader(HFR_RES + "shaders/", "guiVertex.glsl", "guiImageFragment.glsl");
 	Shader Renderer2D::guiTextShader = HFR::Shader(HFR_RES + "shaders/", "guiTextVertex.glsl", "guiTextFragment.glsl");
+	Shader Renderer2D::guiTextSdfShader = HFR::Shader(HFR_RES + "shaders/", "guiTextVertex.glsl", "guiTextSdfFragment.glsl");
+	Shader Renderer2D::guiCompositeShader = HFR::Shader(HFR_RES + "shaders/", "guiVertex.glsl", "guiCompositeFragment.glsl");
 
 
 	Mat4f Renderer2D::orthoMatrix = Mat4f::createOrthoMatrix(-1, 1, -1, 1, -1, 1);
 	Mat4f Renderer2D::pixelOrthoMatrix = Mat4f::createOrthoMatrix(-1, 1, -1, 1, -1, 1);
 
-	const std::vector<float> Renderer2D::quadVertices = { -1, 1,  -1, -1,  1, 1, 1, -1 };
-	Mesh Renderer2D::quad = Mesh(quadVertices, std::vector<unsigned int>(), std::vector<float>(), std::vector<float>());
-	
 	Vec2f Renderer2D::currentWindowSize = Vec2f();
 
 	void Renderer2D::init(const float& screenWidth, const float& screenHeight) {
@@ -22,14 +21,16 @@ namespace HFR {
 
 		setAlphaBlending(true);
 
-		quad.type = HFR_2D;
-		quad.create();
-
 		Debug::systemLog("Creating gui shaders");
 
 		guiFrameShader.create();
 		guiImageShader.create();
 		guiTextShader.create();
+		guiTextSdfShader.create();
+		guiCompositeShader.create();
+
+		QuadBatcher::init();
+		TextBatcher::init();
 
 		createProjectionMatrix(screenWidth, screenHeight);
 
@@ -39,10 +40,14 @@ namespace HFR {
 	}
 
 	void Renderer2D::createProjectionMatrix(const float& screenWidth, const float& screenHeight) {
-		currentWindowSize.x = screenWidth;
-		currentWindowSize.y = screenHeight;
+		setWindowSize(screenWidth, screenHeight);
 
 		glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
+	}
+
+	void Renderer2D::setWindowSize(const float& screenWidth, const float& screenHeight) {
+		currentWindowSize.x = screenWidth;
+		currentWindowSize.y = screenHeight;
 
 		//for use with pixel sized gui (top left coordinate system btw)
 		pixelOrthoMatrix = Mat4f::createOrthoMatrix(0, 2 * screenWidth, -2 * screenHeight, 0, -1, 1);
@@ -58,7 +63,11 @@ namespace HFR {
 		guiFrameShader.close();
 		guiImageShader.close();
 		guiTextShader.close();
+		guiTextSdfShader.close();
+		guiCompositeShader.close();
 
+		QuadBatcher::close();
+		TextBatcher::close();
 	}
 
 	void Renderer2D::setDepthTest(const bool& in) {
@@ -71,7 +80,8 @@ namespace HFR {
 	void Renderer2D::setAlphaBlending(const bool& in) {
 		if (in) {
 			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			//alpha adds up the way it should so things drawn into a transparent framebuffer (the gui canvas) keep their coverage
+			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 		}else
 			glDisable(GL_BLEND);
 	}
@@ -80,167 +90,63 @@ namespace HFR {
 		return currentWindowSize.x / currentWindowSize.y;
 	}
 
-	void Renderer2D::render(const GuiFrame& frame) {
-
-		glBindVertexArray(quad.VAO);
-		glEnableVertexAttribArray(0);
-
-		guiFrameShader.bind();
-
-		Vec2f uiPosition;
-
-		Mat4f transform;
-		Mat4f outlineTransform;
+	Vec2f Renderer2D::getCurrentWindowSize() {
+		return currentWindowSize;
+	}
 
-		//matrix stuff
-		if (frame.sizeType == HFR_SCREEN_SPACE_SIZE) {
+	void Renderer2D::placeQuad(GuiQuad& quad, const Vec2f& position, const Vec2f& size, const float& rotation, const Vec2f& anchorPoint, const int& sizeType) {
+		const Vec2f anchorOffset = Vec2f(size.x - size.x * anchorPoint.x * 2, -size.y + size.y * anchorPoint.y * 2);
+		const Mat4f* projection = &pixelOrthoMatrix;
 
-			uiPosition = Vec2f(frame.position.x * 2 * Renderer::getAspectRatio(), -frame.position.y * 2) + Vec2f(frame.size.x - frame.size.x * frame.anchorPoint.x * 2, -frame.size.y + frame.size.y * frame.anchorPoint.y * 2);
+		Vec2f translation;
 
-			transform = orthoMatrix * Mat4f::createTransformationMatrix(uiPosition, Vec3f(0, 0, frame.rotation), frame.size);
+		if (sizeType == HFR_SCREEN_SPACE_SIZE) {
+			translation = Vec2f(position.x * 2 * Renderer::getAspectRatio(), -position.y * 2) + anchorOffset;
+			projection = &orthoMatrix;
 
 			//because dank aspect ratio madness fuck me
 			if (currentWindowSize.x < currentWindowSize.y)
-				guiFrameShader.setUniform("uiSize", Vec2f(frame.size.x * currentWindowSize.x, frame.size.y * currentWindowSize.x));
+				quad.pixelSize = Vec2f(size.x * currentWindowSize.x, size.y * currentWindowSize.x);
 			else
-				guiFrameShader.setUniform("uiSize", Vec2f(frame.size.x * currentWindowSize.y, frame.size.y * currentWindowSize.y));
-
+				quad.pixelSize = Vec2f(size.x * currentWindowSize.y, size.y * currentWindowSize.y);
 		}
-		else if (frame.sizeType == HFR_PIXEL_SIZE) {
-
-			transform = pixelOrthoMatrix * Mat4f::createTransformationMatrix(Vec2f(frame.position.x * 2, -frame.position.y * 2) + Vec2f(frame.size.x - frame.size.x * frame.anchorPoint.x * 2, -frame.size.y + frame.size.y * frame.anchorPoint.y * 2), Vec3f(0, 0, frame.rotation), frame.size);
-
-			guiFrameShader.setUniform("uiSize", frame.size);
+		else {
+			translation = Vec2f(position.x * 2, -position.y * 2) + anchorOffset;
+			quad.pixelSize = size;
 		}
 
-		guiFrameShader.setUniform("transform", transform);
-		guiFrameShader.setUniform("color", frame.backgroundColor);
-		guiFrameShader.setUniform("borderColor", frame.borderColor);
-		guiFrameShader.setUniform("borderSize", (float)frame.borderSize);
-		guiFrameShader.setUniform("cornerRadius", (float)frame.roundedCornerRadius);
-		guiFrameShader.setUniform("aspectRatio", getAspectRatio());
+		//same as projection * Mat4f::createTransformationMatrix(translation, Vec3f(0, 0, rotation), size) but only the parts a flat quad uses
+		const float angle = (float)HMath::toRadians(rotation);
+		const float sinZ = (float)sin(angle);
+		const float cosZ = (float)cos(angle);
 
+		const Vec2f scale = Vec2f(projection->m00, projection->m11);
 
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, (int)quad.vertices.size());
+		quad.axisX = Vec2f(scale.x * cosZ * size.x, scale.y * sinZ * size.x);
+		quad.axisY = Vec2f(scale.x * -sinZ * size.y, scale.y * cosZ * size.y);
+		quad.origin = Vec2f(scale.x * translation.x + projection->m30, scale.y * translation.y + projection->m31);
+	}
 
-		guiFrameShader.unbind();
+	void Renderer2D::render(const GuiFrame& frame) {
+		GuiQuad quad;
+		placeQuad(quad, frame.position, frame.size, frame.rotation, frame.anchorPoint, frame.sizeType);
 
-		glDisableVertexAttribArray(0);
-		glBindVertexArray(0);
+		QuadBatcher::submit(quad, *frame.createQuad(quad));
 	}
 
 	void Renderer2D::render(const GuiImage& image) {
+		GuiQuad quad;
+		placeQuad(quad, image.position, image.size, image.rotation, image.anchorPoint, image.sizeType);
 
-		glBindVertexArray(quad.VAO);
-		glEnableVertexAttribArray(0);
-
-		guiImageShader.bind();
-
-		Vec2f uiPosition;
-
-		Mat4f transform;
-		Mat4f outlineTransform;
-
-		//matrix stuff
-		if (image.sizeType == HFR_SCREEN_SPACE_SIZE) {
-
-			uiPosition = Vec2f(image.position.x * 2 * Renderer::getAspectRatio(), -image.position.y * 2) + Vec2f(image.size.x - image.size.x * image.anchorPoint.x * 2, -image.size.y + image.size.y * image.anchorPoint.y * 2);
-
-			transform = orthoMatrix * Mat4f::createTransformationMatrix(uiPosition, Vec3f(0, 0, image.rotation), image.size);
-
-			//because dank aspect ratio madness fuck me
-			if (currentWindowSize.x < currentWindowSize.y)
-				guiImageShader.setUniform("uiSize", Vec2f(image.size.x * currentWindowSize.x, image.size.y * currentWindowSize.x));
-			else
-				guiImageShader.setUniform("uiSize", Vec2f(image.size.x * currentWindowSize.y, image.size.y * currentWindowSize.y));
-
-		}
-		else if (image.sizeType == HFR_PIXEL_SIZE) {
-
-			transform = pixelOrthoMatrix * Mat4f::createTransformationMatrix(Vec2f(image.position.x * 2, -image.position.y * 2) + Vec2f(image.size.x - image.size.x * image.anchorPoint.x * 2, -image.size.y + image.size.y * image.anchorPoint.y * 2), Vec3f(0, 0, image.rotation), image.size);
-
-			guiImageShader.setUniform("uiSize", image.size);
-		}
-
-		guiImageShader.setUniform("transform", transform);
-		guiImageShader.setUniform("color", image.color);
-
-		guiImageShader.setUniform("angle", (float)HMath::toRadians(image.radialFill));
-		guiImageShader.setUniform("offsetAngle", (float)HMath::toRadians(image.radialFillAngleOffset));
-		guiImageShader.setUniform("radialFillOffset", image.radialFillOffset);
-		guiImageShader.setUniform("radialFillFlipped", image.radialFillInverse);
-
-		if (image.texture.image.hasData()) {
-			guiImageShader.setUniform("hasTextureCoords", true);
-			
-			glActiveTexture(GL_TEXTURE0);
-			glEnable(GL_TEXTURE_2D);
-			glBindTexture(GL_TEXTURE_2D, image.texture.textureID);
-		}
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, (int)quad.vertices.size());
-
-		guiImageShader.unbind();
-
-		glDisableVertexAttribArray(0);
-		glBindVertexArray(0);
+		QuadBatcher::submit(quad, *image.createQuad(quad));
 	}
 
 	void Renderer2D::render(const GuiText& text) {
-		setDepthTest(false);
-		setAlphaBlending(true);
-
-		glBindVertexArray(text.mesh.VAO);
-		glEnableVertexAttribArray(0);
-		glEnableVertexAttribArray(1);
-
-		guiTextShader.bind();
-
-		glActiveTexture(GL_TEXTURE0);
-
-		glEnable(GL_TEXTURE_2D);
-		glBindTexture(GL_TEXTURE_2D, text.font.texture.textureID);
-
-
-		guiTextShader.setUniform("color", text.color);
-
-		if (!text.mesh.vertices.empty())
-			glDrawArrays(GL_TRIANGLES, 0, (int)text.mesh.vertices.size() / text.mesh.type);
-
-
-		glDisableVertexAttribArray(0);
-		glDisableVertexAttribArray(1);
-		glBindVertexArray(0);
-
-		guiTextShader.unbind();
-
-		setDepthTest(true);
-		setAlphaBlending(false);
+		TextBatcher::submit(text);
 	}
 
 	void Renderer2D::renderGuis() {
-		setDepthTest(false);
-		setAlphaBlending(true);
-
-
-		for (size_t i = 0; i < Engine::guiFrames.size(); ++i) {
-			auto& frame = Engine::guiFrames[i];
-			if (frame->active && frame->draggable && frame->isSelected())
-				frame->position += frame->sizeType == HFR_PIXEL_SIZE ? Vec2f(Input::getMouseMovement().x / 2, Input::getMouseMovement().y / 2) : Vec2f(Input::getMouseMovementScreenSpace().x / 2, Input::getMouseMovementScreenSpace().y / 2);
-
-			if (frame->visible)
-				Renderer2D::render(*frame);
-		}
-
-
-		for (size_t i = 0; i < Engine::guiImages.size(); ++i) {
-			auto& image = Engine::guiImages[i];
-
-			if (image->visible)
-				Renderer2D::render(*image);
-		}
-		setDepthTest(true);
-		setAlphaBlending(false);
+		GuiCanvas::render();
 	}
 
 }
\ No newline at end of file
@@ -11,14 +11,14 @@
 #include HFR_GUI_FRAME
 #include HFR_GUI_IMAGE
 #include HFR_GUI_TEXT
+#include HFR_QUAD_BATCHER
+#include HFR_TEXT_BATCHER
 
 namespace HFR {
 
 	class DLL_API Renderer2D {
 	private:
 		static bool wireframe;
-		static Mesh quad;
-		const static std::vector<float> quadVertices;
 		static Vec2f currentWindowSize;
 
 	public:
@@ -26,16 +26,24 @@ namespace HFR {
 		static Shader guiFrameShader;
 		static Shader guiImageShader;
 		static Shader guiTextShader;
+		static Shader guiTextSdfShader;
+		//puts the gui framebuffer on screen
+		static Shader guiCompositeShader;
 
 		static Mat4f orthoMatrix;
 		static Mat4f pixelOrthoMatrix;
 
 		static void init(const float& screenWidth, const float& screenHeight);
 		static void createProjectionMatrix(const float& screenWidth, const float& screenHeight);
+		//createProjectionMatrix without the glViewport, for running without a gl context
+		static void setWindowSize(const float& screenWidth, const float& screenHeight);
 		static void close();
 
 		static float getAspectRatio();
-		//static Vec2f getCurrentWindowSize();
+		static Vec2f getCurrentWindowSize();
+
+		//corners and pixel size of a gui element, the same math for every kind of element
+		static void placeQuad(GuiQuad& quad, const Vec2f& position, const Vec2f& size, const float& rotation, const Vec2f& anchorPoint, const int& sizeType);
 
 		/*static void setWireFrameMode(const bool& wireframe);
 		static void toggleWireFrameMode();
@@ -54,10 +62,13 @@ namespace HFR {
 		static void radialRevealRectangle(const Vec2f& position, const Vec2f& size, const float& angle, const float& offset, const bool& flipped, const Texture& texture);
 		static void radialRevealRectangle(const Vec2f& position, const Vec2f& size, const float& angle, const float& offset, const bool& flipped, const Vec3f& color);*/
 
+		//frames and images only get queued, QuadBatcher::flush draws them in order before the text
 		static void render(const GuiFrame& frame);
 		static void render(const GuiImage& image);
+		//only queues the text, it gets drawn with all the other text of the frame when TextBatcher::flush runs
 		static void render(const GuiText& text);
 
+		//lays out and draws whatever changed in the gui canvas, then queues it to be put on screen
 		static void renderGuis();
 	};
 
@@ -47,11 +47,9 @@ namespace HFR {
 		return glGetAttribLocation(programID, name);
 	}
 
-	void Shader::setUniform(const char* name, Mat4f& data) const{
-		FloatBuffer* matbuffer = new FloatBuffer(16);
-		data.store(matbuffer);
-		glUniformMatrix4fv(getUniformLocation(name), 1, false, matbuffer->data);
-		delete matbuffer;
+	void Shader::setUniform(const char* name, const Mat4f& data) const{
+		//Mat4f is already 16 column major floats so no need to copy it into a buffer
+		glUniformMatrix4fv(getUniformLocation(name), 1, false, &data.m00);
 	}
 
 	void Shader::setUniform(const char* name, const Vec2f& data) const{
@@ -88,39 +86,39 @@ namespace HFR {
 		setUniform("material.emissionColor", material.emissionColor);
 		//shader.setUniform("material.ambientIntensity", ambientIntensity);
 
-		//maps
-		if (material.diffuseMap.image.hasData()) {
+		//maps (textures that haven't been uploaded yet show up as the null texture)
+		if (material.diffuseMap.isValid() && !material.diffuseMap.isFailed()) {
 			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, material.diffuseMap.textureID);
+			glBindTexture(GL_TEXTURE_2D, Renderer::getTexture(material.diffuseMap).textureID);
 			setUniform("material.diffuseMap", (int)0);
 			setUniform("material.useDiffuseMap", true);
 		}
 		else
 			setUniform("material.useDiffuseMap", false);
 
-		if (material.ambientMap.image.hasData()) {
+		if (material.ambientMap.isValid() && !material.ambientMap.isFailed()) {
 			glActiveTexture(GL_TEXTURE1);
 			setUniform("material.ambientMap", (int)1);
 			setUniform("material.useAmbientMap", true);
-			glBindTexture(GL_TEXTURE_2D, material.ambientMap.textureID);
+			glBindTexture(GL_TEXTURE_2D, Renderer::getTexture(material.ambientMap).textureID);
 		}
 		else
 			setUniform("material.useAmbientMap", false);
 
-		if (material.specularMap.image.hasData()) {
+		if (material.specularMap.isValid() && !material.specularMap.isFailed()) {
 			glActiveTexture(GL_TEXTURE2);
 			setUniform("material.specularMap", (int)2);
 			setUniform("material.useSpecularMap", true);
-			glBindTexture(GL_TEXTURE_2D, material.specularMap.textureID);
+			glBindTexture(GL_TEXTURE_2D, Renderer::getTexture(material.specularMap).textureID);
 		}
 		else
 			setUniform("material.useSpecularMap", false);
 
-		if (material.emissionMap.image.hasData()) {
+		if (material.emissionMap.isValid() && !material.emissionMap.isFailed()) {
 			glActiveTexture(GL_TEXTURE3);
 			setUniform("material.emissionMap", (int)3);
 			setUniform("material.useEmissionMap", true);
-			glBindTexture(GL_TEXTURE_2D, material.emissionMap.textureID);
+			glBindTexture(GL_TEXTURE_2D, Renderer::getTexture(material.emissionMap).textureID);
 		}
 		else
 			setUniform("material.useEmissionMap", false);
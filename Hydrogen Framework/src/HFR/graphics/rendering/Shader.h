@@ -28,7 +28,7 @@ namespace HFR {
 		unsigned int getAttributeLocation(const char* name) const;
 
 
-		void setUniform(const char* name, Mat4f& data) const;
+		void setUniform(const char* name, const Mat4f& data) const;
 		void setUniform(const char* name, const Vec4f& data) const;
 		void setUniform(const char* name, const Vec3f& data) const;
 		void setUniform(const char* name, const Vec2f& data) const;
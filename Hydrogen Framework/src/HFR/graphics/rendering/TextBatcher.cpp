@@ -0,0 +1,393 @@
+#include "hfpch.h"
+#include HFR_TEXT_BATCHER
+#include HFR_RENDERER2D
+#include HFR_GUI_TEXT
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		//texture coordinates are atlas texels, the vertex shader divides them by the atlas size so an atlas growing doesn't move anything
+		struct TextVertex {
+			float x;
+			float y;
+			unsigned short u;
+			unsigned short v;
+			uint32_t color;
+		};
+
+		//one glyph of a laid out string, relative to where the string starts
+		struct TextQuad {
+			float left;
+			float top;
+			float right;
+			float bottom;
+			unsigned short u0;
+			unsigned short v0;
+			unsigned short u1;
+			unsigned short v1;
+		};
+
+		struct TextLayout {
+			std::string text;
+			const GlyphCache* cache = nullptr;
+			float size = 0;
+			Vec2f scale;
+			unsigned int generation = 0;
+			unsigned long long lastUsed = 0;
+			std::vector<TextQuad> quads;
+		};
+
+		//everything drawn out of one atlas
+		struct TextBatch {
+			std::shared_ptr<GlyphCache> cache;
+			std::vector<TextVertex> vertices;
+		};
+
+		std::unordered_map<uint64_t, TextLayout> layouts;
+		std::vector<TextBatch> batches;
+
+		unsigned int VAO = 0;
+		unsigned int VBO = 0;
+		unsigned int IBO = 0;
+		//in quads
+		size_t capacity = 0;
+
+		//fnv-1a over everything a layout depends on
+		uint64_t hashLayout(const std::string& text, const GlyphCache* cache, const float& size, const Vec2f& scale) {
+			uint64_t out = 14695981039346656037ull;
+
+			auto mix = [&out](const void* data, const size_t& length) {
+				const unsigned char* bytes = (const unsigned char*)data;
+
+				for (size_t i = 0; i < length; ++i) {
+					out ^= bytes[i];
+					out *= 1099511628211ull;
+				}
+			};
+
+			mix(text.data(), text.size());
+			mix(&cache, sizeof(cache));
+			mix(&size, sizeof(size));
+			mix(&scale.x, sizeof(scale.x));
+			mix(&scale.y, sizeof(scale.y));
+
+			return out;
+		}
+
+		bool matches(const TextLayout& layout, const std::string& text, const GlyphCache* cache, const float& size, const Vec2f& scale) {
+			return layout.cache == cache && layout.size == size && layout.scale.x == scale.x && layout.scale.y == scale.y &&
+				layout.generation == cache->getGeneration() && layout.text == text;
+		}
+
+		void createLayout(TextLayout& layout, const std::string& text, GlyphCache& cache, const float& size, const Vec2f& scale) {
+			//glyphs that aren't in the atlas yet have to be there before anything gets read out of it
+			cache.cacheText(text);
+
+			layout.text = text;
+			layout.cache = &cache;
+			layout.size = size;
+			layout.scale = scale;
+			layout.generation = cache.getGeneration();
+			layout.quads.clear();
+
+			const float pixelScale = size / cache.pixelSize;
+			const Vec2f glyphScale = Vec2f(pixelScale * scale.x, pixelScale * scale.y);
+
+			Vec2f cursor = Vec2f();
+
+			for (size_t i = 0; i < text.size();) {
+				const CachedGlyph* glyph = cache.getGlyph(Util::decodeUTF8(text, i));
+
+				if (glyph == nullptr)
+					continue;
+
+				TextQuad quad;
+				quad.left = cursor.x + glyph->bitmapLeftTop.x * glyphScale.x;
+				quad.top = cursor.y + glyph->bitmapLeftTop.y * glyphScale.y;
+				quad.right = quad.left + glyph->size.x * glyphScale.x;
+				quad.bottom = quad.top - glyph->size.y * glyphScale.y;
+
+				cursor.x += glyph->advance.x * glyphScale.x;
+				cursor.y += glyph->advance.y * glyphScale.y;
+
+				//skip if glyph has no data
+				if (glyph->size.x == 0 || glyph->size.y == 0)
+					continue;
+
+				quad.u0 = (unsigned short)glyph->position.x;
+				quad.v0 = (unsigned short)glyph->position.y;
+				quad.u1 = (unsigned short)(glyph->position.x + glyph->size.x);
+				quad.v1 = (unsigned short)(glyph->position.y + glyph->size.y);
+
+				layout.quads.push_back(quad);
+			}
+		}
+	}
+
+	unsigned long long TextBatcher::frame = 0;
+	size_t TextBatcher::drawCalls = 0;
+	size_t TextBatcher::quadAmount = 0;
+	unsigned long long TextBatcher::layoutHits = 0;
+	unsigned long long TextBatcher::layoutMisses = 0;
+
+	void TextBatcher::init() {
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+		glGenBuffers(1, &IBO);
+
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, x));
+		glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, u));
+		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex), (void*)offsetof(TextVertex, color));
+
+		glEnableVertexAttribArray(0);
+		glEnableVertexAttribArray(1);
+		glEnableVertexAttribArray(2);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		reserve(HFR_TEXT_BATCH_QUADS);
+	}
+
+	void TextBatcher::close() {
+		clear();
+		batches.clear();
+		layouts.clear();
+
+		if (VAO != 0) {
+			glDeleteVertexArrays(1, &VAO);
+			glDeleteBuffers(1, &VBO);
+			glDeleteBuffers(1, &IBO);
+		}
+
+		VAO = 0;
+		VBO = 0;
+		IBO = 0;
+		capacity = 0;
+	}
+
+	void TextBatcher::reserve(const size_t& quads) {
+		if (quads <= capacity)
+			return;
+
+		capacity = max(quads, capacity * 2);
+
+		//every quad is two triangles out of its own four vertices, so one index buffer works for any mix of strings
+		std::vector<uint32_t> indices(capacity * 6);
+
+		for (size_t i = 0; i < capacity; ++i) {
+			uint32_t vertex = (uint32_t)(i * 4);
+			uint32_t* quad = &indices[i * 6];
+
+			quad[0] = vertex;
+			quad[1] = vertex + 1;
+			quad[2] = vertex + 2;
+			quad[3] = vertex + 2;
+			quad[4] = vertex + 1;
+			quad[5] = vertex + 3;
+		}
+
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		glBindVertexArray(0);
+	}
+
+	void TextBatcher::submit(const GuiText& text) {
+		submit(text.text, text.font, text.transform.position, text.transform.scale, text.color);
+	}
+
+	void TextBatcher::submit(const std::string& text, const Font& font, const Vec2f& position, const Vec2f& scale, const Vec4f& color) {
+		std::shared_ptr<GlyphCache> cache = font.getGlyphCache();
+
+		if (cache == nullptr || text.empty())
+			return;
+
+		uint64_t key = hashLayout(text, cache.get(), font.size.y, scale);
+		auto found = layouts.find(key);
+
+		if (found != layouts.end() && matches(found->second, text, cache.get(), font.size.y, scale)) {
+			layoutHits += 1;
+		}
+		else {
+			layoutMisses += 1;
+
+			//a hash collision just takes the slot over
+			found = layouts.insert(std::make_pair(key, TextLayout())).first;
+			createLayout(found->second, text, *cache, font.size.y, scale);
+		}
+
+		TextLayout& layout = found->second;
+		layout.lastUsed = frame;
+
+		TextBatch* batch = nullptr;
+
+		for (size_t i = 0; i < batches.size() && batch == nullptr; ++i) {
+			if (batches[i].cache == cache)
+				batch = &batches[i];
+		}
+
+		if (batch == nullptr) {
+			batches.push_back(TextBatch());
+			batch = &batches.back();
+			batch->cache = cache;
+		}
+
+		const uint32_t packed = Util::packColor(color);
+		const size_t start = batch->vertices.size();
+
+		batch->vertices.resize(start + layout.quads.size() * 4);
+		TextVertex* out = batch->vertices.data() + start;
+
+		for (size_t i = 0; i < layout.quads.size(); ++i, out += 4) {
+			const TextQuad& quad = layout.quads[i];
+
+			float left = position.x + quad.left;
+			float right = position.x + quad.right;
+			float top = position.y + quad.top;
+			float bottom = position.y + quad.bottom;
+
+			out[0] = { left, top, quad.u0, quad.v0, packed };
+			out[1] = { left, bottom, quad.u0, quad.v1, packed };
+			out[2] = { right, top, quad.u1, quad.v0, packed };
+			out[3] = { right, bottom, quad.u1, quad.v1, packed };
+		}
+	}
+
+	void TextBatcher::flush() {
+		ProfileMethod("Text batcher flush");
+		ProfileGpuTime("Text batches");
+
+		size_t quads = getQueuedQuadAmount();
+
+		drawCalls = 0;
+		quadAmount = quads;
+
+		if (quads > 0 && VAO != 0) {
+			reserve(quads);
+
+			glBindVertexArray(VAO);
+			glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+			//orphaning the old storage gets fresh memory from the driver instead of waiting on the draws still reading last frames text
+			glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(TextVertex), NULL, GL_STREAM_DRAW);
+
+			size_t offset = 0;
+
+			for (size_t i = 0; i < batches.size(); ++i) {
+				const std::vector<TextVertex>& vertices = batches[i].vertices;
+
+				glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(TextVertex), vertices.size() * sizeof(TextVertex), vertices.data());
+				offset += vertices.size();
+			}
+
+			Renderer2D::setDepthTest(false);
+			Renderer2D::setAlphaBlending(true);
+
+			glActiveTexture(GL_TEXTURE0);
+
+			const Shader* bound = nullptr;
+			size_t firstQuad = 0;
+
+			for (size_t i = 0; i < batches.size(); ++i) {
+				TextBatch& batch = batches[i];
+				size_t batchQuads = batch.vertices.size() / 4;
+
+				if (batchQuads == 0)
+					continue;
+
+				const Shader* shader = batch.cache->distanceField ? &Renderer2D::guiTextSdfShader : &Renderer2D::guiTextShader;
+
+				if (shader != bound) {
+					shader->bind();
+					bound = shader;
+				}
+
+				//glyphs added since the last frame might not be on the gpu yet
+				batch.cache->createTexture();
+				glBindTexture(GL_TEXTURE_2D, batch.cache->getTexture().textureID);
+
+				ProfileGpu("Text draw");
+				glDrawElements(GL_TRIANGLES, (GLsizei)(batchQuads * 6), GL_UNSIGNED_INT, (void*)(firstQuad * 6 * sizeof(uint32_t)));
+
+				firstQuad += batchQuads;
+				drawCalls += 1;
+			}
+
+			if (bound != nullptr)
+				bound->unbind();
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			Renderer2D::setDepthTest(true);
+			Renderer2D::setAlphaBlending(false);
+		}
+
+		clear();
+
+		//strings that haven't been drawn in a while (old values of counters and such) don't keep their layouts around
+		frame += 1;
+
+		if (frame % HFR_TEXT_LAYOUT_LIFETIME == 0) {
+			for (auto current = layouts.begin(); current != layouts.end();) {
+				if (current->second.lastUsed + HFR_TEXT_LAYOUT_LIFETIME < frame)
+					current = layouts.erase(current);
+				else
+					++current;
+			}
+		}
+	}
+
+	void TextBatcher::clear() {
+		//atlases nothing got drawn with since the last flush get let go of, the rest keep their vertex memory
+		for (auto current = batches.begin(); current != batches.end();) {
+			if (current->vertices.empty()) {
+				current = batches.erase(current);
+			}
+			else {
+				current->vertices.clear();
+				++current;
+			}
+		}
+	}
+
+	size_t TextBatcher::getDrawCalls() {
+		return drawCalls;
+	}
+
+	size_t TextBatcher::getQuadAmount() {
+		return quadAmount;
+	}
+
+	size_t TextBatcher::getQueuedQuadAmount() {
+		size_t out = 0;
+
+		for (size_t i = 0; i < batches.size(); ++i)
+			out += batches[i].vertices.size() / 4;
+
+		return out;
+	}
+
+	unsigned long long TextBatcher::getLayoutHits() {
+		return layoutHits;
+	}
+
+	unsigned long long TextBatcher::getLayoutMisses() {
+		return layoutMisses;
+	}
+
+	size_t TextBatcher::getLayoutAmount() {
+		return layouts.size();
+	}
+
+	void TextBatcher::resetCounters() {
+		layoutHits = 0;
+		layoutMisses = 0;
+	}
+
+}
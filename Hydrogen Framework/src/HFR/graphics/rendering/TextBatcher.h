@@ -0,0 +1,55 @@
+#ifndef HFR_TEXT_BATCHER_HEADER_INCLUDE
+#define HFR_TEXT_BATCHER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VEC2
+#include HFR_VEC4
+#include HFR_FONT
+
+namespace HFR {
+
+	class GuiText;
+
+	//all the text of a frame goes into one vertex buffer and gets drawn with one call per font atlas when flush runs
+	//strings get laid out once and reused for as long as the same text keeps getting drawn with the same font, size and scale,
+	//so only position and color cost anything per frame
+	//positions are in screen space (opengl) coordinates like GuiText, atlases that overlap get drawn in the order they were first used
+	class DLL_API TextBatcher {
+	private:
+		static unsigned long long frame;
+		static size_t drawCalls;
+		static size_t quadAmount;
+		static unsigned long long layoutHits;
+		static unsigned long long layoutMisses;
+
+		//makes the quad and index buffers fit at least quads quads
+		static void reserve(const size_t& quads);
+
+	public:
+		static void init();
+		static void close();
+
+		//queues the text, nothing gets drawn until flush
+		static void submit(const GuiText& text);
+		static void submit(const std::string& text, const Font& font, const Vec2f& position, const Vec2f& scale, const Vec4f& color);
+
+		//uploads everything queued since the last flush and draws it, Window::update does this right before swapping
+		static void flush();
+		//drops everything queued without drawing it
+		static void clear();
+
+		//as of the last flush
+		static size_t getDrawCalls();
+		static size_t getQuadAmount();
+		//quads queued since the last flush
+		static size_t getQueuedQuadAmount();
+
+		static unsigned long long getLayoutHits();
+		static unsigned long long getLayoutMisses();
+		static size_t getLayoutAmount();
+		static void resetCounters();
+	};
+
+}
+
+#endif
@@ -0,0 +1,428 @@
+#include "hfpch.h"
+#include HFR_GUI_CANVAS
+
+namespace HFR {
+
+	namespace {
+		const Vec4f emptyBounds = Vec4f(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+		bool isEmpty(const Vec4f& rect) {
+			return rect.z <= rect.x || rect.w <= rect.y;
+		}
+
+		bool intersects(const Vec4f& a, const Vec4f& b) {
+			return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+		}
+
+		Vec4f merge(const Vec4f& a, const Vec4f& b) {
+			return Vec4f(min(a.x, b.x), min(a.y, b.y), max(a.z, b.z), max(a.w, b.w));
+		}
+
+		//pixel size of a gui size or position, screen space positions go across the window and screen space sizes follow its shorter side like in Renderer2D
+		Vec2f toPixels(const Vec2f& value, const int& sizeType, const bool& isSize, const Vec2f& windowSize) {
+			if (sizeType != HFR_SCREEN_SPACE_SIZE)
+				return value;
+
+			if (!isSize)
+				return Vec2f(value.x * windowSize.x, value.y * windowSize.y);
+
+			float side = min(windowSize.x, windowSize.y);
+			return Vec2f(value.x * side, value.y * side);
+		}
+
+		//screen rectangle the quad covers, rotated ones get the box around them
+		Vec4f getQuadBounds(const GuiQuad& quad, const Vec2f& windowSize) {
+			Vec4f out = emptyBounds;
+
+			for (int corner = 0; corner < 4; ++corner) {
+				float x = corner & 1 ? 1.0f : -1.0f;
+				float y = corner & 2 ? 1.0f : -1.0f;
+
+				float clipX = quad.origin.x + quad.axisX.x * x + quad.axisY.x * y;
+				float clipY = quad.origin.y + quad.axisX.y * x + quad.axisY.y * y;
+
+				Vec2f pixel = Vec2f((clipX + 1) * 0.5f * windowSize.x, (1 - clipY) * 0.5f * windowSize.y);
+				out = merge(out, Vec4f(pixel.x, pixel.y, pixel.x, pixel.y));
+			}
+
+			//whole pixels so smoothed edges don't get cut off
+			return Vec4f(floor(out.x) - 1, floor(out.y) - 1, ceil(out.z) + 1, ceil(out.w) + 1);
+		}
+	}
+
+	GuiElement GuiCanvas::root;
+	Framebuffer GuiCanvas::framebuffer;
+	std::vector<Vec4f> GuiCanvas::dirtyRegions;
+
+	size_t GuiCanvas::layoutAmount = 0;
+	size_t GuiCanvas::redrawnRegions = 0;
+	size_t GuiCanvas::redrawnQuads = 0;
+
+	void GuiCanvas::add(GuiElement* element) {
+		root.addChild(element);
+	}
+
+	void GuiCanvas::remove(GuiElement* element) {
+		root.removeChild(element);
+	}
+
+	GuiElement* GuiCanvas::find(const std::string& name) {
+		std::vector<GuiElement*> stack = { &root };
+
+		while (!stack.empty()) {
+			GuiElement* element = stack.back();
+			stack.pop_back();
+
+			if (element != &root && element->name == name)
+				return element;
+
+			//last child first so the tree gets searched in drawing order
+			for (GuiElement* child = element->lastChild; child != nullptr; child = child->previousSibling)
+				stack.push_back(child);
+		}
+
+		return nullptr;
+	}
+
+	GuiElement& GuiCanvas::getRoot() {
+		return root;
+	}
+
+	void GuiCanvas::invalidate(const Vec4f& region) {
+		if (!isEmpty(region))
+			dirtyRegions.push_back(region);
+	}
+
+	void GuiCanvas::invalidateAll() {
+		Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+
+		dirtyRegions.clear();
+		dirtyRegions.push_back(Vec4f(0, 0, windowSize.x, windowSize.y));
+	}
+
+	void GuiCanvas::update() {
+		ProfileMethod("Gui layout");
+
+		layoutAmount = 0;
+
+		//every element gets to react to input before anything gets laid out, children after their parents
+		std::vector<GuiElement*> stack = { &root };
+
+		while (!stack.empty()) {
+			GuiElement* element = stack.back();
+			stack.pop_back();
+
+			if (!element->visible)
+				continue;
+
+			element->update();
+
+			for (GuiElement* child = element->lastChild; child != nullptr; child = child->previousSibling)
+				stack.push_back(child);
+		}
+
+		Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+
+		//everything hangs off the window so a new size lays all of it out again
+		if (root.size.x != windowSize.x || root.size.y != windowSize.y) {
+			root.size = windowSize;
+			root.markDirty();
+
+			invalidateAll();
+		}
+
+		if (root.layoutDirty || root.childDirty)
+			layoutElement(root, Vec2f(), nullptr, false);
+	}
+
+	void GuiCanvas::layoutElement(GuiElement& element, const Vec2f& origin, const float* mainSize, const bool& force) {
+		if (!element.visible) {
+			//whatever it drew has to go, and it gets laid out from scratch once it shows up again
+			invalidate(element.subtreeBounds);
+
+			element.bounds = emptyBounds;
+			element.subtreeBounds = emptyBounds;
+			//counts as moved next time so its children get drawn again too
+			element.layoutSize = Vec2f(-1, -1);
+			element.layoutDirty = true;
+			element.childDirty = false;
+
+			return;
+		}
+
+		const Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+		const GuiElement* parent = element.parent;
+
+		Vec2f size = toPixels(element.size, element.sizeType, true, windowSize);
+
+		//grown by a row or column
+		if (mainSize != nullptr) {
+			if (parent->layout == HFR_GUI_LAYOUT_ROW)
+				size.x = *mainSize;
+			else
+				size.y = *mainSize;
+		}
+
+		Vec2f position = toPixels(element.position, element.sizeType, false, windowSize);
+		position = Vec2f(origin.x + position.x - element.anchorPoint.x * size.x, origin.y + position.y - element.anchorPoint.y * size.y);
+
+		//a sibling in a row or column that changed size moves it without it being marked dirty
+		const bool moved = position.x != element.layoutPosition.x || position.y != element.layoutPosition.y ||
+			size.x != element.layoutSize.x || size.y != element.layoutSize.y;
+		const bool relayout = force || element.layoutDirty || moved;
+
+		if (relayout) {
+			element.layoutPosition = position;
+			element.layoutSize = size;
+
+			//the old spot and the new one both have to be drawn again
+			invalidate(element.bounds);
+
+			element.quad = GuiQuad();
+			Renderer2D::placeQuad(element.quad, position, size, element.rotation, Vec2f(), HFR_PIXEL_SIZE);
+			element.shader = element.createQuad(element.quad);
+
+			element.bounds = element.shader != nullptr ? getQuadBounds(element.quad, windowSize) : emptyBounds;
+			invalidate(element.bounds);
+
+			layoutAmount += 1;
+		}
+
+		if (relayout || element.childDirty) {
+			layoutChildren(element, moved || (relayout && element.layout != HFR_GUI_LAYOUT_NONE));
+
+			element.subtreeBounds = element.bounds;
+
+			for (GuiElement* child = element.firstChild; child != nullptr; child = child->nextSibling)
+				element.subtreeBounds = merge(element.subtreeBounds, child->subtreeBounds);
+		}
+
+		element.layoutDirty = false;
+		element.childDirty = false;
+	}
+
+	void GuiCanvas::layoutChildren(GuiElement& element, const bool& force) {
+		const Vec2f origin = Vec2f(element.layoutPosition.x + element.padding, element.layoutPosition.y + element.padding);
+
+		if (element.layout == HFR_GUI_LAYOUT_NONE) {
+			for (GuiElement* child = element.firstChild; child != nullptr; child = child->nextSibling) {
+				if (force || child->layoutDirty || child->childDirty || !child->visible)
+					layoutElement(*child, origin, nullptr, force);
+			}
+
+			return;
+		}
+
+		//rows and columns first find out how much room is left over for the children that grow
+		const Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+		const bool row = element.layout == HFR_GUI_LAYOUT_ROW;
+
+		float available = (row ? element.layoutSize.x : element.layoutSize.y) - element.padding * 2;
+		float used = 0;
+		float grow = 0;
+		int visibleAmount = 0;
+
+		for (GuiElement* child = element.firstChild; child != nullptr; child = child->nextSibling) {
+			if (!child->visible)
+				continue;
+
+			Vec2f size = toPixels(child->size, child->sizeType, true, windowSize);
+
+			used += row ? size.x : size.y;
+			grow += max(child->flexGrow, 0.0f);
+			visibleAmount += 1;
+		}
+
+		used += element.spacing * max(visibleAmount - 1, 0);
+		const float leftOver = max(available - used, 0.0f);
+
+		Vec2f cursor = origin;
+
+		for (GuiElement* child = element.firstChild; child != nullptr; child = child->nextSibling) {
+			if (!child->visible) {
+				layoutElement(*child, cursor, nullptr, true);
+				continue;
+			}
+
+			Vec2f size = toPixels(child->size, child->sizeType, true, windowSize);
+			float mainSize = row ? size.x : size.y;
+			bool grows = child->flexGrow > 0 && grow > 0;
+
+			if (grows)
+				mainSize += leftOver * child->flexGrow / grow;
+
+			layoutElement(*child, cursor, grows ? &mainSize : nullptr, force);
+
+			if (row)
+				cursor.x += mainSize + element.spacing;
+			else
+				cursor.y += mainSize + element.spacing;
+		}
+	}
+
+	void GuiCanvas::mergeRegions() {
+		const Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+		const Vec4f window = Vec4f(0, 0, windowSize.x, windowSize.y);
+
+		std::vector<Vec4f> merged;
+
+		//merging one by one gets slow with a lot of regions (like after everything got laid out), and one big one is close enough then
+		if (dirtyRegions.size() > (size_t)HFR_GUI_MAX_DIRTY_REGIONS * 8) {
+			Vec4f all = emptyBounds;
+
+			for (size_t i = 0; i < dirtyRegions.size(); ++i)
+				all = merge(all, dirtyRegions[i]);
+
+			dirtyRegions.assign(1, all);
+		}
+
+		for (size_t i = 0; i < dirtyRegions.size(); ++i) {
+			Vec4f region = dirtyRegions[i];
+
+			region = Vec4f(max(region.x, window.x), max(region.y, window.y), min(region.z, window.z), min(region.w, window.w));
+
+			if (isEmpty(region))
+				continue;
+
+			//anything it touches gets swallowed, which can make it touch things it didn't before
+			for (size_t j = 0; j < merged.size();) {
+				if (intersects(merged[j], region)) {
+					region = merge(region, merged[j]);
+					merged.erase(merged.begin() + j);
+					j = 0;
+				}
+				else
+					++j;
+			}
+
+			merged.push_back(region);
+		}
+
+		//lots of small scattered regions cost more in draws than drawing a bit too much
+		if (merged.size() > (size_t)HFR_GUI_MAX_DIRTY_REGIONS) {
+			Vec4f all = emptyBounds;
+
+			for (size_t i = 0; i < merged.size(); ++i)
+				all = merge(all, merged[i]);
+
+			merged.assign(1, all);
+		}
+
+		dirtyRegions = std::move(merged);
+	}
+
+	void GuiCanvas::submitRegion(const GuiElement& element, const Vec4f& region) {
+		if (!element.visible || !intersects(element.subtreeBounds, region))
+			return;
+
+		if (element.shader != nullptr && intersects(element.bounds, region)) {
+			QuadBatcher::submit(element.quad, *element.shader);
+			redrawnQuads += 1;
+		}
+
+		for (const GuiElement* child = element.firstChild; child != nullptr; child = child->nextSibling)
+			submitRegion(*child, region);
+	}
+
+	void GuiCanvas::render() {
+		ProfileMethod("Gui canvas render");
+		ProfileGpuTime("Gui canvas");
+
+		update();
+
+		redrawnRegions = 0;
+		redrawnQuads = 0;
+
+		const Vec2f windowSize = Renderer2D::getCurrentWindowSize();
+		const Vec2i pixelSize = Vec2i((int)windowSize.x, (int)windowSize.y);
+
+		if (pixelSize.x <= 0 || pixelSize.y <= 0)
+			return;
+
+		if (framebuffer.getSize().x != pixelSize.x || framebuffer.getSize().y != pixelSize.y) {
+			if (!framebuffer.create(pixelSize))
+				return;
+
+			invalidateAll();
+		}
+
+		mergeRegions();
+
+		if (!dirtyRegions.empty()) {
+			//whatever got queued before this belongs on screen, not in the gui
+			QuadBatcher::flush();
+
+			float clearColor[4];
+			glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+			framebuffer.bind();
+			glEnable(GL_SCISSOR_TEST);
+			glClearColor(0, 0, 0, 0);
+
+			for (size_t i = 0; i < dirtyRegions.size(); ++i) {
+				const Vec4f& region = dirtyRegions[i];
+
+				//scissor rectangles start at the bottom left
+				glScissor((GLint)region.x, (GLint)(windowSize.y - region.w), (GLsizei)(region.z - region.x), (GLsizei)(region.w - region.y));
+				glClear(GL_COLOR_BUFFER_BIT);
+
+				submitRegion(root, region);
+				QuadBatcher::flush();
+
+				redrawnRegions += 1;
+			}
+
+			glDisable(GL_SCISSOR_TEST);
+			glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+			framebuffer.unbind(pixelSize);
+
+			dirtyRegions.clear();
+		}
+
+		//texture row 0 is the bottom of the screen
+		GuiQuad quad;
+		quad.origin = Vec2f(0, 0);
+		quad.axisX = Vec2f(1, 0);
+		quad.axisY = Vec2f(0, 1);
+		quad.pixelSize = windowSize;
+		quad.textureOffset = Vec2f(0, 1);
+		quad.textureSize = Vec2f(1, -1);
+		quad.textureID = framebuffer.getTextureID();
+
+		QuadBatcher::submit(quad, Renderer2D::guiCompositeShader);
+	}
+
+	void GuiCanvas::submitDirtyRegions() {
+		update();
+
+		redrawnRegions = 0;
+		redrawnQuads = 0;
+
+		mergeRegions();
+
+		for (size_t i = 0; i < dirtyRegions.size(); ++i) {
+			submitRegion(root, dirtyRegions[i]);
+			redrawnRegions += 1;
+		}
+
+		dirtyRegions.clear();
+	}
+
+	void GuiCanvas::close() {
+		framebuffer.destroy();
+		dirtyRegions.clear();
+	}
+
+	size_t GuiCanvas::getLayoutAmount() {
+		return layoutAmount;
+	}
+
+	size_t GuiCanvas::getRedrawnRegions() {
+		return redrawnRegions;
+	}
+
+	size_t GuiCanvas::getRedrawnQuads() {
+		return redrawnQuads;
+	}
+
+}
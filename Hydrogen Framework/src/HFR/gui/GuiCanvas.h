@@ -0,0 +1,59 @@
+#ifndef HFR_GUI_CANVAS_HEADER_INCLUDE
+#define HFR_GUI_CANVAS_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_GUI_ELEMENT
+#include HFR_FRAMEBUFFER
+
+namespace HFR {
+
+	//holds the gui tree and keeps it drawn into a framebuffer the size of the window,
+	//only the parts of the screen elements moved away from or onto since the last frame get drawn again, the rest of the time the framebuffer just gets put on screen.
+	//with the render pipeline on scripts change elements on the simulation thread, so update and render only run once RenderPipeline::endFrame returned
+	class DLL_API GuiCanvas {
+	private:
+		//covers the whole window, every gui element that gets drawn is somewhere under it
+		static GuiElement root;
+		static Framebuffer framebuffer;
+		//left, top, right and bottom in pixels
+		static std::vector<Vec4f> dirtyRegions;
+
+		static size_t layoutAmount;
+		static size_t redrawnRegions;
+		static size_t redrawnQuads;
+
+		static void layoutElement(GuiElement& element, const Vec2f& origin, const float* mainSize, const bool& force);
+		static void layoutChildren(GuiElement& element, const bool& force);
+		static void submitRegion(const GuiElement& element, const Vec4f& region);
+		//overlapping regions become one, too many become one too
+		static void mergeRegions();
+
+	public:
+		//adds it at the top level, on top of everything added before
+		static void add(GuiElement* element);
+		static void remove(GuiElement* element);
+		//first element with that name anywhere in the tree, nullptr when there isn't one
+		static GuiElement* find(const std::string& name);
+		static GuiElement& getRoot();
+
+		//that part of the screen gets drawn again next frame
+		static void invalidate(const Vec4f& region);
+		static void invalidateAll();
+
+		//lays out whatever was marked dirty, render does this too
+		static void update();
+		//draws the dirty regions into the framebuffer and queues it to be put on screen with the rest of the gui
+		static void render();
+		//render without the framebuffer, the quads of every dirty region only get queued in the quad batcher, for running without a gl context
+		static void submitDirtyRegions();
+		static void close();
+
+		//as of the last update and render
+		static size_t getLayoutAmount();
+		static size_t getRedrawnRegions();
+		static size_t getRedrawnQuads();
+	};
+
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "hfpch.h"
 #include "GuiElement.h"
+#include HFR_GUI_CANVAS
 
 namespace HFR {
 
@@ -7,6 +8,135 @@ namespace HFR {
 
 	}
 
+	GuiElement::GuiElement(const GuiElement& other) {
+		*this = other;
+	}
+
+	GuiElement& GuiElement::operator=(const GuiElement& other) {
+		if (this == &other)
+			return *this;
+
+		name = other.name;
+		size = other.size;
+		position = other.position;
+		rotation = other.rotation;
+		anchorPoint = other.anchorPoint;
+		sizeType = other.sizeType;
+		visible = other.visible;
+		layout = other.layout;
+		padding = other.padding;
+		spacing = other.spacing;
+		flexGrow = other.flexGrow;
+
+		markDirty();
+
+		return *this;
+	}
+
+	GuiElement::~GuiElement() {
+		unlink();
+
+		//whatever is left under this goes out of the tree with it
+		for (GuiElement* child = firstChild; child != nullptr;) {
+			GuiElement* next = child->nextSibling;
+
+			child->parent = nullptr;
+			child->previousSibling = nullptr;
+			child->nextSibling = nullptr;
+
+			child = next;
+		}
+	}
+
+	void GuiElement::unlink() {
+		if (parent == nullptr)
+			return;
+
+		//the spot it was drawn at has to be drawn again without it
+		GuiCanvas::invalidate(subtreeBounds);
+
+		if (previousSibling != nullptr)
+			previousSibling->nextSibling = nextSibling;
+		else
+			parent->firstChild = nextSibling;
+
+		if (nextSibling != nullptr)
+			nextSibling->previousSibling = previousSibling;
+		else
+			parent->lastChild = previousSibling;
+
+		//siblings in a row or column move up into the gap, otherwise only the bounds above need to be worked out again
+		if (parent->layout != HFR_GUI_LAYOUT_NONE) {
+			parent->markDirty();
+		}
+		else {
+			for (GuiElement* ancestor = parent; ancestor != nullptr && !ancestor->childDirty; ancestor = ancestor->parent)
+				ancestor->childDirty = true;
+		}
+
+		parent = nullptr;
+		previousSibling = nullptr;
+		nextSibling = nullptr;
+	}
+
+	void GuiElement::addChild(GuiElement* child) {
+		if (child == nullptr || child == this)
+			return;
+
+		child->unlink();
+
+		child->parent = this;
+		child->previousSibling = lastChild;
+		child->nextSibling = nullptr;
+
+		if (lastChild != nullptr)
+			lastChild->nextSibling = child;
+		else
+			firstChild = child;
 
+		lastChild = child;
+
+		child->markDirty();
+	}
+
+	void GuiElement::removeChild(GuiElement* child) {
+		if (child != nullptr && child->parent == this)
+			child->unlink();
+	}
+
+	void GuiElement::removeFromParent() {
+		unlink();
+	}
+
+	void GuiElement::markDirty() {
+		layoutDirty = true;
+
+		//everything above only has to know to look further down, siblings in a row or column that its size moves find that out themselves
+		for (GuiElement* ancestor = parent; ancestor != nullptr && !ancestor->childDirty; ancestor = ancestor->parent)
+			ancestor->childDirty = true;
+	}
+
+	Vec2f GuiElement::getLayoutPosition() const {
+		return layoutPosition;
+	}
+
+	Vec2f GuiElement::getLayoutSize() const {
+		return layoutSize;
+	}
+
+	bool GuiElement::isHovered() const {
+		Vec2f mouse = Input::getMousePosition();
+
+		return mouse.x > layoutPosition.x && mouse.x < layoutPosition.x + layoutSize.x &&
+			mouse.y > layoutPosition.y && mouse.y < layoutPosition.y + layoutSize.y;
+	}
+
+	void GuiElement::update() {
+
+	}
+
+	const Shader* GuiElement::createQuad(GuiQuad& quad) const {
+		return nullptr;
+	}
 
-}
\ No newline at end of file
+}
@@ -1,12 +1,33 @@
-
 #ifndef HFR_GUI_ELEMENT_HEADER_INCLUDE
 #define HFR_GUI_ELEMENT_HEADER_INCLUDE
 
 #include HFR_API
+#include HFR_QUAD_BATCHER
 
 namespace HFR {
 
+	//gui elements are kept in a tree and only get laid out and drawn again after markDirty,
+	//so anything changed on one after it was first drawn needs a markDirty to show up
 	class DLL_API GuiElement {
+	private:
+		//laid out top left corner and size in pixels (top left coordinate system)
+		Vec2f layoutPosition;
+		Vec2f layoutSize;
+		//everything the element covers on screen with rotation (left, top, right and bottom in pixels), and the same for it and all its descendants
+		Vec4f bounds;
+		Vec4f subtreeBounds;
+
+		//what createQuad gave back the last time it was laid out
+		GuiQuad quad;
+		const Shader* shader = nullptr;
+
+		bool layoutDirty = true;
+		bool childDirty = false;
+
+		friend class GuiCanvas;
+
+		void unlink();
+
 	public:
 		//you can give your gui items names with this
 		std::string name;
@@ -15,6 +36,7 @@ namespace HFR {
 		Vec2f size = Vec2f(100, 100);
 
 		//position of the gui element (in screen space or pixels), (0, 0) by default
+		//relative to the parents top left corner (plus its padding) when it has one, in a row or column it offsets the spot it gets
 		Vec2f position = Vec2f();
 
 		//the rotation value of the gui element, 0 by default
@@ -26,20 +48,54 @@ namespace HFR {
 		//the size type defines whether to use screen space (opengl) coordinates, or to use pixel coordinates, (HFR_PIXEL_SIZE for pixels) (HFR_SCREEN_SPACE_SIZE for screen space), (HFR_PIXEL_SIZE) by default
 		int sizeType = HFR_PIXEL_SIZE;
 
-		//whether or not this gui element can be seen, (true) by default
+		//whether or not this gui element can be seen, hidden elements hide their children too, (true) by default
 		bool visible = true;
 
-		//the parent of this gui element
-		GuiElement* parent;
+		//how the children get placed, HFR_GUI_LAYOUT_NONE puts each one at its own position, HFR_GUI_LAYOUT_ROW and HFR_GUI_LAYOUT_COLUMN put them one after another, (HFR_GUI_LAYOUT_NONE) by default
+		int layout = HFR_GUI_LAYOUT_NONE;
 
-		//the child of this gui element
-		GuiElement* child;
+		//space in pixels between the edges of this element and its children, (0) by default
+		float padding = 0;
 
-		GuiElement();
+		//space in pixels between children in a row or column, (0) by default
+		float spacing = 0;
+
+		//in a row or column, how much of the space left over this element grows by compared to its siblings, (0) by default
+		float flexGrow = 0;
 
+		//the tree, use addChild and removeChild to change it
+		GuiElement* parent = nullptr;
+		GuiElement* firstChild = nullptr;
+		GuiElement* lastChild = nullptr;
+		GuiElement* previousSibling = nullptr;
+		GuiElement* nextSibling = nullptr;
+
+		GuiElement();
+		//copies are left out of the tree
+		GuiElement(const GuiElement& other);
+		GuiElement& operator=(const GuiElement& other);
+		virtual ~GuiElement();
+
+		//children get drawn after (on top of) their parent and their earlier siblings, a child that already had a parent gets moved
+		void addChild(GuiElement* child);
+		void removeChild(GuiElement* child);
+		//takes this element out of the tree (its children stay with it)
+		void removeFromParent();
+
+		//the element gets laid out and drawn again, and so does whatever its size could have moved
+		void markDirty();
+
+		Vec2f getLayoutPosition() const;
+		Vec2f getLayoutSize() const;
+		bool isHovered() const;
+
+		//every element in the canvas gets this once a frame before anything is laid out, for reacting to input and such
+		virtual void update();
+		//fills in everything but where the quad goes, nullptr when the element draws nothing
+		virtual const Shader* createQuad(GuiQuad& quad) const;
 	};
 
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -22,39 +22,6 @@ namespace HFR {
 	
 	}
 
-	bool GuiFrame::isHovered() {
-		bool x = false;
-		bool y = false;
-
-		if (sizeType == HFR_PIXEL_SIZE) {
-			float xOffset = size.x * anchorPoint.x;
-			float yOffset = size.y * anchorPoint.y;
-
-			x = (Input::getMousePosition().x > position.x - xOffset && Input::getMousePosition().x < position.x + size.x - xOffset);
-			y = (Input::getMousePosition().y > position.y - yOffset && Input::getMousePosition().y < position.y + size.y - yOffset);
-		}
-		else {
-
-			if (Renderer::getCurrentWindowSize().x < Renderer::getCurrentWindowSize().y) {
-				float xOffset = size.x * anchorPoint.x;
-				float yOffset = size.y * anchorPoint.y * Renderer::getAspectRatio();
-
-				x = (Input::getMousePositionScreenSpace().x > position.x - xOffset && Input::getMousePositionScreenSpace().x < position.x + size.x - xOffset);
-				y = (Input::getMousePositionScreenSpace().y > position.y - yOffset && Input::getMousePositionScreenSpace().y < position.y + size.y * Renderer::getAspectRatio() - yOffset);
-			}
-			else {
-
-				float xOffset = size.x * anchorPoint.x / Renderer::getAspectRatio();
-				float yOffset = size.y * anchorPoint.y;
-
-				x = (Input::getMousePositionScreenSpace().x > position.x - xOffset && Input::getMousePositionScreenSpace().x < position.x + size.x / Renderer::getAspectRatio() - xOffset);
-				y = (Input::getMousePositionScreenSpace().y > position.y - yOffset && Input::getMousePositionScreenSpace().y < position.y + size.y - yOffset);
-			}
-		}
-
-		return (x && y);
-	}
-
 	bool GuiFrame::isSelected() {
 		if (selectable) {
 			if (!selected) {
@@ -70,4 +37,26 @@ namespace HFR {
 			return false;
 	}
 
+	void GuiFrame::update() {
+		if (!active || !draggable || !isSelected())
+			return;
+
+		Vec2f movement = sizeType == HFR_PIXEL_SIZE ? Input::getMouseMovement() : Input::getMouseMovementScreenSpace();
+
+		if (movement.x != 0 || movement.y != 0) {
+			position += Vec2f(movement.x / 2, movement.y / 2);
+			markDirty();
+		}
+	}
+
+	const Shader* GuiFrame::createQuad(GuiQuad& quad) const {
+		quad.color = backgroundColor;
+		quad.borderColor = borderColor;
+		quad.borderSize = (float)borderSize;
+		quad.cornerRadius = (float)roundedCornerRadius;
+		quad.cornerSmoothing = cornerSmoothing;
+
+		return &Renderer2D::guiFrameShader;
+	}
+
 }
\ No newline at end of file
@@ -12,18 +12,11 @@ namespace HFR {
 	private:
 		bool selected = false;
 	public:
-		std::string name;
-		
-		Vec2f size;
-		float rotation;
-		Vec2f anchorPoint;
-
 		Vec4f backgroundColor;
 		Vec4f borderColor;
 		
 		unsigned int borderSize;
 
-		int sizeType;
 		int roundedCornerRadius = 0;
 		float cornerSmoothing = 0.7f;
 
@@ -34,8 +27,12 @@ namespace HFR {
 		GuiFrame();
 		~GuiFrame();
 
-		bool isHovered();
 		bool isSelected();
+
+		//drags the frame around when it's draggable
+		void update() override;
+
+		const Shader* createQuad(GuiQuad& quad) const override;
 	};
 
 
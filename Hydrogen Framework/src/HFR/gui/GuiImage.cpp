@@ -27,4 +27,25 @@ namespace HFR {
 
 	}
 
+	const Shader* GuiImage::createQuad(GuiQuad& quad) const {
+		quad.color = color;
+
+		quad.radialFill = (float)HMath::toRadians(radialFill);
+		quad.radialFillAngleOffset = (float)HMath::toRadians(radialFillAngleOffset);
+		quad.radialFillOffset = radialFillOffset;
+		quad.radialFillInverse = radialFillInverse;
+
+		const AtlasRegion* region = atlas != nullptr ? atlas->getRegion(atlasName) : nullptr;
+
+		if (region != nullptr) {
+			quad.textureID = atlas->getTextureID(region->page);
+			quad.textureOffset = region->textureOffset;
+			quad.textureSize = region->textureSize;
+		}
+		else if (texture.image.hasData())
+			quad.textureID = Renderer::getTexture(texture).textureID;
+
+		return &Renderer2D::guiImageShader;
+	}
+
 }
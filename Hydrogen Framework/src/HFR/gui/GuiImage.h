@@ -6,6 +6,7 @@
 #include "GuiElement.h"
 #include HFR_MATH
 #include HFR_TEXTURE
+#include HFR_TEXTURE_ATLAS
 
 
 namespace HFR {
@@ -16,6 +17,10 @@ namespace HFR {
 		//this is your actual image
 		Texture texture;
 
+		//when set the image gets drawn out of atlasName in this atlas instead of from texture, so every image in the same page batches into one draw
+		TextureAtlas* atlas = nullptr;
+		std::string atlasName;
+
 		//this is the texture under the main texture (useful for making progress bars n stuff)
 		Texture backgroundTexture;
 
@@ -38,6 +43,8 @@ namespace HFR {
 
 		GuiImage();
 		~GuiImage();
+
+		const Shader* createQuad(GuiQuad& quad) const override;
 	};
 
 
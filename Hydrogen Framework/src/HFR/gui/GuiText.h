@@ -13,19 +13,21 @@ namespace HFR {
 
 	class DLL_API GuiText : GuiElement{
 	public:
-		Mesh mesh;
+		//position is where the baseline starts, scale multiplies the font size
 		Transform2D transform;
 
 		std::string text;
 
 		Font font;
 
-		Vec4f color = Vec4f(0, 0, 0, 1);
+		Vec4f color = Vec4f(0.1f, 0.2f, 1, 1);
 
 		GuiText();
 		~GuiText();
 		GuiText(const std::string& text, const Font& font, const Transform2D& transform);
 
+		//puts the glyphs of the text into the font atlas ahead of time, text that changes doesn't need this again
+		//(the text batcher lays out whatever it gets and caches it)
 		void create();
 
 	};
@@ -1,12 +1,38 @@
 #include "hfpch.h"
 #include HFR_RENDERER2D
+#include HFR_TIME
+#include HFR_VIRTUAL_FILE_SYSTEM
+#include HFR_UTIL
 
 namespace HFR {
 
-	std::vector<int> Input::keys = std::vector<int>(GLFW_KEY_LAST);
-	std::vector<int> Input::oldkeys = std::vector<int>(GLFW_KEY_LAST);
-	std::vector<int> Input::buttons = std::vector<int>(GLFW_MOUSE_BUTTON_LAST);
-	std::vector<int> Input::oldbuttons = std::vector<int>(GLFW_MOUSE_BUTTON_LAST);
+	namespace {
+		//what the callbacks wrote and update hasn't taken yet, oldest at first
+		std::array<InputEvent, HFR_INPUT_EVENTS> ring;
+		size_t first = 0;
+		size_t amount = 0;
+		size_t dropped = 0;
+		std::mutex ringMutex;
+
+		const char RECORDING_MAGIC[4] = { 'H', 'I', 'N', 'P' };
+	}
+
+	std::bitset<GLFW_KEY_LAST + 1> Input::keys;
+	std::bitset<GLFW_KEY_LAST + 1> Input::pressedKeys;
+	std::bitset<GLFW_KEY_LAST + 1> Input::releasedKeys;
+	std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> Input::buttons;
+	std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> Input::pressedButtons;
+	std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> Input::releasedButtons;
+
+	std::vector<InputEvent> Input::frameEvents;
+
+	std::vector<Input::Action> Input::actions;
+	std::unordered_map<std::string, size_t> Input::actionIndices;
+
+	InputRecording Input::recording;
+	bool Input::recordingInput = false;
+	bool Input::replaying = false;
+	size_t Input::replayFrame = 0;
 
 	Vec2f Input::mousePosition = Vec2f();
 	Vec2f Input::oldMousePosition = Vec2f();
@@ -22,8 +48,9 @@ namespace HFR {
 	void Input::setWindow(Window* _window) {
 		window = _window;
 		setCallbacks(window->window);
-		createKeyVectors();
-		Debug::systemSuccess("Bound new Window for input polling: " + _window->name);
+		keys.reset();
+		buttons.reset();
+		Debug::systemSuccess("Bound new Window for input polling: {}", _window->name);
 	}
 
 	Window* Input::getCurrentWindow() {
@@ -39,13 +66,6 @@ namespace HFR {
 		glfwSetWindowPosCallback(_window, windowPositionCallBack);
 	}
 
-	void Input::createKeyVectors() {
-		keys = std::vector<int>(GLFW_KEY_LAST);
-		oldkeys = std::vector<int>(GLFW_KEY_LAST);
-		buttons = std::vector<int>(GLFW_MOUSE_BUTTON_LAST);
-		oldbuttons = std::vector<int>(GLFW_MOUSE_BUTTON_LAST);
-	}
-
 	void Input::setRawInput(const bool& in) {
 		if (glfwRawMouseMotionSupported())
 			glfwSetInputMode(window->window, GLFW_RAW_MOUSE_MOTION, in ? GLFW_TRUE : GLFW_FALSE);
@@ -53,6 +73,41 @@ namespace HFR {
 
 	void Input::update() {
 		ProfileMethod("Input update");
+
+		{
+			std::lock_guard<std::mutex> lock(ringMutex);
+			frameEvents.clear();
+
+			for (size_t i = 0; i < amount; ++i)
+				frameEvents.push_back(ring[(first + i) % HFR_INPUT_EVENTS]);
+
+			first = 0;
+			amount = 0;
+		}
+
+		//whatever really happened gets thrown away while replaying
+		if (replaying) {
+			if (replayFrame < recording.frames.size())
+				frameEvents = recording.frames[replayFrame++].events;
+
+			if (replayFrame >= recording.frames.size()) {
+				replaying = false;
+				Debug::systemLog("Input replay finished after {} frames", replayFrame);
+			}
+		}
+		else if (recordingInput)
+			recording.frames.push_back({ Time::getFrameStartTime(), frameEvents });
+
+		pressedKeys.reset();
+		releasedKeys.reset();
+		pressedButtons.reset();
+		releasedButtons.reset();
+		mouseMoved = false;
+		scrollMovement = Vec2f();
+
+		for (size_t i = 0; i < frameEvents.size(); ++i)
+			apply(frameEvents[i]);
+
 		mouseMovement = mousePosition - oldMousePosition;
 
 		if (!Cursor::oldState&& Cursor::state) {
@@ -72,43 +127,105 @@ namespace HFR {
 		}
 		else if (mouseMoved)
 			updatesSinceSwitch = 0;
-	
-
 
 		oldMousePosition = mousePosition;
 
-		//update keys
-		oldkeys = std::vector<int>(keys.begin(), keys.end());
-		oldbuttons = std::vector<int>(buttons.begin(), buttons.end());
-
 		Cursor::update();
 
-		mouseMoved = false;
-		scrollMovement = Vec2f();
+		resolveActions();
+	}
+
+	void Input::apply(const InputEvent& event) {
+		switch (event.type) {
+		case InputEventType::Key:
+			if (event.code < 0 || event.code > GLFW_KEY_LAST || event.action == GLFW_REPEAT)
+				break;
+
+			//a key that goes down and up in the same frame keeps both edges
+			if (event.action == GLFW_PRESS && !keys[event.code])
+				pressedKeys[event.code] = true;
+			else if (event.action == GLFW_RELEASE && keys[event.code])
+				releasedKeys[event.code] = true;
+
+			keys[event.code] = event.action == GLFW_PRESS;
+			break;
+
+		case InputEventType::MouseButton:
+			if (event.code < 0 || event.code > GLFW_MOUSE_BUTTON_LAST || event.action == GLFW_REPEAT)
+				break;
+
+			if (event.action == GLFW_PRESS && !buttons[event.code])
+				pressedButtons[event.code] = true;
+			else if (event.action == GLFW_RELEASE && buttons[event.code])
+				releasedButtons[event.code] = true;
+
+			buttons[event.code] = event.action == GLFW_PRESS;
+			break;
+
+		case InputEventType::CursorPosition:
+			mousePosition = Vec2f(event.x, event.y);
+			mouseMoved = true;
+			break;
+
+		case InputEventType::Scroll:
+			scrollMovement.x += event.x;
+			scrollMovement.y += event.y;
+			break;
+		}
+	}
+
+	void Input::pushEvent(const InputEvent& event) {
+		std::lock_guard<std::mutex> lock(ringMutex);
+
+		if (amount == HFR_INPUT_EVENTS) {
+			dropped += 1;
+			return;
+		}
+
+		ring[(first + amount) % HFR_INPUT_EVENTS] = event;
+		amount += 1;
+	}
+
+	size_t Input::getDroppedEvents() {
+		std::lock_guard<std::mutex> lock(ringMutex);
+		return dropped;
 	}
 
 	//glfw callbacks
 	void Input::keyCallBack(GLFWwindow*, int key, int, int action, int) {
-		if (key >= 0) {
-			keys[key] = action;
-		}
+		InputEvent event;
+		event.time = Time::getTime();
+		event.type = InputEventType::Key;
+		event.code = key;
+		event.action = action;
+		pushEvent(event);
 	}
 
 	void Input::buttonCallBack(GLFWwindow*, int button, int action, int) {
-		if (button >= 0) {
-			buttons[button] = action;
-		}
+		InputEvent event;
+		event.time = Time::getTime();
+		event.type = InputEventType::MouseButton;
+		event.code = button;
+		event.action = action;
+		pushEvent(event);
 	}
 
 	void Input::cursorPositionCallBack(GLFWwindow*, double x, double y) {
-		mousePosition.x = (float)x;
-		mousePosition.y = (float)y;
-		mouseMoved = true;
+		InputEvent event;
+		event.time = Time::getTime();
+		event.type = InputEventType::CursorPosition;
+		event.x = (float)x;
+		event.y = (float)y;
+		pushEvent(event);
 	}
 
 	void Input::scrollMovementCallBack(GLFWwindow*, double x, double y) {
-		scrollMovement.x = (float)x;
-		scrollMovement.y = (float)y;
+		InputEvent event;
+		event.time = Time::getTime();
+		event.type = InputEventType::Scroll;
+		event.x = (float)x;
+		event.y = (float)y;
+		pushEvent(event);
 	}
 
 	void Input::windowSizeCallBack(GLFWwindow*, int width, int height) {
@@ -127,15 +244,15 @@ namespace HFR {
 
 	//keyboard input
 	bool Input::getKey(const int& key) {
-		return keys[key] != GLFW_RELEASE;
+		return key >= 0 && key <= GLFW_KEY_LAST && keys[key];
 	}
 
 	bool Input::getKeyDown(const int& key) {
-		return (keys[key] != GLFW_RELEASE && oldkeys[key] == GLFW_RELEASE);
+		return key >= 0 && key <= GLFW_KEY_LAST && pressedKeys[key];
 	}
 
 	bool Input::getKeyUp(const int& key) {
-		return (keys[key] == GLFW_RELEASE && oldkeys[key] != GLFW_RELEASE);
+		return key >= 0 && key <= GLFW_KEY_LAST && releasedKeys[key];
 	}
 
 	void Input::setClipboardText(const std::string& text) {
@@ -146,7 +263,7 @@ namespace HFR {
 
 		if (!hGlobal) {
 			CloseClipboard();
-			Debug::systemErr("Could not set the clipboard to: " + text + ", for unknown reasons");
+			Debug::systemErr("Could not set the clipboard to: {}, for unknown reasons", text);
 			return;
 		}
 
@@ -164,19 +281,17 @@ namespace HFR {
 
 	//mouse button input
 	bool Input::getMouseButton(const int& button) {
-		return buttons[button] != GLFW_RELEASE;
+		return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && buttons[button];
 	}
 
 	bool Input::getMouseButtonDown(const int& button) {
-		return (buttons[button] != GLFW_RELEASE && oldbuttons[button] == GLFW_RELEASE);
+		return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && pressedButtons[button];
 	}
 
 	bool Input::getMouseButtonUp(const int& button) {
-		return (buttons[button] == GLFW_RELEASE && oldbuttons[button] != GLFW_RELEASE);
+		return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && releasedButtons[button];
 	}
 
-
-
 	//mouse position stuff
 	Vec2f Input::getMousePosition() {
 		return mousePosition;
@@ -195,7 +310,9 @@ namespace HFR {
 	}
 
 	void Input::setMousePosition(const Vec2f& position) {
-		glfwSetCursorPos(window->window, position.x, position.y);
+		if (window != nullptr)
+			glfwSetCursorPos(window->window, position.x, position.y);
+
 		mousePosition = position;
 	}
 
@@ -204,4 +321,253 @@ namespace HFR {
 		return scrollMovement;
 	}
 
+	//actions
+	void Input::bindAction(const std::string& name, const InputBinding& binding) {
+		auto it = actionIndices.find(name);
+
+		if (it == actionIndices.end()) {
+			it = actionIndices.emplace(name, actions.size()).first;
+			actions.push_back(Action());
+		}
+
+		actions[it->second].bindings.push_back(binding);
+	}
+
+	void Input::unbindAction(const std::string& name) {
+		auto it = actionIndices.find(name);
+
+		if (it != actionIndices.end())
+			actions[it->second] = Action();
+	}
+
+	void Input::resolveActions() {
+		for (size_t i = 0; i < actions.size(); ++i) {
+			Action& action = actions[i];
+
+			const bool wasHeld = action.held;
+			bool held = false;
+			//went down at some point this frame, maybe up again too
+			bool down = false;
+			float value = 0;
+
+			for (size_t j = 0; j < action.bindings.size(); ++j) {
+				const InputBinding& binding = action.bindings[j];
+				float movement = 0;
+
+				switch (binding.source) {
+				case InputSource::Key:
+					if (binding.code < 0 || binding.code > GLFW_KEY_LAST)
+						break;
+
+					held |= keys[binding.code];
+					down |= pressedKeys[binding.code];
+					value += keys[binding.code] ? binding.scale : 0;
+					break;
+
+				case InputSource::MouseButton:
+					if (binding.code < 0 || binding.code > GLFW_MOUSE_BUTTON_LAST)
+						break;
+
+					held |= buttons[binding.code];
+					down |= pressedButtons[binding.code];
+					value += buttons[binding.code] ? binding.scale : 0;
+					break;
+
+				case InputSource::MouseX: movement = mouseMovement.x; break;
+				case InputSource::MouseY: movement = mouseMovement.y; break;
+				case InputSource::ScrollX: movement = scrollMovement.x; break;
+				case InputSource::ScrollY: movement = scrollMovement.y; break;
+				}
+
+				held |= movement != 0;
+				value += movement * binding.scale;
+			}
+
+			action.value = value;
+			action.held = held;
+			action.pressed = !wasHeld && (held || down);
+			action.released = !held && (wasHeld || down);
+		}
+	}
+
+	const Input::Action* Input::getActionState(const std::string& name) {
+		auto it = actionIndices.find(name);
+		return it != actionIndices.end() ? &actions[it->second] : nullptr;
+	}
+
+	bool Input::getAction(const std::string& name) {
+		const Action* action = getActionState(name);
+		return action != nullptr && action->held;
+	}
+
+	bool Input::getActionDown(const std::string& name) {
+		const Action* action = getActionState(name);
+		return action != nullptr && action->pressed;
+	}
+
+	bool Input::getActionUp(const std::string& name) {
+		const Action* action = getActionState(name);
+		return action != nullptr && action->released;
+	}
+
+	float Input::getActionValue(const std::string& name) {
+		const Action* action = getActionState(name);
+		return action != nullptr ? action->value : 0;
+	}
+
+	//recording and replay
+	void Input::startRecording() {
+		if (replaying) {
+			Debug::systemErr("Can't record input while replaying it");
+			return;
+		}
+
+		recording = InputRecording();
+		recordingInput = true;
+	}
+
+	void Input::stopRecording() {
+		recordingInput = false;
+	}
+
+	bool Input::isRecording() {
+		return recordingInput;
+	}
+
+	const InputRecording& Input::getRecording() {
+		return recording;
+	}
+
+	void Input::startReplay(const InputRecording& _recording) {
+		if (_recording.frames.empty()) {
+			Debug::systemErr("Can't replay an input recording without frames");
+			return;
+		}
+
+		recordingInput = false;
+		recording = _recording;
+		replayFrame = 0;
+		replaying = true;
+	}
+
+	void Input::stopReplay() {
+		replaying = false;
+	}
+
+	bool Input::isReplaying() {
+		return replaying;
+	}
+
+	void InputRecording::write(std::string& out) const {
+		Util::writeValue(out, (uint64_t)frames.size());
+
+		//field by field so padding never ends up in the file
+		for (size_t i = 0; i < frames.size(); ++i) {
+			Util::writeValue(out, frames[i].time);
+			Util::writeValue(out, (uint32_t)frames[i].events.size());
+
+			for (size_t j = 0; j < frames[i].events.size(); ++j) {
+				const InputEvent& event = frames[i].events[j];
+
+				Util::writeValue(out, event.time);
+				Util::writeValue(out, (uint8_t)event.type);
+				Util::writeValue(out, (int32_t)event.code);
+				Util::writeValue(out, (int32_t)event.action);
+				Util::writeValue(out, event.x);
+				Util::writeValue(out, event.y);
+			}
+		}
+	}
+
+	bool InputRecording::read(const unsigned char* data, const size_t& size, size_t& offset) {
+		frames.clear();
+
+		uint64_t frameAmount = 0;
+		bool valid = Util::readValue(data, size, offset, frameAmount);
+
+		for (uint64_t i = 0; valid && i < frameAmount; ++i) {
+			InputFrame frame;
+			uint32_t eventAmount = 0;
+
+			valid = Util::readValue(data, size, offset, frame.time) && Util::readValue(data, size, offset, eventAmount);
+
+			for (uint32_t j = 0; valid && j < eventAmount; ++j) {
+				InputEvent event;
+				uint8_t type = 0;
+				int32_t code = 0;
+				int32_t action = 0;
+
+				valid = Util::readValue(data, size, offset, event.time) && Util::readValue(data, size, offset, type) && Util::readValue(data, size, offset, code) &&
+					Util::readValue(data, size, offset, action) && Util::readValue(data, size, offset, event.x) && Util::readValue(data, size, offset, event.y) &&
+					type <= (uint8_t)InputEventType::Scroll;
+
+				event.type = (InputEventType)type;
+				event.code = code;
+				event.action = action;
+				frame.events.push_back(event);
+			}
+
+			frames.push_back(std::move(frame));
+		}
+
+		if (!valid)
+			frames.clear();
+
+		return valid;
+	}
+
+	bool InputRecording::save(const std::string& path) const {
+		std::string out;
+		out.append(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+		Util::writeValue(out, (uint32_t)HFR_INPUT_RECORDING_VERSION);
+		write(out);
+
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't write input recording to: {}", path);
+			return false;
+		}
+
+		file.write(out.data(), out.size());
+		return file.good();
+	}
+
+	bool InputRecording::load(const std::string& path) {
+		frames.clear();
+
+		FileData file = VirtualFileSystem::read(path);
+
+		if (!file.isValid()) {
+			Debug::systemErr("Could not read input recording: {}", path);
+			return false;
+		}
+
+		const unsigned char* data = file.getData();
+		const size_t size = file.getSize();
+		size_t offset = 0;
+		uint32_t version = 0;
+
+		if (size < sizeof(RECORDING_MAGIC) || std::memcmp(data, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) {
+			Debug::systemErr("Not an input recording: {}", path);
+			return false;
+		}
+
+		offset += sizeof(RECORDING_MAGIC);
+
+		if (!Util::readValue(data, size, offset, version) || version != HFR_INPUT_RECORDING_VERSION) {
+			Debug::systemErr("Input recording: {} has version {}, expected {}", path, version, HFR_INPUT_RECORDING_VERSION);
+			return false;
+		}
+
+		if (!read(data, size, offset)) {
+			Debug::systemErr("Input recording: {} is cut off or broken", path);
+			return false;
+		}
+
+		return true;
+	}
+
 }
\ No newline at end of file
@@ -1,5 +1,3 @@
-
-
 #ifndef HFR_INPUT_HEADER_INCLUDE
 #define HFR_INPUT_HEADER_INCLUDE
 
@@ -9,8 +7,75 @@
 
 namespace HFR {
 
+	enum class InputEventType : uint8_t {
+		Key = 0,
+		MouseButton = 1,
+		CursorPosition = 2,
+		Scroll = 3
+	};
+
+	struct DLL_API InputEvent {
+		//Time::getTime() when it happened
+		double time = 0;
+		InputEventType type = InputEventType::Key;
+		//the key or button and GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+		int code = 0;
+		int action = 0;
+		//cursor position or scroll offset
+		float x = 0;
+		float y = 0;
+	};
+
+	//what a frame of input got made from
+	struct DLL_API InputFrame {
+		//Time::getFrameStartTime() of the frame that took the events
+		double time = 0;
+		std::vector<InputEvent> events;
+	};
+
+	struct DLL_API InputRecording {
+		std::vector<InputFrame> frames;
+
+		bool save(const std::string& path) const;
+		bool load(const std::string& path);
+
+		//the frames without the file header, for files that keep a recording along with other things
+		void write(std::string& out) const;
+		//false when the data ends early or is broken, offset ends up after the recording
+		bool read(const unsigned char* data, const size_t& size, size_t& offset);
+	};
+
+	enum class InputSource : uint8_t {
+		Key = 0,
+		MouseButton = 1,
+		//how far the mouse moved or got scrolled this frame
+		MouseX = 2,
+		MouseY = 3,
+		ScrollX = 4,
+		ScrollY = 5
+	};
+
+	//a key or button adds scale to its action while it's held, an axis adds its movement times scale
+	struct DLL_API InputBinding {
+		InputSource source = InputSource::Key;
+		int code = 0;
+		float scale = 1;
+
+		InputBinding() {}
+		InputBinding(const InputSource& _source, const int& _code, const float& _scale) : source(_source), code(_code), scale(_scale) {}
+	};
+
+	//glfw callbacks only put timestamped events into a ring buffer, update takes them once a frame in order and builds the key states from them,
+	//so a key that goes down and up again between two frames still counts as pressed and released in the next one
 	class DLL_API Input {
 	private:
+		struct Action {
+			std::vector<InputBinding> bindings;
+			float value = 0;
+			bool held = false;
+			bool pressed = false;
+			bool released = false;
+		};
 
 		//arbitrary stuff
 		static Window* window;
@@ -25,11 +90,24 @@ namespace HFR {
 		static bool mouseMoved;
 		static int updatesSinceSwitch;
 
-		//button and key vectors
-		static std::vector<int> keys;
-		static std::vector<int> oldkeys;
-		static std::vector<int> buttons;
-		static std::vector<int> oldbuttons;
+		//what's held right now, and what went down or up during the last frame
+		static std::bitset<GLFW_KEY_LAST + 1> keys;
+		static std::bitset<GLFW_KEY_LAST + 1> pressedKeys;
+		static std::bitset<GLFW_KEY_LAST + 1> releasedKeys;
+		static std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> buttons;
+		static std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> pressedButtons;
+		static std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> releasedButtons;
+
+		//the events update took this frame, kept so it doesn't allocate every time
+		static std::vector<InputEvent> frameEvents;
+
+		static std::vector<Action> actions;
+		static std::unordered_map<std::string, size_t> actionIndices;
+
+		static InputRecording recording;
+		static bool recordingInput;
+		static bool replaying;
+		static size_t replayFrame;
 
 		//glfw callbacks
 		static void setCallbacks(GLFWwindow* Window);
@@ -43,14 +121,23 @@ namespace HFR {
 		static void windowFocusCallBack(GLFWwindow* window, int focused);
 		//need to add scroll call backs n stuff
 
-		static void createKeyVectors();
+		static void apply(const InputEvent& event);
+		static void resolveActions();
+		static const Action* getActionState(const std::string& name);
 
 	public:
+		//takes the events the glfw callbacks put into the ring buffer (or the replays next frame) and builds this frames state from them,
+		//the polling happens in Window::update, Engine::updateEngine does this at the start of every frame
 		static void update();
 		static void setWindow(Window* Window);
 		static Window* getCurrentWindow();
 		static void setRawInput(const bool& in);
 
+		//from any thread, what the callbacks do, and how tests and tools put in made up input
+		static void pushEvent(const InputEvent& event);
+		//events that came in while the ring buffer was full (HFR_INPUT_EVENTS of them in one frame)
+		static size_t getDroppedEvents();
+
 		//i love taking method names from unity :)
 		static bool getKey(const int& key);
 		static bool getKeyDown(const int& key);
@@ -69,7 +156,27 @@ namespace HFR {
 
 		//scroll n stuff
 		static Vec2f getScrollMovement();
+
+		//named actions, every binding of one gets summed up once a frame in update
+		static void bindAction(const std::string& name, const InputBinding& binding);
+		static void unbindAction(const std::string& name);
+		//held, went down or went up this frame, false for actions that aren't bound
+		static bool getAction(const std::string& name);
+		static bool getActionDown(const std::string& name);
+		static bool getActionUp(const std::string& name);
+		static float getActionValue(const std::string& name);
+
+		//every frame from the next update on gets kept with its events until stopRecording
+		static void startRecording();
+		static void stopRecording();
+		static bool isRecording();
+		static const InputRecording& getRecording();
+
+		//the next updates take the recorded frames one by one instead of the real input, until they run out or stopReplay
+		static void startReplay(const InputRecording& recording);
+		static void stopReplay();
+		static bool isReplaying();
 	};
 
 }
-#endif
\ No newline at end of file
+#endif
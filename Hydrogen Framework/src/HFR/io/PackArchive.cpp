@@ -0,0 +1,426 @@
+#include "hfpch.h"
+#include HFR_PACK_ARCHIVE
+
+namespace HFR {
+
+	namespace {
+		//lz4 block format rules, the last 5 bytes are always literals and the last match has to start 12 bytes before the end
+		const size_t LZ4_MIN_MATCH = 4;
+		const size_t LZ4_LAST_LITERALS = 5;
+		const size_t LZ4_MATCH_LIMIT = 12;
+		const size_t LZ4_MAX_OFFSET = 65535;
+		const unsigned int LZ4_HASH_BITS = 14;
+
+		uint32_t read32(const unsigned char* data) {
+			uint32_t out;
+			std::memcpy(&out, data, sizeof(out));
+			return out;
+		}
+
+		void writeLength(std::vector<unsigned char>& out, size_t length) {
+			while (length >= 255) {
+				out.push_back(255);
+				length -= 255;
+			}
+
+			out.push_back((unsigned char)length);
+		}
+
+		void writeSequence(std::vector<unsigned char>& out, const unsigned char* literals, const size_t& literalLength, const size_t& offset, const size_t& matchLength) {
+			size_t match = matchLength - LZ4_MIN_MATCH;
+
+			out.push_back((unsigned char)((min(literalLength, (size_t)15) << 4) | min(match, (size_t)15)));
+
+			if (literalLength >= 15)
+				writeLength(out, literalLength - 15);
+
+			out.insert(out.end(), literals, literals + literalLength);
+
+			out.push_back((unsigned char)(offset & 0xFF));
+			out.push_back((unsigned char)(offset >> 8));
+
+			if (match >= 15)
+				writeLength(out, match - 15);
+		}
+
+		bool readLength(const unsigned char* source, const size_t& sourceSize, size_t& position, size_t& length) {
+			unsigned char value;
+
+			do {
+				if (position >= sourceSize)
+					return false;
+
+				value = source[position++];
+				length += value;
+			} while (value == 255);
+
+			return true;
+		}
+
+		void listFiles(const std::string& directory, const std::string& relative, std::vector<std::string>& out) {
+			DIR* dir = opendir((directory + relative).c_str());
+
+			if (dir == NULL)
+				return;
+
+			struct dirent* ent;
+
+			while ((ent = readdir(dir)) != NULL) {
+				std::string name = ent->d_name;
+
+				if (name == "." || name == "..")
+					continue;
+
+				if (ent->d_type == DT_DIR)
+					listFiles(directory, relative + name + "/", out);
+				else if (ent->d_type == DT_REG)
+					out.push_back(relative + name);
+			}
+
+			closedir(dir);
+		}
+
+		void pad(std::ofstream& file, uint64_t& position, const uint64_t& alignment) {
+			while (position % alignment != 0) {
+				file.put(0);
+				position += 1;
+			}
+		}
+	}
+
+	bool PackArchive::open(const std::string& path) {
+		archive = MappedFile::map(path);
+		header = nullptr;
+		entries = nullptr;
+		names = nullptr;
+
+		if (!archive.isValid() || archive.getSize() < sizeof(PackHeader)) {
+			Debug::systemErr("Couldn't open archive: {}", path);
+			archive = FileData();
+			return false;
+		}
+
+		const PackHeader* candidate = (const PackHeader*)archive.getData();
+		const uint64_t fileSize = archive.getSize();
+
+		bool valid = std::memcmp(candidate->magic, "HPAK", 4) == 0 && candidate->version == HFR_PACK_VERSION &&
+			candidate->tocOffset <= fileSize && (fileSize - candidate->tocOffset) / sizeof(PackEntry) >= candidate->entryAmount &&
+			candidate->namesOffset <= fileSize;
+
+		if (valid) {
+			const PackEntry* toc = (const PackEntry*)(archive.getData() + candidate->tocOffset);
+			const uint64_t namesSize = fileSize - candidate->namesOffset;
+
+			//checking every entry once here means reads never have to
+			for (uint32_t i = 0; i < candidate->entryAmount && valid; ++i) {
+				const PackEntry& entry = toc[i];
+
+				valid = entry.offset <= fileSize && entry.storedSize <= fileSize - entry.offset &&
+					entry.nameOffset <= namesSize && entry.nameLength <= namesSize - entry.nameOffset &&
+					((entry.flags & HFR_PACK_COMPRESSED) || entry.storedSize == entry.size);
+			}
+
+			entries = toc;
+		}
+
+		if (!valid) {
+			Debug::systemErr("Archive is corrupt or from a different version: {}", path);
+			archive = FileData();
+			entries = nullptr;
+			return false;
+		}
+
+		header = candidate;
+		names = (const char*)(archive.getData() + header->namesOffset);
+
+		return true;
+	}
+
+	bool PackArchive::isOpen() const {
+		return header != nullptr;
+	}
+
+	size_t PackArchive::getEntryAmount() const {
+		return header ? header->entryAmount : 0;
+	}
+
+	std::string PackArchive::getEntryName(const size_t& index) const {
+		if (index >= getEntryAmount())
+			return std::string();
+
+		return std::string(names + entries[index].nameOffset, entries[index].nameLength);
+	}
+
+	const PackEntry* PackArchive::find(const std::string& path) const {
+		if (header == nullptr)
+			return nullptr;
+
+		size_t low = 0;
+		size_t high = header->entryAmount;
+
+		while (low < high) {
+			size_t middle = low + (high - low) / 2;
+			const PackEntry& entry = entries[middle];
+
+			int result = path.compare(0, std::string::npos, names + entry.nameOffset, entry.nameLength);
+
+			if (result == 0)
+				return &entry;
+			else if (result < 0)
+				high = middle;
+			else
+				low = middle + 1;
+		}
+
+		return nullptr;
+	}
+
+	bool PackArchive::exists(const std::string& path) const {
+		return find(path) != nullptr;
+	}
+
+	long long PackArchive::getFileSize(const std::string& path) const {
+		const PackEntry* entry = find(path);
+		return entry ? (long long)entry->size : -1;
+	}
+
+	FileData PackArchive::read(const std::string& path) const {
+		const PackEntry* entry = find(path);
+
+		if (entry == nullptr)
+			return FileData();
+
+		if (!(entry->flags & HFR_PACK_COMPRESSED))
+			return archive.slice((size_t)entry->offset, (size_t)entry->size);
+
+		//not a vector so the buffer doesn't get zeroed just to be written over
+		std::shared_ptr<unsigned char> buffer(new unsigned char[(size_t)entry->size], std::default_delete<unsigned char[]>());
+
+		if (!decompressLZ4(archive.getData() + entry->offset, (size_t)entry->storedSize, buffer.get(), (size_t)entry->size)) {
+			Debug::systemErr("Couldn't decompress archived file: {}", path);
+			return FileData();
+		}
+
+		return FileData(buffer.get(), (size_t)entry->size, buffer);
+	}
+
+	bool PackArchive::build(const std::string& directory, const std::string& archivePath, const bool& compress) {
+		std::string root = directory;
+
+		if (!root.empty() && root.back() != '/' && root.back() != '\\')
+			root += '/';
+
+		std::vector<std::string> files;
+		listFiles(root, "", files);
+
+		//the toc gets binary searched so it has to be in the same order std::string compares in
+		std::sort(files.begin(), files.end());
+
+		std::ofstream file(archivePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't create archive: {}", archivePath);
+			return false;
+		}
+
+		PackHeader header = {};
+		std::memcpy(header.magic, "HPAK", 4);
+		header.version = HFR_PACK_VERSION;
+		header.entryAmount = (uint32_t)files.size();
+		header.alignment = HFR_PACK_ALIGNMENT;
+
+		file.write((const char*)&header, sizeof(header));
+		uint64_t position = sizeof(header);
+
+		std::vector<PackEntry> toc(files.size());
+		std::string names;
+		std::vector<unsigned char> compressed;
+		size_t compressedAmount = 0;
+
+		for (size_t i = 0; i < files.size(); ++i) {
+			FileData data = MappedFile::map(root + files[i]);
+
+			if (!data.isValid()) {
+				Debug::systemErr("Couldn't read file while packing: {}{}", root, files[i]);
+				return false;
+			}
+
+			pad(file, position, HFR_PACK_ALIGNMENT);
+
+			PackEntry& entry = toc[i];
+			entry = {};
+			entry.offset = position;
+			entry.size = data.getSize();
+			entry.storedSize = data.getSize();
+			entry.nameOffset = (uint32_t)names.size();
+			entry.nameLength = (uint32_t)files[i].size();
+
+			names += files[i];
+
+			const unsigned char* stored = data.getData();
+
+			if (compress && data.getSize() > 0) {
+				compressLZ4(data.getData(), data.getSize(), compressed);
+
+				//already compressed things (png, ttf) barely shrink, those are better off as zero copy views
+				if (compressed.size() <= data.getSize() - data.getSize() / 8) {
+					entry.flags |= HFR_PACK_COMPRESSED;
+					entry.storedSize = compressed.size();
+					stored = compressed.data();
+					compressedAmount += 1;
+				}
+			}
+
+			file.write((const char*)stored, (std::streamsize)entry.storedSize);
+			position += entry.storedSize;
+		}
+
+		pad(file, position, 8);
+		header.tocOffset = position;
+
+		file.write((const char*)toc.data(), (std::streamsize)(toc.size() * sizeof(PackEntry)));
+		position += toc.size() * sizeof(PackEntry);
+
+		header.namesOffset = position;
+		file.write(names.data(), (std::streamsize)names.size());
+
+		file.seekp(0);
+		file.write((const char*)&header, sizeof(header));
+
+		file.close();
+
+		if (file.fail()) {
+			Debug::systemErr("Couldn't write archive: {}", archivePath);
+			return false;
+		}
+
+		Debug::systemSuccess("Packed {} files ({} compressed) into: {}", files.size(), compressedAmount, archivePath);
+
+		return true;
+	}
+
+	void PackArchive::compressLZ4(const unsigned char* source, const size_t& size, std::vector<unsigned char>& out) {
+		out.clear();
+		out.reserve(size + size / 255 + 16);
+
+		size_t anchor = 0;
+		size_t position = 0;
+
+		if (size > LZ4_MATCH_LIMIT) {
+			std::vector<uint32_t> table((size_t)1 << LZ4_HASH_BITS, 0xFFFFFFFF);
+
+			const size_t matchStartLimit = size - LZ4_MATCH_LIMIT;
+			const size_t matchEndLimit = size - LZ4_LAST_LITERALS;
+
+			//skips ahead faster the longer it goes without a match so incompressible data doesn't take forever
+			size_t misses = 0;
+
+			while (position < matchStartLimit) {
+				uint32_t sequence = read32(source + position);
+				uint32_t hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+
+				uint32_t reference = table[hash];
+				table[hash] = (uint32_t)position;
+
+				if (reference == 0xFFFFFFFF || position - reference > LZ4_MAX_OFFSET || read32(source + reference) != sequence) {
+					position += 1 + (misses++ >> 6);
+					continue;
+				}
+
+				misses = 0;
+
+				size_t length = LZ4_MIN_MATCH;
+
+				while (position + length < matchEndLimit && source[reference + length] == source[position + length])
+					length += 1;
+
+				writeSequence(out, source + anchor, position - anchor, position - reference, length);
+
+				position += length;
+				anchor = position;
+			}
+		}
+
+		//whatever is left goes out as literals
+		size_t literalLength = size - anchor;
+
+		out.push_back((unsigned char)(min(literalLength, (size_t)15) << 4));
+
+		if (literalLength >= 15)
+			writeLength(out, literalLength - 15);
+
+		out.insert(out.end(), source + anchor, source + size);
+	}
+
+	bool PackArchive::decompressLZ4(const unsigned char* source, const size_t& sourceSize, unsigned char* destination, const size_t& destinationSize) {
+		size_t in = 0;
+		size_t out = 0;
+
+		while (in < sourceSize) {
+			unsigned char token = source[in++];
+
+			size_t literalLength = token >> 4;
+
+			if (literalLength == 15 && !readLength(source, sourceSize, in, literalLength))
+				return false;
+
+			if (literalLength > sourceSize - in || literalLength > destinationSize - out)
+				return false;
+
+			//short runs are most of them, a fixed 16 byte copy is a lot cheaper than a sized one when there's room to spill over
+			if (literalLength <= 16 && sourceSize - in >= 16 && destinationSize - out >= 16)
+				std::memcpy(destination + out, source + in, 16);
+			else
+				std::memcpy(destination + out, source + in, literalLength);
+			in += literalLength;
+			out += literalLength;
+
+			//the last sequence has no match
+			if (in == sourceSize)
+				break;
+
+			if (sourceSize - in < 2)
+				return false;
+
+			size_t offset = source[in] | ((size_t)source[in + 1] << 8);
+			in += 2;
+
+			if (offset == 0 || offset > out)
+				return false;
+
+			size_t matchLength = token & 15;
+
+			if (matchLength == 15 && !readLength(source, sourceSize, in, matchLength))
+				return false;
+
+			matchLength += LZ4_MIN_MATCH;
+
+			if (matchLength > destinationSize - out)
+				return false;
+
+			//matches can overlap what they're writing, copying in steps no bigger than the offset keeps that safe
+			const unsigned char* match = destination + out - offset;
+			const size_t spill = destinationSize - out - matchLength;
+
+			if (offset >= 16 && spill >= 16) {
+				for (size_t i = 0; i < matchLength; i += 16)
+					std::memcpy(destination + out + i, match + i, 16);
+			}
+			else if (offset >= 8 && spill >= 8) {
+				for (size_t i = 0; i < matchLength; i += 8)
+					std::memcpy(destination + out + i, match + i, 8);
+			}
+			else if (offset >= matchLength)
+				std::memcpy(destination + out, match, matchLength);
+			else {
+				for (size_t i = 0; i < matchLength; ++i)
+					destination[out + i] = match[i];
+			}
+
+			out += matchLength;
+		}
+
+		return out == destinationSize;
+	}
+
+}
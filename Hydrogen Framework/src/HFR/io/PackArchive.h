@@ -0,0 +1,61 @@
+#ifndef HFR_PACK_ARCHIVE_HEADER_INCLUDE
+#define HFR_PACK_ARCHIVE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VIRTUAL_FILE_SYSTEM
+
+namespace HFR {
+
+	//start of every .hpak file, the file data comes right after it and the toc and names come last
+	struct DLL_API PackHeader {
+		char magic[4];
+		uint32_t version;
+		uint32_t entryAmount;
+		uint32_t alignment;
+		uint64_t tocOffset;
+		uint64_t namesOffset;
+	};
+
+	//toc entries are sorted by name so lookups can binary search them
+	struct DLL_API PackEntry {
+		uint64_t offset;
+		uint64_t size;
+		//same as size unless the entry is compressed
+		uint64_t storedSize;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t flags;
+		uint32_t padding;
+	};
+
+	//one file holding a whole folder, the archive is mapped once and uncompressed entries are handed out straight from the mapping
+	class DLL_API PackArchive : public FileMount {
+	private:
+		FileData archive;
+		const PackHeader* header = nullptr;
+		const PackEntry* entries = nullptr;
+		const char* names = nullptr;
+
+		const PackEntry* find(const std::string& path) const;
+
+	public:
+		bool open(const std::string& path);
+		bool isOpen() const;
+		size_t getEntryAmount() const;
+		std::string getEntryName(const size_t& index) const;
+
+		bool exists(const std::string& path) const override;
+		long long getFileSize(const std::string& path) const override;
+		FileData read(const std::string& path) const override;
+
+		//packs every file under directory, with compress on entries get lz4 compressed when it saves at least an eighth of their size
+		static bool build(const std::string& directory, const std::string& archivePath, const bool& compress);
+
+		//lz4 block format (no frame header), decompress returns false on bad data instead of reading or writing out of bounds
+		static void compressLZ4(const unsigned char* source, const size_t& size, std::vector<unsigned char>& out);
+		static bool decompressLZ4(const unsigned char* source, const size_t& sourceSize, unsigned char* destination, const size_t& destinationSize);
+	};
+
+}
+
+#endif
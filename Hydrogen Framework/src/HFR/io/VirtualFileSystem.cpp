@@ -0,0 +1,364 @@
+#include "hfpch.h"
+#include HFR_VIRTUAL_FILE_SYSTEM
+#include HFR_PACK_ARCHIVE
+
+namespace HFR {
+
+	namespace {
+		struct MountPoint {
+			std::string path;
+			std::shared_ptr<FileMount> mount;
+		};
+
+		struct MountMatch {
+			std::shared_ptr<FileMount> mount;
+			std::string relativePath;
+		};
+
+		//function statics because shaders and textures get read during static initialization, before anything is mounted
+		std::vector<MountPoint>& getMounts() {
+			static std::vector<MountPoint> mounts;
+			return mounts;
+		}
+
+		std::mutex& getMountMutex() {
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		//every mount the path falls under, newest first
+		std::vector<MountMatch> findMounts(const std::string& path) {
+			std::vector<MountMatch> out;
+
+			std::lock_guard<std::mutex> lock(getMountMutex());
+			std::vector<MountPoint>& mounts = getMounts();
+
+			if (mounts.empty())
+				return out;
+
+			std::string normalized = VirtualFileSystem::normalizePath(path);
+
+			for (size_t i = mounts.size(); i > 0; --i) {
+				const MountPoint& point = mounts[i - 1];
+
+				if (normalized.compare(0, point.path.size(), point.path) == 0)
+					out.push_back({ point.mount, normalized.substr(point.path.size()) });
+			}
+
+			return out;
+		}
+	}
+
+	//file data
+
+	FileData::FileData() {}
+
+	FileData::FileData(const unsigned char* _data, const size_t& _size, const std::shared_ptr<const void>& _owner) {
+		data = _data;
+		size = _size;
+		owner = _owner;
+	}
+
+	bool FileData::isValid() const {
+		return owner != nullptr;
+	}
+
+	const unsigned char* FileData::getData() const {
+		return data;
+	}
+
+	size_t FileData::getSize() const {
+		return size;
+	}
+
+	std::string FileData::toString() const {
+		if (data == nullptr)
+			return std::string();
+
+		return std::string((const char*)data, size);
+	}
+
+	FileData FileData::slice(const size_t& offset, const size_t& _size) const {
+		if (offset > size || _size > size - offset)
+			return FileData();
+
+		return FileData(data + offset, _size, owner);
+	}
+
+	//mapped file
+
+	MappedFile::MappedFile() {}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+
+#if _WIN64
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+
+		if (!GetFileSizeEx(file, &fileSize)) {
+			CloseHandle(file);
+			return false;
+		}
+
+		fileHandle = file;
+		size = (size_t)fileSize.QuadPart;
+		opened = true;
+
+		//windows won't map empty files
+		if (size == 0)
+			return true;
+
+		mappingHandle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+		if (mappingHandle != NULL)
+			data = (const unsigned char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+		int file = ::open(path.c_str(), O_RDONLY);
+
+		if (file < 0)
+			return false;
+
+		struct stat info;
+
+		if (fstat(file, &info) != 0 || S_ISDIR(info.st_mode)) {
+			::close(file);
+			return false;
+		}
+
+		size = (size_t)info.st_size;
+		opened = true;
+
+		if (size > 0) {
+			void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+			if (mapped != MAP_FAILED)
+				data = (const unsigned char*)mapped;
+		}
+
+		//the mapping keeps its own reference to the file
+		::close(file);
+
+		if (size == 0)
+			return true;
+#endif
+
+		if (data == nullptr) {
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::close() {
+#if _WIN64
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+
+		if (mappingHandle != nullptr)
+			CloseHandle(mappingHandle);
+
+		if (fileHandle != nullptr)
+			CloseHandle(fileHandle);
+#else
+		if (data != nullptr)
+			munmap((void*)data, size);
+#endif
+
+		fileHandle = nullptr;
+		mappingHandle = nullptr;
+		data = nullptr;
+		size = 0;
+		opened = false;
+	}
+
+	bool MappedFile::isOpen() const {
+		return opened;
+	}
+
+	const unsigned char* MappedFile::getData() const {
+		return data;
+	}
+
+	size_t MappedFile::getSize() const {
+		return size;
+	}
+
+	FileData MappedFile::map(const std::string& path) {
+		std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+
+		if (!file->open(path))
+			return FileData();
+
+		return FileData(file->getData(), file->getSize(), file);
+	}
+
+	//directory mount
+
+	DirectoryMount::DirectoryMount(const std::string& _directory) {
+		directory = _directory;
+
+		if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+			directory += '/';
+	}
+
+	bool DirectoryMount::exists(const std::string& path) const {
+		return getFileSize(path) >= 0;
+	}
+
+	long long DirectoryMount::getFileSize(const std::string& path) const {
+		struct stat result;
+
+		if (stat((directory + path).c_str(), &result) != 0 || (result.st_mode & S_IFDIR))
+			return -1;
+
+		return (long long)result.st_size;
+	}
+
+	FileData DirectoryMount::read(const std::string& path) const {
+		return MappedFile::map(directory + path);
+	}
+
+	//virtual file system
+
+	void VirtualFileSystem::init() {
+		//loose files first so a packed archive sitting next to them wins
+		mountDirectory(HFR_RES, HFR_RES);
+
+		struct stat result;
+
+		if (stat(HFR_RES_ARCHIVE.c_str(), &result) == 0)
+			mountArchive(HFR_RES, HFR_RES_ARCHIVE);
+	}
+
+	void VirtualFileSystem::close() {
+		std::lock_guard<std::mutex> lock(getMountMutex());
+		getMounts().clear();
+	}
+
+	void VirtualFileSystem::mount(const std::string& mountPoint, const std::shared_ptr<FileMount>& mount) {
+		std::string path = normalizePath(mountPoint);
+
+		if (!path.empty())
+			path += '/';
+
+		std::lock_guard<std::mutex> lock(getMountMutex());
+		getMounts().push_back({ path, mount });
+	}
+
+	bool VirtualFileSystem::mountDirectory(const std::string& mountPoint, const std::string& directory) {
+		if (!Util::doesDirectoryExist(directory)) {
+			Debug::systemErr("Couldn't mount directory: {}", directory);
+			return false;
+		}
+
+		mount(mountPoint, std::make_shared<DirectoryMount>(directory));
+		Debug::systemSuccess("Mounted directory: {}", directory);
+
+		return true;
+	}
+
+	bool VirtualFileSystem::mountArchive(const std::string& mountPoint, const std::string& archivePath) {
+		std::shared_ptr<PackArchive> archive = std::make_shared<PackArchive>();
+
+		if (!archive->open(archivePath))
+			return false;
+
+		mount(mountPoint, archive);
+		Debug::systemSuccess("Mounted archive: {} with {} files", Util::removePathFromFilePathAndName(archivePath), archive->getEntryAmount());
+
+		return true;
+	}
+
+	void VirtualFileSystem::unmount(const std::string& mountPoint) {
+		std::string path = normalizePath(mountPoint);
+
+		if (!path.empty())
+			path += '/';
+
+		std::lock_guard<std::mutex> lock(getMountMutex());
+		std::vector<MountPoint>& mounts = getMounts();
+
+		mounts.erase(std::remove_if(mounts.begin(), mounts.end(), [&path](const MountPoint& point) { return point.path == path; }), mounts.end());
+	}
+
+	bool VirtualFileSystem::exists(const std::string& path) {
+		return getFileSize(path) >= 0;
+	}
+
+	long long VirtualFileSystem::getFileSize(const std::string& path) {
+		std::vector<MountMatch> matches = findMounts(path);
+
+		for (size_t i = 0; i < matches.size(); ++i) {
+			long long size = matches[i].mount->getFileSize(matches[i].relativePath);
+
+			if (size >= 0)
+				return size;
+		}
+
+		struct stat result;
+
+		if (stat(path.c_str(), &result) != 0 || (result.st_mode & S_IFDIR))
+			return -1;
+
+		return (long long)result.st_size;
+	}
+
+	FileData VirtualFileSystem::read(const std::string& path) {
+		std::vector<MountMatch> matches = findMounts(path);
+
+		for (size_t i = 0; i < matches.size(); ++i) {
+			FileData file = matches[i].mount->read(matches[i].relativePath);
+
+			if (file.isValid())
+				return file;
+		}
+
+		return MappedFile::map(path);
+	}
+
+	std::string VirtualFileSystem::normalizePath(const std::string& path) {
+		std::vector<std::string> parts;
+		std::string part;
+
+		bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+
+		for (size_t i = 0; i <= path.size(); ++i) {
+			if (i == path.size() || path[i] == '/' || path[i] == '\\') {
+				if (part == "..") {
+					if (!parts.empty() && parts.back() != "..")
+						parts.pop_back();
+					else if (!absolute)
+						parts.push_back(part);
+				}
+				else if (!part.empty() && part != ".")
+					parts.push_back(part);
+
+				part.clear();
+			}
+			else
+				part += path[i];
+		}
+
+		std::string out = absolute ? "/" : "";
+
+		for (size_t i = 0; i < parts.size(); ++i) {
+			if (i > 0)
+				out += '/';
+
+			out += parts[i];
+		}
+
+		return out;
+	}
+
+}
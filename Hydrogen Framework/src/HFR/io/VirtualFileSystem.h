@@ -0,0 +1,104 @@
+#ifndef HFR_VIRTUAL_FILE_SYSTEM_HEADER_INCLUDE
+#define HFR_VIRTUAL_FILE_SYSTEM_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	//read only view of a whole file, the bytes stay valid for as long as any copy of this is alive
+	class DLL_API FileData {
+	private:
+		const unsigned char* data = nullptr;
+		size_t size = 0;
+		//whatever actually owns the bytes (a file mapping or a decompressed buffer)
+		std::shared_ptr<const void> owner;
+
+	public:
+		FileData();
+		FileData(const unsigned char* data, const size_t& size, const std::shared_ptr<const void>& owner);
+
+		//false if the file couldn't be found or opened, empty files are still valid
+		bool isValid() const;
+		const unsigned char* getData() const;
+		size_t getSize() const;
+
+		std::string toString() const;
+		//view into part of this file that keeps the same owner alive
+		FileData slice(const size_t& offset, const size_t& size) const;
+	};
+
+	//read only memory mapping of a file on disk
+	class DLL_API MappedFile {
+	private:
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+		const unsigned char* data = nullptr;
+		size_t size = 0;
+		bool opened = false;
+
+	public:
+		MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		bool open(const std::string& path);
+		void close();
+
+		bool isOpen() const;
+		const unsigned char* getData() const;
+		size_t getSize() const;
+
+		//maps the file and hands out a view that keeps the mapping alive
+		static FileData map(const std::string& path);
+	};
+
+	//something that can be mounted, the paths it gets are relative to its mount point and use /
+	class DLL_API FileMount {
+	public:
+		virtual ~FileMount() {}
+
+		virtual bool exists(const std::string& path) const = 0;
+		//-1 if the file isn't there
+		virtual long long getFileSize(const std::string& path) const = 0;
+		virtual FileData read(const std::string& path) const = 0;
+	};
+
+	//loose files in a folder on disk
+	class DLL_API DirectoryMount : public FileMount {
+	private:
+		std::string directory;
+
+	public:
+		DirectoryMount(const std::string& directory);
+
+		bool exists(const std::string& path) const override;
+		long long getFileSize(const std::string& path) const override;
+		FileData read(const std::string& path) const override;
+	};
+
+	//every engine file read goes through here, paths under a mount point get served by that mount (the last mounted one wins)
+	//and anything else falls back to the normal file system
+	class DLL_API VirtualFileSystem {
+	public:
+		//mounts the res folder and, if there is one, the packed res archive over it
+		static void init();
+		static void close();
+
+		static void mount(const std::string& mountPoint, const std::shared_ptr<FileMount>& mount);
+		static bool mountDirectory(const std::string& mountPoint, const std::string& directory);
+		static bool mountArchive(const std::string& mountPoint, const std::string& archivePath);
+		static void unmount(const std::string& mountPoint);
+
+		static bool exists(const std::string& path);
+		//-1 if the file isn't there
+		static long long getFileSize(const std::string& path);
+		static FileData read(const std::string& path);
+
+		//forward slashes, no . or .. and no doubled up slashes
+		static std::string normalizePath(const std::string& path);
+	};
+
+}
+
+#endif
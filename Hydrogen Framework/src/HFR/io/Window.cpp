@@ -9,23 +9,24 @@ namespace HFR {
 	}
 
 	Window::~Window() {
-		Debug::systemLog("Attempting to delete window: " + name);
-		Debug::systemSuccess("Deleted window: " + name);
+		Debug::systemLog("Attempting to delete window: {}", name);
+		Debug::systemSuccess("Deleted window: {}", name);
 	}
 
 	void Window::create() {
 
-		Debug::systemLog("Attempting to create window: " + name + ", With dimensions: " + std::to_string(size.x) + ", " + std::to_string(size.y));
+		Debug::systemLog("Attempting to create window: {}, With dimensions: {}, {}", name, size.x, size.y);
 
 		monitor = glfwGetPrimaryMonitor();
+		glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 		window = glfwCreateWindow(size.x, size.y, name.c_str(), NULL, NULL);
 		
 		if (!window) {
-			Debug::systemErr("Failed to create window: " + name);
+			Debug::systemErr("Failed to create window: {}", name);
 			exit(1);
 		}
 		else {
-			Debug::systemSuccess("Created window: " + name);
+			Debug::systemSuccess("Created window: {}", name);
 			Debug::resetTextColor();
 		}
 
@@ -34,11 +35,22 @@ namespace HFR {
 		glfwSwapInterval(0);
 		glEnable(GL_DEPTH_TEST);
 
-		glfwShowWindow(window);
+		if (visible)
+			glfwShowWindow(window);
 	}
 
 	void Window::update() {
-		glfwSwapBuffers(window);
+		//gui only gets queued while the frame is being made, text goes on top
+		QuadBatcher::flush();
+		TextBatcher::flush();
+		GpuProfiler::endFrame();
+
+		{
+			//mostly waiting on the gpu to catch up
+			ProfileGpu("Swap buffers");
+			glfwSwapBuffers(window);
+		}
+
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glfwPollEvents();
 		glfwGetWindowSize(window, &size.x, &size.y);
@@ -81,12 +93,8 @@ namespace HFR {
 	}
 
 	void Window::limitFps(const int& fps) {
-		float waitTime = (float)1000 / fps;
-		float sleepTime = waitTime - Time::getDeltaTime();
-
-		if (sleepTime > 0) {
-			Sleep((DWORD)sleepTime);
-		}
+		//the wait happens at the start of the next frame in Engine::updateEngine
+		Time::setTargetFps(fps);
 	}
 
 	void Window::setIcon(Image& image) {
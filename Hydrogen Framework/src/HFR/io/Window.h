@@ -26,6 +26,8 @@ namespace HFR {
 		GLFWwindow* window;
 		Vec2i size, position;
 		std::string name;
+		//set before create, a hidden window still has a context to render into, for runs that only want the timings
+		bool visible = true;
 
 		Window(const Vec2i& _size, const std::string& _Name);
 		~Window();
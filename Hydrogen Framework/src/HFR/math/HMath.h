@@ -7,6 +7,8 @@
 #include HFR_VEC3
 #include HFR_VEC4
 #include HFR_MAT4
+#include HFR_MATRIX_KERNELS
+#include HFR_QUATERNION
 #include HFR_TRANSFORM
 #include HFR_RANDOM
 
@@ -2,6 +2,8 @@
 
 namespace HFR {
 
+	unsigned int Random::seed = 1;
+
 	double Random::range(const int& smallest, const int& largest) {
 		return ((rand() % largest) - (double)smallest);
 	}
@@ -10,12 +12,17 @@ namespace HFR {
 		return Vec3f((float)range(-360, 360), (float)range(-360, 360), (float)range(-360, 360));
 	}
 
-	void Random::setSeed(const unsigned int& seed) {
+	void Random::setSeed(const unsigned int& _seed) {
+		seed = _seed;
 		srand(seed);
 	}
 
+	unsigned int Random::getSeed() {
+		return seed;
+	}
+
 	void Random::randomSeed() {
-		srand(rand());
+		setSeed((unsigned int)rand());
 	}
 
 	void Random::init() {
@@ -9,11 +9,16 @@ namespace HFR {
 	struct Vec3f;
 
 	class DLL_API Random {
+	private:
+		static unsigned int seed;
+
 	public:
 		static double range(const int& smallest, const int& largest);
 
 		static Vec3f rotation();
 		static void setSeed(const unsigned int& seed);
+		//the last seed that got set, what replays record to get the same numbers again
+		static unsigned int getSeed();
 		static void randomSeed();
 		static void init();
 
@@ -40,31 +40,13 @@ namespace HFR {
 		m33 = 1.0f;
 	}
 
-	Mat4f Mat4f::operator*(const Mat4f& other) {
-		Mat4f out = Mat4f();
-		out.setIdentity();
-
-		out.m00 = m00 * other.m00 + m10 * other.m01 + m20 * other.m02 + m30 * other.m03;
-		out.m01 = m01 * other.m00 + m11 * other.m01 + m21 * other.m02 + m31 * other.m03;
-		out.m02 = m02 * other.m00 + m12 * other.m01 + m22 * other.m02 + m32 * other.m03;
-		out.m03 = m03 * other.m00 + m13 * other.m01 + m23 * other.m02 + m33 * other.m03;
-		out.m10 = m00 * other.m10 + m10 * other.m11 + m20 * other.m12 + m30 * other.m13;
-		out.m11 = m01 * other.m10 + m11 * other.m11 + m21 * other.m12 + m31 * other.m13;
-		out.m12 = m02 * other.m10 + m12 * other.m11 + m22 * other.m12 + m32 * other.m13;
-		out.m13 = m03 * other.m10 + m13 * other.m11 + m23 * other.m12 + m33 * other.m13;
-		out.m20 = m00 * other.m20 + m10 * other.m21 + m20 * other.m22 + m30 * other.m23;
-		out.m21 = m01 * other.m20 + m11 * other.m21 + m21 * other.m22 + m31 * other.m23;
-		out.m22 = m02 * other.m20 + m12 * other.m21 + m22 * other.m22 + m32 * other.m23;
-		out.m23 = m03 * other.m20 + m13 * other.m21 + m23 * other.m22 + m33 * other.m23;
-		out.m30 = m00 * other.m30 + m10 * other.m31 + m20 * other.m32 + m30 * other.m33;
-		out.m31 = m01 * other.m30 + m11 * other.m31 + m21 * other.m32 + m31 * other.m33;
-		out.m32 = m02 * other.m30 + m12 * other.m31 + m22 * other.m32 + m32 * other.m33;
-		out.m33 = m03 * other.m30 + m13 * other.m31 + m23 * other.m32 + m33 * other.m33;
-
+	Mat4f Mat4f::operator*(const Mat4f& other) const {
+		Mat4f out;
+		MatrixKernels::multiply(*this, other, out);
 		return out;
 	}
 
-	Mat4f Mat4f::operator*(const Vec4f& other) {
+	Mat4f Mat4f::operator*(const Vec4f& other) const {
 		Mat4f out = Mat4f();
 		out.setIdentity();
 
@@ -87,45 +69,14 @@ namespace HFR {
 		return out;
 	}
 
-	Mat4f Mat4f::operator*=(const Mat4f& other) {
-
-		m00 = m00 * other.m00 + m10 * other.m01 + m20 * other.m02 + m30 * other.m03;
-		m01 = m01 * other.m00 + m11 * other.m01 + m21 * other.m02 + m31 * other.m03;
-		m02 = m02 * other.m00 + m12 * other.m01 + m22 * other.m02 + m32 * other.m03;
-		m03 = m03 * other.m00 + m13 * other.m01 + m23 * other.m02 + m33 * other.m03;
-		m10 = m00 * other.m10 + m10 * other.m11 + m20 * other.m12 + m30 * other.m13;
-		m11 = m01 * other.m10 + m11 * other.m11 + m21 * other.m12 + m31 * other.m13;
-		m12 = m02 * other.m10 + m12 * other.m11 + m22 * other.m12 + m32 * other.m13;
-		m13 = m03 * other.m10 + m13 * other.m11 + m23 * other.m12 + m33 * other.m13;
-		m20 = m00 * other.m20 + m10 * other.m21 + m20 * other.m22 + m30 * other.m23;
-		m21 = m01 * other.m20 + m11 * other.m21 + m21 * other.m22 + m31 * other.m23;
-		m22 = m02 * other.m20 + m12 * other.m21 + m22 * other.m22 + m32 * other.m23;
-		m23 = m03 * other.m20 + m13 * other.m21 + m23 * other.m22 + m33 * other.m23;
-		m30 = m00 * other.m30 + m10 * other.m31 + m20 * other.m32 + m30 * other.m33;
-		m31 = m01 * other.m30 + m11 * other.m31 + m21 * other.m32 + m31 * other.m33;
-		m32 = m02 * other.m30 + m12 * other.m31 + m22 * other.m32 + m32 * other.m33;
-		m33 = m03 * other.m30 + m13 * other.m31 + m23 * other.m32 + m33 * other.m33;
-
+	Mat4f& Mat4f::operator*=(const Mat4f& other) {
+		//the kernel reads everything before writing so this can be multiplied in place
+		MatrixKernels::multiply(*this, other, *this);
 		return *this;
 	}
 
 	void Mat4f::transpose(const Mat4f& src) {
-		m00 = src.m00;
-		m01 = src.m10;
-		m02 = src.m20;
-		m03 = src.m30;
-		m10 = src.m01;
-		m11 = src.m11;
-		m12 = src.m21;
-		m13 = src.m31;
-		m20 = src.m02;
-		m21 = src.m12;
-		m22 = src.m22;
-		m23 = src.m32;
-		m30 = src.m03;
-		m31 = src.m13;
-		m32 = src.m23;
-		m33 = src.m33;
+		MatrixKernels::transpose(src, *this);
 	}
 
 	void Mat4f::transposeWithoutRotation(const Mat4f& src) {
@@ -244,29 +195,73 @@ namespace HFR {
 		m33 += m03 * vec.x + m13 * vec.y;
 	}
 
+	bool Mat4f::invert(const Mat4f& src) {
+		return MatrixKernels::inverse(src, *this);
+	}
+
+	Vec3f Mat4f::transformPoint(const Vec3f& point) const {
+		return MatrixKernels::transformPoint(*this, point);
+	}
+
 	//create important matrixes
+
+	//translation * rotationX * rotationY * rotationZ * scale written out by hand, same result as translate, rotate (x3) and scale without the 3 full matrix multiplies
 	Mat4f Mat4f::createTransformationMatrix(const Vec3f& translation, const Vec3f& rotation, const Vec3f& scale) {
+		float rx = (float)HMath::toRadians(rotation.x);
+		float ry = (float)HMath::toRadians(rotation.y);
+		float rz = (float)HMath::toRadians(rotation.z);
+
+		float sinX = (float)sin(rx), cosX = (float)cos(rx);
+		float sinY = (float)sin(ry), cosY = (float)cos(ry);
+		float sinZ = (float)sin(rz), cosZ = (float)cos(rz);
+
+		float sinXsinY = sinX * sinY;
+		float cosXsinY = cosX * sinY;
+
 		Mat4f transformation = Mat4f();
-		transformation.setIdentity();
-		transformation.translate(translation);
-		transformation.rotate((float)HMath::toRadians(rotation.x), Vec3f(1, 0, 0));
-		transformation.rotate((float)HMath::toRadians(rotation.y), Vec3f(0, 1, 0));
-		transformation.rotate((float)HMath::toRadians(rotation.z), Vec3f(0, 0, 1));
-		transformation.scale(scale);
+
+		transformation.m00 = cosY * cosZ * scale.x;
+		transformation.m01 = (cosX * sinZ + sinXsinY * cosZ) * scale.x;
+		transformation.m02 = (sinX * sinZ - cosXsinY * cosZ) * scale.x;
+		transformation.m10 = -cosY * sinZ * scale.y;
+		transformation.m11 = (cosX * cosZ - sinXsinY * sinZ) * scale.y;
+		transformation.m12 = (sinX * cosZ + cosXsinY * sinZ) * scale.y;
+		transformation.m20 = sinY * scale.z;
+		transformation.m21 = -sinX * cosY * scale.z;
+		transformation.m22 = cosX * cosY * scale.z;
+		transformation.m30 = translation.x;
+		transformation.m31 = translation.y;
+		transformation.m32 = translation.z;
+		transformation.m33 = 1.0f;
+
 		return transformation;
 	}
 
-	Mat4f Mat4f::createTransformationMatrix(const Vec2f& translation, const Vec3f& rotation, const Vec2f& scale) {
+	Mat4f Mat4f::createTransformationMatrix(const Vec3f& translation, const Quaternion& rotation, const Vec3f& scale) {
 		Mat4f transformation = Mat4f();
-		transformation.setIdentity();
-		transformation.translate(translation);
-		transformation.rotate((float)HMath::toRadians(rotation.x), Vec3f(1, 0, 0));
-		transformation.rotate((float)HMath::toRadians(rotation.y), Vec3f(0, 1, 0));
-		transformation.rotate((float)HMath::toRadians(rotation.z), Vec3f(0, 0, 1));
-		transformation.scale(Vec3f(scale.x, scale.y, 1));
+		rotation.toRotationMatrix(transformation);
+
+		transformation.m00 *= scale.x;
+		transformation.m01 *= scale.x;
+		transformation.m02 *= scale.x;
+		transformation.m10 *= scale.y;
+		transformation.m11 *= scale.y;
+		transformation.m12 *= scale.y;
+		transformation.m20 *= scale.z;
+		transformation.m21 *= scale.z;
+		transformation.m22 *= scale.z;
+		transformation.m30 = translation.x;
+		transformation.m31 = translation.y;
+		transformation.m32 = translation.z;
+		transformation.m33 = 1.0f;
+
 		return transformation;
 	}
 
+	Mat4f Mat4f::createTransformationMatrix(const Vec2f& translation, const Vec3f& rotation, const Vec2f& scale) {
+		return createTransformationMatrix(Vec3f(translation.x, translation.y, 0), rotation, Vec3f(scale.x, scale.y, 1));
+	}
+
 	Mat4f Mat4f::createTransformationMatrix_ScaleBeforeRotation(const Vec2f& translation, const Vec3f& rotation, const Vec2f& scale) {
 		Mat4f transformation = Mat4f();
 		transformation.setIdentity();
@@ -317,4 +312,17 @@ namespace HFR {
 		return viewMatrix;
 	}
 
+	Mat4f Mat4f::lerp(const Mat4f& from, const Mat4f& to, const float& percentage) {
+		Mat4f out;
+
+		const float* a = &from.m00;
+		const float* b = &to.m00;
+		float* result = &out.m00;
+
+		for (int i = 0; i < 16; ++i)
+			result[i] = a[i] + (b[i] - a[i]) * percentage;
+
+		return out;
+	}
+
 };
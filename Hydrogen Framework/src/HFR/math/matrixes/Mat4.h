@@ -10,9 +10,11 @@ namespace HFR {
 	struct Vec2f;
 	struct Vec3f;
 	struct Vec4f;
+	struct Quaternion;
 	class FloatBuffer;
 
-	struct DLL_API Mat4f {
+	//16 byte aligned so the columns can be loaded straight into sse registers (see MatrixKernels)
+	struct DLL_API alignas(16) Mat4f {
 		float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33;
 
 		Mat4f();
@@ -35,9 +37,17 @@ namespace HFR {
 
 		void translate(const Vec2f& translation);
 
+		//returns false and leaves this alone if src can't be inverted
+		bool invert(const Mat4f& src);
+
+		//treats the point as w = 1
+		Vec3f transformPoint(const Vec3f& point) const;
+
 		//create important matrixes
 		static Mat4f createTransformationMatrix(const Vec3f& translation, const Vec3f& rotation, const Vec3f& scale);
 
+		static Mat4f createTransformationMatrix(const Vec3f& translation, const Quaternion& rotation, const Vec3f& scale);
+
 		static Mat4f createTransformationMatrix(const Vec2f& translation, const Vec3f& rotation, const Vec2f& scale);
 
 		static Mat4f createTransformationMatrix_ScaleBeforeRotation(const Vec2f& translation, const Vec3f& rotation, const Vec2f& scale);
@@ -48,13 +58,16 @@ namespace HFR {
 
 		static Mat4f createViewMatrix(const Vec3f& position, const Vec3f& rotation);
 
-		Mat4f operator*(const Mat4f& other);
+		//every element on its own, close enough between two fixed steps, rotations far apart come out a bit shrunk
+		static Mat4f lerp(const Mat4f& from, const Mat4f& to, const float& percentage);
+
+		Mat4f operator*(const Mat4f& other) const;
 
-		Mat4f operator*(const Vec4f& other);
+		Mat4f operator*(const Vec4f& other) const;
 
 		friend Vec4f operator*(const Vec4f& other, const Mat4f& matrix);
 
-		Mat4f operator*=(const Mat4f& other);
+		Mat4f& operator*=(const Mat4f& other);
 
 	};
 }
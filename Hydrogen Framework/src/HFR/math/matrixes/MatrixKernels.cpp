@@ -0,0 +1,727 @@
+#include "hfpch.h"
+#include HFR_MATRIX_KERNELS
+
+namespace HFR {
+
+	namespace {
+
+		//same value HMath::toRadians uses so the batch kernels match Mat4f::createTransformationMatrix
+		const float degreesToRadians = 3.14159265f / 180.0f;
+
+		//thin wrappers so the batch kernels only have to be written once for every vector width
+		struct SSE2 {
+			typedef __m128 Float;
+			typedef __m128i Int;
+			static const size_t width = 4;
+
+			static inline Float set(const float& value) { return _mm_set1_ps(value); }
+			static inline Float load(const float* data) { return _mm_loadu_ps(data); }
+			static inline void store(float* data, Float a) { _mm_storeu_ps(data, a); }
+			static inline Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+			static inline Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+			static inline Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+			static inline Float madd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+			static inline Float bitAnd(Float a, Float b) { return _mm_and_ps(a, b); }
+			static inline Float bitXor(Float a, Float b) { return _mm_xor_ps(a, b); }
+			//a & ~b
+			static inline Float bitAndNot(Float a, Float b) { return _mm_andnot_ps(b, a); }
+			static inline Float select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+			static inline Int setInt(const int& value) { return _mm_set1_epi32(value); }
+			static inline Int toInt(Float a) { return _mm_cvttps_epi32(a); }
+			static inline Float toFloat(Int a) { return _mm_cvtepi32_ps(a); }
+			static inline Float asFloat(Int a) { return _mm_castsi128_ps(a); }
+			static inline Int addInt(Int a, Int b) { return _mm_add_epi32(a, b); }
+			static inline Int subInt(Int a, Int b) { return _mm_sub_epi32(a, b); }
+			static inline Int andInt(Int a, Int b) { return _mm_and_si128(a, b); }
+			static inline Int notInt(Int a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+
+			//((quadrant & 4) << 29) as a float sign bit
+			static inline Float quadrantSign(Int quadrant) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(4)), 29)); }
+			//all bits set where (quadrant & 2) == 0
+			static inline Float quadrantMask(Int quadrant) { return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), _mm_setzero_si128())); }
+
+			//transposes 4 element vectors and stores 4 floats for every lane, lane n goes to out + n * stride
+			static inline void storeColumns(Float a, Float b, Float c, Float d, float* out, const size_t& stride) {
+				_MM_TRANSPOSE4_PS(a, b, c, d);
+				_mm_storeu_ps(out, a);
+				_mm_storeu_ps(out + stride, b);
+				_mm_storeu_ps(out + stride * 2, c);
+				_mm_storeu_ps(out + stride * 3, d);
+			}
+		};
+
+		struct AVX2 {
+			typedef __m256 Float;
+			typedef __m256i Int;
+			static const size_t width = 8;
+
+			static inline Float set(const float& value) { return _mm256_set1_ps(value); }
+			static inline Float load(const float* data) { return _mm256_loadu_ps(data); }
+			static inline void store(float* data, Float a) { _mm256_storeu_ps(data, a); }
+			static inline Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+			static inline Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+			static inline Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+			static inline Float madd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+			static inline Float bitAnd(Float a, Float b) { return _mm256_and_ps(a, b); }
+			static inline Float bitXor(Float a, Float b) { return _mm256_xor_ps(a, b); }
+			static inline Float bitAndNot(Float a, Float b) { return _mm256_andnot_ps(b, a); }
+			static inline Float select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+
+			static inline Int setInt(const int& value) { return _mm256_set1_epi32(value); }
+			static inline Int toInt(Float a) { return _mm256_cvttps_epi32(a); }
+			static inline Float toFloat(Int a) { return _mm256_cvtepi32_ps(a); }
+			static inline Float asFloat(Int a) { return _mm256_castsi256_ps(a); }
+			static inline Int addInt(Int a, Int b) { return _mm256_add_epi32(a, b); }
+			static inline Int subInt(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+			static inline Int andInt(Int a, Int b) { return _mm256_and_si256(a, b); }
+			static inline Int notInt(Int a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+
+			static inline Float quadrantSign(Int quadrant) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(4)), 29)); }
+			static inline Float quadrantMask(Int quadrant) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), _mm256_setzero_si256())); }
+
+			static inline void storeColumns(Float a, Float b, Float c, Float d, float* out, const size_t& stride) {
+				SSE2::storeColumns(_mm256_castps256_ps128(a), _mm256_castps256_ps128(b), _mm256_castps256_ps128(c), _mm256_castps256_ps128(d), out, stride);
+				SSE2::storeColumns(_mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1), _mm256_extractf128_ps(c, 1), _mm256_extractf128_ps(d, 1), out + stride * 4, stride);
+			}
+		};
+
+		struct AVX512 {
+			typedef __m512 Float;
+			typedef __m512i Int;
+			static const size_t width = 16;
+
+			static inline Float set(const float& value) { return _mm512_set1_ps(value); }
+			static inline Float load(const float* data) { return _mm512_loadu_ps(data); }
+			static inline void store(float* data, Float a) { _mm512_storeu_ps(data, a); }
+			static inline Float add(Float a, Float b) { return _mm512_add_ps(a, b); }
+			static inline Float sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+			static inline Float mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+			static inline Float madd(Float a, Float b, Float c) { return _mm512_fmadd_ps(a, b, c); }
+			//float bitwise ops are avx512dq, so go through the integer ones (avx512f)
+			static inline Float bitAnd(Float a, Float b) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+			static inline Float bitXor(Float a, Float b) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+			static inline Float bitAndNot(Float a, Float b) { return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(b), _mm512_castps_si512(a))); }
+			static inline Float select(Float mask, Float a, Float b) { return _mm512_mask_blend_ps(_mm512_test_epi32_mask(_mm512_castps_si512(mask), _mm512_castps_si512(mask)), b, a); }
+
+			static inline Int setInt(const int& value) { return _mm512_set1_epi32(value); }
+			static inline Int toInt(Float a) { return _mm512_cvttps_epi32(a); }
+			static inline Float toFloat(Int a) { return _mm512_cvtepi32_ps(a); }
+			static inline Float asFloat(Int a) { return _mm512_castsi512_ps(a); }
+			static inline Int addInt(Int a, Int b) { return _mm512_add_epi32(a, b); }
+			static inline Int subInt(Int a, Int b) { return _mm512_sub_epi32(a, b); }
+			static inline Int andInt(Int a, Int b) { return _mm512_and_si512(a, b); }
+			static inline Int notInt(Int a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+
+			static inline Float quadrantSign(Int quadrant) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_and_si512(quadrant, _mm512_set1_epi32(4)), 29)); }
+			static inline Float quadrantMask(Int quadrant) {
+				__mmask16 zero = _mm512_testn_epi32_mask(quadrant, _mm512_set1_epi32(2));
+				return _mm512_castsi512_ps(_mm512_maskz_mov_epi32(zero, _mm512_set1_epi32(-1)));
+			}
+
+			static inline void storeColumns(Float a, Float b, Float c, Float d, float* out, const size_t& stride) {
+				SSE2::storeColumns(_mm512_castps512_ps128(a), _mm512_castps512_ps128(b), _mm512_castps512_ps128(c), _mm512_castps512_ps128(d), out, stride);
+				SSE2::storeColumns(_mm512_extractf32x4_ps(a, 1), _mm512_extractf32x4_ps(b, 1), _mm512_extractf32x4_ps(c, 1), _mm512_extractf32x4_ps(d, 1), out + stride * 4, stride);
+				SSE2::storeColumns(_mm512_extractf32x4_ps(a, 2), _mm512_extractf32x4_ps(b, 2), _mm512_extractf32x4_ps(c, 2), _mm512_extractf32x4_ps(d, 2), out + stride * 8, stride);
+				SSE2::storeColumns(_mm512_extractf32x4_ps(a, 3), _mm512_extractf32x4_ps(b, 3), _mm512_extractf32x4_ps(c, 3), _mm512_extractf32x4_ps(d, 3), out + stride * 12, stride);
+			}
+		};
+
+		//cephes style sin and cos at the same time, good to about 1e-7 in [-8192, 8192] radians
+		template<typename S>
+		inline void sinCos(typename S::Float x, typename S::Float& sinOut, typename S::Float& cosOut) {
+			typedef typename S::Float Float;
+			typedef typename S::Int Int;
+
+			const Float signMask = S::asFloat(S::setInt((int)0x80000000));
+
+			Float sinSign = S::bitAnd(x, signMask);
+			x = S::bitAndNot(x, signMask);
+
+			//which octant we are in (multiplied by 4 / pi)
+			Int quadrant = S::toInt(S::mul(x, S::set(1.27323954473516f)));
+			quadrant = S::andInt(S::addInt(quadrant, S::setInt(1)), S::setInt(~1));
+			Float y = S::toFloat(quadrant);
+
+			sinSign = S::bitXor(sinSign, S::quadrantSign(quadrant));
+			Float cosSign = S::quadrantSign(S::notInt(S::subInt(quadrant, S::setInt(2))));
+			Float polyMask = S::quadrantMask(quadrant);
+
+			//extended precision modular arithmetic
+			x = S::madd(y, S::set(-0.78515625f), x);
+			x = S::madd(y, S::set(-2.4187564849853515625e-4f), x);
+			x = S::madd(y, S::set(-3.77489497744594108e-8f), x);
+
+			Float z = S::mul(x, x);
+
+			//cos polynomial (0 <= x <= pi / 4)
+			Float cosPoly = S::set(2.443315711809948e-5f);
+			cosPoly = S::madd(cosPoly, z, S::set(-1.388731625493765e-3f));
+			cosPoly = S::madd(cosPoly, z, S::set(4.166664568298827e-2f));
+			cosPoly = S::mul(S::mul(cosPoly, z), z);
+			cosPoly = S::add(S::sub(cosPoly, S::mul(z, S::set(0.5f))), S::set(1.0f));
+
+			//sin polynomial
+			Float sinPoly = S::set(-1.9515295891e-4f);
+			sinPoly = S::madd(sinPoly, z, S::set(8.3321608736e-3f));
+			sinPoly = S::madd(sinPoly, z, S::set(-1.6666654611e-1f));
+			sinPoly = S::madd(S::mul(sinPoly, z), x, x);
+
+			sinOut = S::bitXor(S::select(polyMask, sinPoly, cosPoly), sinSign);
+			cosOut = S::bitXor(S::select(polyMask, cosPoly, sinPoly), cosSign);
+		}
+
+		//builds lanes worth of translation * rotationX * rotationY * rotationZ * scale matrices, m is column major like Mat4f
+		template<typename S>
+		inline void buildTransformationMatrices(const TransformArrays& t, const size_t& i, typename S::Float* m) {
+			typedef typename S::Float Float;
+
+			const Float radians = S::set(degreesToRadians);
+
+			Float sinX, cosX, sinY, cosY, sinZ, cosZ;
+			sinCos<S>(S::mul(S::load(t.rotationX + i), radians), sinX, cosX);
+			sinCos<S>(S::mul(S::load(t.rotationY + i), radians), sinY, cosY);
+			sinCos<S>(S::mul(S::load(t.rotationZ + i), radians), sinZ, cosZ);
+
+			Float scaleX = S::load(t.scaleX + i);
+			Float scaleY = S::load(t.scaleY + i);
+			Float scaleZ = S::load(t.scaleZ + i);
+
+			Float sinXsinY = S::mul(sinX, sinY);
+			Float cosXsinY = S::mul(cosX, sinY);
+
+			m[0] = S::mul(S::mul(cosY, cosZ), scaleX);
+			m[1] = S::mul(S::madd(sinXsinY, cosZ, S::mul(cosX, sinZ)), scaleX);
+			m[2] = S::mul(S::sub(S::mul(sinX, sinZ), S::mul(cosXsinY, cosZ)), scaleX);
+			m[3] = S::set(0);
+
+			m[4] = S::mul(S::mul(S::mul(cosY, sinZ), S::set(-1.0f)), scaleY);
+			m[5] = S::mul(S::sub(S::mul(cosX, cosZ), S::mul(sinXsinY, sinZ)), scaleY);
+			m[6] = S::mul(S::madd(cosXsinY, sinZ, S::mul(sinX, cosZ)), scaleY);
+			m[7] = S::set(0);
+
+			m[8] = S::mul(sinY, scaleZ);
+			m[9] = S::mul(S::mul(S::mul(sinX, cosY), S::set(-1.0f)), scaleZ);
+			m[10] = S::mul(S::mul(cosX, cosY), scaleZ);
+			m[11] = S::set(0);
+
+			m[12] = S::load(t.positionX + i);
+			m[13] = S::load(t.positionY + i);
+			m[14] = S::load(t.positionZ + i);
+			m[15] = S::set(1);
+		}
+
+		template<typename S>
+		inline void storeMatrices(const typename S::Float* m, Mat4f* out) {
+			float* base = &out->m00;
+			S::storeColumns(m[0], m[1], m[2], m[3], base, 16);
+			S::storeColumns(m[4], m[5], m[6], m[7], base + 4, 16);
+			S::storeColumns(m[8], m[9], m[10], m[11], base + 8, 16);
+			S::storeColumns(m[12], m[13], m[14], m[15], base + 12, 16);
+		}
+
+		void createTransformationMatrixFast(const TransformArrays& t, const size_t& i, Mat4f& out) {
+			out = Mat4f::createTransformationMatrix(Vec3f(t.positionX[i], t.positionY[i], t.positionZ[i]), Vec3f(t.rotationX[i], t.rotationY[i], t.rotationZ[i]), Vec3f(t.scaleX[i], t.scaleY[i], t.scaleZ[i]));
+		}
+
+		template<typename S>
+		void createTransformationMatricesSimd(const TransformArrays& transforms, Mat4f* out, const size_t& count) {
+			typename S::Float m[16];
+			size_t i = 0;
+
+			for (; i + S::width <= count; i += S::width) {
+				buildTransformationMatrices<S>(transforms, i, m);
+				storeMatrices<S>(m, out + i);
+			}
+
+			//leftovers that don't fill a whole vector
+			for (; i < count; ++i)
+				createTransformationMatrixFast(transforms, i, out[i]);
+		}
+
+		template<typename S>
+		void createMVPMatricesSimd(const Mat4f& projectionView, const TransformArrays& transforms, Mat4f* models, Mat4f* mvps, const size_t& count) {
+			typedef typename S::Float Float;
+
+			const float* pv = &projectionView.m00;
+
+			//pv[column * 4 + row] broadcast once
+			Float p[16];
+			for (int j = 0; j < 16; ++j)
+				p[j] = S::set(pv[j]);
+
+			Float m[16];
+			Float mvp[16];
+			size_t i = 0;
+
+			for (; i + S::width <= count; i += S::width) {
+				buildTransformationMatrices<S>(transforms, i, m);
+
+				if (models)
+					storeMatrices<S>(m, models + i);
+
+				//the bottom row of a transformation matrix is (0, 0, 0, 1) so only 3 terms per element (plus translation)
+				for (int column = 0; column < 3; ++column) {
+					for (int row = 0; row < 4; ++row) {
+						Float sum = S::mul(p[row], m[column * 4]);
+						sum = S::madd(p[4 + row], m[column * 4 + 1], sum);
+						mvp[column * 4 + row] = S::madd(p[8 + row], m[column * 4 + 2], sum);
+					}
+				}
+
+				for (int row = 0; row < 4; ++row) {
+					Float sum = S::madd(p[row], m[12], p[12 + row]);
+					sum = S::madd(p[4 + row], m[13], sum);
+					mvp[12 + row] = S::madd(p[8 + row], m[14], sum);
+				}
+
+				storeMatrices<S>(mvp, mvps + i);
+			}
+
+			for (; i < count; ++i) {
+				Mat4f model;
+				createTransformationMatrixFast(transforms, i, model);
+
+				if (models)
+					models[i] = model;
+
+				MatrixKernels::multiply(projectionView, model, mvps[i]);
+			}
+		}
+
+		template<typename S>
+		void transformPointsSimd(const Mat4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, const size_t& count) {
+			typedef typename S::Float Float;
+
+			const Float m00 = S::set(matrix.m00), m01 = S::set(matrix.m01), m02 = S::set(matrix.m02);
+			const Float m10 = S::set(matrix.m10), m11 = S::set(matrix.m11), m12 = S::set(matrix.m12);
+			const Float m20 = S::set(matrix.m20), m21 = S::set(matrix.m21), m22 = S::set(matrix.m22);
+			const Float m30 = S::set(matrix.m30), m31 = S::set(matrix.m31), m32 = S::set(matrix.m32);
+
+			size_t i = 0;
+
+			for (; i + S::width <= count; i += S::width) {
+				Float px = S::load(x + i);
+				Float py = S::load(y + i);
+				Float pz = S::load(z + i);
+
+				S::store(outX + i, S::madd(m20, pz, S::madd(m10, py, S::madd(m00, px, m30))));
+				S::store(outY + i, S::madd(m21, pz, S::madd(m11, py, S::madd(m01, px, m31))));
+				S::store(outZ + i, S::madd(m22, pz, S::madd(m12, py, S::madd(m02, px, m32))));
+			}
+
+			for (; i < count; ++i) {
+				float px = x[i], py = y[i], pz = z[i];
+				outX[i] = matrix.m00 * px + matrix.m10 * py + matrix.m20 * pz + matrix.m30;
+				outY[i] = matrix.m01 * px + matrix.m11 * py + matrix.m21 * pz + matrix.m31;
+				outZ[i] = matrix.m02 * px + matrix.m12 * py + matrix.m22 * pz + matrix.m32;
+			}
+		}
+
+		void multiplyBatchScalar(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				MatrixKernels::multiplyScalar(left, right[i], out[i]);
+		}
+
+		void multiplyBatchSSE2(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				MatrixKernels::multiply(left, right[i], out[i]);
+		}
+
+		//two columns per register, left columns are broadcast into both halves (Mat4f is only 16 byte aligned so unaligned loads)
+		void multiplyBatchAVX2(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count) {
+			const __m256 l0 = _mm256_broadcast_ps((const __m128*)&left.m00);
+			const __m256 l1 = _mm256_broadcast_ps((const __m128*)&left.m10);
+			const __m256 l2 = _mm256_broadcast_ps((const __m128*)&left.m20);
+			const __m256 l3 = _mm256_broadcast_ps((const __m128*)&left.m30);
+
+			for (size_t i = 0; i < count; ++i) {
+				__m256 r01 = _mm256_loadu_ps(&right[i].m00);
+				__m256 r23 = _mm256_loadu_ps(&right[i].m20);
+
+				__m256 o01 = _mm256_mul_ps(l0, _mm256_permute_ps(r01, 0x00));
+				o01 = _mm256_fmadd_ps(l1, _mm256_permute_ps(r01, 0x55), o01);
+				o01 = _mm256_fmadd_ps(l2, _mm256_permute_ps(r01, 0xAA), o01);
+				o01 = _mm256_fmadd_ps(l3, _mm256_permute_ps(r01, 0xFF), o01);
+
+				__m256 o23 = _mm256_mul_ps(l0, _mm256_permute_ps(r23, 0x00));
+				o23 = _mm256_fmadd_ps(l1, _mm256_permute_ps(r23, 0x55), o23);
+				o23 = _mm256_fmadd_ps(l2, _mm256_permute_ps(r23, 0xAA), o23);
+				o23 = _mm256_fmadd_ps(l3, _mm256_permute_ps(r23, 0xFF), o23);
+
+				_mm256_storeu_ps(&out[i].m00, o01);
+				_mm256_storeu_ps(&out[i].m20, o23);
+			}
+		}
+
+		//whole matrix in one register
+		void multiplyBatchAVX512(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count) {
+			const __m512 l0 = _mm512_broadcast_f32x4(_mm_load_ps(&left.m00));
+			const __m512 l1 = _mm512_broadcast_f32x4(_mm_load_ps(&left.m10));
+			const __m512 l2 = _mm512_broadcast_f32x4(_mm_load_ps(&left.m20));
+			const __m512 l3 = _mm512_broadcast_f32x4(_mm_load_ps(&left.m30));
+
+			for (size_t i = 0; i < count; ++i) {
+				__m512 r = _mm512_loadu_ps(&right[i].m00);
+
+				__m512 o = _mm512_mul_ps(l0, _mm512_permute_ps(r, 0x00));
+				o = _mm512_fmadd_ps(l1, _mm512_permute_ps(r, 0x55), o);
+				o = _mm512_fmadd_ps(l2, _mm512_permute_ps(r, 0xAA), o);
+				o = _mm512_fmadd_ps(l3, _mm512_permute_ps(r, 0xFF), o);
+
+				_mm512_storeu_ps(&out[i].m00, o);
+			}
+		}
+
+		void transformPointsScalar(const Mat4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, const size_t& count) {
+			for (size_t i = 0; i < count; ++i) {
+				Vec3f point = MatrixKernels::transformPointScalar(matrix, Vec3f(x[i], y[i], z[i]));
+				outX[i] = point.x;
+				outY[i] = point.y;
+				outZ[i] = point.z;
+			}
+		}
+
+		void createTransformationMatricesScalar(const TransformArrays& transforms, Mat4f* out, const size_t& count) {
+			for (size_t i = 0; i < count; ++i)
+				createTransformationMatrixFast(transforms, i, out[i]);
+		}
+
+		void createMVPMatricesScalar(const Mat4f& projectionView, const TransformArrays& transforms, Mat4f* models, Mat4f* mvps, const size_t& count) {
+			for (size_t i = 0; i < count; ++i) {
+				Mat4f model;
+				createTransformationMatrixFast(transforms, i, model);
+
+				if (models)
+					models[i] = model;
+
+				MatrixKernels::multiplyScalar(projectionView, model, mvps[i]);
+			}
+		}
+
+		//2x2 matrix helpers for the block inverse, a 2x2 matrix is stored as (m00, m01, m10, m11)
+		inline __m128 mat2Multiply(const __m128& a, const __m128& b) {
+			return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+
+		//adjugate(a) * b
+		inline __m128 mat2AdjugateMultiply(const __m128& a, const __m128& b) {
+			return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+
+		//a * adjugate(b)
+		inline __m128 mat2MultiplyAdjugate(const __m128& a, const __m128& b) {
+			return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+
+	}
+
+	int MatrixKernels::instructionSet = HFR_SIMD_SSE2;
+
+	void (*MatrixKernels::multiplyBatchKernel)(const Mat4f&, const Mat4f*, Mat4f*, const size_t&) = multiplyBatchSSE2;
+	void (*MatrixKernels::transformPointsKernel)(const Mat4f&, const float*, const float*, const float*, float*, float*, float*, const size_t&) = transformPointsSimd<SSE2>;
+	void (*MatrixKernels::createTransformationMatricesKernel)(const TransformArrays&, Mat4f*, const size_t&) = createTransformationMatricesSimd<SSE2>;
+	void (*MatrixKernels::createMVPMatricesKernel)(const Mat4f&, const TransformArrays&, Mat4f*, Mat4f*, const size_t&) = createMVPMatricesSimd<SSE2>;
+
+	void MatrixKernels::init() {
+		setInstructionSet(detectInstructionSet());
+		Debug::systemLog("Matrix kernels are using: {}", getInstructionSetName(instructionSet));
+	}
+
+	int MatrixKernels::detectInstructionSet() {
+		int info[4];
+		int out = HFR_SIMD_SSE2;
+
+		__cpuid(info, 0);
+		int highestLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		bool fma = (info[2] & (1 << 12)) != 0;
+
+		//the os has to save the bigger registers too, otherwise we can't use them even if the cpu has them
+		if (osxsave && avx && highestLeaf >= 7) {
+			unsigned long long xcr0 = _xgetbv(0);
+
+			__cpuidex(info, 7, 0);
+			bool avx2 = (info[1] & (1 << 5)) != 0;
+			bool avx512 = (info[1] & (1 << 16)) != 0;
+
+			if (avx2 && fma && (xcr0 & 0x6) == 0x6) {
+				out = HFR_SIMD_AVX2;
+
+				if (avx512 && (xcr0 & 0xE6) == 0xE6)
+					out = HFR_SIMD_AVX512;
+			}
+		}
+
+		return out;
+	}
+
+	void MatrixKernels::setInstructionSet(const int& set) {
+		instructionSet = min(set, detectInstructionSet());
+
+		switch (instructionSet) {
+		case HFR_SIMD_SCALAR:
+			multiplyBatchKernel = multiplyBatchScalar;
+			transformPointsKernel = transformPointsScalar;
+			createTransformationMatricesKernel = createTransformationMatricesScalar;
+			createMVPMatricesKernel = createMVPMatricesScalar;
+			break;
+		case HFR_SIMD_AVX2:
+			multiplyBatchKernel = multiplyBatchAVX2;
+			transformPointsKernel = transformPointsSimd<AVX2>;
+			createTransformationMatricesKernel = createTransformationMatricesSimd<AVX2>;
+			createMVPMatricesKernel = createMVPMatricesSimd<AVX2>;
+			break;
+		case HFR_SIMD_AVX512:
+			multiplyBatchKernel = multiplyBatchAVX512;
+			transformPointsKernel = transformPointsSimd<AVX512>;
+			createTransformationMatricesKernel = createTransformationMatricesSimd<AVX512>;
+			createMVPMatricesKernel = createMVPMatricesSimd<AVX512>;
+			break;
+		default:
+			instructionSet = HFR_SIMD_SSE2;
+			multiplyBatchKernel = multiplyBatchSSE2;
+			transformPointsKernel = transformPointsSimd<SSE2>;
+			createTransformationMatricesKernel = createTransformationMatricesSimd<SSE2>;
+			createMVPMatricesKernel = createMVPMatricesSimd<SSE2>;
+			break;
+		}
+	}
+
+	int MatrixKernels::getInstructionSet() {
+		return instructionSet;
+	}
+
+	std::string MatrixKernels::getInstructionSetName(const int& set) {
+		switch (set) {
+		case HFR_SIMD_SCALAR: return "Scalar";
+		case HFR_SIMD_SSE2: return "SSE2";
+		case HFR_SIMD_AVX2: return "AVX2";
+		case HFR_SIMD_AVX512: return "AVX-512";
+		default: return "Unknown";
+		}
+	}
+
+	void MatrixKernels::multiply(const Mat4f& left, const Mat4f& right, Mat4f& out) {
+		const __m128 l0 = _mm_load_ps(&left.m00);
+		const __m128 l1 = _mm_load_ps(&left.m10);
+		const __m128 l2 = _mm_load_ps(&left.m20);
+		const __m128 l3 = _mm_load_ps(&left.m30);
+
+		//load everything first so out can be left or right
+		__m128 r[4] = { _mm_load_ps(&right.m00), _mm_load_ps(&right.m10), _mm_load_ps(&right.m20), _mm_load_ps(&right.m30) };
+		float* o = &out.m00;
+
+		for (int j = 0; j < 4; ++j) {
+			__m128 column = _mm_mul_ps(l0, _mm_shuffle_ps(r[j], r[j], _MM_SHUFFLE(0, 0, 0, 0)));
+			column = _mm_add_ps(column, _mm_mul_ps(l1, _mm_shuffle_ps(r[j], r[j], _MM_SHUFFLE(1, 1, 1, 1))));
+			column = _mm_add_ps(column, _mm_mul_ps(l2, _mm_shuffle_ps(r[j], r[j], _MM_SHUFFLE(2, 2, 2, 2))));
+			column = _mm_add_ps(column, _mm_mul_ps(l3, _mm_shuffle_ps(r[j], r[j], _MM_SHUFFLE(3, 3, 3, 3))));
+			r[j] = column;
+		}
+
+		_mm_store_ps(o, r[0]);
+		_mm_store_ps(o + 4, r[1]);
+		_mm_store_ps(o + 8, r[2]);
+		_mm_store_ps(o + 12, r[3]);
+	}
+
+	void MatrixKernels::transpose(const Mat4f& in, Mat4f& out) {
+		__m128 c0 = _mm_load_ps(&in.m00);
+		__m128 c1 = _mm_load_ps(&in.m10);
+		__m128 c2 = _mm_load_ps(&in.m20);
+		__m128 c3 = _mm_load_ps(&in.m30);
+
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		_mm_store_ps(&out.m00, c0);
+		_mm_store_ps(&out.m10, c1);
+		_mm_store_ps(&out.m20, c2);
+		_mm_store_ps(&out.m30, c3);
+	}
+
+	//block matrix inverse using 2x2 sub matrices, works the same for rows or columns because inverse(transpose(m)) = transpose(inverse(m))
+	bool MatrixKernels::inverse(const Mat4f& in, Mat4f& out) {
+		const __m128 c0 = _mm_load_ps(&in.m00);
+		const __m128 c1 = _mm_load_ps(&in.m10);
+		const __m128 c2 = _mm_load_ps(&in.m20);
+		const __m128 c3 = _mm_load_ps(&in.m30);
+
+		//sub matrices
+		__m128 a = _mm_movelh_ps(c0, c1);
+		__m128 b = _mm_movehl_ps(c1, c0);
+		__m128 c = _mm_movelh_ps(c2, c3);
+		__m128 d = _mm_movehl_ps(c3, c2);
+
+		//determinants of the sub matrices as (|a|, |b|, |c|, |d|)
+		__m128 subDeterminants = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+		__m128 determinantA = _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 determinantB = _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 determinantC = _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 determinantD = _mm_shuffle_ps(subDeterminants, subDeterminants, _MM_SHUFFLE(3, 3, 3, 3));
+
+		__m128 dc = mat2AdjugateMultiply(d, c);
+		__m128 ab = mat2AdjugateMultiply(a, b);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), mat2Multiply(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), mat2Multiply(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), mat2MultiplyAdjugate(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), mat2MultiplyAdjugate(a, dc));
+
+		//|m| = |a| * |d| + |b| * |c| - trace(ab * dc)
+		__m128 determinant = _mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC));
+
+		__m128 trace = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+		trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+		determinant = _mm_sub_ps(determinant, trace);
+
+		if (_mm_cvtss_f32(determinant) == 0.0f)
+			return false;
+
+		__m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+		x = _mm_mul_ps(x, inverseDeterminant);
+		y = _mm_mul_ps(y, inverseDeterminant);
+		z = _mm_mul_ps(z, inverseDeterminant);
+		w = _mm_mul_ps(w, inverseDeterminant);
+
+		//adjugate shuffle and store shuffle in one go
+		_mm_store_ps(&out.m00, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_store_ps(&out.m10, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_store_ps(&out.m20, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_store_ps(&out.m30, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+		return true;
+	}
+
+	Vec4f MatrixKernels::transform(const Mat4f& matrix, const Vec4f& vector) {
+		__m128 out = _mm_mul_ps(_mm_load_ps(&matrix.m00), _mm_set1_ps(vector.x));
+		out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&matrix.m10), _mm_set1_ps(vector.y)));
+		out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&matrix.m20), _mm_set1_ps(vector.z)));
+		out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&matrix.m30), _mm_set1_ps(vector.w)));
+
+		alignas(16) float result[4];
+		_mm_store_ps(result, out);
+
+		return Vec4f(result[0], result[1], result[2], result[3]);
+	}
+
+	//treats the point as w = 1, doesn't do the perspective divide
+	Vec3f MatrixKernels::transformPoint(const Mat4f& matrix, const Vec3f& point) {
+		__m128 out = _mm_mul_ps(_mm_load_ps(&matrix.m00), _mm_set1_ps(point.x));
+		out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&matrix.m10), _mm_set1_ps(point.y)));
+		out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&matrix.m20), _mm_set1_ps(point.z)));
+		out = _mm_add_ps(out, _mm_load_ps(&matrix.m30));
+
+		alignas(16) float result[4];
+		_mm_store_ps(result, out);
+
+		return Vec3f(result[0], result[1], result[2]);
+	}
+
+	void MatrixKernels::multiply(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count) {
+		multiplyBatchKernel(left, right, out, count);
+	}
+
+	void MatrixKernels::transformPoints(const Mat4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, const size_t& count) {
+		transformPointsKernel(matrix, x, y, z, outX, outY, outZ, count);
+	}
+
+	void MatrixKernels::createTransformationMatrices(const TransformArrays& transforms, Mat4f* out, const size_t& count) {
+		createTransformationMatricesKernel(transforms, out, count);
+	}
+
+	void MatrixKernels::createMVPMatrices(const Mat4f& projectionView, const TransformArrays& transforms, Mat4f* models, Mat4f* mvps, const size_t& count) {
+		createMVPMatricesKernel(projectionView, transforms, models, mvps, count);
+	}
+
+	void MatrixKernels::multiplyScalar(const Mat4f& left, const Mat4f& right, Mat4f& out) {
+		const float* l = &left.m00;
+		const float* r = &right.m00;
+		float result[16];
+
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				result[column * 4 + row] = l[row] * r[column * 4] + l[4 + row] * r[column * 4 + 1] + l[8 + row] * r[column * 4 + 2] + l[12 + row] * r[column * 4 + 3];
+			}
+		}
+
+		std::memcpy(&out.m00, result, sizeof(result));
+	}
+
+	void MatrixKernels::transposeScalar(const Mat4f& in, Mat4f& out) {
+		const float* m = &in.m00;
+		float result[16];
+
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				result[row * 4 + column] = m[column * 4 + row];
+			}
+		}
+
+		std::memcpy(&out.m00, result, sizeof(result));
+	}
+
+	//plain cofactor expansion
+	bool MatrixKernels::inverseScalar(const Mat4f& in, Mat4f& out) {
+		const float* m = &in.m00;
+		float inv[16];
+
+		inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+		inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+		inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+		inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+		inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+		inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+		inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+		inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+		inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+		inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+		inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+		inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+		inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+		inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+		inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+		inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+		float determinant = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+		if (determinant == 0.0f)
+			return false;
+
+		determinant = 1.0f / determinant;
+
+		float* o = &out.m00;
+		for (int i = 0; i < 16; ++i)
+			o[i] = inv[i] * determinant;
+
+		return true;
+	}
+
+	Vec3f MatrixKernels::transformPointScalar(const Mat4f& matrix, const Vec3f& point) {
+		return Vec3f(matrix.m00 * point.x + matrix.m10 * point.y + matrix.m20 * point.z + matrix.m30,
+			matrix.m01 * point.x + matrix.m11 * point.y + matrix.m21 * point.z + matrix.m31,
+			matrix.m02 * point.x + matrix.m12 * point.y + matrix.m22 * point.z + matrix.m32);
+	}
+
+	//the old translate, rotate, rotate, rotate, scale chain
+	void MatrixKernels::createTransformationMatrixScalar(const TransformArrays& t, const size_t& i, Mat4f& out) {
+		out.setIdentity();
+		out.translate(Vec3f(t.positionX[i], t.positionY[i], t.positionZ[i]));
+		out.rotate((float)HMath::toRadians(t.rotationX[i]), Vec3f(1, 0, 0));
+		out.rotate((float)HMath::toRadians(t.rotationY[i]), Vec3f(0, 1, 0));
+		out.rotate((float)HMath::toRadians(t.rotationZ[i]), Vec3f(0, 0, 1));
+		out.scale(Vec3f(t.scaleX[i], t.scaleY[i], t.scaleZ[i]));
+	}
+
+}
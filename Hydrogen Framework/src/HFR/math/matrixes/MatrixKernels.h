@@ -0,0 +1,73 @@
+#ifndef HFR_MATRIX_KERNELS_HEADER_INCLUDE
+#define HFR_MATRIX_KERNELS_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	struct Mat4f;
+	struct Vec3f;
+	struct Vec4f;
+
+	//structure of arrays input for the batch kernels, every pointer needs count floats (rotation is in degrees like Transform)
+	struct DLL_API TransformArrays {
+		const float* positionX = nullptr;
+		const float* positionY = nullptr;
+		const float* positionZ = nullptr;
+
+		const float* rotationX = nullptr;
+		const float* rotationY = nullptr;
+		const float* rotationZ = nullptr;
+
+		const float* scaleX = nullptr;
+		const float* scaleY = nullptr;
+		const float* scaleZ = nullptr;
+	};
+
+	class DLL_API MatrixKernels {
+	private:
+		static int instructionSet;
+
+		//the batch kernels get swapped out depending on what the cpu supports
+		static void (*multiplyBatchKernel)(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count);
+		static void (*transformPointsKernel)(const Mat4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, const size_t& count);
+		static void (*createTransformationMatricesKernel)(const TransformArrays& transforms, Mat4f* out, const size_t& count);
+		static void (*createMVPMatricesKernel)(const Mat4f& projectionView, const TransformArrays& transforms, Mat4f* models, Mat4f* mvps, const size_t& count);
+
+	public:
+		//picks the best instruction set the cpu supports (HFR_SIMD_SSE2, HFR_SIMD_AVX2 or HFR_SIMD_AVX512)
+		static void init();
+		static int detectInstructionSet();
+
+		//forces an instruction set, it gets clamped to what the cpu actually supports
+		static void setInstructionSet(const int& set);
+		static int getInstructionSet();
+		static std::string getInstructionSetName(const int& set);
+
+		//single matrix operations (sse2, every x64 cpu has it)
+		static void multiply(const Mat4f& left, const Mat4f& right, Mat4f& out);
+		static void transpose(const Mat4f& in, Mat4f& out);
+		//returns false and leaves out alone if the matrix can't be inverted
+		static bool inverse(const Mat4f& in, Mat4f& out);
+		static Vec4f transform(const Mat4f& matrix, const Vec4f& vector);
+		static Vec3f transformPoint(const Mat4f& matrix, const Vec3f& point);
+
+		//batch operations (dispatched to the current instruction set)
+		static void multiply(const Mat4f& left, const Mat4f* right, Mat4f* out, const size_t& count);
+		static void transformPoints(const Mat4f& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, const size_t& count);
+		//same layout as Mat4f::createTransformationMatrix (translation * rotationX * rotationY * rotationZ * scale)
+		static void createTransformationMatrices(const TransformArrays& transforms, Mat4f* out, const size_t& count);
+		//models can be nullptr if you only want the mvp matrices
+		static void createMVPMatrices(const Mat4f& projectionView, const TransformArrays& transforms, Mat4f* models, Mat4f* mvps, const size_t& count);
+
+		//scalar reference versions, these are what the simd versions get checked against
+		static void multiplyScalar(const Mat4f& left, const Mat4f& right, Mat4f& out);
+		static void transposeScalar(const Mat4f& in, Mat4f& out);
+		static bool inverseScalar(const Mat4f& in, Mat4f& out);
+		static Vec3f transformPointScalar(const Mat4f& matrix, const Vec3f& point);
+		static void createTransformationMatrixScalar(const TransformArrays& transforms, const size_t& index, Mat4f& out);
+	};
+
+}
+
+#endif
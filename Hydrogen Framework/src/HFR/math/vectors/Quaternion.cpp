@@ -0,0 +1,110 @@
+#include "hfpch.h"
+
+namespace HFR {
+
+	void Quaternion::normalize() {
+		float len = length();
+
+		if (len == 0) {
+			x = 0;
+			y = 0;
+			z = 0;
+			w = 1;
+			return;
+		}
+
+		float ilen = 1.0f / len;
+		x *= ilen;
+		y *= ilen;
+		z *= ilen;
+		w *= ilen;
+	}
+
+	float Quaternion::length() const {
+		return std::sqrt(x * x + y * y + z * z + w * w);
+	}
+
+	Quaternion Quaternion::conjugate() const {
+		return Quaternion(-x, -y, -z, w);
+	}
+
+	Vec3f Quaternion::rotate(const Vec3f& vector) const {
+		//v + 2w(q x v) + 2(q x (q x v))
+		float tx = 2 * (y * vector.z - z * vector.y);
+		float ty = 2 * (z * vector.x - x * vector.z);
+		float tz = 2 * (x * vector.y - y * vector.x);
+
+		return Vec3f(vector.x + w * tx + (y * tz - z * ty),
+			vector.y + w * ty + (z * tx - x * tz),
+			vector.z + w * tz + (x * ty - y * tx));
+	}
+
+	void Quaternion::toRotationMatrix(Mat4f& matrix) const {
+		float xx = x * x, yy = y * y, zz = z * z;
+		float xy = x * y, xz = x * z, yz = y * z;
+		float wx = w * x, wy = w * y, wz = w * z;
+
+		matrix.m00 = 1 - 2 * (yy + zz);
+		matrix.m01 = 2 * (xy + wz);
+		matrix.m02 = 2 * (xz - wy);
+		matrix.m10 = 2 * (xy - wz);
+		matrix.m11 = 1 - 2 * (xx + zz);
+		matrix.m12 = 2 * (yz + wx);
+		matrix.m20 = 2 * (xz + wy);
+		matrix.m21 = 2 * (yz - wx);
+		matrix.m22 = 1 - 2 * (xx + yy);
+	}
+
+	Quaternion Quaternion::fromEuler(const Vec3f& rotation) {
+		return fromAxisAngle(rotation.x, Vec3f(1, 0, 0)) * fromAxisAngle(rotation.y, Vec3f(0, 1, 0)) * fromAxisAngle(rotation.z, Vec3f(0, 0, 1));
+	}
+
+	Quaternion Quaternion::fromAxisAngle(const float& angle, const Vec3f& axis) {
+		float halfAngle = (float)HMath::toRadians(angle) * 0.5f;
+		float s = (float)sin(halfAngle);
+
+		return Quaternion(axis.x * s, axis.y * s, axis.z * s, (float)cos(halfAngle));
+	}
+
+	float Quaternion::dot(const Quaternion& left, const Quaternion& right) {
+		return left.x * right.x + left.y * right.y + left.z * right.z + left.w * right.w;
+	}
+
+	Quaternion Quaternion::slerp(const Quaternion& from, const Quaternion& to, const float& percentage) {
+		Quaternion end = to;
+		float cosTheta = dot(from, to);
+
+		if (cosTheta < 0) {
+			end = Quaternion(-to.x, -to.y, -to.z, -to.w);
+			cosTheta = -cosTheta;
+		}
+
+		float a = 1 - percentage;
+		float b = percentage;
+
+		//if they're really close together just lerp (also avoids dividing by ~0)
+		if (cosTheta < 0.9995f) {
+			float theta = (float)acos(cosTheta);
+			float isinTheta = 1.0f / (float)sin(theta);
+			a = (float)sin(a * theta) * isinTheta;
+			b = (float)sin(b * theta) * isinTheta;
+		}
+
+		Quaternion out = Quaternion(from.x * a + end.x * b, from.y * a + end.y * b, from.z * a + end.z * b, from.w * a + end.w * b);
+		out.normalize();
+		return out;
+	}
+
+	Quaternion Quaternion::operator*(const Quaternion& other) const {
+		return Quaternion(w * other.x + x * other.w + y * other.z - z * other.y,
+			w * other.y - x * other.z + y * other.w + z * other.x,
+			w * other.z + x * other.y - y * other.x + z * other.w,
+			w * other.w - x * other.x - y * other.y - z * other.z);
+	}
+
+	Quaternion Quaternion::operator*=(const Quaternion& other) {
+		*this = *this * other;
+		return *this;
+	}
+
+}
@@ -0,0 +1,48 @@
+#ifndef HFR_QUATERNION_HEADER_INCLUDE
+#define HFR_QUATERNION_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VEC3
+
+namespace HFR {
+
+	struct Mat4f;
+
+	//unit quaternion for rotations, angles going in are in degrees like the rest of the engine
+	struct DLL_API Quaternion {
+		float x, y, z, w;
+
+		Quaternion() : x(0), y(0), z(0), w(1) {}
+
+		Quaternion(const float& _x, const float& _y, const float& _z, const float& _w) : x(_x), y(_y), z(_z), w(_w) {}
+
+		void normalize();
+
+		float length() const;
+
+		Quaternion conjugate() const;
+
+		//rotates a vector by this quaternion
+		Vec3f rotate(const Vec3f& vector) const;
+
+		//only the rotation part of the matrix gets written (m00 to m22)
+		void toRotationMatrix(Mat4f& matrix) const;
+
+		//same order as Mat4f::createTransformationMatrix (x, then y, then z)
+		static Quaternion fromEuler(const Vec3f& rotation);
+
+		static Quaternion fromAxisAngle(const float& angle, const Vec3f& axis);
+
+		static float dot(const Quaternion& left, const Quaternion& right);
+
+		//takes the short way around
+		static Quaternion slerp(const Quaternion& from, const Quaternion& to, const float& percentage);
+
+		Quaternion operator*(const Quaternion& other) const;
+
+		Quaternion operator*=(const Quaternion& other);
+
+	};
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "hfpch.h"
+
+namespace HFR {
+
+	void Transform::setPosition(const Vec3f& _position) {
+		position = _position;
+		dirty = true;
+	}
+
+	void Transform::setRotation(const Vec3f& _rotation) {
+		rotation = _rotation;
+		HMath::keepRotationInTermsOf360(rotation);
+
+		//keep the quaternion in sync so switching modes doesn't snap
+		orientation = Quaternion::fromEuler(rotation);
+		dirty = true;
+	}
+
+	void Transform::setScale(const Vec3f& _scale) {
+		scale = _scale;
+		dirty = true;
+	}
+
+	void Transform::setOrientation(const Quaternion& _orientation) {
+		orientation = _orientation;
+		orientation.normalize();
+		useQuaternion = true;
+		dirty = true;
+	}
+
+	void Transform::rotate(const Quaternion& amount) {
+		if (!useQuaternion)
+			orientation = Quaternion::fromEuler(rotation);
+
+		orientation = amount * orientation;
+		orientation.normalize();
+		useQuaternion = true;
+		dirty = true;
+	}
+
+	void Transform::markDirty() {
+		dirty = true;
+	}
+
+	Mat4f Transform::createLocalMatrix() const {
+		if (useQuaternion)
+			return Mat4f::createTransformationMatrix(position, orientation, scale);
+
+		return Mat4f::createTransformationMatrix(position, rotation, scale);
+	}
+
+	Transform Transform::interpolate(const Transform& previous, const Transform& current, const float& alpha) {
+		Transform out = current;
+
+		Vec3f position = previous.position;
+		Vec3f scale = previous.scale;
+
+		out.position = position + (Vec3f(current.position) - position) * alpha;
+		out.scale = scale + (Vec3f(current.scale) - scale) * alpha;
+
+		if (previous.useQuaternion || current.useQuaternion) {
+			const Quaternion from = previous.useQuaternion ? previous.orientation : Quaternion::fromEuler(previous.rotation);
+			const Quaternion to = current.useQuaternion ? current.orientation : Quaternion::fromEuler(current.rotation);
+
+			out.orientation = Quaternion::slerp(from, to, alpha);
+			out.useQuaternion = true;
+		}
+		else {
+			out.rotation.x = HMath::lerp(previous.rotation.x, current.rotation.x, alpha);
+			out.rotation.y = HMath::lerp(previous.rotation.y, current.rotation.y, alpha);
+			out.rotation.z = HMath::lerp(previous.rotation.z, current.rotation.z, alpha);
+		}
+
+		out.dirty = true;
+		return out;
+	}
+
+}
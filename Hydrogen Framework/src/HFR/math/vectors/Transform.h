@@ -1,4 +1,3 @@
-
 #ifndef HFR_TRANSFORM_HEADER_INCLUDE
 #define HFR_TRANSFORM_HEADER_INCLUDE
 
@@ -6,16 +5,53 @@
 #include HFR_ECS
 #include HFR_VEC2
 #include HFR_VEC3
+#include HFR_MAT4
+#include HFR_QUATERNION
 
 namespace HFR {
 
 	struct DLL_API Transform {
 		Vec3f position, rotation, scale;
 
+		//used instead of rotation (euler degrees) when useQuaternion is true
+		Quaternion orientation;
+		bool useQuaternion = false;
+
+		//cached matrixes, TransformSystem rebuilds them when dirty (if you change position, rotation or scale directly call markDirty)
+		Mat4f localMatrix;
+		Mat4f worldMatrix;
+		bool dirty = true;
+
+		//drawn in between the last two fixed steps instead of where the last one left it, for things that only move in fixedUpdate
+		//(moving it in update as well makes it lag and stutter)
+		bool interpolated = false;
+		//worldMatrix when the last fixed step started, Scene::fixedUpdate keeps it, set hasPreviousStep to false after teleporting it
+		//so it doesn't get drawn sliding across
+		Mat4f previousWorldMatrix;
+		bool hasPreviousStep = false;
+
 		Transform() : position(Vec3f()), rotation(Vec3f()), scale(Vec3f(1)) {}
 
 		Transform(const Vec3f& _position, const Vec3f& _rotation, const Vec3f& _scale) : position(_position), rotation(_rotation), scale(_scale) {}
 
+		Transform(const Vec3f& _position, const Quaternion& _orientation, const Vec3f& _scale) : position(_position), rotation(Vec3f()), scale(_scale), orientation(_orientation), useQuaternion(true) {}
+
+		void setPosition(const Vec3f& position);
+		void setRotation(const Vec3f& rotation);
+		void setScale(const Vec3f& scale);
+		void setOrientation(const Quaternion& orientation);
+
+		//rotates on top of the current orientation (switches to quaternion mode)
+		void rotate(const Quaternion& amount);
+
+		void markDirty();
+
+		//builds the matrix from position, rotation / orientation and scale without touching the cache
+		Mat4f createLocalMatrix() const;
+
+		//in between two fixed steps, alpha is Time::getInterpolationAlpha() (euler rotations get lerped per axis, so keep the steps small)
+		static Transform interpolate(const Transform& previous, const Transform& current, const float& alpha);
+
 	};
 
 	struct DLL_API Transform2D {
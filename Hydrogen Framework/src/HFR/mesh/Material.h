@@ -4,7 +4,7 @@
 
 #include HFR_API
 #include HFR_VEC3
-#include HFR_TEXTURE
+#include HFR_ASSET_HANDLE
 
 namespace HFR {
 
@@ -15,57 +15,46 @@ namespace HFR {
 
 		//float dissolve;
 
-		Texture diffuseMap;
+		TextureHandle diffuseMap;
 		Vec3f diffuseColor;
 
-		Texture ambientMap;
+		TextureHandle ambientMap;
 		Vec3f ambientColor;
 
-		Texture specularMap;
+		TextureHandle specularMap;
 		Vec3f specularColor;
 		float specularExponent;
 
-		Texture emissionMap;
+		TextureHandle emissionMap;
 		Vec3f emissionColor;
 
 		Material() {
-			diffuseMap = Texture();
 			diffuseColor = Vec3f(0.8f);
 
-			ambientMap = Texture();
 			ambientColor = Vec3f(0.8f);
 
-			specularMap = Texture();
 			specularColor = Vec3f(0.5f);
 			specularExponent = 32;
 
-			emissionMap = Texture();
 			emissionColor = Vec3f(0);
 		}
 
-		~Material() {
-
-		}
-
+		//the maps are shared through the TextureCache and get uploaded by the AssetLoader, nothing to do here anymore
 		void create() {
-			diffuseMap.textureUnit = 0;
-			ambientMap.textureUnit = 1;
-			specularMap.textureUnit = 2;
-			emissionMap.textureUnit = 3;
-
-			if (diffuseMap.image.hasData())
-				diffuseMap.create();
-
-			if (ambientMap.image.hasData())
-				ambientMap.create();
+			created = true;
+		}
 
-			if (specularMap.image.hasData())
-				specularMap.create();
+		//the same maps, colors and name, comparing doesn't touch the handles reference counts like a copy does
+		bool operator==(const Material& other) const {
+			const auto same = [](const Vec3f& a, const Vec3f& b) { return a.x == b.x && a.y == b.y && a.z == b.z; };
 
-			if (emissionMap.image.hasData())
-				emissionMap.create();
+			return diffuseMap == other.diffuseMap && ambientMap == other.ambientMap && specularMap == other.specularMap && emissionMap == other.emissionMap &&
+				same(diffuseColor, other.diffuseColor) && same(ambientColor, other.ambientColor) && same(specularColor, other.specularColor) &&
+				same(emissionColor, other.emissionColor) && specularExponent == other.specularExponent && created == other.created && name == other.name;
+		}
 
-			created = true;
+		bool operator!=(const Material& other) const {
+			return !(*this == other);
 		}
 
 		//shader NEEDS to be BINDED before calling this
@@ -7,18 +7,89 @@ namespace HFR {
 		IBO = 0;
 	}
 
-	Mesh::Mesh(const std::vector<float>& _vertices, const std::vector<unsigned int>& _indices, const std::vector<float>& _normals, const std::vector<float>& _texturecoords) {
-		vertices = _vertices;
-		texturecoords = _texturecoords;
-		indices = _indices;
-		normals = _normals;
+	Mesh::Mesh(std::vector<float> _vertices, std::vector<unsigned int> _indices, std::vector<float> _normals, std::vector<float> _texturecoords) {
+		vertices = std::move(_vertices);
+		texturecoords = std::move(_texturecoords);
+		indices = std::move(_indices);
+		normals = std::move(_normals);
 
 		VAO = 0;
 		IBO = 0;
 	}
 
+	Mesh::Mesh(const Mesh& mesh) : Mesh(mesh.clone()) {}
+
+	Mesh& Mesh::operator=(const Mesh& mesh) {
+		//the implicit copy shared the vao, so both copies deleted it
+		if (this != &mesh)
+			*this = mesh.clone();
+
+		return *this;
+	}
+
+	Mesh::Mesh(Mesh&& mesh) noexcept {
+		material = std::move(mesh.material);
+		vertices = std::move(mesh.vertices);
+		texturecoords = std::move(mesh.texturecoords);
+		normals = std::move(mesh.normals);
+		indices = std::move(mesh.indices);
+
+		VAO = mesh.VAO;
+		IBO = mesh.IBO;
+		isUsingIndices = mesh.isUsingIndices;
+		created = mesh.created;
+		type = mesh.type;
+		useLighting = mesh.useLighting;
+		radius = mesh.radius;
+
+		mesh.VAO = 0;
+		mesh.IBO = 0;
+		mesh.created = false;
+	}
+
+	Mesh& Mesh::operator=(Mesh&& mesh) noexcept {
+		if (this != &mesh) {
+			if (VAO != 0)
+				RenderPipeline::deleteVertexArray(VAO);
+
+			material = std::move(mesh.material);
+			vertices = std::move(mesh.vertices);
+			texturecoords = std::move(mesh.texturecoords);
+			normals = std::move(mesh.normals);
+			indices = std::move(mesh.indices);
+
+			VAO = mesh.VAO;
+			IBO = mesh.IBO;
+			isUsingIndices = mesh.isUsingIndices;
+			created = mesh.created;
+			type = mesh.type;
+			useLighting = mesh.useLighting;
+			radius = mesh.radius;
+
+			mesh.VAO = 0;
+			mesh.IBO = 0;
+			mesh.created = false;
+		}
+
+		return *this;
+	}
+
 	Mesh::~Mesh() {
-		glDeleteVertexArrays(1, &VAO);
+		//meshes that never got created can die on the loader threads, which have no gl context, created ones can die on the simulation thread
+		if (VAO != 0)
+			RenderPipeline::deleteVertexArray(VAO);
+	}
+
+	Mesh Mesh::clone() const {
+		Mesh out(vertices, indices, normals, texturecoords);
+
+		out.material = material;
+		out.material.created = false;
+		out.isUsingIndices = isUsingIndices;
+		out.type = type;
+		out.useLighting = useLighting;
+
+		return out;
 	}
 
 	void Mesh::create() {
@@ -45,6 +116,19 @@ namespace HFR {
 		if (!indices.empty())
 			Util::pushDataToIBO(indices, IBO);
 
+		radius = 0;
+
+		for (size_t i = 0; i + type <= vertices.size(); i += type) {
+			float squared = 0;
+
+			for (int j = 0; j < type; ++j)
+				squared += vertices[i + j] * vertices[i + j];
+
+			radius = max(radius, squared);
+		}
+
+		radius = sqrtf(radius);
+
 		material.create();
 		created = true;
 	}
@@ -25,12 +25,26 @@ namespace HFR {
 
 		bool useLighting = true;
 
+		//distance from the origin to the farthest vertex, set by create (texture streaming uses it to guess how big the mesh is on screen)
+		float radius = 0;
+
 		Mesh();
 
-		Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, const std::vector<float>& normals, const std::vector<float>& texturecoords);
+		//pass the vectors in with std::move to hand them over without a copy
+		Mesh(std::vector<float> vertices, std::vector<unsigned int> indices, std::vector<float> normals, std::vector<float> texturecoords);
+
+		//copies keep the vertex data but not the vao, a copy comes out with created false and VAO 0 (same as clone, this just spells it out).
+		//meshes in a scenes MeshComponent get created when they get extracted, anywhere else call create on the copy yourself.
+		//every copy duplicates all the vertex buffers, move when you don't need the original anymore
+		Mesh(const Mesh& mesh);
+		Mesh& operator=(const Mesh& mesh);
+		Mesh(Mesh&& mesh) noexcept;
+		Mesh& operator=(Mesh&& mesh) noexcept;
 
 		~Mesh();
 
+		Mesh clone() const;
+
 		void create();
 
 		/*
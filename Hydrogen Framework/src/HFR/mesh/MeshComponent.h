@@ -4,13 +4,21 @@
 
 #include HFR_API
 #include "Mesh.h"
+#include HFR_ASSET_HANDLE
 
 namespace HFR {
 
 	struct DLL_API MeshComponent {
 		std::vector<Mesh> meshes;
+		//from AssetLoader::loadMesh, gets drawn alongside meshes once it's ready
+		MeshHandle asset;
 
 		MeshComponent();
+		//copying goes through Mesh's copy so the copy gets its own vaos, move it into addComponent instead
+		MeshComponent(const MeshComponent&) = default;
+		MeshComponent& operator=(const MeshComponent&) = default;
+		MeshComponent(MeshComponent&&) = default;
+		MeshComponent& operator=(MeshComponent&&) = default;
 		~MeshComponent();
 
 		void clearAllVertices();
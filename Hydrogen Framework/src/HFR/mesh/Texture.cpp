@@ -8,22 +8,13 @@ namespace HFR {
 	}
 
 	Texture::Texture(const Image& _image) {
-		image = _image;
+		image = _image.clone();
 		textureID = 0;
 	}
 
-	Texture::Texture(const Texture& texture) {
-		image = Image(texture.image);
+	Texture::Texture(Image&& _image) {
+		image = std::move(_image);
 		textureID = 0;
-		byteAlignment = texture.byteAlignment;
-		wrapMode = texture.wrapMode;
-		filterMode = texture.filterMode;
-		textureType = texture.textureType;
-		internalFormat = texture.internalFormat;
-		format = texture.format;
-		dataType = texture.dataType;
-		generateMipmap = texture.generateMipmap;
-		textureUnit = texture.textureUnit;
 	}
 
 	Texture::Texture(const std::string& path) {
@@ -31,9 +22,28 @@ namespace HFR {
 		textureID = 0;
 	}
 
+	Texture::Texture(const CookedTexture& _cooked) {
+		cooked = _cooked;
+		textureID = 0;
+	}
+
+	Texture::Texture(const Texture& texture) : Texture(texture.clone()) {}
+
 	Texture& Texture::operator=(const Texture& texture) {
+		//this used to share the texture id, which got it deleted twice
+		if (this != &texture)
+			*this = texture.clone();
+
+		return *this;
+	}
+
+	Texture::Texture(Texture&& texture) noexcept {
+		image = std::move(texture.image);
+		mipmaps = std::move(texture.mipmaps);
+		cooked = std::move(texture.cooked);
+		firstLevel = texture.firstLevel;
 		textureID = texture.textureID;
-		image = texture.image;
+		isCreated = texture.isCreated;
 
 		byteAlignment = texture.byteAlignment;
 		wrapMode = texture.wrapMode;
@@ -45,6 +55,35 @@ namespace HFR {
 		generateMipmap = texture.generateMipmap;
 		textureUnit = texture.textureUnit;
 
+		texture.textureID = 0;
+		texture.isCreated = false;
+	}
+
+	Texture& Texture::operator=(Texture&& texture) noexcept {
+		if (this != &texture) {
+			destroy();
+
+			image = std::move(texture.image);
+			mipmaps = std::move(texture.mipmaps);
+			cooked = std::move(texture.cooked);
+			firstLevel = texture.firstLevel;
+			textureID = texture.textureID;
+			isCreated = texture.isCreated;
+
+			byteAlignment = texture.byteAlignment;
+			wrapMode = texture.wrapMode;
+			filterMode = texture.filterMode;
+			textureType = texture.textureType;
+			internalFormat = texture.internalFormat;
+			format = texture.format;
+			dataType = texture.dataType;
+			generateMipmap = texture.generateMipmap;
+			textureUnit = texture.textureUnit;
+
+			texture.textureID = 0;
+			texture.isCreated = false;
+		}
+
 		return *this;
 	}
 
@@ -52,8 +91,50 @@ namespace HFR {
 		destroy();
 	}
 
+	Texture Texture::clone() const {
+		Texture out;
+		out.image = image.clone();
+
+		for (size_t i = 0; i < mipmaps.size(); ++i)
+			out.mipmaps.push_back(mipmaps[i].clone());
+
+		//the cooked data is read only so sharing it is fine
+		out.cooked = cooked;
+		out.firstLevel = firstLevel;
+
+		out.byteAlignment = byteAlignment;
+		out.wrapMode = wrapMode;
+		out.filterMode = filterMode;
+		out.textureType = textureType;
+		out.internalFormat = internalFormat;
+		out.format = format;
+		out.dataType = dataType;
+		out.generateMipmap = generateMipmap;
+		out.textureUnit = textureUnit;
+
+		return out;
+	}
+
 	void Texture::destroy() {
-		glDeleteTextures(1, &textureID);
+		if (textureID != 0)
+			glDeleteTextures(1, &textureID);
+
+		textureID = 0;
+		isCreated = false;
+	}
+
+	void Texture::setSampler(const TextureSampler& sampler) {
+		wrapMode = sampler.wrapMode;
+		filterMode = sampler.filterMode;
+		generateMipmap = sampler.generateMipmap;
+	}
+
+	TextureSampler Texture::getSampler() const {
+		TextureSampler out;
+		out.wrapMode = wrapMode;
+		out.filterMode = filterMode;
+		out.generateMipmap = generateMipmap;
+		return out;
 	}
 
 	void Texture::create() {
@@ -76,10 +157,35 @@ namespace HFR {
 			else
 				glTexImage2D(textureType, 0, internalFormat, image.width, image.height, 0, format, dataType, 0);*/
 
-			glTexImage2D(textureType, 0, internalFormat, image.width, image.height, 0, format, dataType, image.data);
+			if (cooked.isOpen()) {
+				internalFormat = cooked.getInternalFormat();
+
+				firstLevel = min(max(firstLevel, 0), (int)cooked.getLevelAmount() - 1);
+
+				for (int i = firstLevel; i < (int)cooked.getLevelAmount(); ++i)
+					uploadCookedLevel(i);
 
-			if(generateMipmap)
-				glGenerateMipmap(textureType);
+				glTexParameteri(textureType, GL_TEXTURE_BASE_LEVEL, firstLevel);
+
+				//the driver can't make block compressed mips so a single level file stays a single level
+				if (cooked.getLevelAmount() > 1 || cooked.isCompressed())
+					glTexParameteri(textureType, GL_TEXTURE_MAX_LEVEL, (GLint)cooked.getLevelAmount() - 1);
+				else if (generateMipmap)
+					glGenerateMipmap(textureType);
+			}
+			else {
+				glTexImage2D(textureType, 0, internalFormat, image.width, image.height, 0, format, dataType, image.data);
+
+				//mips made on the cpu go up level by level, that way the driver doesn't stall making them
+				if (!mipmaps.empty()) {
+					for (size_t i = 0; i < mipmaps.size(); ++i)
+						glTexImage2D(textureType, (GLint)i + 1, internalFormat, mipmaps[i].width, mipmaps[i].height, 0, format, dataType, mipmaps[i].data);
+
+					glTexParameteri(textureType, GL_TEXTURE_MAX_LEVEL, (GLint)mipmaps.size());
+				}
+				else if(generateMipmap)
+					glGenerateMipmap(textureType);
+			}
 
 			isCreated = true;
 
@@ -91,8 +197,48 @@ namespace HFR {
 
 	void Texture::setSubImage(const int& level, const Vec2i& offset, const Vec2i& size, const void* pixels) {
 		glBindTexture(textureType, textureID);
+		//whatever was created last left its own alignment behind
+		glPixelStorei(GL_UNPACK_ALIGNMENT, byteAlignment);
 		glTexSubImage2D(GL_TEXTURE_2D, level, offset.x, offset.y, size.x, size.y, format, dataType, pixels);
 		glBindTexture(textureType, 0);
 	}
 
+	void Texture::setFirstLevel(const int& level) {
+		if (!cooked.isOpen() || level < 0 || level >= (int)cooked.getLevelAmount() || level == firstLevel)
+			return;
+
+		//create picks it up from here
+		if (!isCreated) {
+			firstLevel = level;
+			return;
+		}
+
+		glBindTexture(textureType, textureID);
+
+		//setSubImage only writes into levels that already have storage, levels coming in need to be defined whole
+		for (int i = level; i < firstLevel; ++i)
+			uploadCookedLevel(i);
+
+		//levels going out get redefined as empty so the driver can let go of them
+		for (int i = firstLevel; i < level; ++i) {
+			if (cooked.isCompressed())
+				glCompressedTexImage2D(textureType, i, internalFormat, 0, 0, 0, 0, NULL);
+			else
+				glTexImage2D(textureType, i, internalFormat, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+
+		firstLevel = level;
+		glTexParameteri(textureType, GL_TEXTURE_BASE_LEVEL, firstLevel);
+
+		glBindTexture(textureType, 0);
+	}
+
+	void Texture::uploadCookedLevel(const int& level) {
+		//every level comes out of the file as is, compressed ones never get decoded on the cpu
+		if (cooked.isCompressed())
+			glCompressedTexImage2D(textureType, level, internalFormat, cooked.getLevelWidth(level), cooked.getLevelHeight(level), 0, (GLsizei)cooked.getLevelSize(level), cooked.getLevelData(level));
+		else
+			glTexImage2D(textureType, level, internalFormat, cooked.getLevelWidth(level), cooked.getLevelHeight(level), 0, GL_RGBA, GL_UNSIGNED_BYTE, cooked.getLevelData(level));
+	}
+
 }
\ No newline at end of file
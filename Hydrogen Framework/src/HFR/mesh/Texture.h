@@ -5,13 +5,28 @@
 
 #include HFR_API
 #include HFR_IMAGE
+#include HFR_COOKED_TEXTURE
 #include HFR_MATH
 
 namespace HFR {
 
+	//the settings that change how a texture gets sampled, the texture cache keys on these along with the path
+	struct DLL_API TextureSampler {
+		Vec2i wrapMode = Vec2i(GL_CLAMP_TO_EDGE);
+		//same as what Texture actually ends up with by default
+		Vec2i filterMode = Vec2i(GL_NEAREST);
+		bool generateMipmap = true;
+	};
+
 	class DLL_API Texture {
 	public:
 		Image image;
+		//levels 1 and up (see ImageProcessing::generateMipChain), when there are any they get uploaded instead of calling glGenerateMipmap
+		std::vector<Image> mipmaps;
+		//when this is open it gets uploaded instead of image and mipmaps, compressed formats go straight to the gpu without being decoded
+		CookedTexture cooked;
+		//first cooked level on the gpu, the ones above it (bigger) aren't uploaded, texture streaming moves this around
+		int firstLevel = 0;
 		unsigned int textureID;
 		bool isCreated = false;
 
@@ -36,15 +51,32 @@ namespace HFR {
 
 		Texture();
 		Texture(const Image& image);
-		Texture(const Texture& texture);
-
+		Texture(Image&& image);
 		Texture(const std::string& path);
+		Texture(const CookedTexture& cooked);
+
+		//copies get their own pixels but come out with isCreated false and textureID 0 (same as clone), nothing uploads them on its own,
+		//call create on the copy or Renderer::getTexture keeps handing out the null texture for it. only moves carry the gl texture over
+		Texture(const Texture& texture);
 		Texture& operator=(const Texture& texture);
+		Texture(Texture&& texture) noexcept;
+		Texture& operator=(Texture&& texture) noexcept;
 		~Texture();
 
+		Texture clone() const;
+
+		void setSampler(const TextureSampler& sampler);
+		TextureSampler getSampler() const;
+
 		void create();
 		void destroy();
 		void setSubImage(const int& level, const Vec2i& offset, const Vec2i& size, const void* pixels);
+		//cooked textures only, uploads the levels from level up to the current first level or drops the ones below level
+		void setFirstLevel(const int& level);
+
+	private:
+		//defines the whole level, needs the texture bound
+		void uploadCookedLevel(const int& level);
 	};
 
 }
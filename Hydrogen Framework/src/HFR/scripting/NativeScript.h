@@ -28,19 +28,32 @@ namespace HFR {
 				scriptAmount += 1;
 			}
 			else
-				Debug::systemErr("Couldn't add script with name: " + name + ", because it wasn't registered");
+				Debug::systemErr("Couldn't add script with name: {}, because it wasn't registered", name);
 			
 			instantiateScript = [](NativeScript* nativeScript, const unsigned int& index) {
 				GameObject* script = ScriptManager::instantiateScript(nativeScript->nameToScriptIndex[index]);
 				if (script != nullptr)
 					nativeScript->scripts[index] = script;
 				else
-					Debug::systemErr("Couldn't find script: " + nativeScript->nameToScriptIndex[index]);
+					Debug::systemErr("Couldn't find script: {}", nativeScript->nameToScriptIndex[index]);
 			};
 		}
 
+		//stops the scripts that got started and deletes them, the component can make them again after this
 		void destroyScripts() {
+			for (unsigned int i = 0; i < scriptAmount; ++i) {
+				//taken out first, stop can end up destroying this object again
+				GameObject* script = scripts[i];
+				scripts[i] = nullptr;
 
+				if (script == nullptr)
+					continue;
+
+				if (script->created)
+					script->stop();
+
+				delete script;
+			}
 		}
 
 	};
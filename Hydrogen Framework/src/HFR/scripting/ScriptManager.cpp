@@ -17,7 +17,7 @@ namespace HFR {
 		HINSTANCE dllHandle = LoadLibraryA(path.c_str());
 
 		if (!dllHandle) {
-			Debug::systemErr("Couldn't load dll file containing scripts at: " + path);
+			Debug::systemErr("Couldn't load dll file containing scripts at: {}", path);
 		}
 
 		typedef GameObject* (__stdcall* scriptPointer)();
@@ -25,7 +25,7 @@ namespace HFR {
 		scriptPointer createScript = (scriptPointer)GetProcAddress(dllHandle, "CreateScript");
 
 		if (!createScript) {
-			Debug::systemErr("Couldn't find the create function of a script in the dll file containing scripts at: " + path + "(Check if there is an export function for the script)");
+			Debug::systemErr("Couldn't find the create function of a script in the dll file containing scripts at: {}(Check if there is an export function for the script)", path);
 		}
 
 		if (scriptPathToName.find(path) == scriptPathToName.end() && scriptNameToScript.find(name) == scriptNameToScript.end()) {
@@ -39,7 +39,7 @@ namespace HFR {
 		}
 		else {
 			if(!supressError)
-			Debug::systemErr("Already loaded script file: " + path + ", or already loaded script with name: " + name);
+			Debug::systemErr("Already loaded script file: {}, or already loaded script with name: {}", path, name);
 		}
 	}
 
@@ -75,7 +75,7 @@ namespace HFR {
 			return scriptNameToScript[name]();
 		}
 		else {
-			Debug::systemErr("No script found of name: " + name);
+			Debug::systemErr("No script found of name: {}", name);
 			return nullptr;
 		}
 	}
@@ -105,12 +105,12 @@ namespace HFR {
 						if (modeIdentification == "_D")
 							loadScriptFromDLL(path + file, name, supressError);
 						else if (!supressError && modeIdentification != "_R")
-							Debug::systemErr("Couldn't load script dll: " + file + ", because it doesn't have debug identification, it should be: scriptname_D.dll. At path: " + path);
+							Debug::systemErr("Couldn't load script dll: {}, because it doesn't have debug identification, it should be: scriptname_D.dll. At path: {}", file, path);
 #else
 						if (modeIdentification == "_R")
 							loadScriptFromDLL(path + file, name, supressError);
 						else if (!supressError && modeIdentification != "_D")
-							Debug::systemErr("Couldn't load script dll: " + file + ", because it doesn't have release identification, it should be: scriptname_R.dll. At path: " + path);
+							Debug::systemErr("Couldn't load script dll: {}, because it doesn't have release identification, it should be: scriptname_R.dll. At path: {}", file, path);
 #endif
 					}
 				}
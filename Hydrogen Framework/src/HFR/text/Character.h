@@ -10,6 +10,7 @@ namespace HFR {
 	struct DLL_API Character {
 		Vec2f size; //size
 		Vec2f textureOffset; //offset in texture coordinates for a glyph
+		Vec2f textureSize; //size in texture coordinates
 		Vec2f advance; //amount to offset glyph in rendering
 		Vec2f bitmapLeftTop; //the top and left of the bitmap
 
@@ -5,14 +5,17 @@
 
 namespace HFR {
 
+	namespace {
+		//what fonts without an atlas hand out
+		const Texture noTexture;
+	}
+
 	Font::Font() {
 		size = Vec2f(0, 48);
-		atlasSize = Vec2f();
 	}
 
 	Font::Font(const std::string& _path) {
 		size = Vec2f(0, 48);
-		atlasSize = Vec2f();
 		path = _path;
 		name = Util::removePathFromFilePathAndName(_path);
 	}
@@ -21,108 +24,87 @@ namespace HFR {
          
 	}
 
-	void Font::create() {
-
-		FT_Face face = FreeType::loadFace(path);
-		FT_Set_Pixel_Sizes(face, 0, size.y);
-		FT_GlyphSlot glyph = face->glyph;
+	bool Font::rasterize() {
+		//distance field glyphs don't depend on the text size so they always get made at the same one
+		std::shared_ptr<GlyphCache> cache = std::make_shared<GlyphCache>(path, distanceField, distanceField ? HFR_SDF_GLYPH_SIZE : (int)size.y);
+		cache->maxAtlasSize = maxAtlasSize;
 
-		float width = 0;
-		float height = 0;
+		if (!cache->open())
+			return false;
 
-		float rowWidth = 0;
-		float rowHeight = 0;
+		//ascii goes in up front, everything else gets added when text needs it
+		std::string ascii;
 
-		for (int i = 0; i < 128; ++i) {
-			//super sophisticated error checking algorithm
-			if (FT_Load_Char(face, i, FT_LOAD_RENDER)) {
-				std::string character;
-				character = (char)(i);
+		for (char i = 32; i < 127; ++i)
+			ascii += i;
 
-				std::string error = ("Loading character " + character + " has failed in font: " + name);
-				Debug::systemErr(error);
-				
-				continue;
-			}
+		cache->cacheText(ascii);
+		glyphs = cache;
 
-			if (rowWidth + glyph->bitmap.width + 1 >= (unsigned int)maxTextureWidth) {
-				width = max(width, rowWidth);
-				height += rowHeight;
-
-				rowWidth = 0;
-				rowHeight = 0;
-			}
+		if (logStatus) {
+			Vec2i atlasSize = glyphs->getAtlasSize();
 
-			rowWidth += glyph->bitmap.width + 1;
-			rowHeight = max(height, glyph->bitmap.rows);
+			Debug::systemSuccess("Loaded font: " + name, DebugColor::Blue);
+			Debug::systemSuccess(name + " atlas size is " + std::to_string(atlasSize.x) + " x " + std::to_string(atlasSize.y) + " pixels and is " + std::to_string(glyphs->getMemoryUsage() / 1024) + " kb", DebugColor::Blue);
 		}
 
-		width = max(width, rowWidth);
-		height += rowHeight;
-
-		atlasSize = Vec2f(width, height);
-
-		rowHeight = 0;
-
-		Vec2i offset = Vec2i();
-
-
-		unsigned char* blankColor = new unsigned char[width * height];
-
-		for (int i = 0; i < (width * height); ++i) {
-			blankColor[i] = 0x0;
-		}
+		return true;
+	}
 
-		Image imageData = Image(width, height, 1, blankColor);
+	void Font::createTexture() {
+		if (glyphs != nullptr)
+			glyphs->createTexture();
+	}
 
-		texture = Texture(imageData);
-		texture.byteAlignment = 1;
-		texture.filterMode = Vec2i(GL_LINEAR);
-		texture.internalFormat = GL_RED;
-		texture.format = GL_RED;
-		texture.generateMipmap = false;
-		texture.wrapMode = Vec2i(GL_CLAMP_TO_EDGE);
+	void Font::create() {
+		if (rasterize())
+			createTexture();
+	}
 
-		texture.create();
+	bool Font::isRasterized() const {
+		return glyphs != nullptr;
+	}
 
-		for (int i = 0; i < 128; ++i) {
-			//super sophisticated error checking algorithm
-			if (FT_Load_Char(face, i, FT_LOAD_RENDER)) {
-				std::string character;
-				character = (char)(i);
+	bool Font::cacheText(const std::string& text) {
+		return glyphs != nullptr && glyphs->cacheText(text);
+	}
 
-				std::string error = ("Loading character " + character + " has failed in font: " + Util::removePathFromFilePathAndName(path));
-				Debug::systemErr(error);
+	bool Font::getCharacter(const uint32_t& codepoint, Character& out) const {
+		const CachedGlyph* glyph = glyphs != nullptr ? glyphs->getGlyph(codepoint) : nullptr;
 
-				continue;
-			}
+		if (glyph == nullptr)
+			return false;
 
-			if (offset.x + glyph->bitmap.width + 1 >= (unsigned int)maxTextureWidth) {
-				offset.y += rowHeight;
-				rowHeight = 0;
-				offset.x = 0;
-			}
+		const float scale = size.y / glyphs->pixelSize;
+		const Vec2f atlasSize = getAtlasSize();
 
-			texture.setSubImage(0, offset, Vec2i(glyph->bitmap.width, glyph->bitmap.rows), glyph->bitmap.buffer);
+		out.size = Vec2f(glyph->size.x * scale, glyph->size.y * scale);
+		out.advance = Vec2f(glyph->advance.x * scale, glyph->advance.y * scale);
+		out.bitmapLeftTop = Vec2f(glyph->bitmapLeftTop.x * scale, glyph->bitmapLeftTop.y * scale);
+		out.textureOffset = Vec2f(glyph->position.x / atlasSize.x, glyph->position.y / atlasSize.y);
+		out.textureSize = Vec2f(glyph->size.x / atlasSize.x, glyph->size.y / atlasSize.y);
 
-			characters[i].advance = Vec2f((float)(glyph->advance.x >> 6), (float)(glyph->advance.y >> 6));
-			characters[i].bitmapLeftTop = Vec2f((float)glyph->bitmap_left, (float)glyph->bitmap_top);
-			characters[i].size = Vec2f((float)(glyph->bitmap.width), (float)(glyph->bitmap.rows));
-			characters[i].textureOffset = Vec2f((float)(offset.x / width), (float)(offset.y / height));
+		return true;
+	}
 
-			rowHeight = max(rowHeight, glyph->bitmap.rows);
-			offset.x += glyph->bitmap.width + 2;
-		}
+	const Texture& Font::getTexture() const {
+		return glyphs != nullptr ? glyphs->getTexture() : noTexture;
+	}
 
-		delete[] blankColor;
+	Vec2f Font::getAtlasSize() const {
+		if (glyphs == nullptr)
+			return Vec2f();
 
-		if (logStatus) {
-			Debug::systemSuccess("Loaded font: " + Util::removePathFromFilePathAndName(path), DebugColor::Blue);
-			Debug::systemSuccess(Util::removePathFromFilePathAndName(path) + " atlas size is " + std::to_string(width) + " x " + std::to_string(height) + " pixels and is " + std::to_string(width * height / 1024) + " kb", DebugColor::Blue);
-		}
+		Vec2i atlasSize = glyphs->getAtlasSize();
+		return Vec2f((float)atlasSize.x, (float)atlasSize.y);
+	}
 
-		FT_Done_Face(face);
+	unsigned int Font::getAtlasGeneration() const {
+		return glyphs != nullptr ? glyphs->getGeneration() : 0;
+	}
 
+	std::shared_ptr<GlyphCache> Font::getGlyphCache() const {
+		return glyphs;
 	}
 
 }
@@ -5,33 +5,57 @@
 #include HFR_API
 #include HFR_VEC2
 #include HFR_CHARACTER
-#include HFR_TEXTURE
+#include HFR_GLYPH_CACHE
 
 namespace HFR {
 
 	class Face;
 
+	//copies share the glyph cache (and its texture), so a copy at another size doesn't make another atlas for distance field fonts
 	class DLL_API Font {
+	private:
+		std::shared_ptr<GlyphCache> glyphs;
+
 	public:
+		//pixel size text gets laid out at
 		Vec2f size;
-		Vec2f atlasSize;
-
-		Texture texture;
 
-		int maxTextureWidth = 1024;
+		//distance field glyphs stay sharp at any size, bitmap ones get rasterized at size.y and only look right at that size
+		bool distanceField = true;
+		//the atlas doubles up to this before it starts evicting glyphs
+		int maxAtlasSize = HFR_MAX_GLYPH_ATLAS_SIZE;
 
 		bool logStatus = true;
 
-		Character characters[128];
-		//std::map<unsigned char, Character> characters;
 		std::string path;
 		std::string name;
 
 		Font();
 		Font(const std::string& path);
+		Font(const Font&) = default;
+		Font& operator=(const Font&) = default;
+		Font(Font&&) = default;
+		Font& operator=(Font&&) = default;
 		~Font();
 
+		//freetype part only, opens the font and puts ascii in the atlas (safe to run on a worker thread)
+		bool rasterize();
+		//uploads the atlas, rasterize has to have worked first
+		void createTexture();
 		void create();
+		bool isRasterized() const;
+
+		//every codepoint of the utf-8 text that isn't in the atlas yet gets added, lay text out right after this
+		bool cacheText(const std::string& text);
+		//metrics scaled to size and texture coordinates in the current atlas, false when the codepoint isn't cached
+		bool getCharacter(const uint32_t& codepoint, Character& out) const;
+
+		const Texture& getTexture() const;
+		Vec2f getAtlasSize() const;
+		//see GlyphCache::getGeneration
+		unsigned int getAtlasGeneration() const;
+		//nullptr until rasterize worked
+		std::shared_ptr<GlyphCache> getGlyphCache() const;
 
 	};
 
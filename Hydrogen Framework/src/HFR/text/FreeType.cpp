@@ -3,6 +3,12 @@
 
 namespace HFR {
 
+	namespace {
+		std::mutex faceMutex;
+		//memory faces read straight from the file data, so it has to live as long as the face
+		std::unordered_map<FT_Face, FileData> faceFiles;
+	}
+
 	FT_Library FreeType::ftLibrary = nullptr;
 
 	void FreeType::init() {
@@ -23,15 +29,35 @@ namespace HFR {
 	
 	FT_Face FreeType::loadFace(const std::string& path) {
 		FT_Face out = nullptr;
+		FT_Error error;
+
+		FileData file = VirtualFileSystem::read(path);
+
+		if (!file.isValid()) {
+			Debug::systemErr("Couldn't load font: {}", path);
+			return nullptr;
+		}
 
-		FT_Error error = FT_New_Face(ftLibrary, path.c_str(), 0, &out);
+		{
+			std::lock_guard<std::mutex> lock(faceMutex);
+			error = FT_New_Memory_Face(ftLibrary, file.getData(), (FT_Long)file.getSize(), 0, &out);
+
+			if (!error)
+				faceFiles[out] = file;
+		}
 
 		if (error == FT_Err_Unknown_File_Format)
-			Debug::systemErr("Unkown font format at: " + path);
+			Debug::systemErr("Unkown font format at: {}", path);
 		else if(error)
-			Debug::systemErr("Couldn't load font: " + path);
+			Debug::systemErr("Couldn't load font: {}", path);
 
 		return out;
 	}
 
+	void FreeType::closeFace(FT_Face face) {
+		std::lock_guard<std::mutex> lock(faceMutex);
+		FT_Done_Face(face);
+		faceFiles.erase(face);
+	}
+
 }
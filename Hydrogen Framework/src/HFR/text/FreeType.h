@@ -13,7 +13,9 @@ namespace HFR {
 		static void init();
 		static void close();
 
+		//the library isn't thread safe for creating and destroying faces so these two lock, using a face after that is fine from any thread
 		static FT_Face loadFace(const std::string& path);
+		static void closeFace(FT_Face face);
 
 	};
 
@@ -0,0 +1,314 @@
+#include "hfpch.h"
+#include HFR_GLYPH_CACHE
+#include HFR_FREETYPE
+#include HFR_IMAGE_PROCESSING
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		void copyRect(const Image& from, const Vec2i& fromPosition, Image& to, const Vec2i& toPosition, const Vec2i& size) {
+			for (int row = 0; row < size.y; ++row) {
+				std::memcpy(to.data + (size_t)(toPosition.y + row) * to.width + toPosition.x,
+					from.data + (size_t)(fromPosition.y + row) * from.width + fromPosition.x, (size_t)size.x);
+			}
+		}
+
+		Image createAtlas(const int& width, const int& height) {
+			Image out = Image(width, height, 1, NULL);
+			std::memset(out.data, 0, (size_t)width * height);
+
+			return out;
+		}
+	}
+
+	GlyphCache::GlyphCache(const std::string& _path, const bool& _distanceField, const int& _pixelSize) {
+		path = _path;
+		distanceField = _distanceField;
+		pixelSize = _pixelSize;
+	}
+
+	GlyphCache::~GlyphCache() {
+		if (face != nullptr)
+			FreeType::closeFace(face);
+	}
+
+	bool GlyphCache::open() {
+		if (isOpen())
+			return true;
+
+		face = FreeType::loadFace(path);
+
+		if (face == nullptr)
+			return false;
+
+		FT_Set_Pixel_Sizes(face, 0, (FT_UInt)(distanceField ? pixelSize * HFR_SDF_SUPERSAMPLE : pixelSize));
+
+		int size = min(HFR_GLYPH_ATLAS_SIZE, maxAtlasSize);
+
+		texture = Texture();
+		texture.image = createAtlas(size, size);
+
+		texture.byteAlignment = 1;
+		texture.filterMode = Vec2i(GL_LINEAR);
+		texture.internalFormat = GL_RED;
+		texture.format = GL_RED;
+		texture.generateMipmap = false;
+		texture.wrapMode = Vec2i(GL_CLAMP_TO_EDGE);
+
+		packer.reset(size, size);
+
+		return true;
+	}
+
+	bool GlyphCache::isOpen() const {
+		return face != nullptr;
+	}
+
+	bool GlyphCache::cacheText(const std::string& text) {
+		std::vector<uint32_t> codepoints;
+
+		for (size_t i = 0; i < text.size();)
+			codepoints.push_back(Util::decodeUTF8(text, i));
+
+		return cacheCodepoints(codepoints);
+	}
+
+	bool GlyphCache::cacheGlyph(const uint32_t& codepoint) {
+		return cacheCodepoints(std::vector<uint32_t>(1, codepoint));
+	}
+
+	const CachedGlyph* GlyphCache::getGlyph(const uint32_t& codepoint) const {
+		auto found = glyphs.find(codepoint);
+
+		return found != glyphs.end() ? &found->second : nullptr;
+	}
+
+	bool GlyphCache::cacheCodepoints(const std::vector<uint32_t>& codepoints) {
+		if (!isOpen())
+			return false;
+
+		useCounter += 1;
+		bool out = true;
+
+		std::vector<PendingGlyph> pending;
+		std::unordered_set<uint32_t> queued;
+
+		for (size_t i = 0; i < codepoints.size(); ++i) {
+			auto found = glyphs.find(codepoints[i]);
+
+			if (found != glyphs.end()) {
+				found->second.lastUsed = useCounter;
+				continue;
+			}
+
+			if (!queued.insert(codepoints[i]).second)
+				continue;
+
+			PendingGlyph glyph;
+
+			if (loadGlyph(codepoints[i], glyph))
+				pending.push_back(std::move(glyph));
+			else
+				out = false;
+		}
+
+		//the distance fields are most of the work and don't need freetype, so they get spread over the job system
+		if (distanceField) {
+			JobSystem::parallelFor(pending.size(), 8, [&pending](const size_t& begin, const size_t& end) {
+				for (size_t i = begin; i < end; ++i) {
+					if (pending[i].bitmap.hasData())
+						pending[i].bitmap = ImageProcessing::createDistanceField(pending[i].bitmap, HFR_SDF_SPREAD, HFR_SDF_SUPERSAMPLE);
+				}
+			});
+		}
+
+		//tallest first packs tightest
+		std::sort(pending.begin(), pending.end(), [](const PendingGlyph& a, const PendingGlyph& b) {
+			return a.bitmap.height > b.bitmap.height;
+		});
+
+		for (size_t i = 0; i < pending.size(); ++i) {
+			if (!placeGlyph(pending[i]))
+				out = false;
+		}
+
+		if (texture.isCreated)
+			createTexture();
+
+		return out;
+	}
+
+	bool GlyphCache::loadGlyph(const uint32_t& codepoint, PendingGlyph& out) {
+		//codepoints the font doesn't have load its missing glyph box instead of failing
+		if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER)) {
+			Debug::systemErr("Loading character {} has failed in font: {}", codepoint, Util::removePathFromFilePathAndName(path));
+			return false;
+		}
+
+		FT_GlyphSlot slot = face->glyph;
+		const FT_Bitmap& bitmap = slot->bitmap;
+
+		//distance field glyphs got rasterized bigger than they end up
+		const float scale = distanceField ? 1.0f / HFR_SDF_SUPERSAMPLE : 1.0f;
+
+		out.codepoint = codepoint;
+		out.glyph.lastUsed = useCounter;
+		out.glyph.advance = Vec2f(slot->advance.x / 64.0f * scale, slot->advance.y / 64.0f * scale);
+		out.glyph.bitmapLeftTop = Vec2f(slot->bitmap_left * scale, slot->bitmap_top * scale);
+
+		//nothing to draw (like space)
+		if (bitmap.width == 0 || bitmap.rows == 0)
+			return true;
+
+		out.bitmap = Image((int)bitmap.width, (int)bitmap.rows, 1, NULL);
+
+		for (unsigned int row = 0; row < bitmap.rows; ++row)
+			std::memcpy(out.bitmap.data + (size_t)row * bitmap.width, &bitmap.buffer[row * bitmap.pitch], bitmap.width);
+
+		//the padding around the distance field moves the corner out
+		if (distanceField) {
+			out.glyph.bitmapLeftTop.x -= HFR_SDF_SPREAD;
+			out.glyph.bitmapLeftTop.y += HFR_SDF_SPREAD;
+		}
+
+		return true;
+	}
+
+	bool GlyphCache::placeGlyph(PendingGlyph& pending) {
+		CachedGlyph& glyph = pending.glyph;
+		const Image& bitmap = pending.bitmap;
+
+		if (bitmap.hasData()) {
+			//a texel of space between glyphs so linear filtering never reaches into the neighbours
+			const Vec2i packSize = Vec2i(bitmap.width + 1, bitmap.height + 1);
+
+			while (!packer.insert(packSize, glyph.position)) {
+				if (!growAtlas() && !evictGlyphs(glyph.lastUsed)) {
+					Debug::systemErr("Glyph atlas is full in font: {}", Util::removePathFromFilePathAndName(path));
+					return false;
+				}
+			}
+
+			glyph.size = Vec2i(bitmap.width, bitmap.height);
+			copyRect(bitmap, Vec2i(), texture.image, glyph.position, glyph.size);
+
+			//the rest waits for the whole atlas to go up
+			if (texture.isCreated && !needsUpload)
+				texture.setSubImage(0, glyph.position, glyph.size, bitmap.data);
+		}
+
+		glyphs[pending.codepoint] = glyph;
+
+		return true;
+	}
+
+	bool GlyphCache::growAtlas() {
+		const Vec2i size = getAtlasSize();
+
+		if (size.x >= maxAtlasSize && size.y >= maxAtlasSize)
+			return false;
+
+		const int width = min(size.x * 2, max(maxAtlasSize, size.x));
+		const int height = min(size.y * 2, max(maxAtlasSize, size.y));
+
+		//everything keeps its texel position so only the texture coordinates change
+		Image atlas = createAtlas(width, height);
+		copyRect(texture.image, Vec2i(), atlas, Vec2i(), size);
+
+		texture.image = std::move(atlas);
+		packer.grow(width, height);
+
+		generation += 1;
+		needsUpload = true;
+
+		return true;
+	}
+
+	bool GlyphCache::evictGlyphs(const unsigned long long& protectedFrom) {
+		std::vector<std::pair<unsigned long long, uint32_t>> candidates;
+
+		for (auto& pair : glyphs) {
+			if (pair.second.lastUsed < protectedFrom && pair.second.size.x > 0)
+				candidates.push_back(std::make_pair(pair.second.lastUsed, pair.first));
+		}
+
+		if (candidates.empty())
+			return false;
+
+		std::sort(candidates.begin(), candidates.end());
+
+		for (size_t i = 0; i < max(candidates.size() / 2, (size_t)1); ++i)
+			glyphs.erase(candidates[i].second);
+
+		//skyline space can't be given back one glyph at a time, so whatever is left gets packed again from scratch (tallest first packs tightest)
+		std::vector<std::pair<int, uint32_t>> order;
+
+		for (auto& pair : glyphs) {
+			if (pair.second.size.x > 0)
+				order.push_back(std::make_pair(-pair.second.size.y, pair.first));
+		}
+
+		std::sort(order.begin(), order.end());
+
+		const Vec2i size = getAtlasSize();
+		Image atlas = createAtlas(size.x, size.y);
+		SkylinePacker repacked = SkylinePacker(size.x, size.y);
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			CachedGlyph& glyph = glyphs[order[i].second];
+			Vec2i position;
+
+			if (!repacked.insert(Vec2i(glyph.size.x + 1, glyph.size.y + 1), position)) {
+				glyphs.erase(order[i].second);
+				continue;
+			}
+
+			copyRect(texture.image, glyph.position, atlas, position, glyph.size);
+			glyph.position = position;
+		}
+
+		texture.image = std::move(atlas);
+		packer = repacked;
+
+		generation += 1;
+		needsUpload = true;
+
+		return true;
+	}
+
+	void GlyphCache::createTexture() {
+		if (texture.isCreated && !needsUpload)
+			return;
+
+		texture.destroy();
+		texture.create();
+
+		needsUpload = false;
+	}
+
+	const Texture& GlyphCache::getTexture() const {
+		return texture;
+	}
+
+	Vec2i GlyphCache::getAtlasSize() const {
+		return Vec2i(texture.image.width, texture.image.height);
+	}
+
+	unsigned int GlyphCache::getGeneration() const {
+		return generation;
+	}
+
+	size_t GlyphCache::getGlyphAmount() const {
+		return glyphs.size();
+	}
+
+	size_t GlyphCache::getMemoryUsage() const {
+		return (size_t)texture.image.width * texture.image.height;
+	}
+
+	float GlyphCache::getOccupancy() const {
+		return packer.getOccupancy();
+	}
+
+}
@@ -0,0 +1,90 @@
+#ifndef HFR_GLYPH_CACHE_HEADER_INCLUDE
+#define HFR_GLYPH_CACHE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_VEC2
+#include HFR_TEXTURE
+#include HFR_SKYLINE_PACKER
+
+namespace HFR {
+
+	//one glyph as it sits in the atlas, metrics are in pixels at the size the cache rasterizes at
+	struct DLL_API CachedGlyph {
+		//top left in the atlas and size in atlas texels, distance field padding included
+		Vec2i position;
+		Vec2i size;
+		Vec2f bitmapLeftTop;
+		Vec2f advance;
+		unsigned long long lastUsed = 0;
+	};
+
+	//the atlas behind a font, glyphs get rasterized the first time some text needs them instead of all up front so any codepoint works
+	//distance field caches make every glyph at HFR_SDF_GLYPH_SIZE and get scaled to whatever size the text is, bitmap ones only look right at their own size
+	//once the atlas is at its max size the least recently used glyphs get evicted and the rest packed again, which changes getGeneration
+	//rasterizing works on any thread until the texture is created, after that it's main thread only since new glyphs go straight to the gpu
+	class DLL_API GlyphCache {
+	private:
+		FT_Face face = nullptr;
+		std::unordered_map<uint32_t, CachedGlyph> glyphs;
+		SkylinePacker packer;
+		//texture.image is the cpu copy of the atlas
+		Texture texture;
+
+		unsigned long long useCounter = 0;
+		unsigned int generation = 0;
+		//set when the atlas grew or got packed again, the whole thing has to go up again
+		bool needsUpload = false;
+
+		//a glyph between being rasterized and getting its spot in the atlas
+		struct PendingGlyph {
+			uint32_t codepoint;
+			CachedGlyph glyph;
+			Image bitmap;
+		};
+
+		//marks every codepoint used and adds the ones that aren't cached, none of them get evicted to make room for each other
+		bool cacheCodepoints(const std::vector<uint32_t>& codepoints);
+		//the freetype part, coverage and metrics (with the distance field padding already counted in)
+		bool loadGlyph(const uint32_t& codepoint, PendingGlyph& out);
+		bool placeGlyph(PendingGlyph& pending);
+		bool growAtlas();
+		//drops the older half of the glyphs not used since protectedFrom and packs the rest again, false when there's nothing to drop
+		bool evictGlyphs(const unsigned long long& protectedFrom);
+
+	public:
+		std::string path;
+		bool distanceField;
+		//pixel size glyphs get rasterized at
+		int pixelSize;
+		int maxAtlasSize = HFR_MAX_GLYPH_ATLAS_SIZE;
+
+		GlyphCache(const std::string& path, const bool& distanceField, const int& pixelSize);
+		GlyphCache(const GlyphCache&) = delete;
+		GlyphCache& operator=(const GlyphCache&) = delete;
+		~GlyphCache();
+
+		bool open();
+		bool isOpen() const;
+
+		//adds every codepoint in the utf-8 text that isn't cached yet and marks all of them as used
+		bool cacheText(const std::string& text);
+		bool cacheGlyph(const uint32_t& codepoint);
+		//nullptr when it isn't cached
+		const CachedGlyph* getGlyph(const uint32_t& codepoint) const;
+
+		//uploads the atlas the first time, after that only when it grew or got packed again
+		void createTexture();
+		const Texture& getTexture() const;
+
+		Vec2i getAtlasSize() const;
+		//goes up every time glyphs move around in the atlas, text laid out with an older generation has the wrong texture coordinates
+		unsigned int getGeneration() const;
+		size_t getGlyphAmount() const;
+		//bytes of the atlas on the gpu, the cpu copy is the same again
+		size_t getMemoryUsage() const;
+		float getOccupancy() const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,381 @@
+#include "hfpch.h"
+#include HFR_FRAME_TELEMETRY
+#include HFR_ALLOCATION_TRACKER
+#include HFR_QUAD_BATCHER
+#include HFR_TEXT_BATCHER
+#include HFR_GPU_PROFILER
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		//what the engine profiles anyway
+		const char* DEFAULT_SUBSYSTEMS[] = { "Input update", "ScriptManager update", "Scene Editor update", "Asset uploads", "Texture streamer update",
+			"Gui layout", "Gui canvas render", "Quad batcher flush", "Text batcher flush", "Swap buffers", "Simulation", "Waiting on simulation", "Scene", "Gui canvas", "Quad batches", "Text batches" };
+
+#if !_WIN64
+		//kept open, procfs files give fresh contents every time they're read from the start
+		int statmFile = -1;
+#endif
+	}
+
+	std::vector<FrameSample> FrameTelemetry::samples;
+	std::vector<std::string> FrameTelemetry::subsystemNames;
+	std::vector<std::vector<float>> FrameTelemetry::subsystemTimes;
+	size_t FrameTelemetry::next = 0;
+	size_t FrameTelemetry::frameAmount = 0;
+	double FrameTelemetry::frameTimeSum = 0;
+
+	std::chrono::steady_clock::time_point FrameTelemetry::lastFrame;
+	double FrameTelemetry::lastCpuTime = -1;
+	size_t FrameTelemetry::lastAllocations = 0;
+	size_t FrameTelemetry::lastAllocatedBytes = 0;
+	size_t FrameTelemetry::totalHitches = 0;
+
+	size_t FrameTelemetry::capacity = HFR_TELEMETRY_FRAMES;
+
+	size_t FrameTelemetry::meshDrawCalls = 0;
+	size_t FrameTelemetry::meshTriangles = 0;
+
+	float FrameTelemetry::hitchFactor = HFR_TELEMETRY_HITCH_FACTOR;
+	float FrameTelemetry::hitchMilliseconds = HFR_TELEMETRY_HITCH_MILLISECONDS;
+
+	void FrameTelemetry::update() {
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const double cpuTime = getProcessCpuTime();
+		const size_t allocations = AllocationTracker::getAllocations();
+		const size_t allocatedBytes = AllocationTracker::getAllocatedBytes();
+
+		//the first call only has something to measure the next frame from
+		if (lastCpuTime < 0) {
+			for (size_t i = 0; i < sizeof(DEFAULT_SUBSYSTEMS) / sizeof(DEFAULT_SUBSYSTEMS[0]); ++i)
+				trackSubsystem(DEFAULT_SUBSYSTEMS[i]);
+		}
+		else {
+			FrameSample sample;
+			sample.frameTime = std::chrono::duration<float, std::milli>(now - lastFrame).count();
+			sample.cpuTime = (float)(cpuTime - lastCpuTime);
+			sample.gpuTime = (float)GpuProfiler::getFrameTime();
+			sample.drawCalls = meshDrawCalls + QuadBatcher::getDrawCalls() + TextBatcher::getDrawCalls();
+			sample.triangles = meshTriangles + (QuadBatcher::getQuadAmount() + TextBatcher::getQuadAmount()) * 2;
+			sample.allocations = allocations - lastAllocations;
+			sample.allocatedBytes = allocatedBytes - lastAllocatedBytes;
+			sample.memory = (float)getResidentMemory();
+
+			addSample(sample);
+		}
+
+		lastFrame = now;
+		lastCpuTime = cpuTime;
+		lastAllocations = allocations;
+		lastAllocatedBytes = allocatedBytes;
+
+		meshDrawCalls = 0;
+		meshTriangles = 0;
+	}
+
+	void FrameTelemetry::addSample(const FrameSample& frame) {
+		if (samples.empty())
+			samples.resize(capacity);
+
+		FrameSample& sample = samples[next];
+
+		//the frame that falls out of the window
+		if (frameAmount == capacity)
+			frameTimeSum -= sample.frameTime;
+
+		const size_t others = frameAmount == capacity ? frameAmount - 1 : frameAmount;
+		const double average = others > 0 ? frameTimeSum / others : 0;
+
+		sample = frame;
+		sample.hitch = others > 0 && sample.frameTime >= hitchMilliseconds && sample.frameTime > hitchFactor * average;
+		totalHitches += sample.hitch ? 1 : 0;
+
+		for (size_t i = 0; i < subsystemNames.size(); ++i) {
+			size_t calls = 0;
+			double milliseconds = 0;
+
+			if (!ScopeProfiler::getTotal(subsystemNames[i], calls, milliseconds))
+				GpuProfiler::getTotal(subsystemNames[i], milliseconds);
+
+			subsystemTimes[i][next] = (float)milliseconds;
+		}
+
+		frameTimeSum += sample.frameTime;
+		frameAmount = min(frameAmount + 1, capacity);
+		next = (next + 1) % capacity;
+	}
+
+	void FrameTelemetry::trackSubsystem(const std::string& name) {
+		for (size_t i = 0; i < subsystemNames.size(); ++i) {
+			if (subsystemNames[i] == name)
+				return;
+		}
+
+		subsystemNames.push_back(name);
+		//frames from before it was tracked read as 0
+		subsystemTimes.push_back(std::vector<float>(capacity, 0.0f));
+	}
+
+	void FrameTelemetry::countDraw(const size_t& triangles) {
+		meshDrawCalls += 1;
+		meshTriangles += triangles;
+	}
+
+	void FrameTelemetry::setCapacity(const size_t& frames) {
+		if (frames == 0) {
+			Debug::systemErr("Frame telemetry needs room for at least one frame");
+			return;
+		}
+
+		capacity = frames;
+		samples.clear();
+		samples.resize(capacity);
+
+		for (size_t i = 0; i < subsystemTimes.size(); ++i)
+			subsystemTimes[i].assign(capacity, 0.0f);
+
+		clear();
+	}
+
+	size_t FrameTelemetry::getCapacity() {
+		return capacity;
+	}
+
+	size_t FrameTelemetry::getFrameAmount() {
+		return frameAmount;
+	}
+
+	size_t FrameTelemetry::getIndex(const size_t& age) {
+		return (next + capacity - 1 - age) % capacity;
+	}
+
+	const FrameSample& FrameTelemetry::getSample(const size_t& age) {
+		return samples[getIndex(age)];
+	}
+
+	FrameStats FrameTelemetry::getStats(std::vector<float>& values) {
+		FrameStats stats = {};
+		stats.frames = values.size();
+
+		if (values.empty())
+			return stats;
+
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&](const double& fraction) {
+			const size_t rank = (size_t)std::ceil(fraction * values.size());
+			return values[rank > 0 ? rank - 1 : 0];
+		};
+
+		stats.average = (float)(std::accumulate(values.begin(), values.end(), 0.0) / values.size());
+		stats.p50 = percentile(0.5);
+		stats.p95 = percentile(0.95);
+		stats.p99 = percentile(0.99);
+		stats.max = values.back();
+
+		return stats;
+	}
+
+	FrameStats FrameTelemetry::getFrameStats() {
+		std::vector<float> values(frameAmount);
+
+		for (size_t i = 0; i < frameAmount; ++i)
+			values[i] = getSample(i).frameTime;
+
+		return getStats(values);
+	}
+
+	FrameStats FrameTelemetry::getCpuStats() {
+		std::vector<float> values(frameAmount);
+
+		for (size_t i = 0; i < frameAmount; ++i)
+			values[i] = getSample(i).cpuTime;
+
+		return getStats(values);
+	}
+
+	FrameStats FrameTelemetry::getGpuStats() {
+		std::vector<float> values(frameAmount);
+
+		for (size_t i = 0; i < frameAmount; ++i)
+			values[i] = getSample(i).gpuTime;
+
+		return getStats(values);
+	}
+
+	FrameStats FrameTelemetry::getSubsystemStats(const std::string& name) {
+		std::vector<float> values;
+
+		for (size_t i = 0; i < subsystemNames.size(); ++i) {
+			if (subsystemNames[i] != name)
+				continue;
+
+			values.resize(frameAmount);
+
+			for (size_t j = 0; j < frameAmount; ++j)
+				values[j] = subsystemTimes[i][getIndex(j)];
+		}
+
+		return getStats(values);
+	}
+
+	size_t FrameTelemetry::getHitches() {
+		size_t hitches = 0;
+
+		for (size_t i = 0; i < frameAmount; ++i)
+			hitches += getSample(i).hitch ? 1 : 0;
+
+		return hitches;
+	}
+
+	size_t FrameTelemetry::getTotalHitches() {
+		return totalHitches;
+	}
+
+	double FrameTelemetry::getProcessCpuTime() {
+#if _WIN64
+		FILETIME creation, exited, kernel, user;
+
+		if (!GetProcessTimes(GetCurrentProcess(), &creation, &exited, &kernel, &user))
+			return 0;
+
+		ULARGE_INTEGER kernelTime, userTime;
+		std::memcpy(&kernelTime, &kernel, sizeof(FILETIME));
+		std::memcpy(&userTime, &user, sizeof(FILETIME));
+
+		//100 nanosecond units
+		return (double)(kernelTime.QuadPart + userTime.QuadPart) / 10000.0;
+#else
+		//the same thing /proc/self/stat has, without its 10 ms resolution
+		timespec time;
+
+		if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+			return 0;
+
+		return (double)time.tv_sec * 1000.0 + (double)time.tv_nsec / 1000000.0;
+#endif
+	}
+
+	double FrameTelemetry::getResidentMemory() {
+#if _WIN64
+		PROCESS_MEMORY_COUNTERS counters;
+
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+
+		return (double)counters.WorkingSetSize / 1048576;
+#else
+		if (statmFile < 0)
+			statmFile = open("/proc/self/statm", O_RDONLY);
+
+		char text[128];
+		const ssize_t length = statmFile >= 0 ? pread(statmFile, text, sizeof(text) - 1, 0) : -1;
+
+		if (length <= 0)
+			return 0;
+
+		text[length] = '\0';
+
+		//total size then resident size, in pages
+		unsigned long long size = 0;
+		unsigned long long resident = 0;
+
+		if (sscanf(text, "%llu %llu", &size, &resident) != 2)
+			return 0;
+
+		return (double)resident * (double)sysconf(_SC_PAGESIZE) / 1048576;
+#endif
+	}
+
+	bool FrameTelemetry::dumpCsv(const std::string& path) {
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't write frame telemetry to: {}", path);
+			return false;
+		}
+
+		file << "frame,frame ms,cpu ms,gpu ms,draw calls,triangles,allocations,allocated bytes,memory MB,hitch";
+
+		for (size_t i = 0; i < subsystemNames.size(); ++i)
+			file << ",\"" << subsystemNames[i] << " ms\"";
+
+		file << "\n";
+
+		for (size_t age = frameAmount; age-- > 0;) {
+			const size_t index = getIndex(age);
+			const FrameSample& sample = samples[index];
+
+			file << frameAmount - 1 - age << "," << sample.frameTime << "," << sample.cpuTime << "," << sample.gpuTime << "," << sample.drawCalls << "," << sample.triangles << "," <<
+				sample.allocations << "," << sample.allocatedBytes << "," << sample.memory << "," << (sample.hitch ? 1 : 0);
+
+			for (size_t i = 0; i < subsystemTimes.size(); ++i)
+				file << "," << subsystemTimes[i][index];
+
+			file << "\n";
+		}
+
+		Debug::systemLog("Wrote {} frames of telemetry to: {}", frameAmount, path);
+		return true;
+	}
+
+	bool FrameTelemetry::dumpJson(const std::string& path) {
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't write frame telemetry to: {}", path);
+			return false;
+		}
+
+		auto writeStats = [&](const FrameStats& stats) {
+			file << "{ \"average\": " << stats.average << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << " }";
+		};
+
+		//profiler names are plain text, only quotes and backslashes need escaping
+		auto writeName = [&](const std::string& name) {
+			file << "\"";
+
+			for (size_t i = 0; i < name.size(); ++i) {
+				if (name[i] == '"' || name[i] == '\\')
+					file << '\\';
+
+				file << name[i];
+			}
+
+			file << "\"";
+		};
+
+		file << "{\n\t\"frames\": " << frameAmount << ",\n\t\"hitches\": " << getHitches() << ",\n";
+		file << "\t\"frameTime\": ";
+		writeStats(getFrameStats());
+		file << ",\n\t\"cpuTime\": ";
+		writeStats(getCpuStats());
+		file << ",\n\t\"gpuTime\": ";
+		writeStats(getGpuStats());
+		file << ",\n\t\"subsystems\": {";
+
+		for (size_t i = 0; i < subsystemNames.size(); ++i) {
+			file << (i > 0 ? ",\n\t\t" : "\n\t\t");
+			writeName(subsystemNames[i]);
+			file << ": ";
+			writeStats(getSubsystemStats(subsystemNames[i]));
+		}
+
+		file << "\n\t}\n}\n";
+
+		Debug::systemLog("Wrote a report of {} frames to: {}", frameAmount, path);
+		return true;
+	}
+
+	void FrameTelemetry::clear() {
+		next = 0;
+		frameAmount = 0;
+		frameTimeSum = 0;
+	}
+
+}
@@ -0,0 +1,107 @@
+#ifndef HFR_FRAME_TELEMETRY_HEADER_INCLUDE
+#define HFR_FRAME_TELEMETRY_HEADER_INCLUDE
+
+#include HFR_API
+
+namespace HFR {
+
+	struct DLL_API FrameSample {
+		//milliseconds, wall time from the frame before
+		float frameTime;
+		//milliseconds of cpu time the whole process used during the frame, every thread counts so it can be more than frameTime
+		float cpuTime;
+		//milliseconds between the first and last gpu timestamp of the newest frame the gpu finished, a couple of frames behind the rest
+		float gpuTime;
+		size_t drawCalls;
+		size_t triangles;
+		size_t allocations;
+		size_t allocatedBytes;
+		//resident memory in megabytes
+		float memory;
+		bool hitch;
+	};
+
+	//milliseconds over the frames in the window, percentiles are nearest rank
+	struct DLL_API FrameStats {
+		size_t frames;
+		float average;
+		float p50;
+		float p95;
+		float p99;
+		float max;
+	};
+
+	//keeps the last HFR_TELEMETRY_FRAMES (or setCapacity) frames worth of timings and counters, the statistics get worked out when asked for
+	//a frame is a hitch when it takes hitchFactor times the average of the window and at least hitchMilliseconds
+	class DLL_API FrameTelemetry {
+	private:
+		//ring buffers, next is where the coming frame goes
+		static std::vector<FrameSample> samples;
+		static std::vector<std::string> subsystemNames;
+		static std::vector<std::vector<float>> subsystemTimes;
+		static size_t next;
+		static size_t capacity;
+		static size_t frameAmount;
+		static double frameTimeSum;
+
+		static std::chrono::steady_clock::time_point lastFrame;
+		static double lastCpuTime;
+		static size_t lastAllocations;
+		static size_t lastAllocatedBytes;
+		static size_t totalHitches;
+
+		static size_t meshDrawCalls;
+		static size_t meshTriangles;
+
+		//index into the ring buffers, age 0 is the newest frame
+		static size_t getIndex(const size_t& age);
+		static FrameStats getStats(std::vector<float>& values);
+
+	public:
+		static float hitchFactor;
+		static float hitchMilliseconds;
+
+		//once a frame after Debug::update, samples the frame that just ended
+		static void update();
+		//a frame measured somewhere else (replays, synthetic frame times), hitch gets worked out here and the subsystems come from the profilers last collect
+		static void addSample(const FrameSample& sample);
+
+		//the time of every profiler scope with that name goes into its own column, gpu scopes count too when no cpu scope has the name,
+		//a few of the engines own get tracked from the start
+		static void trackSubsystem(const std::string& name);
+		//what the renderer calls for every draw that doesn't go through a batcher
+		static void countDraw(const size_t& triangles);
+
+		//how many frames the window holds, changing it drops every frame, replays make it as long as the run so the report covers all of it
+		static void setCapacity(const size_t& frames);
+		static size_t getCapacity();
+		//frames in the window, up to the capacity
+		static size_t getFrameAmount();
+		//age 0 is the newest frame, has to be less than getFrameAmount
+		static const FrameSample& getSample(const size_t& age);
+
+		static FrameStats getFrameStats();
+		static FrameStats getCpuStats();
+		static FrameStats getGpuStats();
+		//zeros when the subsystem isn't tracked
+		static FrameStats getSubsystemStats(const std::string& name);
+		//in the window and since startup
+		static size_t getHitches();
+		static size_t getTotalHitches();
+
+		//milliseconds of cpu time the process used since it started, over every thread
+		static double getProcessCpuTime();
+		//megabytes of the process that are actually in memory
+		static double getResidentMemory();
+
+		//every frame in the window oldest first, one column per counter and tracked subsystem
+		static bool dumpCsv(const std::string& path);
+		//statistics of the window as json, frame, cpu and gpu time and every tracked subsystem, what replay runs get compared with
+		static bool dumpJson(const std::string& path);
+		//drops every frame, the tracked subsystems stay
+		static void clear();
+	};
+
+}
+
+#endif
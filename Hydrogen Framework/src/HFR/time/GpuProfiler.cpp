@@ -0,0 +1,303 @@
+#include "hfpch.h"
+#include HFR_GPU_PROFILER
+
+namespace HFR {
+
+	namespace {
+		struct GpuEvent {
+			uint32_t marker;
+			bool isEnd;
+		};
+
+		//the queries of one frame, event i wrote into queries[i]
+		struct QueryPool {
+			std::vector<uint32_t> queries;
+			std::vector<GpuEvent> events;
+			size_t frameNumber = 0;
+			//written and not read back yet
+			bool pending = false;
+		};
+
+		std::array<QueryPool, HFR_GPU_TIMER_FRAMES> pools;
+		size_t current = 0;
+		size_t frameNumber = 0;
+
+		//whether each open scope got its queries, ends have to match up with their begins
+		std::vector<bool> open;
+
+		//index in the frame being resolved of every scope that began and hasn't ended yet
+		std::vector<size_t> resolving;
+
+		//marker names for the debug groups, so they don't get looked up every time
+		std::vector<std::string> groupNames;
+
+		const std::string& getGroupName(const uint32_t& marker) {
+			if (marker >= groupNames.size())
+				groupNames.resize(ScopeProfiler::getMarkerAmount());
+
+			if (marker < groupNames.size() && groupNames[marker].empty())
+				groupNames[marker] = ScopeProfiler::getMarkerName(marker);
+
+			static const std::string unknown = "Unknown";
+			return marker < groupNames.size() ? groupNames[marker] : unknown;
+		}
+	}
+
+	bool GpuProfiler::enabled = false;
+	GpuTimerBackend GpuProfiler::backend;
+	std::vector<GpuTiming> GpuProfiler::frame;
+	double GpuProfiler::frameTime = 0;
+	size_t GpuProfiler::latency = 0;
+	size_t GpuProfiler::dropped = 0;
+	std::vector<RecordedEvent> GpuProfiler::recorded;
+	double GpuProfiler::tickOffset = 0;
+	size_t GpuProfiler::framesSinceSync = HFR_GPU_TIMER_SYNC_FRAMES;
+
+	GpuScope::GpuScope(const uint32_t& _marker) {
+		marker = _marker;
+		GpuProfiler::begin(marker);
+	}
+
+	GpuScope::~GpuScope() {
+		GpuProfiler::end(marker);
+	}
+
+	void GpuProfiler::init() {
+		if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) {
+			Debug::systemErr("The driver has no timer queries, gpu profiling is off");
+			return;
+		}
+
+		GpuTimerBackend gl;
+
+		gl.createQueries = [](const size_t& amount, uint32_t* queries) { glGenQueries((GLsizei)amount, queries); };
+		gl.deleteQueries = [](const size_t& amount, const uint32_t* queries) { glDeleteQueries((GLsizei)amount, queries); };
+		gl.writeTimestamp = [](const uint32_t& query) { glQueryCounter(query, GL_TIMESTAMP); };
+
+		gl.isAvailable = [](const uint32_t& query) {
+			GLint available = 0;
+			glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+			return available != 0;
+		};
+
+		gl.getTimestamp = [](const uint32_t& query) {
+			GLuint64 time = 0;
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &time);
+			return (uint64_t)time;
+		};
+
+		gl.getTime = []() {
+			GLint64 time = 0;
+			glGetInteger64v(GL_TIMESTAMP, &time);
+			return (uint64_t)time;
+		};
+
+		//debug groups are only for tools, without them the timings still work
+		if (GLEW_VERSION_4_3 || GLEW_KHR_debug) {
+			gl.pushGroup = [](const char* name) { glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name); };
+			gl.popGroup = []() { glPopDebugGroup(); };
+		}
+
+		setBackend(gl);
+	}
+
+	void GpuProfiler::close() {
+		for (size_t i = 0; i < pools.size(); ++i) {
+			if (!pools[i].queries.empty() && backend.deleteQueries)
+				backend.deleteQueries(pools[i].queries.size(), pools[i].queries.data());
+
+			pools[i] = QueryPool();
+		}
+
+		open.clear();
+		frame.clear();
+		frameTime = 0;
+		enabled = false;
+	}
+
+	void GpuProfiler::setBackend(const GpuTimerBackend& _backend) {
+		close();
+
+		backend = _backend;
+		enabled = true;
+		framesSinceSync = HFR_GPU_TIMER_SYNC_FRAMES;
+	}
+
+	bool GpuProfiler::isEnabled() {
+		return enabled;
+	}
+
+	void GpuProfiler::begin(const uint32_t& marker) {
+		if (!enabled)
+			return;
+
+		if (backend.pushGroup)
+			backend.pushGroup(getGroupName(marker).c_str());
+
+		QueryPool& pool = pools[current];
+
+		//room for this begin and the end of every scope that's open, so no end ever gets left out
+		if (pool.events.size() + open.size() + 2 > HFR_GPU_TIMER_QUERIES) {
+			open.push_back(false);
+			return;
+		}
+
+		if (pool.events.size() == pool.queries.size()) {
+			const size_t amount = min(max(pool.queries.size(), (size_t)16), HFR_GPU_TIMER_QUERIES - pool.queries.size());
+
+			pool.queries.resize(pool.queries.size() + amount);
+			backend.createQueries(amount, pool.queries.data() + pool.queries.size() - amount);
+		}
+
+		backend.writeTimestamp(pool.queries[pool.events.size()]);
+		pool.events.push_back({ marker, false });
+		open.push_back(true);
+	}
+
+	void GpuProfiler::end(const uint32_t& marker) {
+		if (!enabled || open.empty())
+			return;
+
+		const bool written = open.back();
+		open.pop_back();
+
+		if (written) {
+			QueryPool& pool = pools[current];
+
+			if (pool.events.size() == pool.queries.size()) {
+				pool.queries.resize(pool.queries.size() + 1);
+				backend.createQueries(1, &pool.queries.back());
+			}
+
+			backend.writeTimestamp(pool.queries[pool.events.size()]);
+			pool.events.push_back({ marker, true });
+		}
+
+		if (backend.popGroup)
+			backend.popGroup();
+	}
+
+	void GpuProfiler::endFrame() {
+		if (!enabled)
+			return;
+
+		pools[current].pending = !pools[current].events.empty();
+		pools[current].frameNumber = frameNumber;
+
+		frameNumber += 1;
+		current = (current + 1) % HFR_GPU_TIMER_FRAMES;
+
+		if (ScopeProfiler::isRecording() && ++framesSinceSync >= HFR_GPU_TIMER_SYNC_FRAMES)
+			sync();
+
+		//oldest first, the pool that's about to get written into again has to be read now or never
+		for (size_t i = 0; i < HFR_GPU_TIMER_FRAMES; ++i) {
+			const size_t index = (current + i) % HFR_GPU_TIMER_FRAMES;
+			QueryPool& pool = pools[index];
+
+			if (!pool.pending)
+				continue;
+
+			if (backend.isAvailable(pool.queries[pool.events.size() - 1]))
+				resolve(index);
+			else if (index == current) {
+				dropped += 1;
+				pool.pending = false;
+			}
+			//the gpu finishes frames in order, nothing newer is done either
+			else
+				break;
+		}
+
+		pools[current].events.clear();
+	}
+
+	void GpuProfiler::resolve(const size_t& index) {
+		QueryPool& pool = pools[index];
+
+		const bool recording = ScopeProfiler::isRecording();
+		const double ticksPerNanosecond = recording ? ScopeProfiler::getTicksPerMillisecond() / 1000000.0 : 0;
+
+		const uint64_t first = backend.getTimestamp(pool.queries[0]);
+		uint64_t last = first;
+
+		frame.clear();
+		resolving.clear();
+
+		for (size_t i = 0; i < pool.events.size(); ++i) {
+			const GpuEvent& event = pool.events[i];
+			const uint64_t time = i == 0 ? first : backend.getTimestamp(pool.queries[i]);
+			const double milliseconds = (double)(time - first) / 1000000.0;
+
+			last = max(last, time);
+
+			if (recording)
+				recorded.push_back({ (uint64_t)(tickOffset + (double)time * ticksPerNanosecond), event.marker, HFR_GPU_TRACE_THREAD, (uint16_t)(event.isEnd ? 1 : 0) });
+
+			if (!event.isEnd) {
+				resolving.push_back(frame.size());
+				frame.push_back({ event.marker, (int)resolving.size() - 1, milliseconds, 0 });
+			}
+			else if (!resolving.empty()) {
+				GpuTiming& timing = frame[resolving.back()];
+				timing.duration = milliseconds - timing.start;
+				resolving.pop_back();
+			}
+		}
+
+		frameTime = (double)(last - first) / 1000000.0;
+		//frameNumber already counts the frame that just ended
+		latency = frameNumber - 1 - pool.frameNumber;
+		pool.pending = false;
+	}
+
+	void GpuProfiler::sync() {
+		framesSinceSync = 0;
+
+		if (!backend.getTime)
+			return;
+
+		//both clocks read back to back, the gap between the two calls is the error
+		const uint64_t gpuTime = backend.getTime();
+		const uint64_t ticks = ScopeProfiler::getTicks();
+
+		tickOffset = (double)ticks - (double)gpuTime * ScopeProfiler::getTicksPerMillisecond() / 1000000.0;
+	}
+
+	const std::vector<GpuTiming>& GpuProfiler::getFrame() {
+		return frame;
+	}
+
+	double GpuProfiler::getFrameTime() {
+		return frameTime;
+	}
+
+	size_t GpuProfiler::getLatency() {
+		return latency;
+	}
+
+	size_t GpuProfiler::getDroppedFrames() {
+		return dropped;
+	}
+
+	bool GpuProfiler::getTotal(const std::string& name, double& milliseconds) {
+		milliseconds = 0;
+		bool found = false;
+
+		for (size_t i = 0; i < frame.size(); ++i) {
+			if (getGroupName(frame[i].marker) != name)
+				continue;
+
+			milliseconds += frame[i].duration;
+			found = true;
+		}
+
+		return found;
+	}
+
+	void GpuProfiler::takeRecorded(std::vector<RecordedEvent>& out) {
+		out.clear();
+		std::swap(out, recorded);
+	}
+
+}
@@ -0,0 +1,106 @@
+#ifndef HFR_GPU_PROFILER_HEADER_INCLUDE
+#define HFR_GPU_PROFILER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_SCOPE_PROFILER
+
+#define HFR_GPU_SCOPE_INNER(name, counter) static const HFR::ProfileMarker HFR_PROFILE_CONCAT(hfrGpuMarker, counter)(name, "gpu"); \
+	HFR::GpuScope HFR_PROFILE_CONCAT(hfrGpuScope, counter)(HFR_PROFILE_CONCAT(hfrGpuMarker, counter).id)
+
+//times how long the gpu takes for the draws issued in the rest of the enclosing scope and shows up as a debug group in tools like renderdoc,
+//it has to end in the frame it began in, name has to be a string literal
+#define ProfileGpuTime(name) HFR_GPU_SCOPE_INNER(name, __COUNTER__)
+
+namespace HFR {
+
+	//what the gpu profiler needs from the graphics api, init sets up the opengl one, tests can hand in one with made up timestamps
+	struct DLL_API GpuTimerBackend {
+		std::function<void(const size_t& amount, uint32_t* queries)> createQueries;
+		std::function<void(const size_t& amount, const uint32_t* queries)> deleteQueries;
+		//the gpu writes its clock into the query once everything before it is done
+		std::function<void(const uint32_t& query)> writeTimestamp;
+		std::function<bool(const uint32_t& query)> isAvailable;
+		//nanoseconds, only asked for once isAvailable said yes
+		std::function<uint64_t(const uint32_t& query)> getTimestamp;
+		//nanoseconds on the same clock, right now
+		std::function<uint64_t()> getTime;
+		//can be empty when there's nothing to show the groups in
+		std::function<void(const char* name)> pushGroup;
+		std::function<void()> popGroup;
+	};
+
+	//one gpu scope in a resolved frame
+	struct DLL_API GpuTiming {
+		uint32_t marker;
+		int depth;
+		//milliseconds from the first timestamp of the frame
+		double start;
+		double duration;
+	};
+
+	class DLL_API GpuScope {
+	private:
+		uint32_t marker;
+
+	public:
+		GpuScope(const uint32_t& marker);
+		GpuScope(const GpuScope&) = delete;
+		GpuScope& operator=(const GpuScope&) = delete;
+		~GpuScope();
+	};
+
+	//every scope writes a timestamp query when it begins and ends, the queries of one frame are read back HFR_GPU_TIMER_FRAMES - 1 frames later
+	//when they're done so nothing waits on the gpu, a frame that still isn't done by the time its queries come around again gets dropped
+	class DLL_API GpuProfiler {
+	private:
+		static bool enabled;
+		static GpuTimerBackend backend;
+
+		static std::vector<GpuTiming> frame;
+		static double frameTime;
+		static size_t latency;
+		static size_t dropped;
+
+		static std::vector<RecordedEvent> recorded;
+
+		//the profiler tick a gpu nanosecond of 0 lines up with, only needed for traces
+		static double tickOffset;
+		static size_t framesSinceSync;
+
+		static void resolve(const size_t& pool);
+		static void sync();
+
+	public:
+		//main thread with a current context, turns itself off when the driver has no timer queries
+		static void init();
+		//before the context goes
+		static void close();
+		//replaces whatever init set up, the pools get made again with the new backend
+		static void setBackend(const GpuTimerBackend& backend);
+		static bool isEnabled();
+
+		//what GpuScope calls, main thread only
+		static void begin(const uint32_t& marker);
+		static void end(const uint32_t& marker);
+
+		//once a frame once everything is submitted, Window::update does it before swapping
+		static void endFrame();
+
+		//the newest frame the gpu finished
+		static const std::vector<GpuTiming>& getFrame();
+		//milliseconds from the first timestamp to the last of it
+		static double getFrameTime();
+		//how many frames ago that one was submitted
+		static size_t getLatency();
+		//frames whose results were given up on
+		static size_t getDroppedFrames();
+		//summed up time of every scope with that name, false when it isn't in the frame
+		static bool getTotal(const std::string& name, double& milliseconds);
+
+		//while the scope profiler records, resolved scopes come out of here with profiler ticks and HFR_GPU_TRACE_THREAD as thread
+		static void takeRecorded(std::vector<RecordedEvent>& out);
+	};
+
+}
+
+#endif
@@ -35,8 +35,7 @@ namespace HFR {
 
 	void Profiler::stop() {
 		if (shouldLogOnStop) {
-			std::string Duration = std::to_string(getDuration());
-			Debug::log(nameOfFunction + " ms: " + Duration);
+			Debug::log("{} ms: {}", nameOfFunction, getDuration());
 		}
 
 		if (storeInDebug) {
@@ -0,0 +1,362 @@
+#include "hfpch.h"
+#include HFR_SCOPE_PROFILER
+
+namespace HFR {
+
+	namespace {
+		struct ProfileEvent {
+			uint64_t ticks;
+			uint32_t marker;
+			uint32_t isEnd;
+		};
+
+		//a scope that began and hasn't ended yet as the collector sees it
+		struct OpenScope {
+			uint32_t marker;
+			uint64_t start;
+			//inclusive ticks of the scopes that already ended inside this one
+			uint64_t childTicks;
+			//node in the frame being collected, -1 until the scope (or one inside it) ends in that frame
+			int node;
+		};
+
+		//one producer (the thread it belongs to) and one consumer (collect), head and tail are on their own cache lines so they don't bounce between the two
+		struct ThreadBuffer {
+			std::unique_ptr<ProfileEvent[]> events;
+
+			alignas(64) std::atomic<size_t> head;
+			//the owners last look at tail, it only loads the real one again when the buffer looks full
+			size_t cachedTail = 0;
+			std::atomic<size_t> dropped;
+
+			alignas(64) std::atomic<size_t> tail;
+
+			//everything below is only touched by collect
+			std::string name;
+			std::vector<OpenScope> open;
+			std::vector<ProfileNode> nodes;
+			//(parent + 1) << 32 | marker to node
+			std::unordered_map<uint64_t, int> nodeLookup;
+			size_t reportedDropped = 0;
+
+			ThreadBuffer() : events(new ProfileEvent[HFR_PROFILER_BUFFER_EVENTS]), head(0), dropped(0), tail(0) {}
+		};
+
+		const size_t BUFFER_MASK = HFR_PROFILER_BUFFER_EVENTS - 1;
+
+		thread_local ThreadBuffer* threadBuffer = nullptr;
+
+		//buffers live as long as the program so nothing a thread wrote before it exited gets lost
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+		std::mutex bufferMutex;
+
+		std::vector<std::string> markerNames;
+		std::vector<std::string> markerCategories;
+		std::mutex markerMutex;
+
+		uint64_t startTicks = 0;
+		std::chrono::steady_clock::time_point startTime;
+		bool started = false;
+
+		ThreadBuffer* registerThread() {
+			std::lock_guard<std::mutex> lock(bufferMutex);
+
+			buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+			buffers.back()->name = "Thread " + std::to_string(buffers.size() - 1);
+
+			threadBuffer = buffers.back().get();
+			return threadBuffer;
+		}
+
+		inline void push(const uint32_t& marker, const uint32_t& isEnd, const uint64_t& ticks) {
+			ThreadBuffer* buffer = threadBuffer != nullptr ? threadBuffer : registerThread();
+			const size_t head = buffer->head.load(std::memory_order_relaxed);
+
+			if (head - buffer->cachedTail >= HFR_PROFILER_BUFFER_EVENTS) {
+				buffer->cachedTail = buffer->tail.load(std::memory_order_acquire);
+
+				//collect hasn't been around in a while, the event is lost and collect sorts out the nesting
+				if (head - buffer->cachedTail >= HFR_PROFILER_BUFFER_EVENTS) {
+					buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+			}
+
+			ProfileEvent& event = buffer->events[head & BUFFER_MASK];
+			event.ticks = ticks;
+			event.marker = marker;
+			event.isEnd = isEnd;
+
+			buffer->head.store(head + 1, std::memory_order_release);
+		}
+
+		//node of the open scope at depth, made along with the nodes of every open scope under it the first time its needed this frame
+		int getNode(ThreadBuffer& buffer, const size_t& depth) {
+			OpenScope& scope = buffer.open[depth];
+
+			if (scope.node >= 0)
+				return scope.node;
+
+			const int parent = depth > 0 ? getNode(buffer, depth - 1) : -1;
+			const uint64_t key = ((uint64_t)(parent + 1) << 32) | scope.marker;
+
+			auto found = buffer.nodeLookup.find(key);
+
+			if (found != buffer.nodeLookup.end()) {
+				scope.node = found->second;
+				return scope.node;
+			}
+
+			ProfileNode node;
+			node.marker = scope.marker;
+			node.parent = parent;
+			node.calls = 0;
+			node.inclusive = 0;
+			node.exclusive = 0;
+
+			scope.node = (int)buffer.nodes.size();
+			buffer.nodes.push_back(node);
+			buffer.nodeLookup[key] = scope.node;
+
+			return scope.node;
+		}
+
+		void logNode(const ThreadProfile& thread, const int& index, const int& depth) {
+			const ProfileNode& node = thread.nodes[index];
+
+			Debug::log("{}{}: {} ms ({} ms self), {} calls", std::string((size_t)depth * 2, ' '), ScopeProfiler::getMarkerName(node.marker), node.inclusive, node.exclusive, node.calls);
+
+			for (size_t i = index + 1; i < thread.nodes.size(); ++i) {
+				if (thread.nodes[i].parent == index)
+					logNode(thread, (int)i, depth + 1);
+			}
+		}
+	}
+
+	std::vector<ThreadProfile> ScopeProfiler::frame;
+	double ScopeProfiler::ticksPerMillisecond = 0;
+	bool ScopeProfiler::recording = false;
+	std::vector<RecordedEvent> ScopeProfiler::recorded;
+
+	ProfileMarker::ProfileMarker(const char* name) : ProfileMarker(name, "cpu") {}
+
+	ProfileMarker::ProfileMarker(const char* name, const char* category) {
+		std::lock_guard<std::mutex> lock(markerMutex);
+
+		id = (uint32_t)markerNames.size();
+		markerNames.push_back(name);
+		markerCategories.push_back(category);
+	}
+
+	ScopeTimer::ScopeTimer(const uint32_t& _marker) {
+		marker = _marker;
+		ScopeProfiler::begin(marker);
+	}
+
+	ScopeTimer::~ScopeTimer() {
+		ScopeProfiler::end(marker);
+	}
+
+	uint64_t ScopeProfiler::getTicks() {
+#if defined(_M_X64) || defined(__x86_64__)
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	double ScopeProfiler::getTicksPerMillisecond() {
+		if (ticksPerMillisecond == 0)
+			calibrate();
+
+		return ticksPerMillisecond;
+	}
+
+	void ScopeProfiler::setRecording(const bool& _recording) {
+		recording = _recording;
+	}
+
+	bool ScopeProfiler::isRecording() {
+		return recording;
+	}
+
+	void ScopeProfiler::takeRecorded(std::vector<RecordedEvent>& out) {
+		out.clear();
+		std::swap(out, recorded);
+	}
+
+	void ScopeProfiler::calibrate() {
+		if (!started)
+			init();
+
+		//the tsc rate comes from how far it got against the steady clock since init, so it only gets more exact the longer this runs
+		double milliseconds = 0;
+
+		do {
+			milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		} while (ticksPerMillisecond == 0 && milliseconds < 1);
+
+		if (milliseconds >= 1)
+			ticksPerMillisecond = (double)(getTicks() - startTicks) / milliseconds;
+	}
+
+	void ScopeProfiler::init() {
+		if (started)
+			return;
+
+		startTicks = getTicks();
+		startTime = std::chrono::steady_clock::now();
+		started = true;
+
+		setThreadName("Main");
+	}
+
+	void ScopeProfiler::setThreadName(const std::string& name) {
+		ThreadBuffer* buffer = threadBuffer != nullptr ? threadBuffer : registerThread();
+
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		buffer->name = name;
+	}
+
+	void ScopeProfiler::begin(const uint32_t& marker) {
+		push(marker, 0, getTicks());
+	}
+
+	void ScopeProfiler::end(const uint32_t& marker) {
+		push(marker, 1, getTicks());
+	}
+
+	void ScopeProfiler::collect() {
+		calibrate();
+
+		const double millisecondsPerTick = 1.0 / ticksPerMillisecond;
+
+		std::lock_guard<std::mutex> lock(bufferMutex);
+
+		frame.resize(buffers.size());
+
+		for (size_t i = 0; i < buffers.size(); ++i) {
+			ThreadBuffer& buffer = *buffers[i];
+
+			buffer.nodes.clear();
+			buffer.nodeLookup.clear();
+
+			for (size_t depth = 0; depth < buffer.open.size(); ++depth)
+				buffer.open[depth].node = -1;
+
+			const size_t head = buffer.head.load(std::memory_order_acquire);
+
+			for (size_t position = buffer.tail.load(std::memory_order_relaxed); position != head; ++position) {
+				const ProfileEvent& event = buffer.events[position & BUFFER_MASK];
+
+				if (recording)
+					recorded.push_back({ event.ticks, event.marker, (uint16_t)i, (uint16_t)event.isEnd });
+
+				if (!event.isEnd) {
+					buffer.open.push_back({ event.marker, event.ticks, 0, -1 });
+					continue;
+				}
+
+				//a dropped end leaves scopes open above the one ending here, a dropped begin leaves an end with nothing to match
+				size_t depth = buffer.open.size();
+
+				while (depth > 0 && buffer.open[depth - 1].marker != event.marker)
+					--depth;
+
+				if (depth == 0)
+					continue;
+
+				buffer.open.resize(depth);
+
+				const OpenScope& scope = buffer.open.back();
+				const uint64_t ticks = event.ticks - scope.start;
+
+				ProfileNode& node = buffer.nodes[getNode(buffer, depth - 1)];
+				node.calls += 1;
+				node.inclusive += ticks * millisecondsPerTick;
+				node.exclusive += (ticks - min(scope.childTicks, ticks)) * millisecondsPerTick;
+
+				buffer.open.pop_back();
+
+				if (!buffer.open.empty())
+					buffer.open.back().childTicks += ticks;
+			}
+
+			buffer.tail.store(head, std::memory_order_release);
+
+			frame[i].name = buffer.name;
+			std::swap(frame[i].nodes, buffer.nodes);
+			//the owner keeps counting up, only what's new gets reported
+			const size_t dropped = buffer.dropped.load(std::memory_order_relaxed);
+			frame[i].dropped = dropped - buffer.reportedDropped;
+			buffer.reportedDropped = dropped;
+		}
+	}
+
+	const std::vector<ThreadProfile>& ScopeProfiler::getFrame() {
+		return frame;
+	}
+
+	bool ScopeProfiler::getTotal(const std::string& name, size_t& calls, double& milliseconds) {
+		calls = 0;
+		milliseconds = 0;
+
+		//more than one line can use the same name
+		std::vector<bool> matches;
+
+		{
+			std::lock_guard<std::mutex> lock(markerMutex);
+			matches.resize(markerNames.size());
+
+			for (size_t i = 0; i < markerNames.size(); ++i)
+				matches[i] = markerNames[i] == name;
+		}
+
+		bool found = false;
+
+		for (size_t i = 0; i < frame.size(); ++i) {
+			for (size_t j = 0; j < frame[i].nodes.size(); ++j) {
+				const ProfileNode& node = frame[i].nodes[j];
+
+				if (node.marker >= matches.size() || !matches[node.marker])
+					continue;
+
+				calls += node.calls;
+				milliseconds += node.inclusive;
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	uint32_t ScopeProfiler::getMarkerAmount() {
+		std::lock_guard<std::mutex> lock(markerMutex);
+		return (uint32_t)markerNames.size();
+	}
+
+	std::string ScopeProfiler::getMarkerName(const uint32_t& marker) {
+		std::lock_guard<std::mutex> lock(markerMutex);
+		return marker < markerNames.size() ? markerNames[marker] : std::string();
+	}
+
+	std::string ScopeProfiler::getMarkerCategory(const uint32_t& marker) {
+		std::lock_guard<std::mutex> lock(markerMutex);
+		return marker < markerCategories.size() ? markerCategories[marker] : std::string();
+	}
+
+	void ScopeProfiler::logFrame() {
+		for (size_t i = 0; i < frame.size(); ++i) {
+			if (frame[i].nodes.empty())
+				continue;
+
+			Debug::log(frame[i].name + (frame[i].dropped > 0 ? " (" + std::to_string(frame[i].dropped) + " events dropped)" : ""));
+
+			for (size_t j = 0; j < frame[i].nodes.size(); ++j) {
+				if (frame[i].nodes[j].parent < 0)
+					logNode(frame[i], (int)j, 1);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,120 @@
+#ifndef HFR_SCOPE_PROFILER_HEADER_INCLUDE
+#define HFR_SCOPE_PROFILER_HEADER_INCLUDE
+
+#include HFR_API
+
+#define HFR_PROFILE_CONCAT_INNER(a, b) a##b
+#define HFR_PROFILE_CONCAT(a, b) HFR_PROFILE_CONCAT_INNER(a, b)
+
+#define HFR_PROFILE_SCOPE_INNER(name, category, counter) static const HFR::ProfileMarker HFR_PROFILE_CONCAT(hfrProfileMarker, counter)(name, category); \
+	HFR::ScopeTimer HFR_PROFILE_CONCAT(hfrProfileScope, counter)(HFR_PROFILE_CONCAT(hfrProfileMarker, counter).id)
+
+//times the rest of the enclosing scope, name has to be a string literal, the marker gets its id the first time the line runs and never looks it up again
+#define ProfileScope(name) HFR_PROFILE_SCOPE_INNER(name, "cpu", __COUNTER__)
+//the same but for scopes that hand work to the gpu and for job system jobs, traces show them apart
+#define ProfileGpu(name) HFR_PROFILE_SCOPE_INNER(name, "gpu", __COUNTER__)
+#define ProfileJob(name) HFR_PROFILE_SCOPE_INNER(name, "job", __COUNTER__)
+
+namespace HFR {
+
+	//one named spot in the code that gets profiled, made once per ProfileScope line
+	class DLL_API ProfileMarker {
+	public:
+		uint32_t id;
+
+		ProfileMarker(const char* name);
+		ProfileMarker(const char* name, const char* category);
+	};
+
+	//writes a begin event when it's made and an end event when it goes out of scope
+	class DLL_API ScopeTimer {
+	private:
+		uint32_t marker;
+
+	public:
+		ScopeTimer(const uint32_t& marker);
+		ScopeTimer(const ScopeTimer&) = delete;
+		ScopeTimer& operator=(const ScopeTimer&) = delete;
+		~ScopeTimer();
+	};
+
+	//one spot in a threads call tree, a marker reached through a different parent is a different node
+	struct DLL_API ProfileNode {
+		uint32_t marker;
+		//index of the parent in the same threads nodes, -1 for top level scopes
+		int parent;
+		size_t calls;
+		//milliseconds, exclusive is inclusive without the time spent in child scopes
+		double inclusive;
+		double exclusive;
+	};
+
+	struct DLL_API ThreadProfile {
+		std::string name;
+		//parents always come before their children
+		std::vector<ProfileNode> nodes;
+		//events that didn't fit in the threads buffer since the last collect
+		size_t dropped;
+	};
+
+	//a begin or an end the way it was written, only kept while recording
+	struct DLL_API RecordedEvent {
+		uint64_t ticks;
+		uint32_t marker;
+		//index into getFrame
+		uint16_t thread;
+		uint16_t isEnd;
+	};
+
+	//every thread writes begin and end events into its own ring buffer with nothing but a timestamp and the marker id, no locks and no strings,
+	//collect (once a frame from Debug::update) reads the buffers on the main thread and builds the call trees, scopes count in the frame they end in
+	class DLL_API ScopeProfiler {
+	private:
+		static std::vector<ThreadProfile> frame;
+		static double ticksPerMillisecond;
+
+		static bool recording;
+		static std::vector<RecordedEvent> recorded;
+
+		static void calibrate();
+
+	public:
+		//names the calling thread and sets the timer up, main thread
+		static void init();
+
+		//shows up in the results instead of "Thread N"
+		static void setThreadName(const std::string& name);
+
+		//what ScopeTimer calls, nothing else should need to
+		static void begin(const uint32_t& marker);
+		static void end(const uint32_t& marker);
+
+		//the timestamps events get, tsc ticks on x86 and nanoseconds everywhere else
+		static uint64_t getTicks();
+		static double getTicksPerMillisecond();
+
+		//while on collect also keeps every event it reads, in order for each thread
+		static void setRecording(const bool& recording);
+		static bool isRecording();
+		//moves out everything recorded since the last call
+		static void takeRecorded(std::vector<RecordedEvent>& out);
+
+		//aggregates everything every thread did since the last collect
+		static void collect();
+		//per thread, as of the last collect
+		static const std::vector<ThreadProfile>& getFrame();
+		//the summed up calls and time of every node with that marker on every thread, false when nothing with that name ran
+		static bool getTotal(const std::string& name, size_t& calls, double& milliseconds);
+
+		static uint32_t getMarkerAmount();
+		static std::string getMarkerName(const uint32_t& marker);
+		//"cpu", "gpu" or "job"
+		static std::string getMarkerCategory(const uint32_t& marker);
+
+		//prints the last frames call trees
+		static void logFrame();
+	};
+
+}
+
+#endif
@@ -1,28 +1,200 @@
 #include "hfpch.h"
 
+#if _WIN64
+//older sdks don't have it, windows versions that don't know it fail to make the timer and get a normal one
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
 namespace HFR {
 
+	namespace {
+#if _WIN64
+		HANDLE waitTimer = NULL;
+#endif
+
+		//per thread, with a pipelined renderer the steps run on the simulation thread while the main thread keeps its frame delta
+		thread_local bool inFixedStep = false;
+	}
+
 	double Time::lastFrameTime = 0;
 	float Time::frameTime = 0;
 	float Time::lastFPS = 1;
 
+	std::function<double()> Time::clock;
+
+	double Time::fixedDeltaTime = 1.0 / HFR_FIXED_RATE;
+	double Time::accumulator = 0;
+	double Time::fixedTime = 0;
+	double Time::droppedTime = 0;
+	size_t Time::fixedSteps = 0;
+
+	double Time::targetFrameTime = 0;
+	double Time::nextFrameStart = 0;
+
 	double Time::getTime() {
+		if (clock)
+			return clock();
+
 		return (glfwGetTime() * 1000);
 	}
 
+	double Time::getFrameStartTime() {
+		return lastFrameTime;
+	}
+
 	void Time::update() {
-		frameTime = (float)((getTime() - Time::lastFrameTime) / 1000);
-		lastFrameTime = getTime();
+		const double now = getTime();
+
+		frameTime = (float)((now - Time::lastFrameTime) / 1000);
+		lastFrameTime = now;
+
+		//spiral of death clamp, a frame can only ever ask for so many steps or slow steps would make every next frame slower
+		const double maxTime = fixedDeltaTime * HFR_MAX_FIXED_STEPS;
+		const double elapsed = (double)frameTime;
+
+		if (elapsed > maxTime) {
+			droppedTime += elapsed - maxTime;
+			accumulator += maxTime;
+		}
+		else if (elapsed > 0)
+			accumulator += elapsed;
 	}
 
 	float Time::getDeltaTime() {
-		return frameTime;
+		return inFixedStep ? (float)fixedDeltaTime : frameTime;
 	}
 
 	float Time::getFPS() {
-		lastFPS = HMath::lerp(lastFPS, 1 / getDeltaTime(), 0.05f);
+		lastFPS = HMath::lerp(lastFPS, 1 / frameTime, 0.05f);
 
 		return lastFPS;
 	}
 
+	void Time::setClock(const std::function<double()>& _clock) {
+		clock = _clock;
+		lastFrameTime = getTime();
+	}
+
+	void Time::setFixedRate(const double& hz) {
+		if (hz <= 0) {
+			Debug::systemErr("Couldn't set the fixed rate to {} steps a second", hz);
+			return;
+		}
+
+		//keeps the time that's already accumulated, only the step size changes
+		fixedDeltaTime = 1.0 / hz;
+	}
+
+	double Time::getFixedRate() {
+		return 1.0 / fixedDeltaTime;
+	}
+
+	float Time::getFixedDeltaTime() {
+		return (float)fixedDeltaTime;
+	}
+
+	bool Time::stepFixed() {
+		if (accumulator < fixedDeltaTime)
+			return false;
+
+		accumulator -= fixedDeltaTime;
+		fixedTime += fixedDeltaTime;
+		fixedSteps += 1;
+
+		return true;
+	}
+
+	float Time::getInterpolationAlpha() {
+		return (float)min(accumulator / fixedDeltaTime, 1.0);
+	}
+
+	double Time::getFixedTime() {
+		return fixedTime;
+	}
+
+	size_t Time::getFixedSteps() {
+		return fixedSteps;
+	}
+
+	double Time::getDroppedTime() {
+		return droppedTime;
+	}
+
+	void Time::resetFixedSteps() {
+		accumulator = 0;
+		fixedTime = 0;
+		droppedTime = 0;
+		fixedSteps = 0;
+	}
+
+	FixedStepScope::FixedStepScope() : previous(inFixedStep) {
+		inFixedStep = true;
+	}
+
+	FixedStepScope::~FixedStepScope() {
+		inFixedStep = previous;
+	}
+
+	void Time::setTargetFps(const int& fps) {
+		const double frame = fps > 0 ? 1000.0 / fps : 0;
+
+		//gets called every frame by games that limit it in their loop, only a new rate starts the pacing over
+		if (frame != targetFrameTime) {
+			targetFrameTime = frame;
+			nextFrameStart = 0;
+		}
+	}
+
+	void Time::sleep(const double& milliseconds) {
+#if _WIN64
+		if (waitTimer == NULL)
+			waitTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+		if (waitTimer == NULL)
+			waitTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+
+		if (waitTimer == NULL) {
+			Sleep((DWORD)milliseconds);
+			return;
+		}
+
+		//negative is relative, in 100 nanosecond units
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)(milliseconds * 10000.0);
+
+		if (SetWaitableTimer(waitTimer, &dueTime, 0, NULL, NULL, FALSE))
+			WaitForSingleObject(waitTimer, INFINITE);
+#else
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(milliseconds));
+#endif
+	}
+
+	void Time::waitForFrame() {
+		//a made up clock doesn't move while sleeping
+		if (targetFrameTime <= 0 || clock)
+			return;
+
+		ProfileMethod("Frame pacing");
+
+		const double now = getTime();
+
+		if (nextFrameStart > now) {
+			const double remaining = nextFrameStart - now;
+
+			if (remaining > HFR_FRAME_SPIN_MILLISECONDS)
+				sleep(remaining - HFR_FRAME_SPIN_MILLISECONDS);
+
+			while (getTime() < nextFrameStart)
+				_mm_pause();
+		}
+
+		//frames keep their spacing after one that ran a bit long, but one that ran more than a whole frame over doesn't make the next ones rush to catch up
+		if (nextFrameStart == 0 || now - nextFrameStart > targetFrameTime)
+			nextFrameStart = now + targetFrameTime;
+		else
+			nextFrameStart += targetFrameTime;
+	}
+
 }
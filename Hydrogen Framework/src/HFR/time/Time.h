@@ -1,4 +1,3 @@
-
 #ifndef HFR_TIME_INCLUDE
 #define HFR_TIME_INCLUDE
 
@@ -6,22 +5,81 @@
 
 namespace HFR {
 
+	//frame timing, the fixed step simulation accumulator and frame pacing, Engine::updateEngine drives all of it once a frame
 	class DLL_API Time {
 	private:
 		static double lastFrameTime;
 		static float frameTime;
 
 		static float lastFPS;
+
+		//milliseconds, glfw unless something else got set
+		static std::function<double()> clock;
+
+		//fixed steps, in seconds
+		static double fixedDeltaTime;
+		static double accumulator;
+		static double fixedTime;
+		static double droppedTime;
+		static size_t fixedSteps;
+
+		//milliseconds, 0 when the frame rate isn't limited
+		static double targetFrameTime;
+		static double nextFrameStart;
+
+		static void sleep(const double& milliseconds);
+
 	public:
 		static void update();
 
 		static double getTime();
+		//what the clock said when the current frame started, in milliseconds
+		static double getFrameStartTime();
 
+		//the time since the last frame in seconds, inside a fixed step it's the fixed delta
 		static float getDeltaTime();
 
 		static float getFPS();
+
+		//replaces the clock getTime reads (in milliseconds), for running frames headless with made up times, an empty one goes back to glfw
+		static void setClock(const std::function<double()>& clock);
+
+		//steps a second, HFR_FIXED_RATE by default
+		static void setFixedRate(const double& hz);
+		static double getFixedRate();
+		static float getFixedDeltaTime();
+		//call it in a loop, it's true once for every fixed step that fits into the time accumulated so far, put a FixedStepScope in the loop
+		static bool stepFixed();
+		//how far between the last fixed step and the next one this frame is (0 to 1), Scene::extract draws interpolated transforms that far
+		//between their last two steps and game code keeping two states of something can do the same
+		static float getInterpolationAlpha();
+		//seconds simulated with fixed steps
+		static double getFixedTime();
+		static size_t getFixedSteps();
+		//seconds that got thrown away because frames took longer than HFR_MAX_FIXED_STEPS steps
+		static double getDroppedTime();
+		//starts the simulation clock over from 0 with nothing accumulated, so runs fed the same frames step the same way
+		static void resetFixedSteps();
+
+		//0 to stop limiting it
+		static void setTargetFps(const int& fps);
+		//sleeps until the next frame is due and spins the last bit, a sleep alone wakes up too late too often
+		static void waitForFrame();
+	};
+
+	//getDeltaTime gives the fixed delta on this thread for as long as it's around, a step that breaks out of the loop early
+	//or throws still ends up back on the frame delta
+	class DLL_API FixedStepScope {
+	private:
+		bool previous;
+
+	public:
+		FixedStepScope();
+		FixedStepScope(const FixedStepScope&) = delete;
+		FixedStepScope& operator=(const FixedStepScope&) = delete;
+		~FixedStepScope();
 	};
 
 }
 
-#endif
\ No newline at end of file
+#endif
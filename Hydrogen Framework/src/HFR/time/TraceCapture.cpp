@@ -0,0 +1,502 @@
+#include "hfpch.h"
+#include HFR_TRACE_CAPTURE
+#include HFR_ALLOCATION_TRACKER
+#include HFR_QUAD_BATCHER
+#include HFR_TEXT_BATCHER
+#include HFR_JOB_SYSTEM
+#include HFR_GPU_PROFILER
+#include HFR_INPUT
+#include HFR_VIRTUAL_FILE_SYSTEM
+#include HFR_UTIL
+
+namespace HFR {
+
+	namespace {
+		void writeVarint(std::vector<unsigned char>& out, uint64_t value) {
+			while (value >= 0x80) {
+				out.push_back((unsigned char)(value | 0x80));
+				value >>= 7;
+			}
+
+			out.push_back((unsigned char)value);
+		}
+
+		bool readVarint(const unsigned char*& data, const unsigned char* end, uint64_t& value) {
+			value = 0;
+
+			for (int shift = 0; shift < 64; shift += 7) {
+				if (data == end)
+					return false;
+
+				const unsigned char byte = *data++;
+				value |= (uint64_t)(byte & 0x7f) << shift;
+
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+
+			return false;
+		}
+
+		//small negative deltas stay small
+		uint64_t zigzag(const int64_t& value) {
+			return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+		}
+
+		int64_t unzigzag(const uint64_t& value) {
+			return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+		}
+
+		void writeDouble(std::vector<unsigned char>& out, const double& value) {
+			unsigned char bytes[sizeof(double)];
+			std::memcpy(bytes, &value, sizeof(double));
+			out.insert(out.end(), bytes, bytes + sizeof(double));
+		}
+
+		bool readDouble(const unsigned char*& data, const unsigned char* end, double& value) {
+			if ((size_t)(end - data) < sizeof(double))
+				return false;
+
+			std::memcpy(&value, data, sizeof(double));
+			data += sizeof(double);
+			return true;
+		}
+
+		void writeString(std::vector<unsigned char>& out, const std::string& value) {
+			writeVarint(out, value.size());
+			out.insert(out.end(), value.begin(), value.end());
+		}
+
+		bool readString(const unsigned char*& data, const unsigned char* end, std::string& value) {
+			uint64_t size = 0;
+
+			if (!readVarint(data, end, size) || size > (uint64_t)(end - data))
+				return false;
+
+			value.assign((const char*)data, (size_t)size);
+			data += size;
+			return true;
+		}
+
+		void writeStrings(std::vector<unsigned char>& out, const std::vector<std::string>& values) {
+			writeVarint(out, values.size());
+
+			for (size_t i = 0; i < values.size(); ++i)
+				writeString(out, values[i]);
+		}
+
+		bool readStrings(const unsigned char*& data, const unsigned char* end, std::vector<std::string>& values) {
+			uint64_t amount = 0;
+
+			if (!readVarint(data, end, amount) || amount > (uint64_t)(end - data))
+				return false;
+
+			values.resize((size_t)amount);
+
+			for (size_t i = 0; i < values.size(); ++i) {
+				if (!readString(data, end, values[i]))
+					return false;
+			}
+
+			return true;
+		}
+
+		std::string escapeJson(const std::string& value) {
+			std::string out;
+			out.reserve(value.size());
+
+			for (size_t i = 0; i < value.size(); ++i) {
+				const char character = value[i];
+
+				if (character == '"' || character == '\\') {
+					out += '\\';
+					out += character;
+				}
+				else if ((unsigned char)character < 0x20) {
+					char escaped[8];
+					snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)character);
+					out += escaped;
+				}
+				else
+					out += character;
+			}
+
+			return out;
+		}
+
+		std::string toJsonNumber(const double& value) {
+			char out[32];
+			snprintf(out, sizeof(out), "%.3f", value);
+			return out;
+		}
+
+		std::string getName(const std::vector<std::string>& names, const size_t& index, const std::string& fallback) {
+			return index < names.size() ? names[index] : fallback;
+		}
+	}
+
+	bool TraceData::writeJson(const std::string& path) const {
+		ProfileMethod("Trace json write");
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't create trace: {}", path);
+			return false;
+		}
+
+		//everything is relative to whatever happened first
+		uint64_t base = frames.empty() ? 0 : frames[0].start;
+
+		if (!frames.empty()) {
+			for (size_t i = 0; i < frames[0].events.size(); ++i)
+				base = min(base, frames[0].events[i].ticks);
+		}
+
+		const double microsecondsPerTick = 1000.0 / ticksPerMillisecond;
+		auto toMicroseconds = [&](const uint64_t& ticks) { return toJsonNumber((double)(ticks - base) * microsecondsPerTick); };
+
+		//the frames get their own track after the threads
+		const size_t frameTrack = threadNames.size();
+
+		std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Hydrogen Framework\"}}";
+
+		for (size_t i = 0; i <= frameTrack; ++i) {
+			const std::string name = i == frameTrack ? "Frames" : threadNames[i];
+			out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(i) + ",\"args\":{\"name\":\"" + escapeJson(name) + "\"}}";
+		}
+
+		for (size_t i = 0; i < frames.size(); ++i) {
+			const TraceFrame& frame = frames[i];
+
+			out += ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(frameTrack) + ",\"ts\":" + toMicroseconds(frame.start) +
+				",\"dur\":" + toJsonNumber((double)(frame.end - frame.start) * microsecondsPerTick) + ",\"args\":{\"frame\":" + std::to_string(i) + "}}";
+
+			for (size_t j = 0; j < frame.events.size(); ++j) {
+				const RecordedEvent& event = frame.events[j];
+
+				out += ",\n{\"name\":\"" + escapeJson(getName(markerNames, event.marker, "Unknown")) + "\",\"cat\":\"" + escapeJson(getName(markerCategories, event.marker, "cpu")) +
+					"\",\"ph\":\"" + (event.isEnd ? "E" : "B") + "\",\"pid\":1,\"tid\":" + std::to_string(event.thread) + ",\"ts\":" + toMicroseconds(event.ticks) + "}";
+			}
+
+			for (size_t j = 0; j < frame.counters.size(); ++j) {
+				out += ",\n{\"name\":\"" + escapeJson(getName(counterNames, frame.counters[j].name, "Unknown")) + "\",\"cat\":\"counter\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" +
+					toMicroseconds(frame.start) + ",\"args\":{\"value\":" + toJsonNumber(frame.counters[j].value) + "}}";
+			}
+
+			//keeps the string from growing with the whole capture
+			file.write(out.data(), out.size());
+			out.clear();
+		}
+
+		out += "\n]}\n";
+		file.write(out.data(), out.size());
+
+		return true;
+	}
+
+	bool TraceData::writeBinary(const std::string& path) const {
+		ProfileMethod("Trace binary write");
+
+		std::vector<unsigned char> out;
+		out.insert(out.end(), { 'H', 'T', 'R', 'C' });
+
+		writeVarint(out, HFR_TRACE_VERSION);
+		writeDouble(out, ticksPerMillisecond);
+		writeStrings(out, threadNames);
+		writeStrings(out, markerNames);
+		writeStrings(out, markerCategories);
+		writeStrings(out, counterNames);
+		writeVarint(out, frames.size());
+
+		for (size_t i = 0; i < frames.size(); ++i) {
+			const TraceFrame& frame = frames[i];
+
+			writeVarint(out, frame.start);
+			writeVarint(out, frame.end - frame.start);
+			writeVarint(out, frame.counters.size());
+
+			for (size_t j = 0; j < frame.counters.size(); ++j) {
+				writeVarint(out, frame.counters[j].name);
+				writeDouble(out, frame.counters[j].value);
+			}
+
+			writeVarint(out, frame.events.size());
+
+			//ticks go in as the difference to the event before, which is a couple of bytes instead of eight
+			uint64_t previous = frame.start;
+
+			for (size_t j = 0; j < frame.events.size(); ++j) {
+				const RecordedEvent& event = frame.events[j];
+
+				writeVarint(out, event.thread);
+				writeVarint(out, ((uint64_t)event.marker << 1) | (event.isEnd ? 1 : 0));
+				writeVarint(out, zigzag((int64_t)(event.ticks - previous)));
+
+				previous = event.ticks;
+			}
+		}
+
+		std::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Couldn't create trace: {}", path);
+			return false;
+		}
+
+		file.write((const char*)out.data(), out.size());
+		return true;
+	}
+
+	bool TraceData::readBinary(const std::string& path) {
+		FileData file = VirtualFileSystem::read(path);
+
+		if (!file.isValid()) {
+			Debug::systemErr("Couldn't open trace: {}", path);
+			return false;
+		}
+
+		const unsigned char* data = file.getData();
+		const unsigned char* end = data + file.getSize();
+
+		uint64_t version = 0;
+		uint64_t frameAmount = 0;
+
+		bool valid = file.getSize() >= 4 && std::memcmp(data, "HTRC", 4) == 0;
+		data += valid ? 4 : 0;
+
+		valid = valid && readVarint(data, end, version) && version == HFR_TRACE_VERSION && readDouble(data, end, ticksPerMillisecond) &&
+			readStrings(data, end, threadNames) && readStrings(data, end, markerNames) && readStrings(data, end, markerCategories) &&
+			readStrings(data, end, counterNames) && readVarint(data, end, frameAmount) && frameAmount <= (uint64_t)(end - data);
+
+		if (valid)
+			frames.resize((size_t)frameAmount);
+
+		for (size_t i = 0; valid && i < frames.size(); ++i) {
+			TraceFrame& frame = frames[i];
+
+			uint64_t duration = 0;
+			uint64_t amount = 0;
+
+			valid = readVarint(data, end, frame.start) && readVarint(data, end, duration) && readVarint(data, end, amount) && amount <= (uint64_t)(end - data);
+			frame.end = frame.start + duration;
+
+			if (valid)
+				frame.counters.resize((size_t)amount);
+
+			for (size_t j = 0; valid && j < frame.counters.size(); ++j) {
+				uint64_t name = 0;
+				valid = readVarint(data, end, name) && readDouble(data, end, frame.counters[j].value);
+				frame.counters[j].name = (uint32_t)name;
+			}
+
+			valid = valid && readVarint(data, end, amount) && amount <= (uint64_t)(end - data);
+
+			if (valid)
+				frame.events.resize((size_t)amount);
+
+			uint64_t previous = frame.start;
+
+			for (size_t j = 0; valid && j < frame.events.size(); ++j) {
+				RecordedEvent& event = frame.events[j];
+
+				uint64_t thread = 0;
+				uint64_t marker = 0;
+				uint64_t delta = 0;
+
+				valid = readVarint(data, end, thread) && readVarint(data, end, marker) && readVarint(data, end, delta);
+
+				event.thread = (uint16_t)thread;
+				event.marker = (uint32_t)(marker >> 1);
+				event.isEnd = (uint16_t)(marker & 1);
+				event.ticks = previous + (uint64_t)unzigzag(delta);
+
+				previous = event.ticks;
+			}
+		}
+
+		if (!valid) {
+			Debug::systemErr("Trace is corrupt or from a different version: {}", path);
+			frames.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	std::deque<TraceFrame> TraceCapture::frames;
+	size_t TraceCapture::framesLeft = 0;
+	uint64_t TraceCapture::frameStart = 0;
+	size_t TraceCapture::captureAmount = 0;
+	std::vector<std::string> TraceCapture::counterNames;
+	std::vector<TraceCounter> TraceCapture::counters;
+	size_t TraceCapture::lastAllocations = 0;
+	size_t TraceCapture::lastAllocatedBytes = 0;
+	std::string TraceCapture::lastPath;
+	std::atomic<size_t> TraceCapture::writing(0);
+
+	std::string TraceCapture::outputPath = "Captures/frame";
+	int TraceCapture::hotkey = GLFW_KEY_F11;
+	size_t TraceCapture::hotkeyFrames = HFR_TRACE_CAPTURE_FRAMES;
+	float TraceCapture::spikeThreshold = 0;
+	size_t TraceCapture::spikeFrames = HFR_TRACE_CAPTURE_FRAMES;
+
+	void TraceCapture::capture(const size_t& frameAmount) {
+		if (frameAmount == 0)
+			return;
+
+		//whatever spike recording kept around isn't part of this
+		frames.clear();
+		framesLeft = frameAmount;
+
+		ScopeProfiler::setRecording(true);
+	}
+
+	bool TraceCapture::isCapturing() {
+		return framesLeft > 0;
+	}
+
+	bool TraceCapture::isWriting() {
+		return writing.load() > 0;
+	}
+
+	std::string TraceCapture::getLastPath() {
+		return lastPath;
+	}
+
+	uint32_t TraceCapture::getCounterName(const std::string& name) {
+		for (size_t i = 0; i < counterNames.size(); ++i) {
+			if (counterNames[i] == name)
+				return (uint32_t)i;
+		}
+
+		counterNames.push_back(name);
+		return (uint32_t)counterNames.size() - 1;
+	}
+
+	void TraceCapture::setCounter(const std::string& name, const double& value) {
+		if (ScopeProfiler::isRecording())
+			counters.push_back({ getCounterName(name), value });
+	}
+
+	void TraceCapture::update() {
+		const uint64_t now = ScopeProfiler::getTicks();
+
+		//collect just read everything from the frame that ends here
+		if (ScopeProfiler::isRecording() && frameStart != 0) {
+			const size_t allocations = AllocationTracker::getAllocations();
+			const size_t allocatedBytes = AllocationTracker::getAllocatedBytes();
+
+			setCounter("Quad draw calls", (double)QuadBatcher::getDrawCalls());
+			setCounter("Text draw calls", (double)TextBatcher::getDrawCalls());
+
+			//without HFR_TRACK_ALLOCATIONS these would be a flat 0 that looks like a real number
+			if (AllocationTracker::isTracking()) {
+				setCounter("Allocations", (double)(allocations - lastAllocations));
+				setCounter("Allocated KB", (double)(allocatedBytes - lastAllocatedBytes) / 1024.0);
+			}
+
+			TraceFrame frame;
+			frame.start = frameStart;
+			frame.end = now;
+			ScopeProfiler::takeRecorded(frame.events);
+			std::swap(frame.counters, counters);
+
+			//gpu scopes come back a couple of frames late, their timestamps still put them where they happened
+			std::vector<RecordedEvent> gpuEvents;
+			GpuProfiler::takeRecorded(gpuEvents);
+			frame.events.insert(frame.events.end(), gpuEvents.begin(), gpuEvents.end());
+
+			frames.push_back(std::move(frame));
+
+			const double milliseconds = (double)(now - frameStart) / ScopeProfiler::getTicksPerMillisecond();
+
+			if (framesLeft > 0) {
+				framesLeft -= 1;
+
+				if (framesLeft == 0)
+					finish("requested");
+			}
+			else if (spikeThreshold > 0) {
+				while (frames.size() > spikeFrames)
+					frames.pop_front();
+
+				//only once the frames before it are there too, which also skips the slow frames while everything loads
+				if (milliseconds > spikeThreshold && frames.size() == spikeFrames)
+					finish(std::to_string(milliseconds) + " ms frame");
+			}
+			else
+				frames.clear();
+		}
+
+		//collect already ran, so a capture from the hotkey starts with the next frame
+		if (hotkey != GLFW_KEY_UNKNOWN && Input::getKeyDown(hotkey) && framesLeft == 0)
+			capture(hotkeyFrames);
+
+		counters.clear();
+		lastAllocations = AllocationTracker::getAllocations();
+		lastAllocatedBytes = AllocationTracker::getAllocatedBytes();
+
+		ScopeProfiler::setRecording(framesLeft > 0 || spikeThreshold > 0);
+		frameStart = now;
+	}
+
+	void TraceCapture::finish(const std::string& reason) {
+		std::shared_ptr<TraceData> data(new TraceData());
+
+		data->ticksPerMillisecond = ScopeProfiler::getTicksPerMillisecond();
+		data->counterNames = counterNames;
+
+		const std::vector<ThreadProfile>& threads = ScopeProfiler::getFrame();
+
+		for (size_t i = 0; i < threads.size(); ++i)
+			data->threadNames.push_back(threads[i].name);
+
+		const uint32_t markerAmount = ScopeProfiler::getMarkerAmount();
+
+		for (uint32_t i = 0; i < markerAmount; ++i) {
+			data->markerNames.push_back(ScopeProfiler::getMarkerName(i));
+			data->markerCategories.push_back(ScopeProfiler::getMarkerCategory(i));
+		}
+
+		data->frames.assign(std::make_move_iterator(frames.begin()), std::make_move_iterator(frames.end()));
+		frames.clear();
+
+		//the gpu gets its own track after the threads
+		if (GpuProfiler::isEnabled()) {
+			const uint16_t gpuThread = (uint16_t)data->threadNames.size();
+			data->threadNames.push_back("GPU");
+
+			for (size_t i = 0; i < data->frames.size(); ++i) {
+				for (size_t j = 0; j < data->frames[i].events.size(); ++j) {
+					if (data->frames[i].events[j].thread == HFR_GPU_TRACE_THREAD)
+						data->frames[i].events[j].thread = gpuThread;
+				}
+			}
+		}
+
+		const std::string path = outputPath + "_" + std::to_string(captureAmount);
+		captureAmount += 1;
+		lastPath = path;
+
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+		Debug::systemLog("Writing a {} frame capture ({}) to: {}", data->frames.size(), reason, path);
+
+		//the json for a few seconds of frames takes a while, the game keeps going meanwhile
+		writing.fetch_add(1);
+
+		JobSystem::run([data, path]() {
+			if (data->writeBinary(path + ".htrace") && data->writeJson(path + ".json"))
+				Debug::systemSuccess("Wrote capture: {}", path);
+
+			writing.fetch_sub(1);
+		});
+	}
+
+	bool TraceCapture::convert(const std::string& binaryPath, const std::string& jsonPath) {
+		TraceData data;
+		return data.readBinary(binaryPath) && data.writeJson(jsonPath);
+	}
+
+}
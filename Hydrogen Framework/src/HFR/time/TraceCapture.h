@@ -0,0 +1,91 @@
+#ifndef HFR_TRACE_CAPTURE_HEADER_INCLUDE
+#define HFR_TRACE_CAPTURE_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_SCOPE_PROFILER
+
+namespace HFR {
+
+	struct DLL_API TraceCounter {
+		//index into TraceData::counterNames
+		uint32_t name;
+		double value;
+	};
+
+	struct DLL_API TraceFrame {
+		//profiler ticks
+		uint64_t start;
+		uint64_t end;
+		std::vector<RecordedEvent> events;
+		std::vector<TraceCounter> counters;
+	};
+
+	//everything one capture holds, the same thing gets written as chrome trace json and as a .htrace file
+	struct DLL_API TraceData {
+		double ticksPerMillisecond = 1;
+		std::vector<std::string> threadNames;
+		//indexed by marker id
+		std::vector<std::string> markerNames;
+		std::vector<std::string> markerCategories;
+		std::vector<std::string> counterNames;
+		std::vector<TraceFrame> frames;
+
+		//trace event format, opens in chrome://tracing and perfetto, timestamps are microseconds from the first frame
+		bool writeJson(const std::string& path) const;
+		//varints and tick deltas, a lot smaller than the json and what convert reads
+		bool writeBinary(const std::string& path) const;
+		bool readBinary(const std::string& path);
+	};
+
+	//records whole frames of profiler scopes (cpu, gpu submissions and jobs) with per frame counters and writes them out,
+	//a capture starts from capture, the hotkey, or a frame taking longer than spikeThreshold (the frames leading up to it get written out along with it)
+	class DLL_API TraceCapture {
+	private:
+		static std::deque<TraceFrame> frames;
+		static size_t framesLeft;
+		static uint64_t frameStart;
+		static size_t captureAmount;
+
+		static std::vector<std::string> counterNames;
+		static std::vector<TraceCounter> counters;
+		static size_t lastAllocations;
+		static size_t lastAllocatedBytes;
+		static std::string lastPath;
+		//captures handed to a job and not written out yet
+		static std::atomic<size_t> writing;
+
+		static uint32_t getCounterName(const std::string& name);
+		//hands the frames to a job that writes them out
+		static void finish(const std::string& reason);
+
+	public:
+		//captures end up as outputPath_0.json and outputPath_0.htrace, then _1 and so on
+		static std::string outputPath;
+		//a GLFW_KEY_ that starts a capture of hotkeyFrames, GLFW_KEY_UNKNOWN for none
+		static int hotkey;
+		static size_t hotkeyFrames;
+		//milliseconds, 0 turns spike captures off, while it's on the last spikeFrames frames are always being recorded
+		static float spikeThreshold;
+		static size_t spikeFrames;
+
+		//records the next frames frames and writes them out
+		static void capture(const size_t& frames);
+		static bool isCapturing();
+		//true until every finished capture is on disk, JobSystem::close finishes them anyway but anything reading the files has to wait on this
+		static bool isWriting();
+		//where the last capture went without the extension, empty before the first one
+		static std::string getLastPath();
+
+		//shows up as a counter track in the frame it's set in, only kept while recording
+		static void setCounter(const std::string& name, const double& value);
+
+		//once a frame after Debug::update
+		static void update();
+
+		//turns a .htrace into chrome trace json
+		static bool convert(const std::string& binaryPath, const std::string& jsonPath);
+	};
+
+}
+
+#endif
@@ -9,40 +9,73 @@ namespace HFR {
 	int Debug::succeedLogMode = HFR_LOG_ON_SUCCESS;
 	int Debug::failLogMode = HFR_LOG_ON_FAIL;
 
+	namespace {
+		//the Debug calls aren't rate limited, they can't tell apart where they got called from
+		void write(LogSite& site, const std::string& message, const DebugColor& color) {
+			if (site.allow())
+				Logger::writeColored(site, color, message);
+		}
+
+		std::string toString(const Vec3f& in) {
+			std::string x = std::to_string(in.x);
+			std::string y = std::to_string(in.y);
+			std::string z = std::to_string(in.z);
+
+			return "Vec3f: [" + x + "][" + y + "][" + z + "]";
+		}
+	}
+
+	LogSite& Debug::getLogSite(const LogLevel& level) {
+		static LogSite trace(LogLevel::Trace, "Debug", "{}", DebugColor::White, 0);
+		static LogSite info(LogLevel::Info, "Debug", "{}", DebugColor::Yellow, 0);
+		static LogSite success(LogLevel::Success, "Debug", "{}", DebugColor::LightGreen, 0);
+		static LogSite error(LogLevel::Error, "Debug", "{}", DebugColor::Red, 0);
+
+		switch (level) {
+		case LogLevel::Info:
+			return info;
+		case LogLevel::Success:
+			return success;
+		case LogLevel::Warning:
+		case LogLevel::Error:
+			return error;
+		default:
+			return trace;
+		}
+	}
+
 	void Debug::log(const std::string& message) {
-		std::string out = message + "\n";
-		std::cout << out;
+		write(getLogSite(LogLevel::Trace), message, DebugColor::White);
 	}
 
 	void Debug::log(const std::string& message, const DebugColor& color) {
-		setTextColor(color);
-		std::string out = message + "\n";
-		std::cout << out;
-		resetTextColor();
+		write(getLogSite(LogLevel::Trace), message, color);
+	}
+
+	void Debug::log(const char* message, const DebugColor& color) {
+		log(std::string(message), color);
 	}
 
 	void Debug::log(const char& in) {
-		std::cout << in << std::endl;
+		log(std::string(1, in));
 	}
 
 	void Debug::log(const double& in) {
-		std::cout << std::fixed;
-		std::cout << in << std::endl;
+		log(std::to_string(in));
 	}
 
 	void Debug::log(const int& in) {
-		std::cout << std::fixed;
-		std::cout << in << std::endl;
+		log(std::to_string(in));
 	}
 
 	void Debug::logScientific(const double& in) {
-		std::cout << std::scientific;
-		std::cout << in << std::endl;
+		char out[32];
+		snprintf(out, sizeof(out), "%e", in);
+		log(std::string(out));
 	}
 
 	void Debug::logScientific(const int& in) {
-		std::cout << std::scientific;
-		std::cout << in << std::endl;
+		logScientific((double)in);
 	}
 
 	void Debug::log(const std::vector<float>& array) {
@@ -52,25 +85,21 @@ namespace HFR {
 	}
 
 	void Debug::log(const Vec3f& in) {
-		std::string x = std::to_string(in.x);
-		std::string y = std::to_string(in.y);
-		std::string z = std::to_string(in.z);
-
-		std::cout << "Vec3f: [" + x + "][" + y + "][" + z + "]\n";
+		log(toString(in));
 	}
 
 	void Debug::log(const Vec2i& in) {
 		std::string x = std::to_string(in.x);
 		std::string y = std::to_string(in.y);
 
-		std::cout << "Vec2i: [" + x + "][" + y + "]\n";
+		log("Vec2i: [" + x + "][" + y + "]");
 	}
 
 	void Debug::log(const Vec2f& in) {
 		std::string x = std::to_string(in.x);
 		std::string y = std::to_string(in.y);
 
-		std::cout << "Vec2f: [" + x + "][" + y + "]\n";
+		log("Vec2f: [" + x + "][" + y + "]");
 	}
 
 	void Debug::log(const Pixel& in) {
@@ -79,7 +108,7 @@ namespace HFR {
 		std::string b = std::to_string(in.b);
 		std::string a = std::to_string(in.a);
 
-		std::cout << "Pixel: [" + r + "][" + g + "][" + b + "][" + a + "]\n";
+		log("Pixel: [" + r + "][" + g + "][" + b + "][" + a + "]");
 	}
 
 	void Debug::log(const std::vector<Pixel>& array) {
@@ -103,92 +132,64 @@ namespace HFR {
 	}
 
 	void Debug::log(const Transform& in) {
-		log("Transform: ");
-		
-		std::cout <<"   position: ";
-		log(in.position);
-
-		std::cout <<"   rotation: ";
-		log(in.rotation);
-		
-		std::cout <<"   scale: ";
-		log(in.scale);
+		//one record so lines of other threads can't end up in between
+		log("Transform: \n   position: " + toString(in.position) + "\n   rotation: " + toString(in.rotation) + "\n   scale: " + toString(in.scale));
 	}
 
 	void Debug::systemLog(const std::string& SystemMessage) {
-		Debug::setTextColor(DebugColor::Yellow);
-		std::string out = "System Message: " + SystemMessage + "\n";
-		std::cout << out;
-		Debug::resetTextColor();
+		systemLog(SystemMessage, DebugColor::Yellow);
 	}
 
 	void Debug::systemLog(const std::string& SystemMessage, const DebugColor& color) {
-		Debug::setTextColor(color);
-		std::string out = "System Message: " + SystemMessage + "\n";
-		std::cout << out;
-		Debug::resetTextColor();
+		write(getLogSite(LogLevel::Info), SystemMessage, color);
+	}
+
+	void Debug::systemLog(const char* SystemMessage, const DebugColor& color) {
+		systemLog(std::string(SystemMessage), color);
 	}
 
 	void Debug::systemErr(const std::string& SystemError) {
-		if (failLogMode != HFR_DONT_LOG_ON_FAIL) {
-			Debug::setTextColor(DebugColor::Red);
-			std::string out = "System Error: " + SystemError + "\n";
-			std::cout << out;
-			Debug::resetTextColor();
-		}
+		systemErr(SystemError, DebugColor::Red);
 	}
 	
 	void Debug::systemErr(const std::string& SystemError, const DebugColor& color) {
-		if (failLogMode != HFR_DONT_LOG_ON_FAIL) {
-			Debug::setTextColor(color);
-			std::string out = "System Error: " + SystemError + "\n";
-			std::cout << out;
-			Debug::resetTextColor();
-		}
+		if (failLogMode != HFR_DONT_LOG_ON_FAIL)
+			write(getLogSite(LogLevel::Error), SystemError, color);
+	}
+
+	void Debug::systemErr(const char* SystemError, const DebugColor& color) {
+		systemErr(std::string(SystemError), color);
 	}
 
 	void Debug::systemSuccess(const std::string& SystemMessage) {
-		if (succeedLogMode != HFR_DONT_LOG_ON_SUCCESS) {
-			Debug::setTextColor(DebugColor::LightGreen);
-			std::string out = "System Success: " + SystemMessage + "\n";
-			std::cout << out;
-			Debug::resetTextColor();
-		}
+		systemSuccess(SystemMessage, DebugColor::LightGreen);
 	}
 	
 	void Debug::systemSuccess(const std::string& SystemMessage, const DebugColor& color) {
-		if (succeedLogMode != HFR_DONT_LOG_ON_SUCCESS) {
-			Debug::setTextColor(color);
-			std::string out = "System Success: " + SystemMessage + "\n";
-			std::cout << out;
-			Debug::resetTextColor();
-		}
+		if (succeedLogMode != HFR_DONT_LOG_ON_SUCCESS)
+			write(getLogSite(LogLevel::Success), SystemMessage, color);
+	}
+
+	void Debug::systemSuccess(const char* SystemMessage, const DebugColor& color) {
+		systemSuccess(std::string(SystemMessage), color);
 	}
 
 	void Debug::newLine() {
-		std::cout << "\n";
+		log(std::string());
 	}
 
 	void Debug::newLine(const int& lines) {
-		std::string linesAmount;
-
 		for (int i = 0; i < lines; ++i) {
-			linesAmount += "\n";
+			newLine();
 		}
-
-		std::cout << linesAmount;
 	}
 
 	void Debug::waterMark() {
-		Debug::setTextColor(DebugColor::Aqua);
-		std::cout << "Hydrogen Game Engine v0.7 alpha: created by Salmoncatt\n";
-		Debug::resetTextColor();
+		log("Hydrogen Game Engine v0.7 alpha: created by Salmoncatt", DebugColor::Aqua);
 	}
 
 	void Debug::closingWaterMark() {
-		Debug::setTextColor(DebugColor::Aqua);
-		std::cout << "Engine is Closing, thanks for coming\n";
-		Debug::resetTextColor();
+		log("Engine is Closing, thanks for coming", DebugColor::Aqua);
 	}
 
 	void Debug::setTextColor(const DebugColor& color) {
@@ -213,6 +214,12 @@ namespace HFR {
 	}
 	
 	Profile Debug::getProfile(const std::string& name) {
+		Profile out(name);
+
+		//ProfileMethod scopes go through the scope profiler now, only Profiler objects end up in here
+		if (ScopeProfiler::getTotal(name, out.calls, out.duration))
+			return out;
+
 		if (profilerNames.find(name) != profilerNames.end())
 			return lastFrameProfiles[profilerNames[name]];
 		else
@@ -229,8 +236,15 @@ namespace HFR {
 		log("Profiling of method: " + profile.name + ", took: " + std::to_string(profile.duration) + " ms, and had " + std::to_string(profile.calls) + " calls");
 	}
 
+	void Debug::logTextureCacheStats() {
+		log("Texture cache: " + std::to_string(TextureCache::getEntryAmount()) + " textures, " + std::to_string(TextureCache::getMemoryUsage() / 1024) + " kb of " + std::to_string(TextureCache::getBudget() / 1024) + " kb, "
+			+ std::to_string(TextureCache::getHits()) + " hits, " + std::to_string(TextureCache::getMisses()) + " misses, " + std::to_string(TextureCache::getEvictions()) + " evictions");
+	}
+
 	void Debug::update() {
-		lastFrameProfiles = profiles;
+		ScopeProfiler::collect();
+
+		std::copy(profiles.begin(), profiles.begin() + profiledAmount, lastFrameProfiles.begin());
 		resetProfiles();
 	}
 
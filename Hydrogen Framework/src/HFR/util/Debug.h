@@ -15,6 +15,8 @@ namespace HFR {
 	struct Vec2i;
 	struct Transform;
 	class Profiler;
+	class LogSite;
+	enum class LogLevel : uint8_t;
 
 	const enum class DLL_API DebugColor
 	{
@@ -45,9 +47,29 @@ namespace HFR {
 		static int succeedLogMode;
 		static int failLogMode;
 
+		//the one every Debug call of that level goes through
+		static LogSite& getLogSite(const LogLevel& level);
+
+		//defined in Logger.h, it needs the logger
+		template<typename... Args>
+		static void writeFormatted(const LogLevel& level, const DebugColor& color, const char* format, const Args&... arguments);
+
 	public:
+		//these take a format and arguments instead of a message, every {} gets the next argument (numbers and strings), the logger thread
+		//puts the text together so nothing gets built on the calling thread, and nothing at all when the level is filtered out
+		template<typename T, typename... Args>
+		static void log(const char* format, const T& argument, const Args&... arguments);
+		template<typename T, typename... Args>
+		static void systemLog(const char* format, const T& argument, const Args&... arguments);
+		template<typename T, typename... Args>
+		static void systemErr(const char* format, const T& argument, const Args&... arguments);
+		template<typename T, typename... Args>
+		static void systemSuccess(const char* format, const T& argument, const Args&... arguments);
+
 		static void log(const std::string& message);
 		static void log(const std::string& message, const DebugColor& color);
+		//so a literal with a color doesn't end up as a format
+		static void log(const char* message, const DebugColor& color);
 		static void log(const char& in);
 		static void log(const double& in);
 		static void log(const int& in);
@@ -66,10 +88,13 @@ namespace HFR {
 
 		static void systemLog(const std::string& message);
 		static void systemLog(const std::string& message, const DebugColor& color);
+		static void systemLog(const char* message, const DebugColor& color);
 		static void systemErr(const std::string& message);
 		static void systemErr(const std::string& message, const DebugColor& color);
+		static void systemErr(const char* message, const DebugColor& color);
 		static void systemSuccess(const std::string& message);
 		static void systemSuccess(const std::string& message, const DebugColor& color);
+		static void systemSuccess(const char* message, const DebugColor& color);
 
 		static void newLine();
 		static void newLine(const int& lines);
@@ -82,6 +107,7 @@ namespace HFR {
 		static Profile getProfile(const std::string& name);
 		static void resetProfiles();
 		static void logProfile(const Profile& profile);
+		static void logTextureCacheStats();
 
 		//returns that amount of different functions that were profiled ever
 		static unsigned long getAmountOfProfiles();
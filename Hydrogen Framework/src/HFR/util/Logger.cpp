@@ -0,0 +1,614 @@
+#include "hfpch.h"
+#include HFR_LOGGER
+
+namespace HFR {
+
+	namespace {
+		struct RecordHeader {
+			//of the whole record with the header, a multiple of 8
+			uint32_t size;
+			uint32_t site;
+			uint64_t ticks;
+			uint32_t argumentBytes;
+			//records the site dropped right before this one
+			uint32_t suppressed;
+			uint32_t color;
+			uint32_t kind;
+		};
+
+		//site of a record that only fills up the end of the buffer so the next one can start at the beginning
+		const uint32_t PADDING_SITE = 0xffffffff;
+
+		//one producer (the thread it belongs to) and one consumer (whoever drains), the same setup as the scope profilers buffers
+		struct LogBuffer {
+			std::unique_ptr<unsigned char[]> bytes;
+
+			alignas(64) std::atomic<size_t> head;
+			size_t cachedTail = 0;
+			//head once the record being written is committed
+			size_t pending = 0;
+			std::atomic<size_t> dropped;
+			//the thread it belongs to exited, nothing gets written into it anymore
+			std::atomic<bool> retired;
+
+			alignas(64) std::atomic<size_t> tail;
+
+			LogBuffer() : bytes(new unsigned char[HFR_LOG_BUFFER_BYTES]), head(0), dropped(0), retired(false), tail(0) {}
+		};
+
+		struct Entry {
+			uint64_t ticks;
+			LogLevel level;
+			DebugColor color;
+			std::string text;
+		};
+
+		thread_local LogBuffer* threadBuffer = nullptr;
+		thread_local bool threadExited = false;
+
+		//retires the threads buffer when it exits, the buffer stays until a drain wrote everything in it so nothing the thread logged gets lost,
+		//threadBuffer is a plain pointer so logging from thread_local destructors that run after this one is still fine
+		struct ThreadExit {
+			bool registered = false;
+
+			~ThreadExit() {
+				threadExited = true;
+
+				if (threadBuffer != nullptr)
+					threadBuffer->retired.store(true, std::memory_order_release);
+
+				threadBuffer = nullptr;
+			}
+		};
+
+		thread_local ThreadExit threadExit;
+
+		std::vector<std::unique_ptr<LogBuffer>> buffers;
+		//dropped records of buffers that are gone
+		size_t retiredDropped = 0;
+		std::mutex bufferMutex;
+
+		//sites get made while static objects are still being constructed, so these can't be plain statics
+		std::vector<LogSite*>& getSites() {
+			static std::vector<LogSite*> sites;
+			return sites;
+		}
+
+		std::mutex& getSiteMutex() {
+			static std::mutex siteMutex;
+			return siteMutex;
+		}
+
+		std::atomic<bool> running(false);
+		std::thread writer;
+		std::mutex wakeMutex;
+		std::condition_variable wakeCondition;
+
+		//only one drain at a time, the writer thread or a flush
+		std::mutex drainMutex;
+		std::vector<Entry> entries;
+		size_t reportedDropped = 0;
+
+		bool console = true;
+		std::ofstream file;
+		std::string filePath;
+		size_t fileBytes = 0;
+
+		uint64_t startTicks = 0;
+		double ticksPerSecond = 0;
+
+		LogBuffer* registerThread() {
+			std::lock_guard<std::mutex> lock(bufferMutex);
+
+			buffers.push_back(std::unique_ptr<LogBuffer>(new LogBuffer()));
+			threadBuffer = buffers.back().get();
+
+			//touching threadExit is what gets it made (and destroyed) on this thread,
+			//a thread that logs while it's exiting, after threadExit went, keeps this one for good
+			if (!threadExited)
+				threadExit.registered = true;
+
+			return threadBuffer;
+		}
+
+		const char* getPrefix(const LogLevel& level) {
+			switch (level) {
+			case LogLevel::Info:
+				return "System Message: ";
+			case LogLevel::Success:
+				return "System Success: ";
+			case LogLevel::Warning:
+				return "System Warning: ";
+			case LogLevel::Error:
+				return "System Error: ";
+			default:
+				return "";
+			}
+		}
+
+		void rotateFile() {
+			file.close();
+
+			for (int i = HFR_LOG_FILES; i > 0; --i) {
+				const std::string from = i == 1 ? filePath : filePath + "." + std::to_string(i - 1);
+				const std::string to = filePath + "." + std::to_string(i);
+
+				std::remove(to.c_str());
+				std::rename(from.c_str(), to.c_str());
+			}
+
+			file.open(filePath, std::ios_base::out | std::ios_base::trunc);
+			fileBytes = 0;
+		}
+
+		void writeEntries() {
+			//records of different threads only get in order here
+			std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.ticks < b.ticks; });
+
+			std::string out;
+			DebugColor color = DebugColor::White;
+
+			for (size_t i = 0; i < entries.size(); ++i) {
+				const Entry& entry = entries[i];
+
+				if (console) {
+					//the console only changes color between writes
+					if (entry.color != color && !out.empty()) {
+						std::cout << out;
+						std::cout.flush();
+						out.clear();
+					}
+
+					if (entry.color != color) {
+						Debug::setTextColor(entry.color);
+						color = entry.color;
+					}
+
+					out += getPrefix(entry.level);
+					out += entry.text;
+					out += '\n';
+				}
+
+				if (file.is_open()) {
+					char time[32];
+					snprintf(time, sizeof(time), "[%10.3f] ", ticksPerSecond > 0 ? (double)(entry.ticks - startTicks) / ticksPerSecond : 0.0);
+
+					const std::string line = time + std::string(getPrefix(entry.level)) + entry.text + "\n";
+					file << line;
+					fileBytes += line.size();
+
+					if (fileBytes >= HFR_LOG_FILE_BYTES)
+						rotateFile();
+				}
+			}
+
+			if (!out.empty()) {
+				std::cout << out;
+				std::cout.flush();
+			}
+
+			if (color != DebugColor::White)
+				Debug::resetTextColor();
+
+			if (file.is_open())
+				file.flush();
+
+			entries.clear();
+		}
+
+		std::string formatRecord(const LogSite& site, const RecordHeader& header, const unsigned char* arguments) {
+			if (header.kind == (uint32_t)LogRecordKind::Plain)
+				return Logger::format(site.format, arguments, header.argumentBytes);
+
+			//the format is the first argument, a string
+			uint32_t length = 0;
+			std::memcpy(&length, arguments + 1, 4);
+
+			const std::string format((const char*)arguments + 5, length);
+			return Logger::format(format.c_str(), arguments + 5 + length, header.argumentBytes - 5 - length);
+		}
+
+		//drainMutex has to be held
+		void drain() {
+			std::vector<LogBuffer*> drained;
+			size_t dropped = 0;
+
+			{
+				std::lock_guard<std::mutex> lock(bufferMutex);
+
+				for (size_t i = 0; i < buffers.size(); ++i)
+					drained.push_back(buffers[i].get());
+
+				dropped = retiredDropped;
+			}
+
+			std::lock_guard<std::mutex> siteLock(getSiteMutex());
+			const std::vector<LogSite*>& sites = getSites();
+
+			for (size_t i = 0; i < drained.size(); ++i) {
+				LogBuffer& buffer = *drained[i];
+
+				const size_t head = buffer.head.load(std::memory_order_acquire);
+				size_t position = buffer.tail.load(std::memory_order_relaxed);
+
+				while (position != head) {
+					const size_t offset = position % HFR_LOG_BUFFER_BYTES;
+
+					//too little left at the end for a header, the writer skipped it too
+					if (HFR_LOG_BUFFER_BYTES - offset < sizeof(RecordHeader)) {
+						position += HFR_LOG_BUFFER_BYTES - offset;
+						continue;
+					}
+
+					RecordHeader header;
+					std::memcpy(&header, buffer.bytes.get() + offset, sizeof(RecordHeader));
+
+					//a site that's gone was flushed before it went, anything after that can't be formatted anymore
+					if (header.site != PADDING_SITE && header.site < sites.size() && sites[header.site] != nullptr) {
+						const LogSite& site = *sites[header.site];
+
+						Entry entry;
+						entry.ticks = header.ticks;
+						entry.level = site.level;
+						entry.color = (DebugColor)header.color;
+						entry.text = formatRecord(site, header, buffer.bytes.get() + offset + sizeof(RecordHeader));
+
+						if (header.suppressed > 0)
+							entry.text += " (" + std::to_string(header.suppressed) + " more from here were dropped)";
+
+						entries.push_back(std::move(entry));
+					}
+
+					position += header.size;
+				}
+
+				//the text is made, the bytes can go
+				buffer.tail.store(position, std::memory_order_release);
+				dropped += buffer.dropped.load(std::memory_order_relaxed);
+			}
+
+			{
+				//retired is set after the threads last record, so once it's seen and the buffer is empty nothing else comes
+				std::lock_guard<std::mutex> lock(bufferMutex);
+
+				for (size_t i = buffers.size(); i-- > 0;) {
+					LogBuffer& buffer = *buffers[i];
+
+					if (buffer.retired.load(std::memory_order_acquire) && buffer.tail.load(std::memory_order_relaxed) == buffer.head.load(std::memory_order_acquire)) {
+						retiredDropped += buffer.dropped.load(std::memory_order_relaxed);
+						buffers.erase(buffers.begin() + i);
+					}
+				}
+			}
+
+			if (dropped > reportedDropped) {
+				Entry entry;
+				entry.ticks = ScopeProfiler::getTicks();
+				entry.level = LogLevel::Warning;
+				entry.color = DebugColor::LightYellow;
+				entry.text = std::to_string(dropped - reportedDropped) + " log records didn't fit into their threads buffer";
+
+				entries.push_back(std::move(entry));
+				reportedDropped = dropped;
+			}
+
+			if (!entries.empty())
+				writeEntries();
+		}
+
+		void writerLoop() {
+			while (running.load(std::memory_order_acquire)) {
+				{
+					std::unique_lock<std::mutex> lock(wakeMutex);
+					wakeCondition.wait_for(lock, std::chrono::milliseconds(HFR_LOG_FLUSH_MILLISECONDS), [] { return !running.load(std::memory_order_acquire); });
+				}
+
+				Logger::flush();
+			}
+		}
+	}
+
+	LogLevel Logger::level = LogLevel::Trace;
+
+	LogSite::LogSite(const LogLevel& _level, const char* _category, const char* _format, const DebugColor& _color, const uint32_t& _limit) : windowStart(0), windowCount(0), suppressed(0) {
+		level = _level;
+		category = _category;
+		format = _format;
+		color = _color;
+		limit = _limit;
+
+		std::lock_guard<std::mutex> lock(getSiteMutex());
+
+		id = (uint32_t)getSites().size();
+		getSites().push_back(this);
+	}
+
+	LogSite::~LogSite() {
+		//the format and category are the modules strings too, so the records have to be text before they go away
+		if (running.load(std::memory_order_acquire))
+			Logger::flush();
+
+		//the slot stays empty instead of being reused, a record with this id could still be in a buffer
+		std::lock_guard<std::mutex> lock(getSiteMutex());
+		getSites()[id] = nullptr;
+	}
+
+	bool LogSite::allow() {
+		if (level < Logger::level)
+			return false;
+
+		//before init there's no clock to limit with
+		if (limit == 0 || ticksPerSecond <= 0)
+			return true;
+
+		const uint64_t now = ScopeProfiler::getTicks();
+		uint64_t start = windowStart.load(std::memory_order_relaxed);
+
+		//whoever gets to start the new second resets the count
+		if ((double)(now - start) >= ticksPerSecond && windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+			windowCount.store(0, std::memory_order_relaxed);
+
+		if (windowCount.fetch_add(1, std::memory_order_relaxed) < limit)
+			return true;
+
+		suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	uint32_t LogSite::takeSuppressed() {
+		return suppressed.load(std::memory_order_relaxed) > 0 ? suppressed.exchange(0, std::memory_order_relaxed) : 0;
+	}
+
+	size_t Logger::getArgumentSize(const std::string& value) {
+		return 5 + value.size();
+	}
+
+	size_t Logger::getArgumentSize(const char* value) {
+		return 5 + (value != nullptr ? std::strlen(value) : 0);
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const std::string& value) {
+		const uint32_t size = (uint32_t)value.size();
+
+		*out = 's';
+		std::memcpy(out + 1, &size, 4);
+		std::memcpy(out + 5, value.data(), size);
+
+		return out + 5 + size;
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const char* value) {
+		const uint32_t size = value != nullptr ? (uint32_t)std::strlen(value) : 0;
+
+		*out = 's';
+		std::memcpy(out + 1, &size, 4);
+		std::memcpy(out + 5, value, size);
+
+		return out + 5 + size;
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const bool& value) {
+		out[0] = 'b';
+		out[1] = value ? 1 : 0;
+		return out + 2;
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const char& value) {
+		out[0] = 'c';
+		out[1] = (unsigned char)value;
+		return out + 2;
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const float& value) {
+		return encodeArgument(out, (double)value);
+	}
+
+	unsigned char* Logger::encodeArgument(unsigned char* out, const double& value) {
+		*out = 'd';
+		std::memcpy(out + 1, &value, 8);
+		return out + 9;
+	}
+
+	unsigned char* Logger::encodeSigned(unsigned char* out, const int64_t& value) {
+		*out = 'i';
+		std::memcpy(out + 1, &value, 8);
+		return out + 9;
+	}
+
+	unsigned char* Logger::encodeUnsigned(unsigned char* out, const uint64_t& value) {
+		*out = 'u';
+		std::memcpy(out + 1, &value, 8);
+		return out + 9;
+	}
+
+	unsigned char* Logger::reserve(const LogSite& site, const DebugColor& color, const size_t& argumentBytes, const LogRecordKind& kind) {
+		LogBuffer* buffer = threadBuffer != nullptr ? threadBuffer : registerThread();
+
+		const size_t size = (sizeof(RecordHeader) + argumentBytes + 7) & ~(size_t)7;
+		size_t head = buffer->head.load(std::memory_order_relaxed);
+		size_t offset = head % HFR_LOG_BUFFER_BYTES;
+
+		//records never wrap around, whatever is left at the end gets skipped
+		size_t skipped = 0;
+
+		if (HFR_LOG_BUFFER_BYTES - offset < size)
+			skipped = HFR_LOG_BUFFER_BYTES - offset;
+
+		if (head + skipped + size - buffer->cachedTail > HFR_LOG_BUFFER_BYTES) {
+			buffer->cachedTail = buffer->tail.load(std::memory_order_acquire);
+
+			if (head + skipped + size - buffer->cachedTail > HFR_LOG_BUFFER_BYTES) {
+				buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+		}
+
+		if (skipped >= sizeof(RecordHeader)) {
+			RecordHeader padding = {};
+			padding.size = (uint32_t)skipped;
+			padding.site = PADDING_SITE;
+
+			std::memcpy(buffer->bytes.get() + offset, &padding, sizeof(RecordHeader));
+		}
+
+		head += skipped;
+		offset = head % HFR_LOG_BUFFER_BYTES;
+
+		RecordHeader header;
+		header.size = (uint32_t)size;
+		header.site = site.id;
+		header.ticks = ScopeProfiler::getTicks();
+		header.argumentBytes = (uint32_t)argumentBytes;
+		header.suppressed = const_cast<LogSite&>(site).takeSuppressed();
+		header.color = (uint32_t)color;
+		header.kind = (uint32_t)kind;
+
+		std::memcpy(buffer->bytes.get() + offset, &header, sizeof(RecordHeader));
+		buffer->pending = head + size;
+
+		return buffer->bytes.get() + offset + sizeof(RecordHeader);
+	}
+
+	void Logger::commit(const LogSite& site) {
+		threadBuffer->head.store(threadBuffer->pending, std::memory_order_release);
+
+		//without the writer thread it goes out right away, errors too since the program might be about to exit
+		if (!running.load(std::memory_order_relaxed) || site.level >= LogLevel::Error)
+			flush();
+	}
+
+	void Logger::writeOversized(const LogSite& site, const DebugColor& color, const LogRecordKind& kind, const unsigned char* arguments, const size_t& argumentBytes) {
+		RecordHeader header = {};
+		header.argumentBytes = (uint32_t)argumentBytes;
+		header.kind = (uint32_t)kind;
+
+		std::string text = formatRecord(site, header, arguments);
+
+		if (text.size() > HFR_LOG_RECORD_BYTES - 128)
+			text.resize(HFR_LOG_RECORD_BYTES - 128);
+
+		text += "... (cut off, the record was " + std::to_string(argumentBytes) + " bytes)";
+		writeFormatted(site, color, "{}", text);
+	}
+
+	std::string Logger::format(const char* format, const unsigned char* arguments, const size_t& size) {
+		std::string out;
+		const unsigned char* end = arguments + size;
+
+		for (const char* character = format; *character != '\0'; ++character) {
+			if (character[0] != '{' || character[1] != '}' || arguments >= end) {
+				out += *character;
+				continue;
+			}
+
+			++character;
+
+			const unsigned char tag = *arguments++;
+
+			if (tag == 's') {
+				uint32_t length = 0;
+				std::memcpy(&length, arguments, 4);
+				out.append((const char*)arguments + 4, length);
+				arguments += 4 + length;
+			}
+			else if (tag == 'b' || tag == 'c') {
+				if (tag == 'b')
+					out += *arguments != 0 ? "true" : "false";
+				else
+					out += (char)*arguments;
+
+				arguments += 1;
+			}
+			else {
+				char number[32];
+
+				if (tag == 'd') {
+					double value = 0;
+					std::memcpy(&value, arguments, 8);
+					snprintf(number, sizeof(number), "%g", value);
+				}
+				else if (tag == 'i') {
+					int64_t value = 0;
+					std::memcpy(&value, arguments, 8);
+					snprintf(number, sizeof(number), "%lld", (long long)value);
+				}
+				else {
+					uint64_t value = 0;
+					std::memcpy(&value, arguments, 8);
+					snprintf(number, sizeof(number), "%llu", (unsigned long long)value);
+				}
+
+				out += number;
+				arguments += 8;
+			}
+		}
+
+		return out;
+	}
+
+	void Logger::init() {
+		if (running.load())
+			return;
+
+		startTicks = ScopeProfiler::getTicks();
+		ticksPerSecond = ScopeProfiler::getTicksPerMillisecond() * 1000.0;
+
+		running.store(true, std::memory_order_release);
+		writer = std::thread(writerLoop);
+	}
+
+	void Logger::close() {
+		if (running.exchange(false)) {
+			wakeCondition.notify_all();
+			writer.join();
+		}
+
+		flush();
+	}
+
+	void Logger::setFile(const std::string& path) {
+		std::lock_guard<std::mutex> lock(drainMutex);
+
+		if (file.is_open())
+			file.close();
+
+		filePath = path;
+		fileBytes = 0;
+
+		if (path.empty())
+			return;
+
+		Util::createDirectory(Util::removeNameFromFilePathAndName(path));
+		file.open(path, std::ios_base::out | std::ios_base::trunc);
+
+		if (!file.is_open())
+			std::cout << "System Error: Couldn't open log file: " + path + "\n";
+	}
+
+	void Logger::setConsole(const bool& _console) {
+		std::lock_guard<std::mutex> lock(drainMutex);
+		console = _console;
+	}
+
+	void Logger::flush() {
+		std::lock_guard<std::mutex> lock(drainMutex);
+		drain();
+	}
+
+	size_t Logger::getDroppedRecords() {
+		std::lock_guard<std::mutex> lock(bufferMutex);
+
+		size_t dropped = retiredDropped;
+
+		for (size_t i = 0; i < buffers.size(); ++i)
+			dropped += buffers[i]->dropped.load(std::memory_order_relaxed);
+
+		return dropped;
+	}
+
+	size_t Logger::getBufferAmount() {
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		return buffers.size();
+	}
+
+}
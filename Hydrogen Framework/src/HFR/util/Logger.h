@@ -0,0 +1,232 @@
+#ifndef HFR_LOGGER_HEADER_INCLUDE
+#define HFR_LOGGER_HEADER_INCLUDE
+
+#include HFR_API
+#include HFR_DEBUG
+
+//levels under this get compiled out, arguments and all, set it before hfpch.h (or in the project) to strip them from a build
+#ifndef HFR_LOG_LEVEL
+#define HFR_LOG_LEVEL 0
+#endif
+
+#define HFR_LOG_INNER(level, category, color, format, ...) do { \
+		static HFR::LogSite hfrLogSite(level, category, format, color, HFR::HFR_LOG_SITE_LIMIT); \
+		if (hfrLogSite.allow()) \
+			HFR::Logger::write(hfrLogSite, ##__VA_ARGS__); \
+	} while (0)
+
+//format and category have to be string literals, every {} in the format gets the next argument,
+//a call site that logs more than HFR_LOG_SITE_LIMIT times a second drops the rest and says how many it dropped with the next one that gets through
+#if HFR_LOG_LEVEL <= 0
+#define HFR_LOG_TRACE(category, format, ...) HFR_LOG_INNER(HFR::LogLevel::Trace, category, HFR::DebugColor::White, format, ##__VA_ARGS__)
+#else
+#define HFR_LOG_TRACE(category, format, ...) ((void)0)
+#endif
+
+#if HFR_LOG_LEVEL <= 1
+#define HFR_LOG_INFO(category, format, ...) HFR_LOG_INNER(HFR::LogLevel::Info, category, HFR::DebugColor::Yellow, format, ##__VA_ARGS__)
+#else
+#define HFR_LOG_INFO(category, format, ...) ((void)0)
+#endif
+
+#if HFR_LOG_LEVEL <= 2
+#define HFR_LOG_SUCCESS(category, format, ...) HFR_LOG_INNER(HFR::LogLevel::Success, category, HFR::DebugColor::LightGreen, format, ##__VA_ARGS__)
+#else
+#define HFR_LOG_SUCCESS(category, format, ...) ((void)0)
+#endif
+
+#if HFR_LOG_LEVEL <= 3
+#define HFR_LOG_WARNING(category, format, ...) HFR_LOG_INNER(HFR::LogLevel::Warning, category, HFR::DebugColor::LightYellow, format, ##__VA_ARGS__)
+#else
+#define HFR_LOG_WARNING(category, format, ...) ((void)0)
+#endif
+
+#if HFR_LOG_LEVEL <= 4
+#define HFR_LOG_ERROR(category, format, ...) HFR_LOG_INNER(HFR::LogLevel::Error, category, HFR::DebugColor::Red, format, ##__VA_ARGS__)
+#else
+#define HFR_LOG_ERROR(category, format, ...) ((void)0)
+#endif
+
+namespace HFR {
+
+	enum class LogLevel : uint8_t {
+		Trace = 0,
+		Info = 1,
+		Success = 2,
+		Warning = 3,
+		Error = 4
+	};
+
+	enum class LogRecordKind : uint32_t {
+		//the sites format with the arguments
+		Plain = 0,
+		//the first argument is the format
+		Formatted = 1
+	};
+
+	//one place in the code that logs, made once per macro line (and once per kind of Debug call)
+	class DLL_API LogSite {
+	private:
+		//rate limiting, ticks of when the current second started and how much got logged in it
+		std::atomic<uint64_t> windowStart;
+		std::atomic<uint32_t> windowCount;
+		std::atomic<uint32_t> suppressed;
+
+	public:
+		uint32_t id;
+		LogLevel level;
+		DebugColor color;
+		const char* category;
+		const char* format;
+		//per second, 0 for no limit
+		uint32_t limit;
+
+		LogSite(const LogLevel& level, const char* category, const char* format, const DebugColor& color, const uint32_t& limit);
+		LogSite(const LogSite&) = delete;
+		LogSite& operator=(const LogSite&) = delete;
+		//writes out what's still waiting from the site and takes it out of the list, a site in a script dll goes when the dll is unloaded
+		~LogSite();
+
+		//false when the level is filtered out or the site is over its limit
+		bool allow();
+		//what got dropped since the last call
+		uint32_t takeSuppressed();
+	};
+
+	//callers only write a small binary record (site, timestamp and the raw arguments) into a ring buffer of their own thread, no locks and no formatting,
+	//a background thread puts the text together, sorts the records of every thread by time and writes them to the console and the log file
+	class DLL_API Logger {
+	private:
+		//argument encoding, every argument is a tag byte and its bytes
+		static size_t getSize() { return 0; }
+		template<typename T, typename... Args>
+		static size_t getSize(const T& value, const Args&... args) { return getArgumentSize(value) + getSize(args...); }
+
+		static void encode(unsigned char*) {}
+		template<typename T, typename... Args>
+		static void encode(unsigned char* out, const T& value, const Args&... args) { out = encodeArgument(out, value); encode(out, args...); }
+
+		static size_t getArgumentSize(const std::string& value);
+		static size_t getArgumentSize(const char* value);
+		static size_t getArgumentSize(const bool&) { return 2; }
+		static size_t getArgumentSize(const char&) { return 2; }
+		static size_t getArgumentSize(const float&) { return 9; }
+		static size_t getArgumentSize(const double&) { return 9; }
+		template<typename T>
+		static size_t getArgumentSize(const T&) { static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "only numbers and strings can be logged"); return 9; }
+
+		static unsigned char* encodeArgument(unsigned char* out, const std::string& value);
+		static unsigned char* encodeArgument(unsigned char* out, const char* value);
+		static unsigned char* encodeArgument(unsigned char* out, const bool& value);
+		static unsigned char* encodeArgument(unsigned char* out, const char& value);
+		static unsigned char* encodeArgument(unsigned char* out, const float& value);
+		static unsigned char* encodeArgument(unsigned char* out, const double& value);
+		static unsigned char* encodeSigned(unsigned char* out, const int64_t& value);
+		static unsigned char* encodeUnsigned(unsigned char* out, const uint64_t& value);
+		template<typename T>
+		static unsigned char* encodeArgument(unsigned char* out, const T& value) {
+			return std::is_signed<T>::value ? encodeSigned(out, (int64_t)value) : encodeUnsigned(out, (uint64_t)value);
+		}
+
+		//room for a record of argumentBytes in the calling threads buffer, nullptr when it's full
+		static unsigned char* reserve(const LogSite& site, const DebugColor& color, const size_t& argumentBytes, const LogRecordKind& kind);
+		static void commit(const LogSite& site);
+		//formats the encoded arguments right here and logs the start of the text with a note that it got cut off
+		static void writeOversized(const LogSite& site, const DebugColor& color, const LogRecordKind& kind, const unsigned char* arguments, const size_t& argumentBytes);
+
+		template<typename... Args>
+		static void writeRecord(const LogSite& site, const DebugColor& color, const LogRecordKind& kind, const Args&... args) {
+			const size_t argumentBytes = getSize(args...);
+
+			//it would never fit (or take up most of the buffer), rare enough that it can allocate
+			if (argumentBytes > HFR_LOG_RECORD_BYTES) {
+				std::unique_ptr<unsigned char[]> arguments(new unsigned char[argumentBytes]);
+				encode(arguments.get(), args...);
+				writeOversized(site, color, kind, arguments.get(), argumentBytes);
+				return;
+			}
+
+			unsigned char* out = reserve(site, color, argumentBytes, kind);
+
+			if (out == nullptr)
+				return;
+
+			encode(out, args...);
+			commit(site);
+		}
+
+	public:
+		//lower levels get dropped while running, HFR_LOG_LEVEL drops them while compiling
+		static LogLevel level;
+
+		//starts the writer thread, before that (and after close) everything gets written right away on the calling thread
+		static void init();
+		//writes out whatever is left and stops the writer thread
+		static void close();
+
+		//also writes into this file, it gets moved to path.1 (and so on up to HFR_LOG_FILES) once it's HFR_LOG_FILE_BYTES, empty to stop
+		static void setFile(const std::string& path);
+		//on by default, off to only write into the file
+		static void setConsole(const bool& console);
+		//blocks until everything logged so far is written
+		static void flush();
+
+		//records that didn't fit into their threads buffer
+		static size_t getDroppedRecords();
+		//buffers still around, the one of a thread that exited goes with the first drain after everything in it is written
+		static size_t getBufferAmount();
+
+		template<typename... Args>
+		static void write(const LogSite& site, const Args&... args) {
+			writeColored(site, site.color, args...);
+		}
+
+		template<typename... Args>
+		static void writeColored(const LogSite& site, const DebugColor& color, const Args&... args) {
+			writeRecord(site, color, LogRecordKind::Plain, args...);
+		}
+
+		//the format goes into the record instead of coming from the site, for the Debug calls that all share a site,
+		//it doesn't have to outlive the call
+		template<typename... Args>
+		static void writeFormatted(const LogSite& site, const DebugColor& color, const char* format, const Args&... args) {
+			writeRecord(site, color, LogRecordKind::Formatted, format, args...);
+		}
+
+		//text of a record, what the writer thread does with every record
+		static std::string format(const char* format, const unsigned char* arguments, const size_t& size);
+	};
+
+	template<typename... Args>
+	void Debug::writeFormatted(const LogLevel& level, const DebugColor& color, const char* format, const Args&... arguments) {
+		LogSite& site = getLogSite(level);
+
+		if (site.allow())
+			Logger::writeFormatted(site, color, format, arguments...);
+	}
+
+	template<typename T, typename... Args>
+	void Debug::log(const char* format, const T& argument, const Args&... arguments) {
+		writeFormatted(LogLevel::Trace, DebugColor::White, format, argument, arguments...);
+	}
+
+	template<typename T, typename... Args>
+	void Debug::systemLog(const char* format, const T& argument, const Args&... arguments) {
+		writeFormatted(LogLevel::Info, DebugColor::Yellow, format, argument, arguments...);
+	}
+
+	template<typename T, typename... Args>
+	void Debug::systemErr(const char* format, const T& argument, const Args&... arguments) {
+		if (failLogMode != HFR_DONT_LOG_ON_FAIL)
+			writeFormatted(LogLevel::Error, DebugColor::Red, format, argument, arguments...);
+	}
+
+	template<typename T, typename... Args>
+	void Debug::systemSuccess(const char* format, const T& argument, const Args&... arguments) {
+		if (succeedLogMode != HFR_DONT_LOG_ON_SUCCESS)
+			writeFormatted(LogLevel::Success, DebugColor::LightGreen, format, argument, arguments...);
+	}
+
+}
+
+#endif
@@ -65,30 +65,39 @@ namespace HFR {
 			glDeleteBuffers(1, &VBOs[i]);
 			vbos += 1;
 		}
-		HFR::Debug::systemSuccess("Successfully deleted " + std::to_string(vbos) + " VBOs");
+		HFR::Debug::systemSuccess("Successfully deleted {} VBOs", vbos);
 	}
 
 	std::string Util::readAsString(const std::string& filepath, const int& readmode) {
-		std::ifstream file;
+		if (readmode != HFR_NORMAL_READ && readmode != HFR_BINARY_READ)
+			Debug::systemErr("Unkown read mode in file: {}, HFR_NORMAL_READ or HFR_BINARY_READ", filepath);
 
-		if (readmode == HFR_NORMAL_READ)
-			file = std::ifstream(filepath, std::ios_base::in);
-		else if (readmode == HFR_BINARY_READ)
-			file = std::ifstream(filepath, std::ios_base::in | std::ios_base::binary);
-		else
-			Debug::systemErr("Unkown read mode in file: " + filepath + ", HFR_NORMAL_READ or HFR_BINARY_READ");
+		FileData file = VirtualFileSystem::read(filepath);
 
-		std::string line;
-		std::string out = "";
+		if (!file.isValid()) {
+			Debug::systemErr("Could not read file: {}", filepath);
+			return "";
+		}
 
-		if (file.is_open()) {
-			while (std::getline(file, line)) {
-				out += line + "\n";
+		std::string out;
+
+		if (readmode == HFR_NORMAL_READ) {
+			//same as text mode, \r\n turns into \n
+			out.reserve(file.getSize() + 1);
+
+			const char* data = (const char*)file.getData();
+
+			for (size_t i = 0; i < file.getSize(); ++i) {
+				if (data[i] != '\r' || i + 1 >= file.getSize() || data[i + 1] != '\n')
+					out += data[i];
 			}
-			file.close();
 		}
 		else
-			Debug::systemErr("Could not read file: " + filepath);
+			out = file.toString();
+
+		//every line used to get a \n put after it, the last one included
+		if (!out.empty() && out.back() != '\n')
+			out += '\n';
 
 		return out;
 
@@ -121,10 +130,10 @@ namespace HFR {
 				success = _mkdir(path.substr(0, index).c_str());
 
 			if (success == 0) {
-				Debug::systemSuccess("Created directory: " + path);
+				Debug::systemSuccess("Created directory: {}", path);
 				return true;
 			} else if (success == -1){
-				Debug::systemErr("Couldn't create directory: " + path);
+				Debug::systemErr("Couldn't create directory: {}", path);
 				return false;
 			}
 		}
@@ -140,7 +149,7 @@ namespace HFR {
 		if (result == S_OK)
 			out = documentRawPath;
 		else
-			Debug::systemErr("Couldn't find directory: " + std::to_string(mode));
+			Debug::systemErr("Couldn't find directory: {}", mode);
 
 		return out;
 	}
@@ -164,14 +173,14 @@ namespace HFR {
 		else if (writemode == HFR_BINARY_WRITE)
 			file = std::ofstream(filepath, std::ios_base::out | std::ios_base::binary);
 		else
-			Debug::systemErr("Unkown read mode in file: " + filepath + ", HFR_NORMAL_READ or HFR_BINARY_READ");
+			Debug::systemErr("Unkown read mode in file: {}, HFR_NORMAL_READ or HFR_BINARY_READ", filepath);
 
 		file << fileData;
 
 		file.close();
 
 		std::string mode = (writemode == HFR_NORMAL_WRITE) ? "HFR_NORMAL_WRITE" : "HFR_BINARY_WRITE";
-		Debug::systemSuccess("Wrote file to: " + filepath + ", with mode: " + mode);
+		Debug::systemSuccess("Wrote file to: {}, with mode: {}", filepath, mode);
 	}
 
 	std::string Util::removeNameFromFilePathAndName(const std::string& path) {
@@ -202,28 +211,31 @@ namespace HFR {
 	}
 
 	std::vector<unsigned char> Util::readAsUnsignedChar(const std::string& filepath, const int& readmode) {
+		if (readmode == HFR_BINARY_READ) {
+			FileData file = VirtualFileSystem::read(filepath);
+
+			if (!file.isValid()) {
+				Debug::systemErr("Could not read file: {}", filepath);
+				return std::vector<unsigned char>();
+			}
+
+			return std::vector<unsigned char>(file.getData(), file.getData() + file.getSize());
+		}
+
 		std::string data = readAsString(filepath, readmode);
 		std::vector<unsigned char> out(data.begin(), data.end());
 		return out;
 	}
 
 	long Util::getFileSize(const std::string& filepath) {
-		
-		std::ifstream file(filepath, std::ios::in);
-		std::streampos fileSize = 0;
+		long long size = VirtualFileSystem::getFileSize(filepath);
 
-		if (file.is_open()) {
-			fileSize = file.tellg();
-			file.seekg(0, std::ios::end);
-
-			fileSize = file.tellg() - fileSize;
+		if (size < 0) {
+			Debug::systemErr("Could not read file: {}", filepath);
+			return 0;
 		}
-		else
-			Debug::systemErr("Could not read file: " + filepath);
 
-		file.close();
-
-		return (long)fileSize;
+		return (long)size;
 	}
 
 	void Util::compileShader(const int& ShaderID, const std::string& ShaderCode, const std::string& ShaderName) {
@@ -237,7 +249,7 @@ namespace HFR {
 			char Error[1024];
 			glGetShaderInfoLog(ShaderID, 1024, NULL, Error);
 			std::string StringError = Error;
-			Debug::systemErr("Compiling shader: " + ShaderName + " has failed with error: " + StringError);
+			Debug::systemErr("Compiling shader: {} has failed with error: {}", ShaderName, StringError);
 			return;
 		}
 		Debug::systemSuccess("Compiling shader: " + ShaderName + " has succeeded", DebugColor::Blue);
@@ -252,7 +264,7 @@ namespace HFR {
 			char Error[1024];
 			glGetProgramInfoLog(ProgramID, 1024, NULL, Error);
 			std::string StringError = Error;
-			Debug::systemErr("Linking Shader Program has failed with code: " + StringError);
+			Debug::systemErr("Linking Shader Program has failed with code: {}", StringError);
 			return;
 		}
 
@@ -263,14 +275,15 @@ namespace HFR {
 			char Error[1024];
 			glGetProgramInfoLog(ProgramID, 1024, NULL, Error);
 			std::string StringError = Error;
-			Debug::systemErr("Validating Shader Program has failed with code: " + StringError);
+			Debug::systemErr("Validating Shader Program has failed with code: {}", StringError);
 			return;
 		}
 	}
 
 	std::vector<Material> Util::loadMaterial(const std::string& filepath) {
 		std::string filename = removePathFromFilePathAndName(filepath);
-		std::ifstream file(filepath, std::ios::in);
+		FileData fileData = VirtualFileSystem::read(filepath);
+		std::istringstream file(fileData.toString());
 
 		std::vector<Material> out;
 
@@ -278,8 +291,12 @@ namespace HFR {
 
 		int materialCount = 0;
 
-		if (file.is_open()) {
+		if (fileData.isValid()) {
 			while (std::getline(file, line)) {
+				//text mode used to take care of these
+				if (!line.empty() && line.back() == '\r')
+					line.pop_back();
+
 				if (line.substr(0, 7) == "newmtl ") {
 					Material mat = Material();
 
@@ -301,7 +318,7 @@ namespace HFR {
 						out[index].ambientColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 4) == "	Ka ") {
@@ -316,7 +333,7 @@ namespace HFR {
 						out[index].ambientColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 3) == "Kd ") {
@@ -331,7 +348,7 @@ namespace HFR {
 						out[index].diffuseColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 4) == "	Kd ") {
@@ -346,7 +363,7 @@ namespace HFR {
 						out[index].diffuseColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 3) == "Ks ") {
@@ -361,7 +378,7 @@ namespace HFR {
 						out[index].specularColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 4) == "	Ks ") {
@@ -376,7 +393,7 @@ namespace HFR {
 						out[index].specularColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 3) == "Ke ") {
@@ -391,7 +408,7 @@ namespace HFR {
 						out[index].emissionColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 4) == "	Ke ") {
@@ -406,7 +423,7 @@ namespace HFR {
 						out[index].emissionColor = color;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 3) == "Ns ") {
@@ -421,7 +438,7 @@ namespace HFR {
 						out[index].specularExponent = amount;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 4) == "	Ns ") {
@@ -436,7 +453,7 @@ namespace HFR {
 						out[index].specularExponent = amount;
 					}
 					else {
-						Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+						Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 					}
 				}
 				else if (line.substr(0, 7) == "map_Kd ") {
@@ -444,11 +461,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].diffuseMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(7));
-					out[index].diffuseMap.create();
+					out[index].diffuseMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(7));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 8) == "	map_Kd ") {
@@ -456,11 +472,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].diffuseMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(8));
-					out[index].diffuseMap.create();
+					out[index].diffuseMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(8));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 7) == "map_Ks ") {
@@ -468,11 +483,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].specularMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(7));
-					out[index].specularMap.create();
+					out[index].specularMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(7));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 8) == "	map_Ks ") {
@@ -480,11 +494,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].specularMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(8));
-					out[index].specularMap.create();
+					out[index].specularMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(8));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 7) == "map_Ka ") {
@@ -492,11 +505,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].ambientMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(7));
-					out[index].ambientMap.create();
+					out[index].ambientMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(7));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 8) == "	map_Ka ") {
@@ -504,11 +516,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].ambientMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(8));
-					out[index].ambientMap.create();
+					out[index].ambientMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(8));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 7) == "map_Ke ") {
@@ -516,11 +527,10 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].emissionMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(7));
-					out[index].emissionMap.create();
+					out[index].emissionMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(7));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 				else if (line.substr(0, 8) == "	map_Ke ") {
@@ -528,21 +538,20 @@ namespace HFR {
 				if (materialCount > 0) {
 					int index = materialCount - 1;
 
-					out[index].emissionMap = Texture(removeNameFromFilePathAndName(filepath) + line.substr(8));
-					out[index].emissionMap.create();
+					out[index].emissionMap = TextureCache::load(removeNameFromFilePathAndName(filepath) + line.substr(8));
 				}
 				else {
-					Debug::systemErr("Loading material: " + filepath + ", has failed because trying to add material properties without having (newmtl) command found");
+					Debug::systemErr("Loading material: {}, has failed because trying to add material properties without having (newmtl) command found", filepath);
 				}
 				}
 			}
 		}
 		else {
-			Debug::systemErr("Could not read material file: " + filename + ", at: " + filepath);
+			Debug::systemErr("Could not read material file: {}, at: {}", filename, filepath);
 			return out;
 		}
 
-		Debug::systemSuccess("Loaded material: " + filename);
+		Debug::systemSuccess("Loaded material: {}", filename);
 
 		return out;
 
@@ -550,12 +559,11 @@ namespace HFR {
 
 	std::vector<Mesh> Util::loadMesh(const std::string& filepath) {
 		std::string filename = removePathFromFilePathAndName(filepath);
-		FILE* file;
-		errno_t result = fopen_s(&file, filepath.c_str(), "r");
+		FileData file = VirtualFileSystem::read(filepath);
 
 		std::vector<Mesh> out;
-		if (!file || result != 0) {
-			Debug::systemErr("Could not read file: " + filepath);
+		if (!file.isValid()) {
+			Debug::systemErr("Could not read file: {}", filepath);
 			return out;
 		}
 
@@ -567,13 +575,15 @@ namespace HFR {
 
 		//std::string buffer;
 
-		char buffer[512];
+		const char* fileData = (const char*)file.getData();
+		const size_t fileSize = file.getSize();
+		size_t lineStart = 0;
 
 		std::string line;
 
 		unsigned int meshIndex = 0;
 
-		long reserveSize = getFileSize(filepath) / 100;
+		long reserveSize = (long)(fileSize / 100);
 
 		//0 = i/i/i, 1 = i/i 2 = i//i
 		unsigned short faceIndexType = 0;
@@ -584,9 +594,17 @@ namespace HFR {
 		normalBuffer.reserve(reserveSize);
 
 		//file.read(buffer, length);
-		while (fgets(buffer, 512, file) != NULL) {
-			line = buffer;
-			line.erase(line.end() - 1, line.end());
+		//lines get read straight out of the mapped file
+		while (lineStart < fileSize) {
+			const char* lineEnd = (const char*)std::memchr(fileData + lineStart, '\n', fileSize - lineStart);
+			size_t lineLength = lineEnd ? (size_t)(lineEnd - (fileData + lineStart)) : fileSize - lineStart;
+
+			line.assign(fileData + lineStart, lineLength);
+			lineStart += lineLength + 1;
+
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
 			std::string header = line.substr(0, 2);
 
 			float data[3];
@@ -628,7 +646,7 @@ namespace HFR {
 							matches = sscanf_s(line.c_str(), "f %d//%d %d//%d %d//%d", &vertexIndex[0], &normalIndex[0], &vertexIndex[1], &normalIndex[1], &vertexIndex[2], &normalIndex[2]);
 
 							if (matches != 6) {
-								Debug::systemErr("Model: " + filepath + " has incorrect formatting, try different exporting options");
+								Debug::systemErr("Model: {} has incorrect formatting, try different exporting options", filepath);
 								return out;
 							}
 							else
@@ -653,7 +671,7 @@ namespace HFR {
 							matches = sscanf_s(line.c_str(), "f %d//%d %d//%d %d//%d", &vertexIndex[0], &normalIndex[0], &vertexIndex[1], &normalIndex[1], &vertexIndex[2], &normalIndex[2]);
 
 							if (matches != 6) {
-								Debug::systemErr("Model: " + filepath + " has incorrect formatting, try different exporting options");
+								Debug::systemErr("Model: {} has incorrect formatting, try different exporting options", filepath);
 								return out;
 							}
 							else
@@ -678,7 +696,7 @@ namespace HFR {
 							matches = sscanf_s(line.c_str(), "f %d/%d %d/%d %d/%d", &vertexIndex[0], &uvIndex[0], &vertexIndex[1], &uvIndex[1], &vertexIndex[2], &uvIndex[2]);
 
 							if (matches != 6) {
-								Debug::systemErr("Model: " + filepath + " has incorrect formatting, try different exporting options");
+								Debug::systemErr("Model: {} has incorrect formatting, try different exporting options", filepath);
 								return out;
 							}
 							else
@@ -787,7 +805,7 @@ namespace HFR {
 
 				//just a little helper for materials
 				if (!found) {
-					Debug::systemErr("Couldn't find material: " + line.substr(7));
+					Debug::systemErr("Couldn't find material: {}", line.substr(7));
 				}
 
 			}
@@ -795,19 +813,16 @@ namespace HFR {
 				std::string materialPath = removeNameFromFilePathAndName(filepath) + line.substr(7);
 				std::vector<Material> loadedMaterials = loadMaterial(materialPath);
 
-				materials.insert(materials.end(), loadedMaterials.begin(), loadedMaterials.end());
+				materials.insert(materials.end(), std::make_move_iterator(loadedMaterials.begin()), std::make_move_iterator(loadedMaterials.end()));
 
-				out = std::vector<Mesh>(materials.size(), Mesh());
-				out.reserve(materials.size());
+				out = std::vector<Mesh>(materials.size());
 			}
 		}
 
-		fclose(file);
-
 		if (!(materials.size() > 0))
-			Debug::systemErr("Warning object file: " + filename + ", has no materials. Meaning it will have null textures and stuff");
+			Debug::systemErr("Warning object file: {}, has no materials. Meaning it will have null textures and stuff", filename);
 
-		Debug::systemSuccess("Loaded object: " + filename);
+		Debug::systemSuccess("Loaded object: {}", filename);
 		Debug::newLine();
 
 		return out;
@@ -911,7 +926,7 @@ namespace HFR {
 
 		if ((dir = opendir(HFR_SCRIPTS.c_str())) != NULL) {
 
-			Debug::systemLog("Printing files at path: " + path);
+			Debug::systemLog("Printing files at path: {}", path);
 			Debug::newLine();
 
 			while ((ent = readdir(dir)) != NULL) {
@@ -923,7 +938,7 @@ namespace HFR {
 			closedir(dir);
 		}
 		else
-			Debug::systemErr("Couldn't load folder: " + path);
+			Debug::systemErr("Couldn't load folder: {}", path);
 
 	}
 
@@ -935,4 +950,56 @@ namespace HFR {
 		}
 	}
 
+	uint32_t Util::decodeUTF8(const std::string& text, size_t& index) {
+		const uint32_t replacement = 0xFFFD;
+		unsigned char lead = (unsigned char)text[index];
+
+		index += 1;
+
+		if (lead < 0x80)
+			return lead;
+
+		int length;
+		uint32_t out;
+
+		if ((lead & 0xE0) == 0xC0) {
+			length = 1;
+			out = lead & 0x1F;
+		}
+		else if ((lead & 0xF0) == 0xE0) {
+			length = 2;
+			out = lead & 0x0F;
+		}
+		else if ((lead & 0xF8) == 0xF0) {
+			length = 3;
+			out = lead & 0x07;
+		}
+		else
+			return replacement;
+
+		for (int i = 0; i < length; ++i) {
+			if (index >= text.size() || ((unsigned char)text[index] & 0xC0) != 0x80)
+				return replacement;
+
+			out = (out << 6) | ((unsigned char)text[index] & 0x3F);
+			index += 1;
+		}
+
+		//overlong encodings, surrogates and anything past the last codepoint
+		const uint32_t smallest[4] = { 0, 0x80, 0x800, 0x10000 };
+
+		if (out < smallest[length] || (out >= 0xD800 && out <= 0xDFFF) || out > 0x10FFFF)
+			return replacement;
+
+		return out;
+	}
+
+	uint32_t Util::packColor(const Vec4f& color) {
+		auto channel = [](const float& value) {
+			return (uint32_t)(min(max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+		};
+
+		return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+	}
+
 }
\ No newline at end of file
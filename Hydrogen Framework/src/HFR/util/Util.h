@@ -61,6 +61,23 @@ namespace HFR{
 		static std::string removePathFromFilePathAndName(const std::string& path);
 		static std::vector<unsigned char> readAsUnsignedChar(const std::string& filepath, const int& readmode);
 
+		//the raw bytes of a value onto the end of out, binary files (input recordings, replays) write field by field with it so no padding ends up in them
+		template<typename T>
+		static inline void writeValue(std::string& out, const T& value) {
+			out.append((const char*)&value, sizeof(T));
+		}
+
+		//false when there's less than a whole value left after offset, otherwise offset ends up after it
+		template<typename T>
+		static inline bool readValue(const unsigned char* data, const size_t& size, size_t& offset, T& value) {
+			if (size - offset < sizeof(T))
+				return false;
+
+			std::memcpy(&value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
 		//static void test(const std::string& filepath, const std::string& filename);
 		
 		static std::vector<Mesh> loadMesh(const std::string& filepath);
@@ -78,6 +95,10 @@ namespace HFR{
 		static void listFilesInFolder(const std::string& path);
 
 		static void toUpper(std::string& string);
+		//the codepoint starting at index, which ends up just past it, broken sequences come out as U+FFFD
+		static uint32_t decodeUTF8(const std::string& text, size_t& index);
+		//rgba8 with red in the lowest byte, every channel gets clamped to 0 - 1 first
+		static uint32_t packColor(const Vec4f& color);
 
 		//static void sendWindowsNotification();
 
@@ -3,13 +3,28 @@
 #define HFR_INCLUDE_STANDARD_HEADER_INCLUDE
 
 #include HFR_DEBUG
+#include HFR_LOGGER
 #include HFR_UTIL
+#include HFR_VIRTUAL_FILE_SYSTEM
 #include HFR_MATH
 #include HFR_TIME
 #include HFR_INPUT
+#include HFR_REPLAY
 #include HFR_CURSOR
 #include HFR_ENGINE
+#include HFR_JOB_SYSTEM
+#include HFR_ALLOCATION_TRACKER
+#include HFR_TRACE_CAPTURE
+#include HFR_FRAME_TELEMETRY
+#include HFR_GPU_PROFILER
+#include HFR_ASSET_LOADER
+#include HFR_TEXTURE_CACHE
+#include HFR_TEXTURE_STREAMER
 #include HFR_RENDERER
+#include HFR_TEXT_BATCHER
+#include HFR_QUAD_BATCHER
+#include HFR_RENDER_SNAPSHOT
+#include HFR_RENDER_PIPELINE
 #include HFR_PROGRAM
 #include HFR_FLOAT_BUFFER
 #include HFR_MESH
@@ -18,6 +33,11 @@
 #include HFR_TEXTURE
 #include HFR_IMAGE
 #include HFR_PIXEL
+#include HFR_IMAGE_PROCESSING
+#include HFR_COOKED_TEXTURE
+#include HFR_TEXTURE_COMPRESSOR
+#include HFR_SKYLINE_PACKER
+#include HFR_TEXTURE_ATLAS
 #include HFR_CAMERA
 #include HFR_CAMERA_CONTROLLER
 #include HFR_EDITOR_CAMERA
@@ -27,10 +47,14 @@
 #include HFR_SCENE
 //#include HFR_
 #include HFR_TAG
+#include HFR_TRANSFORM_SYSTEM
+#include HFR_HIERARCHY
+#include HFR_HIERARCHY_SYSTEM
 #include HFR_NATIVE_SCRIPT
 #include STB_IMAGE
 #include HFR_GUI_FRAME
 #include HFR_GUI_ELEMENT
+#include HFR_GUI_CANVAS
 #include HFR_SHADER
 #include HFR_WINDOW
 #include HFR_GUID
@@ -5,6 +5,9 @@
 //#define _CRT_SECURE_NO_DEPRECATE
 #include <iostream>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <chrono> 
 #include <sstream>
 #include <vector>
@@ -13,9 +16,13 @@
 #include <assert.h>
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <queue>
+#include <deque>
+#include <memory>
 #include <stdio.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <intrin.h>
 #include <functional>
 #include <cstring>
@@ -57,6 +64,11 @@
 #else
 
 #include <unistd.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
 #define HFR_Get_Directory getcwd
 
 #endif
@@ -83,7 +95,9 @@ this is just a test block comment for my header merger project
 
 //for profiling of any class
 #include HFR_PROFILER //another test comment
-#define ProfileMethod(name) HFR::Profiler HFR_AUTO_PROFILER(name, false, true)
+#include HFR_SCOPE_PROFILER
+//name has to be a string literal
+#define ProfileMethod(name) ProfileScope(name)
 
 #include HFR_STANDARD
 
@@ -9,10 +9,16 @@ namespace HFR {
 	//need to not duct tape fix this
 #define HFR_RES std::string(Util::getWorkingDirectory() + "../../../../../Hydrogen Framework/res/")
 #define HFR_SCRIPTS std::string(Util::getWorkingDirectory() + "../../../../../Hydrogen Framework/scripts/")
+//packed version of res, gets mounted over it if it exists (PackArchive::build makes it)
+#define HFR_RES_ARCHIVE std::string(Util::getWorkingDirectory() + "../../../../../Hydrogen Framework/res.hpak")
 
 
 #define HFR_PROJECTS_PATH Util::getDirectory(HFR_FOLDER_DOCUMENTS) + R"(\Hydrogen Game Engine\)"
 
+//counts every new and delete for the frame counters and the benchmarks, it replaces the global operators so it's off unless it's defined
+//here or for the framework and the program both (a program only counts its own allocations if it includes HFR_ALLOCATION_OPERATORS)
+//#define HFR_TRACK_ALLOCATIONS
+
 	//for byte buffer and other buffers
 	const int HFR_UNSIGNED = 0;
 	const int HFR_SIGNED = 1;
@@ -21,6 +27,11 @@ namespace HFR {
 	const int HFR_PIXEL_SIZE = 0;
 	const int HFR_SCREEN_SPACE_SIZE = 1;
 
+	//for GUI layout
+	const int HFR_GUI_LAYOUT_NONE = 0;
+	const int HFR_GUI_LAYOUT_ROW = 1;
+	const int HFR_GUI_LAYOUT_COLUMN = 2;
+
 	//for read as string and other things
 	const int HFR_NORMAL_READ = 1;
 	const int HFR_BINARY_READ = 2;
@@ -54,6 +65,153 @@ namespace HFR {
 	const int HFR_DONT_LOG_ON_SUCCESS = 1;
 	const int HFR_LOG_ON_FAIL = 2;
 	const int HFR_DONT_LOG_ON_FAIL = 3;
+
+	//logging
+	//bytes of log records every thread can have waiting for the writer thread, what doesn't fit gets dropped and counted
+	const size_t HFR_LOG_BUFFER_BYTES = 262144;
+	//the most argument bytes one record can have, a bigger one gets cut down to its first this many bytes of text and says so
+	const size_t HFR_LOG_RECORD_BYTES = 16384;
+	//records one call site can log a second before the rest gets dropped
+	const uint32_t HFR_LOG_SITE_LIMIT = 20;
+	//how long the writer thread sleeps between drains
+	const int HFR_LOG_FLUSH_MILLISECONDS = 2;
+	//a log file gets rotated at this size, and this many old ones are kept
+	const size_t HFR_LOG_FILE_BYTES = 8388608;
+	const int HFR_LOG_FILES = 3;
+
+	//input
+	//events that can come in between two Input::update calls, the rest gets dropped and counted
+	const size_t HFR_INPUT_EVENTS = 1024;
+	//bumped whenever the layout of saved input recordings changes
+	const uint32_t HFR_INPUT_RECORDING_VERSION = 1;
+
+	//replays
+	//bumped whenever the layout of saved replays changes
+	const uint32_t HFR_REPLAY_VERSION = 1;
+
+	//simd instruction sets
+	const int HFR_SIMD_SCALAR = 0;
+	const int HFR_SIMD_SSE2 = 1;
+	const int HFR_SIMD_AVX2 = 2;
+	const int HFR_SIMD_AVX512 = 3;
+
+	//image resampling filters
+	const int HFR_FILTER_BOX = 0;
+	const int HFR_FILTER_TRIANGLE = 1;
+	const int HFR_FILTER_KAISER = 2;
+
+	//cooked texture formats, everything but rgba8 is gpu block compression
+	const int HFR_TEXTURE_FORMAT_RGBA8 = 0;
+	const int HFR_TEXTURE_FORMAT_BC1 = 1;
+	const int HFR_TEXTURE_FORMAT_BC3 = 2;
+	const int HFR_TEXTURE_FORMAT_BC5 = 3;
+	const int HFR_TEXTURE_FORMAT_BC7 = 4;
+
+	//block compression quality, each one is slower than the last
+	const int HFR_COMPRESSION_FAST = 0;
+	const int HFR_COMPRESSION_NORMAL = 1;
+	const int HFR_COMPRESSION_BEST = 2;
+
+	//asset loading states
+	const int HFR_ASSET_LOADING = 0;
+	const int HFR_ASSET_READY = 1;
+	const int HFR_ASSET_FAILED = 2;
+
+	//how many bytes the asset loader is allowed to push to the gpu per frame
+	const size_t HFR_DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+	//how much the texture cache holds on to before it starts evicting unused textures
+	const size_t HFR_DEFAULT_TEXTURE_CACHE_BUDGET = 256 * 1024 * 1024;
+
+	//texture streaming
+	//gpu bytes streamed textures get to keep resident, their always resident base levels included
+	const size_t HFR_DEFAULT_STREAMING_BUDGET = 128 * 1024 * 1024;
+	//streamed textures start out with the levels this size and smaller, those never get dropped
+	const int HFR_STREAMING_BASE_SIZE = 64;
+	//level reads allowed in flight at once
+	const int HFR_STREAMING_MAX_REQUESTS = 8;
+
+	//vertical field of view of the renderers perspective matrix, in degrees
+	const float HFR_FIELD_OF_VIEW = 90.0f;
+
+	//packed archives
+	const uint32_t HFR_PACK_VERSION = 1;
+	//every entry starts on this so mapped data is cache line aligned
+	const uint32_t HFR_PACK_ALIGNMENT = 64;
+	const uint32_t HFR_PACK_COMPRESSED = 1;
+
+	//cooked textures
+	const uint32_t HFR_COOKED_TEXTURE_VERSION = 1;
+	//every level starts on this, a bc block is 16 bytes at most
+	const uint32_t HFR_COOKED_TEXTURE_ALIGNMENT = 16;
+	const uint32_t HFR_COOKED_TEXTURE_SRGB = 1;
+
+	//glyph atlases
+	//pixel size distance field glyphs are made at, the same atlas serves every text size
+	const int HFR_SDF_GLYPH_SIZE = 32;
+	//atlas texels of distance around every glyph, text can't get an outline or glow wider than this
+	const int HFR_SDF_SPREAD = 4;
+	//glyphs get rasterized this many times bigger and the distance field gets scaled back down from that
+	const int HFR_SDF_SUPERSAMPLE = 4;
+	//atlases start out this big and double until they hit the max size, after that least recently used glyphs get evicted
+	const int HFR_GLYPH_ATLAS_SIZE = 512;
+	const int HFR_MAX_GLYPH_ATLAS_SIZE = 4096;
+
+	//texture atlases
+	//every page is this big, images bigger than a page (padding included) can't go in an atlas
+	const int HFR_ATLAS_PAGE_SIZE = 2048;
+	//texels around every image filled with its edge pixels, enough for linear filtering and 4x4 compression blocks
+	const int HFR_ATLAS_PADDING = 2;
+
+	//text batching
+	//quads the batch buffers start out with, they double whenever a frame has more text than that
+	const size_t HFR_TEXT_BATCH_QUADS = 4096;
+	//frames a laid out string is kept around for without getting drawn
+	const unsigned long long HFR_TEXT_LAYOUT_LIFETIME = 120;
+
+	//scope profiler
+	//begin and end events a thread can have waiting for collect, every scope is two, has to be a power of two
+	const size_t HFR_PROFILER_BUFFER_EVENTS = 1 << 16;
+
+	//frame loop
+	//fixed simulation steps a second
+	const double HFR_FIXED_RATE = 60.0;
+	//steps one frame can take at most, the time past that gets dropped so a slow frame can't snowball
+	const int HFR_MAX_FIXED_STEPS = 5;
+	//the end of a paced frame gets spun out instead of slept, sleeps can overshoot by about this much
+	const double HFR_FRAME_SPIN_MILLISECONDS = 1.5;
+
+	//frame captures
+	//bumped whenever the .htrace layout changes, older files don't convert
+	const unsigned int HFR_TRACE_VERSION = 1;
+	//frames the hotkey captures and spike captures keep before the slow frame
+	const size_t HFR_TRACE_CAPTURE_FRAMES = 60;
+
+	//frame telemetry
+	//frames the rolling statistics and csv dumps cover
+	const size_t HFR_TELEMETRY_FRAMES = 600;
+	//a hitch takes this many times the average frame and at least the milliseconds
+	const float HFR_TELEMETRY_HITCH_FACTOR = 2.0f;
+	const float HFR_TELEMETRY_HITCH_MILLISECONDS = 20.0f;
+
+	//gpu timers
+	//frames of timestamp queries in flight, results get read this many frames minus one later
+	const size_t HFR_GPU_TIMER_FRAMES = 3;
+	//timestamps one frame can have, every scope takes two
+	const size_t HFR_GPU_TIMER_QUERIES = 512;
+	//frames between lining the gpu clock up with the profilers while recording a trace
+	const size_t HFR_GPU_TIMER_SYNC_FRAMES = 60;
+	//the thread recorded gpu scopes have in traces
+	const uint16_t HFR_GPU_TRACE_THREAD = 0xffff;
+
+	//gui quad batching
+	//quads the instance buffer starts out with, it doubles whenever a frame has more than that
+	const size_t HFR_QUAD_BATCH_QUADS = 4096;
+	//textures one draw can use, guiImageFragment.glsl has the same amount of samplers
+	const int HFR_QUAD_BATCH_TEXTURE_SLOTS = 8;
+
+	//gui canvas
+	//more dirty regions than this in a frame get drawn as one region around all of them
+	const int HFR_GUI_MAX_DIRTY_REGIONS = 8;
 }
 
 //keycodes
@@ -281,6 +439,11 @@ namespace HFR {
 }
 
 //macros for include bc im lazy
+#define HFR_ASSET_HANDLE "HFR/assets/AssetHandle.h"
+#define HFR_ASSET_LOADER "HFR/assets/AssetLoader.h"
+#define HFR_TEXTURE_CACHE "HFR/assets/TextureCache.h"
+#define HFR_TEXTURE_STREAMER "HFR/assets/TextureStreamer.h"
+
 #define HFR_CAMERA "HFR/camera/Camera.h"
 #define HFR_CAMERA_CONTROLLER "HFR/camera/CameraController.h"
 #define HFR_EDITOR_CAMERA "HFR/camera/EditorCamera.h"
@@ -289,6 +452,9 @@ namespace HFR {
 #define HFR_GAMEOBJECT "HFR/ECS/GameObject.h"
 #define HFR_SCENE "HFR/ECS/Scene.h"
 #define HFR_TAG "HFR/ECS/components/Tag.h"
+#define HFR_HIERARCHY "HFR/ECS/components/Hierarchy.h"
+#define HFR_TRANSFORM_SYSTEM "HFR/ECS/systems/TransformSystem.h"
+#define HFR_HIERARCHY_SYSTEM "HFR/ECS/systems/HierarchySystem.h"
 
 #define HFR_MESH "HFR/mesh/Mesh.h"
 #define HFR_TEXTURE "HFR/mesh/Texture.h"
@@ -299,6 +465,7 @@ namespace HFR {
 #define HFR_SCRIPT_MANAGER "HFR/scripting/ScriptManager.h"
 
 #define HFR_GUI_ELEMENT "HFR/gui/GuiElement.h"
+#define HFR_GUI_CANVAS "HFR/gui/GuiCanvas.h"
 #define HFR_GUI_FRAME "HFR/gui/GuiFrame.h"
 #define HFR_GUI_IMAGE "HFR/gui/GuiImage.h"
 #define HFR_GUI_PANEL "HFR/gui/GuiPanel.h"
@@ -308,12 +475,26 @@ namespace HFR {
 #define HFR_PROGRAM "HFR/core/Program.h"
 #define HFR_ENGINE "HFR/core/Engine.h"
 #define HFR_START "HFR/core/Start.h"
+#define HFR_JOB_SYSTEM "HFR/core/JobSystem.h"
+#define HFR_ALLOCATION_TRACKER "HFR/core/AllocationTracker.h"
+#define HFR_ALLOCATION_OPERATORS "HFR/core/AllocationOperators.h"
+#define HFR_REPLAY "HFR/core/Replay.h"
 
 #define HFR_IMAGE "HFR/graphics/image/Image.h"
 #define HFR_PIXEL "HFR/graphics/image/Pixel.h"
+#define HFR_IMAGE_PROCESSING "HFR/graphics/image/ImageProcessing.h"
+#define HFR_COOKED_TEXTURE "HFR/graphics/image/CookedTexture.h"
+#define HFR_TEXTURE_COMPRESSOR "HFR/graphics/image/TextureCompressor.h"
+#define HFR_SKYLINE_PACKER "HFR/graphics/image/SkylinePacker.h"
+#define HFR_TEXTURE_ATLAS "HFR/graphics/image/TextureAtlas.h"
 
 #define HFR_RENDERER "HFR/graphics/rendering/Renderer.h"
 #define HFR_RENDERER2D "HFR/graphics/rendering/Renderer2D.h"
+#define HFR_TEXT_BATCHER "HFR/graphics/rendering/TextBatcher.h"
+#define HFR_QUAD_BATCHER "HFR/graphics/rendering/QuadBatcher.h"
+#define HFR_FRAMEBUFFER "HFR/graphics/rendering/Framebuffer.h"
+#define HFR_RENDER_SNAPSHOT "HFR/graphics/rendering/RenderSnapshot.h"
+#define HFR_RENDER_PIPELINE "HFR/graphics/rendering/RenderPipeline.h"
 #define HFR_SHADER "HFR/graphics/rendering/Shader.h"
 
 #define HFR_LIGHT "HFR/graphics/lighting/Light.h"
@@ -321,9 +502,13 @@ namespace HFR {
 #define HFR_CURSOR "HFR/io/Cursor.h"
 #define HFR_INPUT "HFR/io/Input.h"
 #define HFR_WINDOW "HFR/io/Window.h"
+#define HFR_VIRTUAL_FILE_SYSTEM "HFR/io/VirtualFileSystem.h"
+#define HFR_PACK_ARCHIVE "HFR/io/PackArchive.h"
 
 #define HFR_MAT4 "HFR/math/matrixes/Mat4.h"
+#define HFR_MATRIX_KERNELS "HFR/math/matrixes/MatrixKernels.h"
 #define HFR_TRANSFORM "HFR/math/vectors/Transform.h"
+#define HFR_QUATERNION "HFR/math/vectors/Quaternion.h"
 #define HFR_VEC2 "HFR/math/vectors/Vec2.h"
 #define HFR_VEC3 "HFR/math/vectors/Vec3.h"
 #define HFR_VEC4 "HFR/math/vectors/Vec4.h"
@@ -334,13 +519,19 @@ namespace HFR {
 
 #define HFR_FREETYPE "HFR/text/FreeType.h"
 #define HFR_CHARACTER "HFR/text/Character.h"
+#define HFR_GLYPH_CACHE "HFR/text/GlyphCache.h"
 #define HFR_FONT "HFR/text/Font.h"
 
 #define HFR_PROFILE "HFR/time/Profile.h"
 #define HFR_PROFILER "HFR/time/Profiler.h"
+#define HFR_SCOPE_PROFILER "HFR/time/ScopeProfiler.h"
+#define HFR_TRACE_CAPTURE "HFR/time/TraceCapture.h"
+#define HFR_FRAME_TELEMETRY "HFR/time/FrameTelemetry.h"
+#define HFR_GPU_PROFILER "HFR/time/GpuProfiler.h"
 #define HFR_TIME "HFR/time/Time.h"
 
 #define HFR_DEBUG "HFR/util/Debug.h"
+#define HFR_LOGGER "HFR/util/Logger.h"
 #define HFR_UTIL "HFR/util/Util.h"
 #define HFR_GUID "HFR/util/HGUID.h"
 
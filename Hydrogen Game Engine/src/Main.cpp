@@ -39,7 +39,7 @@ public:
 
 		MeshComponent mesh = MeshComponent();
 		mesh.meshes = Util::loadMesh(HFR_RES + "models/peter/peter.obj");
-		peter.addComponent<MeshComponent>(mesh);
+		peter.addComponent<MeshComponent>(std::move(mesh));
 		peter.getComponent<Transform>().scale = 2;
 
 		mesh = MeshComponent();
@@ -47,7 +47,7 @@ public:
 		//mesh.meshes = Util::loadMesh(HFR_RES + "models/warehouse/warehouse.obj");
 		mesh.meshes = Util::loadMesh(HFR_RES + "models/crate/crate.obj");
 
-		warehouse.addComponent<MeshComponent>(mesh);
+		warehouse.addComponent<MeshComponent>(std::move(mesh));
 
 		warehouse.getComponent<Transform>().scale = (2);
 		//warehouse.getComponent<Transform>().scale = (0.03f);
@@ -64,7 +64,7 @@ public:
 
 		peter.addComponent<NativeScript>().addScript("testScript");
 
-		Renderer::light.diffuseColor = Vec3f(1);
+		test->light.diffuseColor = Vec3f(1);
 
 		/*GuiFrame* frame = new GuiFrame();
 		frame->draggable = true;
@@ -88,19 +88,19 @@ public:
 			if (Input::getKeyDown(HFR_KEY_BACKSLASH))
 				Renderer::toggleWireFrameMode();
 
-			//Renderer::light.position.x = 50 * sin(Time::getTime() / 400);
-			//Renderer::light.position.z = 50 * cos(Time::getTime() / 400);
+			//test->light.position.x = 50 * sin(Time::getTime() / 400);
+			//test->light.position.z = 50 * cos(Time::getTime() / 400);
 
 			//move light
 			if (Input::getKey(HFR_KEY_UP))
-				Renderer::light.position.x += 3 * Time::getDeltaTime();
+				test->light.position.x += 3 * Time::getDeltaTime();
 			if (Input::getKey(HFR_KEY_DOWN))
-				Renderer::light.position.x -= 3 * Time::getDeltaTime();
+				test->light.position.x -= 3 * Time::getDeltaTime();
 			if (Input::getKey(HFR_KEY_LEFT))
-				Renderer::light.position.z -= 3 * Time::getDeltaTime();
+				test->light.position.z -= 3 * Time::getDeltaTime();
 			if (Input::getKey(HFR_KEY_RIGHT))
-				Renderer::light.position.z += 3 * Time::getDeltaTime();
-			Renderer::light.position.y += Input::getScrollMovement().y;
+				test->light.position.z += 3 * Time::getDeltaTime();
+			test->light.position.y += Input::getScrollMovement().y;
 
 			//if (Input::getKeyDown(HFR_KEY_F))
 				//ProjectManager::createEngineProject("testProject", "testScript");
@@ -0,0 +1,142 @@
+#include "hfpch.h"
+#include "HFR.h"
+#include "ReportCompare.h"
+
+using namespace HFR;
+
+//Hydrogen Replay record <replay> [seed]                       plays the demo scene and records it until the window closes or escape
+//Hydrogen Replay run <replay> <report.json> [warmup frames]   replays it in a hidden window and writes the frame statistics
+//Hydrogen Replay compare <base.json> <new.json> [percent]      exits with 1 when the new report is slower than the threshold anywhere
+//exits with 2 when the arguments are wrong or a report can't be read
+
+namespace {
+	const unsigned int DEFAULT_SEED = 1;
+	//the first frames load and upload everything, they'd swamp the percentiles
+	const size_t DEFAULT_WARMUP_FRAMES = 30;
+	const double DEFAULT_THRESHOLD_PERCENT = 5.0;
+
+	void printUsage() {
+		Debug::systemErr("Usage: record <replay> [seed] | run <replay> <report.json> [warmup frames] | compare <base.json> <new.json> [threshold percent]");
+	}
+}
+
+class Main : public HFR::Program {
+public:
+	Scene* scene;
+	std::string mode;
+
+	Main(const std::string& _mode) {
+		mode = _mode;
+		scene = new Scene();
+		//a replay only needs the timings, nothing has to show up on screen
+		window->visible = mode != "run";
+	}
+
+	~Main() {
+	}
+
+	void create() override {
+		window->setBackGroundColor(Vec4f(1, 0.7f, 0, 1));
+		scene->initialize();
+	}
+
+	void start() override {
+		window->resize(Vec2i(1000, 600));
+		Renderer::setCullingMode(true);
+
+		createScene();
+
+		if (mode == "record")
+			record();
+		else
+			run();
+
+		delete scene;
+	}
+
+private:
+	//the same things the demo has, so the numbers mean something for it
+	void createScene() {
+		scene->editorCamera.transform.position = Vec3f(0, 0, 10);
+		scene->light.diffuseColor = Vec3f(1);
+
+		GameObject peter = scene->createGameObject("peter");
+		GameObject crate = scene->createGameObject("crate");
+
+		MeshComponent mesh = MeshComponent();
+		mesh.meshes = Util::loadMesh(HFR_RES + "models/peter/peter.obj");
+		peter.addComponent<MeshComponent>(std::move(mesh));
+		peter.getComponent<Transform>().scale = 2;
+
+		mesh = MeshComponent();
+		mesh.meshes = Util::loadMesh(HFR_RES + "models/crate/crate.obj");
+		crate.addComponent<MeshComponent>(std::move(mesh));
+		crate.getComponent<Transform>().scale = 2;
+	}
+
+	void updateFrame() {
+		scene->updateEditor();
+
+		if (Input::getMouseButtonDown(HFR_MOUSE_BUTTON_2))
+			Cursor::toggleMouseState();
+	}
+
+	void record() {
+		const std::string path = arguments[2];
+		const unsigned int seed = arguments.size() > 3 ? (unsigned int)std::stoul(arguments[3]) : DEFAULT_SEED;
+
+		Replay::startRecording(seed);
+
+		while (shouldUpdate() && !Input::getKey(HFR_KEY_ESCAPE))
+			updateFrame();
+
+		Replay::stopRecording();
+		Replay::getData().save(path);
+	}
+
+	void run() {
+		ReplayData replay;
+
+		if (!replay.load(arguments[2]))
+			return;
+
+		const std::string reportPath = arguments[3];
+		const size_t warmup = arguments.size() > 4 ? (size_t)std::stoul(arguments[4]) : DEFAULT_WARMUP_FRAMES;
+
+		if (warmup >= replay.getFrameAmount()) {
+			Debug::systemErr("The replay only has " + std::to_string(replay.getFrameAmount()) + " frames, that's not more than the " + std::to_string(warmup) + " warmup frames");
+			return;
+		}
+
+		//the whole run goes into the report
+		FrameTelemetry::setCapacity(replay.getFrameAmount());
+		Replay::startReplay(replay);
+
+		while (shouldUpdate() && Replay::isReplaying()) {
+			updateFrame();
+
+			if (Replay::getFrame() == warmup)
+				FrameTelemetry::clear();
+		}
+
+		FrameTelemetry::dumpJson(reportPath);
+	}
+};
+
+HFR::Program* HFR::createProgram() {
+	const std::vector<std::string>& arguments = Program::arguments;
+	const std::string mode = arguments.size() > 1 ? arguments[1] : "";
+
+	//comparing doesn't need the engine, so it's done before anything gets started
+	if (mode == "compare" && arguments.size() > 3) {
+		const double threshold = arguments.size() > 4 ? std::stod(arguments[4]) : DEFAULT_THRESHOLD_PERCENT;
+		std::exit((int)HRP::compareReports(arguments[2], arguments[3], threshold));
+	}
+
+	if (!(mode == "record" && arguments.size() > 2) && !(mode == "run" && arguments.size() > 3)) {
+		printUsage();
+		std::exit((int)HRP::CompareResult::Error);
+	}
+
+	return new Main(mode);
+}
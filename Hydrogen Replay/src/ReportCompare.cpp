@@ -0,0 +1,172 @@
+#include "hfpch.h"
+#include "HFR.h"
+#include "ReportCompare.h"
+
+using namespace HFR;
+
+namespace HRP {
+
+	namespace {
+		//differences under this many milliseconds are noise no matter the percentage, tiny subsystems jump around a lot
+		const double NOISE_MILLISECONDS = 0.02;
+
+		//just enough json for the reports, objects of numbers and more objects
+		class ReportParser {
+		private:
+			const std::string& text;
+			size_t position = 0;
+
+			void skipSpace() {
+				while (position < text.size() && std::isspace((unsigned char)text[position]))
+					position += 1;
+			}
+
+			bool expect(const char& c) {
+				skipSpace();
+
+				if (position >= text.size() || text[position] != c)
+					return false;
+
+				position += 1;
+				return true;
+			}
+
+			bool parseString(std::string& out) {
+				if (!expect('"'))
+					return false;
+
+				out.clear();
+
+				while (position < text.size() && text[position] != '"') {
+					if (text[position] == '\\' && position + 1 < text.size())
+						position += 1;
+
+					out += text[position++];
+				}
+
+				return expect('"');
+			}
+
+			bool parseValue(const std::string& name, std::map<std::string, double>& values) {
+				skipSpace();
+
+				if (position < text.size() && text[position] == '{')
+					return parseObject(name + ".", values);
+
+				const char* start = text.c_str() + position;
+				char* end = nullptr;
+				const double value = std::strtod(start, &end);
+
+				if (end == start)
+					return false;
+
+				position += end - start;
+				values[name] = value;
+				return true;
+			}
+
+		public:
+			ReportParser(const std::string& _text) : text(_text) {}
+
+			bool parseObject(const std::string& prefix, std::map<std::string, double>& values) {
+				if (!expect('{'))
+					return false;
+
+				if (expect('}'))
+					return true;
+
+				do {
+					std::string name;
+
+					if (!parseString(name) || !expect(':') || !parseValue(prefix + name, values))
+						return false;
+				} while (expect(','));
+
+				return expect('}');
+			}
+		};
+	}
+
+	bool readReport(const std::string& path, std::map<std::string, double>& values) {
+		std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+
+		if (!file.is_open()) {
+			Debug::systemErr("Could not read report: " + path);
+			return false;
+		}
+
+		const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		values.clear();
+		ReportParser parser(text);
+
+		if (!parser.parseObject("", values)) {
+			Debug::systemErr("Report: " + path + " isn't a frame telemetry report");
+			return false;
+		}
+
+		return true;
+	}
+
+	CompareResult compareReports(const std::string& basePath, const std::string& newPath, const double& thresholdPercent) {
+		std::map<std::string, double> base;
+		std::map<std::string, double> current;
+
+		if (!readReport(basePath, base) || !readReport(newPath, current))
+			return CompareResult::Error;
+
+		size_t regressions = 0;
+		size_t improvements = 0;
+
+		char header[256];
+		snprintf(header, sizeof(header), "%-48s %10s %10s %9s", "milliseconds", "base", "new", "change");
+		Debug::log(std::string(header), DebugColor::BrightWhite);
+
+		for (auto it = base.begin(); it != base.end(); ++it) {
+			const std::string& name = it->first;
+
+			//only the timings, the frame count just says how long the run was
+			if (name == "frames")
+				continue;
+
+			auto found = current.find(name);
+
+			if (found == current.end()) {
+				Debug::log(name + ": missing from " + newPath, DebugColor::Yellow);
+				continue;
+			}
+
+			const double before = it->second;
+			const double after = found->second;
+			const double change = before > 0 ? (after - before) / before * 100 : 0;
+			const bool isHitches = name == "hitches";
+
+			const bool slower = isHitches ? after > before : (after - before > NOISE_MILLISECONDS && change > thresholdPercent);
+			const bool faster = isHitches ? after < before : (before - after > NOISE_MILLISECONDS && -change > thresholdPercent);
+
+			char line[256];
+			snprintf(line, sizeof(line), "%-48s %10.3f %10.3f %+8.1f%%", name.c_str(), before, after, change);
+
+			if (slower) {
+				regressions += 1;
+				Debug::log(std::string(line), DebugColor::Red);
+			}
+			else if (faster) {
+				improvements += 1;
+				Debug::log(std::string(line), DebugColor::LightGreen);
+			}
+			else
+				Debug::log(std::string(line), DebugColor::White);
+		}
+
+		Debug::newLine();
+
+		if (regressions > 0)
+			Debug::systemErr(std::to_string(regressions) + " regressions over " + std::to_string(thresholdPercent) + "%, " + std::to_string(improvements) + " improvements");
+		else
+			Debug::systemSuccess("No regressions over " + std::to_string(thresholdPercent) + "%, " + std::to_string(improvements) + " improvements");
+
+		return regressions > 0 ? CompareResult::Regressed : CompareResult::Passed;
+	}
+
+}
@@ -0,0 +1,25 @@
+#ifndef HRP_REPORT_COMPARE_HEADER_INCLUDE
+#define HRP_REPORT_COMPARE_HEADER_INCLUDE
+
+#include <string>
+#include <map>
+
+namespace HRP {
+
+	//what FrameTelemetry::dumpJson writes, flattened into "frameTime.p95", "subsystems.Scene.max" and so on
+	bool readReport(const std::string& path, std::map<std::string, double>& values);
+
+	//what compare exits with, so a script can tell a slower build from reports that aren't there
+	enum class CompareResult : int {
+		Passed = 0,
+		Regressed = 1,
+		//nothing got compared, a report isn't there or isn't one
+		Error = 2
+	};
+
+	//prints every statistic of both reports side by side, Regressed when the new one is more than thresholdPercent slower anywhere
+	CompareResult compareReports(const std::string& basePath, const std::string& newPath, const double& thresholdPercent);
+
+}
+
+#endif